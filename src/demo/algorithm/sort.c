@@ -295,6 +295,64 @@ static tb_void_t tb_sort_int_test_func_heap()
     // free
     tb_free(data);
 }
+static tb_void_t tb_sort_int_test_perf_radix(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data);
+    
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_array_iterator_init_long(&array_iterator, data, n);
+
+    // make
+    for (i = 0; i < n; i++) data[i] = tb_random_range(TB_MINS16, TB_MAXS16);
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_radix_sort_all(iterator);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_radix_sort_int_all: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // free
+    tb_free(data);
+}
+static tb_void_t tb_sort_int_test_perf_parallel(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data);
+    
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_array_iterator_init_long(&array_iterator, data, n);
+
+    // make
+    for (i = 0; i < n; i++) data[i] = tb_random_range(TB_MINS16, TB_MAXS16);
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_parallel_sort_all(iterator, tb_null);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_parallel_sort_int_all: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // free
+    tb_free(data);
+}
 static tb_void_t tb_sort_str_test_perf(tb_size_t n)
 {
     __tb_volatile__ tb_size_t i = 0;
@@ -492,6 +550,8 @@ tb_int_t tb_demo_algorithm_sort_main(tb_int_t argc, tb_char_t** argv)
     tb_sort_int_test_perf_quick(1000);
     tb_sort_int_test_perf_bubble(1000);
     tb_sort_int_test_perf_insert(1000);
+    tb_sort_int_test_perf_radix(1000);
+    tb_sort_int_test_perf_parallel(1000000);
     tb_sort_str_test_perf(1000);
     tb_sort_str_test_perf_heap(1000);
     tb_sort_str_test_perf_quick(1000);
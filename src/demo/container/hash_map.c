@@ -33,13 +33,25 @@
 #define tb_hash_map_test_insert_i2t(h, i)       do {tb_hash_map_insert(h, (tb_pointer_t)i, (tb_pointer_t)(tb_size_t)tb_true); } while (0);
 #define tb_hash_map_test_remove_i2t(h, i)       do {tb_hash_map_remove(h, (tb_pointer_t)i); tb_assert(!tb_hash_map_get(h, (tb_pointer_t)i)); } while (0);
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// use the swiss table?
+static tb_bool_t g_swiss = tb_false;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+static tb_hash_map_ref_t tb_hash_map_test_init(tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data)
+{
+    // the swiss table will be grown from the minimum capacity
+    return g_swiss? tb_hash_map_init_swiss(0, element_name, element_data) : tb_hash_map_init(bucket_size, element_name, element_data);
+}
 static tb_void_t tb_hash_map_test_s2i_func()
 {
     // init hash
-    tb_hash_map_ref_t hash = tb_hash_map_init(8, tb_element_str(tb_true), tb_element_long());
+    tb_hash_map_ref_t hash = tb_hash_map_test_init(8, tb_element_str(tb_true), tb_element_long());
     tb_assert_and_check_return(hash);
 
     // set
@@ -113,7 +125,7 @@ static tb_void_t tb_hash_map_test_s2i_func()
 static tb_void_t tb_hash_map_test_s2i_perf()
 {
     // init hash
-    tb_hash_map_ref_t hash = tb_hash_map_init(0, tb_element_str(tb_true), tb_element_long());
+    tb_hash_map_ref_t hash = tb_hash_map_test_init(0, tb_element_str(tb_true), tb_element_long());
     tb_assert_and_check_return(hash);
 
     // performance
@@ -135,7 +147,7 @@ static tb_void_t tb_hash_map_test_s2i_perf()
 static tb_void_t tb_hash_map_test_i2s_func()
 {
     // init hash
-    tb_hash_map_ref_t hash = tb_hash_map_init(8, tb_element_long(), tb_element_str(tb_true));
+    tb_hash_map_ref_t hash = tb_hash_map_test_init(8, tb_element_long(), tb_element_str(tb_true));
     tb_assert_and_check_return(hash);
 
     // set
@@ -205,7 +217,7 @@ static tb_void_t tb_hash_map_test_i2s_func()
 static tb_void_t tb_hash_map_test_i2s_perf()
 {
     // init hash
-    tb_hash_map_ref_t hash = tb_hash_map_init(0, tb_element_long(), tb_element_str(tb_true));
+    tb_hash_map_ref_t hash = tb_hash_map_test_init(0, tb_element_long(), tb_element_str(tb_true));
     tb_assert_and_check_return(hash);
 
     // performance
@@ -227,7 +239,7 @@ static tb_void_t tb_hash_map_test_m2m_func()
     // init hash
     tb_size_t const step = 256;
     tb_byte_t       item[step];
-    tb_hash_map_ref_t  hash = tb_hash_map_init(8, tb_element_mem(step, tb_null, tb_null), tb_element_mem(step, tb_null, tb_null));
+    tb_hash_map_ref_t  hash = tb_hash_map_test_init(8, tb_element_mem(step, tb_null, tb_null), tb_element_mem(step, tb_null, tb_null));
     tb_assert_and_check_return(hash);
 
     // set
@@ -338,7 +350,7 @@ static tb_void_t tb_hash_map_test_m2m_perf()
     // init hash: mem => mem
     tb_size_t const     step = 12;
     tb_byte_t           item[step];
-    tb_hash_map_ref_t       hash = tb_hash_map_init(0, tb_element_mem(step, tb_null, tb_null), tb_element_mem(step, tb_null, tb_null));
+    tb_hash_map_ref_t       hash = tb_hash_map_test_init(0, tb_element_mem(step, tb_null, tb_null), tb_element_mem(step, tb_null, tb_null));
     tb_assert_and_check_return(hash);
 
     // performance
@@ -358,7 +370,7 @@ static tb_void_t tb_hash_map_test_m2m_perf()
 static tb_void_t tb_hash_map_test_i2i_func()
 {
     // init hash
-    tb_hash_map_ref_t hash = tb_hash_map_init(8, tb_element_long(), tb_element_long());
+    tb_hash_map_ref_t hash = tb_hash_map_test_init(8, tb_element_long(), tb_element_long());
     tb_assert_and_check_return(hash);
 
     // set
@@ -427,7 +439,7 @@ static tb_void_t tb_hash_map_test_i2i_func()
 static tb_void_t tb_hash_map_test_i2i_perf()
 {
     // init hash
-    tb_hash_map_ref_t  hash = tb_hash_map_init(0, tb_element_long(), tb_element_long());
+    tb_hash_map_ref_t  hash = tb_hash_map_test_init(0, tb_element_long(), tb_element_long());
     tb_assert_and_check_return(hash);
 
     // performance
@@ -447,7 +459,7 @@ static tb_void_t tb_hash_map_test_i2i_perf()
 static tb_void_t tb_hash_map_test_i2t_func()
 {
     // init hash
-    tb_hash_map_ref_t hash = tb_hash_map_init(8, tb_element_long(), tb_element_true());
+    tb_hash_map_ref_t hash = tb_hash_map_test_init(8, tb_element_long(), tb_element_true());
     tb_assert_and_check_return(hash);
 
     // set
@@ -517,7 +529,7 @@ static tb_void_t tb_hash_map_test_i2t_func()
 static tb_void_t tb_hash_map_test_i2t_perf()
 {
     // init hash
-    tb_hash_map_ref_t  hash = tb_hash_map_init(0, tb_element_long(), tb_element_true());
+    tb_hash_map_ref_t  hash = tb_hash_map_test_init(0, tb_element_long(), tb_element_true());
     tb_assert_and_check_return(hash);
 
     // done
@@ -558,7 +570,7 @@ static tb_bool_t tb_hash_map_test_walk_item(tb_iterator_ref_t iterator, tb_cpoin
 static tb_void_t tb_hash_map_test_walk_perf()
 {
     // init hash
-    tb_hash_map_ref_t hash = tb_hash_map_init(0, tb_element_long(), tb_element_long());
+    tb_hash_map_ref_t hash = tb_hash_map_test_init(0, tb_element_long(), tb_element_long());
     tb_assert_and_check_return(hash);
 
     // reset random
@@ -584,11 +596,51 @@ static tb_void_t tb_hash_map_test_walk_perf()
     tb_hash_map_exit(hash);
 }
 
+static tb_void_t tb_hash_map_test_get_perf(tb_bool_t swiss)
+{
+    // init hash, the load factor will be ~7/8 for the swiss table and ~3.5 items per bucket for the bucket lists
+    tb_size_t           count = 229376;
+    tb_hash_map_ref_t   hash = swiss? tb_hash_map_init_swiss(count, tb_element_long(), tb_element_long()) : tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_LARGE, tb_element_long(), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // add items
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++) 
+    {
+        tb_size_t v = i * 2654435761UL;
+        tb_hash_map_test_insert_i2i(hash, v);
+    }
+
+    // get items
+    __tb_volatile__ tb_size_t   n = 10;
+    __tb_volatile__ tb_size_t   found = 0;
+    tb_hong_t                   t = tb_mclock();
+    while (n--)
+    {
+        for (i = 0; i < count; i++)
+        {
+            // the hit item
+            if (tb_hash_map_find(hash, (tb_pointer_t)(i * 2654435761UL))) found++;
+
+            // the missed item
+            if (tb_hash_map_find(hash, (tb_pointer_t)(i * 2654435761UL + 1))) found++;
+        }
+    }
+    t = tb_mclock() - t;
+    tb_trace_i("get: %s: size: %lu, maxn: %lu, found: %lu, time: %lld", swiss? "swiss" : "bucket", tb_hash_map_size(hash), tb_hash_map_maxn(hash), found, t);
+
+    // exit
+    tb_hash_map_exit(hash);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
 tb_int_t tb_demo_container_hash_map_main(tb_int_t argc, tb_char_t** argv)
 {
+    // use the swiss table? e.g. demo hash_map swiss
+    g_swiss = argv[1] && !tb_strcmp(argv[1], "swiss");
+
 #if 1
     tb_hash_map_test_s2i_func();
     tb_hash_map_test_i2s_func();
@@ -609,5 +661,10 @@ tb_int_t tb_demo_container_hash_map_main(tb_int_t argc, tb_char_t** argv)
     tb_hash_map_test_walk_perf();
 #endif
 
+#if 1
+    tb_hash_map_test_get_perf(tb_false);
+    tb_hash_map_test_get_perf(tb_true);
+#endif
+
     return 0;
 }
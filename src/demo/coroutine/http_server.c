@@ -13,7 +13,7 @@
 // the timeout
 #define TB_DEMO_TIMEOUT     (-1)
 
-// the cpu-core count
+// the cpu-core count, uses all cpu-cores if be zero
 #define TB_DEMO_CPU         (1)
 
 // the stack size
@@ -445,7 +445,7 @@ static tb_void_t tb_demo_coroutine_client(tb_cpointer_t priv)
 }
 static tb_void_t tb_demo_coroutine_listen(tb_cpointer_t priv)
 {
-    // TODO: fix thundering herd issues
+    // the client coroutines will be stolen by the other idle workers
     tb_size_t       count = 0;
     tb_socket_ref_t client = tb_null;
     tb_socket_ref_t sock = (tb_socket_ref_t)priv;
@@ -463,24 +463,6 @@ static tb_void_t tb_demo_coroutine_listen(tb_cpointer_t priv)
     // trace
     tb_trace_d("[%#x]: listened %lu", tb_thread_self(), count);
 }
-static tb_int_t tb_demo_coroutine_worker(tb_cpointer_t priv)
-{
-    // init scheduler
-    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
-    if (scheduler)
-    {
-        // start coroutines
-        tb_coroutine_start(scheduler, tb_demo_coroutine_listen, priv, 0);
-
-        // run scheduler, enable exclusive mode if be only one cpu
-        tb_co_scheduler_loop(scheduler, TB_DEMO_CPU == 1);
-
-        // exit scheduler
-        tb_co_scheduler_exit(scheduler);
-    }
-    return 0;
-}
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
@@ -512,14 +494,23 @@ tb_int_t tb_demo_coroutine_http_server_main(tb_int_t argc, tb_char_t** argv)
         // trace
         tb_trace_i("%s: %s", g_onlydata? "data" : "rootdir", g_rootdir);
 
-#if TB_DEMO_CPU > 1
-        // start workers for multi-threads
-        tb_size_t count = TB_DEMO_CPU - 1;
-        while (count--) tb_thread_init(tb_null, tb_demo_coroutine_worker, sock, 0);
+        // init scheduler, uses the M:N scheduler for multi-threads
+#if TB_DEMO_CPU == 1
+        tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+#else
+        tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init_workers(TB_DEMO_CPU);
 #endif
+        if (scheduler)
+        {
+            // start listening coroutine
+            tb_coroutine_start(scheduler, tb_demo_coroutine_listen, sock, 0);
 
-        // start worker
-        tb_demo_coroutine_worker(sock);
+            // run scheduler, enable exclusive mode if be only one cpu
+            tb_co_scheduler_loop(scheduler, TB_DEMO_CPU == 1);
+
+            // exit scheduler
+            tb_co_scheduler_exit(scheduler);
+        }
 
     } while (0);
 
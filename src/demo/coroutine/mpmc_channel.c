@@ -0,0 +1,151 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the task count of the thread pool
+#define TASK_COUNT          (8)
+
+// the result count of each task
+#define RESULT_COUNT        (100000)
+
+// the io scheduler count
+#define SCHEDULER_COUNT     (2)
+
+// the batch size
+#define BATCH_SIZE          (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the total received results
+static tb_atomic_t          g_received = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_void_t tb_demo_coroutine_mpmc_channel_task_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    tb_co_mpmc_channel_ref_t channel = (tb_co_mpmc_channel_ref_t)priv;
+
+    // compute the results on the worker thread and send them to the io coroutines by batch
+    tb_size_t       i = 0;
+    tb_size_t       n = 0;
+    tb_cpointer_t   results[BATCH_SIZE];
+    for (i = 0; i < RESULT_COUNT; i++)
+    {
+        results[n++] = (tb_cpointer_t)(i + 1);
+        if (n == BATCH_SIZE)
+        {
+            tb_co_mpmc_channel_nsend(channel, results, n);
+            n = 0;
+        }
+    }
+    if (n) tb_co_mpmc_channel_nsend(channel, results, n);
+}
+static tb_void_t tb_demo_coroutine_mpmc_channel_recv(tb_cpointer_t priv)
+{
+    // check
+    tb_co_mpmc_channel_ref_t channel = (tb_co_mpmc_channel_ref_t)priv;
+
+    // recv the results until the end
+    tb_size_t       count = 0;
+    tb_pointer_t    results[BATCH_SIZE];
+    while (1)
+    {
+        // recv them by batch
+        tb_size_t i = 0;
+        tb_size_t n = tb_co_mpmc_channel_nrecv(channel, results, BATCH_SIZE);
+        for (i = 0; i < n && results[i]; i++) count++;
+
+        // end?
+        if (i < n)
+        {
+            // the left end marks belong to the other coroutines, send them back
+            if (i + 1 < n) tb_co_mpmc_channel_nsend(channel, (tb_cpointer_t const*)results + i + 1, n - i - 1);
+            break;
+        }
+    }
+
+    // trace
+    tb_trace_i("[coroutine: %p]: recv %lu results", tb_coroutine_self(), count);
+
+    // save the received count
+    tb_atomic_fetch_and_add(&g_received, count);
+}
+static tb_int_t tb_demo_coroutine_mpmc_channel_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_co_mpmc_channel_ref_t channel = (tb_co_mpmc_channel_ref_t)priv;
+
+    // init scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    if (scheduler)
+    {
+        // start the receiving coroutine
+        tb_coroutine_start(scheduler, tb_demo_coroutine_mpmc_channel_recv, channel, 0);
+
+        // run scheduler
+        tb_co_scheduler_loop(scheduler, tb_true);
+
+        // exit scheduler
+        tb_co_scheduler_exit(scheduler);
+    }
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_coroutine_mpmc_channel_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init channel
+    tb_co_mpmc_channel_ref_t channel = tb_co_mpmc_channel_init(256, tb_null, tb_null);
+    if (channel)
+    {
+        // init the start time
+        tb_hong_t startime = tb_mclock();
+
+        // start the io schedulers
+        tb_size_t       i = 0;
+        tb_thread_ref_t threads[SCHEDULER_COUNT];
+        for (i = 0; i < SCHEDULER_COUNT; i++)
+            threads[i] = tb_thread_init(tb_null, tb_demo_coroutine_mpmc_channel_loop, channel, 0);
+
+        // post the cpu-bound tasks to the thread pool
+        for (i = 0; i < TASK_COUNT; i++)
+            tb_thread_pool_task_post(tb_thread_pool(), "mpmc_channel", tb_demo_coroutine_mpmc_channel_task_done, tb_null, channel, tb_false);
+
+        // wait all tasks
+        tb_thread_pool_task_wait_all(tb_thread_pool(), -1);
+
+        // send the end marks
+        for (i = 0; i < SCHEDULER_COUNT; i++) tb_co_mpmc_channel_send(channel, tb_null);
+
+        // wait the io schedulers
+        for (i = 0; i < SCHEDULER_COUNT; i++)
+        {
+            if (threads[i])
+            {
+                tb_thread_wait(threads[i], -1, tb_null);
+                tb_thread_exit(threads[i]);
+            }
+        }
+
+        // computing time
+        tb_hong_t duration = tb_mclock() - startime;
+
+        // trace
+        tb_trace_i("recv %ld/%d results in %lld ms", tb_atomic_get(&g_received), TASK_COUNT * RESULT_COUNT, duration);
+
+        // exit channel
+        tb_co_mpmc_channel_exit(channel);
+    }
+    return 0;
+}
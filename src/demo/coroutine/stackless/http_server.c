@@ -16,6 +16,9 @@
 // the stack size
 #define TB_DEMO_STACKSIZE   (8192 << 2)
 
+// the cpu count
+#define TB_DEMO_CPU         (1)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */ 
@@ -545,15 +548,22 @@ tb_int_t tb_demo_lo_coroutine_http_server_main(tb_int_t argc, tb_char_t** argv)
     // trace
     tb_trace_i("%s: %s", g_onlydata? "data" : "rootdir", g_rootdir);
 
-    // init scheduler
+    // init scheduler, uses the sharded scheduler for multi-threads
+#if TB_DEMO_CPU == 1 || defined(TB_CONFIG_MICRO_ENABLE)
     tb_lo_scheduler_ref_t scheduler = tb_lo_scheduler_init();
+#else
+    tb_lo_scheduler_ref_t scheduler = tb_lo_scheduler_init_shards(TB_DEMO_CPU);
+#endif
     if (scheduler)
     {
-        // start coroutines
-        tb_lo_coroutine_start(scheduler, tb_demo_lo_coroutine_listen, tb_lo_coroutine_pass(tb_demo_http_listen_t));
+        // start one listening coroutine for each shard, they will bind the same port with SO_REUSEPORT
+        tb_size_t i = 0;
+        tb_size_t n = tb_lo_scheduler_shards(scheduler);
+        for (i = 0; i < n; i++)
+            tb_lo_coroutine_start(scheduler, tb_demo_lo_coroutine_listen, tb_lo_coroutine_pass(tb_demo_http_listen_t));
 
         // run scheduler, enable exclusive mode if be only one cpu
-        tb_lo_scheduler_loop(scheduler, tb_true);
+        tb_lo_scheduler_loop(scheduler, TB_DEMO_CPU == 1);
 
         // exit scheduler
         tb_lo_scheduler_exit(scheduler);
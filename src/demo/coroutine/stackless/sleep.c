@@ -50,11 +50,52 @@ static tb_void_t tb_demo_lo_coroutine_sleep_func(tb_lo_coroutine_ref_t coroutine
     }
 }
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+static tb_void_t tb_demo_lo_coroutine_sleep_shards()
+{
+    // init scheduler with two shards, the io loop of each shard must be started on itself
+    tb_lo_scheduler_ref_t scheduler = tb_lo_scheduler_init_shards(2);
+    if (scheduler)
+    {
+        // start the odd number of coroutines, they will be distributed to all shards
+        tb_demo_lo_sleep_t sleeps[] = 
+        {
+            {10,    5}
+        ,   {20,    5}
+        ,   {30,    5}
+        };
+        tb_size_t i = 0;
+        tb_size_t n = tb_arrayn(sleeps);
+        for (i = 0; i < n; i++)
+            tb_lo_coroutine_start(scheduler, tb_demo_lo_coroutine_sleep_func, &sleeps[i], tb_null);
+
+        // run scheduler on the current thread and the other shard threads
+        tb_lo_scheduler_loop(scheduler, tb_false);
+
+        // all sleeping coroutines have been waked up and finished?
+        tb_bool_t ok = tb_true;
+        for (i = 0; i < n; i++)
+            if (sleeps[i].count != (tb_size_t)-1) ok = tb_false;
+
+        // trace
+        tb_trace_i("[shards]: %s", ok? "ok" : "failed");
+
+        // exit scheduler
+        tb_lo_scheduler_exit(scheduler);
+    }
+}
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_lo_coroutine_sleep_main(tb_int_t argc, tb_char_t** argv)
 {
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // test sleep in the scheduler shards
+    tb_demo_lo_coroutine_sleep_shards();
+#endif
+
     // init scheduler
     tb_lo_scheduler_ref_t scheduler = tb_lo_scheduler_init();
     if (scheduler)
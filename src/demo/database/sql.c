@@ -29,7 +29,9 @@ static tb_void_t tb_demo_database_sql_test_done(tb_database_sql_ref_t database,
 
         // trace
         tb_trace_i("==============================================================================");
-        tb_trace_i("row: size: %lu", tb_iterator_size(result));
+        tb_size_t size = tb_iterator_size(result);
+        if (size != (tb_size_t)-1) tb_trace_i("row: size: %lu", size);
+        else tb_trace_i("row: size: unknown");
 
         // walk result
         tb_for_all_if (tb_iterator_ref_t, row, result, row)
@@ -85,7 +87,9 @@ static tb_void_t tb_demo_database_sql_test_statement_done(tb_database_sql_ref_t
 
         // trace
         tb_trace_i("==============================================================================");
-        tb_trace_i("row: size: %lu", tb_iterator_size(result));
+        tb_size_t size = tb_iterator_size(result);
+        if (size != (tb_size_t)-1) tb_trace_i("row: size: %lu", size);
+        else tb_trace_i("row: size: unknown");
 
         // walk result
         tb_for_all_if (tb_iterator_ref_t, row, result, row)
@@ -204,6 +204,7 @@ TB_DEMO_MAIN_DECL(coroutine_spider);
 TB_DEMO_MAIN_DECL(coroutine_stream);
 TB_DEMO_MAIN_DECL(coroutine_switch);
 TB_DEMO_MAIN_DECL(coroutine_channel);
+TB_DEMO_MAIN_DECL(coroutine_mpmc_channel);
 TB_DEMO_MAIN_DECL(coroutine_semaphore);
 TB_DEMO_MAIN_DECL(coroutine_echo_client);
 TB_DEMO_MAIN_DECL(coroutine_echo_server);
@@ -64,6 +64,7 @@ static tb_demo_hash32_entry_t g_hash32_entries[] =
 ,   { "adler32 ",   tb_adler32_make         }
 ,   { "crc32   ",   tb_crc32_make           }
 ,   { "crc32-le",   tb_crc32_le_make        }
+,   { "crc32c  ",   tb_crc32c_make          }
 ,   { "bkdr    ",   tb_demo_bkdr_make       }
 ,   { "murmur  ",   tb_demo_murmur_make     }
 ,   { "blizzard",   tb_demo_blizzard_make   }
@@ -84,41 +85,31 @@ static tb_void_t tb_demo_hash32_test()
     tb_size_t i = 0;
     for (i = 0; i < size; i++) data[i] = (tb_byte_t)tb_random_range(0, 0xff);
 
-    // done (1M)
-    tb_demo_hash32_entry_ref_t entry = g_hash32_entries;
-    for (; entry && entry->name; entry++)
+    // done (64B, 1K, 64K, 1M), hash 256M data for each size
+    static tb_size_t sizes[] = {64, 1024, 64 * 1024, 1024 * 1024};
+    for (i = 0; i < tb_arrayn(sizes); i++)
     {
-        __tb_volatile__ tb_uint32_t v = 0;
-        __tb_volatile__ tb_uint32_t n = 1000000;
-        __tb_volatile__ tb_hong_t   t = tb_mclock();
-        while (n--)
+        tb_demo_hash32_entry_ref_t entry = g_hash32_entries;
+        for (; entry && entry->name; entry++)
         {
-            v = entry->hash(data, 1024, n);
-        }
-        t = tb_mclock() - t;
-
-        // trace
-        tb_trace_i("[hash(1K)]: %s: %08x %ld ms", entry->name, v, t);
-    }
+            __tb_volatile__ tb_uint32_t v = 0;
+            __tb_volatile__ tb_size_t   n = (256 * 1024 * 1024) / sizes[i];
+            __tb_volatile__ tb_hong_t   t = tb_mclock();
+            while (n--)
+            {
+                v = entry->hash(data, sizes[i], (tb_uint32_t)n);
+            }
+            t = tb_mclock() - t;
 
-    // trace
-    tb_trace_i("");
+            // the throughput (MB/s)
+            tb_size_t rate = (tb_size_t)((256 * 1000) / tb_max(t, 1));
 
-    // done (1M)
-    entry = g_hash32_entries;
-    for (; entry && entry->name; entry++)
-    {
-        __tb_volatile__ tb_uint32_t v = 0;
-        __tb_volatile__ tb_uint32_t n = 1000;
-        __tb_volatile__ tb_hong_t   t = tb_mclock();
-        while (n--)
-        {
-            v = entry->hash(data, size, n);
+            // trace
+            tb_trace_i("[hash(%lu)]: %s: %08x %ld ms, %lu.%02lu GB/s", sizes[i], entry->name, v, t, rate / 1024, (rate % 1024) * 100 / 1024);
         }
-        t = tb_mclock() - t;
 
         // trace
-        tb_trace_i("[hash(1M)]: %s: %08x %ld ms", entry->name, v, t);
+        tb_trace_i("");
     }
 
     // exit data
@@ -9,6 +9,7 @@
 #define TB_TEST_CMP         (1)
 #define TB_TEST_LEN         (1)
 #define TB_TEST_CPY         (1)
+#define TB_TEST_STR         (1)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * compare
@@ -110,6 +111,67 @@ static tb_void_t tb_test_strncpy(tb_char_t const* s2, tb_size_t size)
     tb_printf("%lld ms, tb_test_strncpy(%s, %d) = %s\n", t, s2, size, s1);
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * search
+ */
+static tb_void_t tb_test_strstr(tb_char_t const* s1, tb_char_t const* s2)
+{
+    __tb_volatile__ tb_long_t   n = 1000000;
+    tb_char_t const*            r = tb_null;
+    tb_hong_t t = tb_mclock();
+    while (n--)
+    {
+        r = tb_strstr(s1, s2);
+    }
+    t = tb_mclock() - t;
+    tb_printf("%lld ms, tb_test_strstr(%s, %s) = %ld\n", t, s1, s2, r? r - s1 : -1);
+}
+static tb_void_t tb_test_stristr(tb_char_t const* s1, tb_char_t const* s2)
+{
+    __tb_volatile__ tb_long_t   n = 1000000;
+    tb_char_t const*            r = tb_null;
+    tb_hong_t t = tb_mclock();
+    while (n--)
+    {
+        r = tb_stristr(s1, s2);
+    }
+    t = tb_mclock() - t;
+    tb_printf("%lld ms, tb_test_stristr(%s, %s) = %ld\n", t, s1, s2, r? r - s1 : -1);
+}
+static tb_void_t tb_test_strrstr(tb_char_t const* s1, tb_char_t const* s2)
+{
+    __tb_volatile__ tb_long_t   n = 1000000;
+    tb_char_t const*            r = tb_null;
+    tb_hong_t t = tb_mclock();
+    while (n--)
+    {
+        r = tb_strrstr(s1, s2);
+    }
+    t = tb_mclock() - t;
+    tb_printf("%lld ms, tb_test_strrstr(%s, %s) = %ld\n", t, s1, s2, r? r - s1 : -1);
+}
+static tb_void_t tb_test_strsearch(tb_char_t const* s1, tb_char_t const* s2, tb_size_t mode)
+{
+    // init the precompiled needle
+    tb_strsearch_ref_t search = tb_strsearch_init(s2, tb_strlen(s2), mode);
+    if (search)
+    {
+        __tb_volatile__ tb_long_t   n = 1000000;
+        __tb_volatile__ tb_long_t   r = 0;
+        tb_size_t                   size = tb_strlen(s1);
+        tb_hong_t t = tb_mclock();
+        while (n--)
+        {
+            r = tb_strsearch_find(search, s1, size);
+        }
+        t = tb_mclock() - t;
+        tb_printf("%lld ms, tb_test_strsearch(%s, %s, %s) = %ld, rfind: %ld\n", t, s1, s2, mode & TB_STRSEARCH_MODE_ICASE? "icase" : "none", r, tb_strsearch_rfind(search, s1, size));
+
+        // exit the precompiled needle
+        tb_strsearch_exit(search);
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
@@ -192,5 +254,27 @@ tb_int_t tb_demo_libc_string_main(tb_int_t argc, tb_char_t** argv)
 
 #endif
 
+#if TB_TEST_STR
+    tb_printf("=================================================================\n");
+    tb_test_strstr("", "");
+    tb_test_strstr("1234567890", "");
+    tb_test_strstr("1234567890", "890");
+    tb_test_strstr("abcdefghijklmnopqrstuvwxyz1234567890", "xyz123");
+    tb_test_strstr("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab", "aaaaaaaaaaaaab");
+    tb_test_strstr("Host: tboox.org\r\nContent-Type: text/html\r\nContent-Length: 1024\r\n\r\n", "Content-Length");
+
+    tb_printf("\n");
+    tb_test_stristr("1234567890abcbefg", "ABCBE");
+    tb_test_stristr("Host: tboox.org\r\nContent-Type: text/html\r\nContent-Length: 1024\r\n\r\n", "content-length");
+
+    tb_printf("\n");
+    tb_test_strrstr("abcabcabc", "abc");
+    tb_test_strrstr("abcdefghijklmnopqrstuvwxyz1234567890abcdefghijklmnopqrstuvwxyz1234567890", "xyz123");
+
+    tb_printf("\n");
+    tb_test_strsearch("Host: tboox.org\r\nContent-Type: text/html\r\nContent-Length: 1024\r\n\r\n", "Content-Length", TB_STRSEARCH_MODE_NONE);
+    tb_test_strsearch("Host: tboox.org\r\nContent-Type: text/html\r\nContent-Length: 1024\r\n\r\n", "content-", TB_STRSEARCH_MODE_ICASE);
+#endif
+
     return 0;
 }
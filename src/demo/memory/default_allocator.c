@@ -214,6 +214,70 @@ tb_void_t tb_demo_default_allocator_perf()
     large_allocator = tb_null;
 }
 
+static tb_int_t tb_demo_default_allocator_thread(tb_cpointer_t priv)
+{
+    // the global allocator, it will use the thread cache
+    tb_allocator_ref_t allocator = tb_allocator();
+    tb_assert_and_check_return_val(allocator, -1);
+
+    // malloc and free the small data
+    tb_size_t       i = 0;
+    tb_size_t       n = (tb_size_t)priv;
+    tb_size_t       rand = 0xbeaf;
+    tb_pointer_t    list[64] = {0};
+    for (i = 0; i < n; i++)
+    {
+        // free the previous data
+        tb_size_t index = rand & 63;
+        if (list[index]) tb_allocator_free(allocator, list[index]);
+
+        // make data
+        list[index] = tb_allocator_malloc(allocator, (rand & 511) + 1);
+        tb_assert_and_check_break(list[index]);
+
+        // make rand
+        rand = (rand * 10807 + 1) & 0xffffffff;
+    }
+
+    // free the left data
+    for (i = 0; i < tb_arrayn(list); i++)
+    {
+        if (list[i]) tb_allocator_free(allocator, list[i]);
+    }
+    return 0;
+}
+tb_void_t tb_demo_default_allocator_threads(tb_size_t count);
+tb_void_t tb_demo_default_allocator_threads(tb_size_t count)
+{
+    // the operation count of each thread
+    tb_size_t n = 1000000;
+
+    // done
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[64] = {0};
+    tb_hong_t       time = tb_mclock();
+    if (count > tb_arrayn(threads)) count = tb_arrayn(threads);
+    for (i = 0; i < count; i++)
+    {
+        threads[i] = tb_thread_init(tb_null, tb_demo_default_allocator_thread, (tb_cpointer_t)n, 0);
+        tb_assert_and_check_break(threads[i]);
+    }
+
+    // wait threads
+    for (i = 0; i < count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("threads: %lu, malloc/free: %lu, time: %lld ms", count, count * n, time);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
@@ -223,6 +287,10 @@ tb_int_t tb_demo_memory_default_allocator_main(tb_int_t argc, tb_char_t** argv)
     tb_demo_default_allocator_perf();
 #endif
 
+#if 1
+    tb_demo_default_allocator_threads(argv[1]? tb_atoi(argv[1]) : 4);
+#endif
+
 #if 0
     tb_demo_default_allocator_leak();
 #endif
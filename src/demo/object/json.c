@@ -3,11 +3,91 @@
  */ 
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */ 
+static tb_void_t tb_demo_object_json_number(tb_char_t const* data, tb_bool_t valid, tb_double_t expected)
+{
+    // read object
+    tb_object_ref_t object = tb_object_read_from_data((tb_byte_t const*)data, tb_strlen(data));
+
+    // get the number, the number may be in the array
+    tb_object_ref_t number = object;
+    if (number && tb_object_type(number) == TB_OBJECT_TYPE_ARRAY)
+        number = tb_oc_array_size(number) == 1? tb_oc_array_item(number, 0) : tb_null;
+
+    // check it
+    tb_bool_t ok = tb_false;
+    if (!valid) ok = !object;
+    else if (number && tb_object_type(number) == TB_OBJECT_TYPE_NUMBER)
+    {
+        tb_double_t value = tb_oc_number_double(number);
+        tb_double_t delta = value > expected? value - expected : expected - value;
+        ok = delta <= (expected > 0? expected : -expected) * 1e-6;
+    }
+
+    // trace
+    tb_trace_i("number: %s => %s", data, ok? "ok" : "failed");
+
+    // exit object
+    if (object) tb_object_exit(object);
+}
+
+static tb_void_t tb_demo_object_json_depth(tb_size_t depth)
+{
+    // make the nested arrays
+    tb_char_t* data = tb_malloc_cstr(depth * 2 + 2);
+    tb_assert_and_check_return(data);
+    tb_memset(data, '[', depth);
+    data[depth] = '1';
+    tb_memset(data + depth + 1, ']', depth);
+    data[depth * 2 + 1] = '\0';
+
+    // read object
+    tb_object_ref_t object = tb_object_read_from_data((tb_byte_t const*)data, depth * 2 + 1);
+
+    // trace
+    tb_trace_i("depth: %lu => %s", depth, object && tb_object_type(object) == TB_OBJECT_TYPE_ARRAY? "ok" : "failed");
+
+    // exit it
+    if (object) tb_object_exit(object);
+    tb_free(data);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_object_json_main(tb_int_t argc, tb_char_t** argv)
 {
+    // test the number grammar, @note the json probe need at least 5 characters
+    if (argc < 2)
+    {
+        tb_demo_object_json_number("[ 1 ]", tb_true, 1);
+        tb_demo_object_json_number("[ -5 ]", tb_true, -5);
+        tb_demo_object_json_number("[1.5]", tb_true, 1.5);
+        tb_demo_object_json_number("[-0.25]", tb_true, -0.25);
+        tb_demo_object_json_number("[1e5]", tb_true, 1e5);
+        tb_demo_object_json_number("[2.5E-3]", tb_true, 2.5e-3);
+        tb_demo_object_json_number("[-1e+2]", tb_true, -1e2);
+        tb_demo_object_json_number("[1-2]", tb_false, 0);
+        tb_demo_object_json_number("[1+1]", tb_false, 0);
+        tb_demo_object_json_number("[--5]", tb_false, 0);
+        tb_demo_object_json_number("[1.5.5]", tb_false, 0);
+        tb_demo_object_json_number("[ +1 ]", tb_false, 0);
+        tb_demo_object_json_number("[ .5 ]", tb_false, 0);
+        tb_demo_object_json_number("[ 1e ]", tb_false, 0);
+        tb_demo_object_json_number("[ 1. ]", tb_false, 0);
+        tb_demo_object_json_number("[1e-99999]", tb_true, 0);
+        tb_demo_object_json_number("{\"a\":", tb_false, 0);
+        tb_demo_object_json_number("{\"a\":[1, ", tb_false, 0);
+        tb_demo_object_json_number("{ 1: 2 }", tb_false, 0);
+
+        // test the nesting depth
+        tb_demo_object_json_depth(16);
+        tb_demo_object_json_depth(600);
+        return 0;
+    }
+
     // read object
     tb_object_ref_t object = tb_object_read_from_url(argv[1]);
 
@@ -23,4 +103,3 @@ tb_int_t tb_demo_object_json_main(tb_int_t argc, tb_char_t** argv)
     
     return 0;
 }
-
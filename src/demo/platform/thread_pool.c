@@ -20,11 +20,77 @@ static tb_void_t tb_demo_task_time_exit(tb_thread_pool_worker_ref_t worker, tb_c
     tb_trace_i("exit: %u ms", tb_p2u32(priv));
 }
 
+static tb_void_t tb_demo_task_count_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // count it
+    tb_atomic_fetch_and_add((tb_atomic_t*)priv, 1);
+}
+static tb_void_t tb_demo_thread_pool_bench(tb_thread_pool_ref_t pool, tb_char_t const* name)
+{
+    // check
+    tb_assert_and_check_return(pool);
+
+    // init tasks
+    tb_atomic_t             count = 0;
+    tb_thread_pool_task_t   tasks[1000];
+    tb_size_t               i = 0;
+    for (i = 0; i < tb_arrayn(tasks); i++)
+    {
+        tasks[i].name   = tb_null;
+        tasks[i].done   = tb_demo_task_count_done;
+        tasks[i].exit   = tb_null;
+        tasks[i].priv   = (tb_cpointer_t)&count;
+        tasks[i].urgent = tb_false;
+    }
+
+    // post 1000000 tiny tasks
+    tb_size_t total = 0;
+    tb_hong_t time = tb_mclock();
+    for (i = 0; i < 1000; i++)
+    {
+        // post them, we need wait some time if the jobs queue is full
+        tb_size_t post = 0;
+        while (post < tb_arrayn(tasks))
+        {
+            tb_size_t real = tb_thread_pool_task_post_list(pool, tasks + post, tb_arrayn(tasks) - post);
+            if (!real) tb_sched_yield();
+            post += real;
+        }
+        total += post;
+    }
+
+    // wait all
+    while (tb_atomic_get(&count) < (tb_long_t)total) tb_msleep(1);
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("%s: tasks: %lu, workers: %lu, time: %lld ms", name, total, tb_thread_pool_worker_size(pool), time);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_platform_thread_pool_main(tb_int_t argc, tb_char_t** argv)
 {
+    // bench the default and stealing modes for many tiny tasks
+    if (argc > 1 && !tb_strcmp(argv[1], "bench"))
+    {
+        tb_size_t workers = argc > 2? tb_atoi(argv[2]) : 0;
+        tb_thread_pool_ref_t pool = tb_thread_pool_init(workers, 0);
+        if (pool)
+        {
+            tb_demo_thread_pool_bench(pool, "default");
+            tb_thread_pool_exit(pool);
+        }
+        pool = tb_thread_pool_init_stealing(workers, 0);
+        if (pool)
+        {
+            tb_demo_thread_pool_bench(pool, "stealing");
+            tb_thread_pool_exit(pool);
+        }
+        return 0;
+    }
+
 #if 0
     // post task: 60s
     tb_thread_pool_task_post(tb_thread_pool(), "60000ms", tb_demo_task_time_done, tb_null, (tb_cpointer_t)60000, tb_false);
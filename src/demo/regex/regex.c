@@ -78,6 +78,35 @@ static tb_void_t tb_demo_regex_test_match_global(tb_char_t const* pattern, tb_ch
     // trace
     tb_trace_i("");
 }
+static tb_bool_t tb_demo_regex_test_match_all_func(tb_regex_match_ref_t matches, tb_size_t count, tb_cpointer_t priv)
+{
+    // trace
+    tb_trace_i("[%lu, %lu]: ", matches[0].start, matches[0].size);
+
+    // show matches, the matched string is not null-terminated
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // trace
+        tb_trace_i("    [%lu, %lu]: %.*s", matches[i].start, matches[i].size, (tb_int_t)matches[i].size, matches[i].cstr);
+    }
+
+    // continue
+    return tb_true;
+}
+static tb_size_t tb_demo_regex_test_match_all(tb_char_t const* pattern, tb_char_t const* content)
+{
+    // trace
+    tb_trace_i("match_all: %s, %s", content, pattern);
+
+    // done
+    tb_size_t count = tb_regex_match_all_done(pattern, 0, content, tb_strlen(content), 0, tb_demo_regex_test_match_all_func, tb_null);
+
+    // trace
+    tb_trace_i("count: %lu", count);
+    tb_trace_i("");
+    return count;
+}
 static tb_void_t tb_demo_regex_test_replace_global(tb_char_t const* pattern, tb_char_t const* content, tb_char_t const* replacement)
 {
     // trace
@@ -110,6 +139,12 @@ tb_int_t tb_demo_regex_main(tb_int_t argc, tb_char_t** argv)
     tb_demo_regex_test_match_simple("(\\w+)\\s+?(\\w+)", "hello world");
     tb_demo_regex_test_match_global("(\\w+)\\s+?(\\w+)", "hello world");
 
+    tb_demo_regex_test_match_all("\\w+", "hello world");
+    tb_demo_regex_test_match_all("(\\w+)\\s+?(\\w+)", "hello world");
+
+    // '^' only matches at the beginning of the content, not at the start position of the next match
+    if (tb_demo_regex_test_match_all("^a", "aaa") != 1) tb_trace_e("match_all: ^a: failed");
+
     // test replace
     tb_demo_regex_test_replace_simple("\\w+", "hello world", "hi");
     tb_demo_regex_test_replace_global("\\w+", "hello world", "hi");
@@ -0,0 +1,286 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        sort.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "sort.h"
+#include "../../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* define the introsort for the given plain type
+ *
+ * - the ranges with a few items are sorted by the insertion sort
+ * - the pivot is the median of three and the partition is hoare's scheme,
+ *   so the equal items are split evenly and the sorted input does not degenerate
+ * - we recurse on the smaller partition and loop on the larger one,
+ *   and switch to the heap sort if the depth reaches 2 * log2(n)
+ */
+#define TB_SORT_IMPL_INTRO_DEFINE(name, type_t) \
+static tb_void_t tb_sort_impl_insert_##name(type_t* data, tb_size_t size) \
+{ \
+    tb_size_t i; \
+    tb_size_t j; \
+    for (i = 1; i < size; i++) \
+    { \
+        type_t item = data[i]; \
+        for (j = i; j && item < data[j - 1]; j--) data[j] = data[j - 1]; \
+        data[j] = item; \
+    } \
+} \
+static tb_void_t tb_sort_impl_sift_##name(type_t* data, tb_size_t root, tb_size_t size) \
+{ \
+    type_t      item = data[root]; \
+    tb_size_t   child; \
+    while ((child = (root << 1) + 1) < size) \
+    { \
+        if (child + 1 < size && data[child] < data[child + 1]) child++; \
+        if (!(item < data[child])) break; \
+        data[root] = data[child]; \
+        root = child; \
+    } \
+    data[root] = item; \
+} \
+static tb_void_t tb_sort_impl_heap_##name(type_t* data, tb_size_t size) \
+{ \
+    tb_size_t i; \
+    for (i = size >> 1; i--; ) tb_sort_impl_sift_##name(data, i, size); \
+    for (i = size - 1; i > 0; i--) \
+    { \
+        tb_swap(type_t, data[0], data[i]); \
+        tb_sort_impl_sift_##name(data, 0, i); \
+    } \
+} \
+static tb_void_t tb_sort_impl_intro_##name(type_t* data, tb_size_t size, tb_size_t depth) \
+{ \
+    while (size > TB_SORT_IMPL_INSERT_MAXN) \
+    { \
+        if (!depth) \
+        { \
+            tb_sort_impl_heap_##name(data, size); \
+            return ; \
+        } \
+        depth--; \
+        tb_size_t last = size - 1; \
+        tb_size_t middle = size >> 1; \
+        if (data[middle] < data[0]) tb_swap(type_t, data[middle], data[0]); \
+        if (data[last] < data[middle]) \
+        { \
+            tb_swap(type_t, data[last], data[middle]); \
+            if (data[middle] < data[0]) tb_swap(type_t, data[middle], data[0]); \
+        } \
+        type_t      pivot = data[middle]; \
+        tb_size_t   i = 0; \
+        tb_size_t   j = last; \
+        for (;;) \
+        { \
+            do i++; while (data[i] < pivot); \
+            do j--; while (pivot < data[j]); \
+            if (i >= j) break; \
+            tb_swap(type_t, data[i], data[j]); \
+        } \
+        if (i < size - i) \
+        { \
+            tb_sort_impl_intro_##name(data, i, depth); \
+            data += i; \
+            size -= i; \
+        } \
+        else \
+        { \
+            tb_sort_impl_intro_##name(data + i, size - i, depth); \
+            size = i; \
+        } \
+    } \
+    tb_sort_impl_insert_##name(data, size); \
+}
+
+/* define the lsd radix sort for the given plain type
+ *
+ * the items are sorted by one byte in each pass from the lowest byte,
+ * and the pass will be skipped if all items have the same byte.
+ * the sign bit of the signed key is flipped to keep the order of the negative numbers.
+ */
+#define TB_SORT_IMPL_RADIX_DEFINE(name, type_t, key_t, flip) \
+static tb_bool_t tb_sort_impl_radix_##name(type_t* data, tb_size_t size) \
+{ \
+    tb_size_t*  counts = (tb_size_t*)tb_nalloc0(sizeof(type_t) << 8, sizeof(tb_size_t)); \
+    type_t*     temp = (type_t*)tb_nalloc(size, sizeof(type_t)); \
+    if (!counts || !temp) \
+    { \
+        if (counts) tb_free(counts); \
+        if (temp) tb_free(temp); \
+        return tb_false; \
+    } \
+    tb_size_t i; \
+    tb_size_t b; \
+    for (i = 0; i < size; i++) \
+    { \
+        key_t key = (key_t)data[i] ^ (flip); \
+        for (b = 0; b < sizeof(type_t); b++) counts[(b << 8) + ((key >> (b << 3)) & 0xff)]++; \
+    } \
+    type_t* src = data; \
+    type_t* dst = temp; \
+    for (b = 0; b < sizeof(type_t); b++) \
+    { \
+        tb_size_t*  count = counts + (b << 8); \
+        tb_size_t   shift = b << 3; \
+        if (count[(((key_t)src[0] ^ (flip)) >> shift) & 0xff] == size) continue; \
+        tb_size_t offset = 0; \
+        for (i = 0; i < 256; i++) \
+        { \
+            tb_size_t n = count[i]; \
+            count[i] = offset; \
+            offset += n; \
+        } \
+        for (i = 0; i < size; i++) dst[count[(((key_t)src[i] ^ (flip)) >> shift) & 0xff]++] = src[i]; \
+        tb_swap(type_t*, src, dst); \
+    } \
+    if (src != data) tb_memcpy(data, src, size * sizeof(type_t)); \
+    tb_free(temp); \
+    tb_free(counts); \
+    return tb_true; \
+}
+
+// define the stable merge for the given plain type
+#define TB_SORT_IMPL_MERGE_DEFINE(name, type_t) \
+static tb_void_t tb_sort_impl_merge_##name(type_t* data, type_t const* ldata, tb_size_t lsize, type_t const* rdata, tb_size_t rsize) \
+{ \
+    type_t const* ltail = ldata + lsize; \
+    type_t const* rtail = rdata + rsize; \
+    while (ldata < ltail && rdata < rtail) *data++ = (*rdata < *ldata)? *rdata++ : *ldata++; \
+    if (ldata < ltail) tb_memcpy(data, ldata, (ltail - ldata) * sizeof(type_t)); \
+    if (rdata < rtail) tb_memcpy(data, rdata, (rtail - rdata) * sizeof(type_t)); \
+}
+
+// define all sorters for the given plain type
+#define TB_SORT_IMPL_DEFINE(name, type_t, key_t, flip) \
+    TB_SORT_IMPL_INTRO_DEFINE(name, type_t) \
+    TB_SORT_IMPL_RADIX_DEFINE(name, type_t, key_t, flip) \
+    TB_SORT_IMPL_MERGE_DEFINE(name, type_t)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+TB_SORT_IMPL_DEFINE(long,   tb_long_t,      tb_size_t,      (tb_size_t)1 << ((sizeof(tb_size_t) << 3) - 1))
+TB_SORT_IMPL_DEFINE(size,   tb_size_t,      tb_size_t,      0)
+TB_SORT_IMPL_DEFINE(uint8,  tb_uint8_t,     tb_uint8_t,     0)
+TB_SORT_IMPL_DEFINE(uint16, tb_uint16_t,    tb_uint16_t,    0)
+TB_SORT_IMPL_DEFINE(uint32, tb_uint32_t,    tb_uint32_t,    0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_pointer_t tb_sort_impl_data(tb_iterator_ref_t iterator, tb_iterator_comp_t comp, tb_size_t* type)
+{
+    // check
+    tb_assert(iterator && type);
+
+    // only for the default comparer
+    *type = TB_ITERATOR_DATA_TYPE_NONE;
+    tb_check_return_val(!comp || comp == tb_iterator_comp, tb_null);
+
+    // the data
+    tb_pointer_t data = tb_iterator_data(iterator, type);
+    tb_check_return_val(data, tb_null);
+
+    // the step must be the same as the data type
+    if (tb_iterator_step(iterator) != tb_sort_impl_step(*type))
+    {
+        *type = TB_ITERATOR_DATA_TYPE_NONE;
+        return tb_null;
+    }
+
+    // ok
+    return data;
+}
+tb_size_t tb_sort_impl_step(tb_size_t type)
+{
+    switch (type)
+    {
+    case TB_ITERATOR_DATA_TYPE_LONG:    return sizeof(tb_long_t);
+    case TB_ITERATOR_DATA_TYPE_SIZE:    return sizeof(tb_size_t);
+    case TB_ITERATOR_DATA_TYPE_UINT8:   return sizeof(tb_uint8_t);
+    case TB_ITERATOR_DATA_TYPE_UINT16:  return sizeof(tb_uint16_t);
+    case TB_ITERATOR_DATA_TYPE_UINT32:  return sizeof(tb_uint32_t);
+    default:                            return 0;
+    }
+}
+tb_bool_t tb_sort_impl_intro(tb_pointer_t data, tb_size_t type, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data, tb_false);
+
+    // sort it
+    tb_size_t depth = tb_sort_impl_depth(size);
+    switch (type)
+    {
+    case TB_ITERATOR_DATA_TYPE_LONG:    tb_sort_impl_intro_long((tb_long_t*)data, size, depth);         break;
+    case TB_ITERATOR_DATA_TYPE_SIZE:    tb_sort_impl_intro_size((tb_size_t*)data, size, depth);         break;
+    case TB_ITERATOR_DATA_TYPE_UINT8:   tb_sort_impl_intro_uint8((tb_uint8_t*)data, size, depth);       break;
+    case TB_ITERATOR_DATA_TYPE_UINT16:  tb_sort_impl_intro_uint16((tb_uint16_t*)data, size, depth);     break;
+    case TB_ITERATOR_DATA_TYPE_UINT32:  tb_sort_impl_intro_uint32((tb_uint32_t*)data, size, depth);     break;
+    default:                            return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_sort_impl_radix(tb_pointer_t data, tb_size_t type, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data, tb_false);
+
+    // no items?
+    tb_check_return_val(size, tb_true);
+
+    // sort it
+    switch (type)
+    {
+    case TB_ITERATOR_DATA_TYPE_LONG:    return tb_sort_impl_radix_long((tb_long_t*)data, size);
+    case TB_ITERATOR_DATA_TYPE_SIZE:    return tb_sort_impl_radix_size((tb_size_t*)data, size);
+    case TB_ITERATOR_DATA_TYPE_UINT8:   return tb_sort_impl_radix_uint8((tb_uint8_t*)data, size);
+    case TB_ITERATOR_DATA_TYPE_UINT16:  return tb_sort_impl_radix_uint16((tb_uint16_t*)data, size);
+    case TB_ITERATOR_DATA_TYPE_UINT32:  return tb_sort_impl_radix_uint32((tb_uint32_t*)data, size);
+    default:                            return tb_false;
+    }
+}
+tb_bool_t tb_sort_impl_merge(tb_pointer_t data, tb_cpointer_t ldata, tb_size_t lsize, tb_cpointer_t rdata, tb_size_t rsize, tb_size_t type)
+{
+    // check
+    tb_assert_and_check_return_val(data && ldata && rdata, tb_false);
+
+    // merge it
+    switch (type)
+    {
+    case TB_ITERATOR_DATA_TYPE_LONG:    tb_sort_impl_merge_long((tb_long_t*)data, (tb_long_t const*)ldata, lsize, (tb_long_t const*)rdata, rsize);              break;
+    case TB_ITERATOR_DATA_TYPE_SIZE:    tb_sort_impl_merge_size((tb_size_t*)data, (tb_size_t const*)ldata, lsize, (tb_size_t const*)rdata, rsize);              break;
+    case TB_ITERATOR_DATA_TYPE_UINT8:   tb_sort_impl_merge_uint8((tb_uint8_t*)data, (tb_uint8_t const*)ldata, lsize, (tb_uint8_t const*)rdata, rsize);          break;
+    case TB_ITERATOR_DATA_TYPE_UINT16:  tb_sort_impl_merge_uint16((tb_uint16_t*)data, (tb_uint16_t const*)ldata, lsize, (tb_uint16_t const*)rdata, rsize);      break;
+    case TB_ITERATOR_DATA_TYPE_UINT32:  tb_sort_impl_merge_uint32((tb_uint32_t*)data, (tb_uint32_t const*)ldata, lsize, (tb_uint32_t const*)rdata, rsize);      break;
+    default:                            return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
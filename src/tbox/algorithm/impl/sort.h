@@ -0,0 +1,119 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        sort.h
+ *
+ */
+#ifndef TB_ALGORITHM_IMPL_SORT_H
+#define TB_ALGORITHM_IMPL_SORT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum count of the items sorted by the insertion sort in the introsort
+#define TB_SORT_IMPL_INSERT_MAXN            (16)
+
+// the minimum count of the items sorted by the radix sort in tb_sort()
+#define TB_SORT_IMPL_RADIX_MINN             (1 << 12)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/* the maximum recursive depth of the introsort, 2 * log2(size)
+ *
+ * we will switch to the heap sort if the partitions are too unbalanced
+ */
+static __tb_inline__ tb_size_t tb_sort_impl_depth(tb_size_t size)
+{
+    tb_size_t depth = 0;
+    for (; size > 1; size >>= 1) depth += 2;
+    return depth;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* the contiguous items data of the iterator for sorting
+ *
+ * @param iterator  the iterator
+ * @param comp      the comparer, only the default comparer is supported
+ * @param type      the data type
+ *
+ * @return          the data, return tb_null if not supported
+ */
+tb_pointer_t        tb_sort_impl_data(tb_iterator_ref_t iterator, tb_iterator_comp_t comp, tb_size_t* type);
+
+/* the item size of the given data type
+ *
+ * @param type      the data type
+ *
+ * @return          the item size
+ */
+tb_size_t           tb_sort_impl_step(tb_size_t type);
+
+/* sort the contiguous items using the introsort
+ *
+ * @param data      the items data
+ * @param type      the data type
+ * @param size      the items count
+ *
+ * @return          tb_true if the data type is supported
+ */
+tb_bool_t           tb_sort_impl_intro(tb_pointer_t data, tb_size_t type, tb_size_t size);
+
+/* sort the contiguous items using the lsd radix sort, it need O(n) temporary space
+ *
+ * @param data      the items data
+ * @param type      the data type
+ * @param size      the items count
+ *
+ * @return          tb_true if the data type is supported and the temporary space has been allocated
+ */
+tb_bool_t           tb_sort_impl_radix(tb_pointer_t data, tb_size_t type, tb_size_t size);
+
+/* merge the two sorted contiguous items to the data, it is stable
+ *
+ * @param data      the merged data, it should not overlap the given items
+ * @param ldata     the left items data
+ * @param lsize     the left items count
+ * @param rdata     the right items data
+ * @param rsize     the right items count
+ * @param type      the data type
+ *
+ * @return          tb_true if the data type is supported
+ */
+tb_bool_t           tb_sort_impl_merge(tb_pointer_t data, tb_cpointer_t ldata, tb_size_t lsize, tb_cpointer_t rdata, tb_size_t rsize, tb_size_t type);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,403 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        parallel_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "parallel_sort.h"
+#include "sort.h"
+#include "impl/sort.h"
+#include "../libc/libc.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum items count of each part
+#ifdef __tb_small__
+#   define TB_PARALLEL_SORT_PART_MINN       (1 << 14)
+#else
+#   define TB_PARALLEL_SORT_PART_MINN       (1 << 16)
+#endif
+
+// the maximum parts count
+#define TB_PARALLEL_SORT_PART_MAXN          (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the parallel sorter type
+struct __tb_parallel_sort_t;
+
+// the parallel sort job func type
+typedef tb_void_t                   (*tb_parallel_sort_job_func_t)(struct __tb_parallel_sort_t* sort, tb_size_t job);
+
+// the parallel sort round type
+typedef struct __tb_parallel_sort_round_t
+{
+    // the sorter, it is only accessed after claiming a job
+    struct __tb_parallel_sort_t*    sort;
+
+    // the job func
+    tb_parallel_sort_job_func_t     func;
+
+    // the jobs count
+    tb_size_t                       count;
+
+    // the next job index
+    tb_atomic_t                     index;
+
+    // the finished jobs count
+    tb_atomic_t                     finished;
+
+    // the semaphore for notifying the finished jobs
+    tb_semaphore_ref_t              semaphore;
+
+    // the reference count
+    tb_atomic_t                     refn;
+
+}tb_parallel_sort_round_t;
+
+// the parallel sorter type
+typedef struct __tb_parallel_sort_t
+{
+    // the iterator
+    tb_iterator_ref_t               iterator;
+
+    // the comparer
+    tb_iterator_comp_t              comp;
+
+    // the head itor
+    tb_size_t                       head;
+
+    // the items count
+    tb_size_t                       size;
+
+    // the parts count
+    tb_size_t                       parts;
+
+    // the merged parts count of the current round
+    tb_size_t                       width;
+
+    // the contiguous data type, the items are merged in the iterator data if be not none
+    tb_size_t                       type;
+
+    // the item size in the merge buffer
+    tb_size_t                       step;
+
+    // the item is stored as a pointer in the merge buffer?
+    tb_bool_t                       small;
+
+    // the source items
+    tb_byte_t*                      src;
+
+    // the merged items
+    tb_byte_t*                      dst;
+
+}tb_parallel_sort_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * round implementation
+ */
+static tb_size_t tb_parallel_sort_round_work(tb_parallel_sort_round_t* round)
+{
+    // claim and do the jobs
+    tb_size_t job;
+    tb_size_t count = 0;
+    while ((job = (tb_size_t)tb_atomic_fetch_and_inc(&round->index)) < round->count)
+    {
+        round->func(round->sort, job);
+        count++;
+    }
+    return count;
+}
+static tb_void_t tb_parallel_sort_round_exit(tb_parallel_sort_round_t* round)
+{
+    // check
+    tb_assert_and_check_return(round);
+
+    // refn--, exit it if be the last reference
+    if (tb_atomic_fetch_and_dec(&round->refn) == 1)
+    {
+        if (round->semaphore) tb_semaphore_exit(round->semaphore);
+        tb_free(round);
+    }
+}
+static tb_void_t tb_parallel_sort_round_task_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    tb_parallel_sort_round_t* round = (tb_parallel_sort_round_t*)priv;
+    tb_assert_and_check_return(round);
+
+    // help to do the remaining jobs and notify the caller
+    tb_size_t count = tb_parallel_sort_round_work(round);
+    if (count)
+    {
+        tb_atomic_fetch_and_add(&round->finished, count);
+        tb_semaphore_post(round->semaphore, 1);
+    }
+}
+static tb_void_t tb_parallel_sort_round_task_exit(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    tb_parallel_sort_round_exit((tb_parallel_sort_round_t*)priv);
+}
+
+/* do all jobs of the round in parallel
+ *
+ * the current thread also does the jobs, and the posted tasks only do the jobs which have not been claimed, 
+ * so it will not be deadlocked even if the thread pool is busy or all tasks are done in the current thread.
+ */
+static tb_void_t tb_parallel_sort_round(tb_parallel_sort_t* sort, tb_parallel_sort_job_func_t func, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return(sort && func && count);
+
+    // init round
+    tb_parallel_sort_round_t* round = tb_malloc0_type(tb_parallel_sort_round_t);
+    if (round) 
+    {
+        round->sort      = sort;
+        round->func      = func;
+        round->count     = count;
+        round->semaphore = tb_semaphore_init(0);
+        tb_atomic_set(&round->refn, 1);
+    }
+
+    // do all jobs in the current thread if failed
+    if (!round || !round->semaphore)
+    {
+        tb_size_t job;
+        for (job = 0; job < count; job++) func(sort, job);
+        if (round) tb_parallel_sort_round_exit(round);
+        return ;
+    }
+
+    // post tasks to the thread pool
+    tb_size_t i;
+    tb_size_t n = tb_min(count, tb_processor_count()) - 1;
+    for (i = 0; i < n; i++)
+    {
+        tb_atomic_fetch_and_inc(&round->refn);
+        if (!tb_thread_pool_task_post(tb_thread_pool(), "parallel_sort", tb_parallel_sort_round_task_done, tb_parallel_sort_round_task_exit, round, tb_false))
+        {
+            tb_atomic_fetch_and_dec(&round->refn);
+            break;
+        }
+    }
+
+    // do jobs in the current thread
+    tb_atomic_fetch_and_add(&round->finished, tb_parallel_sort_round_work(round));
+
+    // wait the jobs of the thread pool
+    while ((tb_size_t)tb_atomic_get(&round->finished) < count)
+        tb_semaphore_wait(round->semaphore, -1);
+
+    // exit round
+    tb_parallel_sort_round_exit(round);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * job implementation
+ */
+static __tb_inline__ tb_size_t tb_parallel_sort_bound(tb_parallel_sort_t* sort, tb_size_t part)
+{
+    // the part is out of range?
+    if (part >= sort->parts) return sort->size;
+
+    // the head of the part, the first (size % parts) parts have one more item
+    return (sort->size / sort->parts) * part + tb_min(part, sort->size % sort->parts);
+}
+static __tb_inline__ tb_cpointer_t tb_parallel_sort_item(tb_parallel_sort_t* sort, tb_byte_t const* slot)
+{
+    return sort->small? *((tb_cpointer_t const*)slot) : (tb_cpointer_t)slot;
+}
+static tb_void_t tb_parallel_sort_job_sort(tb_parallel_sort_t* sort, tb_size_t job)
+{
+    // sort this part
+    tb_size_t head = tb_parallel_sort_bound(sort, job);
+    tb_size_t tail = tb_parallel_sort_bound(sort, job + 1);
+    tb_sort(sort->iterator, sort->head + head, sort->head + tail, sort->comp);
+
+    // the contiguous data? it will be merged in place
+    tb_check_return(sort->type == TB_ITERATOR_DATA_TYPE_NONE);
+
+    // copy the sorted items to the merge buffer
+    tb_size_t   itor;
+    tb_byte_t*  slot = sort->src + head * sort->step;
+    for (itor = sort->head + head; itor < sort->head + tail; itor++, slot += sort->step)
+    {
+        tb_cpointer_t item = tb_iterator_item(sort->iterator, itor);
+        if (sort->small) *((tb_cpointer_t*)slot) = item;
+        else tb_memcpy(slot, item, sort->step);
+    }
+}
+static tb_void_t tb_parallel_sort_job_merge(tb_parallel_sort_t* sort, tb_size_t job)
+{
+    // the left part [head, middle) and the right part [middle, tail)
+    tb_size_t   step    = sort->step;
+    tb_size_t   head    = tb_parallel_sort_bound(sort, job * (sort->width << 1));
+    tb_size_t   middle  = tb_parallel_sort_bound(sort, job * (sort->width << 1) + sort->width);
+    tb_size_t   tail    = tb_parallel_sort_bound(sort, job * (sort->width << 1) + (sort->width << 1));
+
+    // merge the contiguous data
+    if (sort->type != TB_ITERATOR_DATA_TYPE_NONE)
+    {
+        tb_sort_impl_merge(sort->dst + head * step, sort->src + head * step, middle - head, sort->src + middle * step, tail - middle, sort->type);
+        return ;
+    }
+
+    // merge the items in the merge buffer, it is stable
+    tb_iterator_comp_t  comp    = sort->comp;
+    tb_byte_t*          data    = sort->dst + head * step;
+    tb_byte_t const*    ldata   = sort->src + head * step;
+    tb_byte_t const*    ltail   = sort->src + middle * step;
+    tb_byte_t const*    rdata   = ltail;
+    tb_byte_t const*    rtail   = sort->src + tail * step;
+    while (ldata < ltail && rdata < rtail)
+    {
+        if (comp(sort->iterator, tb_parallel_sort_item(sort, rdata), tb_parallel_sort_item(sort, ldata)) < 0)
+        {
+            tb_memcpy(data, rdata, step);
+            rdata += step;
+        }
+        else
+        {
+            tb_memcpy(data, ldata, step);
+            ldata += step;
+        }
+        data += step;
+    }
+    if (ldata < ltail) tb_memcpy(data, ldata, ltail - ldata);
+    if (rdata < rtail) tb_memcpy(data, rdata, rtail - rdata);
+}
+static tb_void_t tb_parallel_sort_job_copy(tb_parallel_sort_t* sort, tb_size_t job)
+{
+    // copy the merged items of this part to the iterator
+    tb_size_t   head = tb_parallel_sort_bound(sort, job);
+    tb_size_t   tail = tb_parallel_sort_bound(sort, job + 1);
+    tb_byte_t*  slot = sort->src + head * sort->step;
+    for (; head < tail; head++, slot += sort->step)
+        tb_iterator_copy(sort->iterator, sort->head + head, tb_parallel_sort_item(sort, slot));
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_parallel_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(iterator);
+
+    // no elements?
+    tb_check_return(head != tail);
+
+    // readonly?
+    tb_assert_and_check_return(!(tb_iterator_mode(iterator) & TB_ITERATOR_MODE_READONLY));
+
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // done
+    tb_byte_t*  buff = tb_null;
+    tb_bool_t   ok = tb_false;
+    do
+    {
+        // only for the random access iterator
+        tb_check_break(tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS);
+
+        // the parts count, it is the power of two
+        tb_size_t size = tail - head;
+        tb_size_t maxn = tb_min(tb_processor_count(), size / TB_PARALLEL_SORT_PART_MINN);
+        tb_size_t parts = 1;
+        while ((parts << 1) <= maxn && (parts << 1) <= TB_PARALLEL_SORT_PART_MAXN) parts <<= 1;
+        tb_check_break(parts > 1);
+
+        // init sorter
+        tb_parallel_sort_t sort;
+        tb_memset(&sort, 0, sizeof(tb_parallel_sort_t));
+        sort.iterator   = iterator;
+        sort.comp       = comp? comp : tb_iterator_comp;
+        sort.head       = head;
+        sort.size       = size;
+        sort.parts      = parts;
+
+        /* init the merge buffers
+         *
+         * the contiguous data will be merged in place with one buffer,
+         * and the other items will be copied to the merge buffers first
+         */
+        tb_byte_t* data = (tb_byte_t*)tb_sort_impl_data(iterator, comp, &sort.type);
+        if (data)
+        {
+            sort.step   = tb_iterator_step(iterator);
+            buff        = (tb_byte_t*)tb_nalloc(size, sort.step);
+            tb_check_break(buff);
+            sort.src    = data + head * sort.step;
+            sort.dst    = buff;
+        }
+        else
+        {
+            sort.small  = tb_iterator_step(iterator) <= sizeof(tb_pointer_t);
+            sort.step   = sort.small? sizeof(tb_pointer_t) : tb_iterator_step(iterator);
+            buff        = (tb_byte_t*)tb_nalloc(size << 1, sort.step);
+            tb_check_break(buff);
+            sort.src    = buff;
+            sort.dst    = buff + size * sort.step;
+        }
+
+        // sort all parts
+        tb_parallel_sort_round(&sort, tb_parallel_sort_job_sort, parts);
+
+        // merge the neighbouring parts
+        for (sort.width = 1; sort.width < parts; sort.width <<= 1)
+        {
+            tb_parallel_sort_round(&sort, tb_parallel_sort_job_merge, parts / (sort.width << 1));
+            tb_swap(tb_byte_t*, sort.src, sort.dst);
+        }
+
+        // copy the merged items back
+        if (data) 
+        {
+            if (sort.src != data + head * sort.step) tb_memcpy(data + head * sort.step, sort.src, size * sort.step);
+        }
+        else tb_parallel_sort_round(&sort, tb_parallel_sort_job_copy, parts);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit buffer
+    if (buff) tb_free(buff);
+    buff = tb_null;
+
+    // done
+    if (ok) return ;
+#endif
+
+    // the items are too few or no enough memory, uses the generic sorter
+    tb_sort(iterator, head, tail, comp);
+}
+tb_void_t tb_parallel_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp)
+{
+    tb_parallel_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), comp);
+}
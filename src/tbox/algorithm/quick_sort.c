@@ -24,67 +24,139 @@
  * includes
  */
 #include "quick_sort.h"
+#include "heap_sort.h"
+#include "impl/sort.h"
 #include "../libc/libc.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * private implementation
  */
-tb_void_t tb_quick_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
-{   
-    // check
-    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
-    tb_check_return(head != tail);
-
-    // init
-    tb_size_t       step = tb_iterator_step(iterator);
-    tb_pointer_t    key = step > sizeof(tb_pointer_t)? tb_malloc(step) : tb_null;
-    tb_assert_and_check_return(step <= sizeof(tb_pointer_t) || key);
+static __tb_inline__ tb_cpointer_t tb_quick_sort_load(tb_iterator_ref_t iterator, tb_size_t itor, tb_pointer_t buff, tb_size_t step)
+{
+    // the small item is the value self
+    tb_cpointer_t item = tb_iterator_item(iterator, itor);
+    tb_check_return_val(step > sizeof(tb_pointer_t), item);
 
-    // the comparer
-    if (!comp) comp = tb_iterator_comp;
+    // copy the large item to the buffer
+    tb_memcpy(buff, item, step);
+    return buff;
+}
+static __tb_inline__ tb_void_t tb_quick_sort_swap(tb_iterator_ref_t iterator, tb_size_t litor, tb_size_t ritor, tb_pointer_t buff, tb_size_t step)
+{
+    tb_cpointer_t item = tb_quick_sort_load(iterator, litor, buff, step);
+    tb_iterator_copy(iterator, litor, tb_iterator_item(iterator, ritor));
+    tb_iterator_copy(iterator, ritor, item);
+}
+static tb_void_t tb_quick_sort_insert(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp, tb_pointer_t buff, tb_size_t step)
+{
+    tb_size_t i;
+    tb_size_t j;
+    for (i = head + 1; i < tail; i++)
+    {
+        // save item
+        tb_cpointer_t item = tb_quick_sort_load(iterator, i, buff, step);
 
-    // hole => key
-    if (step <= sizeof(tb_pointer_t)) key = tb_iterator_item(iterator, head);
-    else tb_memcpy(key, tb_iterator_item(iterator, head), step);
+        // move the larger items [j, i - 1] => [j + 1, i]
+        for (j = i; j > head && comp(iterator, item, tb_iterator_item(iterator, j - 1)) < 0; j--)
+            tb_iterator_copy(iterator, j, tb_iterator_item(iterator, j - 1));
 
-    // quick_sort
-    tb_size_t l = head;
-    tb_size_t r = tail - 1;
-    while (r > l)
+        // item => hole
+        if (j != i) tb_iterator_copy(iterator, j, item);
+    }
+}
+static tb_void_t tb_quick_sort_intro(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp, tb_pointer_t buff, tb_size_t step, tb_size_t depth)
+{
+    while (tail - head > TB_SORT_IMPL_INSERT_MAXN)
     {
-        // find: <= 
-        for (; r != l; r--)
-            if (comp(iterator, tb_iterator_item(iterator, r), key) < 0) break;
-        if (r != l) 
+        // the partitions are too unbalanced? switch to the heap sort
+        if (!depth)
+        {
+            tb_heap_sort(iterator, head, tail, comp);
+            return ;
+        }
+        depth--;
+
+        // the median of three => head
+        tb_size_t last = tail - 1;
+        tb_size_t middle = head + ((tail - head) >> 1);
+        if (comp(iterator, tb_iterator_item(iterator, middle), tb_iterator_item(iterator, head)) < 0)
+            tb_quick_sort_swap(iterator, middle, head, buff, step);
+        if (comp(iterator, tb_iterator_item(iterator, last), tb_iterator_item(iterator, middle)) < 0)
+        {
+            tb_quick_sort_swap(iterator, last, middle, buff, step);
+            if (comp(iterator, tb_iterator_item(iterator, middle), tb_iterator_item(iterator, head)) < 0)
+                tb_quick_sort_swap(iterator, middle, head, buff, step);
+        }
+        tb_quick_sort_swap(iterator, head, middle, buff, step);
+
+        // hole => key
+        tb_cpointer_t key = tb_quick_sort_load(iterator, head, buff, step);
+
+        /* partition, the scanning stops at the equal items, 
+         * so many duplicate items will be split evenly
+         */
+        tb_size_t l = head;
+        tb_size_t r = last;
+        while (l < r)
         {
-            tb_iterator_copy(iterator, l, tb_iterator_item(iterator, r));
-            l++;
+            // find: <=
+            while (l < r && comp(iterator, tb_iterator_item(iterator, r), key) > 0) r--;
+            if (l < r) tb_iterator_copy(iterator, l++, tb_iterator_item(iterator, r));
+
+            // find: =>
+            while (l < r && comp(iterator, tb_iterator_item(iterator, l), key) < 0) l++;
+            if (l < r) tb_iterator_copy(iterator, r--, tb_iterator_item(iterator, l));
         }
 
-        // find: =>
-        for (; l != r; l++)
-            if (comp(iterator, tb_iterator_item(iterator, l), key) > 0) break;
-        if (l != r) 
+        // key => hole
+        tb_iterator_copy(iterator, l, key);
+
+        // sort the smaller partition recursively and loop for the larger one, the stack depth is O(log(n))
+        if (l - head < tail - l)
+        {
+            tb_quick_sort_intro(iterator, head, l, comp, buff, step, depth);
+            head = l + 1;
+        }
+        else
         {
-            tb_iterator_copy(iterator, r, tb_iterator_item(iterator, l));
-            r--;
+            tb_quick_sort_intro(iterator, l + 1, tail, comp, buff, step, depth);
+            tail = l;
         }
     }
 
-    // key => hole
-    tb_iterator_copy(iterator, l, key);
+    // sort the small range
+    tb_quick_sort_insert(iterator, head, tail, comp, buff, step);
+}
 
-    // quick_sort [head, hole - 1]
-    tb_quick_sort(iterator, head, l, comp);
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_quick_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
+{   
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
+    tb_check_return(head != tail);
+
+    // the contiguous integer items with the default comparer? sort them directly
+    tb_size_t       type = TB_ITERATOR_DATA_TYPE_NONE;
+    tb_size_t       step = tb_iterator_step(iterator);
+    tb_byte_t*      data = (tb_byte_t*)tb_sort_impl_data(iterator, comp, &type);
+    if (data && tb_sort_impl_intro(data + head * step, type, tail - head)) return ;
 
-    // quick_sort [hole + 1, tail]
-    tb_quick_sort(iterator, ++l, tail, comp);
+    // init buffer for the large item
+    tb_pointer_t    buff = step > sizeof(tb_pointer_t)? tb_malloc(step) : tb_null;
+    tb_assert_and_check_return(step <= sizeof(tb_pointer_t) || buff);
+
+    // the comparer
+    if (!comp) comp = tb_iterator_comp;
+
+    // introsort
+    tb_quick_sort_intro(iterator, head, tail, comp, buff, step, tb_sort_impl_depth(tail - head));
 
     // free
-    if (key && step > sizeof(tb_pointer_t)) tb_free(key);
+    if (buff) tb_free(buff);
 }
 tb_void_t tb_quick_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp)
 {
     tb_quick_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), comp);
 }
-
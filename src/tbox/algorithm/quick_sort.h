@@ -37,6 +37,9 @@ __tb_extern_c_enter__
  */
 
 /*! the quick sorter, O(nlog(n))
+ *
+ * it is an introsort, the partitions which are too deep will be sorted by the heap sort,
+ * and the contiguous integer items with the default comparer will be sorted directly.
  *
  * @param iterator  the iterator
  * @param head      the iterator head
@@ -0,0 +1,55 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        radix_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "radix_sort.h"
+#include "sort.h"
+#include "impl/sort.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_radix_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail)
+{
+    // check
+    tb_assert_and_check_return(iterator);
+
+    // no elements?
+    tb_check_return(head != tail);
+
+    // readonly?
+    tb_assert_and_check_return(!(tb_iterator_mode(iterator) & TB_ITERATOR_MODE_READONLY));
+
+    // the contiguous integer items? sort them using the radix sort
+    tb_size_t   type = TB_ITERATOR_DATA_TYPE_NONE;
+    tb_byte_t*  data = (tb_byte_t*)tb_sort_impl_data(iterator, tb_null, &type);
+    if (data && tb_sort_impl_radix(data + head * tb_iterator_step(iterator), type, tail - head)) return ;
+
+    // not supported or no enough memory? uses the generic sorter
+    tb_sort(iterator, head, tail, tb_null);
+}
+tb_void_t tb_radix_sort_all(tb_iterator_ref_t iterator)
+{
+    tb_radix_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator));
+}
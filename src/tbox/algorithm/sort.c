@@ -29,6 +29,7 @@
 #include "quick_sort.h"
 #include "insert_sort.h"
 #include "bubble_sort.h"
+#include "impl/sort.h"
 #include "../libc/libc.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -55,8 +56,16 @@ tb_void_t tb_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb
     // random access iterator? 
     if (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) 
     {
-        if (tb_distance(iterator, head, tail) > 100000) tb_heap_sort(iterator, head, tail, comp);
-        else tb_quick_sort(iterator, head, tail, comp); //!< @note the recursive stack size is limit
+        // many contiguous integer items? sort them using the radix sort
+        if (tb_distance(iterator, head, tail) >= TB_SORT_IMPL_RADIX_MINN)
+        {
+            tb_size_t   type = TB_ITERATOR_DATA_TYPE_NONE;
+            tb_byte_t*  data = (tb_byte_t*)tb_sort_impl_data(iterator, comp, &type);
+            if (data && tb_sort_impl_radix(data + head * tb_iterator_step(iterator), type, tail - head)) return ;
+        }
+
+        // the introsort, the recursive depth is limited
+        tb_quick_sort(iterator, head, tail, comp);
     }
     else tb_insert_sort(iterator, head, tail, comp);
 #endif
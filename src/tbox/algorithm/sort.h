@@ -37,6 +37,9 @@ __tb_extern_c_enter__
  */
 
 /*! the sorter
+ *
+ * the random access items are sorted by the introsort, 
+ * and many contiguous integer items with the default comparer are sorted by the radix sort.
  *
  * @param iterator  the iterator
  * @param head      the iterator head
@@ -89,6 +89,15 @@ static tb_long_t tb_array_iterator_ptr_comp(tb_iterator_ref_t iterator, tb_cpoin
 {
     return (litem < ritem)? -1 : (litem > ritem);
 }
+static tb_pointer_t tb_array_iterator_ptr_data(tb_iterator_ref_t iterator, tb_size_t* type)
+{
+    // check
+    tb_assert(iterator && type);
+
+    // the pointers are compared as the size integers
+    *type = TB_ITERATOR_DATA_TYPE_SIZE;
+    return ((tb_array_iterator_ref_t)iterator)->items;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * iterator implementation for memory element
@@ -144,6 +153,15 @@ static tb_long_t tb_array_iterator_long_comp(tb_iterator_ref_t iterator, tb_cpoi
 {
     return ((tb_long_t)litem < (tb_long_t)ritem)? -1 : ((tb_long_t)litem > (tb_long_t)ritem);
 }
+static tb_pointer_t tb_array_iterator_long_data(tb_iterator_ref_t iterator, tb_size_t* type)
+{
+    // check
+    tb_assert(iterator && type);
+
+    // the data
+    *type = TB_ITERATOR_DATA_TYPE_LONG;
+    return ((tb_array_iterator_ref_t)iterator)->items;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -167,6 +185,7 @@ tb_iterator_ref_t tb_array_iterator_init_ptr(tb_array_iterator_ref_t iterator, t
     ,   tb_array_iterator_ptr_copy
     ,   tb_null
     ,   tb_null
+    ,   tb_array_iterator_ptr_data
     };
 
     // init iterator
@@ -300,6 +319,7 @@ tb_iterator_ref_t tb_array_iterator_init_long(tb_array_iterator_ref_t iterator,
     ,   tb_array_iterator_ptr_copy
     ,   tb_null
     ,   tb_null
+    ,   tb_array_iterator_long_data
     };
 
     // init iterator
@@ -37,6 +37,11 @@
 #include "../stream/stream.h"
 #include "../platform/platform.h"
 #include "../algorithm/algorithm.h"
+#if defined(TB_ARCH_SSE2)
+#   include <emmintrin.h>
+#elif defined(TB_ARCH_ARM_NEON) || defined(TB_ARCH_ARM64)
+#   include <arm_neon.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -66,10 +71,50 @@
 // the self bucket item maximum size
 #define TB_HASH_MAP_BUCKET_ITEM_MAXN                    (1 << 16)
 
+// the swiss table empty control byte, the full control byte is the 7-bits h2 of the hash value
+#define TB_HASH_MAP_SWISS_EMPTY                         (0x80)
+
+// the swiss table minimum capacity
+#define TB_HASH_MAP_SWISS_CAPACITY_MIN                  (16)
+
+// the swiss table control group, we probe 16 control bytes at a time using sse2/neon, or 8 control bytes using swar
+#if defined(TB_ARCH_SSE2)
+#   define TB_HASH_MAP_SWISS_GROUP                      (16)
+#   define tb_hash_map_swiss_bitmask_index(mask)        tb_bits_cl0_u32_le(mask)
+#elif defined(TB_ARCH_ARM_NEON) || defined(TB_ARCH_ARM64)
+#   define TB_HASH_MAP_SWISS_GROUP                      (16)
+#   define tb_hash_map_swiss_bitmask_index(mask)        (tb_bits_cl0_u64_le(mask) >> 2)
+#else
+#   define TB_HASH_MAP_SWISS_GROUP                      (8)
+#   define tb_hash_map_swiss_bitmask_index(mask)        (tb_bits_cl0_u64_le(mask) >> 3)
+#endif
+
+// the swiss table h2 and home slot of the hash value
+#define tb_hash_map_swiss_h2(hash)                      ((tb_byte_t)((hash) & 0x7f))
+#define tb_hash_map_swiss_home(hash, mask)              ((tb_size_t)((hash) >> 7) & (mask))
+
+// the swiss table maximum load factor: 7/8
+#define tb_hash_map_swiss_growth(capacity)              ((capacity) - ((capacity) >> 3))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the hash map mode enum
+typedef enum __tb_hash_map_mode_e
+{
+    TB_HASH_MAP_MODE_BUCKET         = 0     //!< the bucket lists
+,   TB_HASH_MAP_MODE_SWISS          = 1     //!< the open-addressing swiss table
+
+}tb_hash_map_mode_e;
+
+// the swiss table group bitmask type
+#if defined(TB_ARCH_SSE2)
+typedef tb_uint32_t                 tb_hash_map_swiss_bitmask_t;
+#else
+typedef tb_uint64_t                 tb_hash_map_swiss_bitmask_t;
+#endif
+
 // the hash map item list type
 typedef struct __tb_hash_map_item_list_t
 {
@@ -87,6 +132,9 @@ typedef struct __tb_hash_map_t
     // the item itor
     tb_iterator_t                   itor;
 
+    // the mode
+    tb_size_t                       mode;
+
     // the hash list
     tb_hash_map_item_list_t**       hash_list;
 
@@ -113,6 +161,51 @@ typedef struct __tb_hash_map_t
 
 }tb_hash_map_t;
 
+/* the swiss table hash map type
+ *
+ * the items are stored in the flat slots with the linear probing, 
+ * and we find them by probing the control bytes (the 7-bits hash value) of the whole group at a time.
+ *
+ * the items in the same probe run are ordered by the home slot (robin hood), 
+ * so we can remove items by shifting the next items backward without tombstones.
+ */
+typedef struct __tb_hash_map_swiss_t
+{
+    // the item itor
+    tb_iterator_t                   itor;
+
+    // the mode
+    tb_size_t                       mode;
+
+    // the control bytes, the first group - 1 bytes are cloned to the tail for probing the last group
+    tb_byte_t*                      ctrl;
+
+    // the hash values of the items
+    tb_uint32_t*                    hashes;
+
+    // the items
+    tb_byte_t*                      items;
+
+    // the capacity mask
+    tb_size_t                       mask;
+
+    // the item size
+    tb_size_t                       item_size;
+
+    // the iteration base, the previous slot of it must be empty
+    tb_size_t                       base;
+
+    // the current item for iterator
+    tb_hash_map_item_t              item;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+    // the element for data
+    tb_element_t                    element_data;
+
+}tb_hash_map_swiss_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -473,6 +566,598 @@ static tb_void_t tb_hash_map_itor_nremove(tb_iterator_ref_t iterator, tb_size_t
     }
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * swiss group implementation
+ */
+#if defined(TB_ARCH_SSE2)
+static __tb_inline__ tb_hash_map_swiss_bitmask_t tb_hash_map_swiss_group_match(tb_byte_t const* ctrl, tb_byte_t h2)
+{
+    __m128i group = _mm_loadu_si128((__m128i const*)ctrl);
+    return (tb_hash_map_swiss_bitmask_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((tb_char_t)h2)));
+}
+static __tb_inline__ tb_hash_map_swiss_bitmask_t tb_hash_map_swiss_group_empty(tb_byte_t const* ctrl)
+{
+    // only the empty control byte has the high bit
+    return (tb_hash_map_swiss_bitmask_t)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)ctrl));
+}
+#elif defined(TB_ARCH_ARM_NEON) || defined(TB_ARCH_ARM64)
+static __tb_inline__ tb_hash_map_swiss_bitmask_t tb_hash_map_swiss_group_bits(uint8x16_t mask)
+{
+    // narrow the byte mask to the nibble mask, one bit per control byte
+    uint8x8_t bits = vshrn_n_u16(vreinterpretq_u16_u8(mask), 4);
+    return (tb_hash_map_swiss_bitmask_t)vget_lane_u64(vreinterpret_u64_u8(bits), 0) & 0x8888888888888888ULL;
+}
+static __tb_inline__ tb_hash_map_swiss_bitmask_t tb_hash_map_swiss_group_match(tb_byte_t const* ctrl, tb_byte_t h2)
+{
+    return tb_hash_map_swiss_group_bits(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(h2)));
+}
+static __tb_inline__ tb_hash_map_swiss_bitmask_t tb_hash_map_swiss_group_empty(tb_byte_t const* ctrl)
+{
+    return tb_hash_map_swiss_group_bits(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(TB_HASH_MAP_SWISS_EMPTY)));
+}
+#else
+static __tb_inline__ tb_hash_map_swiss_bitmask_t tb_hash_map_swiss_group_match(tb_byte_t const* ctrl, tb_byte_t h2)
+{
+    /* find the zero bytes of (group ^ h2) using swar
+     *
+     * it may report false positive for the byte after the real matched byte, 
+     * so we need check the control byte again
+     */
+    tb_uint64_t group = tb_bits_get_u64_le(ctrl) ^ (0x0101010101010101ULL * h2);
+    return (group - 0x0101010101010101ULL) & ~group & 0x8080808080808080ULL;
+}
+static __tb_inline__ tb_hash_map_swiss_bitmask_t tb_hash_map_swiss_group_empty(tb_byte_t const* ctrl)
+{
+    // only the empty control byte has the high bit
+    return tb_bits_get_u64_le(ctrl) & 0x8080808080808080ULL;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * swiss implementation
+ */
+static __tb_inline__ tb_uint32_t tb_hash_map_swiss_hash(tb_hash_map_swiss_t* hash_map, tb_cpointer_t name)
+{
+    // compute the full hash value
+    tb_uint64_t hash = (tb_uint64_t)hash_map->element_name.hash(&hash_map->element_name, name, (tb_size_t)-1, 0);
+
+    // mix it (murmur3 finalizer), because the low and high bits of some element hashs are weak
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return (tb_uint32_t)hash;
+}
+static __tb_inline__ tb_void_t tb_hash_map_swiss_ctrl_set(tb_hash_map_swiss_t* hash_map, tb_size_t index, tb_byte_t ctrl)
+{
+    // set it and the cloned control byte for the tail group
+    hash_map->ctrl[index] = ctrl;
+    if (index < TB_HASH_MAP_SWISS_GROUP - 1) hash_map->ctrl[hash_map->mask + 1 + index] = ctrl;
+}
+static __tb_inline__ tb_size_t tb_hash_map_swiss_dist(tb_hash_map_swiss_t* hash_map, tb_size_t index)
+{
+    // the probe distance from the home slot
+    return (index - tb_hash_map_swiss_home(hash_map->hashes[index], hash_map->mask)) & hash_map->mask;
+}
+static tb_bool_t tb_hash_map_swiss_item_find(tb_hash_map_swiss_t* hash_map, tb_cpointer_t name, tb_size_t* pindex)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && hash_map->ctrl, tb_false);
+
+    // empty?
+    tb_check_return_val(hash_map->item_size, tb_false);
+
+    // the hash
+    tb_uint32_t hash = tb_hash_map_swiss_hash(hash_map, name);
+    tb_byte_t   h2 = tb_hash_map_swiss_h2(hash);
+
+    // the step
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+
+    // probe groups from the home slot
+    tb_size_t mask = hash_map->mask;
+    tb_size_t pos = tb_hash_map_swiss_home(hash, mask);
+    while (1)
+    {
+        // compare the matched items
+        tb_byte_t const*                ctrl = hash_map->ctrl + pos;
+        tb_hash_map_swiss_bitmask_t     match = tb_hash_map_swiss_group_match(ctrl, h2);
+        while (match)
+        {
+            // the item index
+            tb_size_t index = (pos + tb_hash_map_swiss_bitmask_index(match)) & mask;
+
+            // found? the swar matcher may report false positive for the empty slot
+            if (hash_map->ctrl[index] == h2 && hash_map->hashes[index] == hash && !hash_map->element_name.comp(&hash_map->element_name, name, hash_map->element_name.data(&hash_map->element_name, hash_map->items + index * step)))
+            {
+                if (pindex) *pindex = index;
+                return tb_true;
+            }
+
+            // next matched item
+            match &= match - 1;
+        }
+
+        // the item will be always in the probe run before the first empty slot
+        tb_check_break(!tb_hash_map_swiss_group_empty(ctrl));
+
+        // next group
+        pos = (pos + TB_HASH_MAP_SWISS_GROUP) & mask;
+    }
+
+    // not found
+    return tb_false;
+}
+static tb_size_t tb_hash_map_swiss_item_place(tb_hash_map_swiss_t* hash_map, tb_uint32_t hash)
+{
+    // check
+    tb_assert(hash_map && hash_map->item_size < hash_map->mask + 1);
+
+    /* find the insert position (robin hood)
+     *
+     * we keep the items ordered by the home slot in the probe run,
+     * so the removed items can be filled by shifting the next items backward
+     */
+    tb_size_t mask = hash_map->mask;
+    tb_size_t index = tb_hash_map_swiss_home(hash, mask);
+    tb_size_t dist = 0;
+    while (hash_map->ctrl[index] != TB_HASH_MAP_SWISS_EMPTY && tb_hash_map_swiss_dist(hash_map, index) >= dist)
+    {
+        index = (index + 1) & mask;
+        dist++;
+    }
+
+    // find the first empty slot after it
+    tb_size_t last = index;
+    while (hash_map->ctrl[last] != TB_HASH_MAP_SWISS_EMPTY) last = (last + 1) & mask;
+
+    // shift the left probe run forward
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    while (last != index)
+    {
+        tb_size_t prev = (last - 1) & mask;
+        tb_memcpy(hash_map->items + last * step, hash_map->items + prev * step, step);
+        hash_map->hashes[last] = hash_map->hashes[prev];
+        tb_hash_map_swiss_ctrl_set(hash_map, last, hash_map->ctrl[prev]);
+        last = prev;
+    }
+
+    // place it
+    hash_map->hashes[index] = hash;
+    tb_hash_map_swiss_ctrl_set(hash_map, index, tb_hash_map_swiss_h2(hash));
+
+    // the iteration base may be changed
+    hash_map->base = -1;
+    return index;
+}
+static tb_void_t tb_hash_map_swiss_item_erase(tb_hash_map_swiss_t* hash_map, tb_size_t index)
+{
+    // check
+    tb_assert(hash_map && index <= hash_map->mask && hash_map->ctrl[index] != TB_HASH_MAP_SWISS_EMPTY);
+
+    // shift the next items backward until the empty slot or the item in the home slot, we need not tombstones
+    tb_size_t mask = hash_map->mask;
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_size_t next = (index + 1) & mask;
+    while (hash_map->ctrl[next] != TB_HASH_MAP_SWISS_EMPTY && tb_hash_map_swiss_dist(hash_map, next))
+    {
+        tb_memcpy(hash_map->items + index * step, hash_map->items + next * step, step);
+        hash_map->hashes[index] = hash_map->hashes[next];
+        tb_hash_map_swiss_ctrl_set(hash_map, index, hash_map->ctrl[next]);
+        index = next;
+        next = (next + 1) & mask;
+    }
+
+    // clear the last slot
+    tb_hash_map_swiss_ctrl_set(hash_map, index, TB_HASH_MAP_SWISS_EMPTY);
+}
+static tb_void_t tb_hash_map_swiss_item_remove(tb_hash_map_swiss_t* hash_map, tb_size_t index)
+{
+    // check
+    tb_assert(hash_map && index <= hash_map->mask);
+
+    // free item
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_byte_t* item = hash_map->items + index * step;
+    if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, item);
+    if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, item + hash_map->element_name.size);
+
+    // erase it
+    tb_hash_map_swiss_item_erase(hash_map, index);
+
+    // update the item size
+    hash_map->item_size--;
+}
+static tb_bool_t tb_hash_map_swiss_resize(tb_hash_map_swiss_t* hash_map, tb_size_t capacity)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && capacity >= TB_HASH_MAP_SWISS_GROUP && !(capacity & (capacity - 1)), tb_false);
+    tb_assert_and_check_return_val(hash_map->item_size <= tb_hash_map_swiss_growth(capacity), tb_false);
+
+    // the step
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_assert_and_check_return_val(step, tb_false);
+
+    // make the new slots
+    tb_byte_t*      ctrl = tb_malloc_bytes(capacity + TB_HASH_MAP_SWISS_GROUP);
+    tb_uint32_t*    hashes = tb_nalloc_type(capacity, tb_uint32_t);
+    tb_byte_t*      items = tb_nalloc_bytes(capacity, step);
+    if (!ctrl || !hashes || !items)
+    {
+        if (ctrl) tb_free(ctrl);
+        if (hashes) tb_free(hashes);
+        if (items) tb_free(items);
+        return tb_false;
+    }
+    tb_memset(ctrl, TB_HASH_MAP_SWISS_EMPTY, capacity + TB_HASH_MAP_SWISS_GROUP);
+
+    // swap the slots
+    tb_byte_t*      ctrl_old = hash_map->ctrl;
+    tb_uint32_t*    hashes_old = hash_map->hashes;
+    tb_byte_t*      items_old = hash_map->items;
+    tb_size_t       capacity_old = hash_map->ctrl? hash_map->mask + 1 : 0;
+    hash_map->ctrl      = ctrl;
+    hash_map->hashes    = hashes;
+    hash_map->items     = items;
+    hash_map->mask      = capacity - 1;
+    hash_map->base      = -1;
+
+    // move the old items, the hash values need not be computed again
+    tb_size_t i = 0;
+#ifdef __tb_debug__
+    tb_size_t size = hash_map->item_size;
+#endif
+    hash_map->item_size = 0;
+    for (i = 0; i < capacity_old; i++)
+    {
+        if (ctrl_old[i] != TB_HASH_MAP_SWISS_EMPTY)
+        {
+            tb_size_t index = tb_hash_map_swiss_item_place(hash_map, hashes_old[i]);
+            tb_memcpy(items + index * step, items_old + i * step, step);
+            hash_map->item_size++;
+        }
+    }
+    tb_assert(hash_map->item_size == size);
+
+    // free the old slots
+    if (ctrl_old) tb_free(ctrl_old);
+    if (hashes_old) tb_free(hashes_old);
+    if (items_old) tb_free(items_old);
+    return tb_true;
+}
+static tb_size_t tb_hash_map_swiss_itor_base(tb_hash_map_swiss_t* hash_map)
+{
+    // check
+    tb_assert(hash_map && hash_map->ctrl);
+
+    /* the iteration will start after an empty slot, so no probe run will cross the iteration head,
+     * and the items shifted backward by removing will not be walked again.
+     *
+     * it will not be changed when removing items, because the empty slot will be not filled
+     */
+    tb_size_t mask = hash_map->mask;
+    if (hash_map->base > mask || hash_map->ctrl[(hash_map->base - 1) & mask] != TB_HASH_MAP_SWISS_EMPTY)
+    {
+        tb_size_t i = 0;
+        while (hash_map->ctrl[i] != TB_HASH_MAP_SWISS_EMPTY) i++;
+        hash_map->base = (i + 1) & mask;
+    }
+    return hash_map->base;
+}
+static tb_size_t tb_hash_map_swiss_itor_seek(tb_hash_map_swiss_t* hash_map, tb_size_t index)
+{
+    // check
+    tb_assert(hash_map && hash_map->ctrl);
+
+    // find the next item from the given index to the iteration tail
+    tb_size_t mask = hash_map->mask;
+    tb_size_t base = tb_hash_map_swiss_itor_base(hash_map);
+    tb_size_t left = (base - index - 1) & mask;
+    while (left--)
+    {
+        if (hash_map->ctrl[index] != TB_HASH_MAP_SWISS_EMPTY) return index + 1;
+        index = (index + 1) & mask;
+    }
+    return 0;
+}
+static tb_size_t tb_hash_map_swiss_itor_size(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_hash_map_swiss_t* hash_map = (tb_hash_map_swiss_t*)iterator;
+    tb_assert(hash_map);
+
+    // the size
+    return hash_map->item_size;
+}
+static tb_size_t tb_hash_map_swiss_itor_head(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_hash_map_swiss_t* hash_map = (tb_hash_map_swiss_t*)iterator;
+    tb_assert(hash_map);
+
+    // empty?
+    tb_check_return_val(hash_map->item_size, 0);
+
+    // find the head
+    return tb_hash_map_swiss_itor_seek(hash_map, tb_hash_map_swiss_itor_base(hash_map));
+}
+static tb_size_t tb_hash_map_swiss_itor_tail(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_size_t tb_hash_map_swiss_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_hash_map_swiss_t* hash_map = (tb_hash_map_swiss_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->mask + 1);
+
+    // the iteration tail?
+    tb_size_t index = itor & hash_map->mask;
+    tb_check_return_val(index != tb_hash_map_swiss_itor_base(hash_map), 0);
+
+    // find the next item
+    return tb_hash_map_swiss_itor_seek(hash_map, index);
+}
+static tb_pointer_t tb_hash_map_swiss_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_hash_map_swiss_t* hash_map = (tb_hash_map_swiss_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->mask + 1);
+
+    // the item
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_byte_t* item = hash_map->items + (itor - 1) * step;
+    tb_assert_and_check_return_val(hash_map->ctrl[itor - 1] != TB_HASH_MAP_SWISS_EMPTY, tb_null);
+
+    // get it
+    hash_map->item.name = hash_map->element_name.data(&hash_map->element_name, item);
+    hash_map->item.data = hash_map->element_data.data(&hash_map->element_data, item + hash_map->element_name.size);
+    return &(hash_map->item);
+}
+static tb_void_t tb_hash_map_swiss_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_hash_map_swiss_t* hash_map = (tb_hash_map_swiss_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->mask + 1);
+
+    // the step
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_check_return(hash_map->ctrl[itor - 1] != TB_HASH_MAP_SWISS_EMPTY);
+
+    // note: copy data only, will destroy hash_map index if copy name
+    hash_map->element_data.copy(&hash_map->element_data, hash_map->items + (itor - 1) * step + hash_map->element_name.size, item);
+}
+static tb_long_t tb_hash_map_swiss_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t lelement, tb_cpointer_t relement)
+{
+    // check
+    tb_hash_map_swiss_t* hash_map = (tb_hash_map_swiss_t*)iterator;
+    tb_assert(hash_map && hash_map->element_name.comp && lelement && relement);
+    
+    // done
+    return hash_map->element_name.comp(&hash_map->element_name, ((tb_hash_map_item_ref_t)lelement)->name, ((tb_hash_map_item_ref_t)relement)->name);
+}
+static tb_void_t tb_hash_map_swiss_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_hash_map_swiss_t* hash_map = (tb_hash_map_swiss_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->mask + 1);
+
+    // keep the iteration base before removing it
+    tb_hash_map_swiss_itor_base(hash_map);
+
+    // remove it
+    tb_hash_map_swiss_item_remove(hash_map, itor - 1);
+}
+static tb_void_t tb_hash_map_swiss_itor_nremove(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_assert(iterator);
+
+    /* remove items: [prev + 1, next)
+     *
+     * the next items will be shifted backward to the removed slot in order, 
+     * so we only need remove the first item after prev repeatly
+     */
+    while (size--)
+    {
+        // the first item
+        tb_size_t itor = prev? tb_hash_map_swiss_itor_next(iterator, prev) : tb_hash_map_swiss_itor_head(iterator);
+        tb_check_break(itor && itor != next);
+
+        // remove it
+        tb_hash_map_swiss_itor_remove(iterator, itor);
+    }
+}
+static tb_hash_map_ref_t tb_hash_map_swiss_init(tb_size_t size, tb_element_t element_name, tb_element_t element_data)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_hash_map_swiss_t*    hash_map = tb_null;
+    do
+    {
+        // make hash map
+        hash_map = tb_malloc0_type(tb_hash_map_swiss_t);
+        tb_assert_and_check_break(hash_map);
+
+        // init hash map
+        hash_map->mode          = TB_HASH_MAP_MODE_SWISS;
+        hash_map->base          = -1;
+        hash_map->element_name  = element_name;
+        hash_map->element_data  = element_data;
+
+        // init operation
+        static tb_iterator_op_t op = 
+        {
+            tb_hash_map_swiss_itor_size
+        ,   tb_hash_map_swiss_itor_head
+        ,   tb_null
+        ,   tb_hash_map_swiss_itor_tail
+        ,   tb_null
+        ,   tb_hash_map_swiss_itor_next
+        ,   tb_hash_map_swiss_itor_item
+        ,   tb_hash_map_swiss_itor_comp
+        ,   tb_hash_map_swiss_itor_copy
+        ,   tb_hash_map_swiss_itor_remove
+        ,   tb_hash_map_swiss_itor_nremove
+        };
+
+        // init iterator
+        hash_map->itor.priv = tb_null;
+        hash_map->itor.step = sizeof(tb_hash_map_item_t);
+        hash_map->itor.mode = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_MUTABLE;
+        hash_map->itor.op   = &op;
+
+        // init slots
+        if (!tb_hash_map_reserve((tb_hash_map_ref_t)hash_map, size)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (hash_map) tb_hash_map_exit((tb_hash_map_ref_t)hash_map);
+        hash_map = tb_null;
+    }
+
+    // ok?
+    return (tb_hash_map_ref_t)hash_map;
+}
+static tb_void_t tb_hash_map_swiss_clear(tb_hash_map_swiss_t* hash_map)
+{
+    // check
+    tb_assert_and_check_return(hash_map);
+
+    // no slots?
+    tb_check_return(hash_map->ctrl);
+
+    // free items
+    if (hash_map->item_size && (hash_map->element_name.free || hash_map->element_data.free))
+    {
+        tb_size_t i = 0;
+        tb_size_t n = hash_map->mask + 1;
+        tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+        for (i = 0; i < n; i++)
+        {
+            if (hash_map->ctrl[i] != TB_HASH_MAP_SWISS_EMPTY)
+            {
+                tb_byte_t* item = hash_map->items + i * step;
+                if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, item);
+                if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, item + hash_map->element_name.size);
+            }
+        }
+    }
+
+    // clear slots
+    tb_memset(hash_map->ctrl, TB_HASH_MAP_SWISS_EMPTY, hash_map->mask + 1 + TB_HASH_MAP_SWISS_GROUP);
+    hash_map->item_size = 0;
+    hash_map->base      = -1;
+    tb_memset(&hash_map->item, 0, sizeof(tb_hash_map_item_t));
+}
+static tb_void_t tb_hash_map_swiss_exit(tb_hash_map_swiss_t* hash_map)
+{
+    // check
+    tb_assert_and_check_return(hash_map);
+
+    // clear it
+    tb_hash_map_swiss_clear(hash_map);
+
+    // free slots
+    if (hash_map->ctrl) tb_free(hash_map->ctrl);
+    if (hash_map->hashes) tb_free(hash_map->hashes);
+    if (hash_map->items) tb_free(hash_map->items);
+
+    // free it
+    tb_free(hash_map);
+}
+static tb_size_t tb_hash_map_swiss_insert(tb_hash_map_swiss_t* hash_map, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && hash_map->ctrl, 0);
+
+    // the step
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_assert_and_check_return_val(step, 0);
+
+    // exists? replace data
+    tb_size_t index = 0;
+    if (tb_hash_map_swiss_item_find(hash_map, name, &index))
+    {
+        hash_map->element_data.repl(&hash_map->element_data, hash_map->items + index * step + hash_map->element_name.size, data);
+        return index + 1;
+    }
+
+    // grow it
+    if (hash_map->item_size + 1 > tb_hash_map_swiss_growth(hash_map->mask + 1))
+    {
+        if (!tb_hash_map_swiss_resize(hash_map, (hash_map->mask + 1) << 1)) return 0;
+    }
+
+    // place it
+    index = tb_hash_map_swiss_item_place(hash_map, tb_hash_map_swiss_hash(hash_map, name));
+
+    // dupl item
+    tb_byte_t* item = hash_map->items + index * step;
+    hash_map->element_name.dupl(&hash_map->element_name, item, name);
+    hash_map->element_data.dupl(&hash_map->element_data, item + hash_map->element_name.size, data);
+
+    // update the item size
+    hash_map->item_size++;
+    return index + 1;
+}
+#ifdef __tb_debug__
+static tb_void_t tb_hash_map_swiss_dump(tb_hash_map_swiss_t* hash_map)
+{
+    // check
+    tb_assert_and_check_return(hash_map && hash_map->ctrl);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("self: size: %lu, capacity: %lu", hash_map->item_size, hash_map->mask + 1);
+
+    // dump the probe distances
+    tb_size_t i = 0;
+    tb_size_t n = hash_map->mask + 1;
+    tb_size_t dist_maxn = 0;
+    tb_size_t dist_total = 0;
+    for (i = 0; i < n; i++)
+    {
+        if (hash_map->ctrl[i] != TB_HASH_MAP_SWISS_EMPTY)
+        {
+            tb_size_t dist = tb_hash_map_swiss_dist(hash_map, i);
+            if (dist > dist_maxn) dist_maxn = dist;
+            dist_total += dist;
+        }
+    }
+    tb_trace_i("probe: dist: maxn: %lu, average: %lu.%02lu", dist_maxn, hash_map->item_size? dist_total / hash_map->item_size : 0, hash_map->item_size? (dist_total * 100 / hash_map->item_size) % 100 : 0);
+
+    // dump items
+    tb_char_t name[4096];
+    tb_char_t data[4096];
+    tb_for_all_if (tb_hash_map_item_ref_t, item, (tb_hash_map_ref_t)hash_map, item)
+    {
+        if (hash_map->element_name.cstr && hash_map->element_data.cstr)
+        {
+            tb_trace_i("    %s => %s", hash_map->element_name.cstr(&hash_map->element_name, item->name, name, sizeof(name)), hash_map->element_data.cstr(&hash_map->element_data, item->data, data, sizeof(data)));
+        }
+        else if (hash_map->element_name.cstr) 
+        {
+            tb_trace_i("    %s => %p", hash_map->element_name.cstr(&hash_map->element_name, item->name, name, sizeof(name)), item->data);
+        }
+        else if (hash_map->element_data.cstr) 
+        {
+            tb_trace_i("    %x => %p", item->name, hash_map->element_data.cstr(&hash_map->element_data, item->data, data, sizeof(data)));
+        }
+        else 
+        {
+            tb_trace_i("    %p => %p", item->name, item->data);
+        }
+    }
+}
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -496,6 +1181,7 @@ tb_hash_map_ref_t tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_n
         tb_assert_and_check_break(hash_map);
 
         // init self func
+        hash_map->mode         = TB_HASH_MAP_MODE_BUCKET;
         hash_map->element_name = element_name;
         hash_map->element_data = element_data;
 
@@ -550,12 +1236,28 @@ tb_hash_map_ref_t tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_n
     // ok?
     return (tb_hash_map_ref_t)hash_map;
 }
+tb_hash_map_ref_t tb_hash_map_init_swiss(tb_size_t size, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.size && element_name.hash && element_name.comp && element_name.data && element_name.dupl, tb_null);
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
+
+    // init it
+    return tb_hash_map_swiss_init(size, element_name, element_data);
+}
 tb_void_t tb_hash_map_exit(tb_hash_map_ref_t self)
 {
     // check
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return(hash_map);
 
+    // the swiss table?
+    if (hash_map->mode == TB_HASH_MAP_MODE_SWISS)
+    {
+        tb_hash_map_swiss_exit((tb_hash_map_swiss_t*)hash_map);
+        return ;
+    }
+
     // clear it
     tb_hash_map_clear(self);
 
@@ -569,7 +1271,17 @@ tb_void_t tb_hash_map_clear(tb_hash_map_ref_t self)
 {
     // check
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
-    tb_assert_and_check_return(hash_map && hash_map->hash_list);
+    tb_assert_and_check_return(hash_map);
+
+    // the swiss table?
+    if (hash_map->mode == TB_HASH_MAP_MODE_SWISS)
+    {
+        tb_hash_map_swiss_clear((tb_hash_map_swiss_t*)hash_map);
+        return ;
+    }
+
+    // check
+    tb_assert_and_check_return(hash_map->hash_list);
 
     // step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
@@ -613,6 +1325,15 @@ tb_pointer_t tb_hash_map_get(tb_hash_map_ref_t self, tb_cpointer_t name)
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return_val(hash_map, tb_null);
 
+    // the swiss table?
+    if (hash_map->mode == TB_HASH_MAP_MODE_SWISS)
+    {
+        tb_hash_map_swiss_t* swiss = (tb_hash_map_swiss_t*)hash_map;
+        tb_size_t index = 0;
+        if (!tb_hash_map_swiss_item_find(swiss, name, &index)) return tb_null;
+        return swiss->element_data.data(&swiss->element_data, swiss->items + index * (swiss->element_name.size + swiss->element_data.size) + swiss->element_name.size);
+    }
+
     // find it
     tb_size_t buck = 0;
     tb_size_t item = 0;
@@ -628,6 +1349,13 @@ tb_size_t tb_hash_map_find(tb_hash_map_ref_t self, tb_cpointer_t name)
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return_val(hash_map, 0);
 
+    // the swiss table?
+    if (hash_map->mode == TB_HASH_MAP_MODE_SWISS)
+    {
+        tb_size_t index = 0;
+        return tb_hash_map_swiss_item_find((tb_hash_map_swiss_t*)hash_map, name, &index)? index + 1 : 0;
+    }
+
     // find
     tb_size_t buck = 0;
     tb_size_t item = 0;
@@ -639,6 +1367,10 @@ tb_size_t tb_hash_map_insert(tb_hash_map_ref_t self, tb_cpointer_t name, tb_cpoi
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return_val(hash_map, 0);
 
+    // the swiss table?
+    if (hash_map->mode == TB_HASH_MAP_MODE_SWISS) 
+        return tb_hash_map_swiss_insert((tb_hash_map_swiss_t*)hash_map, name, data);
+
     // the step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert_and_check_return_val(step, 0);
@@ -739,6 +1471,15 @@ tb_void_t tb_hash_map_remove(tb_hash_map_ref_t self, tb_cpointer_t name)
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return(hash_map);
 
+    // the swiss table?
+    if (hash_map->mode == TB_HASH_MAP_MODE_SWISS)
+    {
+        tb_size_t index = 0;
+        if (tb_hash_map_swiss_item_find((tb_hash_map_swiss_t*)hash_map, name, &index))
+            tb_hash_map_swiss_itor_remove((tb_iterator_ref_t)hash_map, index + 1);
+        return ;
+    }
+
     // find it
     tb_size_t buck = 0;
     tb_size_t item = 0;
@@ -752,7 +1493,7 @@ tb_size_t tb_hash_map_size(tb_hash_map_ref_t self)
     tb_assert_and_check_return_val(hash_map, 0);
 
     // the size
-    return hash_map->item_size;
+    return hash_map->mode == TB_HASH_MAP_MODE_SWISS? ((tb_hash_map_swiss_t const*)hash_map)->item_size : hash_map->item_size;
 }
 tb_size_t tb_hash_map_maxn(tb_hash_map_ref_t self)
 {
@@ -761,14 +1502,48 @@ tb_size_t tb_hash_map_maxn(tb_hash_map_ref_t self)
     tb_assert_and_check_return_val(hash_map, 0);
 
     // the maxn
-    return hash_map->item_maxn;
+    return hash_map->mode == TB_HASH_MAP_MODE_SWISS? tb_hash_map_swiss_growth(((tb_hash_map_swiss_t const*)hash_map)->mask + 1) : hash_map->item_maxn;
+}
+tb_bool_t tb_hash_map_reserve(tb_hash_map_ref_t self, tb_size_t size)
+{
+    // check
+    tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, tb_false);
+
+    // the bucket lists will be grown on demand
+    tb_check_return_val(hash_map->mode == TB_HASH_MAP_MODE_SWISS, tb_true);
+
+    // compute the capacity
+    tb_hash_map_swiss_t* swiss = (tb_hash_map_swiss_t*)hash_map;
+    tb_size_t capacity = TB_HASH_MAP_SWISS_CAPACITY_MIN;
+    while (tb_hash_map_swiss_growth(capacity) < size)
+    {
+        tb_assert_and_check_return_val(capacity < (TB_MAXU32 >> 7), tb_false);
+        capacity <<= 1;
+    }
+
+    // enough?
+    tb_check_return_val(!swiss->ctrl || capacity > swiss->mask + 1, tb_true);
+
+    // resize it
+    return tb_hash_map_swiss_resize(swiss, capacity);
 }
 #ifdef __tb_debug__
 tb_void_t tb_hash_map_dump(tb_hash_map_ref_t self)
 {
     // check
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
-    tb_assert_and_check_return(hash_map && hash_map->hash_list);
+    tb_assert_and_check_return(hash_map);
+
+    // the swiss table?
+    if (hash_map->mode == TB_HASH_MAP_MODE_SWISS)
+    {
+        tb_hash_map_swiss_dump((tb_hash_map_swiss_t*)hash_map);
+        return ;
+    }
+
+    // check
+    tb_assert_and_check_return(hash_map->hash_list);
 
     // the step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
@@ -106,6 +106,21 @@ typedef tb_iterator_ref_t tb_hash_map_ref_t;
  */
 tb_hash_map_ref_t       tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data);
 
+/*! init hash map with the open-addressing swiss table
+ *
+ * the items are stored in the flat slots and found by probing 16 control bytes at a time (sse2/neon),
+ * it will be faster than the bucket lists for the lookup at the high load factor.
+ *
+ * @note the items will be moved when inserting and removing items, so the itor of the same item is mutable
+ *
+ * @param size          the reserved item count, using the minimum capacity if be zero
+ * @param element_name  the item for name
+ * @param element_data  the item for data
+ *
+ * @return              the hash map
+ */
+tb_hash_map_ref_t       tb_hash_map_init_swiss(tb_size_t size, tb_element_t element_name, tb_element_t element_data);
+
 /*! exit hash map
  *
  * @param hash_map      the hash map
@@ -200,6 +215,15 @@ tb_size_t               tb_hash_map_size(tb_hash_map_ref_t hash_map);
  */
 tb_size_t               tb_hash_map_maxn(tb_hash_map_ref_t hash_map);
 
+/*! reserve the room for the given item count, only for the swiss table
+ *
+ * @param hash_map      the hash map
+ * @param size          the item count
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_hash_map_reserve(tb_hash_map_ref_t hash_map, tb_size_t size);
+
 #ifdef __tb_debug__
 /*! dump hash
  *
@@ -133,4 +133,16 @@ tb_long_t tb_iterator_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_c
     // comp
     return iterator->op->comp(iterator, litem, ritem);
 }
+tb_pointer_t tb_iterator_data(tb_iterator_ref_t iterator, tb_size_t* type)
+{
+    // check
+    tb_assert(iterator && iterator->op && type);
 
+    // no data?
+    *type = TB_ITERATOR_DATA_TYPE_NONE;
+    tb_check_return_val(iterator->op->data, tb_null);
+
+    // data
+    tb_pointer_t data = iterator->op->data(iterator, type);
+    return (data && *type != TB_ITERATOR_DATA_TYPE_NONE)? data : tb_null;
+}
@@ -47,6 +47,18 @@ typedef enum __tb_iterator_mode_t
 
 }tb_iterator_mode_t;
 
+/// the iterator data type, the plain type of the contiguous items
+typedef enum __tb_iterator_data_type_t
+{
+    TB_ITERATOR_DATA_TYPE_NONE      = 0     //!< unknown
+,   TB_ITERATOR_DATA_TYPE_LONG      = 1     //!< long
+,   TB_ITERATOR_DATA_TYPE_SIZE      = 2     //!< size
+,   TB_ITERATOR_DATA_TYPE_UINT8     = 3     //!< uint8
+,   TB_ITERATOR_DATA_TYPE_UINT16    = 4     //!< uint16
+,   TB_ITERATOR_DATA_TYPE_UINT32    = 5     //!< uint32
+
+}tb_iterator_data_type_t;
+
 /// the iterator operation type
 struct __tb_iterator_t;
 typedef struct __tb_iterator_op_t
@@ -84,6 +96,9 @@ typedef struct __tb_iterator_op_t
     /// the iterator nremove 
     tb_void_t               (*nremove)(struct __tb_iterator_t* iterator, tb_size_t prev, tb_size_t next, tb_size_t size);
 
+    /// the iterator data, optional
+    tb_pointer_t            (*data)(struct __tb_iterator_t* iterator, tb_size_t* type);
+
 }tb_iterator_op_t;
 
 /// the iterator operation ref type
@@ -222,6 +237,17 @@ tb_void_t           tb_iterator_copy(tb_iterator_ref_t iterator, tb_size_t itor,
  */
 tb_long_t           tb_iterator_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem);
 
+/*! the contiguous items data of the iterator
+ *
+ * it is only supported if all items are stored in the contiguous memory as plain integers 
+ * and the iterator comparer is the ascending order of them, the item of itor is at (data + itor * step).
+ *
+ * @param iterator  the iterator
+ * @param type      the data type, see tb_iterator_data_type_t
+ * @return          the data, return tb_null if not supported
+ */
+tb_pointer_t        tb_iterator_data(tb_iterator_ref_t iterator, tb_size_t* type);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -178,6 +178,37 @@ static tb_void_t tb_vector_itor_nremove(tb_iterator_ref_t iterator, tb_size_t pr
     // remove the items
     if (size) tb_vector_nremove((tb_vector_ref_t)iterator, prev != vector->size? prev + 1 : 0, size);
 }
+static tb_pointer_t tb_vector_itor_data(tb_iterator_ref_t iterator, tb_size_t* type)
+{
+    // check
+    tb_vector_t* vector = (tb_vector_t*)iterator;
+    tb_assert(vector && type);
+
+    // only for the plain integer element with the default comparer
+    switch (vector->element.type)
+    {
+    case TB_ELEMENT_TYPE_LONG:
+        if (vector->element.comp == tb_element_long().comp) *type = TB_ITERATOR_DATA_TYPE_LONG;
+        break;
+    case TB_ELEMENT_TYPE_SIZE:
+        if (vector->element.comp == tb_element_size().comp) *type = TB_ITERATOR_DATA_TYPE_SIZE;
+        break;
+    case TB_ELEMENT_TYPE_UINT8:
+        if (vector->element.comp == tb_element_uint8().comp) *type = TB_ITERATOR_DATA_TYPE_UINT8;
+        break;
+    case TB_ELEMENT_TYPE_UINT16:
+        if (vector->element.comp == tb_element_uint16().comp) *type = TB_ITERATOR_DATA_TYPE_UINT16;
+        break;
+    case TB_ELEMENT_TYPE_UINT32:
+        if (vector->element.comp == tb_element_uint32().comp) *type = TB_ITERATOR_DATA_TYPE_UINT32;
+        break;
+    default:
+        break;
+    }
+
+    // the data
+    return vector->data;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -220,6 +251,7 @@ tb_vector_ref_t tb_vector_init(tb_size_t grow, tb_element_t element)
         ,   tb_vector_itor_copy
         ,   tb_vector_itor_remove
         ,   tb_vector_itor_nremove
+        ,   tb_vector_itor_data
         };
 
         // init iterator
@@ -79,94 +79,49 @@ typedef struct __tb_co_channel_t
     // the waiting recv coroutines 
     tb_single_list_entry_head_t     waiting_recv;
 
+    /* the lock
+     *
+     * the waiting coroutines may be resumed on the other worker threads for the M:N scheduler
+     */
+    tb_spinlock_t                   lock;
+
 }tb_co_channel_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_bool_t tb_co_channel_send_resume(tb_co_channel_t* channel, tb_pointer_t* pdata)
+static tb_coroutine_ref_t tb_co_channel_waiting_pop(tb_single_list_entry_head_ref_t waiting)
 {
     // check
-    tb_assert(channel);
-
-    // resume the first waiting send coroutine and recv data
-    tb_bool_t ok = tb_false;
-    if (tb_single_list_entry_size(&channel->waiting_send))
-    {
-        // get the next entry from head
-        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&channel->waiting_send);
-        tb_assert(entry);
-
-        // remove it from the waiting send coroutines
-        tb_single_list_entry_remove_head(&channel->waiting_send);
+    tb_assert(waiting);
 
-        // get the waiting send coroutine
-        tb_coroutine_ref_t waiting = (tb_coroutine_ref_t)tb_single_list_entry(&channel->waiting_send, entry);
+    // no waiting coroutines?
+    tb_check_return_val(tb_single_list_entry_size(waiting), tb_null);
 
-        // resume this coroutine and recv data
-        tb_pointer_t data = tb_coroutine_resume(waiting, tb_null);
+    // get the next entry from head
+    tb_single_list_entry_ref_t entry = tb_single_list_entry_head(waiting);
+    tb_assert(entry);
 
-        // save data
-        if (pdata) *pdata = data;
-
-        // ok
-        ok = tb_true;
-    }
+    // remove it from the waiting coroutines
+    tb_single_list_entry_remove_head(waiting);
 
-    // ok?
-    return ok;
+    // get the waiting coroutine
+    return (tb_coroutine_ref_t)tb_single_list_entry(waiting, entry);
 }
-static tb_void_t tb_co_channel_recv_resume(tb_co_channel_t* channel)
+static tb_void_t tb_co_channel_waiting_push(tb_single_list_entry_head_ref_t waiting, tb_cpointer_t data)
 {
     // check
-    tb_assert(channel);
-
-    // resume the first waiting recv coroutine 
-    if (tb_single_list_entry_size(&channel->waiting_recv))
-    {
-        // get the next entry from head
-        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&channel->waiting_recv);
-        tb_assert(entry);
-
-        // remove it from the waiting recv coroutines
-        tb_single_list_entry_remove_head(&channel->waiting_recv);
-
-        // get the waiting recv coroutine
-        tb_coroutine_ref_t waiting = (tb_coroutine_ref_t)tb_single_list_entry(&channel->waiting_recv, entry);
-
-        // resume this coroutine 
-        tb_coroutine_resume(waiting, tb_null);
-    }
-}
-static tb_void_t tb_co_channel_send_suspend(tb_co_channel_t* channel, tb_cpointer_t data)
-{
-    // check
-    tb_assert(channel);
+    tb_assert(waiting);
 
     // get the running coroutine 
     tb_coroutine_t* running = (tb_coroutine_t*)tb_coroutine_self();
     tb_assert(running);
 
-    // save this coroutine to the waiting send coroutines
-    tb_single_list_entry_insert_tail(&channel->waiting_send, &running->rs.single_entry);
+    // pass the data to resume() first, it may be resumed on the other thread before suspending it
+    running->rs_priv = data;
 
-    // send data and wait it
-    tb_coroutine_suspend(data);
-}
-static tb_void_t tb_co_channel_recv_suspend(tb_co_channel_t* channel)
-{
-    // check
-    tb_assert(channel);
-
-    // get the running coroutine 
-    tb_coroutine_t* running = (tb_coroutine_t*)tb_coroutine_self();
-    tb_assert(running);
-
-    // save this coroutine to the waiting recv coroutines
-    tb_single_list_entry_insert_tail(&channel->waiting_recv, &running->rs.single_entry);
-
-    // wait data
-    tb_coroutine_suspend(tb_null);
+    // save this coroutine to the waiting coroutines
+    tb_single_list_entry_insert_tail(waiting, &running->rs.single_entry);
 }
 static tb_void_t tb_co_channel_send_buffer(tb_co_channel_t* channel, tb_cpointer_t data)
 {
@@ -176,6 +131,9 @@ static tb_void_t tb_co_channel_send_buffer(tb_co_channel_t* channel, tb_cpointer
     // done
     do
     {
+        // enter lock
+        tb_spinlock_enter(&channel->lock);
+
         // put data into queue if be not full
         if (channel->queue.size + 1 < channel->queue.maxn)
         {
@@ -187,8 +145,14 @@ static tb_void_t tb_co_channel_send_buffer(tb_co_channel_t* channel, tb_cpointer
             channel->queue.tail = (channel->queue.tail + 1) % channel->queue.maxn;
             channel->queue.size++;
 
+            // get the first waiting recv coroutine
+            tb_coroutine_ref_t waiting = tb_co_channel_waiting_pop(&channel->waiting_recv);
+
+            // leave lock
+            tb_spinlock_leave(&channel->lock);
+
             // notify to recv data
-            tb_co_channel_recv_resume(channel);
+            if (waiting) tb_coroutine_resume(waiting, tb_null);
 
             // send ok
             break;
@@ -199,8 +163,14 @@ static tb_void_t tb_co_channel_send_buffer(tb_co_channel_t* channel, tb_cpointer
             // trace
             tb_trace_d("send[%p]: wait ..", tb_coroutine_self());
 
+            // save this coroutine to the waiting send coroutines
+            tb_co_channel_waiting_push(&channel->waiting_send, tb_null);
+
+            // leave lock
+            tb_spinlock_leave(&channel->lock);
+
             // wait send
-            tb_co_channel_send_suspend(channel, tb_null);
+            tb_coroutine_suspend(tb_null);
  
             // trace
             tb_trace_d("send[%p]: wait ok", tb_coroutine_self());
@@ -220,6 +190,9 @@ static tb_pointer_t tb_co_channel_recv_buffer(tb_co_channel_t* channel)
     tb_pointer_t data = tb_null;
     do
     {
+        // enter lock
+        tb_spinlock_enter(&channel->lock);
+
         // recv data from channel if be not null
         if (channel->queue.size)
         {
@@ -233,8 +206,14 @@ static tb_pointer_t tb_co_channel_recv_buffer(tb_co_channel_t* channel)
             // trace
             tb_trace_d("recv[%p]: get data(%p)", tb_coroutine_self(), data);
 
+            // get the first waiting send coroutine
+            tb_coroutine_ref_t waiting = tb_co_channel_waiting_pop(&channel->waiting_send);
+
+            // leave lock
+            tb_spinlock_leave(&channel->lock);
+
             // notify to send data
-            tb_co_channel_send_resume(channel, tb_null);
+            if (waiting) tb_coroutine_resume(waiting, tb_null);
 
             // recv ok
             break;
@@ -245,8 +224,14 @@ static tb_pointer_t tb_co_channel_recv_buffer(tb_co_channel_t* channel)
             // trace
             tb_trace_d("recv[%p]: wait ..", tb_coroutine_self());
 
+            // save this coroutine to the waiting recv coroutines
+            tb_co_channel_waiting_push(&channel->waiting_recv, tb_null);
+
+            // leave lock
+            tb_spinlock_leave(&channel->lock);
+
             // wait recv
-            tb_co_channel_recv_suspend(channel);
+            tb_coroutine_suspend(tb_null);
 
             // trace
             tb_trace_d("recv[%p]: wait ok", tb_coroutine_self());
@@ -265,7 +250,12 @@ static tb_bool_t tb_co_channel_send_buffer_try(tb_co_channel_t* channel, tb_cpoi
     // check
     tb_assert_and_check_return_val(channel && channel->queue.data, tb_false);
 
+    // enter lock
+    tb_spinlock_enter(&channel->lock);
+
     // put data into queue if be not full
+    tb_bool_t           ok = tb_false;
+    tb_coroutine_ref_t  waiting = tb_null;
     if (channel->queue.size + 1 < channel->queue.maxn)
     {
         // trace
@@ -276,22 +266,33 @@ static tb_bool_t tb_co_channel_send_buffer_try(tb_co_channel_t* channel, tb_cpoi
         channel->queue.tail = (channel->queue.tail + 1) % channel->queue.maxn;
         channel->queue.size++;
 
-        // notify to recv data
-        tb_co_channel_recv_resume(channel);
+        // get the first waiting recv coroutine
+        waiting = tb_co_channel_waiting_pop(&channel->waiting_recv);
 
         // send ok
-        return tb_true;
+        ok = tb_true;
     }
 
-    // failed
-    return tb_false;
+    // leave lock
+    tb_spinlock_leave(&channel->lock);
+
+    // notify to recv data
+    if (waiting) tb_coroutine_resume(waiting, tb_null);
+
+    // ok?
+    return ok;
 }
 static tb_bool_t tb_co_channel_recv_buffer_try(tb_co_channel_t* channel, tb_pointer_t* pdata)
 {
     // check
     tb_assert_and_check_return_val(channel && channel->queue.data && pdata, tb_false);
 
+    // enter lock
+    tb_spinlock_enter(&channel->lock);
+
     // recv data from channel if be not null
+    tb_bool_t           ok = tb_false;
+    tb_coroutine_ref_t  waiting = tb_null;
     if (channel->queue.size)
     {
         // get data
@@ -304,26 +305,44 @@ static tb_bool_t tb_co_channel_recv_buffer_try(tb_co_channel_t* channel, tb_poin
         // trace
         tb_trace_d("recv[%p]: get data(%p)", tb_coroutine_self(), *pdata);
 
-        // notify to send data
-        tb_co_channel_send_resume(channel, tb_null);
+        // get the first waiting send coroutine
+        waiting = tb_co_channel_waiting_pop(&channel->waiting_send);
 
         // recv ok
-        return tb_true;
+        ok = tb_true;
     }
 
-    // failed
-    return tb_false;
+    // leave lock
+    tb_spinlock_leave(&channel->lock);
+
+    // notify to send data
+    if (waiting) tb_coroutine_resume(waiting, tb_null);
+
+    // ok?
+    return ok;
 }
 static tb_void_t tb_co_channel_send_buffer0(tb_co_channel_t* channel, tb_cpointer_t data)
 {
     // check
     tb_assert(channel);
 
+    // enter lock
+    tb_spinlock_enter(&channel->lock);
+
+    // get the first waiting recv coroutine 
+    tb_coroutine_ref_t waiting = tb_co_channel_waiting_pop(&channel->waiting_recv);
+
+    // save this coroutine and data to the waiting send coroutines
+    tb_co_channel_waiting_push(&channel->waiting_send, data);
+
+    // leave lock
+    tb_spinlock_leave(&channel->lock);
+
     // resume one waiting recv coroutine 
-    tb_co_channel_recv_resume(channel);
+    if (waiting) tb_coroutine_resume(waiting, tb_null);
 
     // send data and wait it
-    tb_co_channel_send_suspend(channel, data);
+    tb_coroutine_suspend(data);
 }
 static tb_pointer_t tb_co_channel_recv_buffer0(tb_co_channel_t* channel)
 {
@@ -334,17 +353,33 @@ static tb_pointer_t tb_co_channel_recv_buffer0(tb_co_channel_t* channel)
     tb_pointer_t data = tb_null;
     do
     {
-        // resume the first waiting send coroutine and recv data
-        if (tb_co_channel_send_resume(channel, &data))
+        // enter lock
+        tb_spinlock_enter(&channel->lock);
+
+        // get the first waiting send coroutine
+        tb_coroutine_ref_t waiting = tb_co_channel_waiting_pop(&channel->waiting_send);
+        if (waiting)
         {
+            // leave lock
+            tb_spinlock_leave(&channel->lock);
+
+            // resume this coroutine and recv data
+            data = tb_coroutine_resume(waiting, tb_null);
+
             // recv ok
             break;
         }
         // no data?
         else
         {
+            // save this coroutine to the waiting recv coroutines
+            tb_co_channel_waiting_push(&channel->waiting_recv, tb_null);
+
+            // leave lock
+            tb_spinlock_leave(&channel->lock);
+
             // wait data
-            tb_co_channel_recv_suspend(channel);
+            tb_coroutine_suspend(tb_null);
         }
 
     } while (1);
@@ -373,6 +408,9 @@ tb_co_channel_ref_t tb_co_channel_init(tb_size_t size, tb_co_channel_free_func_t
         // init waiting recv coroutines
         tb_single_list_entry_init(&channel->waiting_recv, tb_coroutine_t, rs.single_entry, tb_null);
 
+        // init lock
+        if (!tb_spinlock_init(&channel->lock)) break;
+
         // init free function and data
         channel->free = free;
         channel->priv = priv;
@@ -440,6 +478,9 @@ tb_void_t tb_co_channel_exit(tb_co_channel_ref_t self)
     tb_single_list_entry_exit(&channel->waiting_send);
     tb_single_list_entry_exit(&channel->waiting_recv);
 
+    // exit lock
+    tb_spinlock_exit(&channel->lock);
+
     // exit the channel
     tb_free(channel);
 }
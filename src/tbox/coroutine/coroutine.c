@@ -41,6 +41,14 @@ tb_bool_t tb_coroutine_start(tb_co_scheduler_ref_t scheduler, tb_coroutine_func_
     // check
     tb_assert_and_check_return_val(func, tb_false);
 
+    // uses the current scheduler if be null
+    if (!scheduler) scheduler = tb_co_scheduler_self();
+    tb_assert_and_check_return_val(scheduler, tb_false);
+
+    // post it to the scheduler group for the M:N mode, it may be stolen by the other workers
+    if (((tb_co_scheduler_t*)scheduler)->group) 
+        return tb_co_scheduler_post((tb_co_scheduler_t*)scheduler, func, priv, stacksize);
+
     // start it
     return tb_co_scheduler_start((tb_co_scheduler_t*)scheduler, func, priv, stacksize);
 }
@@ -54,8 +62,19 @@ tb_bool_t tb_coroutine_yield()
 }
 tb_pointer_t tb_coroutine_resume(tb_coroutine_ref_t coroutine, tb_cpointer_t priv)
 {
+    // check
+    tb_assert_and_check_return_val(coroutine, tb_null);
+
     // get current scheduler
     tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+
+    /* this coroutine is owned by the other scheduler? 
+     *
+     * e.g. the other worker thread for the M:N mode, or it is resumed from the plain thread by tb_co_mpmc_channel_t
+     */
+    tb_co_scheduler_t* owner = (tb_co_scheduler_t*)tb_coroutine_scheduler((tb_coroutine_t*)coroutine);
+    if (owner && owner != scheduler) 
+        return tb_co_scheduler_resume_remote(owner, (tb_coroutine_t*)coroutine, priv);
         
     // resume the given coroutine
     return scheduler? tb_co_scheduler_resume(scheduler, (tb_coroutine_t*)coroutine, priv) : tb_null;
@@ -27,6 +27,7 @@
  */
 #include "lock.h"
 #include "channel.h"
+#include "mpmc_channel.h"
 #include "semaphore.h"
 #include "scheduler.h"
 #include "stackless/stackless.h"
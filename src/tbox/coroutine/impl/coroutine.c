@@ -31,9 +31,14 @@
  */
 #include "coroutine.h"
 #include "scheduler.h"
+#include "../../algorithm/algorithm.h"
 #if defined(__tb_valgrind__) && defined(TB_CONFIG_VALGRIND_HAVE_VALGRIND_STACK_REGISTER)
 #   include "valgrind/valgrind.h"
 #endif
+#if defined(TB_CONFIG_POSIX_HAVE_MMAP) && defined(TB_CONFIG_POSIX_HAVE_MPROTECT)
+#   include <sys/mman.h>
+#   include <errno.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -45,9 +50,367 @@
 // the default stack size
 #define TB_COROUTINE_STACK_DEFSIZE          (8192 << 1)
 
+// the coroutine head size at the stack top
+#define TB_COROUTINE_HEAD_SIZE              tb_align(sizeof(tb_coroutine_t), 16)
+
+/* use the mmap-backed stack with the guard page?
+ *
+ * the stack pages will be committed lazily by the kernel when they are touched,
+ * and the guard page will trap the stack overflow.
+ */
+#if defined(TB_CONFIG_POSIX_HAVE_MMAP) && defined(TB_CONFIG_POSIX_HAVE_MPROTECT)
+#   define TB_COROUTINE_STACK_MMAP
+#   ifndef MAP_ANONYMOUS
+#       define MAP_ANONYMOUS                MAP_ANON
+#   endif
+#   ifndef MAP_NORESERVE
+#       define MAP_NORESERVE                (0)
+#   endif
+#   ifndef MAP_STACK
+#       define MAP_STACK                    (0)
+#   endif
+#endif
+
+#ifdef TB_COROUTINE_STACK_MMAP
+
+// the coroutine stack slab size
+#   ifdef __tb_small__
+#       define TB_COROUTINE_STACK_SLAB_SIZE     (1 << 20)
+#   else
+#       define TB_COROUTINE_STACK_SLAB_SIZE     (1 << 22)
+#   endif
+
+/* the maximum guarded stack count
+ *
+ * every guard page will take two mappings, so we only protect the part of stacks,
+ * the other stacks will use the guard magic at the stack bottom.
+ */
+#   ifdef __tb_small__
+#       define TB_COROUTINE_STACK_GUARD_MAXN    (1024)
+#   else
+#       define TB_COROUTINE_STACK_GUARD_MAXN    (16384)
+#   endif
+
+// use the guard magic at the stack bottom to check the stack overflow?
+#   define tb_coroutine_stack_magic(coroutine)  (!((tb_coroutine_stack_slab_ref_t)(coroutine)->stackslab)->guarded)
+#else
+#   define tb_coroutine_stack_magic(coroutine)  (tb_true)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * types
+ */
+
+#ifdef TB_COROUTINE_STACK_MMAP
+/* the coroutine stack slab type
+ *
+ * we reserve the stacks with the same size from one mapping,
+ * because the process has only a limited number of mappings (e.g. vm.max_map_count on linux)
+ *
+ *  ---------------------------------------------------------------------------------------------
+ * | guard page | stack | coroutine head | guard page | stack | coroutine head | ... (slot count) |
+ *  ---------------------------------------------------------------------------------------------
+ * |<----------------- slot ------------>|
  */
+typedef struct __tb_coroutine_stack_slab_t
+{
+    // the list entry for the free slabs
+    tb_list_entry_t             entry;
+
+    // the mapped data
+    tb_byte_t*                  data;
+
+    // the slot size
+    tb_size_t                   slotsize;
+
+    // the slot count
+    tb_uint16_t                 count;
+
+    // are the guard pages protected?
+    tb_uint16_t                 guarded;
+
+    // the used slots
+    tb_uint64_t                 used;
+
+}tb_coroutine_stack_slab_t, *tb_coroutine_stack_slab_ref_t;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+#ifdef TB_COROUTINE_STACK_MMAP
+// the stack slabs lock
+static tb_spinlock_t            g_stack_lock = TB_SPINLOCK_INIT;
+
+// the stack slabs with the free slots
+static tb_list_entry_head_t     g_stack_slabs;
+
+// the stack slabs have been initialized?
+static tb_bool_t                g_stack_slabs_inited = tb_false;
+
+// the guarded stack count
+static tb_size_t                g_stack_guards = 0;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+#ifdef TB_COROUTINE_STACK_MMAP
+static tb_coroutine_stack_slab_ref_t tb_coroutine_stack_slab_init(tb_size_t slotsize)
+{
+    // done
+    tb_bool_t                       ok = tb_false;
+    tb_coroutine_stack_slab_ref_t   slab = tb_null;
+    do
+    {
+        // make slab
+        slab = tb_malloc0_type(tb_coroutine_stack_slab_t);
+        tb_assert_and_check_break(slab);
+
+        // init slab
+        slab->slotsize  = slotsize;
+        slab->count     = (tb_uint16_t)tb_max(1, tb_min(TB_COROUTINE_STACK_SLAB_SIZE / slotsize, 64));
+
+        // reserve the guard pages if the guarded stacks are not too many
+        tb_spinlock_enter(&g_stack_lock);
+        if (g_stack_guards + slab->count <= TB_COROUTINE_STACK_GUARD_MAXN)
+        {
+            g_stack_guards += slab->count;
+            slab->guarded = 1;
+        }
+        tb_spinlock_leave(&g_stack_lock);
+
+        /* reserve the stack space
+         *
+         * the pages will be not committed until they are touched, 
+         * so we can run many mostly idle coroutines with the large reserved stacks.
+         */
+        slab->data = (tb_byte_t*)mmap(tb_null, slab->count * slotsize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+        if (slab->data == MAP_FAILED)
+        {
+            // trace
+            tb_trace_e("map the coroutine stacks(%lu x %lu) failed, errno: %d", (tb_ulong_t)slab->count, slotsize, errno);
+            slab->data = tb_null;
+            break;
+        }
+
+        /* protect the guard pages
+         *
+         * every guard page will split the mapping, 
+         * so we will lose the overflow detection of this slab if the mapping count has been reached.
+         */
+        if (slab->guarded)
+        {
+            tb_size_t i = 0;
+            tb_size_t pagesize = tb_page_size();
+            for (i = 0; i < slab->count; i++)
+            {
+                if (mprotect(slab->data + i * slotsize, pagesize, PROT_NONE) != 0)
+                {
+                    // trace
+                    tb_trace_d("protect the guard page failed, errno: %d", errno);
+
+                    // restore the protected guard pages
+                    if (i) mprotect(slab->data, i * slotsize, PROT_READ | PROT_WRITE);
+                    break;
+                }
+            }
+            if (i < slab->count)
+            {
+                tb_spinlock_enter(&g_stack_lock);
+                g_stack_guards -= slab->count;
+                tb_spinlock_leave(&g_stack_lock);
+                slab->guarded = 0;
+            }
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && slab)
+    {
+        // release the reserved guard pages
+        if (slab->guarded)
+        {
+            tb_spinlock_enter(&g_stack_lock);
+            g_stack_guards -= slab->count;
+            tb_spinlock_leave(&g_stack_lock);
+        }
+
+        // exit it
+        tb_free(slab);
+        slab = tb_null;
+    }
+
+    // ok?
+    return slab;
+}
+static tb_void_t tb_coroutine_stack_slab_exit(tb_coroutine_stack_slab_ref_t slab)
+{
+    // check
+    tb_assert_and_check_return(slab && slab->data);
+
+    // release the reserved guard pages
+    if (slab->guarded)
+    {
+        tb_spinlock_enter(&g_stack_lock);
+        g_stack_guards -= slab->count;
+        tb_spinlock_leave(&g_stack_lock);
+    }
+
+    // unmap the whole slab
+    if (munmap(slab->data, slab->count * slab->slotsize) != 0)
+    {
+        tb_trace_e("unmap the coroutine stacks(%p) failed, errno: %d", slab->data, errno);
+    }
+
+    // exit it
+    tb_free(slab);
+}
+static tb_byte_t* tb_coroutine_stack_slab_alloc(tb_coroutine_stack_slab_ref_t slab)
+{
+    // check
+    tb_assert(slab && ~slab->used);
+
+    // alloc a free slot
+    tb_size_t index = tb_bits_fb1_u64_le(~slab->used);
+    tb_assert(index < slab->count);
+    slab->used |= ((tb_uint64_t)1 << index);
+
+    // the slab is full now? remove it from the free slabs
+    if (tb_bits_cb1_u64(slab->used) == slab->count)
+        tb_list_entry_remove(&g_stack_slabs, &slab->entry);
+
+    // ok
+    return slab->data + index * slab->slotsize;
+}
+#endif
+
+/* make the coroutine stack and put the coroutine head at the stack top
+ *
+ *  ------------------------------------------------
+ * | guard page | ... stacksize ... | coroutine head |
+ *  ------------------------------------------------
+ *                                  |
+ *                              stackbase
+ *
+ * we use the guard magic at the stack bottom instead of the guard page 
+ * if mmap is not supported or the guard pages are too many.
+ */
+static tb_coroutine_t* tb_coroutine_stack_init(tb_size_t stacksize)
+{
+    // done
+    tb_coroutine_t* coroutine = tb_null;
+#ifdef TB_COROUTINE_STACK_MMAP
+    do
+    {
+        // the page size
+        tb_size_t pagesize = tb_page_size();
+        tb_assert_and_check_break(pagesize);
+
+        // the slot size will be aligned to the whole pages
+        tb_size_t slotsize = tb_align(pagesize + stacksize + TB_COROUTINE_HEAD_SIZE, pagesize);
+
+        // get a free slot from the free slabs with the same slot size
+        tb_byte_t*                      data = tb_null;
+        tb_coroutine_stack_slab_ref_t   slab = tb_null;
+        tb_spinlock_enter(&g_stack_lock);
+        if (!g_stack_slabs_inited)
+        {
+            tb_list_entry_init(&g_stack_slabs, tb_coroutine_stack_slab_t, entry, tb_null);
+            g_stack_slabs_inited = tb_true;
+        }
+        tb_for_all_if (tb_coroutine_stack_slab_ref_t, item, tb_list_entry_itor(&g_stack_slabs), item)
+        {
+            if (item->slotsize == slotsize)
+            {
+                slab = item;
+                data = tb_coroutine_stack_slab_alloc(slab);
+                break;
+            }
+        }
+        tb_spinlock_leave(&g_stack_lock);
+
+        // no free slots? make a new slab
+        if (!data)
+        {
+            // make slab
+            slab = tb_coroutine_stack_slab_init(slotsize);
+            tb_check_break(slab);
+
+            // alloc a free slot from it
+            tb_spinlock_enter(&g_stack_lock);
+            tb_list_entry_insert_head(&g_stack_slabs, &slab->entry);
+            data = tb_coroutine_stack_slab_alloc(slab);
+            tb_spinlock_leave(&g_stack_lock);
+        }
+
+        // init coroutine at the stack top
+        coroutine = (tb_coroutine_t*)(data + slotsize - TB_COROUTINE_HEAD_SIZE);
+        coroutine->stackbase = (tb_byte_t*)coroutine;
+        coroutine->stacksize = slotsize - pagesize - TB_COROUTINE_HEAD_SIZE;
+        coroutine->stackslab = slab;
+
+    } while (0);
+#else
+    // make stack and coroutine
+    stacksize = tb_align(stacksize, 16);
+    tb_byte_t* data = (tb_byte_t*)tb_malloc_bytes(stacksize + TB_COROUTINE_HEAD_SIZE);
+    if (data)
+    {
+        // init coroutine at the stack top
+        coroutine = (tb_coroutine_t*)(data + stacksize);
+        coroutine->stackbase = (tb_byte_t*)coroutine;
+        coroutine->stacksize = stacksize;
+    }
+#endif
+
+    // ok?
+    return coroutine;
+}
+static tb_void_t tb_coroutine_stack_exit(tb_coroutine_t* coroutine)
+{
+#ifdef TB_COROUTINE_STACK_MMAP
+    // the slab
+    tb_coroutine_stack_slab_ref_t slab = (tb_coroutine_stack_slab_ref_t)coroutine->stackslab;
+    tb_assert_and_check_return(slab);
+
+    // the slot index
+    tb_byte_t*  data = coroutine->stackbase + TB_COROUTINE_HEAD_SIZE - slab->slotsize;
+    tb_size_t   index = (data - slab->data) / slab->slotsize;
+    tb_assert_and_check_return(index < slab->count);
+
+#if defined(TB_CONFIG_POSIX_HAVE_MADVISE) && defined(MADV_DONTNEED)
+    // release the whole slot pages, the coroutine head will be not used now
+    tb_size_t pagesize = tb_page_size();
+    madvise(data + pagesize, slab->slotsize - pagesize, MADV_DONTNEED);
+#endif
+
+    // free this slot
+    tb_bool_t empty = tb_false;
+    tb_spinlock_enter(&g_stack_lock);
+    if (tb_bits_cb1_u64(slab->used) == slab->count)
+        tb_list_entry_insert_head(&g_stack_slabs, &slab->entry);
+    slab->used &= ~((tb_uint64_t)1 << index);
+    if (!slab->used)
+    {
+        tb_list_entry_remove(&g_stack_slabs, &slab->entry);
+        empty = tb_true;
+    }
+    tb_spinlock_leave(&g_stack_lock);
+
+    // unmap this slab if all slots are free
+    if (empty) tb_coroutine_stack_slab_exit(slab);
+#else
+    // free the whole stack
+    tb_free(coroutine->stackbase - coroutine->stacksize);
+#endif
+}
 static tb_void_t tb_coroutine_entry(tb_context_from_t from)
 {
     // get the from-coroutine 
@@ -106,29 +469,25 @@ tb_coroutine_t* tb_coroutine_init(tb_co_scheduler_ref_t scheduler, tb_coroutine_
         stacksize <<= 1;
 #endif
 
-        /* make coroutine
-         *
-         * TODO: 
-         *
-         * - segment stack 
-         *
-         *  -----------------------------------------------
-         * | coroutine | guard | ... stacksize ... | guard |
-         *  -----------------------------------------------
-         */
-        coroutine = (tb_coroutine_t*)tb_malloc_bytes(sizeof(tb_coroutine_t) + stacksize + sizeof(tb_uint16_t));
+        // make coroutine with the stack
+        coroutine = tb_coroutine_stack_init(stacksize);
         tb_assert_and_check_break(coroutine);
 
         // save scheduler
         coroutine->scheduler = scheduler;
 
-        // init stack
-        coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
-        coroutine->stacksize = stacksize;
+        // the stack pages are committed now
+        coroutine->decommitted = 0;
+
+        // the real stack size
+        stacksize = coroutine->stacksize;
 
         // fill guard
         coroutine->guard = TB_COROUTINE_STACK_GUARD;
-        tb_bits_set_u16_ne(coroutine->stackbase, TB_COROUTINE_STACK_GUARD);
+#ifdef __tb_debug__
+        if (tb_coroutine_stack_magic(coroutine))
+            tb_bits_set_u16_ne(coroutine->stackbase - stacksize, TB_COROUTINE_STACK_GUARD);
+#endif
 
         // init function and user private data
         coroutine->rs.func.func = func;
@@ -187,19 +546,22 @@ tb_coroutine_t* tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_coroutine_func
         VALGRIND_STACK_DEREGISTER(coroutine->valgrind_stack_id);
 #endif
 
-        // remake coroutine
-        if (stacksize > coroutine->stacksize)
-            coroutine = (tb_coroutine_t*)tb_ralloc_bytes(coroutine, sizeof(tb_coroutine_t) + stacksize + sizeof(tb_uint16_t));
-        else stacksize = coroutine->stacksize;
-        tb_assert_and_check_break(coroutine && coroutine->scheduler);
+        // the stack is too small? we need make a new coroutine
+        tb_check_break(stacksize <= coroutine->stacksize);
+        tb_assert_and_check_break(coroutine->scheduler);
 
-        // init stack
-        coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
-        coroutine->stacksize = stacksize;
+        // reuse the whole stack
+        stacksize = coroutine->stacksize;
+
+        // the stack pages will be committed again when they are touched
+        coroutine->decommitted = 0;
 
         // fill guard
         coroutine->guard = TB_COROUTINE_STACK_GUARD;
-        tb_bits_set_u16_ne(coroutine->stackbase, TB_COROUTINE_STACK_GUARD);
+#ifdef __tb_debug__
+        if (tb_coroutine_stack_magic(coroutine))
+            tb_bits_set_u16_ne(coroutine->stackbase - stacksize, TB_COROUTINE_STACK_GUARD);
+#endif
 
         // init function and user private data
         coroutine->rs.func.func = func;
@@ -247,7 +609,36 @@ tb_void_t tb_coroutine_exit(tb_coroutine_t* coroutine)
 #endif
 
     // exit it
-    tb_free(coroutine);
+    tb_coroutine_stack_exit(coroutine);
+}
+tb_void_t tb_coroutine_decommit(tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert_and_check_return(coroutine && !tb_coroutine_is_original(coroutine));
+
+    // have been decommitted?
+    tb_check_return(!coroutine->decommitted);
+    coroutine->decommitted = 1;
+
+#if defined(TB_COROUTINE_STACK_MMAP) && defined(TB_CONFIG_POSIX_HAVE_MADVISE) && defined(MADV_DONTNEED)
+    // the stack bottom, it's page aligned after the guard page
+    tb_byte_t* stack = coroutine->stackbase - coroutine->stacksize;
+
+    // the top page will be kept, because the coroutine head and the top frames are always used
+    tb_byte_t* top = (tb_byte_t*)((tb_size_t)coroutine->stackbase & ~(tb_page_size() - 1));
+
+    // release the other stack pages, they will be zero-filled and committed again when they are touched
+    if (top > stack && madvise(stack, top - stack, MADV_DONTNEED) != 0)
+    {
+        tb_trace_d("decommit the coroutine(%p) stack failed, errno: %d", coroutine, errno);
+    }
+
+#ifdef __tb_debug__
+    // restore the guard magic
+    if (tb_coroutine_stack_magic(coroutine))
+        tb_bits_set_u16_ne(stack, TB_COROUTINE_STACK_GUARD);
+#endif
+#endif
 }
 #ifdef __tb_debug__
 tb_void_t tb_coroutine_check(tb_coroutine_t* coroutine)
@@ -271,8 +662,8 @@ tb_void_t tb_coroutine_check(tb_coroutine_t* coroutine)
         tb_abort();
     }
 
-    // check stack overflow
-    if (tb_bits_get_u16_ne(coroutine->stackbase) != TB_COROUTINE_STACK_GUARD)
+    // check stack overflow, it will be trapped by the guard page for the guarded stack
+    if (tb_coroutine_stack_magic(coroutine) && tb_bits_get_u16_ne(coroutine->stackbase - coroutine->stacksize) != TB_COROUTINE_STACK_GUARD)
     {
         // trace
         tb_trace_e("this coroutine stack is overflow!");
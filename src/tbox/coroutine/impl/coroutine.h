@@ -60,24 +60,20 @@ typedef struct __tb_coroutine_rs_func_t
 // the coroutine wait type
 typedef struct __tb_coroutine_rs_wait_t
 {
-    /* the timer task pointer for ltimer or timer
-     *
-     * for ltimer:  task
-     * for timer:   task & 0x1
-     */
-    tb_cpointer_t                   task;
+    // the timer task
+    tb_timer_task_ref_t             task;
 
     // the socket
     tb_socket_ref_t                 sock;
 
     // the waiting events
-    tb_uint16_t                     events          : 6;
+    tb_uint32_t                     events          : 6;
 
-    // the cached events
-    tb_uint16_t                     events_cache    : 6;
+    // the cached events, with TB_POLLER_EVENT_EOF and TB_POLLER_EVENT_ERROR
+    tb_uint32_t                     events_cache    : 10;
 
     // is waiting?
-    tb_uint16_t                     waiting         : 1;
+    tb_uint32_t                     waiting         : 1;
 
 }tb_coroutine_rs_wait_t;
 
@@ -102,6 +98,9 @@ typedef struct __tb_coroutine_t
     // the stack size
     tb_size_t                       stacksize;
 
+    // the stack slab
+    tb_pointer_t                    stackslab;
+
     // the passed user private data between priv = resume(priv) and priv = suspend(priv)
     tb_cpointer_t                   rs_priv;
 
@@ -122,6 +121,9 @@ typedef struct __tb_coroutine_t
     // the guard
     tb_uint16_t                     guard;
 
+    // the unused stack pages have been decommitted?
+    tb_uint16_t                     decommitted;
+
 #if defined(__tb_valgrind__) && defined(TB_CONFIG_VALGRIND_HAVE_VALGRIND_STACK_REGISTER)
     // the valgrind stack id, helo valgrind to understand coroutine
     tb_uint_t                       valgrind_stack_id;
@@ -161,6 +163,15 @@ tb_coroutine_t*         tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_corout
  */
 tb_void_t               tb_coroutine_exit(tb_coroutine_t* coroutine);
 
+/* decommit the unused stack pages of the dead coroutine
+ *
+ * the pages will be committed again when they are touched after reusing it,
+ * and it will do nothing if the stack has been decommitted and not been reused
+ *
+ * @param coroutine     the coroutine
+ */
+tb_void_t               tb_coroutine_decommit(tb_coroutine_t* coroutine);
+
 #ifdef __tb_debug__
 /* check coroutine
  *
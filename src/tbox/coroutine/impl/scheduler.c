@@ -37,11 +37,32 @@
  * macros
  */
 
+// the dead cache minimum count
+#ifdef __tb_small__
+#   define TB_SCHEDULER_DEAD_CACHE_MINN     (64)
+#else
+#   define TB_SCHEDULER_DEAD_CACHE_MINN     (256)
+#endif
+
 // the dead cache maximum count
 #ifdef __tb_small__
-#   define TB_SCHEDULER_DEAD_CACHE_MAXN     (64)
+#   define TB_SCHEDULER_DEAD_CACHE_MAXN     (1024)
+#else
+#   define TB_SCHEDULER_DEAD_CACHE_MAXN     (16384)
+#endif
+
+// the hot dead coroutines count, their stacks will be not decommitted for reusing them quickly
+#ifdef __tb_small__
+#   define TB_SCHEDULER_DEAD_CACHE_HOTN     (4)
 #else
-#   define TB_SCHEDULER_DEAD_CACHE_MAXN     (256)
+#   define TB_SCHEDULER_DEAD_CACHE_HOTN     (16)
+#endif
+
+// the maximum count of the pulled pending tasks for each loop (M:N mode)
+#ifdef __tb_small__
+#   define TB_SCHEDULER_PULL_MAXN           (16)
+#else
+#   define TB_SCHEDULER_PULL_MAXN           (64)
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -61,6 +82,12 @@ static tb_void_t tb_co_scheduler_make_dead(tb_co_scheduler_t* scheduler, tb_coro
     // append this coroutine to dead coroutines
     tb_list_entry_insert_tail(&scheduler->coroutines_dead, (tb_list_entry_ref_t)coroutine);
 }
+static __tb_inline__ tb_size_t tb_co_scheduler_dead_maxn(tb_co_scheduler_t* scheduler)
+{
+    // we keep the dead coroutines for 1/8 of the living coroutines to reuse their stacks
+    tb_size_t maxn = (tb_co_scheduler_ready_count(scheduler) + tb_co_scheduler_suspend_count(scheduler)) >> 3;
+    return tb_max(TB_SCHEDULER_DEAD_CACHE_MINN, tb_min(maxn, TB_SCHEDULER_DEAD_CACHE_MAXN));
+}
 static tb_void_t tb_co_scheduler_make_ready(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
 {
     // check
@@ -108,6 +135,127 @@ static __tb_inline__ tb_coroutine_t* tb_co_scheduler_next_ready(tb_co_scheduler_
     // get the next ready coroutine
     return (tb_coroutine_t*)tb_list_entry0(entry_next);
 }
+static tb_void_t tb_co_scheduler_notify(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    // only spak it once if this worker is waiting io events now
+    if (tb_atomic_fetch_and_pset(&scheduler->idle, 1, 0)) 
+    {
+        // check
+        tb_assert(scheduler->scheduler_io && scheduler->scheduler_io->poller);
+
+        // spak the poller
+        tb_poller_spak(scheduler->scheduler_io->poller);
+    }
+}
+static tb_void_t tb_co_scheduler_notify_idle(tb_co_scheduler_group_t* group, tb_co_scheduler_t* busy)
+{
+    // check
+    tb_assert(group && group->workers);
+
+    // notify the first idle worker to steal the pending tasks of the busy worker
+    tb_size_t i = 0;
+    for (i = 0; i < group->count; i++)
+    {
+        tb_co_scheduler_t* worker = group->workers[i];
+        if (worker != busy && tb_atomic_get(&worker->idle))
+        {
+            tb_co_scheduler_notify(worker);
+            break;
+        }
+    }
+}
+static tb_void_t tb_co_scheduler_task_entry(tb_cpointer_t priv)
+{
+    // check
+    tb_co_scheduler_task_t* task = (tb_co_scheduler_task_t*)priv;
+    tb_assert_and_check_return(task && task->func && task->group);
+
+    // get the coroutine function and group
+    tb_coroutine_func_t         func = task->func;
+    tb_cpointer_t               data = task->priv;
+    tb_co_scheduler_group_t*    group = task->group;
+
+    // exit task
+    tb_free(task);
+
+    // call the coroutine function
+    func(data);
+
+    // all coroutines have been finished? stop all workers
+    if (!tb_atomic_dec_and_fetch(&group->coroutines))
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+        {
+            // stop this worker 
+            tb_co_scheduler_t* worker = group->workers[i];
+            tb_atomic_set(&worker->stopped, 1);
+
+            // break the io loop of this worker, we need not kill the timers of the other threads
+            if (worker->scheduler_io) tb_poller_spak(worker->scheduler_io->poller);
+        }
+    }
+}
+static tb_size_t tb_co_scheduler_steal(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler->group;
+    tb_assert(group && group->workers);
+
+    // find the worker index
+    tb_size_t i = 0;
+    tb_size_t index = 0;
+    for (i = 0; i < group->count; i++)
+    {
+        if (group->workers[i] == scheduler) 
+        {
+            index = i;
+            break;
+        }
+    }
+
+    // steal the half of pending tasks from the first busy worker, starting from the next worker
+    tb_size_t               stolen = 0;
+    tb_co_scheduler_task_t* tasks[TB_SCHEDULER_PULL_MAXN];
+    for (i = 1; i < group->count && !stolen; i++)
+    {
+        // get the victim worker
+        tb_co_scheduler_t* victim = group->workers[(index + i) % group->count];
+        tb_assert(victim && victim != scheduler);
+
+        // no pending tasks? skip it quickly without lock
+        tb_check_continue(tb_single_list_entry_size(&victim->tasks));
+
+        // steal them, @note we cannot hold the both locks at the same time
+        tb_spinlock_enter(&victim->lock);
+        tb_size_t count = tb_min((tb_single_list_entry_size(&victim->tasks) + 1) >> 1, TB_SCHEDULER_PULL_MAXN);
+        while (stolen < count)
+        {
+            tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&victim->tasks);
+            tb_single_list_entry_remove_head(&victim->tasks);
+            tasks[stolen++] = (tb_co_scheduler_task_t*)tb_single_list_entry(&victim->tasks, entry);
+        }
+        tb_spinlock_leave(&victim->lock);
+    }
+
+    // move them to the local pending tasks
+    if (stolen)
+    {
+        tb_spinlock_enter(&scheduler->lock);
+        for (i = 0; i < stolen; i++)
+            tb_single_list_entry_insert_tail(&scheduler->tasks, &tasks[i]->entry);
+        tb_spinlock_leave(&scheduler->lock);
+    }
+
+    // trace
+    tb_trace_d("steal %lu tasks", stolen);
+
+    // ok?
+    return stolen;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -130,17 +278,17 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
         tb_assert_and_check_break(scheduler);
 
         // have been stopped? do not continue to start new coroutines
-        tb_check_break(!scheduler->stopped);
+        tb_check_break(!tb_atomic_get(&scheduler->stopped));
 
-        // reuses dead coroutines in init function
+        // reuses the last dead coroutines in init function, their stacks are still hot
         if (tb_list_entry_size(&scheduler->coroutines_dead))
         {
-            // get the next entry from head
-            tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
+            // get the last entry
+            tb_list_entry_ref_t entry = tb_list_entry_last(&scheduler->coroutines_dead);
             tb_assert_and_check_break(entry);
 
-            // remove it from the ready coroutines
-            tb_list_entry_remove_head(&scheduler->coroutines_dead);
+            // remove it from the dead coroutines
+            tb_list_entry_remove_last(&scheduler->coroutines_dead);
 
             // get the dead coroutine
             tb_coroutine_t* coroutine_dead = (tb_coroutine_t*)tb_list_entry0(entry);
@@ -159,7 +307,11 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
         // ready coroutine
         tb_co_scheduler_make_ready(scheduler, coroutine);
 
-        // the dead coroutines is too much? free some coroutines
+        /* the dead coroutines is too much? free some cold coroutines
+         *
+         * we only free them above the maximum count here, so the bursts of short-lived coroutines can reuse the hot stacks,
+         * and the dead cache will be trimmed to the living coroutines when the scheduler is idle.
+         */
         while (tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_CACHE_MAXN)
         {
             // get the next entry from head
@@ -184,6 +336,158 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
     // ok?
     return ok;
 }
+tb_void_t tb_co_scheduler_trim(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    // free the coldest dead coroutines, we keep them for 1/8 of the living coroutines
+    tb_size_t dead_maxn = tb_co_scheduler_dead_maxn(scheduler);
+    while (tb_list_entry_size(&scheduler->coroutines_dead) > dead_maxn)
+    {
+        // get the next entry from head
+        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
+        tb_assert(entry);
+
+        // remove it from the dead coroutines
+        tb_list_entry_remove_head(&scheduler->coroutines_dead);
+
+        // exit this coroutine
+        tb_coroutine_exit((tb_coroutine_t*)tb_list_entry0(entry));
+    }
+
+    // no cold dead coroutines?
+    tb_size_t count = tb_list_entry_size(&scheduler->coroutines_dead);
+    tb_check_return(count > TB_SCHEDULER_DEAD_CACHE_HOTN);
+
+    /* decommit the stacks of the cold dead coroutines from the tail of the cold window
+     *
+     * the dead coroutines are appended and reused at the tail, so the decommitted stacks are always at the head,
+     * and we can stop at the first decommitted stack.
+     */
+    tb_size_t           n = TB_SCHEDULER_DEAD_CACHE_HOTN;
+    tb_list_entry_ref_t entry = tb_list_entry_last(&scheduler->coroutines_dead);
+    while (n--) entry = tb_list_entry_prev(entry);
+    for (count -= TB_SCHEDULER_DEAD_CACHE_HOTN; count; count--)
+    {
+        // have been decommitted? the colder stacks have been decommitted too
+        tb_coroutine_t* coroutine = (tb_coroutine_t*)tb_list_entry0(entry);
+        tb_check_break(!coroutine->decommitted);
+
+        // decommit it
+        tb_coroutine_decommit(coroutine);
+
+        // the previous colder entry
+        entry = tb_list_entry_prev(entry);
+    }
+}
+tb_bool_t tb_co_scheduler_post(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    // check
+    tb_assert(scheduler && func);
+
+    // get the scheduler group
+    tb_co_scheduler_group_t* group = scheduler->group;
+    tb_assert_and_check_return_val(group && group->count, tb_false);
+
+    // have been stopped? do not continue to post new tasks
+    tb_check_return_val(!tb_atomic_get(&scheduler->stopped), tb_false);
+
+    // make task
+    tb_co_scheduler_task_t* task = tb_malloc0_type(tb_co_scheduler_task_t);
+    tb_assert_and_check_return_val(task, tb_false);
+
+    // init task
+    task->func      = func;
+    task->priv      = priv;
+    task->stacksize = stacksize;
+    task->group     = group;
+
+    /* post it to the current worker if we are running on the worker of this group, 
+     * otherwise select the next worker in turn
+     */
+    tb_co_scheduler_t* self = (tb_co_scheduler_t*)tb_co_scheduler_self();
+    tb_co_scheduler_t* worker = (self && self->group == group)? self : group->workers[(tb_size_t)tb_atomic_fetch_and_inc(&group->next) % group->count];
+    tb_assert(worker);
+
+    // the pending coroutines count++
+    tb_atomic_fetch_and_inc(&group->coroutines);
+
+    // post it to the pending tasks
+    tb_spinlock_enter(&worker->lock);
+    tb_single_list_entry_insert_tail(&worker->tasks, &task->entry);
+    tb_spinlock_leave(&worker->lock);
+
+    // notify this worker if it is waiting io events on the other thread
+    if (worker != self) tb_co_scheduler_notify(worker);
+
+    // notify one idle worker to steal the pending tasks
+    tb_co_scheduler_notify_idle(group, worker);
+
+    // ok
+    return tb_true;
+}
+tb_size_t tb_co_scheduler_pull(tb_co_scheduler_t* scheduler, tb_bool_t steal)
+{
+    // check
+    tb_assert(scheduler && (scheduler->group || !steal));
+
+    // no pending tasks and resumed coroutines? steal some tasks from the other workers
+    if (    !tb_single_list_entry_size(&scheduler->tasks)
+        &&  !tb_single_list_entry_size(&scheduler->coroutines_remote)
+        &&  (!steal || !tb_co_scheduler_steal(scheduler)))
+        return 0;
+
+    // @note the resumed private data is saved to rs.func.priv, it will not be overwrited by rs.single_entry
+    tb_assert_static(sizeof(tb_single_list_entry_t) <= tb_offsetof(tb_coroutine_rs_func_t, priv));
+
+    // pull them
+    tb_size_t               size = 0;
+    tb_size_t               count = 0;
+    tb_co_scheduler_task_t* tasks[TB_SCHEDULER_PULL_MAXN];
+    tb_spinlock_enter(&scheduler->lock);
+    while (tb_single_list_entry_size(&scheduler->coroutines_remote))
+    {
+        // get the resumed coroutine
+        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&scheduler->coroutines_remote);
+        tb_single_list_entry_remove_head(&scheduler->coroutines_remote);
+        tb_coroutine_t* coroutine = (tb_coroutine_t*)tb_single_list_entry(&scheduler->coroutines_remote, entry);
+
+        // resume it on the current thread
+        tb_co_scheduler_resume(scheduler, coroutine, coroutine->rs.func.priv);
+        count++;
+    }
+    while (size < TB_SCHEDULER_PULL_MAXN && tb_single_list_entry_size(&scheduler->tasks))
+    {
+        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&scheduler->tasks);
+        tb_single_list_entry_remove_head(&scheduler->tasks);
+        tasks[size++] = (tb_co_scheduler_task_t*)tb_single_list_entry(&scheduler->tasks, entry);
+    }
+    tb_spinlock_leave(&scheduler->lock);
+
+    // start the pending tasks
+    tb_size_t i = 0;
+    for (i = 0; i < size; i++)
+    {
+        tb_co_scheduler_task_t* task = tasks[i];
+        if (!tb_co_scheduler_start(scheduler, tb_co_scheduler_task_entry, task, task->stacksize))
+        {
+            // trace
+            tb_trace_e("failed to start the pending task(%p)!", task);
+
+            // exit it
+            tb_atomic_fetch_and_dec(&task->group->coroutines);
+            tb_free(task);
+        }
+    }
+    count += size;
+
+    // trace
+    tb_trace_d("pull %lu", count);
+
+    // ok?
+    return count;
+}
 tb_bool_t tb_co_scheduler_yield(tb_co_scheduler_t* scheduler)
 {
     // check
@@ -244,6 +548,33 @@ tb_pointer_t tb_co_scheduler_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t
     // return it
     return retval;
 }
+tb_pointer_t tb_co_scheduler_resume_remote(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(scheduler && coroutine);
+
+    // trace
+    tb_trace_d("resume coroutine(%p) on the other thread", coroutine);
+
+    // post it to the resumed coroutines of the owner scheduler
+    tb_spinlock_enter(&scheduler->lock);
+
+    // get the passed private data from suspend(priv)
+    tb_pointer_t retval = (tb_pointer_t)coroutine->rs_priv;
+
+    // save the user private data, it will be passed to suspend() after pulling it
+    coroutine->rs.func.priv = priv;
+
+    // append it to the resumed coroutines
+    tb_single_list_entry_insert_tail(&scheduler->coroutines_remote, &coroutine->rs.single_entry);
+    tb_spinlock_leave(&scheduler->lock);
+
+    // notify the owner scheduler if it is waiting io events
+    tb_co_scheduler_notify(scheduler);
+
+    // return it
+    return retval;
+}
 tb_pointer_t tb_co_scheduler_suspend(tb_co_scheduler_t* scheduler, tb_cpointer_t priv)
 {
     // check
@@ -251,7 +582,7 @@ tb_pointer_t tb_co_scheduler_suspend(tb_co_scheduler_t* scheduler, tb_cpointer_t
     tb_assert(scheduler->running == (tb_coroutine_t*)tb_coroutine_self());
 
     // have been stopped? return it directly
-    tb_check_return_val(!scheduler->stopped, tb_null);
+    tb_check_return_val(!tb_atomic_get(&scheduler->stopped), tb_null);
 
     // trace
     tb_trace_d("suspend coroutine(%p)", scheduler->running);
@@ -327,7 +658,7 @@ tb_pointer_t tb_co_scheduler_sleep(tb_co_scheduler_t* scheduler, tb_long_t inter
     tb_assert(scheduler->running == (tb_coroutine_t*)tb_coroutine_self());
 
     // have been stopped? return it directly
-    tb_check_return_val(!scheduler->stopped, tb_null);
+    tb_check_return_val(!tb_atomic_get(&scheduler->stopped), tb_null);
 
     // need io scheduler
     if (!tb_co_scheduler_io_need(scheduler)) return tb_null;
@@ -372,7 +703,7 @@ tb_long_t tb_co_scheduler_wait(tb_co_scheduler_t* scheduler, tb_socket_ref_t soc
     tb_assert(scheduler->running == (tb_coroutine_t*)tb_coroutine_self());
 
     // have been stopped? return it directly
-    tb_check_return_val(!scheduler->stopped, -1);
+    tb_check_return_val(!tb_atomic_get(&scheduler->stopped), -1);
 
     // need io scheduler
     if (!tb_co_scheduler_io_need(scheduler)) return -1;
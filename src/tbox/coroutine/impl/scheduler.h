@@ -56,6 +56,29 @@ __tb_extern_c_enter__
 // the io scheduler type
 struct __tb_co_scheduler_io_t;
 
+// the scheduler group type for the M:N mode
+struct __tb_co_scheduler_group_t;
+
+// the pending coroutine task type for the M:N mode
+typedef struct __tb_co_scheduler_task_t
+{
+    // the single list entry
+    tb_single_list_entry_t          entry;
+
+    // the coroutine function
+    tb_coroutine_func_t             func;
+
+    // the user private data as the argument of function
+    tb_cpointer_t                   priv;
+
+    // the stack size
+    tb_size_t                       stacksize;
+
+    // the scheduler group
+    struct __tb_co_scheduler_group_t* group;
+
+}tb_co_scheduler_task_t;
+
 // the scheduler type
 typedef struct __tb_co_scheduler_t
 {   
@@ -65,8 +88,8 @@ typedef struct __tb_co_scheduler_t
      */
     tb_coroutine_t                  original;
 
-    // is stopped
-    tb_bool_t                       stopped;
+    // is stopped? it may be set by the other worker threads in the M:N mode
+    tb_atomic_t                     stopped;
 
     // the running coroutine
     tb_coroutine_t*                 running;
@@ -88,8 +111,46 @@ typedef struct __tb_co_scheduler_t
     // the suspend coroutines
     tb_list_entry_head_t            coroutines_suspend;
 
+    // the scheduler group for the M:N mode, be null for the single-threaded mode
+    struct __tb_co_scheduler_group_t* group;
+
+    /* the lock of the pending tasks and the resumed coroutines from the other threads (M:N mode)
+     *
+     * the other workers will steal the pending tasks if they are idle
+     */
+    tb_spinlock_t                   lock;
+
+    // the pending tasks (M:N mode)
+    tb_single_list_entry_head_t     tasks;
+
+    // the resumed coroutines from the other threads (M:N mode or the cross-thread channel)
+    tb_single_list_entry_head_t     coroutines_remote;
+
+    // is waiting io events now?
+    tb_atomic_t                     idle;
+
 }tb_co_scheduler_t;
 
+// the scheduler group type for the M:N mode
+typedef struct __tb_co_scheduler_group_t
+{
+    // the worker schedulers, the first worker is the root scheduler
+    tb_co_scheduler_t**             workers;
+
+    // the worker count
+    tb_size_t                       count;
+
+    // the worker threads
+    tb_thread_ref_t*                threads;
+
+    // the pending and alive coroutines count of all workers
+    tb_atomic_t                     coroutines;
+
+    // the next worker index for posting tasks from the other threads
+    tb_atomic_t                     next;
+
+}tb_co_scheduler_group_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -105,6 +166,36 @@ typedef struct __tb_co_scheduler_t
  */
 tb_bool_t                   tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
 
+/* trim the dead coroutines cache, free the coldest coroutines and decommit the stacks of the cold coroutines
+ *
+ * it will be called before waiting io events, so the start and finish path will be not slowed down
+ *
+ * @param scheduler         the scheduler
+ */
+tb_void_t                   tb_co_scheduler_trim(tb_co_scheduler_t* scheduler);
+
+/* post the coroutine function to the scheduler group (M:N mode)
+ *
+ * the coroutine will be started later on the current worker or stolen by the other idle workers
+ *
+ * @param scheduler         the worker scheduler of the scheduler group
+ * @param func              the coroutine function
+ * @param priv              the passed user private data as the argument of function
+ * @param stacksize         the stack size
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   tb_co_scheduler_post(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
+
+/* pull the pending tasks and the resumed coroutines from the other threads
+ *
+ * @param scheduler         the scheduler
+ * @param steal             steal the pending tasks from the other workers if no local tasks? (M:N mode only)
+ *
+ * @return                  the pulled count
+ */
+tb_size_t                   tb_co_scheduler_pull(tb_co_scheduler_t* scheduler, tb_bool_t steal);
+
 /* yield the current coroutine
  *
  * @param scheduler         the scheduler
@@ -123,6 +214,18 @@ tb_bool_t                   tb_co_scheduler_yield(tb_co_scheduler_t* scheduler);
  */
 tb_pointer_t                tb_co_scheduler_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine, tb_cpointer_t priv);
 
+/*! resume the given coroutine (suspended) on the other thread
+ *
+ * it will be pulled and resumed by the io loop of the owner scheduler later
+ *
+ * @param scheduler         the owner scheduler of this coroutine
+ * @param coroutine         the suspended coroutine
+ * @param priv              the user private data as the return value of suspend() or sleep()
+ *
+ * @return                  the user private data from suspend(priv)
+ */
+tb_pointer_t                tb_co_scheduler_resume_remote(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine, tb_cpointer_t priv);
+
 /* suspend the current coroutine
  *
  * @param scheduler         the scheduler
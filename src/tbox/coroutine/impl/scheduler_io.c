@@ -36,15 +36,19 @@
  * macros
  */
 
-// the ltimer grow
+// the timer grow
 #ifdef __tb_small__
-#   define TB_SCHEDULER_IO_LTIMER_GROW      (64)
+#   define TB_SCHEDULER_IO_TIMER_GROW       (64)
 #else
-#   define TB_SCHEDULER_IO_LTIMER_GROW      (4096)
+#   define TB_SCHEDULER_IO_TIMER_GROW       (4096)
 #endif
 
-// the timer grow
-#define TB_SCHEDULER_IO_TIMER_GROW          (TB_SCHEDULER_IO_LTIMER_GROW >> 4)
+// the ready events maxn for each waiting
+#ifdef __tb_small__
+#   define TB_SCHEDULER_IO_EVENTS_MAXN      (64)
+#else
+#   define TB_SCHEDULER_IO_EVENTS_MAXN      (256)
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
@@ -52,22 +56,15 @@
 static tb_void_t tb_co_scheduler_io_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine, tb_cpointer_t priv)
 {
     // exists the timer task? remove it
-    tb_cpointer_t task = coroutine->rs.wait.task;
+    tb_timer_task_ref_t task = coroutine->rs.wait.task;
     if (task) 
     {
         // get io scheduler
         tb_co_scheduler_io_ref_t scheduler_io = tb_co_scheduler_io(scheduler);
         tb_assert(scheduler_io && scheduler_io->poller);
 
-        // is high-precision timer?
-        tb_size_t is_timer = (tb_size_t)(task) & 0x1;
-
-        // check
-        tb_assert((tb_size_t)task & (tb_size_t)~0x1);
-
         // remove the timer task
-        if (__tb_unlikely__(is_timer)) tb_timer_task_exit(scheduler_io->timer, (tb_timer_task_ref_t)((tb_size_t)task & (tb_size_t)~0x1));
-        else tb_ltimer_task_exit(scheduler_io->ltimer, (tb_ltimer_task_ref_t)task);
+        tb_timer_task_exit(scheduler_io->timer, task);
         coroutine->rs.wait.task = tb_null;
     }
 
@@ -93,11 +90,11 @@ static tb_void_t tb_co_scheduler_io_timeout(tb_bool_t killed, tb_cpointer_t priv
     // resume the coroutine 
     tb_co_scheduler_io_resume(scheduler, coroutine, tb_null);
 }
-static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+static tb_void_t tb_co_scheduler_io_events(tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
 {
     // check
     tb_coroutine_t* coroutine = (tb_coroutine_t*)priv;
-    tb_assert(coroutine && poller && sock);
+    tb_assert(coroutine && sock);
 
     // get scheduler
     tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_coroutine_scheduler(coroutine);
@@ -106,17 +103,25 @@ static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_socket_ref
     // trace
     tb_trace_d("coroutine(%p): socket: %p, events %lu", coroutine, sock, events);
 
+    /* only notify the waiting events
+     *
+     * the socket may be registered with all events for the edge trigger,
+     * and the other events will be ignored, because we always recv/send it first before waiting events,
+     * and the socket will be re-armed to report them again if the waiting events are changed.
+     */
+    tb_size_t events_wait = coroutine->rs.wait.events;
+    if (events & TB_POLLER_EVENT_EOF)
+    {
+        // cache this eof as next recv/send event
+        events |= events_wait;
+        coroutine->rs.wait.events_cache |= events_wait;
+    }
+    events &= events_wait | TB_POLLER_EVENT_ERROR;
+    tb_check_return(events);
+
     // waiting now?
     if (coroutine->rs.wait.waiting)
     {
-        // eof for edge trigger?
-        if (events & TB_POLLER_EVENT_EOF)
-        {
-            // cache this eof as next recv/send event
-            events &= ~TB_POLLER_EVENT_EOF;
-            coroutine->rs.wait.events_cache |= coroutine->rs.wait.events;
-        }
-
         // resume the coroutine and pass the events to suspend()
         tb_co_scheduler_io_resume(scheduler, coroutine, (tb_cpointer_t)((events & TB_POLLER_EVENT_ERROR)? -1 : events));
     }
@@ -126,7 +131,7 @@ static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_socket_ref
 static tb_bool_t tb_co_scheduler_io_timer_spak(tb_co_scheduler_io_ref_t scheduler_io)
 {
     // check
-    tb_assert(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
+    tb_assert(scheduler_io && scheduler_io->timer);
 
     // spak ctime
     tb_cache_time_spak();
@@ -134,9 +139,6 @@ static tb_bool_t tb_co_scheduler_io_timer_spak(tb_co_scheduler_io_ref_t schedule
     // spak timer
     if (!tb_timer_spak(scheduler_io->timer)) return tb_false;
 
-    // spak ltimer
-    if (!tb_ltimer_spak(scheduler_io->ltimer)) return tb_false;
-
     // pk
     return tb_true;
 }
@@ -144,7 +146,7 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
 {
     // check
     tb_co_scheduler_io_ref_t scheduler_io = (tb_co_scheduler_io_ref_t)priv;
-    tb_assert_and_check_return(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
+    tb_assert_and_check_return(scheduler_io && scheduler_io->timer);
 
     // the scheduler
     tb_co_scheduler_t* scheduler = scheduler_io->scheduler;
@@ -155,8 +157,11 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
     tb_assert_and_check_return(poller);
 
     // loop
-    while (!scheduler->stopped)
+    while (!tb_atomic_get(&scheduler->stopped))
     {
+        // pull the pending tasks and the resumed coroutines from the other threads
+        tb_co_scheduler_pull(scheduler, scheduler->group && tb_co_scheduler_ready_count(scheduler) <= 1);
+
         // finish all other ready coroutines first
         while (tb_co_scheduler_yield(scheduler)) 
         {
@@ -165,19 +170,41 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
         }
 
         // no more suspended coroutines? loop end
-        tb_check_break(tb_co_scheduler_suspend_count(scheduler));
+        if (!scheduler->group) tb_check_break(tb_co_scheduler_suspend_count(scheduler));
+
+        // mark as idle, the other threads will spak the poller if there are new tasks or resumed coroutines
+        tb_atomic_set(&scheduler->idle, 1);
+
+        // pull them again to avoid losing the notification before waiting
+        if (tb_co_scheduler_pull(scheduler, scheduler->group != tb_null))
+        {
+            tb_atomic_set(&scheduler->idle, 0);
+            continue ;
+        }
+
+        // trim the dead coroutines and release their stack pages before waiting
+        tb_co_scheduler_trim(scheduler);
 
         // the delay
         tb_size_t delay = tb_timer_delay(scheduler_io->timer);
 
-        // the ldelay
-        tb_size_t ldelay = tb_ltimer_delay(scheduler_io->ltimer);
-
         // trace
-        tb_trace_d("loop: wait %lu ms, %lu pending coroutines ..", tb_min(delay, ldelay), tb_co_scheduler_suspend_count(scheduler));
+        tb_trace_d("loop: wait %lu ms, %lu pending coroutines ..", delay, tb_co_scheduler_suspend_count(scheduler));
 
         // no more ready coroutines? wait io events and timers
-        if (tb_poller_wait(poller, tb_co_scheduler_io_events, tb_min(delay, ldelay)) < 0) break;
+        tb_long_t events_count = tb_poller_wait_events(poller, scheduler_io->events, TB_SCHEDULER_IO_EVENTS_MAXN, delay);
+        tb_check_break(events_count >= 0);
+
+        // resume all waiting coroutines of the ready events
+        tb_long_t i = 0;
+        for (i = 0; i < events_count; i++)
+        {
+            tb_poller_event_t* event = &scheduler_io->events[i];
+            tb_co_scheduler_io_events(event->sock, event->events, event->priv);
+        }
+
+        // clear the idle state
+        tb_atomic_set(&scheduler->idle, 0);
 
         // trace
         tb_trace_d("loop: wait ok, left %lu pending coroutines ..", tb_co_scheduler_suspend_count(scheduler));
@@ -208,14 +235,14 @@ tb_co_scheduler_io_ref_t tb_co_scheduler_io_init(tb_co_scheduler_t* scheduler)
         scheduler_io->timer = tb_timer_init(TB_SCHEDULER_IO_TIMER_GROW, tb_true);
         tb_assert_and_check_break(scheduler_io->timer);
 
-        // init ltimer and using cache time
-        scheduler_io->ltimer = tb_ltimer_init(TB_SCHEDULER_IO_LTIMER_GROW, TB_LTIMER_TICK_S, tb_true);
-        tb_assert_and_check_break(scheduler_io->ltimer);
-
         // init poller
         scheduler_io->poller = tb_poller_init(tb_null);
         tb_assert_and_check_break(scheduler_io->poller);
 
+        // init the ready events list
+        scheduler_io->events = tb_nalloc_type(TB_SCHEDULER_IO_EVENTS_MAXN, tb_poller_event_t);
+        tb_assert_and_check_break(scheduler_io->events);
+
         // start the io loop coroutine
         if (!tb_co_scheduler_start(scheduler_io->scheduler, tb_co_scheduler_io_loop, scheduler_io, 0)) break;
 
@@ -248,9 +275,9 @@ tb_void_t tb_co_scheduler_io_exit(tb_co_scheduler_io_ref_t scheduler_io)
     if (scheduler_io->timer) tb_timer_exit(scheduler_io->timer);
     scheduler_io->timer = tb_null;
 
-    // exit ltimer
-    if (scheduler_io->ltimer) tb_ltimer_exit(scheduler_io->ltimer);
-    scheduler_io->ltimer = tb_null;
+    // exit the ready events list
+    if (scheduler_io->events) tb_free(scheduler_io->events);
+    scheduler_io->events = tb_null;
 
     // clear scheduler
     scheduler_io->scheduler = tb_null;
@@ -284,9 +311,6 @@ tb_void_t tb_co_scheduler_io_kill(tb_co_scheduler_io_ref_t scheduler_io)
     // kill timer
     if (scheduler_io->timer) tb_timer_kill(scheduler_io->timer);
 
-    // kill ltimer
-    if (scheduler_io->ltimer) tb_ltimer_kill(scheduler_io->ltimer);
-
     // kill poller
     if (scheduler_io->poller) tb_poller_kill(scheduler_io->poller);
 }
@@ -311,18 +335,8 @@ tb_pointer_t tb_co_scheduler_io_sleep(tb_co_scheduler_io_ref_t scheduler_io, tb_
     // infinity?
     if (interval > 0)
     {
-        // high-precision interval?
-        if (interval % 1000)
-        {
-            // post task to timer
-            tb_timer_task_post(scheduler_io->timer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
-        }
-        // low-precision interval?
-        else
-        {
-            // post task to ltimer (faster)
-            tb_ltimer_task_post(scheduler_io->ltimer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
-        }
+        // post task to timer
+        tb_timer_task_post(scheduler_io->timer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
     }
 
     // suspend it
@@ -344,9 +358,13 @@ tb_long_t tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_sock
     // trace
     tb_trace_d("coroutine(%p): wait events(%lu) with %ld ms for socket(%p) ..", coroutine, events, timeout, sock);
 
-    // enable edge-trigger mode if be supported
+    /* enable edge-trigger mode if be supported
+     *
+     * we register all events of the socket, so we need not modify the poller events when waiting the same events again.
+     */
+    tb_size_t events_poll = events;
     if (tb_poller_support(poller, TB_POLLER_EVENT_CLEAR))
-        events |= TB_POLLER_EVENT_CLEAR;
+        events_poll = TB_POLLER_EVENT_EALL | TB_POLLER_EVENT_CLEAR;
 
     // @note avoid to write rs.single_entry (channel/suspend) and erase rs.wait.{sock, events, events_cache}
     tb_assert_static(sizeof(tb_single_list_entry_t) <= tb_offsetof(tb_coroutine_rs_wait_t, sock));
@@ -374,8 +392,12 @@ tb_long_t tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_sock
             return events_cache & events;
         }
 
-        // modify socket from poller for waiting events if the waiting events has been changed 
-        if (events_prev != events && !tb_poller_modify(poller, sock, events, coroutine))
+        /* modify socket from poller for waiting events if the waiting events has been changed
+         *
+         * the ready events which were not waited have been ignored in edge-trigger mode,
+         * so we need re-arm it to report the current ready events again.
+         */
+        if (events_prev != events && !tb_poller_modify(poller, sock, events_poll, coroutine))
         {
             // trace
             tb_trace_e("failed to modify sock(%p) to poller on coroutine(%p)!", sock, coroutine);
@@ -397,7 +419,7 @@ tb_long_t tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_sock
         }
 
         // insert socket to poller for waiting events
-        if (!tb_poller_insert(poller, sock, events, coroutine))
+        if (!tb_poller_insert(poller, sock, events_poll, coroutine))
         {
             // trace
             tb_trace_e("failed to insert sock(%p) to poller on coroutine(%p)!", sock, coroutine);
@@ -408,34 +430,16 @@ tb_long_t tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_sock
     }
 
     // exists timeout?
-    tb_cpointer_t   task = tb_null;
-    tb_bool_t       is_ltimer = tb_false;
+    tb_timer_task_ref_t task = tb_null;
     if (timeout >= 0)
     {
-        // high-precision interval?
-        if (timeout % 1000)
-        {
-            // init task for timer
-            task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-        }
-        // low-precision interval?
-        else
-        {
-            // init task for ltimer (faster)
-            task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-
-            // mark as low-precision timer
-            is_ltimer = tb_true;
-        }
+        // init task for timer
+        task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
+        tb_assert_and_check_return_val(task, tb_false);
     }
 
-    // check
-    tb_assert(!((tb_size_t)(task) & 0x1));
-
     // save the timer task to coroutine
-    coroutine->rs.wait.task = (is_ltimer || !task)? task : (tb_cpointer_t)((tb_size_t)(task) | 0x1);
+    coroutine->rs.wait.task = task;
 
     // save the socket to coroutine for the timer function
     coroutine->rs.wait.sock = sock;
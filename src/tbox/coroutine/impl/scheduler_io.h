@@ -51,8 +51,8 @@ typedef struct __tb_co_scheduler_io_t
     // the timer
     tb_timer_ref_t      timer;
 
-    // the low-precision timer (faster)
-    tb_ltimer_ref_t     ltimer;
+    // the ready events list
+    tb_poller_event_t*  events;
 
 }tb_co_scheduler_io_t, *tb_co_scheduler_io_ref_t;
 
@@ -39,12 +39,8 @@ __tb_extern_c_enter__
 typedef struct __tb_lo_coroutine_rs_wait_t
 {
 #ifndef TB_CONFIG_MICRO_ENABLE
-    /* the timer task pointer for ltimer or timer
-     *
-     * for ltimer:  task
-     * for timer:   task & 0x1
-     */
-    tb_cpointer_t               task;
+    // the timer task
+    tb_timer_task_ref_t         task;
 #endif
 
     // the socket
@@ -127,6 +123,18 @@ tb_bool_t               tb_lo_coroutine_reinit(tb_lo_coroutine_t* coroutine, tb_
  */
 tb_void_t               tb_lo_coroutine_exit(tb_lo_coroutine_t* coroutine);
 
+/* move the pass block to the given scheduler
+ *
+ * the pass block allocated from the pools of the current scheduler will be moved to the heap
+ * if it will be started on the other scheduler, because the pools are not thread-safe.
+ *
+ * @param scheduler     the scheduler of the started coroutine
+ * @param priv          the pass block from tb_lo_coroutine_pass()
+ *
+ * @return              the moved pass block
+ */
+tb_pointer_t            tb_lo_coroutine_pass_move(tb_lo_scheduler_ref_t scheduler, tb_pointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
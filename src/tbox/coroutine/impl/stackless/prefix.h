@@ -27,6 +27,7 @@
 #include "../prefix.h"
 #include "../../stackless/coroutine.h"
 #include "../../../container/container.h"
+#include "../../../memory/fixed_pool.h"
 
 
 #endif
@@ -42,6 +42,12 @@
 // get the io scheduler
 #define tb_lo_scheduler_io(scheduler)                  ((scheduler)->scheduler_io)
 
+// the pass blocks pool count, the block sizes: 32, 64, 128, 256
+#define TB_LO_SCHEDULER_PASS_POOL_MAXN                 (4)
+
+// the minimum block size of the pass blocks pool
+#define TB_LO_SCHEDULER_PASS_BLOCK_MINN                (32)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -54,6 +60,9 @@ __tb_extern_c_enter__
 // the io scheduler type
 struct __tb_lo_scheduler_io_t;
 
+// the scheduler group type for the sharded mode
+struct __tb_lo_scheduler_group_t;
+
 /// the stackless coroutine scheduler type
 typedef struct __tb_lo_scheduler_t
 {
@@ -80,8 +89,38 @@ typedef struct __tb_lo_scheduler_t
     // the suspend coroutines
     tb_list_entry_head_t            coroutines_suspend;
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // the coroutine frames pool
+    tb_fixed_pool_ref_t             pool;
+
+    // the pass blocks pools, only be used in the thread of this scheduler
+    tb_fixed_pool_ref_t             pass_pools[TB_LO_SCHEDULER_PASS_POOL_MAXN];
+
+    // the scheduler group for the sharded mode, be null for the single-threaded mode
+    struct __tb_lo_scheduler_group_t* group;
+#endif
+
 }tb_lo_scheduler_t;
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+// the scheduler group type for the sharded mode
+typedef struct __tb_lo_scheduler_group_t
+{
+    // the shard schedulers, the first shard is the root scheduler
+    tb_lo_scheduler_t**             shards;
+
+    // the shard count
+    tb_size_t                       count;
+
+    // the shard threads
+    tb_thread_ref_t*                threads;
+
+    // the next shard index for starting coroutines from the outside of this group
+    tb_size_t                       next;
+
+}tb_lo_scheduler_group_t;
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -110,6 +149,19 @@ tb_void_t               tb_lo_scheduler_resume(tb_lo_scheduler_t* scheduler, tb_
  */
 tb_lo_scheduler_ref_t   tb_lo_scheduler_self_(tb_noarg_t);
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+/* select the shard scheduler for starting coroutine (sharded mode)
+ *
+ * the current shard will be selected if we are running in this scheduler group,
+ * otherwise the next shard will be selected in turn for the root scheduler.
+ *
+ * @param scheduler     the shard scheduler of the scheduler group
+ *
+ * @return              the shard scheduler
+ */
+tb_lo_scheduler_t*      tb_lo_scheduler_shard(tb_lo_scheduler_t* scheduler);
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
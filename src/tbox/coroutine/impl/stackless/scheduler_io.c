@@ -37,21 +37,33 @@
  * macros
  */
 
-// the ltimer grow
+// the timer grow
 #ifdef __tb_small__
-#   define TB_SCHEDULER_IO_LTIMER_GROW      (64)
+#   define TB_SCHEDULER_IO_TIMER_GROW       (64)
 #else
-#   define TB_SCHEDULER_IO_LTIMER_GROW      (4096)
+#   define TB_SCHEDULER_IO_TIMER_GROW       (4096)
 #endif
 
-// the timer grow
-#define TB_SCHEDULER_IO_TIMER_GROW          (TB_SCHEDULER_IO_LTIMER_GROW >> 4)
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
 static tb_void_t tb_lo_scheduler_io_resume(tb_lo_scheduler_t* scheduler, tb_lo_coroutine_t* coroutine, tb_size_t events)
 {
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // exists the timer task? remove it
+    tb_timer_task_ref_t task = coroutine->rs.wait.task;
+    if (task)
+    {
+        // get io scheduler
+        tb_lo_scheduler_io_ref_t scheduler_io = tb_lo_scheduler_io(scheduler);
+        tb_assert(scheduler_io && scheduler_io->timer);
+
+        // remove the timer task
+        tb_timer_task_exit(scheduler_io->timer, task);
+        coroutine->rs.wait.task = tb_null;
+    }
+#endif
+
     // clear waiting state
     coroutine->rs.wait.waiting = 0;
 
@@ -113,7 +125,7 @@ static tb_void_t tb_lo_scheduler_io_events(tb_poller_ref_t poller, tb_socket_ref
 static tb_bool_t tb_lo_scheduler_io_timer_spak(tb_lo_scheduler_io_ref_t scheduler_io)
 {
     // check
-    tb_assert(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
+    tb_assert(scheduler_io && scheduler_io->timer);
 
     // spak ctime
     tb_cache_time_spak();
@@ -121,25 +133,16 @@ static tb_bool_t tb_lo_scheduler_io_timer_spak(tb_lo_scheduler_io_ref_t schedule
     // spak timer
     if (!tb_timer_spak(scheduler_io->timer)) return tb_false;
 
-    // spak ltimer
-    if (!tb_ltimer_spak(scheduler_io->ltimer)) return tb_false;
-
     // pk
     return tb_true;
 }
 static tb_long_t tb_lo_scheduler_io_timer_delay(tb_lo_scheduler_io_ref_t scheduler_io)
 {
     // check
-    tb_assert(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
-
-    // the delay
-    tb_size_t delay = tb_timer_delay(scheduler_io->timer);
-
-    // the ldelay
-    tb_size_t ldelay = tb_ltimer_delay(scheduler_io->ltimer);
+    tb_assert(scheduler_io && scheduler_io->timer);
 
     // return the timer delay
-    return tb_min(delay, ldelay);
+    return tb_timer_delay(scheduler_io->timer);
 }
 #else
 static __tb_inline__ tb_long_t tb_lo_scheduler_io_timer_delay(tb_lo_scheduler_io_ref_t scheduler_io)
@@ -217,14 +220,13 @@ tb_lo_scheduler_io_ref_t tb_lo_scheduler_io_init(tb_lo_scheduler_t* scheduler)
         // init timer and using cache time
         scheduler_io->timer = tb_timer_init(TB_SCHEDULER_IO_TIMER_GROW, tb_true);
         tb_assert_and_check_break(scheduler_io->timer);
-
-        // init ltimer and using cache time
-        scheduler_io->ltimer = tb_ltimer_init(TB_SCHEDULER_IO_LTIMER_GROW, TB_LTIMER_TICK_S, tb_true);
-        tb_assert_and_check_break(scheduler_io->ltimer);
 #endif
 
-        // start the io loop coroutine
-        if (!tb_lo_coroutine_start((tb_lo_scheduler_ref_t)scheduler, tb_lo_scheduler_io_loop, scheduler_io, tb_null)) break;
+        /* start the io loop coroutine on this scheduler directly
+         *
+         * @note we cannot use tb_lo_coroutine_start, it will start it on the other shard if this scheduler is the root of a group
+         */
+        if (!tb_lo_scheduler_start(scheduler, tb_lo_scheduler_io_loop, scheduler_io, tb_null)) break;
 
         // ok
         ok = tb_true;
@@ -255,10 +257,6 @@ tb_void_t tb_lo_scheduler_io_exit(tb_lo_scheduler_io_ref_t scheduler_io)
     // exit timer
     if (scheduler_io->timer) tb_timer_exit(scheduler_io->timer);
     scheduler_io->timer = tb_null;
-
-    // exit ltimer
-    if (scheduler_io->ltimer) tb_ltimer_exit(scheduler_io->ltimer);
-    scheduler_io->ltimer = tb_null;
 #endif
 
     // clear scheduler
@@ -293,9 +291,6 @@ tb_void_t tb_lo_scheduler_io_kill(tb_lo_scheduler_io_ref_t scheduler_io)
 #ifndef TB_CONFIG_MICRO_ENABLE
     // kill timer
     if (scheduler_io->timer) tb_timer_kill(scheduler_io->timer);
-
-    // kill ltimer
-    if (scheduler_io->ltimer) tb_ltimer_kill(scheduler_io->ltimer);
 #endif
 
     // kill poller
@@ -314,21 +309,14 @@ tb_void_t tb_lo_scheduler_io_sleep(tb_lo_scheduler_io_ref_t scheduler_io, tb_lon
     // trace
     tb_trace_d("coroutine(%p): sleep %ld ms ..", coroutine, interval);
 
+    // clear waiting task first
+    coroutine->rs.wait.task = tb_null;
+
     // infinity?
     if (interval > 0)
     {
-        // high-precision interval?
-        if (interval % 1000)
-        {
-            // post task to timer
-            tb_timer_task_post(scheduler_io->timer, interval, tb_false, tb_lo_scheduler_io_timeout, coroutine);
-        }
-        // low-precision interval?
-        else
-        {
-            // post task to ltimer (faster)
-            tb_ltimer_task_post(scheduler_io->ltimer, interval, tb_false, tb_lo_scheduler_io_timeout, coroutine);
-        }
+        // post task to timer
+        tb_timer_task_post(scheduler_io->timer, interval, tb_false, tb_lo_scheduler_io_timeout, coroutine);
     }
 #else
     // not impl
@@ -417,34 +405,16 @@ tb_bool_t tb_lo_scheduler_io_wait(tb_lo_scheduler_io_ref_t scheduler_io, tb_sock
 
 #ifndef TB_CONFIG_MICRO_ENABLE
     // exists timeout?
-    tb_cpointer_t   task = tb_null;
-    tb_bool_t       is_ltimer = tb_false;
+    tb_timer_task_ref_t task = tb_null;
     if (timeout >= 0)
     {
-        // high-precision interval?
-        if (timeout % 1000)
-        {
-            // init task for timer
-            task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_lo_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-        }
-        // low-precision interval?
-        else
-        {
-            // init task for ltimer (faster)
-            task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_lo_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-
-            // mark as low-precision timer
-            is_ltimer = tb_true;
-        }
+        // init task for timer
+        task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_lo_scheduler_io_timeout, coroutine);
+        tb_assert_and_check_return_val(task, tb_false);
     }
 
-    // check
-    tb_assert(!((tb_size_t)(task) & 0x1));
-
     // save the timer task to coroutine
-    coroutine->rs.wait.task = (is_ltimer || !task)? task : (tb_cpointer_t)((tb_size_t)(task) | 0x1);
+    coroutine->rs.wait.task = task;
 #endif
 
     // save the socket to coroutine for the timer function
@@ -0,0 +1,562 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        mpmc_channel.c
+ * @ingroup     coroutine
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "mpmc_channel"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "mpmc_channel.h"
+#include "coroutine.h"
+#include "scheduler.h"
+#include "impl/impl.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the channel cell type
+ *
+ * seq == pos:              this cell is free for the producer of this position
+ * seq == pos + 1:          this cell is ready for the consumer of this position
+ * seq == pos + maxn:       this cell is free for the producer of the next round
+ */
+typedef struct __tb_co_mpmc_channel_cell_t
+{
+    // the sequence
+    tb_atomic_t                         seq;
+
+    // the data
+    tb_cpointer_t                       data;
+
+}tb_co_mpmc_channel_cell_t;
+
+// the channel waiter type, it is placed on the stack of the waiting coroutine or thread
+typedef struct __tb_co_mpmc_channel_waiter_t
+{
+    // the list entry
+    tb_list_entry_t                     entry;
+
+    // the next notified waiter
+    struct __tb_co_mpmc_channel_waiter_t* next;
+
+    // the waiting coroutine
+    tb_coroutine_ref_t                  coroutine;
+
+    // the semaphore of the waiting thread if it is not a coroutine
+    tb_semaphore_ref_t                  semaphore;
+
+    // has been notified? it is protected by the channel lock
+    tb_bool_t                           notified;
+
+}tb_co_mpmc_channel_waiter_t;
+
+// the multi-producer/multi-consumer channel type
+typedef struct __tb_co_mpmc_channel_t
+{
+    // the enqueue position
+    tb_atomic_t                         tail;
+
+    // keep the enqueue and dequeue positions in the different cache lines
+    tb_byte_t                           pad0[TB_L1_CACHE_BYTES];
+
+    // the dequeue position
+    tb_atomic_t                         head;
+
+    // keep the dequeue position and the waiting counts in the different cache lines
+    tb_byte_t                           pad1[TB_L1_CACHE_BYTES];
+
+    // the waiting send count, we need not enter lock to notify them if no waiters
+    tb_atomic_t                         waiting_send_count;
+
+    // the waiting recv count
+    tb_atomic_t                         waiting_recv_count;
+
+    // the cells
+    tb_co_mpmc_channel_cell_t*          cells;
+
+    // the cells mask
+    tb_size_t                           mask;
+
+    // the free function
+    tb_co_channel_free_func_t           free;
+
+    // the user private data
+    tb_cpointer_t                       priv;
+
+    // the lock of the waiting lists
+    tb_spinlock_t                       lock;
+
+    // the waiting send coroutines and threads
+    tb_list_entry_head_t                waiting_send;
+
+    // the waiting recv coroutines and threads
+    tb_list_entry_head_t                waiting_recv;
+
+}tb_co_mpmc_channel_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t tb_co_mpmc_channel_push(tb_co_mpmc_channel_t* channel, tb_cpointer_t const* list, tb_size_t size)
+{
+    // check
+    tb_assert(channel && channel->cells && list && size);
+
+    // claim the continuous free cells from the enqueue position
+    tb_size_t                   mask = channel->mask;
+    tb_co_mpmc_channel_cell_t*  cells = channel->cells;
+    tb_size_t                   pos = (tb_size_t)tb_atomic_get(&channel->tail);
+    tb_size_t                   count = 0;
+    while (1)
+    {
+        // get the free cells count
+        tb_long_t diff = 0;
+        for (count = 0; count < size; count++)
+        {
+            diff = (tb_long_t)((tb_size_t)tb_atomic_get(&cells[(pos + count) & mask].seq) - (pos + count));
+            tb_check_break(!diff);
+        }
+
+        // full?
+        if (!count && diff < 0) return 0;
+
+        // claim them
+        if (count)
+        {
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&channel->tail, (tb_long_t)pos, (tb_long_t)(pos + count));
+            tb_check_break(prev != pos);
+            pos = prev;
+        }
+        // the other producers have claimed this position? reload it
+        else pos = (tb_size_t)tb_atomic_get(&channel->tail);
+    }
+
+    // put data and publish them
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        tb_co_mpmc_channel_cell_t* cell = &cells[(pos + i) & mask];
+        cell->data = list[i];
+        tb_atomic_fetch_and_pset(&cell->seq, (tb_long_t)(pos + i), (tb_long_t)(pos + i + 1));
+    }
+
+    // trace
+    tb_trace_d("push: %lu at %lu", count, pos);
+
+    // ok
+    return count;
+}
+static tb_size_t tb_co_mpmc_channel_pop(tb_co_mpmc_channel_t* channel, tb_pointer_t* list, tb_size_t maxn)
+{
+    // check
+    tb_assert(channel && channel->cells && list && maxn);
+
+    // claim the continuous ready cells from the dequeue position
+    tb_size_t                   mask = channel->mask;
+    tb_co_mpmc_channel_cell_t*  cells = channel->cells;
+    tb_size_t                   pos = (tb_size_t)tb_atomic_get(&channel->head);
+    tb_size_t                   count = 0;
+    while (1)
+    {
+        // get the ready cells count
+        tb_long_t diff = 0;
+        for (count = 0; count < maxn; count++)
+        {
+            diff = (tb_long_t)((tb_size_t)tb_atomic_get(&cells[(pos + count) & mask].seq) - (pos + count + 1));
+            tb_check_break(!diff);
+        }
+
+        // empty?
+        if (!count && diff < 0) return 0;
+
+        // claim them
+        if (count)
+        {
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&channel->head, (tb_long_t)pos, (tb_long_t)(pos + count));
+            tb_check_break(prev != pos);
+            pos = prev;
+        }
+        // the other consumers have claimed this position? reload it
+        else pos = (tb_size_t)tb_atomic_get(&channel->head);
+    }
+
+    // get data and free them for the next round
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        tb_co_mpmc_channel_cell_t* cell = &cells[(pos + i) & mask];
+        list[i] = (tb_pointer_t)cell->data;
+        tb_atomic_fetch_and_pset(&cell->seq, (tb_long_t)(pos + i + 1), (tb_long_t)(pos + i + mask + 1));
+    }
+
+    // trace
+    tb_trace_d("pop: %lu at %lu", count, pos);
+
+    // ok
+    return count;
+}
+static tb_void_t tb_co_mpmc_channel_notify(tb_co_mpmc_channel_t* channel, tb_list_entry_head_ref_t waiting, tb_atomic_t* waiting_count, tb_size_t count)
+{
+    // check
+    tb_assert(channel && waiting && waiting_count && count);
+
+    /* no waiters? return it directly
+     *
+     * @note the data have been published by the full barrier of pset(),
+     * and the waiters will check the ring again after increasing the waiting count.
+     */
+    tb_check_return(tb_atomic_get(waiting_count));
+
+    // get the waiters
+    tb_co_mpmc_channel_waiter_t* notified = tb_null;
+    tb_co_mpmc_channel_waiter_t* last = tb_null;
+    tb_spinlock_enter(&channel->lock);
+    while (count-- && tb_list_entry_size(waiting))
+    {
+        // remove the first waiter
+        tb_list_entry_ref_t entry = tb_list_entry_head(waiting);
+        tb_list_entry_remove_head(waiting);
+        tb_atomic_fetch_and_dec(waiting_count);
+
+        // mark it as notified
+        tb_co_mpmc_channel_waiter_t* waiter = (tb_co_mpmc_channel_waiter_t*)tb_list_entry(waiting, entry);
+        waiter->notified = tb_true;
+        waiter->next = tb_null;
+
+        // append it to the notified waiters
+        if (last) last->next = waiter;
+        else notified = waiter;
+        last = waiter;
+    }
+    tb_spinlock_leave(&channel->lock);
+
+    // wake up them outside the lock
+    while (notified)
+    {
+        // get the next waiter first, the waiter will be released after waking up it
+        tb_co_mpmc_channel_waiter_t* waiter = notified;
+        notified = waiter->next;
+
+        // resume the waiting coroutine, it will be resumed by the poller of its owner scheduler if it's on the other thread
+        if (waiter->coroutine) tb_coroutine_resume(waiter->coroutine, tb_null);
+        // post the semaphore of the waiting thread
+        else tb_semaphore_post(waiter->semaphore, 1);
+    }
+}
+static tb_bool_t tb_co_mpmc_channel_wait_enter(tb_co_mpmc_channel_t* channel, tb_co_mpmc_channel_waiter_t* waiter, tb_list_entry_head_ref_t waiting, tb_atomic_t* waiting_count)
+{
+    // check
+    tb_assert(channel && waiter && waiting && waiting_count);
+
+    // init waiter
+    tb_memset(waiter, 0, sizeof(tb_co_mpmc_channel_waiter_t));
+    waiter->coroutine = tb_coroutine_self();
+    if (waiter->coroutine)
+    {
+        // ensure the io loop has been started, the other threads will wake up it by spaking the poller
+        if (!tb_co_scheduler_io_need(tb_null)) return tb_false;
+    }
+    else
+    {
+        // init semaphore for the plain thread
+        waiter->semaphore = tb_semaphore_init(0);
+        tb_assert_and_check_return_val(waiter->semaphore, tb_false);
+    }
+
+    // append it to the waiters
+    tb_spinlock_enter(&channel->lock);
+    tb_list_entry_insert_tail(waiting, &waiter->entry);
+    tb_atomic_fetch_and_inc(waiting_count);
+    tb_spinlock_leave(&channel->lock);
+    return tb_true;
+}
+static tb_void_t tb_co_mpmc_channel_wait_done(tb_co_mpmc_channel_waiter_t* waiter)
+{
+    // check
+    tb_assert(waiter);
+
+    // wait it
+    if (waiter->coroutine) tb_coroutine_suspend(tb_null);
+    else tb_semaphore_wait(waiter->semaphore, -1);
+}
+static tb_void_t tb_co_mpmc_channel_wait_leave(tb_co_mpmc_channel_t* channel, tb_co_mpmc_channel_waiter_t* waiter, tb_list_entry_head_ref_t waiting, tb_atomic_t* waiting_count, tb_bool_t cancel)
+{
+    // check
+    tb_assert(channel && waiter && waiting && waiting_count);
+
+    // cancel it if we need not wait it now
+    if (cancel)
+    {
+        // remove it from the waiters if it has not been notified
+        tb_bool_t notified = tb_false;
+        tb_spinlock_enter(&channel->lock);
+        notified = waiter->notified;
+        if (!notified)
+        {
+            tb_list_entry_remove(waiting, &waiter->entry);
+            tb_atomic_fetch_and_dec(waiting_count);
+        }
+        tb_spinlock_leave(&channel->lock);
+
+        /* it has been notified? we need wait it to absorb this notification,
+         * and pass it on to the next waiter, otherwise this notification will be lost.
+         */
+        if (notified) 
+        {
+            tb_co_mpmc_channel_wait_done(waiter);
+            tb_co_mpmc_channel_notify(channel, waiting, waiting_count, 1);
+        }
+    }
+
+    // exit semaphore
+    if (waiter->semaphore) tb_semaphore_exit(waiter->semaphore);
+    waiter->semaphore = tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_co_mpmc_channel_ref_t tb_co_mpmc_channel_init(tb_size_t size, tb_co_channel_free_func_t free, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(size, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_co_mpmc_channel_t*   channel = tb_null;
+    do
+    {
+        // make channel
+        channel = tb_malloc0_type(tb_co_mpmc_channel_t);
+        tb_assert_and_check_break(channel);
+
+        // init waiting send coroutines and threads
+        tb_list_entry_init(&channel->waiting_send, tb_co_mpmc_channel_waiter_t, entry, tb_null);
+
+        // init waiting recv coroutines and threads
+        tb_list_entry_init(&channel->waiting_recv, tb_co_mpmc_channel_waiter_t, entry, tb_null);
+
+        // init lock
+        if (!tb_spinlock_init(&channel->lock)) break;
+
+        // init free function and data
+        channel->free = free;
+        channel->priv = priv;
+
+        // init cells
+        size = tb_align_pow2(size);
+        if (size < 2) size = 2;
+        channel->mask = size - 1;
+        channel->cells = tb_nalloc0_type(size, tb_co_mpmc_channel_cell_t);
+        tb_assert_and_check_break(channel->cells);
+
+        // init cells sequence
+        tb_size_t i = 0;
+        for (i = 0; i < size; i++) channel->cells[i].seq = (tb_long_t)i;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (channel) tb_co_mpmc_channel_exit((tb_co_mpmc_channel_ref_t)channel);
+        channel = tb_null;
+    }
+
+    // ok?
+    return (tb_co_mpmc_channel_ref_t)channel;
+}
+tb_void_t tb_co_mpmc_channel_exit(tb_co_mpmc_channel_ref_t self)
+{
+    // check
+    tb_co_mpmc_channel_t* channel = (tb_co_mpmc_channel_t*)self;
+    tb_assert_and_check_return(channel);
+
+    // exit cells
+    if (channel->cells)
+    {
+        // free the left data
+        tb_pointer_t data = tb_null;
+        while (tb_co_mpmc_channel_pop(channel, &data, 1))
+        {
+            if (channel->free) channel->free(data, channel->priv);
+        }
+
+        // free it
+        tb_free(channel->cells);
+        channel->cells = tb_null;
+    }
+
+    // check waiters
+    tb_assert(!tb_list_entry_size(&channel->waiting_send));
+    tb_assert(!tb_list_entry_size(&channel->waiting_recv));
+
+    // exit waiters
+    tb_list_entry_exit(&channel->waiting_send);
+    tb_list_entry_exit(&channel->waiting_recv);
+
+    // exit lock
+    tb_spinlock_exit(&channel->lock);
+
+    // exit the channel
+    tb_free(channel);
+}
+tb_void_t tb_co_mpmc_channel_send(tb_co_mpmc_channel_ref_t self, tb_cpointer_t data)
+{
+    tb_co_mpmc_channel_nsend(self, &data, 1);
+}
+tb_pointer_t tb_co_mpmc_channel_recv(tb_co_mpmc_channel_ref_t self)
+{
+    tb_pointer_t data = tb_null;
+    tb_co_mpmc_channel_nrecv(self, &data, 1);
+    return data;
+}
+tb_void_t tb_co_mpmc_channel_nsend(tb_co_mpmc_channel_ref_t self, tb_cpointer_t const* list, tb_size_t size)
+{
+    // check
+    tb_co_mpmc_channel_t* channel = (tb_co_mpmc_channel_t*)self;
+    tb_assert_and_check_return(channel && list);
+
+    // send them
+    while (size)
+    {
+        // put data into the ring if be not full
+        tb_size_t count = tb_co_mpmc_channel_push(channel, list, size);
+        if (count)
+        {
+            // notify the waiting receivers
+            tb_co_mpmc_channel_notify(channel, &channel->waiting_recv, &channel->waiting_recv_count, count);
+
+            // send the left data
+            list += count;
+            size -= count;
+            continue ;
+        }
+
+        // trace
+        tb_trace_d("send[%p]: wait ..", tb_coroutine_self());
+
+        // append it to the waiting senders
+        tb_co_mpmc_channel_waiter_t waiter;
+        if (!tb_co_mpmc_channel_wait_enter(channel, &waiter, &channel->waiting_send, &channel->waiting_send_count)) break;
+
+        // try putting data again to avoid losing the notification before waiting
+        count = tb_co_mpmc_channel_push(channel, list, size);
+        if (count)
+        {
+            // cancel waiting
+            tb_co_mpmc_channel_wait_leave(channel, &waiter, &channel->waiting_send, &channel->waiting_send_count, tb_true);
+
+            // notify the waiting receivers
+            tb_co_mpmc_channel_notify(channel, &channel->waiting_recv, &channel->waiting_recv_count, count);
+            list += count;
+            size -= count;
+            continue ;
+        }
+
+        // wait it
+        tb_co_mpmc_channel_wait_done(&waiter);
+        tb_co_mpmc_channel_wait_leave(channel, &waiter, &channel->waiting_send, &channel->waiting_send_count, tb_false);
+
+        // trace
+        tb_trace_d("send[%p]: wait ok", tb_coroutine_self());
+    }
+}
+tb_size_t tb_co_mpmc_channel_nrecv(tb_co_mpmc_channel_ref_t self, tb_pointer_t* list, tb_size_t maxn)
+{
+    // check
+    tb_co_mpmc_channel_t* channel = (tb_co_mpmc_channel_t*)self;
+    tb_assert_and_check_return_val(channel && list && maxn, 0);
+
+    // recv them
+    tb_size_t count = 0;
+    while (1)
+    {
+        // get data from the ring if be not null
+        count = tb_co_mpmc_channel_pop(channel, list, maxn);
+        tb_check_break(!count);
+
+        // trace
+        tb_trace_d("recv[%p]: wait ..", tb_coroutine_self());
+
+        // append it to the waiting receivers
+        tb_co_mpmc_channel_waiter_t waiter;
+        if (!tb_co_mpmc_channel_wait_enter(channel, &waiter, &channel->waiting_recv, &channel->waiting_recv_count)) break;
+
+        // try getting data again to avoid losing the notification before waiting
+        count = tb_co_mpmc_channel_pop(channel, list, maxn);
+        if (count)
+        {
+            // cancel waiting
+            tb_co_mpmc_channel_wait_leave(channel, &waiter, &channel->waiting_recv, &channel->waiting_recv_count, tb_true);
+            break;
+        }
+
+        // wait it
+        tb_co_mpmc_channel_wait_done(&waiter);
+        tb_co_mpmc_channel_wait_leave(channel, &waiter, &channel->waiting_recv, &channel->waiting_recv_count, tb_false);
+
+        // trace
+        tb_trace_d("recv[%p]: wait ok", tb_coroutine_self());
+    }
+
+    // notify the waiting senders
+    if (count) tb_co_mpmc_channel_notify(channel, &channel->waiting_send, &channel->waiting_send_count, count);
+
+    // ok?
+    return count;
+}
+tb_bool_t tb_co_mpmc_channel_send_try(tb_co_mpmc_channel_ref_t self, tb_cpointer_t data)
+{
+    // check
+    tb_co_mpmc_channel_t* channel = (tb_co_mpmc_channel_t*)self;
+    tb_assert_and_check_return_val(channel, tb_false);
+
+    // put data into the ring
+    tb_check_return_val(tb_co_mpmc_channel_push(channel, &data, 1), tb_false);
+
+    // notify the waiting receivers
+    tb_co_mpmc_channel_notify(channel, &channel->waiting_recv, &channel->waiting_recv_count, 1);
+    return tb_true;
+}
+tb_bool_t tb_co_mpmc_channel_recv_try(tb_co_mpmc_channel_ref_t self, tb_pointer_t* pdata)
+{
+    // check
+    tb_co_mpmc_channel_t* channel = (tb_co_mpmc_channel_t*)self;
+    tb_assert_and_check_return_val(channel && pdata, tb_false);
+
+    // get data from the ring
+    tb_check_return_val(tb_co_mpmc_channel_pop(channel, pdata, 1), tb_false);
+
+    // notify the waiting senders
+    tb_co_mpmc_channel_notify(channel, &channel->waiting_send, &channel->waiting_send_count, 1);
+    return tb_true;
+}
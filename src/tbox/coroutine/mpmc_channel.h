@@ -0,0 +1,136 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        mpmc_channel.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_MPMC_CHANNEL_H
+#define TB_COROUTINE_MPMC_CHANNEL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "channel.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the multi-producer/multi-consumer channel ref type
+ *
+ * it's a lock-free bounded ring, all interfaces can be called from the coroutines of any schedulers and the plain threads.
+ *
+ * - the blocking coroutine will be suspended, and it will be resumed by the poller of its owner scheduler
+ * - the blocking plain thread (e.g. the thread pool worker) will wait on a semaphore
+ *
+ * @note the stackless coroutines can only use the try interfaces
+ */
+typedef __tb_typeref__(co_mpmc_channel);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init channel
+ *
+ * @param size          the buffer size, will be aligned to the power of 2
+ * @param free          the free function for the left data when exiting channel
+ * @param priv          the user private data
+ *
+ * @return              the channel
+ */
+tb_co_mpmc_channel_ref_t    tb_co_mpmc_channel_init(tb_size_t size, tb_co_channel_free_func_t free, tb_cpointer_t priv);
+
+/*! exit channel
+ *
+ * @param channel       the channel
+ */
+tb_void_t                   tb_co_mpmc_channel_exit(tb_co_mpmc_channel_ref_t channel);
+
+/*! send data into channel
+ *
+ * the current coroutine or thread will be blocked if this channel is full
+ *
+ * @param channel       the channel
+ * @param data          the channel data
+ */
+tb_void_t                   tb_co_mpmc_channel_send(tb_co_mpmc_channel_ref_t channel, tb_cpointer_t data);
+
+/*! recv data from channel
+ *
+ * the current coroutine or thread will be blocked if no data
+ *
+ * @param channel       the channel
+ *
+ * @return              the channel data
+ */
+tb_pointer_t                tb_co_mpmc_channel_recv(tb_co_mpmc_channel_ref_t channel);
+
+/*! send the data list into channel
+ *
+ * the current coroutine or thread will be blocked until all data have been sent
+ *
+ * @param channel       the channel
+ * @param list          the data list
+ * @param size          the data count
+ */
+tb_void_t                   tb_co_mpmc_channel_nsend(tb_co_mpmc_channel_ref_t channel, tb_cpointer_t const* list, tb_size_t size);
+
+/*! recv the data list from channel
+ *
+ * the current coroutine or thread will be blocked if no data,
+ * and it will return the all ready data (at most maxn) after waking up.
+ *
+ * @param channel       the channel
+ * @param list          the data list
+ * @param maxn          the data list maxn
+ *
+ * @return              the received data count, > 0
+ */
+tb_size_t                   tb_co_mpmc_channel_nrecv(tb_co_mpmc_channel_ref_t channel, tb_pointer_t* list, tb_size_t maxn);
+
+/*! try sending data into channel
+ *
+ * @param channel       the channel
+ * @param data          the channel data
+ *
+ * @return              tb_true or tb_false (full)
+ */
+tb_bool_t                   tb_co_mpmc_channel_send_try(tb_co_mpmc_channel_ref_t channel, tb_cpointer_t data);
+
+/*! try recving data from channel
+ *
+ * @param channel       the channel
+ * @param pdata         the channel data pointer
+ *
+ * @return              tb_true or tb_false (no data)
+ */
+tb_bool_t                   tb_co_mpmc_channel_recv_try(tb_co_mpmc_channel_ref_t channel, tb_pointer_t* pdata);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
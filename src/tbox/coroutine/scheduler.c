@@ -71,6 +71,98 @@ static tb_void_t tb_co_scheduler_free(tb_list_entry_head_ref_t coroutines)
         tb_coroutine_exit((tb_coroutine_t*)tb_list_entry0(entry));
     }
 }
+static tb_void_t tb_co_scheduler_free_tasks(tb_single_list_entry_head_ref_t tasks)
+{
+    // check
+    tb_assert(tasks);
+
+    // free all pending tasks
+    while (tb_single_list_entry_size(tasks))
+    {
+        // get the next entry from head
+        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(tasks);
+        tb_assert(entry);
+
+        // remove it from the pending tasks
+        tb_single_list_entry_remove_head(tasks);
+
+        // exit this task
+        tb_free(tb_single_list_entry(tasks, entry));
+    }
+}
+static tb_void_t tb_co_scheduler_kill_worker(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    // stop it
+    tb_atomic_set(&scheduler->stopped, 1);
+
+    // kill the io scheduler
+    if (scheduler->scheduler_io) tb_co_scheduler_io_kill(scheduler->scheduler_io);
+}
+static tb_void_t tb_co_scheduler_loop_worker(tb_co_scheduler_t* scheduler, tb_bool_t exclusive)
+{
+    // check
+    tb_assert(scheduler);
+
+#ifdef __tb_thread_local__
+    g_scheduler_self_ex = scheduler;
+#else
+    // is exclusive mode?
+    if (exclusive) g_scheduler_self_ex = scheduler;
+    else
+    {
+        // init self scheduler local
+        if (!tb_thread_local_init(&g_scheduler_self, tb_null)) return ;
+     
+        // update and overide the current scheduler
+        tb_thread_local_set(&g_scheduler_self, scheduler);
+    }
+#endif
+
+    // schedule all ready coroutines
+    while (tb_list_entry_size(&scheduler->coroutines_ready)) 
+    {
+        // check
+        tb_assert(tb_coroutine_is_original(scheduler->running));
+
+        // get the next entry from head
+        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_ready);
+        tb_assert(entry);
+
+        // switch to the next coroutine 
+        tb_co_scheduler_switch(scheduler, (tb_coroutine_t*)tb_list_entry0(entry));
+
+        // trace
+        tb_trace_d("[loop]: ready %lu", tb_list_entry_size(&scheduler->coroutines_ready));
+    }
+
+    // stop it
+    tb_atomic_set(&scheduler->stopped, 1);
+ 
+#ifdef __tb_thread_local__
+    g_scheduler_self_ex = tb_null;
+#else
+    // is exclusive mode?
+    if (exclusive) g_scheduler_self_ex = tb_null;
+    else
+    {
+        // clear the current scheduler
+        tb_thread_local_set(&g_scheduler_self, tb_null);
+    }
+#endif
+}
+static tb_int_t tb_co_scheduler_worker_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)priv;
+    tb_assert_and_check_return_val(scheduler, -1);
+
+    // run the worker loop, we cannot use the exclusive mode for the multiple worker threads
+    tb_co_scheduler_loop_worker(scheduler, tb_false);
+    return 0;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -95,6 +187,15 @@ tb_co_scheduler_ref_t tb_co_scheduler_init()
         // init suspend coroutines
         tb_list_entry_init(&scheduler->coroutines_suspend, tb_coroutine_t, entry, tb_null);
 
+        // init lock
+        if (!tb_spinlock_init(&scheduler->lock)) break;
+
+        // init pending tasks for the M:N mode
+        tb_single_list_entry_init(&scheduler->tasks, tb_co_scheduler_task_t, entry, tb_null);
+
+        // init the resumed coroutines from the other threads for the M:N mode
+        tb_single_list_entry_init(&scheduler->coroutines_remote, tb_coroutine_t, rs.single_entry, tb_null);
+
         // init original coroutine
         scheduler->original.scheduler = (tb_co_scheduler_ref_t)scheduler;
 
@@ -117,6 +218,74 @@ tb_co_scheduler_ref_t tb_co_scheduler_init()
     // ok?
     return (tb_co_scheduler_ref_t)scheduler;
 }
+tb_co_scheduler_ref_t tb_co_scheduler_init_workers(tb_size_t count)
+{
+    // uses the processor count if be zero
+    if (!count) count = tb_processor_count();
+    tb_assert_and_check_return_val(count, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_co_scheduler_group_t*    group = tb_null;
+    do
+    {
+        // make scheduler group
+        group = tb_malloc0_type(tb_co_scheduler_group_t);
+        tb_assert_and_check_break(group);
+
+        // make workers
+        group->workers = tb_nalloc0_type(count, tb_co_scheduler_t*);
+        tb_assert_and_check_break(group->workers);
+
+        // make worker threads
+        group->threads = tb_nalloc0_type(count, tb_thread_ref_t);
+        tb_assert_and_check_break(group->threads);
+
+        // init workers
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // init worker
+            tb_co_scheduler_t* worker = (tb_co_scheduler_t*)tb_co_scheduler_init();
+            tb_assert_and_check_break(worker);
+
+            // attach it to the scheduler group
+            worker->group = group;
+            group->workers[i] = worker;
+            group->count++;
+        }
+        tb_assert_and_check_break(group->count == count);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && group)
+    {
+        // exit workers
+        if (group->count) 
+        {
+            tb_co_scheduler_kill((tb_co_scheduler_ref_t)group->workers[0]);
+            tb_co_scheduler_exit((tb_co_scheduler_ref_t)group->workers[0]);
+        }
+        else
+        {
+            // exit workers and threads
+            if (group->workers) tb_free(group->workers);
+            if (group->threads) tb_free(group->threads);
+            tb_free(group);
+        }
+        group = tb_null;
+    }
+
+    // trace
+    tb_trace_d("init %lu workers %s", count, ok? "ok" : "no");
+
+    // the root scheduler is the first worker
+    return group? (tb_co_scheduler_ref_t)group->workers[0] : tb_null;
+}
 tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
 {
     // check
@@ -124,7 +293,39 @@ tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
     tb_assert_and_check_return(scheduler);
 
     // must be stopped
-    tb_assert(scheduler->stopped);
+    tb_assert(tb_atomic_get(&scheduler->stopped));
+
+    // exit the other workers and the scheduler group for the M:N mode
+    tb_co_scheduler_group_t* group = scheduler->group;
+    if (group)
+    {
+        // only exit it from the root scheduler
+        tb_assert_and_check_return(group->workers && group->workers[0] == scheduler);
+
+        // exit the other workers
+        tb_size_t i = 0;
+        for (i = 1; i < group->count; i++)
+        {
+            tb_co_scheduler_t* worker = group->workers[i];
+            if (worker)
+            {
+                worker->group = tb_null;
+                tb_co_scheduler_exit((tb_co_scheduler_ref_t)worker);
+            }
+        }
+
+        // exit the worker threads
+        if (group->threads) tb_free(group->threads);
+        group->threads = tb_null;
+
+        // exit workers
+        tb_free(group->workers);
+        group->workers = tb_null;
+
+        // exit the scheduler group
+        tb_free(group);
+        scheduler->group = tb_null;
+    }
 
     // exit io scheduler first
     if (scheduler->scheduler_io) tb_co_scheduler_io_exit(scheduler->scheduler_io);
@@ -155,6 +356,18 @@ tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
     // exit suspend coroutines
     tb_list_entry_exit(&scheduler->coroutines_suspend);
 
+    // free all pending tasks
+    tb_co_scheduler_free_tasks(&scheduler->tasks);
+
+    // exit pending tasks
+    tb_single_list_entry_exit(&scheduler->tasks);
+
+    // exit the resumed coroutines
+    tb_single_list_entry_exit(&scheduler->coroutines_remote);
+
+    // exit lock
+    tb_spinlock_exit(&scheduler->lock);
+
     // exit the scheduler
     tb_free(scheduler);
 }
@@ -164,11 +377,16 @@ tb_void_t tb_co_scheduler_kill(tb_co_scheduler_ref_t self)
     tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
     tb_assert_and_check_return(scheduler);
 
-    // stop it
-    scheduler->stopped = tb_true;
-
-    // kill the io scheduler
-    if (scheduler->scheduler_io) tb_co_scheduler_io_kill(scheduler->scheduler_io);
+    // kill all workers for the M:N mode
+    tb_co_scheduler_group_t* group = scheduler->group;
+    if (group)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+            tb_co_scheduler_kill_worker(group->workers[i]);
+    }
+    // kill this scheduler
+    else tb_co_scheduler_kill_worker(scheduler);
 }
 tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
 {
@@ -176,52 +394,63 @@ tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
     tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
     tb_assert_and_check_return(scheduler);
 
-#ifdef __tb_thread_local__
-    g_scheduler_self_ex = scheduler;
-#else
-    // is exclusive mode?
-    if (exclusive) g_scheduler_self_ex = scheduler;
-    else
-    {
-        // init self scheduler local
-        if (!tb_thread_local_init(&g_scheduler_self, tb_null)) return ;
-     
-        // update and overide the current scheduler
-        tb_thread_local_set(&g_scheduler_self, self);
-    }
-#endif
-
-    // schedule all ready coroutines
-    while (tb_list_entry_size(&scheduler->coroutines_ready)) 
-    {
-        // check
-        tb_assert(tb_coroutine_is_original(scheduler->running));
-
-        // get the next entry from head
-        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_ready);
-        tb_assert(entry);
-
-        // switch to the next coroutine 
-        tb_co_scheduler_switch(scheduler, (tb_coroutine_t*)tb_list_entry0(entry));
-
-        // trace
-        tb_trace_d("[loop]: ready %lu", tb_list_entry_size(&scheduler->coroutines_ready));
-    }
-
-    // stop it
-    scheduler->stopped = tb_true;
- 
-#ifdef __tb_thread_local__
-    g_scheduler_self_ex = tb_null;
-#else
-    // is exclusive mode?
-    if (exclusive) g_scheduler_self_ex = tb_null;
-    else
+    // run the scheduler group for the M:N mode
+    tb_co_scheduler_group_t* group = scheduler->group;
+    if (group)
     {
-        // clear the current scheduler
-        tb_thread_local_set(&g_scheduler_self, tb_null);
+        // only run it from the root scheduler
+        tb_assert_and_check_return(group->workers && group->workers[0] == scheduler);
+
+        // init the io schedulers of all workers first, the other threads will notify them via poller
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+        {
+            if (!tb_co_scheduler_io_need(group->workers[i])) 
+            {
+                // trace
+                tb_trace_e("failed to init io scheduler for worker(%lu)!", i);
+
+                // kill all workers
+                tb_co_scheduler_kill(self);
+                break;
+            }
+        }
+
+        // no coroutines? stop all workers directly
+        if (!tb_atomic_get(&group->coroutines)) tb_co_scheduler_kill(self);
+
+        // start the other worker threads
+        for (i = 1; i < group->count; i++)
+        {
+            group->threads[i] = tb_thread_init(__tb_lstring__("co_scheduler"), tb_co_scheduler_worker_loop, group->workers[i], 0);
+            if (!group->threads[i])
+            {
+                // trace
+                tb_trace_e("failed to start worker(%lu) thread!", i);
+
+                // kill all workers
+                tb_co_scheduler_kill(self);
+                break;
+            }
+        }
+
+        // run the root worker on the current thread
+        tb_co_scheduler_loop_worker(scheduler, tb_false);
+
+        // wait the other worker threads
+        for (i = 1; i < group->count; i++)
+        {
+            tb_thread_ref_t thread = group->threads[i];
+            if (thread)
+            {
+                tb_thread_wait(thread, -1, tb_null);
+                tb_thread_exit(thread);
+                group->threads[i] = tb_null;
+            }
+        }
     }
-#endif
+    // run this scheduler on the current thread
+    else tb_co_scheduler_loop_worker(scheduler, exclusive);
 }
 tb_co_scheduler_ref_t tb_co_scheduler_self()
 { 
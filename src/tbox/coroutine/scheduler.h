@@ -49,6 +49,33 @@ typedef __tb_typeref__(co_scheduler);
  */
 tb_co_scheduler_ref_t   tb_co_scheduler_init(tb_noarg_t);
 
+/*! init scheduler with the multiple worker threads (M:N mode)
+ *
+ * each worker thread owns a local ready queue and io poller, 
+ * the new coroutines will be started on the current worker or stolen by the other idle workers,
+ * and the coroutine will be always run on the same worker after starting it.
+ *
+ * @code
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init_workers(0);
+    if (scheduler)
+    {
+        // start coroutines
+        tb_coroutine_start(scheduler, func, priv, 0);
+
+        // run scheduler on the current thread and the other worker threads
+        tb_co_scheduler_loop(scheduler, tb_false);
+
+        // exit scheduler
+        tb_co_scheduler_exit(scheduler);
+    }
+ * @endcode
+ *
+ * @param count         the worker count, uses the processor count if be zero
+ *
+ * @return              the scheduler 
+ */
+tb_co_scheduler_ref_t   tb_co_scheduler_init_workers(tb_size_t count);
+
 /*! exit scheduler
  *
  * @param scheduler     the scheduler
@@ -65,7 +92,8 @@ tb_void_t               tb_co_scheduler_kill(tb_co_scheduler_ref_t scheduler);
  *
  * @param schedule      the scheduler
  * @param exclusive     enable exclusive mode, we need ensure only one loop() be called at the same time, 
- *                      but it will be faster using thr global scheduler instead of TLS storage
+ *                      but it will be faster using thr global scheduler instead of TLS storage,
+ *                      it will be ignored for the M:N mode
  */
 tb_void_t               tb_co_scheduler_loop(tb_co_scheduler_ref_t schedule, tb_bool_t exclusive);
 
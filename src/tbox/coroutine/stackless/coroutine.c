@@ -33,9 +33,49 @@
 #include "scheduler.h"
 #include "../impl/impl.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the pass blocks pool grow
+#ifdef __tb_small__
+#   define TB_LO_COROUTINE_PASS_POOL_GROW       (64)
+#else
+#   define TB_LO_COROUTINE_PASS_POOL_GROW       (256)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the pass block head type
+typedef struct __tb_lo_coroutine_pass_t
+{
+    // the owner scheduler, it is allocated from the heap if be null
+    tb_lo_scheduler_t*          scheduler;
+
+    // the data size
+    tb_size_t                   size;
+
+}tb_lo_coroutine_pass_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+#ifndef TB_CONFIG_MICRO_ENABLE
+static __tb_inline__ tb_size_t tb_lo_coroutine_pass_index(tb_size_t size)
+{
+    // get the pool index of the smallest block which can hold this size
+    tb_size_t index = 0;
+    tb_size_t block = TB_LO_SCHEDULER_PASS_BLOCK_MINN;
+    while (index < TB_LO_SCHEDULER_PASS_POOL_MAXN && block < size)
+    {
+        block <<= 1;
+        index++;
+    }
+    return index;
+}
+#endif
 tb_lo_coroutine_t* tb_lo_coroutine_init(tb_lo_scheduler_ref_t scheduler, tb_lo_coroutine_func_t func, tb_cpointer_t priv, tb_lo_coroutine_free_t free)
 {
     // check
@@ -46,8 +86,12 @@ tb_lo_coroutine_t* tb_lo_coroutine_init(tb_lo_scheduler_ref_t scheduler, tb_lo_c
     tb_lo_coroutine_t*  coroutine = tb_null;
     do
     {
-        // make coroutine
+        // make coroutine from the frames pool of the scheduler
+#ifndef TB_CONFIG_MICRO_ENABLE
+        coroutine = (tb_lo_coroutine_t*)tb_fixed_pool_malloc0(((tb_lo_scheduler_t*)scheduler)->pool);
+#else
         coroutine = tb_malloc0_type(tb_lo_coroutine_t);
+#endif
         tb_assert_and_check_break(coroutine);
 
         // init core
@@ -109,7 +153,41 @@ tb_void_t tb_lo_coroutine_exit(tb_lo_coroutine_t* coroutine)
     tb_trace_d("exit: %p", coroutine);
 
     // exit it
+#ifndef TB_CONFIG_MICRO_ENABLE
+    tb_lo_scheduler_t* scheduler = (tb_lo_scheduler_t*)coroutine->scheduler;
+    if (scheduler && scheduler->pool) tb_fixed_pool_free(scheduler->pool, coroutine);
+#else
     tb_free(coroutine);
+#endif
+}
+tb_pointer_t tb_lo_coroutine_pass_move(tb_lo_scheduler_ref_t scheduler, tb_pointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(scheduler && priv, tb_null);
+
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // this block is allocated from the heap or the pools of the given scheduler? 
+    tb_lo_coroutine_pass_t* pass = (tb_lo_coroutine_pass_t*)priv - 1;
+    tb_check_return_val(pass->scheduler && pass->scheduler != (tb_lo_scheduler_t*)scheduler, priv);
+
+    // it can only be moved in the thread of the owner scheduler
+    tb_assert_and_check_return_val(pass->scheduler == (tb_lo_scheduler_t*)tb_lo_scheduler_self_(), tb_null);
+
+    // copy it to the heap
+    tb_lo_coroutine_pass_t* pass_new = (tb_lo_coroutine_pass_t*)tb_malloc_bytes(sizeof(tb_lo_coroutine_pass_t) + pass->size);
+    tb_assert_and_check_return_val(pass_new, tb_null);
+    pass_new->scheduler = tb_null;
+    pass_new->size      = pass->size;
+    tb_memcpy(pass_new + 1, pass + 1, pass->size);
+
+    // free the old block to the pool
+    tb_lo_coroutine_pass_free_(priv);
+
+    // ok
+    return (tb_pointer_t)(pass_new + 1);
+#else
+    return priv;
+#endif
 }
 tb_lo_scheduler_ref_t tb_lo_coroutine_scheduler_(tb_lo_coroutine_ref_t self)
 {
@@ -129,6 +207,9 @@ tb_void_t tb_lo_coroutine_sleep_(tb_lo_coroutine_ref_t self, tb_long_t interval)
     // get scheduler
     tb_lo_scheduler_t* scheduler = (tb_lo_scheduler_t*)coroutine->scheduler;
     tb_assert(scheduler);
+
+    // have been stopped? the timer may be killed
+    tb_check_return(!scheduler->stopped);
     
     // init io scheduler first
     if (!tb_lo_scheduler_io_need(scheduler)) return ;
@@ -145,6 +226,13 @@ tb_bool_t tb_lo_coroutine_waitio_(tb_lo_coroutine_ref_t self, tb_socket_ref_t so
     // get scheduler
     tb_lo_scheduler_t* scheduler = (tb_lo_scheduler_t*)coroutine->scheduler;
     tb_assert(scheduler);
+
+    // have been stopped? the poller and timer may be killed
+    if (scheduler->stopped)
+    {
+        coroutine->rs.wait.events_result = -1;
+        return tb_false;
+    }
    
     // init io scheduler first
     if (!tb_lo_scheduler_io_need(scheduler)) return tb_false;
@@ -161,9 +249,69 @@ tb_long_t tb_lo_coroutine_events_(tb_lo_coroutine_ref_t self)
     // get events
     return coroutine->rs.wait.events_result;
 }
+tb_pointer_t tb_lo_coroutine_pass_make_(tb_size_t type_size)
+{
+    // check
+    tb_assert(type_size);
+
+    // done
+    tb_lo_coroutine_pass_t* pass = tb_null;
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // make it from the pools of the current scheduler if we are running in it
+    tb_lo_scheduler_t*  scheduler = (tb_lo_scheduler_t*)tb_lo_scheduler_self_();
+    tb_size_t           index = tb_lo_coroutine_pass_index(type_size);
+    if (scheduler && index < TB_LO_SCHEDULER_PASS_POOL_MAXN)
+    {
+        // init pool first
+        tb_fixed_pool_ref_t pool = scheduler->pass_pools[index];
+        if (!pool) 
+        {
+            tb_size_t item_size = sizeof(tb_lo_coroutine_pass_t) + (TB_LO_SCHEDULER_PASS_BLOCK_MINN << index);
+            pool = scheduler->pass_pools[index] = tb_fixed_pool_init(tb_null, TB_LO_COROUTINE_PASS_POOL_GROW, item_size, tb_null, tb_null, tb_null);
+        }
+
+        // make block
+        if (pool && (pass = (tb_lo_coroutine_pass_t*)tb_fixed_pool_malloc0(pool)))
+            pass->scheduler = scheduler;
+    }
+#endif
+
+    // make it from the heap
+    if (!pass) pass = (tb_lo_coroutine_pass_t*)tb_malloc0_bytes(sizeof(tb_lo_coroutine_pass_t) + type_size);
+    tb_assert_and_check_return_val(pass, tb_null);
+
+    // save size
+    pass->size = type_size;
+
+    // ok
+    return (tb_pointer_t)(pass + 1);
+}
 tb_void_t tb_lo_coroutine_pass_free_(tb_cpointer_t priv)
 {
-    if (priv) tb_free(priv);
+    // check
+    tb_check_return(priv);
+
+    // get the block head
+    tb_lo_coroutine_pass_t* pass = (tb_lo_coroutine_pass_t*)priv - 1;
+
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // free it to the pools of the owner scheduler
+    tb_lo_scheduler_t* scheduler = pass->scheduler;
+    if (scheduler)
+    {
+        // check
+        tb_assert(scheduler == (tb_lo_scheduler_t*)tb_lo_scheduler_self_());
+
+        // free it
+        tb_size_t index = tb_lo_coroutine_pass_index(pass->size);
+        tb_assert_and_check_return(index < TB_LO_SCHEDULER_PASS_POOL_MAXN && scheduler->pass_pools[index]);
+        tb_fixed_pool_free(scheduler->pass_pools[index], pass);
+        return ;
+    }
+#endif
+
+    // free it to the heap
+    tb_free(pass);
 }
 tb_pointer_t tb_lo_coroutine_pass1_make_(tb_size_t type_size, tb_cpointer_t value, tb_size_t offset, tb_size_t size)
 {
@@ -171,7 +319,7 @@ tb_pointer_t tb_lo_coroutine_pass1_make_(tb_size_t type_size, tb_cpointer_t valu
     tb_assert(type_size && value && offset + size <= type_size);
 
     // make data
-    tb_byte_t* data = tb_malloc0_bytes(type_size);
+    tb_byte_t* data = (tb_byte_t*)tb_lo_coroutine_pass_make_(type_size);
     if (data) tb_memcpy(data + offset, value, size);
 
     // ok?
@@ -183,7 +331,14 @@ tb_pointer_t tb_lo_coroutine_pass1_make_(tb_size_t type_size, tb_cpointer_t valu
  */
 tb_bool_t tb_lo_coroutine_start(tb_lo_scheduler_ref_t self, tb_lo_coroutine_func_t func, tb_cpointer_t priv, tb_lo_coroutine_free_t free)
 {
-    return tb_lo_scheduler_start((tb_lo_scheduler_t*)self, func, priv, free);
+    // select the shard for the sharded mode
+    tb_lo_scheduler_t* scheduler = (tb_lo_scheduler_t*)self;
+#ifndef TB_CONFIG_MICRO_ENABLE
+    if (scheduler && scheduler->group) scheduler = tb_lo_scheduler_shard(scheduler);
+#endif
+
+    // start it
+    return tb_lo_scheduler_start(scheduler, func, priv, free);
 }
 tb_void_t tb_lo_coroutine_resume(tb_lo_coroutine_ref_t self)
 {
@@ -215,11 +215,14 @@ do \
  * @code
  
     // start coroutine
-    tb_lo_coroutine_start(scheduler, coroutine_func, tb_malloc0_type(tb_xxxx_priv_t), tb_lo_coroutine_pass_free_);
+    tb_lo_coroutine_start(scheduler, coroutine_func, tb_lo_coroutine_pass_make_(sizeof(tb_xxxx_priv_t)), tb_lo_coroutine_pass_free_);
 
  * @endcode
+ *
+ * @note the private data will be allocated from the pools of the current scheduler if we are running in it,
+ * and it will be zeroed and freed automatically after the coroutine have been finished.
  */
-#define tb_lo_coroutine_pass(type)  tb_malloc0_type(type), tb_lo_coroutine_pass_free_
+#define tb_lo_coroutine_pass(type)  tb_lo_coroutine_pass_make_(sizeof(type)), tb_lo_coroutine_pass_free_
 
 /*! pass the user private data and init one member
  *
@@ -241,7 +244,7 @@ do \
  *
  * @code
  
-    tb_xxxx_priv_t* priv = tb_malloc0_type(tb_xxxx_priv_t);
+    tb_xxxx_priv_t* priv = (tb_xxxx_priv_t*)tb_lo_coroutine_pass_make_(sizeof(tb_xxxx_priv_t));
     if (priv)
     {
         priv->member = value;
@@ -297,9 +300,17 @@ tb_bool_t               tb_lo_coroutine_waitio_(tb_lo_coroutine_ref_t coroutine,
  */
 tb_long_t               tb_lo_coroutine_events_(tb_lo_coroutine_ref_t coroutine);
 
+/* make the user private data for pass()
+ *
+ * @param type_size     the data type size
+ *
+ * @return              the user private data
+ */
+tb_pointer_t            tb_lo_coroutine_pass_make_(tb_size_t type_size);
+
 /* free the user private data for pass()
  *
- * @note only be a wrapper of free() for tb_lo_coroutine_pass()
+ * @note only be used to free the user private data from tb_lo_coroutine_pass_make_()
  *
  * @param priv          the user private data
  */
@@ -45,6 +45,13 @@
 #   define TB_SCHEDULER_DEAD_CACHE_MAXN     (256)
 #endif
 
+// the coroutine frames pool grow
+#ifdef __tb_small__
+#   define TB_SCHEDULER_POOL_GROW           (64)
+#else
+#   define TB_SCHEDULER_POOL_GROW           (256)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
@@ -167,6 +174,103 @@ static tb_void_t tb_lo_scheduler_switch(tb_lo_scheduler_t* scheduler, tb_lo_coro
     // call the coroutine function
     coroutine->func((tb_lo_coroutine_ref_t)coroutine, coroutine->priv);
 }
+static tb_void_t tb_lo_scheduler_kill_shard(tb_lo_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    // stop it
+    scheduler->stopped = tb_true;
+
+    // kill the io scheduler
+    if (scheduler->scheduler_io) tb_lo_scheduler_io_kill(scheduler->scheduler_io);
+}
+static tb_void_t tb_lo_scheduler_loop_shard(tb_lo_scheduler_t* scheduler, tb_bool_t exclusive)
+{
+    // check
+    tb_assert(scheduler);
+
+#ifdef __tb_thread_local__
+    g_scheduler_self_ex = scheduler;
+#else
+    // is exclusive mode?
+    if (exclusive) g_scheduler_self_ex = scheduler;
+#   ifndef TB_CONFIG_MICRO_ENABLE
+    else
+    {
+        // init self scheduler local
+        if (!tb_thread_local_init(&g_scheduler_self, tb_null)) return ;
+     
+        // update and overide the current scheduler
+        tb_thread_local_set(&g_scheduler_self, scheduler);
+    }
+#   else
+    else
+    {
+        // trace
+        tb_trace_e("non-exclusive is not suspported in micro mode!");
+    }
+#   endif
+#endif
+
+    // schedule all ready coroutines
+    while (tb_list_entry_size(&scheduler->coroutines_ready) && !scheduler->stopped) 
+    {
+        // trace
+        tb_trace_d("[loop]: ready %lu", tb_list_entry_size(&scheduler->coroutines_ready));
+
+        // get the next ready coroutine
+        tb_lo_coroutine_t* coroutine_next = tb_lo_scheduler_next_ready(scheduler);
+        tb_assert(coroutine_next);
+
+        // process the running coroutine
+        if (scheduler->running)
+        {
+            // get the state of running coroutine
+            tb_size_t state = tb_lo_core_state(scheduler->running);
+
+            // mark this coroutine as dead if the running coroutine(root level) have been finished
+            if (state == TB_STATE_END)
+                tb_lo_scheduler_make_dead(scheduler, scheduler->running);
+            // suspend the running coroutine 
+            else if (state == TB_STATE_SUSPEND)
+                tb_lo_scheduler_make_suspend(scheduler, scheduler->running);
+        }
+            
+        // switch to it if the next coroutine (may be running coroutine) is ready
+        if (tb_lo_core_state(coroutine_next) == TB_STATE_READY)
+            tb_lo_scheduler_switch(scheduler, coroutine_next);
+    }
+
+    // stop it
+    scheduler->stopped = tb_true;
+ 
+#ifdef __tb_thread_local__
+    g_scheduler_self_ex = tb_null;
+#else
+    // is exclusive mode?
+    if (exclusive) g_scheduler_self_ex = tb_null;
+#   ifndef TB_CONFIG_MICRO_ENABLE
+    else
+    {
+        // clear the current scheduler
+        tb_thread_local_set(&g_scheduler_self, tb_null);
+    }
+#   endif
+#endif
+}
+#ifndef TB_CONFIG_MICRO_ENABLE
+static tb_int_t tb_lo_scheduler_shard_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_lo_scheduler_t* scheduler = (tb_lo_scheduler_t*)priv;
+    tb_assert_and_check_return_val(scheduler, -1);
+
+    // run the shard loop, we cannot use the exclusive mode for the multiple shard threads
+    tb_lo_scheduler_loop_shard(scheduler, tb_false);
+    return 0;
+}
+#endif
 tb_bool_t tb_lo_scheduler_start(tb_lo_scheduler_t* scheduler, tb_lo_coroutine_func_t func, tb_cpointer_t priv, tb_lo_coroutine_free_t free)
 {
     // check
@@ -184,6 +288,15 @@ tb_bool_t tb_lo_scheduler_start(tb_lo_scheduler_t* scheduler, tb_lo_coroutine_fu
         if (!scheduler) scheduler = (tb_lo_scheduler_t*)tb_lo_scheduler_self_();
         tb_assert_and_check_break(scheduler);
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+        // the pass block may be allocated from the pools of the other scheduler, move it first
+        if (free == tb_lo_coroutine_pass_free_ && priv)
+        {
+            priv = tb_lo_coroutine_pass_move((tb_lo_scheduler_ref_t)scheduler, (tb_pointer_t)priv);
+            tb_assert_and_check_break(priv);
+        }
+#endif
+
         // have been stopped? do not continue to start new coroutines
         tb_check_break(!scheduler->stopped);
 
@@ -257,6 +370,24 @@ tb_lo_scheduler_ref_t tb_lo_scheduler_self_()
     return (tb_lo_scheduler_ref_t)(g_scheduler_self_ex? g_scheduler_self_ex : tb_thread_local_get(&g_scheduler_self));
 #endif
 }
+#ifndef TB_CONFIG_MICRO_ENABLE
+tb_lo_scheduler_t* tb_lo_scheduler_shard(tb_lo_scheduler_t* scheduler)
+{
+    // check
+    tb_lo_scheduler_group_t* group = scheduler->group;
+    tb_assert(group && group->count);
+
+    // start it on the current shard if we are running in this scheduler group
+    tb_lo_scheduler_t* scheduler_self = (tb_lo_scheduler_t*)tb_lo_scheduler_self_();
+    if (scheduler_self && scheduler_self->group == group) return scheduler_self;
+
+    // start it on the given shard if it is not the root scheduler
+    if (group->shards[0] != scheduler) return scheduler;
+
+    // start it on the next shard in turn
+    return group->shards[group->next++ % group->count];
+}
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * public implementation
@@ -281,6 +412,12 @@ tb_lo_scheduler_ref_t tb_lo_scheduler_init()
         // init suspend coroutines
         tb_list_entry_init(&scheduler->coroutines_suspend, tb_lo_coroutine_t, entry, tb_null);
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+        // init the coroutine frames pool
+        scheduler->pool = tb_fixed_pool_init(tb_null, TB_SCHEDULER_POOL_GROW, sizeof(tb_lo_coroutine_t), tb_null, tb_null, tb_null);
+        tb_assert_and_check_break(scheduler->pool);
+#endif
+
         // ok
         ok = tb_true;
 
@@ -297,6 +434,88 @@ tb_lo_scheduler_ref_t tb_lo_scheduler_init()
     // ok?
     return (tb_lo_scheduler_ref_t)scheduler;
 }
+#ifndef TB_CONFIG_MICRO_ENABLE
+tb_lo_scheduler_ref_t tb_lo_scheduler_init_shards(tb_size_t count)
+{
+    // uses the processor count if be zero
+    if (!count) count = tb_processor_count();
+    tb_assert_and_check_return_val(count, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_lo_scheduler_group_t*    group = tb_null;
+    do
+    {
+        // make scheduler group
+        group = tb_malloc0_type(tb_lo_scheduler_group_t);
+        tb_assert_and_check_break(group);
+
+        // make shards
+        group->shards = tb_nalloc0_type(count, tb_lo_scheduler_t*);
+        tb_assert_and_check_break(group->shards);
+
+        // make shard threads
+        group->threads = tb_nalloc0_type(count, tb_thread_ref_t);
+        tb_assert_and_check_break(group->threads);
+
+        // init shards
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // init shard
+            tb_lo_scheduler_t* shard = (tb_lo_scheduler_t*)tb_lo_scheduler_init();
+            tb_assert_and_check_break(shard);
+
+            // attach it to the scheduler group
+            shard->group = group;
+            group->shards[i] = shard;
+            group->count++;
+        }
+        tb_assert_and_check_break(group->count == count);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && group)
+    {
+        // exit shards
+        if (group->count) 
+        {
+            tb_lo_scheduler_kill((tb_lo_scheduler_ref_t)group->shards[0]);
+            tb_lo_scheduler_exit((tb_lo_scheduler_ref_t)group->shards[0]);
+        }
+        else
+        {
+            // exit shards and threads
+            if (group->shards) tb_free(group->shards);
+            if (group->threads) tb_free(group->threads);
+            tb_free(group);
+        }
+        group = tb_null;
+    }
+
+    // trace
+    tb_trace_d("init %lu shards %s", count, ok? "ok" : "no");
+
+    // the root scheduler is the first shard
+    return group? (tb_lo_scheduler_ref_t)group->shards[0] : tb_null;
+}
+#endif
+tb_size_t tb_lo_scheduler_shards(tb_lo_scheduler_ref_t self)
+{
+    // check
+    tb_lo_scheduler_t* scheduler = (tb_lo_scheduler_t*)self;
+    tb_assert_and_check_return_val(scheduler, 0);
+
+#ifndef TB_CONFIG_MICRO_ENABLE
+    return scheduler->group? scheduler->group->count : 1;
+#else
+    return 1;
+#endif
+}
 tb_void_t tb_lo_scheduler_exit(tb_lo_scheduler_ref_t self)
 {
     // check
@@ -305,6 +524,40 @@ tb_void_t tb_lo_scheduler_exit(tb_lo_scheduler_ref_t self)
 
     // must be stopped
     tb_assert(scheduler->stopped);
+
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // exit the other shards and the scheduler group for the sharded mode
+    tb_lo_scheduler_group_t* group = scheduler->group;
+    if (group)
+    {
+        // only exit it from the root scheduler
+        tb_assert_and_check_return(group->shards && group->shards[0] == scheduler);
+
+        // exit the other shards
+        tb_size_t i = 0;
+        for (i = 1; i < group->count; i++)
+        {
+            tb_lo_scheduler_t* shard = group->shards[i];
+            if (shard)
+            {
+                shard->group = tb_null;
+                tb_lo_scheduler_exit((tb_lo_scheduler_ref_t)shard);
+            }
+        }
+
+        // exit the shard threads
+        if (group->threads) tb_free(group->threads);
+        group->threads = tb_null;
+
+        // exit shards
+        tb_free(group->shards);
+        group->shards = tb_null;
+
+        // exit the scheduler group
+        tb_free(group);
+        scheduler->group = tb_null;
+    }
+#endif
     
     // exit io scheduler first 
     if (scheduler->scheduler_io) tb_lo_scheduler_io_exit(scheduler->scheduler_io);
@@ -332,6 +585,20 @@ tb_void_t tb_lo_scheduler_exit(tb_lo_scheduler_ref_t self)
     // exit suspend coroutines
     tb_list_entry_exit(&scheduler->coroutines_suspend);
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // exit the pass blocks pools
+    tb_size_t i = 0;
+    for (i = 0; i < TB_LO_SCHEDULER_PASS_POOL_MAXN; i++)
+    {
+        if (scheduler->pass_pools[i]) tb_fixed_pool_exit(scheduler->pass_pools[i]);
+        scheduler->pass_pools[i] = tb_null;
+    }
+
+    // exit the coroutine frames pool
+    if (scheduler->pool) tb_fixed_pool_exit(scheduler->pool);
+    scheduler->pool = tb_null;
+#endif
+
     // exit the scheduler
     tb_free(scheduler);
 }
@@ -341,8 +608,19 @@ tb_void_t tb_lo_scheduler_kill(tb_lo_scheduler_ref_t self)
     tb_lo_scheduler_t* scheduler = (tb_lo_scheduler_t*)self;
     tb_assert_and_check_return(scheduler);
 
-    // stop it
-    scheduler->stopped = tb_true;
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // kill all shards for the sharded mode
+    tb_lo_scheduler_group_t* group = scheduler->group;
+    if (group)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+            tb_lo_scheduler_kill_shard(group->shards[i]);
+    }
+    // kill this scheduler
+    else 
+#endif
+    tb_lo_scheduler_kill_shard(scheduler);
 }
 tb_void_t tb_lo_scheduler_loop(tb_lo_scheduler_ref_t self, tb_bool_t exclusive)
 {
@@ -350,73 +628,65 @@ tb_void_t tb_lo_scheduler_loop(tb_lo_scheduler_ref_t self, tb_bool_t exclusive)
     tb_lo_scheduler_t* scheduler = (tb_lo_scheduler_t*)self;
     tb_assert_and_check_return(scheduler);
 
-#ifdef __tb_thread_local__
-    g_scheduler_self_ex = scheduler;
-#else
-    // is exclusive mode?
-    if (exclusive) g_scheduler_self_ex = scheduler;
-#   ifndef TB_CONFIG_MICRO_ENABLE
-    else
-    {
-        // init self scheduler local
-        if (!tb_thread_local_init(&g_scheduler_self, tb_null)) return ;
-     
-        // update and overide the current scheduler
-        tb_thread_local_set(&g_scheduler_self, self);
-    }
-#   else
-    else
-    {
-        // trace
-        tb_trace_e("non-exclusive is not suspported in micro mode!");
-    }
-#   endif
-#endif
-
-    // schedule all ready coroutines
-    while (tb_list_entry_size(&scheduler->coroutines_ready) && !scheduler->stopped) 
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // run the scheduler group for the sharded mode
+    tb_lo_scheduler_group_t* group = scheduler->group;
+    if (group)
     {
-        // trace
-        tb_trace_d("[loop]: ready %lu", tb_list_entry_size(&scheduler->coroutines_ready));
+        // only run it from the root scheduler
+        tb_assert_and_check_return(group->shards && group->shards[0] == scheduler);
 
-        // get the next ready coroutine
-        tb_lo_coroutine_t* coroutine_next = tb_lo_scheduler_next_ready(scheduler);
-        tb_assert(coroutine_next);
-
-        // process the running coroutine
-        if (scheduler->running)
+        // init the io schedulers of all shards first, so we can kill them from the other threads
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
         {
-            // get the state of running coroutine
-            tb_size_t state = tb_lo_core_state(scheduler->running);
+            if (!tb_lo_scheduler_io_need(group->shards[i])) 
+            {
+                // trace
+                tb_trace_e("failed to init io scheduler for shard(%lu)!", i);
+
+                // kill all shards
+                tb_lo_scheduler_kill(self);
+                break;
+            }
+        }
 
-            // mark this coroutine as dead if the running coroutine(root level) have been finished
-            if (state == TB_STATE_END)
-                tb_lo_scheduler_make_dead(scheduler, scheduler->running);
-            // suspend the running coroutine 
-            else if (state == TB_STATE_SUSPEND)
-                tb_lo_scheduler_make_suspend(scheduler, scheduler->running);
+        // start the other shard threads
+        for (i = 1; i < group->count; i++)
+        {
+            group->threads[i] = tb_thread_init(__tb_lstring__("lo_scheduler"), tb_lo_scheduler_shard_loop, group->shards[i], 0);
+            if (!group->threads[i])
+            {
+                // trace
+                tb_trace_e("failed to start shard(%lu) thread!", i);
+
+                // kill all shards
+                tb_lo_scheduler_kill(self);
+                break;
+            }
         }
-            
-        // switch to it if the next coroutine (may be running coroutine) is ready
-        if (tb_lo_core_state(coroutine_next) == TB_STATE_READY)
-            tb_lo_scheduler_switch(scheduler, coroutine_next);
-    }
 
-    // stop it
-    scheduler->stopped = tb_true;
- 
-#ifdef __tb_thread_local__
-    g_scheduler_self_ex = tb_null;
-#else
-    // is exclusive mode?
-    if (exclusive) g_scheduler_self_ex = tb_null;
-#   ifndef TB_CONFIG_MICRO_ENABLE
-    else
-    {
-        // clear the current scheduler
-        tb_thread_local_set(&g_scheduler_self, tb_null);
+        // run the root shard on the current thread
+        tb_lo_scheduler_loop_shard(scheduler, tb_false);
+
+        // wait the other shard threads
+        for (i = 1; i < group->count; i++)
+        {
+            tb_thread_ref_t thread = group->threads[i];
+            if (thread)
+            {
+                tb_thread_wait(thread, -1, tb_null);
+                tb_thread_exit(thread);
+                group->threads[i] = tb_null;
+            }
+
+            // stop the shard which has been not started
+            group->shards[i]->stopped = tb_true;
+        }
+        return ;
     }
-#   endif
 #endif
-}
 
+    // run this scheduler
+    tb_lo_scheduler_loop_shard(scheduler, exclusive);
+}
@@ -49,6 +49,52 @@ __tb_extern_c_enter__
  */
 tb_lo_scheduler_ref_t   tb_lo_scheduler_init(tb_noarg_t);
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+/*! init the sharded scheduler, one scheduler loop for each shard thread
+ *
+ * each shard owns the local ready queue, io poller and coroutine pools, the shards do not share anything.
+ *
+ * the coroutines started from the outside of this scheduler will be distributed to the shards in turn,
+ * and the coroutines started in the shard will be always run on the same shard.
+ *
+ * we can start one listening coroutine for each shard and bind the same port,
+ * the accepted connections will be distributed by kernel (SO_REUSEPORT).
+ *
+ * @code
+    tb_lo_scheduler_ref_t scheduler = tb_lo_scheduler_init_shards(0);
+    if (scheduler)
+    {
+        // start one listening coroutine for each shard
+        tb_size_t i = 0;
+        tb_size_t n = tb_lo_scheduler_shards(scheduler);
+        for (i = 0; i < n; i++)
+            tb_lo_coroutine_start(scheduler, listen_func, tb_lo_coroutine_pass(listen_t));
+
+        // run scheduler on the current thread and the other shard threads
+        tb_lo_scheduler_loop(scheduler, tb_false);
+
+        // exit scheduler
+        tb_lo_scheduler_exit(scheduler);
+    }
+ * @endcode
+ *
+ * @note we cannot start coroutines to the running shards from the other threads
+ *
+ * @param count         the shard count, uses the processor count if be zero
+ *
+ * @return              the root scheduler 
+ */
+tb_lo_scheduler_ref_t   tb_lo_scheduler_init_shards(tb_size_t count);
+#endif
+
+/*! get the shard count
+ *
+ * @param scheduler     the scheduler
+ *
+ * @return              the shard count, it will be one for the single-threaded scheduler
+ */
+tb_size_t               tb_lo_scheduler_shards(tb_lo_scheduler_ref_t scheduler);
+
 /*! exit scheduler
  *
  * @param scheduler     the scheduler
@@ -65,7 +111,8 @@ tb_void_t               tb_lo_scheduler_kill(tb_lo_scheduler_ref_t scheduler);
  *
  * @param scheduler     the scheduler
  * @param exclusive     enable exclusive mode, we need ensure only one loop() be called at the same time, 
- *                      but it will be faster using thr global scheduler instead of TLS storage
+ *                      but it will be faster using thr global scheduler instead of TLS storage,
+ *                      it will be ignored for the sharded mode
  */
 tb_void_t               tb_lo_scheduler_loop(tb_lo_scheduler_ref_t scheduler, tb_bool_t exclusive);
 
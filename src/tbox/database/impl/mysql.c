@@ -28,10 +28,29 @@
  * includes
  */
 #include "prefix.h"
+#include "../../platform/platform.h"
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+#   include "../../coroutine/coroutine.h"
+#   include "../../coroutine/impl/impl.h"
+#endif
 #include <mysql.h>
 #include <errmsg.h>
 #include <mysqld_error.h>
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* use the non-blocking api of the client library?
+ *
+ * it is provided by the mariadb client library, we wait the socket events by tb_socket_wait(),
+ * so only the current coroutine will be suspended instead of the whole scheduler thread if we are in coroutine.
+ */
+#if defined(MYSQL_WAIT_READ) && defined(MYSQL_WAIT_WRITE)
+#   define TB_DATABASE_MYSQL_NONBLOCK
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -201,6 +220,198 @@ static tb_size_t tb_database_mysql_state_from_errno(tb_size_t errno)
     return state;
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * call implementation
+ */
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+static tb_int_t tb_database_mysql_wait(MYSQL* database, tb_int_t status)
+{
+    // check
+    tb_assert_and_check_return_val(database, MYSQL_WAIT_TIMEOUT);
+
+    // the socket
+    tb_socket_ref_t sock = tb_fd2sock(mysql_get_socket(database));
+    tb_assert_and_check_return_val(sock, MYSQL_WAIT_TIMEOUT);
+
+    // the waited events
+    tb_size_t events = 0;
+    if (status & (MYSQL_WAIT_READ | MYSQL_WAIT_EXCEPT)) events |= TB_SOCKET_EVENT_RECV;
+    if (status & MYSQL_WAIT_WRITE) events |= TB_SOCKET_EVENT_SEND;
+    tb_check_return_val(events, MYSQL_WAIT_TIMEOUT);
+
+    // the timeout
+    tb_long_t timeout = (status & MYSQL_WAIT_TIMEOUT)? (tb_long_t)mysql_get_timeout_value_ms(database) : -1;
+
+    // wait it, it will only suspend the current coroutine if we are in coroutine
+    tb_long_t wait = tb_socket_wait(sock, events, timeout);
+
+    // timeout?
+    tb_check_return_val(wait, MYSQL_WAIT_TIMEOUT);
+
+    // failed? let the client library to do io and report the error
+    tb_check_return_val(wait > 0, status & (MYSQL_WAIT_READ | MYSQL_WAIT_WRITE));
+
+    // the ready events
+    tb_int_t ready = 0;
+    if (wait & TB_SOCKET_EVENT_RECV) ready |= MYSQL_WAIT_READ;
+    if (wait & TB_SOCKET_EVENT_SEND) ready |= MYSQL_WAIT_WRITE;
+    return ready;
+}
+#endif
+static MYSQL* tb_database_mysql_call_connect(MYSQL* database, tb_char_t const* host, tb_char_t const* username, tb_char_t const* password, tb_char_t const* name, tb_uint_t port, tb_ulong_t flags)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    MYSQL*      ret = tb_null;
+    tb_int_t    status = mysql_real_connect_start(&ret, database, host, username, password, name, port, tb_null, flags);
+    while (status) status = mysql_real_connect_cont(&ret, database, tb_database_mysql_wait(database, status));
+    return ret;
+#else
+    return mysql_real_connect(database, host, username, password, name, port, tb_null, flags);
+#endif
+}
+static tb_int_t tb_database_mysql_call_query(MYSQL* database, tb_char_t const* sql)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    tb_int_t    ret = 0;
+    tb_int_t    status = mysql_real_query_start(&ret, database, sql, (tb_ulong_t)tb_strlen(sql));
+    while (status) status = mysql_real_query_cont(&ret, database, tb_database_mysql_wait(database, status));
+    return ret;
+#else
+    return mysql_real_query(database, sql, (tb_ulong_t)tb_strlen(sql));
+#endif
+}
+static tb_int_t tb_database_mysql_call_next_result(MYSQL* database)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    tb_int_t    ret = 0;
+    tb_int_t    status = mysql_next_result_start(&ret, database);
+    while (status) status = mysql_next_result_cont(&ret, database, tb_database_mysql_wait(database, status));
+    return ret;
+#else
+    return mysql_next_result(database);
+#endif
+}
+static MYSQL_RES* tb_database_mysql_call_store_result(MYSQL* database)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    MYSQL_RES*  ret = tb_null;
+    tb_int_t    status = mysql_store_result_start(&ret, database);
+    while (status) status = mysql_store_result_cont(&ret, database, tb_database_mysql_wait(database, status));
+    return ret;
+#else
+    return mysql_store_result(database);
+#endif
+}
+static MYSQL_ROW tb_database_mysql_call_fetch_row(MYSQL* database, MYSQL_RES* result)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    MYSQL_ROW   ret = tb_null;
+    tb_int_t    status = mysql_fetch_row_start(&ret, result);
+    while (status) status = mysql_fetch_row_cont(&ret, result, tb_database_mysql_wait(database, status));
+    return ret;
+#else
+    return mysql_fetch_row(result);
+#endif
+}
+static tb_void_t tb_database_mysql_call_free_result(MYSQL* database, MYSQL_RES* result)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    // the unread rows of the unbuffered result will be read and discarded
+    tb_int_t status = mysql_free_result_start(result);
+    while (status) status = mysql_free_result_cont(result, tb_database_mysql_wait(database, status));
+#else
+    mysql_free_result(result);
+#endif
+}
+static tb_bool_t tb_database_mysql_call_commit(MYSQL* database)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    my_bool     ret = 0;
+    tb_int_t    status = mysql_commit_start(&ret, database);
+    while (status) status = mysql_commit_cont(&ret, database, tb_database_mysql_wait(database, status));
+    return !ret;
+#else
+    return !mysql_commit(database);
+#endif
+}
+static tb_bool_t tb_database_mysql_call_rollback(MYSQL* database)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    my_bool     ret = 0;
+    tb_int_t    status = mysql_rollback_start(&ret, database);
+    while (status) status = mysql_rollback_cont(&ret, database, tb_database_mysql_wait(database, status));
+    return !ret;
+#else
+    return !mysql_rollback(database);
+#endif
+}
+static tb_bool_t tb_database_mysql_call_autocommit(MYSQL* database, tb_bool_t enable)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    my_bool     ret = 0;
+    tb_int_t    status = mysql_autocommit_start(&ret, database, (my_bool)enable);
+    while (status) status = mysql_autocommit_cont(&ret, database, tb_database_mysql_wait(database, status));
+    return !ret;
+#else
+    return !mysql_autocommit(database, (my_bool)enable);
+#endif
+}
+static tb_bool_t tb_database_mysql_call_ping(MYSQL* database)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    tb_int_t    ret = 0;
+    tb_int_t    status = mysql_ping_start(&ret, database);
+    while (status) status = mysql_ping_cont(&ret, database, tb_database_mysql_wait(database, status));
+    return !ret;
+#else
+    return !mysql_ping(database);
+#endif
+}
+static tb_int_t tb_database_mysql_call_stmt_prepare(MYSQL* database, MYSQL_STMT* statement, tb_char_t const* sql)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    tb_int_t    ret = 0;
+    tb_int_t    status = mysql_stmt_prepare_start(&ret, statement, sql, (tb_ulong_t)tb_strlen(sql));
+    while (status) status = mysql_stmt_prepare_cont(&ret, statement, tb_database_mysql_wait(database, status));
+    return ret;
+#else
+    return mysql_stmt_prepare(statement, sql, (tb_ulong_t)tb_strlen(sql));
+#endif
+}
+static tb_int_t tb_database_mysql_call_stmt_execute(MYSQL* database, MYSQL_STMT* statement)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    tb_int_t    ret = 0;
+    tb_int_t    status = mysql_stmt_execute_start(&ret, statement);
+    while (status) status = mysql_stmt_execute_cont(&ret, statement, tb_database_mysql_wait(database, status));
+    return ret;
+#else
+    return mysql_stmt_execute(statement);
+#endif
+}
+static tb_int_t tb_database_mysql_call_stmt_store_result(MYSQL* database, MYSQL_STMT* statement)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    tb_int_t    ret = 0;
+    tb_int_t    status = mysql_stmt_store_result_start(&ret, statement);
+    while (status) status = mysql_stmt_store_result_cont(&ret, statement, tb_database_mysql_wait(database, status));
+    return ret;
+#else
+    return mysql_stmt_store_result(statement);
+#endif
+}
+static tb_int_t tb_database_mysql_call_stmt_fetch(MYSQL* database, MYSQL_STMT* statement)
+{
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+    tb_int_t    ret = 0;
+    tb_int_t    status = mysql_stmt_fetch_start(&ret, statement);
+    while (status) status = mysql_stmt_fetch_cont(&ret, statement, tb_database_mysql_wait(database, status));
+    return ret;
+#else
+    return mysql_stmt_fetch(statement);
+#endif
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * stream implementation
  */
@@ -419,6 +630,10 @@ static tb_size_t tb_database_mysql_result_row_iterator_next(tb_iterator_ref_t it
     tb_assert(result);
     tb_assert_and_check_return_val(itor < result->count, result->count);
 
+    // the mysql
+    tb_database_mysql_t* mysql = (tb_database_mysql_t*)iterator->priv;
+    tb_assert_and_check_return_val(mysql, result->count);
+
     // not load all? try fetching it
     if (!result->try_all)
     {
@@ -427,7 +642,7 @@ static tb_size_t tb_database_mysql_result_row_iterator_next(tb_iterator_ref_t it
         {
             // fetch the row
             tb_int_t ok = 0;
-            if ((ok = mysql_stmt_fetch(result->statement)))
+            if ((ok = tb_database_mysql_call_stmt_fetch(mysql->database, result->statement)))
             {
                 // end or error?
                 if (ok != MYSQL_DATA_TRUNCATED)
@@ -435,11 +650,8 @@ static tb_size_t tb_database_mysql_result_row_iterator_next(tb_iterator_ref_t it
                     // error?
                     if (ok != MYSQL_NO_DATA)
                     {
-                        // the mysql
-                        tb_database_mysql_t* mysql = (tb_database_mysql_t*)iterator->priv;
-
                         // save state
-                        if (mysql) mysql->base.state = tb_database_mysql_state_from_errno(mysql_stmt_errno(result->statement));
+                        mysql->base.state = tb_database_mysql_state_from_errno(mysql_stmt_errno(result->statement));
 
                         // trace
                         tb_trace_e("statement: fetch row %lu failed, error[%d]: %s", itor, mysql_stmt_errno(result->statement), mysql_stmt_error(result->statement));
@@ -457,7 +669,7 @@ static tb_size_t tb_database_mysql_result_row_iterator_next(tb_iterator_ref_t it
             tb_assert_and_check_return_val(result->result, result->count);
             
             // fetch the row
-            result->row.row = mysql_fetch_row(result->result);
+            result->row.row = tb_database_mysql_call_fetch_row(mysql->database, result->result);
             tb_check_return_val(result->row.row, result->count);
 
             // fetch the lengths
@@ -799,8 +1011,18 @@ static tb_bool_t tb_database_mysql_open(tb_database_sql_impl_t* database)
         mysql->database = mysql_init(tb_null);
         tb_assert_and_check_break(mysql->database);
 
+#ifdef TB_DATABASE_MYSQL_NONBLOCK
+        // enable the non-blocking api
+        if (mysql_options(mysql->database, MYSQL_OPT_NONBLOCK, 0))
+        {
+            // trace
+            tb_trace_e("open: enable non-blocking api failed, error[%d]: %s", mysql_errno(mysql->database), mysql_error(mysql->database));
+            break;
+        }
+#endif
+
         // connect it
-        if (!mysql_real_connect(mysql->database, host, username[0]? username : tb_null, password[0]? password : tb_null, database_sql_name[0]? database_sql_name : tb_null, (tb_uint_t)port, tb_null, 0))
+        if (!tb_database_mysql_call_connect(mysql->database, host, username[0]? username : tb_null, password[0]? password : tb_null, database_sql_name[0]? database_sql_name : tb_null, (tb_uint_t)port, CLIENT_MULTI_STATEMENTS))
         {
             // save state
             mysql->base.state = tb_database_mysql_state_from_errno(mysql_errno(mysql->database));
@@ -811,7 +1033,7 @@ static tb_bool_t tb_database_mysql_open(tb_database_sql_impl_t* database)
         }
 
         // disable auto commit
-        if (mysql_autocommit(mysql->database, 0))
+        if (!tb_database_mysql_call_autocommit(mysql->database, tb_false))
         {
             // save state
             mysql->base.state = tb_database_mysql_state_from_errno(mysql_errno(mysql->database));
@@ -838,6 +1060,9 @@ static tb_void_t tb_database_mysql_clos(tb_database_sql_impl_t* database)
     tb_database_mysql_t* mysql = tb_database_mysql_cast(database);
     tb_assert_and_check_return(mysql);
 
+    // exit result first if exists
+    tb_database_mysql_result_exit(database, (tb_iterator_ref_t)&mysql->result);
+
     // clear bind data
     tb_buffer_clear(&mysql->bind_data);
 
@@ -845,6 +1070,22 @@ static tb_void_t tb_database_mysql_clos(tb_database_sql_impl_t* database)
     if (mysql->bind_list && mysql->bind_maxn) 
         tb_memset(mysql->bind_list, 0, mysql->bind_maxn * sizeof(MYSQL_BIND));
 
+#if defined(TB_DATABASE_MYSQL_NONBLOCK) \
+        && defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+    /* cancel the socket waiting of the coroutine before closing it
+     *
+     * the socket of the client library has been waited by tb_socket_wait() in coroutine, 
+     * and it is still in the poller, but the fd may be reused after closing it.
+     */
+    if (mysql->database)
+    {
+        tb_socket_ref_t             sock = tb_fd2sock(mysql_get_socket(mysql->database));
+        tb_co_scheduler_io_ref_t    scheduler_io = tb_co_scheduler_io_self();
+        if (sock && scheduler_io) tb_co_scheduler_io_cancel(scheduler_io, sock);
+    }
+#endif
+
     // close database
     if (mysql->database) mysql_close(mysql->database);
     mysql->database = tb_null;
@@ -885,7 +1126,7 @@ static tb_bool_t tb_database_mysql_begin(tb_database_sql_impl_t* database)
     tb_assert_and_check_return_val(mysql && mysql->database, tb_false);
 
     // done begin
-    if (mysql_query(mysql->database, "begin;"))
+    if (tb_database_mysql_call_query(mysql->database, "begin;"))
     {
         // save state
         mysql->base.state = tb_database_mysql_state_from_errno(mysql_errno(mysql->database));
@@ -905,7 +1146,7 @@ static tb_bool_t tb_database_mysql_commit(tb_database_sql_impl_t* database)
     tb_assert_and_check_return_val(mysql && mysql->database, tb_false);
 
     // done commit
-    if (mysql_commit(mysql->database))
+    if (!tb_database_mysql_call_commit(mysql->database))
     {
         // save state
         mysql->base.state = tb_database_mysql_state_from_errno(mysql_errno(mysql->database));
@@ -925,7 +1166,7 @@ static tb_bool_t tb_database_mysql_rollback(tb_database_sql_impl_t* database)
     tb_assert_and_check_return_val(mysql && mysql->database, tb_false);
 
     // done rollback
-    if (mysql_rollback(mysql->database))
+    if (!tb_database_mysql_call_rollback(mysql->database))
     {
         // save state
         mysql->base.state = tb_database_mysql_state_from_errno(mysql_errno(mysql->database));
@@ -948,7 +1189,7 @@ static tb_bool_t tb_database_mysql_done(tb_database_sql_impl_t* database, tb_cha
     tb_database_mysql_result_exit(database, (tb_iterator_ref_t)&mysql->result);
 
     // done query
-    if (mysql_query(mysql->database, sql))
+    if (tb_database_mysql_call_query(mysql->database, sql))
     {
         // save state
         mysql->base.state = tb_database_mysql_state_from_errno(mysql_errno(mysql->database));
@@ -958,6 +1199,29 @@ static tb_bool_t tb_database_mysql_done(tb_database_sql_impl_t* database, tb_cha
         return tb_false;
     }
 
+    /* done the next statements if the sql has multiple statements
+     *
+     * the results of the previous statements will be discarded, 
+     * and only the result of the last statement will be loaded.
+     */
+    while (mysql_more_results(mysql->database))
+    {
+        // discard the result of the previous statement
+        MYSQL_RES* result = tb_database_mysql_call_store_result(mysql->database);
+        if (result) tb_database_mysql_call_free_result(mysql->database, result);
+
+        // done the next statement
+        if (tb_database_mysql_call_next_result(mysql->database) > 0)
+        {
+            // save state
+            mysql->base.state = tb_database_mysql_state_from_errno(mysql_errno(mysql->database));
+
+            // trace
+            tb_trace_e("done: sql: %s failed, error[%d]: %s", sql, mysql_errno(mysql->database), mysql_error(mysql->database));
+            return tb_false;
+        }
+    }
+
     // trace
     tb_trace_d("done: sql: %s: ok", sql);
 
@@ -974,8 +1238,12 @@ static tb_void_t tb_database_mysql_result_exit(tb_database_sql_impl_t* database,
     if (mysql_result->stream) tb_stream_exit(mysql_result->stream);
     mysql_result->stream = tb_null;
 
+    // the mysql
+    tb_database_mysql_t* mysql = (tb_database_mysql_t*)mysql_result->itor.priv;
+    tb_assert_and_check_return(mysql);
+
     // exit result
-    if (mysql_result->result) mysql_free_result(mysql_result->result);
+    if (mysql_result->result) tb_database_mysql_call_free_result(mysql->database, mysql_result->result);
     mysql_result->result = tb_null;
     mysql_result->fields = tb_null;
 
@@ -1187,7 +1455,7 @@ static tb_bool_t tb_database_mysql_result_bind(tb_database_mysql_t* mysql, tb_bo
         if (!tb_database_mysql_result_bind_data(mysql)) break;
 
         // load all?
-        if (try_all && mysql_stmt_store_result(mysql->result.statement))
+        if (try_all && tb_database_mysql_call_stmt_store_result(mysql->database, mysql->result.statement))
         {
             // save state
             mysql->base.state = tb_database_mysql_state_from_errno(mysql_stmt_errno(mysql->result.statement));
@@ -1235,7 +1503,7 @@ static tb_iterator_ref_t tb_database_mysql_result_load(tb_database_sql_impl_t* d
             {
                 // fetch the first row
                 tb_int_t ok = 0;
-                if ((ok = mysql_stmt_fetch(mysql->result.statement)))
+                if ((ok = tb_database_mysql_call_stmt_fetch(mysql->database, mysql->result.statement)))
                 {
                     // end or error?
                     if (ok != MYSQL_DATA_TRUNCATED)
@@ -1257,14 +1525,14 @@ static tb_iterator_ref_t tb_database_mysql_result_load(tb_database_sql_impl_t* d
         else
         {
             // load result
-            mysql->result.result = try_all? mysql_store_result(mysql->database) : mysql_use_result(mysql->database);
+            mysql->result.result = try_all? tb_database_mysql_call_store_result(mysql->database) : mysql_use_result(mysql->database);
             tb_check_break(mysql->result.result);
 
             // try fetching the first result
             if (!try_all)
             {
                 // fetch the first row
-                mysql->result.row.row = mysql_fetch_row(mysql->result.result);
+                mysql->result.row.row = tb_database_mysql_call_fetch_row(mysql->database, mysql->result.result);
                 tb_check_break(mysql->result.row.row);
 
                 // fetch the first lengths
@@ -1328,7 +1596,7 @@ static tb_database_sql_statement_ref_t tb_database_mysql_statement_init(tb_datab
         }
 
         // prepare statement
-        if (mysql_stmt_prepare(statement, sql, tb_strlen(sql)))
+        if (tb_database_mysql_call_stmt_prepare(mysql->database, statement, sql))
         {
             // save state
             mysql->base.state = tb_database_mysql_state_from_errno(mysql_stmt_errno(statement));
@@ -1373,7 +1641,7 @@ static tb_bool_t tb_database_mysql_statement_done(tb_database_sql_impl_t* databa
         tb_database_mysql_result_exit(database, (tb_iterator_ref_t)&mysql->result);
 
         // done statement
-        if (mysql_stmt_execute((MYSQL_STMT*)statement))
+        if (tb_database_mysql_call_stmt_execute(mysql->database, (MYSQL_STMT*)statement))
         {
             // save state
             mysql->base.state = tb_database_mysql_state_from_errno(mysql_stmt_errno((MYSQL_STMT*)statement));
@@ -1573,6 +1841,91 @@ static tb_bool_t tb_database_mysql_statement_bind(tb_database_sql_impl_t* databa
     return ok;
 }
 
+static tb_bool_t tb_database_mysql_statement_batch(tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const* list, tb_size_t size, tb_size_t count)
+{
+    // check
+    tb_database_mysql_t* mysql = tb_database_mysql_cast(database);
+    tb_assert_and_check_return_val(mysql && mysql->database && statement && list && size && count, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    tb_bool_t begin = tb_false;
+    do
+    {
+        // exit the last result first
+        tb_database_mysql_result_exit(database, (tb_iterator_ref_t)&mysql->result);
+
+        // begin a transaction if we are not in it, all rows will be written at once
+        if (!(mysql->database->server_status & SERVER_STATUS_IN_TRANS))
+        {
+            if (!tb_database_mysql_begin(database)) break;
+            begin = tb_true;
+        }
+
+        // done all rows
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // bind the row arguments
+            if (!tb_database_mysql_statement_bind(database, statement, list + i * size, size)) break;
+
+            // done statement
+            if (tb_database_mysql_call_stmt_execute(mysql->database, (MYSQL_STMT*)statement))
+            {
+                // save state
+                mysql->base.state = tb_database_mysql_state_from_errno(mysql_stmt_errno((MYSQL_STMT*)statement));
+
+                // trace
+                tb_trace_e("statement: batch row[%lu] failed, error[%d]: %s", i, mysql_stmt_errno((MYSQL_STMT*)statement), mysql_stmt_error((MYSQL_STMT*)statement));
+                break;
+            }
+        }
+        tb_check_break(i == count);
+
+        // commit it
+        if (begin)
+        {
+            if (!tb_database_mysql_commit(database)) break;
+            begin = tb_false;
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed? rollback it and keep the failed state
+    if (begin)
+    {
+        tb_size_t state = mysql->base.state;
+        tb_database_mysql_rollback(database);
+        mysql->base.state = state;
+    }
+
+    // ok?
+    return ok;
+}
+static tb_bool_t tb_database_mysql_ping(tb_database_sql_impl_t* database)
+{
+    // check
+    tb_database_mysql_t* mysql = tb_database_mysql_cast(database);
+    tb_assert_and_check_return_val(mysql && mysql->database, tb_false);
+
+    // ping it
+    if (!tb_database_mysql_call_ping(mysql->database))
+    {
+        // save state
+        mysql->base.state = tb_database_mysql_state_from_errno(mysql_errno(mysql->database));
+
+        // trace
+        tb_trace_e("ping: failed, error[%d]: %s", mysql_errno(mysql->database), mysql_error(mysql->database));
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -1643,6 +1996,8 @@ tb_database_sql_ref_t tb_database_mysql_init(tb_url_ref_t url)
         mysql->base.statement_exit  = tb_database_mysql_statement_exit;
         mysql->base.statement_done  = tb_database_mysql_statement_done;
         mysql->base.statement_bind  = tb_database_mysql_statement_bind;
+        mysql->base.statement_batch = tb_database_mysql_statement_batch;
+        mysql->base.ping            = tb_database_mysql_ping;
 
         // init row operation
         static tb_iterator_op_t row_op = 
@@ -87,6 +87,12 @@ typedef struct __tb_database_sql_impl_t
     // statement bind
     tb_bool_t                       (*statement_bind)(struct __tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const* list, tb_size_t size);
 
+    // statement batch, optional
+    tb_bool_t                       (*statement_batch)(struct __tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const* list, tb_size_t size, tb_size_t count);
+
+    // ping, optional
+    tb_bool_t                       (*ping)(struct __tb_database_sql_impl_t* database);
+
 }tb_database_sql_impl_t;
 
 
@@ -28,12 +28,35 @@
  * includes
  */
 #include "prefix.h"
+#include "../../container/container.h"
 #include <sqlite3.h>
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the statement cache maxn
+#ifdef __tb_small__
+#   define TB_DATABASE_SQLITE3_STATEMENT_CACHE_MAXN     (16)
+#else
+#   define TB_DATABASE_SQLITE3_STATEMENT_CACHE_MAXN     (64)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the sqlite3 cached statement type
+typedef struct __tb_database_sqlite3_statement_t
+{
+    // the list entry for lru
+    tb_list_entry_t                     entry;
+
+    // the statement
+    sqlite3_stmt*                       statement;
+
+}tb_database_sqlite3_statement_t;
+
 // the sqlite3 result row type
 typedef struct __tb_database_sqlite3_result_row_t
 {
@@ -66,6 +89,9 @@ typedef struct __tb_database_sqlite3_result_t
     // the row count
     tb_size_t                           count;
 
+    // the head row, it will be the tail if all rows of the statement have been stepped
+    tb_size_t                           head;
+
     // the row
     tb_database_sqlite3_result_row_t    row;
 
@@ -83,6 +109,15 @@ typedef struct __tb_database_sqlite3_t
     // the result
     tb_database_sqlite3_result_t        result;
 
+    // the cursor statement of the done sql, it will be released to the cache after iterating the result
+    sqlite3_stmt*                       cursor;
+
+    // the statement cache, sql => cached statement
+    tb_hash_map_ref_t                   cache;
+
+    // the lru list of the cached statements, the recently used statement is at head
+    tb_list_entry_head_t                lru;
+
 }tb_database_sqlite3_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -140,6 +175,151 @@ static tb_size_t tb_database_sqlite3_state_from_errno(tb_size_t errno)
     return state;
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * statement cache implementation
+ */
+static tb_void_t tb_database_sqlite3_statement_cache_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(element && buff);
+
+    // the sqlite
+    tb_database_sqlite3_t* sqlite = (tb_database_sqlite3_t*)element->priv;
+    tb_assert_and_check_return(sqlite);
+
+    // the cached statement
+    tb_database_sqlite3_statement_t* cached = *((tb_database_sqlite3_statement_t**)buff);
+    if (cached)
+    {
+        // remove it from the lru list
+        tb_list_entry_remove(&sqlite->lru, &cached->entry);
+
+        // exit the statement if it has not been taken out
+        if (cached->statement) sqlite3_finalize(cached->statement);
+
+        // exit it
+        tb_free(cached);
+    }
+
+    // clear it
+    *((tb_database_sqlite3_statement_t**)buff) = tb_null;
+}
+static sqlite3_stmt* tb_database_sqlite3_statement_cache_take(tb_database_sqlite3_t* sqlite, tb_char_t const* sql)
+{
+    // check
+    tb_assert_and_check_return_val(sqlite && sql, tb_null);
+
+    // no cache?
+    tb_check_return_val(sqlite->cache, tb_null);
+
+    // get the cached statement
+    tb_database_sqlite3_statement_t* cached = (tb_database_sqlite3_statement_t*)tb_hash_map_get(sqlite->cache, sql);
+    tb_check_return_val(cached, tb_null);
+
+    // take the statement out of the cache, it is in use now
+    sqlite3_stmt* statement = cached->statement;
+    cached->statement = tb_null;
+    tb_hash_map_remove(sqlite->cache, sql);
+
+    // trace
+    tb_trace_d("statement: cache: take: %s, count: %lu", sql, tb_hash_map_size(sqlite->cache));
+
+    // ok
+    return statement;
+}
+static tb_void_t tb_database_sqlite3_statement_cache_save(tb_database_sqlite3_t* sqlite, sqlite3_stmt* statement)
+{
+    // check
+    tb_assert_and_check_return(sqlite && statement);
+
+    // reset it and clear the bound arguments, they may refer to the user data
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+
+    // done
+    tb_bool_t                           ok = tb_false;
+    tb_database_sqlite3_statement_t*    cached = tb_null;
+    do
+    {
+        // no cache? the database has been closed
+        tb_check_break(sqlite->cache);
+
+        // the sql
+        tb_char_t const* sql = sqlite3_sql(statement);
+        tb_check_break(sql);
+
+        // the same sql has been cached? keep the old statement
+        tb_check_break(!tb_hash_map_get(sqlite->cache, sql));
+
+        // remove the least recently used statements if full
+        while (tb_hash_map_size(sqlite->cache) >= TB_DATABASE_SQLITE3_STATEMENT_CACHE_MAXN)
+        {
+            // the last statement
+            tb_list_entry_ref_t last = tb_list_entry_last(&sqlite->lru);
+            tb_assert_and_check_break(last);
+
+            // remove it
+            tb_hash_map_remove(sqlite->cache, sqlite3_sql(((tb_database_sqlite3_statement_t*)tb_list_entry(&sqlite->lru, last))->statement));
+        }
+
+        // make the cached statement
+        cached = tb_malloc0_type(tb_database_sqlite3_statement_t);
+        tb_assert_and_check_break(cached);
+
+        // save it
+        cached->statement = statement;
+        if (!tb_hash_map_insert(sqlite->cache, sql, cached)) break;
+
+        // insert it to the lru list head
+        tb_list_entry_insert_head(&sqlite->lru, &cached->entry);
+
+        // trace
+        tb_trace_d("statement: cache: save: %s, count: %lu", sql, tb_hash_map_size(sqlite->cache));
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed? exit it
+    if (!ok)
+    {
+        if (cached) tb_free(cached);
+        sqlite3_finalize(statement);
+    }
+}
+static tb_bool_t tb_database_sqlite3_statement_load(tb_database_sqlite3_t* sqlite, tb_char_t const* sql, sqlite3_stmt** pstatement, tb_char_t const** ptail)
+{
+    // check
+    tb_assert_and_check_return_val(sqlite && sqlite->database && sql && pstatement, tb_false);
+
+    // get it from the cache first, the cached sql is always a single statement
+    *pstatement = tb_database_sqlite3_statement_cache_take(sqlite, sql);
+    if (*pstatement)
+    {
+        if (ptail) *ptail = sql + tb_strlen(sql);
+        return tb_true;
+    }
+
+    // prepare it, the statement will be null if the sql is only spaces or comments
+    if (SQLITE_OK != sqlite3_prepare_v2(sqlite->database, sql, -1, pstatement, ptail))
+    {
+        // save state
+        sqlite->base.state = tb_database_sqlite3_state_from_errno(sqlite3_errcode(sqlite->database));
+
+        // trace
+        tb_trace_e("statement: init %s failed, error[%d]: %s", sql, sqlite3_errcode(sqlite->database), sqlite3_errmsg(sqlite->database));
+
+        // exit it
+        if (*pstatement) sqlite3_finalize(*pstatement);
+        *pstatement = tb_null;
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * iterator implementation
  */
@@ -154,8 +334,16 @@ static tb_size_t tb_database_sqlite3_result_row_iterator_size(tb_iterator_ref_t
 }
 static tb_size_t tb_database_sqlite3_result_row_iterator_head(tb_iterator_ref_t iterator)
 {
-    // head
-    return 0;
+    // check
+    tb_database_sqlite3_result_t* result = (tb_database_sqlite3_result_t*)iterator;
+    tb_assert(result);
+
+    /* head
+     *
+     * the statement result can only be iterated forward once, 
+     * so the head is the current row of the statement.
+     */
+    return result->head;
 }
 static tb_size_t tb_database_sqlite3_result_row_iterator_tail(tb_iterator_ref_t iterator)
 {
@@ -210,9 +398,15 @@ static tb_size_t tb_database_sqlite3_result_row_iterator_next(tb_iterator_ref_t
                 }
             }
 
+            // end, the head is the tail now
+            result->head = result->count;
+
             // tail
             return result->count;
         }
+
+        // the next row is the head now
+        result->head = itor + 1;
     }
 
     // next
@@ -299,12 +493,24 @@ static tb_pointer_t tb_database_sqlite3_result_col_iterator_item(tb_iterator_ref
         // init name
         tb_database_sql_value_name_set(&row->value, sqlite3_column_name(sqlite->result.statement, (tb_int_t)itor));
 
+        // the cursor of the done sql? get the text value like the result table loaded by sqlite3_get_table
+        if (sqlite->cursor)
+        {
+            tb_database_sql_value_set_text(&row->value, (tb_char_t const*)sqlite3_column_text(sqlite->result.statement, (tb_int_t)itor), sqlite3_column_bytes(sqlite->result.statement, (tb_int_t)itor));
+            return (tb_pointer_t)&row->value;
+        }
+
         // init type
         tb_size_t type = sqlite3_column_type(sqlite->result.statement, (tb_int_t)itor);
         switch (type)
         {
         case SQLITE_INTEGER:
-            tb_database_sql_value_set_int32(&row->value, sqlite3_column_int(sqlite->result.statement, (tb_int_t)itor));
+            {
+                // the integer is always int64 in sqlite3, we use int32 if it fits
+                tb_int64_t number = sqlite3_column_int64(sqlite->result.statement, (tb_int_t)itor);
+                if (number >= TB_MINS32 && number <= TB_MAXS32) tb_database_sql_value_set_int32(&row->value, (tb_int32_t)number);
+                else tb_database_sql_value_set_int64(&row->value, number);
+            }
             break;
         case SQLITE_TEXT:
             tb_database_sql_value_set_text(&row->value, (tb_char_t const*)sqlite3_column_text(sqlite->result.statement, (tb_int_t)itor), sqlite3_column_bytes(sqlite->result.statement, (tb_int_t)itor));
@@ -349,6 +555,27 @@ static __tb_inline__ tb_database_sqlite3_t* tb_database_sqlite3_cast(tb_database
     // cast
     return (tb_database_sqlite3_t*)database;
 }
+static tb_void_t tb_database_sqlite3_result_clear(tb_database_sqlite3_t* sqlite)
+{
+    // check
+    tb_assert_and_check_return(sqlite);
+
+    // exit the result table
+    if (sqlite->result.result) sqlite3_free_table(sqlite->result.result);
+    sqlite->result.result = tb_null;
+
+    // release the cursor statement to the cache
+    if (sqlite->cursor) tb_database_sqlite3_statement_cache_save(sqlite, sqlite->cursor);
+    sqlite->cursor = tb_null;
+
+    // clear the statement
+    sqlite->result.statement = tb_null;
+
+    // clear the result row and col count
+    sqlite->result.count = 0;
+    sqlite->result.head = 0;
+    sqlite->result.row.count = 0;
+}
 static tb_bool_t tb_database_sqlite3_open(tb_database_sql_impl_t* database)
 {
     // check
@@ -367,6 +594,14 @@ static tb_bool_t tb_database_sqlite3_open(tb_database_sql_impl_t* database)
         // load sqlite3 library
         if (!tb_database_sqlite3_library_load()) break;
 
+        // init the statement cache
+        if (!sqlite->cache)
+        {
+            tb_list_entry_init(&sqlite->lru, tb_database_sqlite3_statement_t, entry, tb_null);
+            sqlite->cache = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_ptr(tb_database_sqlite3_statement_cache_free, sqlite));
+            tb_assert_and_check_break(sqlite->cache);
+        }
+
         // open database
         if (SQLITE_OK != sqlite3_open_v2(path, &sqlite->database, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, tb_null) || !sqlite->database) 
         {
@@ -400,8 +635,15 @@ static tb_void_t tb_database_sqlite3_clos(tb_database_sql_impl_t* database)
     tb_assert_and_check_return(sqlite);
     
     // exit result first if exists
-    if (sqlite->result.result) sqlite3_free_table(sqlite->result.result);
-    sqlite->result.result = tb_null;
+    tb_database_sqlite3_result_clear(sqlite);
+
+    // exit the statement cache, all statements must be finalized before closing database
+    if (sqlite->cache)
+    {
+        tb_hash_map_exit(sqlite->cache);
+        tb_list_entry_exit(&sqlite->lru);
+    }
+    sqlite->cache = tb_null;
 
     // close database
     if (sqlite->database) sqlite3_close(sqlite->database);
@@ -489,62 +731,82 @@ static tb_bool_t tb_database_sqlite3_done(tb_database_sql_impl_t* database, tb_c
     tb_assert_and_check_return_val(sqlite && sqlite->database && sql, tb_false);
 
     // done
-    tb_bool_t ok = tb_false;
+    tb_bool_t       ok = tb_false;
+    sqlite3_stmt*   statement = tb_null;
     do
     {
-        // exit result first if exists
-        if (sqlite->result.result) sqlite3_free_table(sqlite->result.result);
-        sqlite->result.result = tb_null;
+        // exit the last result first
+        tb_database_sqlite3_result_clear(sqlite);
+
+        /* done all statements of the sql
+         *
+         * we step the rows instead of loading the whole result table by sqlite3_get_table,
+         * and only the rows of the last statement will be returned.
+         */
+        tb_bool_t           failed = tb_false;
+        tb_char_t const*    tail = sql;
+        while (tail && *tail)
+        {
+            // load the next statement
+            sqlite3_stmt* next = tb_null;
+            if (!tb_database_sqlite3_statement_load(sqlite, tail, &next, &tail))
+            {
+                failed = tb_true;
+                break;
+            }
 
-        // clear the lasr statement first
-        sqlite->result.statement = tb_null;
+            // only spaces or comments?
+            if (!next) continue;
 
-        // clear the result row count first
-        sqlite->result.count = 0;
+            // finish the rows of the previous statement
+            if (statement)
+            {
+                while (SQLITE_ROW == sqlite3_step(statement)) ;
+                tb_database_sqlite3_statement_cache_save(sqlite, statement);
+            }
+            statement = next;
 
-        // clear the result col count first
-        sqlite->result.row.count = 0;
+            // step the first row
+            tb_int_t result = sqlite3_step(statement);
+            if (result != SQLITE_ROW && result != SQLITE_DONE)
+            {
+                // save state
+                sqlite->base.state = tb_database_sqlite3_state_from_errno(sqlite3_errcode(sqlite->database));
 
-        // done sql
-        tb_int_t    row_count = 0;
-        tb_int_t    col_count = 0;
-        tb_char_t*  error = tb_null;
-        if (SQLITE_OK != sqlite3_get_table(sqlite->database, sql, &sqlite->result.result, &row_count, &col_count, &error))
-        {
-            // save state
-            sqlite->base.state = tb_database_sqlite3_state_from_errno(sqlite3_errcode(sqlite->database));
+                // trace
+                tb_trace_e("done: sql: %s failed, error[%d]: %s", sql, sqlite3_errcode(sqlite->database), sqlite3_errmsg(sqlite->database));
 
-            // trace
-            tb_trace_e("done: sql: %s failed, error[%d]: %s", sql, sqlite3_errcode(sqlite->database), error);
+                // failed
+                failed = tb_true;
+                break;
+            }
 
-            // exit error
-            if (error) sqlite3_free(error);
-            break;
+            // no result? release it
+            if (result == SQLITE_DONE)
+            {
+                tb_database_sqlite3_statement_cache_save(sqlite, statement);
+                statement = tb_null;
+            }
         }
+        tb_check_break(!failed);
 
-        // no result?
-        if (!row_count)
+        // exists result?
+        if (statement)
         {
-            // exit result
-            if (sqlite->result.result) sqlite3_free_table(sqlite->result.result);
-            sqlite->result.result = tb_null;
-
-            // trace
-            tb_trace_d("done: sql: %s: ok", sql);
-
-            // ok
-            ok = tb_true;
-            break;
-        }
+            // save the result iterator mode
+            sqlite->result.itor.mode = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_READONLY;
 
-        // save the result iterator mode
-        sqlite->result.itor.mode = TB_ITERATOR_MODE_RACCESS | TB_ITERATOR_MODE_READONLY;
+            // save the cursor statement for iterating it
+            sqlite->cursor = statement;
+            sqlite->result.statement = statement;
+            statement = tb_null;
 
-        // save result row count
-        sqlite->result.count = row_count;
+            // save result row count, it is unknown before all rows have been stepped
+            sqlite->result.count = (tb_size_t)-1;
 
-        // save result col count
-        sqlite->result.row.count = col_count;
+            // save result col count
+            sqlite->result.row.count = sqlite3_column_count(sqlite->cursor);
+        }
 
         // trace
         tb_trace_d("done: sql: %s: ok", sql);
@@ -553,6 +815,9 @@ static tb_bool_t tb_database_sqlite3_done(tb_database_sql_impl_t* database, tb_c
         ok = tb_true;
     
     } while (0);
+
+    // release the failed statement
+    if (statement) tb_database_sqlite3_statement_cache_save(sqlite, statement);
     
     // ok?
     return ok;
@@ -560,19 +825,11 @@ static tb_bool_t tb_database_sqlite3_done(tb_database_sql_impl_t* database, tb_c
 static tb_void_t tb_database_sqlite3_result_exit(tb_database_sql_impl_t* database, tb_iterator_ref_t result)
 {
     // check
-    tb_database_sqlite3_result_t* sqlite3_result = (tb_database_sqlite3_result_t*)result;
-    tb_assert_and_check_return(sqlite3_result);
+    tb_database_sqlite3_t* sqlite = tb_database_sqlite3_cast(database);
+    tb_assert_and_check_return(sqlite && result == (tb_iterator_ref_t)&sqlite->result);
 
     // exit result
-    if (sqlite3_result->result) sqlite3_free_table(sqlite3_result->result);
-    sqlite3_result->result = tb_null;
-
-    // clear the statement
-    sqlite3_result->statement = tb_null;
-
-    // clear result
-    sqlite3_result->count = 0;
-    sqlite3_result->row.count = 0;
+    tb_database_sqlite3_result_clear(sqlite);
 }
 static tb_iterator_ref_t tb_database_sqlite3_result_load(tb_database_sql_impl_t* database, tb_bool_t try_all)
 {
@@ -580,13 +837,56 @@ static tb_iterator_ref_t tb_database_sqlite3_result_load(tb_database_sql_impl_t*
     tb_database_sqlite3_t* sqlite = tb_database_sqlite3_cast(database);
     tb_assert_and_check_return_val(sqlite && sqlite->database, tb_null);
 
+    /* load all rows into memory for accessing them randomly?
+     *
+     * we need to load them again from the head, so only the readonly statement can be done twice.
+     */
+    if (try_all && sqlite->cursor && sqlite3_stmt_readonly(sqlite->cursor))
+    {
+        // load all rows
+        tb_int_t    row_count = 0;
+        tb_int_t    col_count = 0;
+        tb_char_t*  error = tb_null;
+        tb_char_t** table = tb_null;
+        if (SQLITE_OK == sqlite3_get_table(sqlite->database, sqlite3_sql(sqlite->cursor), &table, &row_count, &col_count, &error))
+        {
+            // release the cursor
+            tb_database_sqlite3_result_clear(sqlite);
+
+            // save the result table
+            if (row_count)
+            {
+                sqlite->result.itor.mode    = TB_ITERATOR_MODE_RACCESS | TB_ITERATOR_MODE_READONLY;
+                sqlite->result.result       = table;
+                sqlite->result.count        = row_count;
+                sqlite->result.row.count    = col_count;
+            }
+            else if (table) sqlite3_free_table(table);
+        }
+        else
+        {
+            // trace, we will iterate the cursor
+            tb_trace_e("result: load all failed, error[%d]: %s", sqlite3_errcode(sqlite->database), error);
+
+            // exit error
+            if (error) sqlite3_free(error);
+        }
+    }
+
     // ok?
     return (sqlite->result.result || sqlite->result.statement)? (tb_iterator_ref_t)&sqlite->result : tb_null;
 }
 static tb_void_t tb_database_sqlite3_statement_exit(tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement)
 {
-    // exit statement
-    if (statement) sqlite3_finalize((sqlite3_stmt*)statement);
+    // check
+    tb_database_sqlite3_t* sqlite = tb_database_sqlite3_cast(database);
+    tb_assert_and_check_return(sqlite && statement);
+
+    // clear the result if we are iterating this statement
+    if (sqlite->result.statement == (sqlite3_stmt*)statement) tb_database_sqlite3_result_clear(sqlite);
+
+    // release it to the cache for reusing it
+    tb_database_sqlite3_statement_cache_save(sqlite, (sqlite3_stmt*)statement);
 }
 static tb_database_sql_statement_ref_t tb_database_sqlite3_statement_init(tb_database_sql_impl_t* database, tb_char_t const* sql)
 {
@@ -594,16 +894,9 @@ static tb_database_sql_statement_ref_t tb_database_sqlite3_statement_init(tb_dat
     tb_database_sqlite3_t* sqlite = tb_database_sqlite3_cast(database);
     tb_assert_and_check_return_val(sqlite && sqlite->database && sql, tb_null);
 
-    // init statement
+    // load statement from the cache or prepare it
     sqlite3_stmt* statement = tb_null;
-    if (SQLITE_OK != sqlite3_prepare_v2(sqlite->database, sql, -1, &statement, 0))
-    {
-        // save state
-        sqlite->base.state = tb_database_sqlite3_state_from_errno(sqlite3_errcode(sqlite->database));
-
-        // trace
-        tb_trace_e("statement: init %s failed, error[%d]: %s", sql, sqlite3_errcode(sqlite->database), sqlite3_errmsg(sqlite->database));
-    }
+    tb_database_sqlite3_statement_load(sqlite, sql, &statement, tb_null);
 
     // ok?
     return (tb_database_sql_statement_ref_t)statement;
@@ -618,18 +911,11 @@ static tb_bool_t tb_database_sqlite3_statement_done(tb_database_sql_impl_t* data
     tb_bool_t ok = tb_false;
     do
     {
-        // exit result first if exists
-        if (sqlite->result.result) sqlite3_free_table(sqlite->result.result);
-        sqlite->result.result = tb_null;
-
-        // clear the last statement first
-        sqlite->result.statement = tb_null;
-
-        // clear the result row count first
-        sqlite->result.count = 0;
+        // exit the last result first
+        tb_database_sqlite3_result_clear(sqlite);
 
-        // clear the result col count first
-        sqlite->result.row.count = 0;
+        // reset it first if the rows of the last done have not been finished
+        sqlite3_reset((sqlite3_stmt*)statement);
 
         // step statement
         tb_int_t result = sqlite3_step((sqlite3_stmt*)statement);
@@ -644,7 +930,7 @@ static tb_bool_t tb_database_sqlite3_statement_done(tb_database_sql_impl_t* data
             // save statement for iterating it
             sqlite->result.statement = (sqlite3_stmt*)statement;
 
-            // save result row count
+            // save result row count, it is unknown before all rows have been stepped
             sqlite->result.count = (tb_size_t)-1;
 
             // save result col count
@@ -705,7 +991,6 @@ static tb_bool_t tb_database_sqlite3_statement_bind(tb_database_sql_impl_t* data
         switch (value->type)
         {
         case TB_DATABASE_SQL_VALUE_TYPE_TEXT:
-            tb_trace_i("sqlite3: test %lu %s", i, value->u.text.data);
             ok = sqlite3_bind_text((sqlite3_stmt*)statement, (tb_int_t)(i + 1), value->u.text.data, (tb_int_t)tb_database_sql_value_size(value), tb_null);
             break;
         case TB_DATABASE_SQL_VALUE_TYPE_INT64:
@@ -783,6 +1068,80 @@ static tb_bool_t tb_database_sqlite3_statement_bind(tb_database_sql_impl_t* data
     // ok?
     return (i == size)? tb_true : tb_false;
 }
+static tb_bool_t tb_database_sqlite3_statement_batch(tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const* list, tb_size_t size, tb_size_t count)
+{
+    // check
+    tb_database_sqlite3_t* sqlite = tb_database_sqlite3_cast(database);
+    tb_assert_and_check_return_val(sqlite && sqlite->database && statement && list && size && count, tb_false);
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_bool_t       begin = tb_false;
+    sqlite3_stmt*   stmt = (sqlite3_stmt*)statement;
+    do
+    {
+        // clear the result if we are iterating this statement
+        if (sqlite->result.statement == stmt) tb_database_sqlite3_result_clear(sqlite);
+
+        // begin a transaction if we are not in it, all rows will be written at once
+        if (sqlite3_get_autocommit(sqlite->database))
+        {
+            if (!tb_database_sqlite3_begin(database)) break;
+            begin = tb_true;
+        }
+
+        // done all rows
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // reset it for the next row
+            sqlite3_reset(stmt);
+
+            // bind the row arguments
+            if (!tb_database_sqlite3_statement_bind(database, statement, list + i * size, size)) break;
+
+            // step it and discard the result rows
+            tb_int_t result = SQLITE_DONE;
+            while (SQLITE_ROW == (result = sqlite3_step(stmt))) ;
+            if (result != SQLITE_DONE)
+            {
+                // save state
+                sqlite->base.state = tb_database_sqlite3_state_from_errno(sqlite3_errcode(sqlite->database));
+
+                // trace
+                tb_trace_e("statement: batch row[%lu] failed, error[%d]: %s", i, sqlite3_errcode(sqlite->database), sqlite3_errmsg(sqlite->database));
+                break;
+            }
+        }
+        tb_check_break(i == count);
+
+        // commit it
+        if (begin)
+        {
+            if (!tb_database_sqlite3_commit(database)) break;
+            begin = tb_false;
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // reset it and clear the bound arguments, they refer to the given list
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+
+    // failed? rollback it and keep the failed state
+    if (begin)
+    {
+        tb_size_t state = sqlite->base.state;
+        tb_database_sqlite3_rollback(database);
+        sqlite->base.state = state;
+    }
+
+    // ok?
+    return ok;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -876,6 +1235,7 @@ tb_database_sql_ref_t tb_database_sqlite3_init(tb_url_ref_t url)
         sqlite->base.statement_exit = tb_database_sqlite3_statement_exit;
         sqlite->base.statement_done = tb_database_sqlite3_statement_done;
         sqlite->base.statement_bind = tb_database_sqlite3_statement_bind;
+        sqlite->base.statement_batch = tb_database_sqlite3_statement_batch;
 
         // init row operation
         static tb_iterator_op_t row_op = 
@@ -0,0 +1,327 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pool.c
+ * @ingroup     database
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "database_pool"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "pool.h"
+#include "../container/container.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default idle connections maxn
+#ifdef __tb_small__
+#   define TB_DATABASE_SQL_POOL_DEFAULT_MAXN        (4)
+#else
+#   define TB_DATABASE_SQL_POOL_DEFAULT_MAXN        (16)
+#endif
+
+// the idle timeout, the idle connection will be closed after 5 minutes
+#define TB_DATABASE_SQL_POOL_IDLE_TIMEOUT           (300000)
+
+// the ping interval, the idle connection will be pinged before reusing it if it has been idle for 10s
+#define TB_DATABASE_SQL_POOL_PING_INTERVAL          (10000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the idle connection type
+typedef struct __tb_database_sql_pool_conn_t
+{
+    // the list entry
+    tb_list_entry_t             entry;
+
+    // the database
+    tb_database_sql_ref_t       database;
+
+    // the idle time
+    tb_hong_t                   time;
+
+}tb_database_sql_pool_conn_t;
+
+// the database sql pool type
+typedef struct __tb_database_sql_pool_t
+{
+    // the lock
+    tb_spinlock_t               lock;
+
+    // the idle connections, the recently used connection is at head
+    tb_list_entry_head_t        conns;
+
+    // the idle connections maxn
+    tb_size_t                   maxn;
+
+    // the url
+    tb_char_t*                  url;
+
+}tb_database_sql_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * helper
+ */
+static tb_void_t tb_database_sql_pool_database_exit(tb_database_sql_ref_t database)
+{
+    // check
+    tb_assert_and_check_return(database);
+
+    // close and exit it
+    tb_database_sql_clos(database);
+    tb_database_sql_exit(database);
+}
+static tb_void_t tb_database_sql_pool_conns_exit(tb_list_entry_head_ref_t conns)
+{
+    // exit all connections
+    while (tb_list_entry_size(conns))
+    {
+        // the last entry
+        tb_list_entry_ref_t last = tb_list_entry_last(conns);
+        tb_list_entry_remove_last(conns);
+
+        // exit it
+        tb_database_sql_pool_conn_t* conn = (tb_database_sql_pool_conn_t*)tb_list_entry(conns, last);
+        if (conn->database) tb_database_sql_pool_database_exit(conn->database);
+        tb_free(conn);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_database_sql_pool_ref_t tb_database_sql_pool_init(tb_char_t const* url, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(url, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_database_sql_pool_t* pool = tb_null;
+    do
+    {
+        // make pool
+        pool = tb_malloc0_type(tb_database_sql_pool_t);
+        tb_assert_and_check_break(pool);
+
+        // init lock
+        if (!tb_spinlock_init(&pool->lock)) break;
+
+        // init idle connections
+        tb_list_entry_init(&pool->conns, tb_database_sql_pool_conn_t, entry, tb_null);
+
+        // init maxn
+        pool->maxn = maxn? maxn : TB_DATABASE_SQL_POOL_DEFAULT_MAXN;
+
+        // init url
+        pool->url = tb_strdup(url);
+        tb_assert_and_check_break(pool->url);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (pool) tb_database_sql_pool_exit((tb_database_sql_pool_ref_t)pool);
+        pool = tb_null;
+    }
+
+    // ok?
+    return (tb_database_sql_pool_ref_t)pool;
+}
+tb_void_t tb_database_sql_pool_exit(tb_database_sql_pool_ref_t self)
+{
+    // check
+    tb_database_sql_pool_t* pool = (tb_database_sql_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // exit all idle connections
+    tb_database_sql_pool_conns_exit(&pool->conns);
+    tb_list_entry_exit(&pool->conns);
+
+    // exit url
+    if (pool->url) tb_free(pool->url);
+    pool->url = tb_null;
+
+    // exit lock
+    tb_spinlock_exit(&pool->lock);
+
+    // exit it
+    tb_free(pool);
+}
+tb_database_sql_ref_t tb_database_sql_pool_get(tb_database_sql_pool_ref_t self)
+{
+    // check
+    tb_database_sql_pool_t* pool = (tb_database_sql_pool_t*)self;
+    tb_assert_and_check_return_val(pool && pool->url, tb_null);
+
+    // done
+    tb_database_sql_ref_t           database = tb_null;
+    tb_database_sql_pool_conn_t*    conn = tb_null;
+    tb_list_entry_head_t            removed;
+    tb_list_entry_init(&removed, tb_database_sql_pool_conn_t, entry, tb_null);
+    while (!database)
+    {
+        // enter
+        tb_spinlock_enter(&pool->lock);
+
+        // remove all expired connections, they are at tail
+        tb_hong_t now = tb_mclock();
+        while (tb_list_entry_size(&pool->conns))
+        {
+            // expired?
+            tb_list_entry_ref_t last = tb_list_entry_last(&pool->conns);
+            if (now - ((tb_database_sql_pool_conn_t*)tb_list_entry(&pool->conns, last))->time <= TB_DATABASE_SQL_POOL_IDLE_TIMEOUT) break;
+
+            // remove it
+            tb_list_entry_remove_last(&pool->conns);
+            tb_list_entry_insert_tail(&removed, last);
+        }
+
+        // take out the recently used connection
+        conn = tb_null;
+        if (tb_list_entry_size(&pool->conns))
+        {
+            tb_list_entry_ref_t head = tb_list_entry_head(&pool->conns);
+            tb_list_entry_remove_head(&pool->conns);
+            conn = (tb_database_sql_pool_conn_t*)tb_list_entry(&pool->conns, head);
+        }
+
+        // leave
+        tb_spinlock_leave(&pool->lock);
+
+        // exit the expired connections outside the lock
+        tb_database_sql_pool_conns_exit(&removed);
+
+        // no idle connections?
+        tb_check_break(conn);
+
+        // is alived? ping it if it has been idle for a while
+        if (now - conn->time < TB_DATABASE_SQL_POOL_PING_INTERVAL || tb_database_sql_ping(conn->database))
+            database = conn->database;
+        else tb_database_sql_pool_database_exit(conn->database);
+
+        // trace
+        tb_trace_d("get: %p, %s", conn->database, database? "ok" : "dead");
+
+        // exit the connection entry
+        tb_free(conn);
+    }
+
+    // exit the removed list
+    tb_list_entry_exit(&removed);
+
+    // open a new connection
+    if (!database)
+    {
+        // init database
+        database = tb_database_sql_init(pool->url);
+        if (database && !tb_database_sql_open(database))
+        {
+            tb_database_sql_exit(database);
+            database = tb_null;
+        }
+
+        // trace
+        tb_trace_d("open: %s: %s", pool->url, database? "ok" : "no");
+    }
+
+    // ok?
+    return database;
+}
+tb_void_t tb_database_sql_pool_put(tb_database_sql_pool_ref_t self, tb_database_sql_ref_t database)
+{
+    // check
+    tb_database_sql_pool_t* pool = (tb_database_sql_pool_t*)self;
+    tb_assert_and_check_return(pool && database);
+
+    // the last operation has been failed? check whether the connection has been broken
+    if (tb_database_sql_state(database) != TB_STATE_OK && !tb_database_sql_ping(database))
+    {
+        // trace
+        tb_trace_d("put: %p, dead", database);
+
+        // exit it
+        tb_database_sql_pool_database_exit(database);
+        return ;
+    }
+
+    // make connection
+    tb_database_sql_pool_conn_t* conn = tb_malloc0_type(tb_database_sql_pool_conn_t);
+    if (!conn)
+    {
+        tb_database_sql_pool_database_exit(database);
+        return ;
+    }
+
+    // init connection
+    conn->database  = database;
+    conn->time      = tb_mclock();
+
+    // enter
+    tb_list_entry_head_t removed;
+    tb_list_entry_init(&removed, tb_database_sql_pool_conn_t, entry, tb_null);
+    tb_spinlock_enter(&pool->lock);
+
+    // insert it to the head
+    tb_list_entry_insert_head(&pool->conns, &conn->entry);
+
+    // remove the least recently used connections if be full
+    while (tb_list_entry_size(&pool->conns) > pool->maxn)
+    {
+        tb_list_entry_ref_t last = tb_list_entry_last(&pool->conns);
+        tb_list_entry_remove_last(&pool->conns);
+        tb_list_entry_insert_tail(&removed, last);
+    }
+
+    // leave
+    tb_spinlock_leave(&pool->lock);
+
+    // trace
+    tb_trace_d("put: %p, removed: %lu", database, tb_list_entry_size(&removed));
+
+    // exit the removed connections outside the lock
+    tb_database_sql_pool_conns_exit(&removed);
+    tb_list_entry_exit(&removed);
+}
+tb_size_t tb_database_sql_pool_size(tb_database_sql_pool_ref_t self)
+{
+    // check
+    tb_database_sql_pool_t* pool = (tb_database_sql_pool_t*)self;
+    tb_assert_and_check_return_val(pool, 0);
+
+    // the idle connections count
+    tb_spinlock_enter(&pool->lock);
+    tb_size_t size = tb_list_entry_size(&pool->conns);
+    tb_spinlock_leave(&pool->lock);
+    return size;
+}
@@ -0,0 +1,121 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pool.h
+ * @ingroup     database
+ *
+ */
+#ifndef TB_DATABASE_POOL_H
+#define TB_DATABASE_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "sql.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the database sql pool ref type
+typedef __tb_typeref__(database_sql_pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the database connection pool
+ *
+ * the opened connections will be kept after putting them and reused by the next getting,
+ * it is thread-safe and the database will only suspend the current coroutine when waiting the mysql server in coroutine.
+ *
+ * @code
+    tb_database_sql_pool_ref_t pool = tb_database_sql_pool_init("sql://localhost/?type=mysql&username=xxxx&password=xxxx", 0);
+    if (pool)
+    {
+        // get an opened database
+        tb_database_sql_ref_t database = tb_database_sql_pool_get(pool);
+        if (database)
+        {
+            // done sql
+            // ...
+
+            // put it to the pool
+            tb_database_sql_pool_put(pool, database);
+        }
+
+        // exit pool
+        tb_database_sql_pool_exit(pool);
+    }
+ * @endcode
+ *
+ * @param url                       the database url
+ * @param maxn                      the idle connections maxn, uses the default maxn if be zero
+ *
+ * @return                          the pool
+ */
+tb_database_sql_pool_ref_t          tb_database_sql_pool_init(tb_char_t const* url, tb_size_t maxn);
+
+/*! exit the database connection pool
+ *
+ * all idle connections will be closed, please put all connections before exiting it
+ *
+ * @param pool                      the pool
+ */
+tb_void_t                           tb_database_sql_pool_exit(tb_database_sql_pool_ref_t pool);
+
+/*! get an opened database from the pool
+ *
+ * the idle connection will be pinged first if it has not been used for a while,
+ * and a new connection will be opened if there are no alived idle connections.
+ *
+ * @param pool                      the pool
+ *
+ * @return                          the database
+ */
+tb_database_sql_ref_t               tb_database_sql_pool_get(tb_database_sql_pool_ref_t pool);
+
+/*! put the database to the pool
+ *
+ * please exit the loaded result before putting it,
+ * and the database will be closed if it is broken or the pool is full.
+ *
+ * @param pool                      the pool
+ * @param database                  the database
+ */
+tb_void_t                           tb_database_sql_pool_put(tb_database_sql_pool_ref_t pool, tb_database_sql_ref_t database);
+
+/*! the idle connections count
+ *
+ * @param pool                      the pool
+ *
+ * @return                          the count
+ */
+tb_size_t                           tb_database_sql_pool_size(tb_database_sql_pool_ref_t pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -270,6 +270,27 @@ tb_bool_t tb_database_sql_rollback(tb_database_sql_ref_t database)
     // ok?
     return ok;
 }
+tb_bool_t tb_database_sql_ping(tb_database_sql_ref_t database)
+{
+    // check
+    tb_database_sql_impl_t* impl = (tb_database_sql_impl_t*)database;
+    tb_assert_and_check_return_val(impl, tb_false);
+    
+    // init state
+    impl->state = TB_STATE_DATABASE_UNKNOWN_ERROR;
+        
+    // opened?
+    tb_check_return_val(impl->bopened, tb_false);
+
+    // ping it, the local database is always alived
+    tb_bool_t ok = impl->ping? impl->ping(impl) : tb_true;
+
+    // save state
+    if (ok) impl->state = TB_STATE_OK;
+
+    // ok?
+    return ok;
+}
 tb_bool_t tb_database_sql_done(tb_database_sql_ref_t database, tb_char_t const* sql)
 {
     // check
@@ -408,3 +429,48 @@ tb_bool_t tb_database_sql_statement_bind(tb_database_sql_ref_t database, tb_data
     // ok?
     return ok;
 }
+tb_bool_t tb_database_sql_statement_batch(tb_database_sql_ref_t database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const* list, tb_size_t size, tb_size_t count)
+{
+    // check
+    tb_database_sql_impl_t* impl = (tb_database_sql_impl_t*)database;
+    tb_assert_and_check_return_val(impl && impl->statement_bind && impl->statement_done && statement && list && size && count, tb_false);
+        
+    // init state
+    impl->state = TB_STATE_DATABASE_UNKNOWN_ERROR;
+
+    // opened?
+    tb_assert_and_check_return_val(impl->bopened, tb_false);
+
+    // done batch
+    tb_bool_t ok = tb_false;
+    if (impl->statement_batch) ok = impl->statement_batch(impl, statement, list, size, count);
+    else
+    {
+        // begin transaction
+        if (impl->begin(impl))
+        {
+            // bind and done all rows
+            tb_size_t i = 0;
+            for (i = 0; i < count; i++)
+            {
+                if (!impl->statement_bind(impl, statement, list + i * size, size)) break;
+                if (!impl->statement_done(impl, statement)) break;
+            }
+
+            // commit it if ok, otherwise rollback it and keep the failed state
+            if (i == count) ok = impl->commit(impl);
+            if (!ok)
+            {
+                tb_size_t state = impl->state;
+                impl->rollback(impl);
+                impl->state = state;
+            }
+        }
+    }
+
+    // save state
+    if (ok) impl->state = TB_STATE_OK;
+
+    // ok?
+    return ok;
+}
@@ -138,6 +138,14 @@ tb_bool_t                           tb_database_sql_commit(tb_database_sql_ref_t
  */
 tb_bool_t                           tb_database_sql_rollback(tb_database_sql_ref_t database);
 
+/*! ping the database and check whether the connection is alived
+ *
+ * @param database                  the database handle
+ *
+ * @return                          tb_true or tb_false
+ */
+tb_bool_t                           tb_database_sql_ping(tb_database_sql_ref_t database);
+
 /*! the database state
  *
  * @param database                  the database handle
@@ -255,8 +263,12 @@ tb_bool_t                           tb_database_sql_done(tb_database_sql_ref_t d
 
  * @endcode
  *
+ * @note the rows of the forward result can be iterated only once, and the row count is unknown,
+ * so tb_iterator_size() will return (tb_size_t)-1 for it.
+ *
  * @param database                  the database handle
- * @param try_all                   try loading all result into memory
+ * @param try_all                   try loading all result into memory for accessing it randomly,
+ *                                  otherwise the rows will be iterated forward one by one
  *
  * @return                          the database result
  */
@@ -270,6 +282,9 @@ tb_iterator_ref_t                   tb_database_sql_result_load(tb_database_sql_
 tb_void_t                           tb_database_sql_result_exit(tb_database_sql_ref_t database, tb_iterator_ref_t result);
 
 /*! init the database statement
+ *
+ * the prepared statements of sqlite3 are cached by the sql after exiting them,
+ * so it is cheap to init the same statement again.
  *
  * @param database                  the database handle
  * @param sql                       the sql command
@@ -327,6 +342,43 @@ tb_bool_t                           tb_database_sql_statement_done(tb_database_s
  */
 tb_bool_t                           tb_database_sql_statement_bind(tb_database_sql_ref_t database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const* list, tb_size_t size);
 
+/*! bind and done the database statement for all rows in one transaction
+ *
+ * it is used to insert or update many rows quickly,
+ * the sqlite3 database will not begin a new transaction if it is in a transaction now.
+ *
+ * @code
+    tb_database_sql_statement_ref_t statement = tb_database_sql_statement_init(database, "insert into table values(?, ?)");
+    if (statement)
+    {
+        // the rows
+        tb_database_sql_value_t list[2 * 2] = {0};
+        tb_database_sql_value_set_int32(&list[0], 1);
+        tb_database_sql_value_set_text(&list[1], "name1", 0);
+        tb_database_sql_value_set_int32(&list[2], 2);
+        tb_database_sql_value_set_text(&list[3], "name2", 0);
+
+        // insert them
+        if (!tb_database_sql_statement_batch(database, statement, list, 2, 2))
+        {
+            // ...
+        }
+
+        // exit statement
+        tb_database_sql_statement_exit(database, statement);
+    }
+ * @endcode
+ *
+ * @param database                  the database handle
+ * @param statement                 the statement handle
+ * @param list                      the argument value list of all rows, size * count
+ * @param size                      the argument value count of each row
+ * @param count                     the row count
+ *
+ * @return                          tb_true or tb_false
+ */
+tb_bool_t                           tb_database_sql_statement_batch(tb_database_sql_ref_t database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const* list, tb_size_t size, tb_size_t count);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
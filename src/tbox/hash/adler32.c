@@ -31,6 +31,7 @@
  * includes
  */
 #include "adler32.h"
+#include "impl/prefix.h"
 #ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
 #   include <zlib.h>
 #endif
@@ -57,11 +58,183 @@
 #define MOD28(a)        (a) %= BASE
 #define MOD63(a)        (a) %= BASE
 
+// the simd block size
+#define TB_ADLER32_SIMD_BLOCK   (32)
+
+// the minimum size for using the simd kernels
+#define TB_ADLER32_SIMD_MINN    (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#if defined(TB_HASH_IMPL_x64_SIMD) || defined(TB_HASH_IMPL_ARM64_SIMD)
+static tb_uint32_t tb_adler32_make_left(tb_uint32_t adler, tb_uint32_t sum2, tb_byte_t const* data, tb_size_t size)
+{
+    // done the left bytes (less than 32 bytes)
+    if (size)
+    {
+        while (size--)
+        {
+            adler += *data++;
+            sum2 += adler;
+        }
+        MOD(adler);
+        MOD(sum2);
+    }
+
+    // return recombined sums 
+    return (tb_uint32_t)(adler | (sum2 << 16));
+}
+#endif
+#if defined(TB_HASH_IMPL_x64_SIMD)
+/* make adler32 with avx2
+ *
+ * for each 32 bytes block: 
+ *
+ * sum2 += 32 * adler + 32 * data[0] + 31 * data[1] + ... + 1 * data[31]
+ * adler += data[0] + data[1] + ... + data[31]
+ */
+static __tb_hash_target_avx2__ tb_uint32_t tb_adler32_make_avx2(tb_uint32_t seed, tb_byte_t const* data, tb_size_t size)
+{
+    // split adler-32 into component sums 
+    tb_uint32_t adler = seed & 0xffff;
+    tb_uint32_t sum2 = (seed >> 16) & 0xffff;
+
+    // init the weights and constants
+    __m256i const weights = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    __m256i const ones = _mm256_set1_epi16(1);
+    __m256i const zero = _mm256_setzero_si256();
+
+    // done blocks
+    tb_size_t blocks = size / TB_ADLER32_SIMD_BLOCK;
+    size -= blocks * TB_ADLER32_SIMD_BLOCK;
+    while (blocks)
+    {
+        // the NMAX constraint, only one modulo for each NMAX bytes
+        tb_size_t n = NMAX / TB_ADLER32_SIMD_BLOCK;
+        if (n > blocks) n = blocks;
+        blocks -= n;
+
+        // v_ps: the sum of the adler values before each block, v_s1: the byte sums, v_s2: the weighted byte sums
+        __m256i v_ps = _mm256_setr_epi32((tb_int_t)(adler * n), 0, 0, 0, 0, 0, 0, 0);
+        __m256i v_s2 = _mm256_setr_epi32((tb_int_t)sum2, 0, 0, 0, 0, 0, 0, 0);
+        __m256i v_s1 = zero;
+        do
+        {
+            __m256i bytes = _mm256_loadu_si256((__m256i const*)data);
+            v_ps = _mm256_add_epi32(v_ps, v_s1);
+            v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(bytes, zero));
+            v_s2 = _mm256_add_epi32(v_s2, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, weights), ones));
+            data += TB_ADLER32_SIMD_BLOCK;
+
+        } while (--n);
+        v_s2 = _mm256_add_epi32(v_s2, _mm256_slli_epi32(v_ps, 5));
+
+        // sum the lanes
+        __m128i s1 = _mm_add_epi32(_mm256_castsi256_si128(v_s1), _mm256_extracti128_si256(v_s1, 1));
+        __m128i s2 = _mm_add_epi32(_mm256_castsi256_si128(v_s2), _mm256_extracti128_si256(v_s2, 1));
+        s1 = _mm_add_epi32(s1, _mm_shuffle_epi32(s1, _MM_SHUFFLE(1, 0, 3, 2)));
+        s2 = _mm_add_epi32(s2, _mm_shuffle_epi32(s2, _MM_SHUFFLE(1, 0, 3, 2)));
+        s2 = _mm_add_epi32(s2, _mm_shuffle_epi32(s2, _MM_SHUFFLE(2, 3, 0, 1)));
+        adler += (tb_uint32_t)_mm_cvtsi128_si32(s1);
+        sum2 = (tb_uint32_t)_mm_cvtsi128_si32(s2);
+
+        // reduce them
+        MOD(adler);
+        MOD(sum2);
+    }
+
+    // done the left bytes
+    return tb_adler32_make_left(adler, sum2, data, size);
+}
+#elif defined(TB_HASH_IMPL_ARM64_SIMD)
+/* make adler32 with neon
+ *
+ * for each 32 bytes block: 
+ *
+ * sum2 += 32 * adler + 32 * data[0] + 31 * data[1] + ... + 1 * data[31]
+ * adler += data[0] + data[1] + ... + data[31]
+ */
+static tb_uint32_t tb_adler32_make_neon(tb_uint32_t seed, tb_byte_t const* data, tb_size_t size)
+{
+    // split adler-32 into component sums 
+    tb_uint32_t adler = seed & 0xffff;
+    tb_uint32_t sum2 = (seed >> 16) & 0xffff;
+
+    // init the weights
+    static tb_uint16_t const weights[32] = {32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+
+    // done blocks
+    tb_size_t blocks = size / TB_ADLER32_SIMD_BLOCK;
+    size -= blocks * TB_ADLER32_SIMD_BLOCK;
+    while (blocks)
+    {
+        // the NMAX constraint, only one modulo for each NMAX bytes
+        tb_size_t n = NMAX / TB_ADLER32_SIMD_BLOCK;
+        if (n > blocks) n = blocks;
+        blocks -= n;
+
+        // v_s2: the sum of the adler values before each block, v_s1: the byte sums, v_cs: the byte sums of each column
+        uint32x4_t v_s2 = vsetq_lane_u32((tb_uint32_t)(adler * n), vdupq_n_u32(0), 0);
+        uint32x4_t v_s1 = vdupq_n_u32(0);
+        uint16x8_t v_cs1 = vdupq_n_u16(0);
+        uint16x8_t v_cs2 = vdupq_n_u16(0);
+        uint16x8_t v_cs3 = vdupq_n_u16(0);
+        uint16x8_t v_cs4 = vdupq_n_u16(0);
+        do
+        {
+            uint8x16_t bytes1 = vld1q_u8(data);
+            uint8x16_t bytes2 = vld1q_u8(data + 16);
+            v_s2 = vaddq_u32(v_s2, v_s1);
+            v_s1 = vpadalq_u16(v_s1, vpadalq_u8(vpaddlq_u8(bytes1), bytes2));
+            v_cs1 = vaddw_u8(v_cs1, vget_low_u8(bytes1));
+            v_cs2 = vaddw_u8(v_cs2, vget_high_u8(bytes1));
+            v_cs3 = vaddw_u8(v_cs3, vget_low_u8(bytes2));
+            v_cs4 = vaddw_u8(v_cs4, vget_high_u8(bytes2));
+            data += TB_ADLER32_SIMD_BLOCK;
+
+        } while (--n);
+        v_s2 = vshlq_n_u32(v_s2, 5);
+
+        // add the weighted column sums
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(v_cs1), vld1_u16(weights + 0));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_cs1), vld1_u16(weights + 4));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(v_cs2), vld1_u16(weights + 8));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_cs2), vld1_u16(weights + 12));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(v_cs3), vld1_u16(weights + 16));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_cs3), vld1_u16(weights + 20));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(v_cs4), vld1_u16(weights + 24));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_cs4), vld1_u16(weights + 28));
+
+        // sum the lanes
+        adler += vaddvq_u32(v_s1);
+        sum2 += vaddvq_u32(v_s2);
+
+        // reduce them
+        MOD(adler);
+        MOD(sum2);
+    }
+
+    // done the left bytes
+    return tb_adler32_make_left(adler, sum2, data, size);
+}
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 tb_uint32_t tb_adler32_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
 {
+#if defined(TB_HASH_IMPL_x64_SIMD)
+    // make it with avx2 for the large data
+    if (data && size >= TB_ADLER32_SIMD_MINN && tb_hash_have_feature(AVX2))
+        return tb_adler32_make_avx2(seed, data, size);
+#elif defined(TB_HASH_IMPL_ARM64_SIMD)
+    // make it with neon for the large data
+    if (data && size >= TB_ADLER32_SIMD_MINN)
+        return tb_adler32_make_neon(seed, data, size);
+#endif
+
 #ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
     return adler32(seed, data, (tb_uint_t)size);
 #else
@@ -24,6 +24,42 @@
  * includes
  */
 #include "crc32.h"
+#include "impl/prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// use the slice-by-8 tables? they need 8K for each polynomial
+#ifndef __tb_small__
+#   define TB_CRC32_SLICE_ENABLE
+#endif
+
+// the minimum size for using the slice-by-8 tables
+#define TB_CRC32_SLICE_MINN         (16)
+
+// the minimum size for folding the data with pclmulqdq, it need one 64 bytes block at least
+#define TB_CRC32_PCLMUL_MINN        (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the crc32 slice type
+typedef struct __tb_crc32_slice_t
+{
+    // the base table
+    tb_uint32_t const*      table;
+
+#ifdef TB_CRC32_SLICE_ENABLE
+    // the tables state, 0: none, 1: making, 2: ok
+    tb_atomic_t             state;
+
+    // the slice tables, tables[k][i]: the crc of the byte i followed by k zero bytes
+    tb_uint32_t             tables[8][256];
+#endif
+
+}tb_crc32_slice_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
@@ -132,35 +168,365 @@ tb_uint32_t const g_crc32_le_table[] =
 ,	0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
+// the crc32c(Castagnoli LE) table
+tb_uint32_t const g_crc32c_table[] = 
+{
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c
+,	0x26a1e7e8, 0xd4ca64eb, 0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b
+,	0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24, 0x105ec76f, 0xe235446c
+,	0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384
+,	0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc
+,	0xbc267848, 0x4e4dfb4b, 0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a
+,	0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35, 0xaa64d611, 0x580f5512
+,	0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa
+,	0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad
+,	0x1642ae59, 0xe4292d5a, 0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a
+,	0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595, 0x417b1dbc, 0xb3109ebf
+,	0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957
+,	0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f
+,	0xed03a29b, 0x1f682198, 0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927
+,	0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38, 0xdbfc821c, 0x2997011f
+,	0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7
+,	0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e
+,	0x4767748a, 0xb50cf789, 0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859
+,	0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46, 0x7198540d, 0x83f3d70e
+,	0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6
+,	0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de
+,	0xdde0eb2a, 0x2f8b6829, 0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c
+,	0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93, 0x082f63b7, 0xfa44e0b4
+,	0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c
+,	0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b
+,	0xb4091bff, 0x466298fc, 0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c
+,	0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033, 0xa24bb5a6, 0x502036a5
+,	0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d
+,	0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975
+,	0x0e330a81, 0xfc588982, 0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d
+,	0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622, 0x38cc2a06, 0xcaa7a905
+,	0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed
+,	0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8
+,	0xe52cc12c, 0x1747422f, 0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff
+,	0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0, 0xd3d3e1ab, 0x21b862a8
+,	0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540
+,	0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78
+,	0x7fab5e8c, 0x8dc0dd8f, 0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee
+,	0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1, 0x69e9f0d5, 0x9b8273d6
+,	0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e
+,	0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69
+,	0xd5cf889d, 0x27a40b9e, 0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e
+,	0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+};
+
+// the slices
+static tb_crc32_slice_t g_crc32_slice       = {g_crc32_table};
+#ifndef TB_HASH_IMPL_ARM64_CRC32
+static tb_crc32_slice_t g_crc32_le_slice    = {g_crc32_le_table};
+static tb_crc32_slice_t g_crc32c_slice      = {g_crc32c_table};
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_uint32_t tb_crc32_make_impl(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_uint32_t const table[])
+#ifdef TB_CRC32_SLICE_ENABLE
+static tb_bool_t tb_crc32_slice_init(tb_crc32_slice_t* slice)
+{
+    // the tables have been made?
+    tb_long_t state = tb_atomic_get(&slice->state);
+    tb_check_return_val(state != 2, tb_true);
+
+    // only one thread makes the tables, and the others use the base table before it's finished
+    tb_check_return_val(!state && !tb_atomic_fetch_and_pset(&slice->state, 0, 1), tb_false);
+
+    // make the slice tables
+    tb_size_t i = 0;
+    tb_size_t k = 0;
+    for (i = 0; i < 256; i++) slice->tables[0][i] = slice->table[i];
+    for (k = 1; k < 8; k++)
+    {
+        for (i = 0; i < 256; i++)
+        {
+            tb_uint32_t crc = slice->tables[k - 1][i];
+            slice->tables[k][i] = slice->table[crc & 0xff] ^ (crc >> 8);
+        }
+    }
+
+    // ok
+    tb_atomic_set(&slice->state, 2);
+    return tb_true;
+}
+static tb_uint32_t tb_crc32_make_slice8(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_uint32_t const tables[8][256])
 {
+    // align the data
+    for (; size && ((tb_size_t)data & 7); size--) 
+        crc32 = tables[0][((tb_uint8_t)crc32) ^ *data++] ^ (crc32 >> 8);
+
+    // done 8 bytes for each time
+    tb_uint32_t lo;
+    tb_uint32_t hi;
+    for (; size >= 8; size -= 8, data += 8)
+    {
+        lo = crc32 ^ tb_bits_get_u32_le(data);
+        hi = tb_bits_get_u32_le(data + 4);
+        crc32   = tables[7][lo & 0xff] ^ tables[6][(lo >> 8) & 0xff] ^ tables[5][(lo >> 16) & 0xff] ^ tables[4][lo >> 24]
+                ^ tables[3][hi & 0xff] ^ tables[2][(hi >> 8) & 0xff] ^ tables[1][(hi >> 16) & 0xff] ^ tables[0][hi >> 24];
+    }
+
+    // done the left bytes
+    while (size--) crc32 = tables[0][((tb_uint8_t)crc32) ^ *data++] ^ (crc32 >> 8);
+
+    // ok
+    return crc32;
+}
+#endif
+static tb_uint32_t tb_crc32_make_impl(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_crc32_slice_t* slice)
+{
+#ifdef TB_CRC32_SLICE_ENABLE
+    // use the slice-by-8 tables for the large data
+    if (size >= TB_CRC32_SLICE_MINN && tb_crc32_slice_init(slice))
+        return tb_crc32_make_slice8(crc32, data, size, (tb_uint32_t const (*)[256])slice->tables);
+#endif
+
     // done
 #if defined(TB_ARCH_ARM) && !defined(TB_ARCH_ARM64)
-    crc32 = tb_crc32_make_asm(crc32, data, size, (tb_uint32_t const*)table);
+    crc32 = tb_crc32_make_asm(crc32, data, size, slice->table);
 #else
     tb_byte_t const*    ie = data + size;
-    tb_uint32_t const*  pt = (tb_uint32_t const*)table;
+    tb_uint32_t const*  pt = slice->table;
     while (data < ie) crc32 = pt[((tb_uint8_t)crc32) ^ *data++] ^ (crc32 >> 8);
 #endif
 
     // ok
     return crc32;
 }
+#if defined(TB_HASH_IMPL_x64_SIMD)
+/* fold the data with pclmulqdq for crc32(IEEE LE)
+ *
+ * the size must be >= 64 and aligned by 16 bytes
+ *
+ * @see "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction", Intel
+ */
+static __tb_hash_target_pclmul__ tb_uint32_t tb_crc32_le_make_pclmul(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size)
+{
+    // the fold constants: x^(4*128+32) mod P, x^(4*128-32) mod P, x^(128+32) mod P, ...
+    static __tb_aligned__(16) tb_uint64_t const k1k2[] = { 0x0154442bd4ULL, 0x01c6e41596ULL };
+    static __tb_aligned__(16) tb_uint64_t const k3k4[] = { 0x01751997d0ULL, 0x00ccaa009eULL };
+    static __tb_aligned__(16) tb_uint64_t const k5k0[] = { 0x0163cd6124ULL, 0x0000000000ULL };
+    static __tb_aligned__(16) tb_uint64_t const poly[] = { 0x01db710641ULL, 0x01f7011641ULL };
+
+    // load the first 64 bytes block
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+    x1 = _mm_loadu_si128((__m128i const*)(data + 0x00));
+    x2 = _mm_loadu_si128((__m128i const*)(data + 0x10));
+    x3 = _mm_loadu_si128((__m128i const*)(data + 0x20));
+    x4 = _mm_loadu_si128((__m128i const*)(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((tb_int_t)crc32));
+    x0 = _mm_load_si128((__m128i const*)k1k2);
+    data += 64;
+    size -= 64;
+
+    // fold the 64 bytes blocks in parallel
+    while (size >= 64)
+    {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        y5 = _mm_loadu_si128((__m128i const*)(data + 0x00));
+        y6 = _mm_loadu_si128((__m128i const*)(data + 0x10));
+        y7 = _mm_loadu_si128((__m128i const*)(data + 0x20));
+        y8 = _mm_loadu_si128((__m128i const*)(data + 0x30));
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+        data += 64;
+        size -= 64;
+    }
+
+    // fold them into 128 bits
+    x0 = _mm_load_si128((__m128i const*)k3k4);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // fold the left 16 bytes blocks
+    while (size >= 16)
+    {
+        x2 = _mm_loadu_si128((__m128i const*)data);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        data += 16;
+        size -= 16;
+    }
+
+    // fold 128 bits to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+    x0 = _mm_loadl_epi64((__m128i const*)k5k0);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // barrett reduce it to 32 bits
+    x0 = _mm_load_si128((__m128i const*)poly);
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // ok
+    return (tb_uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+static __tb_hash_target_sse42__ tb_uint32_t tb_crc32c_make_sse42(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size)
+{
+    // align the data
+    for (; size && ((tb_size_t)data & 7); size--) 
+        crc32 = _mm_crc32_u8(crc32, *data++);
+
+    // done 8 bytes for each time
+    tb_uint64_t crc64 = crc32;
+    for (; size >= 32; size -= 32, data += 32)
+    {
+        crc64 = _mm_crc32_u64(crc64, tb_bits_get_u64_le(data));
+        crc64 = _mm_crc32_u64(crc64, tb_bits_get_u64_le(data + 8));
+        crc64 = _mm_crc32_u64(crc64, tb_bits_get_u64_le(data + 16));
+        crc64 = _mm_crc32_u64(crc64, tb_bits_get_u64_le(data + 24));
+    }
+    for (; size >= 8; size -= 8, data += 8)
+        crc64 = _mm_crc32_u64(crc64, tb_bits_get_u64_le(data));
+    crc32 = (tb_uint32_t)crc64;
+
+    // done the left bytes
+    while (size--) crc32 = _mm_crc32_u8(crc32, *data++);
+
+    // ok
+    return crc32;
+}
+#elif defined(TB_HASH_IMPL_ARM64_CRC32)
+static tb_uint32_t tb_crc32_le_make_arm64(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size)
+{
+    // align the data
+    for (; size && ((tb_size_t)data & 7); size--) 
+        crc32 = __crc32b(crc32, *data++);
+
+    // done 8 bytes for each time
+    for (; size >= 32; size -= 32, data += 32)
+    {
+        crc32 = __crc32d(crc32, tb_bits_get_u64_le(data));
+        crc32 = __crc32d(crc32, tb_bits_get_u64_le(data + 8));
+        crc32 = __crc32d(crc32, tb_bits_get_u64_le(data + 16));
+        crc32 = __crc32d(crc32, tb_bits_get_u64_le(data + 24));
+    }
+    for (; size >= 8; size -= 8, data += 8)
+        crc32 = __crc32d(crc32, tb_bits_get_u64_le(data));
+
+    // done the left bytes
+    while (size--) crc32 = __crc32b(crc32, *data++);
+
+    // ok
+    return crc32;
+}
+static tb_uint32_t tb_crc32c_make_arm64(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size)
+{
+    // align the data
+    for (; size && ((tb_size_t)data & 7); size--) 
+        crc32 = __crc32cb(crc32, *data++);
+
+    // done 8 bytes for each time
+    for (; size >= 32; size -= 32, data += 32)
+    {
+        crc32 = __crc32cd(crc32, tb_bits_get_u64_le(data));
+        crc32 = __crc32cd(crc32, tb_bits_get_u64_le(data + 8));
+        crc32 = __crc32cd(crc32, tb_bits_get_u64_le(data + 16));
+        crc32 = __crc32cd(crc32, tb_bits_get_u64_le(data + 24));
+    }
+    for (; size >= 8; size -= 8, data += 8)
+        crc32 = __crc32cd(crc32, tb_bits_get_u64_le(data));
+
+    // done the left bytes
+    while (size--) crc32 = __crc32cb(crc32, *data++);
+
+    // ok
+    return crc32;
+}
+#endif
+static tb_uint32_t tb_crc32_gf2_times(tb_uint32_t const* matrix, tb_uint32_t vector)
+{
+    tb_uint32_t sum = 0;
+    for (; vector; vector >>= 1, matrix++)
+    {
+        if (vector & 1) sum ^= *matrix;
+    }
+    return sum;
+}
+static tb_void_t tb_crc32_gf2_square(tb_uint32_t* square, tb_uint32_t const* matrix)
+{
+    tb_size_t i = 0;
+    for (i = 0; i < 32; i++) square[i] = tb_crc32_gf2_times(matrix, matrix[i]);
+}
+
+/* combine the two crc values without the pre and post conditioning
+ *
+ * crc(A + B) = crc(A) * x^(8 * |B|) + crc(B, 0) mod P, 
+ * and the operator of appending one zero byte (crc => table[crc & 0xff] ^ (crc >> 8)) is a 32x32 matrix over GF(2),
+ * so we can apply |B| zero bytes to crc(A) in O(log(|B|)) matrix squarings.
+ */
+static tb_uint32_t tb_crc32_combine_impl(tb_uint32_t crc1, tb_uint32_t crc2, tb_hize_t size2, tb_uint32_t const table[])
+{
+    // no data?
+    tb_check_return_val(size2, crc1 ^ crc2);
+
+    // make the operator of one zero byte, the column i is the result of the bit i
+    tb_uint32_t  matrices[2][32];
+    tb_uint32_t* matrix = matrices[0];
+    tb_uint32_t* square = matrices[1];
+    tb_uint32_t* swap   = tb_null;
+    tb_size_t    i      = 0;
+    for (i = 0; i < 32; i++) matrix[i] = table[(1u << i) & 0xff] ^ ((1u << i) >> 8);
+
+    // apply the zero bytes of size2 to crc1
+    while (1)
+    {
+        // apply the operator of the 2^n zero bytes
+        if (size2 & 1) crc1 = tb_crc32_gf2_times(matrix, crc1);
+        size2 >>= 1;
+        tb_check_break(size2);
+
+        // the operator of the 2^(n + 1) zero bytes
+        tb_crc32_gf2_square(square, matrix);
+        swap    = matrix;
+        matrix  = square;
+        square  = swap;
+    }
+
+    // ok
+    return crc1 ^ crc2;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-
 tb_uint32_t tb_crc32_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
 {
     // check
     tb_assert_and_check_return_val(data, 0);
 
     // calculate it
-    return tb_crc32_make_impl(seed, data, size, g_crc32_table);
+    return tb_crc32_make_impl(seed, data, size, &g_crc32_slice);
 }
 tb_uint32_t tb_crc32_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
 {
@@ -170,13 +536,34 @@ tb_uint32_t tb_crc32_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
     // make it
     return tb_crc32_make((tb_byte_t const*)cstr, tb_strlen(cstr) + 1, seed);
 }
+tb_uint32_t tb_crc32_combine(tb_uint32_t crc1, tb_uint32_t crc2, tb_hize_t size2)
+{
+    return tb_crc32_combine_impl(crc1, crc2, size2, g_crc32_table);
+}
 tb_uint32_t tb_crc32_le_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
 {
     // check
     tb_assert_and_check_return_val(data, 0);
 
+#if defined(TB_HASH_IMPL_ARM64_CRC32)
+    // calculate it using the crc32 instructions
+    return tb_crc32_le_make_arm64(seed, data, size);
+#else
+
+#   ifdef TB_HASH_IMPL_x64_SIMD
+    // fold the 16 bytes blocks using pclmulqdq
+    if (size >= TB_CRC32_PCLMUL_MINN && tb_hash_have_feature(PCLMUL))
+    {
+        tb_size_t n = size & ~(tb_size_t)15;
+        seed = tb_crc32_le_make_pclmul(seed, data, n);
+        data += n;
+        size -= n;
+    }
+#   endif
+
     // calculate it
-    return tb_crc32_make_impl(seed, data, size, g_crc32_le_table);
+    return tb_crc32_make_impl(seed, data, size, &g_crc32_le_slice);
+#endif
 }
 tb_uint32_t tb_crc32_le_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
 {
@@ -186,3 +573,38 @@ tb_uint32_t tb_crc32_le_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
     // make it
     return tb_crc32_le_make((tb_byte_t const*)cstr, tb_strlen(cstr) + 1, seed);
 }
+tb_uint32_t tb_crc32_le_combine(tb_uint32_t crc1, tb_uint32_t crc2, tb_hize_t size2)
+{
+    return tb_crc32_combine_impl(crc1, crc2, size2, g_crc32_le_table);
+}
+tb_uint32_t tb_crc32c_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(data, 0);
+
+#if defined(TB_HASH_IMPL_ARM64_CRC32)
+    // calculate it using the crc32c instructions
+    return tb_crc32c_make_arm64(seed, data, size);
+#else
+
+#   ifdef TB_HASH_IMPL_x64_SIMD
+    // calculate it using the crc32 instruction of sse4.2
+    if (tb_hash_have_feature(SSE42)) return tb_crc32c_make_sse42(seed, data, size);
+#   endif
+
+    // calculate it
+    return tb_crc32_make_impl(seed, data, size, &g_crc32c_slice);
+#endif
+}
+tb_uint32_t tb_crc32c_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(cstr, 0);
+
+    // make it
+    return tb_crc32c_make((tb_byte_t const*)cstr, tb_strlen(cstr) + 1, seed);
+}
+tb_uint32_t tb_crc32c_combine(tb_uint32_t crc1, tb_uint32_t crc2, tb_hize_t size2)
+{
+    return tb_crc32_combine_impl(crc1, crc2, size2, g_crc32c_table);
+}
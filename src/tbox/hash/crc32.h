@@ -62,7 +62,23 @@ tb_uint32_t         tb_crc32_make(tb_byte_t const* data, tb_size_t size, tb_uint
  */
 tb_uint32_t         tb_crc32_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed);
 
+/*! combine two crc32 (IEEE) values
+ *
+ * crc1 is the crc of the first block A with the given seed, and crc2 is the crc of the second block B with the zero seed,
+ * it returns the crc of the data A + B with the given seed, e.g. combine the crc values of the blocks made in parallel.
+ *
+ * @param crc1      the crc value of the first block
+ * @param crc2      the crc value of the second block, it's made with the zero seed
+ * @param size2     the size of the second block
+ *
+ * @return          the crc value
+ */
+tb_uint32_t         tb_crc32_combine(tb_uint32_t crc1, tb_uint32_t crc2, tb_hize_t size2);
+
 /*! make crc32 (IEEE LE)
+ *
+ * it's the same polynomial as zlib without the pre and post conditioning, 
+ * so the zlib crc32 value is tb_crc32_le_make(data, size, 0xffffffff) ^ 0xffffffff
  *
  * @param data      the input data
  * @param size      the input size
@@ -81,6 +97,48 @@ tb_uint32_t         tb_crc32_le_make(tb_byte_t const* data, tb_size_t size, tb_u
  */
 tb_uint32_t         tb_crc32_le_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed);
 
+/*! combine two crc32 (IEEE LE) values
+ *
+ * @param crc1      the crc value of the first block
+ * @param crc2      the crc value of the second block, it's made with the zero seed
+ * @param size2     the size of the second block
+ *
+ * @return          the crc value
+ */
+tb_uint32_t         tb_crc32_le_combine(tb_uint32_t crc1, tb_uint32_t crc2, tb_hize_t size2);
+
+/*! make crc32c (Castagnoli LE)
+ *
+ * it's used by iscsi, sctp, ext4 and etc. and it will be calculated by the crc32 instructions of sse4.2 or armv8 if be available.
+ * the standard crc32c value is tb_crc32c_make(data, size, 0xffffffff) ^ 0xffffffff
+ *
+ * @param data      the input data
+ * @param size      the input size
+ * @param seed      uses this seed if be non-zero
+ *
+ * @return          the crc value
+ */
+tb_uint32_t         tb_crc32c_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed);
+
+/*! make crc32c (Castagnoli LE) for cstr
+ *
+ * @param cstr      the input cstr
+ * @param seed      uses this seed if be non-zero
+ *
+ * @return          the crc value
+ */
+tb_uint32_t         tb_crc32c_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed);
+
+/*! combine two crc32c (Castagnoli LE) values
+ *
+ * @param crc1      the crc value of the first block
+ * @param crc2      the crc value of the second block, it's made with the zero seed
+ * @param size2     the size of the second block
+ *
+ * @return          the crc value
+ */
+tb_uint32_t         tb_crc32c_combine(tb_uint32_t crc1, tb_uint32_t crc2, tb_hize_t size2);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
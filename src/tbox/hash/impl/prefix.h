@@ -0,0 +1,81 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        prefix.h
+ *
+ */
+#ifndef TB_HASH_IMPL_PREFIX_H
+#define TB_HASH_IMPL_PREFIX_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+#include "../../utils/bits.h"
+#include "../../platform/atomic.h"
+#include "../../platform/processor.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* enable the x64 simd kernels?
+ *
+ * the kernels use the target attribute and are chosen by the processor features at runtime,
+ * so the library itself is still built for the baseline isa.
+ */
+#if defined(TB_ARCH_x64) && defined(TB_ARCH_SSE2) && \
+    (defined(TB_COMPILER_IS_CLANG) || (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9)))
+#   define TB_HASH_IMPL_x64_SIMD
+#endif
+
+// enable the arm64 simd kernels? neon is mandatory for arm64
+#if defined(TB_ARCH_ARM64) && (defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG))
+#   define TB_HASH_IMPL_ARM64_SIMD
+#endif
+
+/* enable the armv8 crc32 instructions?
+ *
+ * they are optional for armv8.0, so we only use them if the compiler targets them, e.g. -march=armv8-a+crc
+ */
+#if defined(TB_HASH_IMPL_ARM64_SIMD) && defined(__ARM_FEATURE_CRC32)
+#   define TB_HASH_IMPL_ARM64_CRC32
+#endif
+
+// the target attributes
+#ifdef TB_HASH_IMPL_x64_SIMD
+#   define __tb_hash_target_avx2__              __attribute__((target("avx2")))
+#   define __tb_hash_target_sse42__             __attribute__((target("sse4.2")))
+#   define __tb_hash_target_pclmul__            __attribute__((target("pclmul")))
+#endif
+
+// have the given processor feature?
+#define tb_hash_have_feature(feature)           (tb_processor_features() & TB_PROCESSOR_FEATURE_ ## feature)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#if defined(TB_HASH_IMPL_x64_SIMD)
+#   include <immintrin.h>
+#elif defined(TB_HASH_IMPL_ARM64_SIMD)
+#   include <arm_neon.h>
+#   ifdef TB_HASH_IMPL_ARM64_CRC32
+#       include <arm_acle.h>
+#   endif
+#endif
+
+#endif
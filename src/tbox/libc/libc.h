@@ -30,5 +30,6 @@
 #include "stdio/stdio.h"
 #include "stdlib/stdlib.h"
 #include "string/string.h"
+#include "string/strsearch.h"
 
 #endif
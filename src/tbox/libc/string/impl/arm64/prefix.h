@@ -0,0 +1,65 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        prefix.h
+ *
+ */
+#ifndef TB_LIBC_STRING_IMPL_ARM64_PREFIX_H
+#define TB_LIBC_STRING_IMPL_ARM64_PREFIX_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* enable the neon routines
+ *
+ * neon is the baseline of arm64, so we needn't dispatch them at runtime
+ */
+#if defined(TB_ARCH_ARM64) && (defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG))
+#   define TB_LIBC_STRING_IMPL_ARM64_SIMD
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#ifdef TB_LIBC_STRING_IMPL_ARM64_SIMD
+#   include <arm_neon.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inline implementation
+ */
+#ifdef TB_LIBC_STRING_IMPL_ARM64_SIMD
+
+/* get the mask of the compared vector
+ *
+ * neon has not movemask, so we narrow the 0x00/0xff bytes to 4 bits per byte,
+ * and the byte index of the first set bit is tb_bits_cl0_u64_le(mask) >> 2.
+ */
+static __tb_inline_force__ tb_uint64_t tb_libc_string_arm64_mask(uint8x16_t v)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,93 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        strsearch.h
+ *
+ */
+#ifndef TB_LIBC_STRING_IMPL_STRSEARCH_H
+#define TB_LIBC_STRING_IMPL_STRSEARCH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* find the first occurrence of the needle in the data
+ *
+ * it's the shared search engine of the tb_memmem, tb_str*str and tb_strn*str functions.
+ *
+ * @param data          the haystack
+ * @param size          the haystack size
+ * @param needle        the needle
+ * @param needle_size   the needle size
+ * @param icase         ignore the case of the ascii letters?
+ *
+ * @return              the matched offset, -1: not found
+ */
+tb_long_t               tb_strsearch_find_impl(tb_byte_t const* data, tb_size_t size, tb_byte_t const* needle, tb_size_t needle_size, tb_bool_t icase);
+
+/* find the last occurrence of the needle in the data
+ *
+ * @param data          the haystack
+ * @param size          the haystack size
+ * @param needle        the needle
+ * @param needle_size   the needle size
+ * @param icase         ignore the case of the ascii letters?
+ *
+ * @return              the matched offset, -1: not found
+ */
+tb_long_t               tb_strsearch_rfind_impl(tb_byte_t const* data, tb_size_t size, tb_byte_t const* needle, tb_size_t needle_size, tb_bool_t icase);
+
+/* find the first occurrence of the wide needle in the wide data
+ *
+ * @param data          the haystack
+ * @param size          the haystack size
+ * @param needle        the needle
+ * @param needle_size   the needle size
+ * @param icase         ignore the case of the ascii letters?
+ *
+ * @return              the matched offset, -1: not found
+ */
+tb_long_t               tb_wcssearch_find_impl(tb_wchar_t const* data, tb_size_t size, tb_wchar_t const* needle, tb_size_t needle_size, tb_bool_t icase);
+
+/* find the last occurrence of the wide needle in the wide data
+ *
+ * @param data          the haystack
+ * @param size          the haystack size
+ * @param needle        the needle
+ * @param needle_size   the needle size
+ * @param icase         ignore the case of the ascii letters?
+ *
+ * @return              the matched offset, -1: not found
+ */
+tb_long_t               tb_wcssearch_rfind_impl(tb_wchar_t const* data, tb_size_t size, tb_wchar_t const* needle, tb_size_t needle_size, tb_bool_t icase);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,255 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        twoway.h
+ *
+ */
+
+/* the two-way string matching template (Crochemore-Perrin)
+ *
+ * it has not the include guard, because it will be included once for each character type and direction.
+ * please define the following macros before including it:
+ *
+ * - TB_TWOWAY_NAME(name):  the function name
+ * - TB_TWOWAY_CHAR:        the character type
+ * - TB_TWOWAY_FOLD_T:      the type of the fold argument
+ * - TB_TWOWAY_CANON(c):    fold the given character with the argument: fold
+ * - TB_TWOWAY_N(i):        get the i-th needle character from: needle, m
+ * - TB_TWOWAY_H(i):        get the i-th haystack character from: haystack, n
+ *
+ * the reversed search is the forward search of the reversed needle and haystack,
+ * so it only need to define the reversed accessors.
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+/* prepare the needle
+ *
+ * compute the critical factorization and the period of the needle,
+ * and the shift table of the last character if the table is not null.
+ *
+ * @param needle        the needle
+ * @param m             the needle size, > 0
+ * @param fold          the fold argument
+ * @param twoway        the factorization
+ * @param shift         the shift table with 256 entries, optional and the needle size must be < 65535
+ */
+static tb_void_t TB_TWOWAY_NAME(prepare)(TB_TWOWAY_CHAR const* needle, tb_size_t m, TB_TWOWAY_FOLD_T fold, tb_twoway_ref_t twoway, tb_uint16_t* shift)
+{
+    // the short needle is always critical at the last character
+    tb_size_t i = 0;
+    tb_size_t suffix = m - 1;
+    tb_size_t period = 1;
+    if (m >= 3)
+    {
+        // the maximal suffix for the lexicographic order
+        tb_size_t           j = 0;
+        tb_size_t           k = 1;
+        tb_size_t           p = 1;
+        tb_size_t           max_suffix = (tb_size_t)-1;
+        TB_TWOWAY_CHAR      a;
+        TB_TWOWAY_CHAR      b;
+        while (j + k < m)
+        {
+            a = TB_TWOWAY_CANON(TB_TWOWAY_N(j + k));
+            b = TB_TWOWAY_CANON(TB_TWOWAY_N(max_suffix + k));
+            if (a < b)
+            {
+                // the suffix is smaller, the period is the entire prefix so far
+                j += k;
+                k = 1;
+                p = j - max_suffix;
+            }
+            else if (a == b)
+            {
+                // advance through the repetition of the current period
+                if (k != p) k++;
+                else
+                {
+                    j += p;
+                    k = 1;
+                }
+            }
+            else
+            {
+                // the suffix is larger, start over from the current location
+                max_suffix = j++;
+                k = p = 1;
+            }
+        }
+        suffix = max_suffix + 1;
+        period = p;
+
+        // the maximal suffix for the reversed lexicographic order
+        j = 0;
+        k = p = 1;
+        max_suffix = (tb_size_t)-1;
+        while (j + k < m)
+        {
+            a = TB_TWOWAY_CANON(TB_TWOWAY_N(j + k));
+            b = TB_TWOWAY_CANON(TB_TWOWAY_N(max_suffix + k));
+            if (b < a)
+            {
+                j += k;
+                k = 1;
+                p = j - max_suffix;
+            }
+            else if (a == b)
+            {
+                if (k != p) k++;
+                else
+                {
+                    j += p;
+                    k = 1;
+                }
+            }
+            else
+            {
+                max_suffix = j++;
+                k = p = 1;
+            }
+        }
+
+        // choose the longer suffix
+        if (max_suffix + 1 > suffix)
+        {
+            suffix = max_suffix + 1;
+            period = p;
+        }
+    }
+
+    // is periodic needle? needle[0, suffix) == needle[period, period + suffix)
+    for (i = 0; i < suffix && TB_TWOWAY_CANON(TB_TWOWAY_N(i)) == TB_TWOWAY_CANON(TB_TWOWAY_N(i + period)); i++) ;
+
+    // save the factorization
+    twoway->suffix      = suffix;
+    twoway->periodic    = (i == suffix);
+    twoway->period      = twoway->periodic? period : tb_max(suffix, m - suffix) + 1;
+
+    // init the shift table of the last character
+    if (shift)
+    {
+        for (i = 0; i < 256; i++) shift[i] = (tb_uint16_t)m;
+        for (i = 0; i < m; i++) shift[((tb_size_t)TB_TWOWAY_CANON(TB_TWOWAY_N(i))) & 0xff] = (tb_uint16_t)(m - i - 1);
+    }
+}
+
+/* search the needle
+ *
+ * @param haystack      the haystack
+ * @param n             the haystack size
+ * @param needle        the needle
+ * @param m             the needle size, > 0
+ * @param fold          the fold argument
+ * @param twoway        the factorization
+ * @param shift         the shift table with 256 entries, optional
+ *
+ * @return              the matched index of the (reversed) haystack, -1: not found
+ */
+static tb_long_t TB_TWOWAY_NAME(search)(TB_TWOWAY_CHAR const* haystack, tb_size_t n, TB_TWOWAY_CHAR const* needle, tb_size_t m, TB_TWOWAY_FOLD_T fold, tb_twoway_ref_t twoway, tb_uint16_t const* shift)
+{
+    // init
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    tb_size_t s = 0;
+    tb_size_t suffix = twoway->suffix;
+    tb_size_t period = twoway->period;
+
+    // periodic needle?
+    if (twoway->periodic)
+    {
+        // the matched prefix size of the last period
+        tb_size_t memory = 0;
+        while (j + m <= n)
+        {
+            // skip it quickly by the last character
+            if (shift)
+            {
+                s = shift[((tb_size_t)TB_TWOWAY_CANON(TB_TWOWAY_H(j + m - 1))) & 0xff];
+                if (s)
+                {
+                    // the last period has a mismatched character, no match until after it
+                    if (memory && s < period) s = m - period;
+                    memory = 0;
+                    j += s;
+                    continue;
+                }
+            }
+
+            // scan the right half
+            i = tb_max(suffix, memory);
+            while (i < m && TB_TWOWAY_CANON(TB_TWOWAY_N(i)) == TB_TWOWAY_CANON(TB_TWOWAY_H(i + j))) i++;
+            if (i >= m)
+            {
+                // scan the left half
+                i = suffix;
+                while (i > memory && TB_TWOWAY_CANON(TB_TWOWAY_N(i - 1)) == TB_TWOWAY_CANON(TB_TWOWAY_H(i - 1 + j))) i--;
+
+                // found?
+                if (i <= memory) return (tb_long_t)j;
+
+                // skip the period and remember the matched prefix
+                j += period;
+                memory = m - period;
+            }
+            else
+            {
+                // skip the matched part of the right half
+                j += i - suffix + 1;
+                memory = 0;
+            }
+        }
+    }
+    else
+    {
+        while (j + m <= n)
+        {
+            // skip it quickly by the last character
+            if (shift)
+            {
+                s = shift[((tb_size_t)TB_TWOWAY_CANON(TB_TWOWAY_H(j + m - 1))) & 0xff];
+                if (s)
+                {
+                    j += s;
+                    continue;
+                }
+            }
+
+            // scan the right half
+            i = suffix;
+            while (i < m && TB_TWOWAY_CANON(TB_TWOWAY_N(i)) == TB_TWOWAY_CANON(TB_TWOWAY_H(i + j))) i++;
+            if (i >= m)
+            {
+                // scan the left half
+                i = suffix;
+                while (i && TB_TWOWAY_CANON(TB_TWOWAY_N(i - 1)) == TB_TWOWAY_CANON(TB_TWOWAY_H(i - 1 + j))) i--;
+
+                // found?
+                if (!i) return (tb_long_t)j;
+
+                // skip the period
+                j += period;
+            }
+            else j += i - suffix + 1;
+        }
+    }
+
+    // not found
+    return -1;
+}
@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "impl/strsearch.h"
 #include "../../memory/impl/prefix.h"
 #ifdef TB_CONFIG_LIBC_HAVE_MEMMEM
 #   include <string.h>
@@ -47,30 +48,9 @@ static tb_pointer_t tb_memmem_impl(tb_cpointer_t s1, tb_size_t n1, tb_cpointer_t
     // check
     tb_assert_and_check_return_val(s1 && s2, tb_null);
 
-    // find empty data?
-	if (!n2) return (tb_pointer_t)s1;
-
-    // done
-	if (n1 >= n2) 
-    {
-        tb_size_t           n = 0;
-		tb_byte_t const*    ph = (tb_byte_t const*)s1;
-		tb_byte_t const*    pn = (tb_byte_t const*)s2;
-		tb_byte_t const*    plast = ph + (n1 - n2);
-		do 
-        {
-			n = 0;
-			while (ph[n] == pn[n]) 
-            {
-                // found?
-				if (++n == n2) return (tb_pointer_t)ph;
-			}
-
-		} while (++ph <= plast);
-	}
-
-    // not found?
-	return tb_null;
+    // find it
+    tb_long_t pos = tb_strsearch_find_impl((tb_byte_t const*)s1, n1, (tb_byte_t const*)s2, n2, tb_false);
+    return pos >= 0? (tb_pointer_t)((tb_byte_t const*)s1 + pos) : tb_null;
 }
 #endif
 
@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "impl/strsearch.h"
 #ifdef TB_CONFIG_LIBC_HAVE_STRCASESTR
 #   include <string.h>
 #endif
@@ -45,30 +46,8 @@ tb_char_t* tb_stristr(tb_char_t const* s1, tb_char_t const* s2)
     // check
     tb_assert_and_check_return_val(s1 && s2, tb_null);
 
-    // init
-    __tb_register__ tb_char_t const* s = s1;
-    __tb_register__ tb_char_t const* p = s2;
-
-    // done
-    do 
-    {
-        if (!*p) return (tb_char_t* )s1;
-        if ((*p == *s)  || (tb_tolower(*((tb_byte_t*)p)) == tb_tolower(*((tb_byte_t*)s)))) 
-        {
-            ++p;
-            ++s;
-        } 
-        else 
-        {
-            p = s2;
-            if (!*s) return tb_null;
-            s = ++s1;
-        }
-
-    } while (1);
-
-    // no found
-    return tb_null;
+    // find it
+    tb_long_t pos = tb_strsearch_find_impl((tb_byte_t const*)s1, tb_strlen(s1), (tb_byte_t const*)s2, tb_strlen(s2), tb_true);
+    return pos >= 0? (tb_char_t*)s1 + pos : tb_null;
 }
 #endif
-
@@ -24,15 +24,17 @@
  * includes
  */
 #include "string.h"
+#include "impl/strsearch.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces 
  */
-
 tb_char_t* tb_strnrstr(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2)
 {
-    tb_assert_and_check_return_val(s1, tb_null);
-    
-    tb_trace_noimpl();
-    return tb_null;
+    // check
+    tb_assert_and_check_return_val(s1 && s2, tb_null);
+
+    // find the last one
+    tb_long_t pos = tb_strsearch_rfind_impl((tb_byte_t const*)s1, tb_strnlen(s1, n1), (tb_byte_t const*)s2, tb_strlen(s2), tb_false);
+    return pos >= 0? (tb_char_t*)s1 + pos : tb_null;
 }
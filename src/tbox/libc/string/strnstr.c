@@ -24,41 +24,17 @@
  * includes
  */
 #include "string.h"
+#include "impl/strsearch.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation 
+ * implementation
  */
 tb_char_t* tb_strnstr(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2)
 {
     // check
     tb_assert_and_check_return_val(s1 && s2 && n1, tb_null);
 
-    // init
-    __tb_register__ tb_char_t const*    s = s1;
-    __tb_register__ tb_char_t const*    p = s2;
-    __tb_register__ tb_size_t           n = n1;
-
-    // done
-    do 
-    {
-        if (!*p) return (tb_char_t *)s1;
-        if (n && *p == *s) 
-        {
-            ++p;
-            ++s;
-            --n;
-        } 
-        else 
-        {
-            p = s2;
-            if (!*s || !n) return tb_null;
-            s = ++s1;
-            n = --n1;
-        }
-
-    } while (1);
-
-    // no found
-    return tb_null;
+    // find it
+    tb_long_t pos = tb_strsearch_find_impl((tb_byte_t const*)s1, tb_strnlen(s1, n1), (tb_byte_t const*)s2, tb_strlen(s2), tb_false);
+    return pos >= 0? (tb_char_t*)s1 + pos : tb_null;
 }
-
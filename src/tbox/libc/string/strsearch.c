@@ -0,0 +1,610 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        strsearch.c
+ * @ingroup     libc
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "strsearch"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "strsearch.h"
+#include "string.h"
+#include "impl/strsearch.h"
+#include "../../utils/bits.h"
+#if defined(TB_ARCH_x64)
+#   include "impl/x64/prefix.h"
+#elif defined(TB_ARCH_ARM64)
+#   include "impl/arm64/prefix.h"
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum size of the short needle which will be filtered by the first and last bytes
+#define TB_STRSEARCH_SHORT_MAXN         (32)
+
+/* the maximum count of the false candidates at the given position for the filter
+ *
+ * each false candidate costs at most TB_STRSEARCH_SHORT_MAXN comparisons,
+ * so we switch to the two-way search if there are too many false candidates to keep it linear.
+ */
+#define TB_STRSEARCH_FAILS_MAXN(pos)    (16 + ((pos) >> 3))
+
+// the minimum haystack size for using the shift table, it's not worth to init the table for the small haystack
+#define TB_STRSEARCH_SHIFT_MINN         (256)
+
+// the maximum needle size for using the shift table, the shifts are saved as 16-bits
+#define TB_STRSEARCH_SHIFT_MAXN         (0xffff)
+
+// the simd filter
+#if defined(TB_LIBC_STRING_IMPL_x64_SIMD)
+#   define TB_STRSEARCH_SIMD_SSE2
+#elif defined(TB_LIBC_STRING_IMPL_ARM64_SIMD)
+#   define TB_STRSEARCH_SIMD_NEON
+#endif
+
+// the vector size and the bits shift of each position in the candidate mask
+#if defined(TB_STRSEARCH_SIMD_SSE2)
+#   define TB_STRSEARCH_SIMD            (16)
+#   define TB_STRSEARCH_SIMD_SHIFT      (0)
+#elif defined(TB_STRSEARCH_SIMD_NEON)
+#   define TB_STRSEARCH_SIMD            (16)
+#   define TB_STRSEARCH_SIMD_SHIFT      (2)
+#endif
+
+// the fold table rows
+#define TB_STRSEARCH_ROW4(f, i)         f(i), f((i) + 1), f((i) + 2), f((i) + 3)
+#define TB_STRSEARCH_ROW16(f, i)        TB_STRSEARCH_ROW4(f, i), TB_STRSEARCH_ROW4(f, (i) + 4), TB_STRSEARCH_ROW4(f, (i) + 8), TB_STRSEARCH_ROW4(f, (i) + 12)
+#define TB_STRSEARCH_ROW64(f, i)        TB_STRSEARCH_ROW16(f, i), TB_STRSEARCH_ROW16(f, (i) + 16), TB_STRSEARCH_ROW16(f, (i) + 32), TB_STRSEARCH_ROW16(f, (i) + 48)
+#define TB_STRSEARCH_ROW256(f)          TB_STRSEARCH_ROW64(f, 0), TB_STRSEARCH_ROW64(f, 64), TB_STRSEARCH_ROW64(f, 128), TB_STRSEARCH_ROW64(f, 192)
+#define TB_STRSEARCH_FOLD_NONE(c)       (c)
+#define TB_STRSEARCH_FOLD_ICASE(c)      (((c) >= 'A' && (c) <= 'Z')? (c) + 0x20 : (c))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the two-way factorization type
+typedef struct __tb_twoway_t
+{
+    // the critical position
+    tb_size_t               suffix;
+
+    // the period (or the shift of the non-periodic needle)
+    tb_size_t               period;
+
+    // is periodic needle?
+    tb_bool_t               periodic;
+
+}tb_twoway_t, *tb_twoway_ref_t;
+
+// the precompiled needle type
+typedef struct __tb_strsearch_t
+{
+    // the fold table
+    tb_byte_t const*        fold;
+
+    // the needle size
+    tb_size_t               size;
+
+    // the forward factorization
+    tb_twoway_t             forward;
+
+    // the reverse factorization
+    tb_twoway_t             reverse;
+
+    // the forward shift table, null if the needle is too long
+    tb_uint16_t*            shift;
+
+    // the reverse shift table, null if the needle is too long
+    tb_uint16_t*            rshift;
+
+    // the shift tables data
+    tb_uint16_t             tables[512];
+
+    // the needle data
+    tb_byte_t               needle[1];
+
+}tb_strsearch_t;
+
+#ifdef TB_STRSEARCH_SIMD
+// the simd filter type
+typedef struct __tb_strsearch_simd_t
+{
+#   if defined(TB_STRSEARCH_SIMD_SSE2)
+    __m128i                 first;
+    __m128i                 first_fold;
+    __m128i                 last;
+    __m128i                 last_fold;
+#   elif defined(TB_STRSEARCH_SIMD_NEON)
+    uint8x16_t              first;
+    uint8x16_t              first_fold;
+    uint8x16_t              last;
+    uint8x16_t              last_fold;
+#   endif
+
+}tb_strsearch_simd_t;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the identity fold table
+static tb_byte_t const g_fold_none[256]     = { TB_STRSEARCH_ROW256(TB_STRSEARCH_FOLD_NONE) };
+
+// the lower case fold table of the ascii letters
+static tb_byte_t const g_fold_icase[256]    = { TB_STRSEARCH_ROW256(TB_STRSEARCH_FOLD_ICASE) };
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the two-way templates
+ */
+
+// the forward search of bytes
+#define TB_TWOWAY_NAME(name)    tb_strsearch_twoway_##name
+#define TB_TWOWAY_CHAR          tb_byte_t
+#define TB_TWOWAY_FOLD_T        tb_byte_t const*
+#define TB_TWOWAY_CANON(c)      fold[c]
+#define TB_TWOWAY_N(i)          needle[i]
+#define TB_TWOWAY_H(i)          haystack[i]
+#include "impl/twoway.h"
+#undef TB_TWOWAY_N
+#undef TB_TWOWAY_H
+#undef TB_TWOWAY_NAME
+
+// the reverse search of bytes
+#define TB_TWOWAY_NAME(name)    tb_strsearch_rtwoway_##name
+#define TB_TWOWAY_N(i)          needle[m - 1 - (i)]
+#define TB_TWOWAY_H(i)          haystack[n - 1 - (i)]
+#include "impl/twoway.h"
+#undef TB_TWOWAY_N
+#undef TB_TWOWAY_H
+#undef TB_TWOWAY_NAME
+#undef TB_TWOWAY_CANON
+#undef TB_TWOWAY_FOLD_T
+#undef TB_TWOWAY_CHAR
+
+// fold the wide character
+static __tb_inline__ tb_wchar_t tb_wcssearch_fold(tb_bool_t icase, tb_wchar_t c)
+{
+    return (icase && c >= L'A' && c <= L'Z')? c + 0x20 : c;
+}
+
+// the forward search of wide characters
+#define TB_TWOWAY_NAME(name)    tb_wcssearch_twoway_##name
+#define TB_TWOWAY_CHAR          tb_wchar_t
+#define TB_TWOWAY_FOLD_T        tb_bool_t
+#define TB_TWOWAY_CANON(c)      tb_wcssearch_fold(fold, c)
+#define TB_TWOWAY_N(i)          needle[i]
+#define TB_TWOWAY_H(i)          haystack[i]
+#include "impl/twoway.h"
+#undef TB_TWOWAY_N
+#undef TB_TWOWAY_H
+#undef TB_TWOWAY_NAME
+
+// the reverse search of wide characters
+#define TB_TWOWAY_NAME(name)    tb_wcssearch_rtwoway_##name
+#define TB_TWOWAY_N(i)          needle[m - 1 - (i)]
+#define TB_TWOWAY_H(i)          haystack[n - 1 - (i)]
+#include "impl/twoway.h"
+#undef TB_TWOWAY_N
+#undef TB_TWOWAY_H
+#undef TB_TWOWAY_NAME
+#undef TB_TWOWAY_CANON
+#undef TB_TWOWAY_FOLD_T
+#undef TB_TWOWAY_CHAR
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the simd filter
+ */
+#ifdef TB_STRSEARCH_SIMD
+
+/* init the simd filter
+ *
+ * we only fold the letter by (c | 0x20), because it merges the upper and lower letters only,
+ * and the other bytes will be compared exactly.
+ */
+static __tb_inline__ tb_void_t tb_strsearch_simd_init(tb_strsearch_simd_t* simd, tb_byte_t first, tb_byte_t last, tb_byte_t const* fold)
+{
+    // is letter? the fold table will merge it with (c ^ 0x20)
+    tb_byte_t first_fold = fold[first ^ 0x20] == first? 0x20 : 0;
+    tb_byte_t last_fold = fold[last ^ 0x20] == last? 0x20 : 0;
+
+    // init vectors
+#   if defined(TB_STRSEARCH_SIMD_SSE2)
+    simd->first         = _mm_set1_epi8((tb_char_t)(first | first_fold));
+    simd->first_fold    = _mm_set1_epi8((tb_char_t)first_fold);
+    simd->last          = _mm_set1_epi8((tb_char_t)(last | last_fold));
+    simd->last_fold     = _mm_set1_epi8((tb_char_t)last_fold);
+#   elif defined(TB_STRSEARCH_SIMD_NEON)
+    simd->first         = vdupq_n_u8(first | first_fold);
+    simd->first_fold    = vdupq_n_u8(first_fold);
+    simd->last          = vdupq_n_u8(last | last_fold);
+    simd->last_fold     = vdupq_n_u8(last_fold);
+#   endif
+}
+
+// get the candidate mask of the positions [p, p + TB_STRSEARCH_SIMD)
+static __tb_inline_force__ tb_uint64_t tb_strsearch_simd_mask(tb_strsearch_simd_t const* simd, tb_byte_t const* p, tb_size_t m)
+{
+#   if defined(TB_STRSEARCH_SIMD_SSE2)
+    __m128i a = _mm_or_si128(_mm_loadu_si128((__m128i const*)p), simd->first_fold);
+    __m128i b = _mm_or_si128(_mm_loadu_si128((__m128i const*)(p + m - 1)), simd->last_fold);
+    return (tb_uint64_t)(tb_uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, simd->first), _mm_cmpeq_epi8(b, simd->last)));
+#   elif defined(TB_STRSEARCH_SIMD_NEON)
+    uint8x16_t a = vorrq_u8(vld1q_u8(p), simd->first_fold);
+    uint8x16_t b = vorrq_u8(vld1q_u8(p + m - 1), simd->last_fold);
+    return tb_libc_string_arm64_mask(vandq_u8(vceqq_u8(a, simd->first), vceqq_u8(b, simd->last))) & 0x1111111111111111ULL;
+#   endif
+}
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// verify the candidate, the first and last bytes have been matched
+static __tb_inline__ tb_bool_t tb_strsearch_verify(tb_byte_t const* p, tb_byte_t const* needle, tb_size_t m, tb_byte_t const* fold)
+{
+    // no middle bytes?
+    tb_check_return_val(m > 2, tb_true);
+
+    // compare the middle bytes
+    if (fold == g_fold_none) return !tb_memcmp_(p + 1, needle + 1, m - 2);
+    else
+    {
+        tb_size_t i = 1;
+        for (; i < m - 1 && fold[p[i]] == fold[needle[i]]; i++) ;
+        return i == m - 1;
+    }
+}
+
+/* filter the candidates of the short needle by the first and last bytes
+ *
+ * @param data          the haystack
+ * @param size          the haystack size, >= m
+ * @param needle        the needle
+ * @param m             the needle size, > 0
+ * @param fold          the fold table
+ * @param pnext         the next position if it gives up for too many false candidates
+ *
+ * @return              the matched offset, -1: not found
+ */
+static tb_long_t tb_strsearch_filter(tb_byte_t const* data, tb_size_t size, tb_byte_t const* needle, tb_size_t m, tb_byte_t const* fold, tb_size_t* pnext)
+{
+    // init
+    tb_size_t   i = 0;
+    tb_size_t   pos = 0;
+    tb_size_t   fails = 0;
+    tb_byte_t   first = fold[needle[0]];
+    tb_byte_t   last = fold[needle[m - 1]];
+
+#ifdef TB_STRSEARCH_SIMD
+    // filter the candidates by vectors
+    tb_uint64_t         mask = 0;
+    tb_strsearch_simd_t simd;
+    tb_strsearch_simd_init(&simd, first, last, fold);
+    while (pos + TB_STRSEARCH_SIMD + m - 1 <= size)
+    {
+        // verify the candidates
+        mask = tb_strsearch_simd_mask(&simd, data + pos, m);
+        while (mask)
+        {
+            i = tb_bits_cl0_u64_le(mask) >> TB_STRSEARCH_SIMD_SHIFT;
+            if (tb_strsearch_verify(data + pos + i, needle, m, fold)) return (tb_long_t)(pos + i);
+            mask &= mask - 1;
+            fails++;
+        }
+        pos += TB_STRSEARCH_SIMD;
+
+        // too many false candidates?
+        if (fails > TB_STRSEARCH_FAILS_MAXN(pos))
+        {
+            *pnext = pos;
+            return -1;
+        }
+    }
+#endif
+
+    // filter the left candidates
+    for (; pos + m <= size; pos++)
+    {
+        if (fold[data[pos]] == first && fold[data[pos + m - 1]] == last)
+        {
+            // found?
+            if (tb_strsearch_verify(data + pos, needle, m, fold)) return (tb_long_t)pos;
+
+            // too many false candidates?
+            if (++fails > TB_STRSEARCH_FAILS_MAXN(pos))
+            {
+                *pnext = pos + 1;
+                return -1;
+            }
+        }
+    }
+
+    // not found
+    *pnext = pos;
+    return -1;
+}
+
+/* filter the candidates of the short needle by the first and last bytes from the end
+ *
+ * @param data          the haystack
+ * @param size          the haystack size, >= m
+ * @param needle        the needle
+ * @param m             the needle size, > 0
+ * @param fold          the fold table
+ * @param pleft         the count of the left candidates if it gives up for too many false candidates
+ *
+ * @return              the matched offset, -1: not found
+ */
+static tb_long_t tb_strsearch_rfilter(tb_byte_t const* data, tb_size_t size, tb_byte_t const* needle, tb_size_t m, tb_byte_t const* fold, tb_size_t* pleft)
+{
+    // init, the left candidates are [0, left)
+    tb_size_t   fails = 0;
+    tb_size_t   count = size - m + 1;
+    tb_size_t   left = count;
+    tb_byte_t   first = fold[needle[0]];
+    tb_byte_t   last = fold[needle[m - 1]];
+
+#ifdef TB_STRSEARCH_SIMD
+    // filter the candidates by vectors
+    tb_size_t           i = 0;
+    tb_uint64_t         mask = 0;
+    tb_strsearch_simd_t simd;
+    tb_strsearch_simd_init(&simd, first, last, fold);
+    while (left >= TB_STRSEARCH_SIMD)
+    {
+        // verify the candidates from the last one
+        left -= TB_STRSEARCH_SIMD;
+        mask = tb_strsearch_simd_mask(&simd, data + left, m);
+        while (mask)
+        {
+            i = (63 - tb_bits_cl0_u64_be(mask)) >> TB_STRSEARCH_SIMD_SHIFT;
+            if (tb_strsearch_verify(data + left + i, needle, m, fold)) return (tb_long_t)(left + i);
+            mask &= ~((tb_uint64_t)1 << (i << TB_STRSEARCH_SIMD_SHIFT));
+            fails++;
+        }
+
+        // too many false candidates?
+        if (fails > TB_STRSEARCH_FAILS_MAXN(count - left))
+        {
+            *pleft = left;
+            return -1;
+        }
+    }
+#endif
+
+    // filter the left candidates
+    while (left)
+    {
+        left--;
+        if (fold[data[left]] == first && fold[data[left + m - 1]] == last)
+        {
+            // found?
+            if (tb_strsearch_verify(data + left, needle, m, fold)) return (tb_long_t)left;
+
+            // too many false candidates?
+            if (++fails > TB_STRSEARCH_FAILS_MAXN(count - left))
+            {
+                *pleft = left;
+                return -1;
+            }
+        }
+    }
+
+    // not found
+    *pleft = 0;
+    return -1;
+}
+
+/* find the first occurrence
+ *
+ * the factorization and shift table will be computed here if the needle is not precompiled.
+ */
+static tb_long_t tb_strsearch_find_done(tb_byte_t const* data, tb_size_t size, tb_byte_t const* needle, tb_size_t m, tb_byte_t const* fold, tb_twoway_ref_t twoway, tb_uint16_t const* shift)
+{
+    // empty needle? or too long needle?
+    tb_check_return_val(m, 0);
+    tb_check_return_val(m <= size, -1);
+
+    // filter the short needle by the first and last bytes
+    tb_long_t pos = -1;
+    tb_size_t next = 0;
+    if (m <= TB_STRSEARCH_SHORT_MAXN)
+    {
+        pos = tb_strsearch_filter(data, size, needle, m, fold, &next);
+        tb_check_return_val(pos < 0 && next + m <= size, pos);
+    }
+
+    // prepare the needle if it's not precompiled
+    tb_twoway_t temp;
+    tb_uint16_t table[256];
+    if (!twoway)
+    {
+        twoway = &temp;
+        shift = (size - next >= TB_STRSEARCH_SHIFT_MINN && m < TB_STRSEARCH_SHIFT_MAXN)? table : tb_null;
+        tb_strsearch_twoway_prepare(needle, m, fold, twoway, (tb_uint16_t*)shift);
+    }
+
+    // search the left data by the two-way
+    pos = tb_strsearch_twoway_search(data + next, size - next, needle, m, fold, twoway, shift);
+    return pos >= 0? pos + (tb_long_t)next : -1;
+}
+
+/* find the last occurrence
+ *
+ * the factorization and shift table will be computed here if the needle is not precompiled.
+ */
+static tb_long_t tb_strsearch_rfind_done(tb_byte_t const* data, tb_size_t size, tb_byte_t const* needle, tb_size_t m, tb_byte_t const* fold, tb_twoway_ref_t twoway, tb_uint16_t const* shift)
+{
+    // empty needle? or too long needle?
+    tb_check_return_val(m, (tb_long_t)size);
+    tb_check_return_val(m <= size, -1);
+
+    // filter the short needle by the first and last bytes
+    tb_long_t pos = -1;
+    tb_size_t left = size - m + 1;
+    if (m <= TB_STRSEARCH_SHORT_MAXN)
+    {
+        pos = tb_strsearch_rfilter(data, size, needle, m, fold, &left);
+        tb_check_return_val(pos < 0 && left, pos);
+    }
+
+    // the left data of the candidates [0, left)
+    tb_size_t n = left + m - 1;
+
+    // prepare the needle if it's not precompiled
+    tb_twoway_t temp;
+    tb_uint16_t table[256];
+    if (!twoway)
+    {
+        twoway = &temp;
+        shift = (n >= TB_STRSEARCH_SHIFT_MINN && m < TB_STRSEARCH_SHIFT_MAXN)? table : tb_null;
+        tb_strsearch_rtwoway_prepare(needle, m, fold, twoway, (tb_uint16_t*)shift);
+    }
+
+    // search the left data by the reversed two-way
+    pos = tb_strsearch_rtwoway_search(data, n, needle, m, fold, twoway, shift);
+    return pos >= 0? (tb_long_t)(n - m) - pos : -1;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private interfaces
+ */
+tb_long_t tb_strsearch_find_impl(tb_byte_t const* data, tb_size_t size, tb_byte_t const* needle, tb_size_t needle_size, tb_bool_t icase)
+{
+    // check
+    tb_assert_and_check_return_val(data && needle, -1);
+
+    // done
+    return tb_strsearch_find_done(data, size, needle, needle_size, icase? g_fold_icase : g_fold_none, tb_null, tb_null);
+}
+tb_long_t tb_strsearch_rfind_impl(tb_byte_t const* data, tb_size_t size, tb_byte_t const* needle, tb_size_t needle_size, tb_bool_t icase)
+{
+    // check
+    tb_assert_and_check_return_val(data && needle, -1);
+
+    // done
+    return tb_strsearch_rfind_done(data, size, needle, needle_size, icase? g_fold_icase : g_fold_none, tb_null, tb_null);
+}
+tb_long_t tb_wcssearch_find_impl(tb_wchar_t const* data, tb_size_t size, tb_wchar_t const* needle, tb_size_t needle_size, tb_bool_t icase)
+{
+    // check
+    tb_assert_and_check_return_val(data && needle, -1);
+
+    // empty needle? or too long needle?
+    tb_check_return_val(needle_size, 0);
+    tb_check_return_val(needle_size <= size, -1);
+
+    // prepare the needle
+    tb_twoway_t twoway;
+    tb_uint16_t table[256];
+    tb_uint16_t* shift = (size >= TB_STRSEARCH_SHIFT_MINN && needle_size < TB_STRSEARCH_SHIFT_MAXN)? table : tb_null;
+    tb_wcssearch_twoway_prepare(needle, needle_size, icase, &twoway, shift);
+
+    // search it
+    return tb_wcssearch_twoway_search(data, size, needle, needle_size, icase, &twoway, shift);
+}
+tb_long_t tb_wcssearch_rfind_impl(tb_wchar_t const* data, tb_size_t size, tb_wchar_t const* needle, tb_size_t needle_size, tb_bool_t icase)
+{
+    // check
+    tb_assert_and_check_return_val(data && needle, -1);
+
+    // empty needle? or too long needle?
+    tb_check_return_val(needle_size, (tb_long_t)size);
+    tb_check_return_val(needle_size <= size, -1);
+
+    // prepare the needle
+    tb_twoway_t twoway;
+    tb_uint16_t table[256];
+    tb_uint16_t* shift = (size >= TB_STRSEARCH_SHIFT_MINN && needle_size < TB_STRSEARCH_SHIFT_MAXN)? table : tb_null;
+    tb_wcssearch_rtwoway_prepare(needle, needle_size, icase, &twoway, shift);
+
+    // search it
+    tb_long_t pos = tb_wcssearch_rtwoway_search(data, size, needle, needle_size, icase, &twoway, shift);
+    return pos >= 0? (tb_long_t)(size - needle_size) - pos : -1;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_strsearch_ref_t tb_strsearch_init(tb_char_t const* needle, tb_size_t size, tb_size_t mode)
+{
+    // check
+    tb_assert_and_check_return_val(needle || !size, tb_null);
+
+    // make the needle
+    tb_strsearch_t* search = (tb_strsearch_t*)tb_malloc(sizeof(tb_strsearch_t) + size);
+    tb_assert_and_check_return_val(search, tb_null);
+
+    // init the needle
+    search->fold = (mode & TB_STRSEARCH_MODE_ICASE)? g_fold_icase : g_fold_none;
+    search->size = size;
+    if (size) tb_memcpy(search->needle, needle, size);
+    search->needle[size] = '\0';
+
+    // compute the factorizations and shift tables of both directions
+    search->shift   = size < TB_STRSEARCH_SHIFT_MAXN? search->tables : tb_null;
+    search->rshift  = size < TB_STRSEARCH_SHIFT_MAXN? search->tables + 256 : tb_null;
+    if (size)
+    {
+        tb_strsearch_twoway_prepare(search->needle, size, search->fold, &search->forward, search->shift);
+        tb_strsearch_rtwoway_prepare(search->needle, size, search->fold, &search->reverse, search->rshift);
+    }
+
+    // ok
+    return (tb_strsearch_ref_t)search;
+}
+tb_void_t tb_strsearch_exit(tb_strsearch_ref_t self)
+{
+    // check
+    tb_strsearch_t* search = (tb_strsearch_t*)self;
+    tb_assert_and_check_return(search);
+
+    // exit it
+    tb_free(search);
+}
+tb_long_t tb_strsearch_find(tb_strsearch_ref_t self, tb_char_t const* data, tb_size_t size)
+{
+    // check
+    tb_strsearch_t* search = (tb_strsearch_t*)self;
+    tb_assert_and_check_return_val(search && (data || !size), -1);
+
+    // done
+    return tb_strsearch_find_done((tb_byte_t const*)data, size, search->needle, search->size, search->fold, &search->forward, search->shift);
+}
+tb_long_t tb_strsearch_rfind(tb_strsearch_ref_t self, tb_char_t const* data, tb_size_t size)
+{
+    // check
+    tb_strsearch_t* search = (tb_strsearch_t*)self;
+    tb_assert_and_check_return_val(search && (data || !size), -1);
+
+    // done
+    return tb_strsearch_rfind_done((tb_byte_t const*)data, size, search->needle, search->size, search->fold, &search->reverse, search->rshift);
+}
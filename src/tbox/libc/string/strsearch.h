@@ -0,0 +1,101 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        strsearch.h
+ * @ingroup     libc
+ *
+ */
+#ifndef TB_LIBC_STRING_STRSEARCH_H
+#define TB_LIBC_STRING_STRSEARCH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the string search mode enum
+typedef enum __tb_strsearch_mode_e
+{
+    TB_STRSEARCH_MODE_NONE      = 0
+,   TB_STRSEARCH_MODE_ICASE     = 1     //!< ignore the case of the ascii letters
+
+}tb_strsearch_mode_e;
+
+/*! the precompiled needle ref type
+ *
+ * the factorization and the shift tables of the needle are computed only once,
+ * so it's faster for searching the same needle in many haystacks, e.g. the http header names.
+ *
+ * the search is linear in the worst case (two-way), and the short needle is filtered by the first and last bytes with simd.
+ */
+typedef __tb_typeref__(strsearch);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the precompiled needle
+ *
+ * @param needle        the needle, it will be copied
+ * @param size          the needle size
+ * @param mode          the search mode, e.g. TB_STRSEARCH_MODE_ICASE
+ *
+ * @return              the needle
+ */
+tb_strsearch_ref_t      tb_strsearch_init(tb_char_t const* needle, tb_size_t size, tb_size_t mode);
+
+/*! exit the precompiled needle
+ *
+ * @param search        the needle
+ */
+tb_void_t               tb_strsearch_exit(tb_strsearch_ref_t search);
+
+/*! find the first occurrence of the needle
+ *
+ * @param search        the needle
+ * @param data          the haystack
+ * @param size          the haystack size
+ *
+ * @return              the matched offset, -1: not found
+ */
+tb_long_t               tb_strsearch_find(tb_strsearch_ref_t search, tb_char_t const* data, tb_size_t size);
+
+/*! find the last occurrence of the needle
+ *
+ * @param search        the needle
+ * @param data          the haystack
+ * @param size          the haystack size
+ *
+ * @return              the matched offset, -1: not found
+ */
+tb_long_t               tb_strsearch_rfind(tb_strsearch_ref_t search, tb_char_t const* data, tb_size_t size);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "impl/strsearch.h"
 #ifdef TB_CONFIG_LIBC_HAVE_WCSCASESTR
 #   include <wchar.h>
 #endif
@@ -44,28 +45,8 @@ tb_wchar_t* tb_wcsistr(tb_wchar_t const* s1, tb_wchar_t const* s2)
     // check
     tb_assert_and_check_return_val(s1 && s2, tb_null);
 
-    // init
-    __tb_register__ tb_wchar_t const* s = s1;
-    __tb_register__ tb_wchar_t const* p = s2;
-
-    // done
-    do 
-    {
-        if (!*p) return (tb_wchar_t* )s1;
-        if ((*p == *s)  || (tb_tolower(*p) == tb_tolower(*s))) 
-        {
-            ++p;
-            ++s;
-        } 
-        else 
-        {
-            p = s2;
-            if (!*s) return tb_null;
-            s = ++s1;
-        }
-
-    } while (1);
-    return tb_null;
+    // find it
+    tb_long_t pos = tb_wcssearch_find_impl(s1, tb_wcslen(s1), s2, tb_wcslen(s2), tb_true);
+    return pos >= 0? (tb_wchar_t*)s1 + pos : tb_null;
 }
 #endif
-
@@ -24,14 +24,17 @@
  * includes
  */
 #include "string.h"
+#include "impl/strsearch.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces 
  */
-
 tb_wchar_t* tb_wcsnirstr(tb_wchar_t const* s1, tb_size_t n, tb_wchar_t const* s2)
 {
-    tb_assert_and_check_return_val(s1, tb_null);
-    tb_trace_noimpl();
-    return tb_null;
+    // check
+    tb_assert_and_check_return_val(s1 && s2, tb_null);
+
+    // find the last one
+    tb_long_t pos = tb_wcssearch_rfind_impl(s1, tb_wcsnlen(s1, n), s2, tb_wcslen(s2), tb_true);
+    return pos >= 0? (tb_wchar_t*)s1 + pos : tb_null;
 }
@@ -24,6 +24,7 @@
  * includes
  */
 #include "string.h"
+#include "impl/strsearch.h"
 #ifdef TB_CONFIG_LIBC_HAVE_WCSSTR
 #   include <wchar.h>
 #endif
@@ -41,28 +42,11 @@ tb_wchar_t* tb_wcsstr(tb_wchar_t const* s1, tb_wchar_t const* s2)
 #else
 tb_wchar_t* tb_wcsstr(tb_wchar_t const* s1, tb_wchar_t const* s2)
 {
+    // check
     tb_assert_and_check_return_val(s1 && s2, tb_null);
 
-    __tb_register__ tb_wchar_t const* s = s1;
-    __tb_register__ tb_wchar_t const* p = s2;
-
-    do 
-    {
-        if (!*p) return (tb_wchar_t *)s1;
-        if (*p == *s) 
-        {
-            ++p;
-            ++s;
-        } 
-        else 
-        {
-            p = s2;
-            if (!*s) return tb_null;
-            s = ++s1;
-        }
-
-    } while (1);
-
-    return tb_null;
+    // find it
+    tb_long_t pos = tb_wcssearch_find_impl(s1, tb_wcslen(s1), s2, tb_wcslen(s2), tb_false);
+    return pos >= 0? (tb_wchar_t*)s1 + pos : tb_null;
 }
 #endif
@@ -34,11 +34,71 @@
 #include "large_allocator.h"
 #include "default_allocator.h"
 #include "impl/prefix.h"
+#include "../platform/impl/thread_local.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// enable the thread cache? 
+#if defined(__tb_thread_local__) && !defined(TB_CONFIG_MICRO_ENABLE)
+#   define TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+#endif
+
+// the cache bin count, one bin for each fixed pool of the small allocator
+#define TB_DEFAULT_ALLOCATOR_CACHE_BINN             (12)
+
+// the cache item maximum count of each bin
+#ifdef __tb_small__
+#   define TB_DEFAULT_ALLOCATOR_CACHE_ITEM_MAXN     (16)
+#else
+#   define TB_DEFAULT_ALLOCATOR_CACHE_ITEM_MAXN     (32)
+#endif
+
+// the cache data maximum size of each bin
+#define TB_DEFAULT_ALLOCATOR_CACHE_DATA_MAXN        (8192)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+// the default allocator cache bin type
+typedef struct __tb_default_allocator_cache_bin_t
+{
+    // the item count
+    tb_size_t                           size;
+
+    // the item maximum count
+    tb_size_t                           maxn;
+
+    // the data space of the fixed pool
+    tb_size_t                           space;
+
+    // the cached items
+    tb_pointer_t                        items[TB_DEFAULT_ALLOCATOR_CACHE_ITEM_MAXN];
+
+}tb_default_allocator_cache_bin_t;
+
+/* the default allocator cache type
+ *
+ * each thread owns a cache (magazine) for the small data, 
+ * so we can malloc and free them without any locks, and only move batches from/to the small allocator.
+ */
+typedef struct __tb_default_allocator_cache_t
+{
+    // the list entry
+    tb_list_entry_t                     entry;
+
+    // the allocator
+    struct __tb_default_allocator_t*    allocator;
+
+    // the bins
+    tb_default_allocator_cache_bin_t    bins[TB_DEFAULT_ALLOCATOR_CACHE_BINN];
+
+}tb_default_allocator_cache_t;
+#endif
+
 // the default allocator type
 typedef struct __tb_default_allocator_t
 {
@@ -51,17 +111,267 @@ typedef struct __tb_default_allocator_t
     // the small allocator
     tb_allocator_ref_t      small_allocator;
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // enable the thread caches?
+    tb_bool_t               cache_enabled;
+
+    // the thread caches, be protected by the base lock
+    tb_list_entry_head_t    caches;
+#endif
+
 }tb_default_allocator_t, *tb_default_allocator_ref_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+__tb_extern_c__ tb_size_t   tb_small_allocator_index_(tb_size_t size, tb_size_t* pspace);
+__tb_extern_c__ tb_size_t   tb_small_allocator_malloc_list_(tb_allocator_ref_t self, tb_size_t space, tb_pointer_t* list, tb_size_t count __tb_debug_decl__);
+__tb_extern_c__ tb_void_t   tb_small_allocator_free_list_(tb_allocator_ref_t self, tb_size_t space, tb_pointer_t const* list, tb_size_t count __tb_debug_decl__);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+
+// the cache of the current thread
+static __tb_thread_local__ tb_default_allocator_cache_t*    g_cache = tb_null;
+
+// the cache of the current thread has been exited? we cannot make it again
+static __tb_thread_local__ tb_bool_t                        g_cache_dead = tb_false;
+
+// the thread local for exiting the cache when the thread is exited
+static tb_thread_local_t                                    g_cache_local = TB_THREAD_LOCAL_INIT;
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+static tb_default_allocator_cache_bin_t* tb_default_allocator_cache_bin(tb_default_allocator_cache_t* cache, tb_size_t size)
+{
+    // the bin
+    tb_size_t space = 0;
+    tb_size_t index = tb_small_allocator_index_(size, &space);
+    tb_assert(index < tb_arrayn(cache->bins));
+    tb_default_allocator_cache_bin_t* bin = &cache->bins[index];
+
+    // init bin, we cache less items for the larger space
+    if (!bin->maxn)
+    {
+        bin->space  = space;
+        bin->maxn   = tb_min(TB_DEFAULT_ALLOCATOR_CACHE_ITEM_MAXN, TB_DEFAULT_ALLOCATOR_CACHE_DATA_MAXN / space);
+        if (bin->maxn < 2) bin->maxn = 2;
+    }
+    return bin;
+}
+static tb_void_t tb_default_allocator_cache_clear(tb_default_allocator_cache_t* cache __tb_debug_decl__)
+{
+    // check
+    tb_default_allocator_ref_t allocator = cache->allocator;
+    tb_assert_and_check_return(allocator && allocator->small_allocator);
+
+    // return all cached items to the small allocator
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(cache->bins); i++)
+    {
+        tb_default_allocator_cache_bin_t* bin = &cache->bins[i];
+        if (bin->size) tb_small_allocator_free_list_(allocator->small_allocator, bin->space, bin->items, bin->size __tb_debug_args__);
+        bin->size = 0;
+    }
+}
+static tb_void_t tb_default_allocator_cache_exit(tb_default_allocator_cache_t* cache)
+{
+    // check
+    tb_default_allocator_ref_t allocator = cache->allocator;
+    tb_assert_and_check_return(allocator && allocator->large_allocator);
+
+    // remove it from the allocator
+    tb_spinlock_enter(&allocator->base.lock);
+    tb_list_entry_remove(&allocator->caches, &cache->entry);
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // clear it
+    tb_default_allocator_cache_clear(cache __tb_debug_vals__);
+
+    // exit it
+    tb_allocator_large_free(allocator->large_allocator, cache);
+}
+static tb_void_t tb_default_allocator_cache_exit_all(tb_default_allocator_ref_t allocator)
+{
+    // check
+    tb_assert_and_check_return(allocator && allocator->large_allocator);
+
+    // the cache of the current thread will be exited
+    if (g_cache && g_cache->allocator == allocator) g_cache = tb_null;
+
+    // exit all caches, we need ensure the other threads have been exited
+    tb_spinlock_enter(&allocator->base.lock);
+    while (tb_list_entry_size(&allocator->caches))
+    {
+        // remove the head cache
+        tb_default_allocator_cache_t* cache = (tb_default_allocator_cache_t*)tb_list_entry_head(&allocator->caches);
+        tb_list_entry_remove_head(&allocator->caches);
+
+        // exit it
+        tb_default_allocator_cache_clear(cache __tb_debug_vals__);
+        tb_allocator_large_free(allocator->large_allocator, cache);
+    }
+    tb_spinlock_leave(&allocator->base.lock);
+}
+static tb_void_t tb_default_allocator_cache_local_free(tb_cpointer_t priv)
+{
+    /* exit the cache of the current thread
+     *
+     * @note the thread local data will not be cleared after calling it, 
+     * so we only exit the current cache, and we cannot make the new cache on this thread
+     */
+    tb_default_allocator_cache_t* cache = (tb_default_allocator_cache_t*)priv;
+    if (cache && cache == g_cache)
+    {
+        g_cache = tb_null;
+        g_cache_dead = tb_true;
+        tb_default_allocator_cache_exit(cache);
+    }
+}
+static tb_default_allocator_cache_t* tb_default_allocator_cache_init(tb_default_allocator_ref_t allocator)
+{
+    // we can make cache only after initializing the thread local envirnoment
+    tb_check_return_val(tb_thread_local_env_ready(), tb_null);
+
+    // init the thread local
+    if (!tb_thread_local_init(&g_cache_local, tb_default_allocator_cache_local_free)) 
+    {
+        g_cache_dead = tb_true;
+        return tb_null;
+    }
+
+    // make cache
+    tb_default_allocator_cache_t* cache = (tb_default_allocator_cache_t*)tb_allocator_large_malloc0(allocator->large_allocator, sizeof(tb_default_allocator_cache_t), tb_null);
+    tb_assert_and_check_return_val(cache, tb_null);
+
+    // add it to the allocator
+    cache->allocator = allocator;
+    tb_spinlock_enter(&allocator->base.lock);
+    tb_list_entry_insert_tail(&allocator->caches, &cache->entry);
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // bind it to the current thread
+    if (!tb_thread_local_set(&g_cache_local, cache))
+    {
+        g_cache_dead = tb_true;
+        tb_default_allocator_cache_exit(cache);
+        return tb_null;
+    }
+    g_cache = cache;
+
+    // trace
+    tb_trace_d("cache: init %p for thread: %lu", cache, tb_thread_self());
+
+    // ok
+    return cache;
+}
+static __tb_inline__ tb_default_allocator_cache_t* tb_default_allocator_cache(tb_default_allocator_ref_t allocator)
+{
+    // get the cache of the current thread
+    tb_default_allocator_cache_t* cache = g_cache;
+    if (cache) return cache->allocator == allocator? cache : tb_null;
+
+    // make a new cache
+    return (allocator->cache_enabled && !g_cache_dead)? tb_default_allocator_cache_init(allocator) : tb_null;
+}
+static tb_pointer_t tb_default_allocator_cache_malloc(tb_default_allocator_ref_t allocator, tb_default_allocator_cache_t* cache, tb_size_t size __tb_debug_decl__)
+{
+    // the bin
+    tb_default_allocator_cache_bin_t* bin = tb_default_allocator_cache_bin(cache, size);
+
+    // no cached items? grab a batch from the small allocator
+    if (!bin->size)
+    {
+        bin->size = tb_small_allocator_malloc_list_(allocator->small_allocator, bin->space, bin->items, bin->maxn >> 1 __tb_debug_args__);
+        tb_check_return_val(bin->size, tb_null);
+    }
+
+    // get data
+    tb_pointer_t data = bin->items[--bin->size];
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assert(data_head->debug.magic == TB_POOL_DATA_MAGIC);
+
+#ifdef __tb_debug__
+    // update the debug info
+    data_head->debug.file   = file_;
+    data_head->debug.func   = func_;
+    data_head->debug.line   = (tb_uint16_t)line_;
+
+    // save backtrace
+    tb_pool_data_save_backtrace(&data_head->debug, 3);
+
+    // make the dirty data and patch 0xcc for checking underflow
+    tb_memset_(data, TB_POOL_DATA_PATCH, bin->space);
+#endif
+
+    // update size
+    data_head->size = size;
+
+    // ok
+    return data;
+}
+static tb_bool_t tb_default_allocator_cache_free(tb_default_allocator_ref_t allocator, tb_default_allocator_cache_t* cache, tb_pointer_t data __tb_debug_decl__)
+{
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+
+    // the bin
+    tb_default_allocator_cache_bin_t* bin = tb_default_allocator_cache_bin(cache, data_head->size);
+
+    // check underflow
+    tb_assertf(bin->space == data_head->size || ((tb_byte_t*)data)[data_head->size] == TB_POOL_DATA_PATCH, "data underflow");
+
+#ifdef __tb_debug__
+    // check double free
+    tb_size_t i = 0;
+    for (i = 0; i < bin->size; i++)
+    {
+        if (bin->items[i] == data)
+        {
+            // trace
+            tb_trace_e("double free(%p) at %s(): %lu, %s", data, func_, line_, file_);
+
+            // dump data
+            tb_pool_data_dump((tb_byte_t const*)data, tb_true, "[default_allocator]: [error]: ");
+
+            // abort
+            tb_abort();
+        }
+    }
+#endif
+
+    // full? return the older half items to the small allocator
+    if (bin->size >= bin->maxn)
+    {
+        tb_size_t half = bin->maxn >> 1;
+        tb_small_allocator_free_list_(allocator->small_allocator, bin->space, bin->items, half __tb_debug_args__);
+        tb_memmov_(bin->items, bin->items + half, (bin->size - half) * sizeof(tb_pointer_t));
+        bin->size -= half;
+    }
+
+    // cache it
+    bin->items[bin->size++] = data;
+    return tb_true;
+}
+#endif
 static tb_void_t tb_default_allocator_exit(tb_allocator_ref_t self)
 {
     // check
     tb_default_allocator_ref_t allocator = (tb_default_allocator_ref_t)self;
     tb_assert_and_check_return(allocator);
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // exit all thread caches
+    if (allocator->small_allocator) tb_default_allocator_cache_exit_all(allocator);
+#endif
+
     // enter
     tb_spinlock_enter(&allocator->base.lock);
 
@@ -87,9 +397,19 @@ static tb_pointer_t tb_default_allocator_malloc(tb_allocator_ref_t self, tb_size
     // check
     tb_assert_and_check_return_val(allocator->large_allocator && allocator->small_allocator && size, tb_null);
 
-    // done
-    return size <= TB_SMALL_ALLOCATOR_DATA_MAXN? tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__) : tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
+    // large data?
+    if (size > TB_SMALL_ALLOCATOR_DATA_MAXN) return tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
+
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // malloc it from the cache of the current thread
+    tb_default_allocator_cache_t* cache = tb_default_allocator_cache(allocator);
+    if (cache) return tb_default_allocator_cache_malloc(allocator, cache, size __tb_debug_args__);
+#endif
+
+    // malloc it from the small allocator
+    return tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__);
 }
+static tb_bool_t tb_default_allocator_free(tb_allocator_ref_t self, tb_pointer_t data __tb_debug_decl__);
 static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_pointer_t data, tb_size_t size __tb_debug_decl__)
 {
     // check
@@ -107,7 +427,7 @@ static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_poin
         if (!data)
         {
             // malloc it directly
-            data_new = size <= TB_SMALL_ALLOCATOR_DATA_MAXN? tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__) : tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
+            data_new = tb_default_allocator_malloc(self, size __tb_debug_args__);
             break;
         }
 
@@ -116,37 +436,43 @@ static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_poin
         tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "ralloc invalid data: %p", data);
         tb_assert_and_check_break(data_head->size);
 
-        // small => small
+        // large => large
+        if (data_head->size > TB_SMALL_ALLOCATOR_DATA_MAXN && size > TB_SMALL_ALLOCATOR_DATA_MAXN)
+        {
+            data_new = tb_allocator_large_ralloc_(allocator->large_allocator, data, size, tb_null __tb_debug_args__);
+            break;
+        }
+
+        // small => small, and the same space? only update size
         if (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN && size <= TB_SMALL_ALLOCATOR_DATA_MAXN)
-            data_new = tb_allocator_ralloc_(allocator->small_allocator, data, size __tb_debug_args__);
-        // small => large
-        else if (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN)
         {
-            // make the new data
-            data_new = tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
-            tb_assert_and_check_break(data_new);
+            tb_size_t space = 0;
+            if (tb_small_allocator_index_(data_head->size, &space) == tb_small_allocator_index_(size, tb_null))
+            {
+                // check underflow
+                tb_assertf(space == data_head->size || ((tb_byte_t*)data)[data_head->size] == TB_POOL_DATA_PATCH, "data underflow");
 
-            // copy the old data
-            tb_memcpy_(data_new, data, tb_min(data_head->size, size));
+#ifdef __tb_debug__
+                // fill the patch bytes
+                if (space > size) tb_memset_((tb_byte_t*)data + size, TB_POOL_DATA_PATCH, space - size);
+#endif
 
-            // free the old data
-            tb_allocator_free_(allocator->small_allocator, data __tb_debug_args__);
+                // update size
+                data_head->size = size;
+                data_new = data;
+                break;
+            }
         }
-        // large => small
-        else if (size <= TB_SMALL_ALLOCATOR_DATA_MAXN)
-        {
-            // make the new data
-            data_new = tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__);
-            tb_assert_and_check_break(data_new);
 
-            // copy the old data
-            tb_memcpy_(data_new, data, tb_min(data_head->size, size));
+        // make the new data
+        data_new = tb_default_allocator_malloc(self, size __tb_debug_args__);
+        tb_assert_and_check_break(data_new);
 
-            // free the old data
-            tb_allocator_large_free_(allocator->large_allocator, data __tb_debug_args__);
-        }
-        // large => large
-        else data_new = tb_allocator_large_ralloc_(allocator->large_allocator, data, size, tb_null __tb_debug_args__);
+        // copy the old data
+        tb_memcpy_(data_new, data, tb_min(data_head->size, size));
+
+        // free the old data
+        tb_default_allocator_free(self, data __tb_debug_args__);
 
     } while (0);
 
@@ -170,8 +496,25 @@ static tb_bool_t tb_default_allocator_free(tb_allocator_ref_t self, tb_pointer_t
         tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
         tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "free invalid data: %p", data);
 
-        // free it
-        ok = (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN)? tb_allocator_free_(allocator->small_allocator, data __tb_debug_args__) : tb_allocator_large_free_(allocator->large_allocator, data __tb_debug_args__);
+        // large data?
+        if (data_head->size > TB_SMALL_ALLOCATOR_DATA_MAXN)
+        {
+            ok = tb_allocator_large_free_(allocator->large_allocator, data __tb_debug_args__);
+            break;
+        }
+
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+        // free it to the cache of the current thread
+        tb_default_allocator_cache_t* cache = tb_default_allocator_cache(allocator);
+        if (cache) 
+        {
+            ok = tb_default_allocator_cache_free(allocator, cache, data __tb_debug_args__);
+            break;
+        }
+#endif
+
+        // free it to the small allocator
+        ok = tb_allocator_free_(allocator->small_allocator, data __tb_debug_args__);
 
     } while (0);
 
@@ -185,6 +528,11 @@ static tb_void_t tb_default_allocator_dump(tb_allocator_ref_t self)
     tb_default_allocator_ref_t allocator = (tb_default_allocator_ref_t)self;
     tb_assert_and_check_return(allocator && allocator->small_allocator);
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // clear the cache of the current thread, the cached data are not leaked
+    if (g_cache && g_cache->allocator == allocator) tb_default_allocator_cache_clear(g_cache __tb_debug_vals__);
+#endif
+
     // dump allocator
     tb_allocator_dump(allocator->small_allocator);
 }
@@ -237,6 +585,11 @@ static tb_handle_t tb_default_allocator_instance_init(tb_cpointer_t* ppriv)
         allocator = tb_default_allocator_init(large_allocator);
         tb_assert_and_check_break(allocator);
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+        // enable the thread caches for the global allocator
+        ((tb_default_allocator_ref_t)allocator)->cache_enabled = tb_true;
+#endif
+
         // ok
         ok = tb_true;
 
@@ -263,6 +616,11 @@ static tb_void_t tb_default_allocator_instance_exit(tb_handle_t self, tb_cpointe
     tb_allocator_ref_t large_allocator = allocator->large_allocator;
     tb_assert_and_check_return(large_allocator);
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // exit all thread caches first, the cached data are not leaked
+    tb_default_allocator_cache_exit_all(allocator);
+#endif
+
 #ifdef __tb_debug__
     // dump allocator
     if (allocator) tb_allocator_dump((tb_allocator_ref_t)allocator);
@@ -317,7 +675,7 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
 
         // init base
         allocator->base.type            = TB_ALLOCATOR_TYPE_DEFAULT;
-        allocator->base.flag            = TB_ALLOCATOR_FLAG_NONE;
+        allocator->base.flag            = TB_ALLOCATOR_FLAG_NOLOCK;
         allocator->base.malloc          = tb_default_allocator_malloc;
         allocator->base.ralloc          = tb_default_allocator_ralloc;
         allocator->base.free            = tb_default_allocator_free;
@@ -327,9 +685,18 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
         allocator->base.have            = tb_default_allocator_have;
 #endif
 
-        // init lock
+        /* init lock
+         *
+         * the small and large allocators have been locked, 
+         * so we only use it to protect the thread caches
+         */
         if (!tb_spinlock_init(&allocator->base.lock)) break;
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+        // init the thread caches
+        tb_list_entry_init(&allocator->caches, tb_default_allocator_cache_t, entry, tb_null);
+#endif
+
         // init allocator
         allocator->large_allocator = large_allocator;
         allocator->small_allocator = tb_small_allocator_init(large_allocator);
@@ -56,97 +56,113 @@ typedef struct __tb_small_allocator_t
  * declaration
  */
 __tb_extern_c__ tb_fixed_pool_ref_t tb_fixed_pool_init_(tb_allocator_ref_t large_allocator, tb_size_t slot_size, tb_size_t item_size, tb_bool_t for_small_allocator, tb_fixed_pool_item_init_func_t item_init, tb_fixed_pool_item_exit_func_t item_exit, tb_cpointer_t priv);
+__tb_extern_c__ tb_size_t           tb_small_allocator_index_(tb_size_t size, tb_size_t* pspace);
+__tb_extern_c__ tb_size_t           tb_small_allocator_malloc_list_(tb_allocator_ref_t self, tb_size_t space, tb_pointer_t* list, tb_size_t count __tb_debug_decl__);
+__tb_extern_c__ tb_void_t           tb_small_allocator_free_list_(tb_allocator_ref_t self, tb_size_t space, tb_pointer_t const* list, tb_size_t count __tb_debug_decl__);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_fixed_pool_ref_t tb_small_allocator_find_fixed(tb_small_allocator_ref_t allocator, tb_size_t size)
+static tb_size_t tb_small_allocator_index(tb_size_t size, tb_size_t* pspace)
 {
     // check
-    tb_assert(allocator && size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
+    tb_assert(size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
 
-    // done
-    tb_fixed_pool_ref_t fixed_pool = tb_null;
-    do
+    // the fixed pool index
+    tb_size_t index = 0;
+    tb_size_t space = 0;
+    if (size > 64 && size < 193)
     {
-        // the fixed pool index
-        tb_size_t index = 0;
-        tb_size_t space = 0;
-        if (size > 64 && size < 193)
+        if (size < 97)
+        {
+            index = 3;
+            space = 96;
+        }
+        else if (size > 128)
+        {
+            index = 5;
+            space = 192;
+        }
+        else 
+        {
+            index = 4;
+            space = 128;
+        }
+    }
+    else if (size > 192 && size < 513)
+    {
+        if (size < 257)
+        {
+            index = 6;
+            space = 256;
+        }
+        else if (size > 384)
+        {
+            index = 8;
+            space = 512;
+        }
+        else 
+        {
+            index = 7;
+            space = 384;
+        }
+    }
+    else if (size < 65)
+    {
+        if (size < 17)
+        {
+            index = 0;
+            space = 16;
+        }
+        else if (size > 32)
+        {
+            index = 2;
+            space = 64;
+        }
+        else 
         {
-            if (size < 97)
-            {
-                index = 3;
-                space = 96;
-            }
-            else if (size > 128)
-            {
-                index = 5;
-                space = 192;
-            }
-            else 
-            {
-                index = 4;
-                space = 128;
-            }
+            index = 1;
+            space = 32;
         }
-        else if (size > 192 && size < 513)
+    }
+    else 
+    {
+        if (size < 1025)
         {
-            if (size < 257)
-            {
-                index = 6;
-                space = 256;
-            }
-            else if (size > 384)
-            {
-                index = 8;
-                space = 512;
-            }
-            else 
-            {
-                index = 7;
-                space = 384;
-            }
+            index = 9;
+            space = 1024;
         }
-        else if (size < 65)
+        else if (size > 2048)
         {
-            if (size < 17)
-            {
-                index = 0;
-                space = 16;
-            }
-            else if (size > 32)
-            {
-                index = 2;
-                space = 64;
-            }
-            else 
-            {
-                index = 1;
-                space = 32;
-            }
+            index = 11;
+            space = 3072;
         }
         else 
         {
-            if (size < 1025)
-            {
-                index = 9;
-                space = 1024;
-            }
-            else if (size > 2048)
-            {
-                index = 11;
-                space = 3072;
-            }
-            else 
-            {
-                index = 10;
-                space = 2048;
-            }
+            index = 10;
+            space = 2048;
         }
+    }
 
-        // trace
-        tb_trace_d("find: size: %lu => index: %lu, space: %lu", size, index, space);
+    // trace
+    tb_trace_d("index: size: %lu => index: %lu, space: %lu", size, index, space);
+
+    // save the space
+    if (pspace) *pspace = space;
+    return index;
+}
+static tb_fixed_pool_ref_t tb_small_allocator_find_fixed(tb_small_allocator_ref_t allocator, tb_size_t size)
+{
+    // check
+    tb_assert(allocator && size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
+
+    // done
+    tb_fixed_pool_ref_t fixed_pool = tb_null;
+    do
+    {
+        // the fixed pool index
+        tb_size_t space = 0;
+        tb_size_t index = tb_small_allocator_index(size, &space);
 
         // make fixed pool if not exists
         if (!allocator->fixed_pool[index]) allocator->fixed_pool[index] = tb_fixed_pool_init_(allocator->large_allocator, 0, space, tb_true, tb_null, tb_null, tb_null);
@@ -466,4 +482,78 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
     // ok?
     return (tb_allocator_ref_t)allocator;
 }
+tb_size_t tb_small_allocator_index_(tb_size_t size, tb_size_t* pspace)
+{
+    return tb_small_allocator_index(size, pspace);
+}
+tb_size_t tb_small_allocator_malloc_list_(tb_allocator_ref_t self, tb_size_t space, tb_pointer_t* list, tb_size_t count __tb_debug_decl__)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator && list && count, 0);
 
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
+    // done
+    tb_size_t real = 0;
+    do
+    {
+        // the fixed pool
+        tb_fixed_pool_ref_t fixed_pool = tb_small_allocator_find_fixed(allocator, space);
+        tb_assert_and_check_break(fixed_pool && tb_fixed_pool_item_size(fixed_pool) == space);
+
+        // make data list
+        for (real = 0; real < count; real++)
+        {
+            // make data
+            tb_pointer_t data = tb_fixed_pool_malloc_(fixed_pool __tb_debug_args__);
+            tb_check_break(data);
+
+            // the data head
+            tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+            tb_assert(data_head->debug.magic == TB_POOL_DATA_MAGIC);
+
+            // use the whole space, the real size will be updated when it is used
+            data_head->size = space;
+
+            // save it
+            list[real] = data;
+        }
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // ok?
+    return real;
+}
+tb_void_t tb_small_allocator_free_list_(tb_allocator_ref_t self, tb_size_t space, tb_pointer_t const* list, tb_size_t count __tb_debug_decl__)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->large_allocator && list);
+
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
+    // the fixed pool
+    tb_fixed_pool_ref_t fixed_pool = tb_small_allocator_find_fixed(allocator, space);
+    tb_assert(fixed_pool && tb_fixed_pool_item_size(fixed_pool) == space);
+
+    // free data list
+    tb_size_t i = 0;
+    for (i = 0; fixed_pool && i < count; i++)
+    {
+        // free it
+        if (!tb_fixed_pool_free_(fixed_pool, list[i] __tb_debug_args__))
+        {
+            // trace
+            tb_trace_e("free(%p) failed!", list[i]);
+        }
+    }
+
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
+}
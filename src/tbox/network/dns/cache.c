@@ -20,6 +20,7 @@
  *
  */
 
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * trace
  */
@@ -32,57 +33,92 @@
 #include "cache.h"
 #include "../../platform/platform.h"
 #include "../../container/container.h"
-#include "../../algorithm/algorithm.h"
+#include "../../hash/fnv32.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
 
-// the cache maxn
+// the cache shard count, must be pow2
 #ifdef __tb_small__
-#   define TB_DNS_CACHE_MAXN        (64)
+#   define TB_DNS_CACHE_SHARDN      (4)
 #else
+#   define TB_DNS_CACHE_SHARDN      (16)
+#endif
+
+// the default cache maxn
+#ifdef __tb_small__
 #   define TB_DNS_CACHE_MAXN        (256)
+#else
+#   define TB_DNS_CACHE_MAXN        (8192)
 #endif
 
+// the minimum ttl (s)
+#define TB_DNS_CACHE_TTL_MIN        (30)
+
+// the maximum ttl (s)
+#define TB_DNS_CACHE_TTL_MAX        (86400)
+
+// the default ttl (s)
+#define TB_DNS_CACHE_TTL_DEFAULT    (600)
+
+// the default ttl of the failed result (s)
+#define TB_DNS_CACHE_TTL_FAILED     (60)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
-// the dns cache type
-typedef struct __tb_dns_cache_t
+// the dns cache entry type
+typedef struct __tb_dns_cache_entry_t
 {
-    // the hash
-    tb_hash_map_ref_t       hash;
+    // the list entry for lru
+    tb_list_entry_t         entry;
 
-    // the times
-    tb_hize_t               times;
-
-    // the expired
+    // the expired time (s)
     tb_size_t               expired;
 
-}tb_dns_cache_t;
+    // the host name
+    tb_char_t const*        name;
+
+    // the addresses
+    tb_ipaddr_ref_t         list;
+
+    // the addresses count, it's the failed result if be zero
+    tb_uint16_t             size;
+
+    // the next address index for round-robin
+    tb_uint16_t             next;
+
+}tb_dns_cache_entry_t;
 
-// the dns cache addr type
-typedef struct __tb_dns_cache_addr_t
+/* the dns cache shard type
+ *
+ * the host names are dispatched to the different shards with their own locks, 
+ * so the concurrent lookups will not contend for a global lock.
+ */
+typedef struct __tb_dns_cache_shard_t
 {
-    // the addr
-    tb_ipaddr_t             addr;
+    // the lock
+    tb_spinlock_t           lock;
 
-    // the time
-    tb_size_t               time;
+    // the hash map, name => entry
+    tb_hash_map_ref_t       hash;
 
-}tb_dns_cache_addr_t;
+    // the lru list, the recently used entry is at head
+    tb_list_entry_head_t    lru;
+
+}tb_dns_cache_shard_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
 
-// the lock
-static tb_spinlock_t        g_lock = TB_SPINLOCK_INIT;
+// the cache shards
+static tb_dns_cache_shard_t g_shards[TB_DNS_CACHE_SHARDN];
 
-// the cache
-static tb_dns_cache_t       g_cache = {0};
+// the cache maxn
+static tb_atomic_t          g_maxn = TB_DNS_CACHE_MAXN;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * helper
@@ -91,57 +127,231 @@ static __tb_inline__ tb_size_t tb_dns_cache_now()
 {
     return (tb_size_t)(tb_cache_time_spak() / 1000);
 }
-static tb_bool_t tb_dns_cache_clear(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+static __tb_inline__ tb_size_t tb_dns_cache_ttl(tb_size_t ttl, tb_size_t ttl_default)
+{
+    // use the default ttl
+    if (!ttl) ttl = ttl_default;
+
+    // limit ttl
+    if (ttl < TB_DNS_CACHE_TTL_MIN) ttl = TB_DNS_CACHE_TTL_MIN;
+    if (ttl > TB_DNS_CACHE_TTL_MAX) ttl = TB_DNS_CACHE_TTL_MAX;
+    return ttl;
+}
+static tb_bool_t tb_dns_cache_name(tb_char_t const* name, tb_char_t* data, tb_size_t maxn)
+{
+    // the host name is case-insensitive, so we use the lower name as key
+    tb_size_t i = 0;
+    for (i = 0; name[i] && i < maxn; i++) data[i] = tb_tolower(name[i]);
+
+    // too long?
+    tb_check_return_val(i < maxn && i, tb_false);
+
+    // end
+    data[i] = '\0';
+    return tb_true;
+}
+static __tb_inline__ tb_dns_cache_shard_t* tb_dns_cache_shard(tb_char_t const* name)
+{
+    // uses the different hash function with the hash map to dispatch names
+    return &g_shards[tb_fnv32_1a_make_from_cstr(name, 0) & (TB_DNS_CACHE_SHARDN - 1)];
+}
+static tb_void_t tb_dns_cache_entry_free(tb_element_ref_t element, tb_pointer_t buff)
 {
     // check
-    tb_assert(item);
+    tb_assert_and_check_return(element && buff);
 
-    // the dns cache address
-    tb_dns_cache_addr_t const* caddr = (tb_dns_cache_addr_t const*)((tb_hash_map_item_ref_t)item)->data;
-    tb_assert(caddr);
+    // the shard
+    tb_dns_cache_shard_t* shard = (tb_dns_cache_shard_t*)element->priv;
+    tb_assert_and_check_return(shard);
 
-    // is expired?
+    // the entry
+    tb_dns_cache_entry_t* entry = *((tb_dns_cache_entry_t**)buff);
+    if (entry)
+    {
+        // trace
+        tb_trace_d("del: %s, size: %u", entry->name, entry->size);
+
+        // remove it from the lru list
+        tb_list_entry_remove(&shard->lru, &entry->entry);
+
+        // exit it
+        tb_free(entry);
+    }
+
+    // clear it
+    *((tb_dns_cache_entry_t**)buff) = tb_null;
+}
+static tb_dns_cache_entry_t* tb_dns_cache_entry_init(tb_char_t const* name, tb_ipaddr_ref_t list, tb_size_t size, tb_size_t ttl)
+{
+    // check
+    tb_assert_and_check_return_val(name, tb_null);
+
+    // make entry with the addresses and name
+    tb_size_t               namesize = tb_strlen(name) + 1;
+    tb_dns_cache_entry_t*   entry = (tb_dns_cache_entry_t*)tb_malloc(sizeof(tb_dns_cache_entry_t) + size * sizeof(tb_ipaddr_t) + namesize);
+    tb_assert_and_check_return_val(entry, tb_null);
+
+    // init addresses
+    entry->list = (tb_ipaddr_ref_t)&entry[1];
+    entry->size = (tb_uint16_t)size;
+    entry->next = 0;
+    if (size) tb_memcpy(entry->list, list, size * sizeof(tb_ipaddr_t));
+
+    // init name
+    entry->name = (tb_char_t const*)(entry->list + size);
+    tb_memcpy((tb_char_t*)entry->name, name, namesize);
+
+    // init expired time
+    entry->expired = tb_dns_cache_now() + ttl;
+    return entry;
+}
+static tb_void_t tb_dns_cache_save(tb_char_t const* name, tb_ipaddr_ref_t list, tb_size_t size, tb_size_t ttl)
+{
+    // check
+    tb_assert_and_check_return(name);
+
+    // the lower name
+    tb_char_t key[TB_DNS_NAME_MAXN];
+    tb_check_return(tb_dns_cache_name(name, key, sizeof(key)));
+
+    // init entry
+    tb_dns_cache_entry_t* entry = tb_dns_cache_entry_init(key, list, size, ttl);
+    tb_assert_and_check_return(entry);
+
+    // the shard maxn
+    tb_size_t maxn = (tb_size_t)tb_atomic_get(&g_maxn) / TB_DNS_CACHE_SHARDN;
+    if (!maxn) maxn = 1;
+
+    // enter
+    tb_dns_cache_shard_t* shard = tb_dns_cache_shard(key);
+    tb_spinlock_enter(&shard->lock);
+
+    // done
     tb_bool_t ok = tb_false;
-    if (caddr->time < g_cache.expired)
+    do
     {
-        // remove it
-        ok = tb_true;
+        // check
+        tb_assert_and_check_break(shard->hash);
+
+        // remove the least recently used entries if full
+        while (!tb_hash_map_get(shard->hash, key) && tb_hash_map_size(shard->hash) >= maxn)
+        {
+            // the last entry
+            tb_list_entry_ref_t last = tb_list_entry_last(&shard->lru);
+            tb_assert_and_check_break(last);
+
+            // remove it
+            tb_hash_map_remove(shard->hash, ((tb_dns_cache_entry_t*)tb_list_entry(&shard->lru, last))->name);
+        }
+
+        // save entry, it will replace and free the old entry
+        if (!tb_hash_map_insert(shard->hash, key, entry)) break;
+
+        // insert it to the lru list head
+        tb_list_entry_insert_head(&shard->lru, &entry->entry);
 
         // trace
-        tb_trace_d("del: %s => %{ipaddr}, time: %u, size: %u", (tb_char_t const*)item->name, &caddr->addr, caddr->time, tb_hash_map_size(g_cache.hash));
+        tb_trace_d("set: %s, size: %lu, ttl: %lu, count: %lu", key, size, ttl, tb_hash_map_size(shard->hash));
 
-        // update times
-        tb_assert(g_cache.times >= caddr->time);
-        g_cache.times -= caddr->time;
-    }
+        // ok
+        ok = tb_true;
 
-    // ok?
-    return ok;
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&shard->lock);
+
+    // failed? exit entry
+    if (!ok) tb_free(entry);
 }
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+/* find the cache entry
+ *
+ * @param key       the lower host name
+ * @param addr      save the next address by round-robin if it is not null
+ *
+ * @return          1: ok, 0: not found, -1: the cached failed result
  */
-tb_bool_t tb_dns_cache_init()
+static tb_long_t tb_dns_cache_find(tb_char_t const* key, tb_ipaddr_ref_t addr)
 {
     // enter
-    tb_spinlock_enter(&g_lock);
+    tb_dns_cache_shard_t* shard = tb_dns_cache_shard(key);
+    tb_spinlock_enter(&shard->lock);
 
     // done
-    tb_bool_t ok = tb_false;
+    tb_long_t ok = 0;
     do
     {
-        // init hash
-        if (!g_cache.hash) g_cache.hash = tb_hash_map_init(tb_align8(tb_isqrti(TB_DNS_CACHE_MAXN) + 1), tb_element_str(tb_false), tb_element_mem(sizeof(tb_dns_cache_addr_t), tb_null, tb_null));
-        tb_assert_and_check_break(g_cache.hash);
+        // check
+        tb_assert_and_check_break(shard->hash);
+
+        // get the cache entry
+        tb_dns_cache_entry_t* entry = (tb_dns_cache_entry_t*)tb_hash_map_get(shard->hash, key);
+        tb_check_break(entry);
+
+        // expired? remove it
+        if (tb_dns_cache_now() >= entry->expired)
+        {
+            tb_hash_map_remove(shard->hash, key);
+            break;
+        }
+
+        // move it to the lru list head
+        tb_list_entry_moveto_head(&shard->lru, &entry->entry);
+
+        // the failed result?
+        if (!entry->size)
+        {
+            ok = -1;
+            break;
+        }
+
+        // save the next address by round-robin
+        tb_check_break_state(addr, ok, 1);
+        tb_ipaddr_copy(addr, &entry->list[entry->next]);
+        entry->next = (tb_uint16_t)((entry->next + 1) % entry->size);
+
+        // trace
+        tb_trace_d("get: %s => %{ipaddr}, size: %u", key, addr, entry->size);
 
         // ok
-        ok = tb_true;
+        ok = 1;
 
     } while (0);
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave(&shard->lock);
+
+    // ok?
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_dns_cache_init()
+{
+    // done
+    tb_bool_t ok = tb_true;
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DNS_CACHE_SHARDN && ok; i++)
+    {
+        // the shard
+        tb_dns_cache_shard_t* shard = &g_shards[i];
+
+        // enter
+        tb_spinlock_enter(&shard->lock);
+
+        // init lru list
+        if (!shard->hash) tb_list_entry_init(&shard->lru, tb_dns_cache_entry_t, entry, tb_null);
+
+        // init hash
+        if (!shard->hash) shard->hash = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_ptr(tb_dns_cache_entry_free, shard));
+        if (!shard->hash) ok = tb_false;
+
+        // leave
+        tb_spinlock_leave(&shard->lock);
+    }
 
     // failed? exit it
     if (!ok) tb_dns_cache_exit();
@@ -151,21 +361,34 @@ tb_bool_t tb_dns_cache_init()
 }
 tb_void_t tb_dns_cache_exit()
 {
-    // enter
-    tb_spinlock_enter(&g_lock);
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DNS_CACHE_SHARDN; i++)
+    {
+        // the shard
+        tb_dns_cache_shard_t* shard = &g_shards[i];
 
-    // exit hash
-    if (g_cache.hash) tb_hash_map_exit(g_cache.hash);
-    g_cache.hash = tb_null;
+        // enter
+        tb_spinlock_enter(&shard->lock);
 
-    // exit times
-    g_cache.times = 0;
+        // exit hash and all entries
+        if (shard->hash) 
+        {
+            tb_hash_map_exit(shard->hash);
+            tb_list_entry_exit(&shard->lru);
+        }
+        shard->hash = tb_null;
 
-    // exit expired 
-    g_cache.expired = 0;
+        // leave
+        tb_spinlock_leave(&shard->lock);
+    }
+}
+tb_void_t tb_dns_cache_maxn_set(tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return(maxn);
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+    // set the cache maxn, the overflow entries will be removed when setting the new entries
+    tb_atomic_set(&g_maxn, (tb_long_t)maxn);
 }
 tb_bool_t tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr)
 {
@@ -191,42 +414,24 @@ tb_bool_t tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr)
     // clear address
     tb_ipaddr_clear(addr);
 
-    // enter
-    tb_spinlock_enter(&g_lock);
-
-    // done
-    tb_bool_t ok = tb_false;
-    do
-    {
-        // check
-        tb_assert_and_check_break(g_cache.hash);
-
-        // get the host address
-        tb_dns_cache_addr_t* caddr = (tb_dns_cache_addr_t*)tb_hash_map_get(g_cache.hash, name);
-        tb_check_break(caddr);
-
-        // trace
-        tb_trace_d("get: %s => %{ipaddr}, time: %u => %u, size: %u", name, &caddr->addr, caddr->time, tb_dns_cache_now(), tb_hash_map_size(g_cache.hash));
-
-        // update time
-        tb_assert_and_check_break(g_cache.times >= caddr->time);
-        g_cache.times -= caddr->time;
-        caddr->time = tb_dns_cache_now();
-        g_cache.times += caddr->time;
+    // the lower name
+    tb_char_t key[TB_DNS_NAME_MAXN];
+    tb_check_return_val(tb_dns_cache_name(name, key, sizeof(key)), tb_false);
 
-        // save address
-        tb_ipaddr_copy(addr, &caddr->addr);
-
-        // ok
-        ok = tb_true;
-
-    } while (0);
+    // find it
+    return tb_dns_cache_find(key, addr) > 0;
+}
+tb_bool_t tb_dns_cache_get_failed(tb_char_t const* name)
+{
+    // check
+    tb_assert_and_check_return_val(name, tb_false);
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+    // the lower name
+    tb_char_t key[TB_DNS_NAME_MAXN];
+    tb_check_return_val(tb_dns_cache_name(name, key, sizeof(key)), tb_false);
 
-    // ok?
-    return ok;
+    // is the cached failed result?
+    return tb_dns_cache_find(key, tb_null) < 0;
 }
 tb_void_t tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr)
 {
@@ -236,53 +441,22 @@ tb_void_t tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr)
     // check address
     tb_assert(!tb_ipaddr_ip_is_empty(addr));
 
-    // trace
-    tb_trace_d("set: %s => %{ipaddr}", name, addr);
-
-    // init addr
-    tb_dns_cache_addr_t caddr;
-    caddr.time = tb_dns_cache_now();
-    tb_ipaddr_copy(&caddr.addr, addr);
-
-    // enter
-    tb_spinlock_enter(&g_lock);
-
-    // done
-    do
-    {
-        // check
-        tb_assert_and_check_break(g_cache.hash);
-
-        // remove the expired items if full
-        if (tb_hash_map_size(g_cache.hash) >= TB_DNS_CACHE_MAXN)
-        {
-            // the expired time
-            g_cache.expired = ((tb_size_t)(g_cache.times / tb_hash_map_size(g_cache.hash)) + 1);
-
-            // check
-            tb_assert_and_check_break(g_cache.expired);
-
-            // trace
-            tb_trace_d("expired: %lu", g_cache.expired);
-
-            // remove the expired times
-            tb_remove_if(g_cache.hash, tb_dns_cache_clear, tb_null);
-        }
-
-        // check
-        tb_assert_and_check_break(tb_hash_map_size(g_cache.hash) < TB_DNS_CACHE_MAXN);
-
-        // save addr
-        tb_hash_map_insert(g_cache.hash, name, &caddr);
-
-        // update times
-        g_cache.times += caddr.time;
-
-        // trace
-        tb_trace_d("set: %s => %{ipaddr}, time: %u, size: %u", name, &caddr.addr, caddr.time, tb_hash_map_size(g_cache.hash));
+    // save it with the default ttl
+    tb_dns_cache_save(name, addr, 1, tb_dns_cache_ttl(0, TB_DNS_CACHE_TTL_DEFAULT));
+}
+tb_void_t tb_dns_cache_set_list(tb_char_t const* name, tb_ipaddr_ref_t list, tb_size_t size, tb_size_t ttl)
+{
+    // check
+    tb_assert_and_check_return(name && list && size && size <= TB_MAXU16);
 
-    } while (0);
+    // save them
+    tb_dns_cache_save(name, list, size, tb_dns_cache_ttl(ttl, TB_DNS_CACHE_TTL_DEFAULT));
+}
+tb_void_t tb_dns_cache_set_failed(tb_char_t const* name, tb_size_t ttl)
+{
+    // check
+    tb_assert_and_check_return(name);
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+    // save the failed result
+    tb_dns_cache_save(name, tb_null, 0, tb_dns_cache_ttl(ttl, TB_DNS_CACHE_TTL_FAILED));
 }
@@ -47,7 +47,17 @@ tb_bool_t           tb_dns_cache_init(tb_noarg_t);
 /// exit the cache list
 tb_void_t           tb_dns_cache_exit(tb_noarg_t);
 
+/*! set the cache maxn
+ *
+ * the least recently used entries will be removed if the cache is full
+ *
+ * @param maxn      the maximum count of the cached host names
+ */
+tb_void_t           tb_dns_cache_maxn_set(tb_size_t maxn);
+
 /*! get addr from cache 
+ *
+ * we will get the next address by round-robin if the host has multiple addresses
  *
  * @param name      the host name 
  * @param addr      the host addr
@@ -56,13 +66,39 @@ tb_void_t           tb_dns_cache_exit(tb_noarg_t);
  */
 tb_bool_t           tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr);
 
-/*! set addr to cache 
+/*! the failed lookup result of this host has been cached and not expired?
+ *
+ * @param name      the host name 
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_dns_cache_get_failed(tb_char_t const* name);
+
+/*! set addr to cache with the default ttl
  *
  * @param name      the host name 
  * @param addr      the host addr
  */
 tb_void_t           tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr);
 
+/*! set the addr list to cache
+ *
+ * @param name      the host name 
+ * @param list      the host addr list
+ * @param size      the host addr count
+ * @param ttl       the ttl (s), use the default ttl if be zero
+ */
+tb_void_t           tb_dns_cache_set_list(tb_char_t const* name, tb_ipaddr_ref_t list, tb_size_t size, tb_size_t ttl);
+
+/*! set the failed result to cache
+ *
+ * it will be not looked up again before it's expired if the host name does not exist
+ *
+ * @param name      the host name 
+ * @param ttl       the ttl (s), use the default ttl if be zero
+ */
+tb_void_t           tb_dns_cache_set_failed(tb_char_t const* name, tb_size_t ttl);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -44,6 +44,9 @@
 // the dns looker timeout
 #define TB_DNS_LOOKER_TIMEOUT   (5000)
 
+// the maximum count of the looked addresses
+#define TB_DNS_LOOKER_ADDR_MAXN (8)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -91,6 +94,18 @@ typedef struct __tb_dns_looker_t
     // the server maxn
     tb_size_t               maxn;
 
+    // the looked addresses
+    tb_ipaddr_t             addrs[TB_DNS_LOOKER_ADDR_MAXN];
+
+    // the looked addresses count
+    tb_size_t               addrn;
+
+    // the minimum ttl of the looked addresses
+    tb_uint32_t             ttl;
+
+    // the server has responded that the host has no address?
+    tb_bool_t               bnoaddr;
+
     // the data
     tb_byte_t               data[TB_DNS_NAME_MAXN + TB_DNS_RPKT_MAXN];
 
@@ -277,7 +292,8 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
 
     // init header
     tb_dns_header_t header;
-    header.id           = tb_static_stream_read_u16_be(&stream); tb_static_stream_skip(&stream, 2);
+    header.id           = tb_static_stream_read_u16_be(&stream);
+    header.rcode        = tb_static_stream_read_u16_be(&stream) & 0xf;
     header.question     = tb_static_stream_read_u16_be(&stream);
     header.answer       = tb_static_stream_read_u16_be(&stream);
     header.authority    = tb_static_stream_read_u16_be(&stream);
@@ -286,6 +302,7 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
     // trace
     tb_trace_d("response: size: %u",        size);
     tb_trace_d("response: id: 0x%04x",      header.id);
+    tb_trace_d("response: rcode: %d",       header.rcode);
     tb_trace_d("response: question: %d",    header.question);
     tb_trace_d("response: answer: %d",      header.answer);
     tb_trace_d("response: authority: %d",   header.authority);
@@ -295,6 +312,13 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
     // check header
     tb_assert_and_check_return_val(header.id == TB_DNS_HEADER_MAGIC, tb_false);
 
+    // the host name does not exist?
+    if (header.rcode == 3)
+    {
+        looker->bnoaddr = tb_true;
+        return tb_false;
+    }
+
     // skip questions, only one question now.
     // name + question1 + question2 + ...
     tb_assert_and_check_return_val(header.question == 1, tb_false);
@@ -311,8 +335,9 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
 
     // decode answers
     tb_size_t i = 0;
-    tb_size_t found = 0;
-    for (i = 0; i < header.answer; i++)
+    looker->addrn = 0;
+    looker->ttl = 0;
+    for (i = 0; i < header.answer && looker->addrn < tb_arrayn(looker->addrs); i++)
     {
         // decode answer
         tb_dns_answer_t answer;
@@ -333,43 +358,42 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
         tb_trace_d("response: size: %d",    answer.res.size);
 
         // is ipv4?
-        if (answer.res.type == 1)
+        tb_ipaddr_ref_t addr_looked = tb_null;
+        if (answer.res.type == 1 && answer.res.size == 4)
         {
             // get ipv4
-            tb_byte_t b1 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b2 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b3 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b4 = tb_static_stream_read_u8(&stream);
+            tb_ipv4_t ipv4;
+            ipv4.u8[0] = tb_static_stream_read_u8(&stream);
+            ipv4.u8[1] = tb_static_stream_read_u8(&stream);
+            ipv4.u8[2] = tb_static_stream_read_u8(&stream);
+            ipv4.u8[3] = tb_static_stream_read_u8(&stream);
 
             // trace
-            tb_trace_d("response: ipv4: %u.%u.%u.%u", b1, b2, b3, b4);
+            tb_trace_d("response: ipv4: %u.%u.%u.%u", ipv4.u8[0], ipv4.u8[1], ipv4.u8[2], ipv4.u8[3]);
 
-            // save the first ip
-            if (!found) 
-            {
-                // save it
-                if (addr)
-                {
-                    // init ipv4
-                    tb_ipv4_t ipv4;
-                    ipv4.u8[0] = b1;
-                    ipv4.u8[1] = b2;
-                    ipv4.u8[2] = b3;
-                    ipv4.u8[3] = b4;
-
-                    // save ipv4
-                    tb_ipaddr_ipv4_set(addr, &ipv4);
-                }
-
-                // found it
-                found = 1;
-
-                // trace
-                tb_trace_d("response: ");
-                break;
-            }
+            // save ipv4
+            addr_looked = &looker->addrs[looker->addrn];
+            tb_ipaddr_clear(addr_looked);
+            tb_ipaddr_ipv4_set(addr_looked, &ipv4);
         }
-        else
+        // is ipv6?
+        else if (answer.res.type == 28 && answer.res.size == 16)
+        {
+            // get ipv6
+            tb_ipv6_t ipv6;
+            tb_memset(&ipv6, 0, sizeof(ipv6));
+            if (!tb_static_stream_read_data(&stream, ipv6.addr.u8, 16)) break;
+
+            // trace
+            tb_trace_d("response: ipv6: %{ipv6}", &ipv6);
+
+            // save ipv6
+            addr_looked = &looker->addrs[looker->addrn];
+            tb_ipaddr_clear(addr_looked);
+            tb_ipaddr_ipv6_set(addr_looked, &ipv6);
+        }
+        // is cname?
+        else if (answer.res.type == 5)
         {
             // decode rdata
             answer.rdata = (tb_byte_t*)tb_dns_decode_name(&stream, answer.name);
@@ -377,13 +401,29 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_
             // trace
             tb_trace_d("response: alias: %s", answer.rdata? (tb_char_t const*)answer.rdata : "");
         }
+        // skip the other resource
+        else if (!tb_static_stream_skip(&stream, answer.res.size)) break;
+
+        // save the looked address and the minimum ttl
+        if (addr_looked)
+        {
+            if (!looker->addrn || answer.res.ttl < looker->ttl) looker->ttl = answer.res.ttl;
+            looker->addrn++;
+        }
 
         // trace
         tb_trace_d("response: ");
     }
 
-    // found it?
-    tb_check_return_val(found, tb_false);
+    // no address?
+    if (!looker->addrn)
+    {
+        looker->bnoaddr = tb_true;
+        return tb_false;
+    }
+
+    // save the first address
+    if (addr) tb_ipaddr_ip_set(addr, &looker->addrs[0]);
 
 #if 0
     // decode authorities
@@ -513,8 +553,8 @@ static tb_long_t tb_dns_looker_resp(tb_dns_looker_t* looker, tb_ipaddr_ref_t add
     // check
     tb_assert_and_check_return_val(tb_static_string_size(&looker->name) && !tb_ipaddr_ip_is_empty(addr), -1);
 
-    // save address to cache
-    tb_dns_cache_set(tb_static_string_cstr(&looker->name), addr);
+    // save addresses to cache
+    tb_dns_cache_set_list(tb_static_string_cstr(&looker->name), looker->addrs, looker->addrn, looker->ttl);
 
     // finish it
     looker->step |= TB_DNS_LOOKER_STEP_RESP;
@@ -629,6 +669,8 @@ tb_long_t tb_dns_looker_spak(tb_dns_looker_ref_t self, tb_ipaddr_ref_t addr)
             // continue 
             r = 0;
         }
+        // the host has no address? cache the failed result
+        else if (looker->bnoaddr) tb_dns_cache_set_failed(tb_static_string_cstr(&looker->name), 0);
     }
 
     // ok?
@@ -687,6 +729,9 @@ tb_bool_t tb_dns_looker_done(tb_char_t const* name, tb_ipaddr_ref_t addr)
     // try to lookup it from cache first
     if (tb_dns_cache_get(name, addr)) return tb_true;
 
+    // the failed result has been cached?
+    if (tb_dns_cache_get_failed(name)) return tb_false;
+
     // init looker
     tb_dns_looker_ref_t looker = tb_dns_looker_init(name);
     tb_check_return_val(looker, tb_false);
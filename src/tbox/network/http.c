@@ -34,6 +34,7 @@
 #include "impl/http/option.h"
 #include "impl/http/status.h"
 #include "impl/http/method.h"
+#include "impl/http/pool.h"
 #include "../zip/zip.h"
 #include "../libc/libc.h"
 #include "../math/math.h"
@@ -75,6 +76,27 @@ typedef struct __tb_http_t
     // is opened?
     tb_bool_t           bopened;
 
+    // the connection is taken from the pool?
+    tb_bool_t           bpooled;
+
+    // the sstream offset at the end of the response head
+    tb_hize_t           head_offset;
+
+    // the pipelined urls
+    tb_vector_ref_t     pipeline;
+
+    // the index of the next pipelined url
+    tb_size_t           pipeline_next;
+
+    // the url of the pipelined request
+    tb_url_t            pipeline_url;
+
+    // the left size of the current chunk of the pipelined chunked response
+    tb_hize_t           chunk_left;
+
+    // the last chunk of the pipelined chunked response has been read?
+    tb_bool_t           chunk_end;
+
     // the request data
     tb_string_t         request;
 
@@ -89,15 +111,188 @@ typedef struct __tb_http_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+static tb_bool_t tb_http_connected(tb_http_t* http)
+{
+    // the sstream has the kept-alive connection?
+    tb_socket_ref_t sock = tb_null;
+    return tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_GET_SOCK, &sock) && sock;
+}
+static tb_bool_t tb_http_pipelined(tb_http_t* http)
+{
+    // have the pipelined requests?
+    return http->pipeline && tb_vector_size(http->pipeline);
+}
+/* the idempotent request can be sent again automatically 
+ * if the connection has been closed before receiving the response
+ *
+ * @see rfc7230 6.3.1 and rfc7231 4.2.2
+ */
+static tb_bool_t tb_http_idempotent(tb_http_t* http)
+{
+    switch (http->option.method)
+    {
+    case TB_HTTP_METHOD_GET:
+    case TB_HTTP_METHOD_HEAD:
+    case TB_HTTP_METHOD_PUT:
+    case TB_HTTP_METHOD_OPTIONS:
+    case TB_HTTP_METHOD_DELETE:
+    case TB_HTTP_METHOD_TRACE:
+        return tb_true;
+    default:
+        return tb_false;
+    }
+}
+/* the left size of the response body on the sstream, not chunked
+ *
+ * @return              the left size, -1: unknown
+ */
+static tb_hong_t tb_http_body_left(tb_http_t* http)
+{
+    // the read size of the response body
+    tb_hize_t offset = tb_stream_offset(http->sstream);
+    tb_check_return_val(offset >= http->head_offset, -1);
+    tb_hize_t read = offset - http->head_offset;
+
+    // no body?
+    if (    http->option.method == TB_HTTP_METHOD_HEAD
+        ||  http->status.code < 200
+        ||  http->status.code == TB_HTTP_CODE_NO_CONTENT
+        ||  http->status.code == TB_HTTP_CODE_NOT_MODIFIED)
+        return read? -1 : 0;
+
+    // the pipelined chunked response? it's decoded directly
+    if (http->status.bchunked) return http->chunk_end? 0 : -1;
+
+    // the left size
+    tb_check_return_val(http->status.content_size >= 0 && read <= (tb_hize_t)http->status.content_size, -1);
+    return http->status.content_size - (tb_hong_t)read;
+}
+static tb_bool_t tb_http_body_end(tb_http_t* http)
+{
+    // the body has been read completely?
+    return !tb_http_body_left(http);
+}
+/* read the pipelined chunked response directly from the sstream
+ *
+ * the chunked filter stream cannot be used, because it will read the next response from the sstream.
+ * the chunk head is read by blocking, it's very short and follows the chunk data.
+ */
+static tb_long_t tb_http_chunked_read(tb_http_t* http, tb_byte_t* data, tb_size_t size)
+{
+    // end?
+    tb_check_return_val(!http->chunk_end, -1);
+
+    // read the next chunk head: "size[;ext]\r\n"
+    if (!http->chunk_left)
+    {
+        // read line and skip the tail "\r\n" of the last chunk
+        tb_char_t line[256];
+        tb_long_t real = tb_stream_bread_line(http->sstream, line, sizeof(line));
+        if (!real) real = tb_stream_bread_line(http->sstream, line, sizeof(line));
+        tb_check_return_val(real > 0 && tb_isdigit16(line[0]), -1);
+
+        // parse the chunk size
+        http->chunk_left = tb_s16tou64(line);
+
+        // the last chunk? skip the trailer
+        if (!http->chunk_left)
+        {
+            while ((real = tb_stream_bread_line(http->sstream, line, sizeof(line))) > 0) ;
+            tb_check_return_val(!real, -1);
+
+            // end
+            http->chunk_end = tb_true;
+            return -1;
+        }
+    }
+
+    // read the chunk data
+    tb_long_t real = tb_stream_read(http->sstream, data, (tb_size_t)tb_min((tb_hize_t)size, http->chunk_left));
+    if (real > 0) http->chunk_left -= real;
+
+    // ok?
+    return real;
+}
+static tb_bool_t tb_http_reusable(tb_http_t* http)
+{
+    // keep alive?
+    tb_check_return_val(http->status.balived, tb_false);
+
+    // chunked? the last chunk must have been read
+    if (http->status.bchunked)
+    {
+        // the pipelined chunked response?
+        if (http->stream == http->sstream) return tb_http_body_end(http);
+
+        // the chunked filter
+        tb_filter_ref_t filter = tb_null;
+        return http->cstream && tb_stream_ctrl(http->cstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter) && filter && tb_filter_beof(filter);
+    }
+
+    // the body must have been read completely
+    return tb_http_body_end(http);
+}
+/* close the current stream and switch to the sstream
+ *
+ * the kept-alive connection will be closed if the response has not been read completely,
+ * because the left data will break the next response.
+ */
+static tb_bool_t tb_http_stream_clos(tb_http_t* http, tb_bool_t* palived)
+{
+    // the connection can be reused?
+    tb_bool_t alived = tb_http_reusable(http);
+    if (!alived) tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+
+    // save the ssl session for resuming the next connection
+    if (http->option.bpool && tb_url_ssl(&http->option.url))
+    {
+        tb_ssl_session_ref_t session = tb_null;
+        if (tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_GET_SSL_SESSION, &session) && session)
+            tb_http_pool_session_save(&http->option.url, session);
+    }
+
+    // close stream
+    if (http->stream && !tb_stream_clos(http->stream)) return tb_false;
+
+    // switch to sstream
+    http->stream = http->sstream;
+
+    // save the alived state
+    if (palived) *palived = alived;
+
+    // ok
+    return tb_true;
+}
 static tb_bool_t tb_http_connect(tb_http_t* http)
 {
     // check
     tb_assert_and_check_return_val(http && http->stream, tb_false);
     
     // done
-    tb_bool_t ok = tb_false;
+    tb_bool_t                   ok = tb_false;
+    tb_http_pool_session_ref_t  session = tb_null;
     do
     {
+        // clear the pooled state
+        http->bpooled       = tb_false;
+        http->head_offset   = 0;
+
+        // take the idle connection to this server from the pool if we have not the kept-alive connection
+        if (http->option.bpool && !tb_http_connected(http))
+        {
+            tb_stream_ref_t sstream = tb_http_pool_conn_get(&http->option.url);
+            if (sstream)
+            {
+                // check
+                tb_assert(http->stream == http->sstream);
+
+                // use it
+                tb_stream_exit(http->sstream);
+                http->stream = http->sstream = sstream;
+                http->bpooled = tb_true;
+            }
+        }
+
         // the host is changed?
         tb_bool_t           host_changed = tb_true;
         tb_char_t const*    host_old = tb_null;
@@ -126,6 +321,13 @@ static tb_bool_t tb_http_connect(tb_http_t* http)
         // clear status
         tb_http_status_cler(&http->status, host_changed);
 
+        // resume the cached ssl session if the new connection will be made
+        if (http->option.bpool && tb_url_ssl(&http->option.url))
+        {
+            session = tb_http_pool_session_get(&http->option.url);
+            if (session) tb_stream_ctrl(http->stream, TB_STREAM_CTRL_SOCK_SET_SSL_SESSION, tb_http_pool_session_ssl(session));
+        }
+
         // open stream
         if (!tb_stream_open(http->stream)) break;
 
@@ -134,6 +336,13 @@ static tb_bool_t tb_http_connect(tb_http_t* http)
 
     } while (0);
 
+    // exit the cached ssl session
+    if (session)
+    {
+        tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_SET_SSL_SESSION, tb_null);
+        tb_http_pool_session_put(session);
+    }
+
 
     // failed? save state
     if (!ok) http->status.state = tb_stream_state(http->stream);
@@ -144,6 +353,46 @@ static tb_bool_t tb_http_connect(tb_http_t* http)
     // ok?
     return ok;
 }
+static tb_bool_t tb_http_pipeline_url(tb_http_t* http, tb_size_t indx)
+{
+    // the pipelined url
+    tb_char_t const* cstr = (tb_char_t const*)tb_iterator_item(http->pipeline, indx);
+    tb_assert_and_check_return_val(cstr, tb_false);
+
+    // init it from the current url
+    tb_url_ref_t url = &http->pipeline_url;
+    tb_url_copy(url, &http->option.url);
+
+    // only path? "/path?args"
+    if (tb_url_protocol_probe(cstr) == TB_URL_PROTOCOL_FILE)
+    {
+        tb_char_t const* args = tb_strchr(cstr, '?');
+        tb_url_path_set(url, cstr);
+        tb_url_args_set(url, args? args : "");
+    }
+    // full http url? 
+    else
+    {
+        // set url
+        if (!tb_url_cstr_set(url, cstr)) return tb_false;
+
+        // the same server? all pipelined requests are sent on the same connection
+        tb_char_t const* host = tb_url_host(url);
+        tb_char_t const* host_cur = tb_url_host(&http->option.url);
+        if (    tb_url_protocol(url) != TB_URL_PROTOCOL_HTTP
+            ||  !host || !host_cur || tb_stricmp(host, host_cur)
+            ||  tb_url_port(url) != tb_url_port(&http->option.url)
+            ||  tb_url_ssl(url) != tb_url_ssl(&http->option.url))
+        {
+            // trace
+            tb_trace_e("the pipelined url %s is not on the server of %s", cstr, tb_url_cstr(&http->option.url));
+            return tb_false;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
 static tb_bool_t tb_http_request_post(tb_size_t state, tb_hize_t offset, tb_hong_t size, tb_hize_t save, tb_size_t rate, tb_cpointer_t priv)
 {
     // check
@@ -160,20 +409,20 @@ static tb_bool_t tb_http_request_post(tb_size_t state, tb_hize_t offset, tb_hong
     // ok?
     return tb_true;
 }
-static tb_bool_t tb_http_request(tb_http_t* http)
+/* make the request head of the given url and append it to the request data
+ *
+ * @param http          the http
+ * @param url           the url
+ * @param post_size     the post size, no post: -1
+ *
+ * @return              tb_true or tb_false
+ */
+static tb_bool_t tb_http_request_head(tb_http_t* http, tb_url_ref_t url, tb_hong_t post_size)
 {
-    // check
-    tb_assert_and_check_return_val(http && http->stream, tb_false);
-
     // done
-    tb_bool_t           ok = tb_false;
-    tb_stream_ref_t     pstream = tb_null;
-    tb_hong_t           post_size = 0;
+    tb_bool_t ok = tb_false;
     do
     {
-        // clear line data
-        tb_string_clear(&http->request);
-
         // init the head value
         tb_static_string_t value;
         if (!tb_static_string_init(&value, http->data, sizeof(http->data))) break;
@@ -183,14 +432,14 @@ static tb_bool_t tb_http_request(tb_http_t* http)
         tb_assert_and_check_break(method);
 
         // init path
-        tb_char_t const* path = tb_url_path(&http->option.url);
+        tb_char_t const* path = tb_url_path(url);
         tb_assert_and_check_break(path);
 
         // init args
-        tb_char_t const* args = tb_url_args(&http->option.url);
+        tb_char_t const* args = tb_url_args(url);
 
         // init host
-        tb_char_t const* host = tb_url_host(&http->option.url);
+        tb_char_t const* host = tb_url_host(url);
         tb_assert_and_check_break(host);
         tb_hash_map_insert(http->head, "Host", host);
 
@@ -198,14 +447,14 @@ static tb_bool_t tb_http_request(tb_http_t* http)
         tb_hash_map_insert(http->head, "Accept", "*/*");
 
         // init connection
-        tb_hash_map_insert(http->head, "Connection", http->status.balived? "keep-alive" : "close");
+        tb_hash_map_insert(http->head, "Connection", (http->status.balived || http->option.bpool || tb_http_pipelined(http))? "keep-alive" : "close");
 
         // init cookies
         tb_bool_t cookie = tb_false;
         if (http->option.cookies)
         {
             // set cookie
-            if (tb_cookies_get(http->option.cookies, host, path, tb_url_ssl(&http->option.url), &http->cookies))
+            if (tb_cookies_get(http->option.cookies, host, path, tb_url_ssl(url), &http->cookies))
             {
                 tb_hash_map_insert(http->head, "Cookie", tb_string_cstr(&http->cookies));
                 cookie = tb_true;
@@ -234,42 +483,11 @@ static tb_bool_t tb_http_request(tb_http_t* http)
         // remove range
         else tb_hash_map_remove(http->head, "Range");
 
-        // init post
-        if (http->option.method == TB_HTTP_METHOD_POST)
+        // append post size
+        if (post_size >= 0)
         {
-            // done
-            tb_bool_t post_ok = tb_false;
-            do
-            {
-                // init pstream
-                tb_char_t const* url = tb_url_cstr(&http->option.post_url);
-                if (http->option.post_data && http->option.post_size)
-                    pstream = tb_stream_init_from_data(http->option.post_data, http->option.post_size);
-                else if (url) pstream = tb_stream_init_from_url(url);
-                tb_assert_and_check_break(pstream);
-
-                // open pstream
-                if (!tb_stream_open(pstream)) break;
-
-                // the post size
-                post_size = tb_stream_size(pstream);
-                tb_assert_and_check_break(post_size >= 0);
-
-                // append post size
-                tb_static_string_cstrfcpy(&value, "%lld", post_size);
-                tb_hash_map_insert(http->head, "Content-Length", tb_static_string_cstr(&value));
-
-                // ok
-                post_ok = tb_true;
-
-            } while (0);
-
-            // init post failed?
-            if (!post_ok) 
-            {
-                http->status.state = TB_STATE_HTTP_POST_FAILED;
-                break;
-            }
+            tb_static_string_cstrfcpy(&value, "%lld", post_size);
+            tb_hash_map_insert(http->head, "Content-Length", tb_static_string_cstr(&value));
         }
         // remove post
         else tb_hash_map_remove(http->head, "Content-Length");
@@ -327,8 +545,9 @@ static tb_bool_t tb_http_request(tb_http_t* http)
         // append ' '
         tb_string_chrcat(&http->request, ' ');
 
-        // append version, HTTP/1.1
-        tb_string_cstrfcat(&http->request, "HTTP/1.%1u\r\n", http->status.balived? http->status.version : http->option.version);
+        // append version, HTTP/1.1, the pipelined requests need HTTP/1.1
+        if (tb_http_pipelined(http)) tb_string_cstrcat(&http->request, "HTTP/1.1\r\n");
+        else tb_string_cstrfcat(&http->request, "HTTP/1.%1u\r\n", http->status.balived? http->status.version : http->option.version);
 
         // append key: value
         tb_for_all (tb_hash_map_item_ref_t, item, http->head)
@@ -340,6 +559,90 @@ static tb_bool_t tb_http_request(tb_http_t* http)
         // append end
         tb_string_cstrcat(&http->request, "\r\n");
 
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // ok?
+    return ok;
+}
+static tb_bool_t tb_http_request(tb_http_t* http)
+{
+    // check
+    tb_assert_and_check_return_val(http && http->stream, tb_false);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_stream_ref_t     pstream = tb_null;
+    tb_hong_t           post_size = -1;
+    do
+    {
+        // clear line data
+        tb_string_clear(&http->request);
+
+        // init post
+        if (http->option.method == TB_HTTP_METHOD_POST)
+        {
+            // done
+            tb_bool_t post_ok = tb_false;
+            do
+            {
+                // init pstream
+                tb_char_t const* url = tb_url_cstr(&http->option.post_url);
+                if (http->option.post_data && http->option.post_size)
+                    pstream = tb_stream_init_from_data(http->option.post_data, http->option.post_size);
+                else if (url) pstream = tb_stream_init_from_url(url);
+                tb_assert_and_check_break(pstream);
+
+                // open pstream
+                if (!tb_stream_open(pstream)) break;
+
+                // the post size
+                post_size = tb_stream_size(pstream);
+                tb_assert_and_check_break(post_size >= 0);
+
+                // ok
+                post_ok = tb_true;
+
+            } while (0);
+
+            // init post failed?
+            if (!post_ok) 
+            {
+                http->status.state = TB_STATE_HTTP_POST_FAILED;
+                break;
+            }
+        }
+
+        // make the request head
+        if (!tb_http_request_head(http, &http->option.url, post_size)) break;
+
+        /* append the left pipelined requests, they will be sent with one write
+         *
+         * only the idempotent requests can be pipelined, 
+         * because the unanswered requests will be sent again if the connection is closed.
+         */
+        if (tb_http_pipelined(http))
+        {
+            // check method
+            if (http->option.method != TB_HTTP_METHOD_GET && http->option.method != TB_HTTP_METHOD_HEAD)
+            {
+                // trace
+                tb_trace_e("only the GET and HEAD requests can be pipelined!");
+                break;
+            }
+
+            // make the pipelined request heads
+            tb_size_t i = http->pipeline_next;
+            tb_size_t n = tb_vector_size(http->pipeline);
+            for (; i < n; i++)
+            {
+                if (!tb_http_pipeline_url(http, i) || !tb_http_request_head(http, &http->pipeline_url, -1)) break;
+            }
+            tb_check_break(i == n);
+        }
+
         // the request data and size
         tb_char_t const*    request_data = tb_string_cstr(&http->request);
         tb_size_t           request_size = tb_string_size(&http->request);
@@ -416,6 +719,13 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
         // parse version
         tb_assert_and_check_return_val((*p - '0') < 2, tb_false);
         http->status.version = *p - '0';
+
+        // HTTP/1.1 is kept alive by default if using the connection pool or pipeline, it will be overrided by the "Connection" head
+        if (http->option.bpool || tb_http_pipelined(http))
+        {
+            http->status.balived = http->status.version;
+            if (!tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, http->status.balived? tb_true : tb_false)) return tb_false;
+        }
     
         // seek to the http code
         p++; while (tb_isspace(*p)) p++;
@@ -437,8 +747,12 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
             http->status.state = TB_STATE_HTTP_RESPONSE_500 + (http->status.code - 500);
         else http->status.state = TB_STATE_HTTP_RESPONSE_UNK;
 
-        // check state code: 4xx & 5xx
-        if (http->status.code >= 400 && http->status.code < 600) return tb_false;
+        /* check state code: 4xx & 5xx
+         *
+         * we need parse the whole head of the pipelined response, 
+         * because the next response follows it and the error state will be saved in the status.
+         */
+        if (http->status.code >= 400 && http->status.code < 600 && !tb_http_pipelined(http)) return tb_false;
     }
     // key: value?
     else
@@ -446,20 +760,25 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
         // seek to value
         while (*p && *p != ':') p++;
         tb_assert_and_check_return_val(*p, tb_false);
+
+        // the name size, we compare it first for skipping the unknown heads quickly
+        tb_size_t n = p - line;
+
+        // skip ':' and spaces
         p++; while (*p && tb_isspace(*p)) p++;
 
         // no value
         tb_check_return_val(*p, tb_true);
 
         // parse content size
-        if (!tb_strnicmp(line, "Content-Length", 14))
+        if (n == 14 && !tb_strnicmp(line, "Content-Length", 14))
         {
             http->status.content_size = tb_stou64(p);
             if (http->status.document_size < 0) 
                 http->status.document_size = http->status.content_size;
         }
         // parse content range: "bytes $from-$to/$document_size"
-        else if (!tb_strnicmp(line, "Content-Range", 13))
+        else if (n == 13 && !tb_strnicmp(line, "Content-Range", 13))
         {
             tb_hize_t from = 0;
             tb_hize_t to = 0;
@@ -485,30 +804,30 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
             }
         }
         // parse accept-ranges: "bytes "
-        else if (!tb_strnicmp(line, "Accept-Ranges", 13))
+        else if (n == 13 && !tb_strnicmp(line, "Accept-Ranges", 13))
         {
             // no stream, be able to seek
             http->status.bseeked = 1;
         }
         // parse content type
-        else if (!tb_strnicmp(line, "Content-Type", 12)) 
+        else if (n == 12 && !tb_strnicmp(line, "Content-Type", 12)) 
         {
             tb_string_cstrcpy(&http->status.content_type, p);
             tb_assert_and_check_return_val(tb_string_size(&http->status.content_type), tb_false);
         }
         // parse transfer encoding
-        else if (!tb_strnicmp(line, "Transfer-Encoding", 17))
+        else if (n == 17 && !tb_strnicmp(line, "Transfer-Encoding", 17))
         {
             if (!tb_stricmp(p, "chunked")) http->status.bchunked = 1;
         }
         // parse content encoding
-        else if (!tb_strnicmp(line, "Content-Encoding", 16))
+        else if (n == 16 && !tb_strnicmp(line, "Content-Encoding", 16))
         {
             if (!tb_stricmp(p, "gzip")) http->status.bgzip = 1;
             else if (!tb_stricmp(p, "deflate")) http->status.bdeflate = 1;
         }
         // parse location
-        else if (!tb_strnicmp(line, "Location", 8)) 
+        else if (n == 8 && !tb_strnicmp(line, "Location", 8)) 
         {
             // redirect? check code: 301 - 307
             tb_assert_and_check_return_val(http->status.code > 300 && http->status.code < 308, tb_false);
@@ -517,7 +836,7 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
             tb_string_cstrcpy(&http->status.location, p);
         }
         // parse connection
-        else if (!tb_strnicmp(line, "Connection", 10))
+        else if (n == 10 && !tb_strnicmp(line, "Connection", 10))
         {
             // keep alive?
             http->status.balived = !tb_stricmp(p, "close")? 0 : 1;
@@ -526,7 +845,7 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
             if (!tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, http->status.balived? tb_true : tb_false)) return tb_false;
         }
         // parse cookies
-        else if (http->option.cookies && !tb_strnicmp(line, "Set-Cookie", 10))
+        else if (n == 10 && http->option.cookies && !tb_strnicmp(line, "Set-Cookie", 10))
         {
             // the host
             tb_char_t const* host = tb_null;
@@ -571,22 +890,41 @@ static tb_bool_t tb_http_response(tb_http_t* http)
             // end?
             if (!real)
             {
+                // no response? the kept-alive connection may have been closed by the server
+                if (!indx)
+                {
+                    http->status.state = TB_STATE_SOCK_RECV_FAILED;
+                    break;
+                }
+
+                // save the offset at the end of the head
+                http->head_offset = tb_stream_offset(http->sstream);
+
                 // switch to cstream if chunked
                 if (http->status.bchunked)
                 {
-                    // init cstream
-                    if (http->cstream)
+                    // the pipelined response and not unzipped? decode it directly for reading the next response
+                    if (tb_http_pipelined(http) && !(http->option.bunzip && (http->status.bgzip || http->status.bdeflate)))
                     {
-                        if (!tb_stream_ctrl(http->cstream, TB_STREAM_CTRL_FLTR_SET_STREAM, http->stream)) break;
+                        http->chunk_left    = 0;
+                        http->chunk_end     = tb_false;
+                    }
+                    else
+                    {
+                        // init cstream
+                        if (http->cstream)
+                        {
+                            if (!tb_stream_ctrl(http->cstream, TB_STREAM_CTRL_FLTR_SET_STREAM, http->stream)) break;
+                        }
+                        else http->cstream = tb_stream_init_filter_from_chunked(http->stream, tb_true);
+                        tb_assert_and_check_break(http->cstream);
+
+                        // open cstream, need not async
+                        if (!tb_stream_open(http->cstream)) break;
+
+                        // using cstream
+                        http->stream = http->cstream;
                     }
-                    else http->cstream = tb_stream_init_filter_from_chunked(http->stream, tb_true);
-                    tb_assert_and_check_break(http->cstream);
-
-                    // open cstream, need not async
-                    if (!tb_stream_open(http->cstream)) break;
-
-                    // using cstream
-                    http->stream = http->cstream;
 
                     // disable seek
                     http->status.bseeked = 0;
@@ -687,11 +1025,8 @@ static tb_bool_t tb_http_redirect(tb_http_t* http)
             tb_assert_pass_and_check_break(read == size);
         }
 
-        // close stream
-        if (http->stream && !tb_stream_clos(http->stream)) break;
-
-        // switch to sstream
-        http->stream = http->sstream;
+        // close stream and switch to sstream
+        if (!tb_http_stream_clos(http, tb_null)) break;
 
         // get location url
         tb_char_t const* location = tb_string_cstr(&http->status.location);
@@ -729,6 +1064,52 @@ static tb_bool_t tb_http_redirect(tb_http_t* http)
     // ok?
     return ok && !tb_string_size(&http->status.location);
 }
+static tb_bool_t tb_http_open_done(tb_http_t* http)
+{
+    // connect it
+    if (!tb_http_connect(http)) return tb_false;
+
+    // request it
+    if (!tb_http_request(http)) return tb_false;
+
+    // response it
+    if (!tb_http_response(http)) return tb_false;
+
+    // the pipelined responses will not be redirected, because the next response follows it
+    tb_check_return_val(!tb_http_pipelined(http), tb_true);
+
+    // redirect it
+    return tb_http_redirect(http);
+}
+/* skip the left body of the current response on the kept-alive connection
+ *
+ * @return              tb_true if the next response can be read from this connection
+ */
+static tb_bool_t tb_http_pipeline_skip(tb_http_t* http)
+{
+    // the chunked or unzipped response? the filter stream may have read the next responses
+    tb_check_return_val(http->stream == http->sstream && http->status.balived, tb_false);
+
+    // skip the left chunked data
+    if (http->status.bchunked)
+    {
+        tb_long_t real = 0;
+        while ((real = tb_http_chunked_read(http, (tb_byte_t*)http->data, sizeof(http->data))) >= 0)
+        {
+            // wait
+            if (!real && tb_stream_wait(http->sstream, TB_STREAM_WAIT_READ, http->option.timeout) <= 0) break;
+        }
+    }
+    // skip the left body
+    else
+    {
+        tb_hong_t left = tb_http_body_left(http);
+        if (left > 0 && !tb_stream_skip(http->sstream, left)) return tb_false;
+    }
+
+    // reusable?
+    return tb_http_reusable(http);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -755,6 +1136,9 @@ tb_http_ref_t tb_http_init()
         // init request data
         if (!tb_string_init(&http->request)) break;
 
+        // init the pipelined url
+        if (!tb_url_init(&http->pipeline_url)) break;
+
         // init cookies data
         if (!tb_string_init(&http->cookies)) break;
 
@@ -824,6 +1208,13 @@ tb_void_t tb_http_exit(tb_http_ref_t self)
     // exit request data
     tb_string_exit(&http->request);
 
+    // exit the pipelined url
+    tb_url_exit(&http->pipeline_url);
+
+    // exit pipeline
+    if (http->pipeline) tb_vector_exit(http->pipeline);
+    http->pipeline = tb_null;
+
     // exit head
     if (http->head) tb_hash_map_exit(http->head);
     http->head = tb_null;
@@ -858,35 +1249,34 @@ tb_bool_t tb_http_open(tb_http_ref_t self)
     // opened?
     tb_assert_and_check_return_val(!http->bopened, tb_false);
 
+    // reset the pipelined requests
+    http->pipeline_next = 0;
+
     // done
     tb_bool_t ok = tb_false;
-    do
+    tb_size_t tryn = 2;
+    while (tryn--)
     {
-        // connect it
-        if (!tb_http_connect(http)) break;
+        // open it
+        ok = tb_http_open_done(http);
+        tb_check_break(!ok);
 
-        // request it
-        if (!tb_http_request(http)) break;
-
-        // response it
-        if (!tb_http_response(http)) break;
-
-        // redirect it
-        if (!tb_http_redirect(http)) break;
-
-        // ok
-        ok = tb_true;
-
-    } while (0);
-
-    // failed? close it
-    if (!ok) 
-    {
-        // close stream
+        // close stream and the connection
+        tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
         if (http->stream) tb_stream_clos(http->stream);
 
         // switch to sstream
         http->stream = http->sstream;
+
+        /* the idle connection from the pool may have been closed by the server, 
+         * so we retry it using a new connection if no response has been received
+         *
+         * the server may have processed the non-idempotent request (e.g. POST), so we cannot send it again.
+         */
+        tb_check_break(http->bpooled && !http->status.code && http->status.state != TB_STATE_KILLED && tb_http_idempotent(http));
+
+        // trace
+        tb_trace_d("open: the pooled connection is broken, retry it");
     }
 
     // is opened?
@@ -904,11 +1294,29 @@ tb_bool_t tb_http_clos(tb_http_ref_t self)
     // opened?
     tb_check_return_val(http->bopened, tb_true);
 
-    // close stream
-    if (http->stream && !tb_stream_clos(http->stream)) return tb_false;
+    // have the unanswered pipelined requests? their responses will break the next request
+    if (tb_http_pipelined(http) && http->pipeline_next < tb_vector_size(http->pipeline))
+        tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
 
-    // switch to sstream
-    http->stream = http->sstream;
+    // clear the pipelined requests
+    if (http->pipeline) tb_vector_clear(http->pipeline);
+    http->pipeline_next = 0;
+
+    // close stream and switch to sstream
+    tb_bool_t alived = tb_false;
+    if (!tb_http_stream_clos(http, &alived)) return tb_false;
+
+    // put the kept-alive connection back to the pool and use a new sstream for the next request
+    if (alived && http->option.bpool && tb_http_connected(http))
+    {
+        tb_stream_ref_t sstream = tb_stream_init_sock();
+        if (sstream && tb_http_pool_conn_put(&http->option.url, http->sstream))
+        {
+            http->stream = http->sstream = sstream;
+            sstream = tb_null;
+        }
+        if (sstream) tb_stream_exit(sstream);
+    }
 
     // clear opened
     http->bopened = tb_false;
@@ -925,18 +1333,15 @@ tb_bool_t tb_http_seek(tb_http_ref_t self, tb_hize_t offset)
     // opened?
     tb_assert_and_check_return_val(http->bopened, tb_false);
 
-    // seeked?
-    tb_check_return_val(http->status.bseeked, tb_false);
+    // seeked? the pipelined responses cannot be seeked
+    tb_check_return_val(http->status.bseeked && !tb_http_pipelined(http), tb_false);
 
     // done
     tb_bool_t ok = tb_false;
     do
     {
-        // close stream
-        if (http->stream && !tb_stream_clos(http->stream)) break;
-
-        // switch to sstream
-        http->stream = http->sstream;
+        // close stream and switch to sstream
+        if (!tb_http_stream_clos(http, tb_null)) break;
 
         // trace
         tb_trace_d("seek: %llu", offset);
@@ -971,6 +1376,22 @@ tb_long_t tb_http_read(tb_http_ref_t self, tb_byte_t* data, tb_size_t size)
     // opened?
     tb_assert_and_check_return_val(http->bopened, -1);
 
+    /* the kept-alive connection will not be closed by the server after reading the whole body,
+     * and we cannot read the data of the next pipelined response
+     */
+    if (http->stream == http->sstream && (http->status.balived || http->status.bchunked))
+    {
+        // end?
+        tb_hong_t left = tb_http_body_left(http);
+        tb_check_return_val(left, -1);
+
+        // the pipelined chunked response? 
+        if (http->status.bchunked) return tb_http_chunked_read(http, data, size);
+
+        // limit the read size
+        if (left > 0 && size > left) size = (tb_size_t)left;
+    }
+
     // read
     return tb_stream_read(http->stream, data, size);
 }
@@ -988,7 +1409,7 @@ tb_bool_t tb_http_bread(tb_http_ref_t self, tb_byte_t* data, tb_size_t size)
     while (read < size)
     {
         // read data
-        tb_long_t real = tb_stream_read(http->stream, data + read, size - read);
+        tb_long_t real = tb_http_read(self, data + read, size - read);
 
         // update size
         if (real > 0) read += real;
@@ -1011,6 +1432,95 @@ tb_bool_t tb_http_bread(tb_http_ref_t self, tb_byte_t* data, tb_size_t size)
     // ok?
     return read == size? tb_true : tb_false;
 }
+tb_bool_t tb_http_pipeline_push(tb_http_ref_t self, tb_char_t const* url)
+{
+    // check
+    tb_http_t* http = (tb_http_t*)self;
+    tb_assert_and_check_return_val(http && url, tb_false);
+
+    // opened? 
+    tb_assert_and_check_return_val(!http->bopened, tb_false);
+
+    // init pipeline
+    if (!http->pipeline) http->pipeline = tb_vector_init(16, tb_element_str(tb_true));
+    tb_assert_and_check_return_val(http->pipeline, tb_false);
+
+    // push it
+    tb_vector_insert_tail(http->pipeline, url);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_http_pipeline_next(tb_http_ref_t self)
+{
+    // check
+    tb_http_t* http = (tb_http_t*)self;
+    tb_assert_and_check_return_val(http && http->stream, tb_false);
+
+    // opened?
+    tb_assert_and_check_return_val(http->bopened, tb_false);
+
+    // no more pipelined requests?
+    tb_check_return_val(tb_http_pipelined(http) && http->pipeline_next < tb_vector_size(http->pipeline), tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // skip the left body and read the next response from the current connection if be reusable
+        tb_bool_t reused = tb_http_pipeline_skip(http);
+
+        // trace
+        tb_trace_d("next: %lu, connection: %s", http->pipeline_next, reused? "reused" : "closed");
+
+        // close the connection, the unanswered requests will be sent again using a new connection
+        if (!reused)
+        {
+            tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+            if (!tb_http_stream_clos(http, tb_null)) break;
+        }
+
+        // switch to the next url
+        if (!tb_http_pipeline_url(http, http->pipeline_next))
+        {
+            http->status.state = TB_STATE_HTTP_REQUEST_FAILED;
+            break;
+        }
+        tb_url_copy(&http->option.url, &http->pipeline_url);
+        http->pipeline_next++;
+
+        // read the next response from the current connection
+        if (reused)
+        {
+            // clear status
+            tb_http_status_cler(&http->status, tb_false);
+            http->head_offset = 0;
+
+            // response it
+            ok = tb_http_response(http);
+        }
+        // send the current and left requests again using a new connection
+        else ok = tb_http_open_done(http);
+
+        // the connection has been closed by the server before responding it? retry it using a new connection
+        if (!ok && (reused || http->bpooled) && !http->status.code && http->status.state != TB_STATE_KILLED && tb_http_idempotent(http))
+        {
+            // trace
+            tb_trace_d("next: the connection is broken, retry it");
+
+            // close the broken connection
+            tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+            if (!tb_http_stream_clos(http, tb_null)) break;
+
+            // retry it
+            ok = tb_http_open_done(http);
+        }
+
+    } while (0);
+
+    // ok?
+    return ok;
+}
 tb_bool_t tb_http_ctrl(tb_http_ref_t self, tb_size_t option, ...)
 {
     // check
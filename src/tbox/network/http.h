@@ -150,6 +150,7 @@ typedef enum __tb_http_option_e
 ,   TB_HTTP_OPTION_GET_POST_FUNC        = TB_HTTP_OPTION_CODE_GET(18)
 ,   TB_HTTP_OPTION_GET_POST_PRIV        = TB_HTTP_OPTION_CODE_GET(19)
 ,   TB_HTTP_OPTION_GET_POST_LRATE       = TB_HTTP_OPTION_CODE_GET(20)
+,   TB_HTTP_OPTION_GET_POOL             = TB_HTTP_OPTION_CODE_GET(21)
 
 ,   TB_HTTP_OPTION_SET_SSL              = TB_HTTP_OPTION_CODE_SET(1)
 ,   TB_HTTP_OPTION_SET_URL              = TB_HTTP_OPTION_CODE_SET(2)
@@ -171,6 +172,7 @@ typedef enum __tb_http_option_e
 ,   TB_HTTP_OPTION_SET_POST_FUNC        = TB_HTTP_OPTION_CODE_SET(18)
 ,   TB_HTTP_OPTION_SET_POST_PRIV        = TB_HTTP_OPTION_CODE_SET(19)
 ,   TB_HTTP_OPTION_SET_POST_LRATE       = TB_HTTP_OPTION_CODE_SET(20)
+,   TB_HTTP_OPTION_SET_POOL             = TB_HTTP_OPTION_CODE_SET(21)
 
 }tb_http_option_e;
 
@@ -224,6 +226,9 @@ typedef struct __tb_http_option_t
     /// the redirect maxn
     tb_uint16_t         redirect    : 10;
 
+    /// reuse the kept-alive connection from the shared connection pool?
+    tb_uint16_t         bpool       : 1;
+
     /// the url
     tb_url_t            url;
 
@@ -386,6 +391,50 @@ tb_long_t               tb_http_read(tb_http_ref_t http, tb_byte_t* data, tb_siz
  */
 tb_bool_t               tb_http_bread(tb_http_ref_t http, tb_byte_t* data, tb_size_t size);
 
+/*! push a pipelined request
+ *
+ * the pipelined requests will be sent with the request of the current url by one write in tb_http_open(), 
+ * and their responses will be read in order from the same kept-alive connection by tb_http_pipeline_next().
+ *
+ * - only the GET and HEAD requests can be pipelined, and they use the same options
+ * - the pipelined responses will not be redirected and the error responses will not fail the opening, please check the status code
+ * - the unanswered requests will be sent again using a new connection if the server closes it
+ * - the pipelined requests will be cleared after closing the http
+ *
+ * @code
+    tb_http_ctrl(http, TB_HTTP_OPTION_SET_URL, "http://www.xxx.com/item?id=0");
+    tb_http_pipeline_push(http, "/item?id=1");
+    tb_http_pipeline_push(http, "/item?id=2");
+    if (tb_http_open(http))
+    {
+        do
+        {
+            // read the current response
+            // ...
+
+        } while (tb_http_pipeline_next(http));
+        tb_http_clos(http);
+    }
+ * @endcode
+ *
+ * @param http          the http 
+ * @param url           the path with args or the full url on the same server
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_http_pipeline_push(tb_http_ref_t http, tb_char_t const* url);
+
+/*! open the response of the next pipelined request
+ *
+ * the left body of the current response will be discarded, 
+ * and the url option will be changed to the url of the next request.
+ *
+ * @param http          the http 
+ *
+ * @return              tb_true or tb_false if no more responses or failed
+ */
+tb_bool_t               tb_http_pipeline_next(tb_http_ref_t http);
+
 /*! ctrl the http option
  *
  * @param http          the http 
@@ -403,6 +452,23 @@ tb_bool_t               tb_http_ctrl(tb_http_ref_t http, tb_size_t option, ...);
  */
 tb_http_status_t const* tb_http_status(tb_http_ref_t http);
 
+/*! set the limits of the shared connection pool
+ *
+ * the kept-alive connections are shared by all http handles and keyed by (host, port, ssl),
+ * the idle connection will be taken out for the next request to the same server,
+ * and the ssl session is also cached for resuming the new connection.
+ *
+ * the default limits: 8 idle connections of each host and 15s idle timeout
+ *
+ * @param maxn          the idle connections maxn of each host, disable the pool if be zero
+ * @param timeout       the idle timeout (ms), keep the current timeout if <= 0
+ */
+tb_void_t               tb_http_pool_limit(tb_size_t maxn, tb_long_t timeout);
+
+/*! close all idle connections and clear the cached ssl sessions of the shared connection pool
+ */
+tb_void_t               tb_http_pool_clear(tb_noarg_t);
+
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
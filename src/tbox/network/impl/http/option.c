@@ -44,6 +44,7 @@ tb_bool_t tb_http_option_init(tb_http_option_t* option)
     option->timeout    = TB_HTTP_DEFAULT_TIMEOUT;
     option->version    = 1; // HTTP/1.1
     option->bunzip     = 0;
+    option->bpool      = 1;
     option->cookies    = tb_null;
 
     // init url
@@ -555,6 +556,27 @@ tb_bool_t tb_http_option_ctrl(tb_http_option_t* option, tb_size_t code, tb_va_li
             return tb_true;
         }
         break;
+    case TB_HTTP_OPTION_SET_POOL:
+        {
+            // bpool
+            tb_bool_t bpool = (tb_bool_t)tb_va_arg(args, tb_bool_t);
+
+            // set bpool
+            option->bpool = bpool? 1 : 0;
+            return tb_true;
+        }
+        break;
+    case TB_HTTP_OPTION_GET_POOL:
+        {
+            // pbpool
+            tb_bool_t* pbpool = (tb_bool_t*)tb_va_arg(args, tb_bool_t*);
+            tb_assert_and_check_return_val(pbpool, tb_false);
+
+            // get bpool
+            *pbpool = option->bpool? tb_true : tb_false;
+            return tb_true;
+        }
+        break;
     case TB_HTTP_OPTION_SET_REDIRECT:
         {
             // redirect
@@ -620,6 +642,7 @@ tb_void_t tb_http_option_dump(tb_http_option_t* option)
     tb_trace_i("option: redirect: %d",          option->redirect);
     tb_trace_i("option: range: %llu-%llu",      option->range.bof, option->range.eof);
     tb_trace_i("option: bunzip: %s",            option->bunzip? "true" : "false");
+    tb_trace_i("option: bpool: %s",             option->bpool? "true" : "false");
 
     // dump head 
     tb_char_t const*    head_data = (tb_char_t const*)tb_buffer_data(&option->head_data);
@@ -0,0 +1,644 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pool.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "http_pool"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "pool.h"
+#include "../../../utils/utils.h"
+#include "../../../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the idle connections maxn of all hosts
+#ifdef __tb_small__
+#   define TB_HTTP_POOL_CONN_MAXN           (16)
+#else
+#   define TB_HTTP_POOL_CONN_MAXN           (64)
+#endif
+
+// the cached ssl sessions maxn
+#ifdef __tb_small__
+#   define TB_HTTP_POOL_SESSION_MAXN        (8)
+#else
+#   define TB_HTTP_POOL_SESSION_MAXN        (32)
+#endif
+
+// the default idle connections maxn of each host
+#define TB_HTTP_POOL_DEFAULT_HOST_MAXN      (8)
+
+// the default idle timeout, 15s
+#define TB_HTTP_POOL_DEFAULT_TIMEOUT        (15000)
+
+// the key maxn
+#define TB_HTTP_POOL_KEY_MAXN               (512)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the idle connection type
+typedef struct __tb_http_pool_conn_t
+{
+    // the list entry
+    tb_list_entry_t         entry;
+
+    // the sock stream
+    tb_stream_ref_t         stream;
+
+    // the idle time
+    tb_hong_t               time;
+
+    // the key: "http[s]://host:port"
+    tb_char_t               key[1];
+
+}tb_http_pool_conn_t;
+
+// the cached ssl session type
+typedef struct __tb_http_pool_session_t
+{
+    // the list entry
+    tb_list_entry_t         entry;
+
+    // the ssl session
+    tb_ssl_session_ref_t    session;
+
+    // the reference count
+    tb_size_t               refn;
+
+    // is cached? it will be exited after the last reference is put if not cached
+    tb_bool_t               cached;
+
+    // the key: "http[s]://host:port"
+    tb_char_t               key[1];
+
+}tb_http_pool_session_t;
+
+/* the http pool type
+ *
+ * the idle connections of all handles are shared by (host, port, ssl),
+ * and the last ssl session of each server is cached for resuming the new connection.
+ */
+typedef struct __tb_http_pool_t
+{
+    // the lock
+    tb_spinlock_t           lock;
+
+    // the idle connections, the recently used connection is at head
+    tb_list_entry_head_t    conns;
+
+    // the cached ssl sessions, the recently used session is at head
+    tb_list_entry_head_t    sessions;
+
+    // the idle connections maxn of each host, the pool is disabled if be zero
+    tb_size_t               host_maxn;
+
+    // the idle timeout
+    tb_long_t               timeout;
+
+}tb_http_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_size_t tb_http_pool_key(tb_url_ref_t url, tb_char_t* key, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(url && key && maxn, 0);
+
+    // the host
+    tb_char_t const* host = tb_url_host(url);
+    tb_check_return_val(host, 0);
+
+    // make key
+    tb_long_t size = tb_snprintf(key, maxn - 1, "%s://%s:%u", tb_url_ssl(url)? "https" : "http", host, tb_url_port(url));
+    tb_check_return_val(size > 0 && (tb_size_t)size < maxn - 1, 0);
+    key[size] = '\0';
+
+    // ok
+    return (tb_size_t)size;
+}
+static tb_void_t tb_http_pool_conn_exit(tb_http_pool_conn_t* conn)
+{
+    // check
+    tb_assert_and_check_return(conn);
+
+    // trace
+    tb_trace_d("conn: exit: %s", conn->key);
+
+    // exit stream and close the kept-alive connection
+    if (conn->stream)
+    {
+        tb_stream_ctrl(conn->stream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+        tb_stream_exit(conn->stream);
+    }
+    conn->stream = tb_null;
+
+    // exit it
+    tb_free(conn);
+}
+static tb_void_t tb_http_pool_session_exit(tb_http_pool_session_t* session)
+{
+    // check
+    tb_assert_and_check_return(session);
+
+#ifdef TB_SSL_ENABLE
+    // exit the ssl session
+    if (session->session) tb_ssl_session_exit(session->session);
+#endif
+    session->session = tb_null;
+
+    // exit it
+    tb_free(session);
+}
+static tb_void_t tb_http_pool_conns_exit(tb_list_entry_head_ref_t conns)
+{
+    // exit all connections
+    while (tb_list_entry_size(conns))
+    {
+        // the last entry
+        tb_list_entry_ref_t last = tb_list_entry_last(conns);
+        tb_list_entry_remove_last(conns);
+
+        // exit it
+        tb_http_pool_conn_exit((tb_http_pool_conn_t*)tb_list_entry(conns, last));
+    }
+}
+static tb_bool_t tb_http_pool_conn_alived(tb_http_pool_conn_t* conn)
+{
+    // check
+    tb_assert_and_check_return_val(conn && conn->stream, tb_false);
+
+    // the socket
+    tb_socket_ref_t sock = tb_null;
+    if (!tb_stream_ctrl(conn->stream, TB_STREAM_CTRL_SOCK_GET_SOCK, &sock) || !sock) return tb_false;
+
+    /* probe it
+     *
+     * the idle connection must have not any data,
+     * so it has been closed by the server or broken if be readable.
+     */
+    return !tb_socket_wait(sock, TB_SOCKET_EVENT_RECV, 0);
+}
+static tb_handle_t tb_http_pool_instance_init(tb_cpointer_t* ppriv)
+{
+    // make pool
+    tb_http_pool_t* pool = tb_malloc0_type(tb_http_pool_t);
+    tb_assert_and_check_return_val(pool, tb_null);
+
+    // init lock
+    if (!tb_spinlock_init(&pool->lock))
+    {
+        tb_free(pool);
+        return tb_null;
+    }
+
+    // init lists
+    tb_list_entry_init(&pool->conns, tb_http_pool_conn_t, entry, tb_null);
+    tb_list_entry_init(&pool->sessions, tb_http_pool_session_t, entry, tb_null);
+
+    // init limits
+    pool->host_maxn = TB_HTTP_POOL_DEFAULT_HOST_MAXN;
+    pool->timeout   = TB_HTTP_POOL_DEFAULT_TIMEOUT;
+
+    // ok
+    return (tb_handle_t)pool;
+}
+static tb_void_t tb_http_pool_instance_exit(tb_handle_t handle, tb_cpointer_t priv)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)handle;
+    tb_assert_and_check_return(pool);
+
+    // exit all idle connections
+    tb_http_pool_conns_exit(&pool->conns);
+    tb_list_entry_exit(&pool->conns);
+
+    // exit all cached sessions, they have not been referenced now
+    while (tb_list_entry_size(&pool->sessions))
+    {
+        // the last entry
+        tb_list_entry_ref_t last = tb_list_entry_last(&pool->sessions);
+        tb_list_entry_remove_last(&pool->sessions);
+
+        // exit it
+        tb_http_pool_session_exit((tb_http_pool_session_t*)tb_list_entry(&pool->sessions, last));
+    }
+    tb_list_entry_exit(&pool->sessions);
+
+    // exit lock
+    tb_spinlock_exit(&pool->lock);
+
+    // exit it
+    tb_free(pool);
+}
+static tb_http_pool_t* tb_http_pool()
+{
+    return (tb_http_pool_t*)tb_singleton_instance(TB_SINGLETON_TYPE_HTTP_POOL, tb_http_pool_instance_init, tb_http_pool_instance_exit, tb_null, tb_null);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_stream_ref_t tb_http_pool_conn_get(tb_url_ref_t url)
+{
+    // the pool
+    tb_http_pool_t* pool = tb_http_pool();
+    tb_check_return_val(pool, tb_null);
+
+    // make key
+    tb_char_t key[TB_HTTP_POOL_KEY_MAXN];
+    tb_check_return_val(tb_http_pool_key(url, key, sizeof(key)), tb_null);
+
+    // done
+    tb_stream_ref_t         stream = tb_null;
+    tb_http_pool_conn_t*    conn = tb_null;
+    tb_list_entry_head_t    removed;
+    tb_list_entry_init(&removed, tb_http_pool_conn_t, entry, tb_null);
+    while (!stream)
+    {
+        // enter
+        tb_spinlock_enter(&pool->lock);
+
+        // take out the recently used connection of this host and remove all expired connections
+        conn = tb_null;
+        tb_hong_t           now = tb_mclock();
+        tb_list_entry_ref_t item = tb_list_entry_head(&pool->conns);
+        tb_list_entry_ref_t tail = tb_list_entry_tail(&pool->conns);
+        while (item != tail)
+        {
+            // the next item
+            tb_list_entry_ref_t next = tb_list_entry_next(item);
+
+            // expired?
+            tb_http_pool_conn_t* idle = (tb_http_pool_conn_t*)tb_list_entry(&pool->conns, item);
+            if (now - idle->time > pool->timeout)
+            {
+                tb_list_entry_remove(&pool->conns, item);
+                tb_list_entry_insert_tail(&removed, item);
+            }
+            // found?
+            else if (!conn && !tb_stricmp(idle->key, key))
+            {
+                tb_list_entry_remove(&pool->conns, item);
+                conn = idle;
+            }
+
+            // the next item
+            item = next;
+        }
+
+        // leave
+        tb_spinlock_leave(&pool->lock);
+
+        // exit the expired connections outside the lock
+        tb_http_pool_conns_exit(&removed);
+
+        // not found?
+        tb_check_break(conn);
+
+        // is alived? take the stream
+        if (tb_http_pool_conn_alived(conn))
+        {
+            stream = conn->stream;
+            conn->stream = tb_null;
+        }
+
+        // trace
+        tb_trace_d("conn: get: %s, %s", key, stream? "ok" : "dead");
+
+        // exit the connection entry
+        tb_http_pool_conn_exit(conn);
+    }
+
+    // exit the removed list
+    tb_list_entry_exit(&removed);
+
+    // ok?
+    return stream;
+}
+tb_bool_t tb_http_pool_conn_put(tb_url_ref_t url, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(url && stream, tb_false);
+
+    // the pool
+    tb_http_pool_t* pool = tb_http_pool();
+    tb_check_return_val(pool && pool->host_maxn, tb_false);
+
+    // make key
+    tb_char_t key[TB_HTTP_POOL_KEY_MAXN];
+    tb_size_t size = tb_http_pool_key(url, key, sizeof(key));
+    tb_check_return_val(size, tb_false);
+
+    // make connection
+    tb_http_pool_conn_t* conn = (tb_http_pool_conn_t*)tb_malloc0(sizeof(tb_http_pool_conn_t) + size);
+    tb_assert_and_check_return_val(conn, tb_false);
+
+    // init connection
+    conn->stream    = stream;
+    conn->time      = tb_mclock();
+    tb_memcpy(conn->key, key, size + 1);
+
+    // enter
+    tb_list_entry_head_t removed;
+    tb_list_entry_init(&removed, tb_http_pool_conn_t, entry, tb_null);
+    tb_spinlock_enter(&pool->lock);
+
+    // insert it to the head
+    tb_list_entry_insert_head(&pool->conns, &conn->entry);
+
+    // remove the least recently used connections of this host if be full
+    tb_size_t           count = 0;
+    tb_list_entry_ref_t item = tb_list_entry_head(&pool->conns);
+    tb_list_entry_ref_t tail = tb_list_entry_tail(&pool->conns);
+    while (item != tail)
+    {
+        // the next item
+        tb_list_entry_ref_t next = tb_list_entry_next(item);
+
+        // full for this host?
+        tb_http_pool_conn_t* idle = (tb_http_pool_conn_t*)tb_list_entry(&pool->conns, item);
+        if (!tb_stricmp(idle->key, key) && ++count > pool->host_maxn)
+        {
+            tb_list_entry_remove(&pool->conns, item);
+            tb_list_entry_insert_tail(&removed, item);
+        }
+
+        // the next item
+        item = next;
+    }
+
+    // remove the least recently used connections of all hosts if be full
+    while (tb_list_entry_size(&pool->conns) > TB_HTTP_POOL_CONN_MAXN)
+    {
+        tb_list_entry_ref_t last = tb_list_entry_last(&pool->conns);
+        tb_list_entry_remove_last(&pool->conns);
+        tb_list_entry_insert_tail(&removed, last);
+    }
+
+    // leave
+    tb_spinlock_leave(&pool->lock);
+
+    // trace
+    tb_trace_d("conn: put: %s, removed: %lu", key, tb_list_entry_size(&removed));
+
+    // exit the removed connections outside the lock
+    tb_http_pool_conns_exit(&removed);
+    tb_list_entry_exit(&removed);
+
+    // ok
+    return tb_true;
+}
+tb_http_pool_session_ref_t tb_http_pool_session_get(tb_url_ref_t url)
+{
+    // the pool
+    tb_http_pool_t* pool = tb_http_pool();
+    tb_check_return_val(pool, tb_null);
+
+    // make key
+    tb_char_t key[TB_HTTP_POOL_KEY_MAXN];
+    tb_check_return_val(tb_http_pool_key(url, key, sizeof(key)), tb_null);
+
+    // enter
+    tb_spinlock_enter(&pool->lock);
+
+    // find it
+    tb_http_pool_session_t* session = tb_null;
+    tb_list_entry_ref_t     item = tb_list_entry_head(&pool->sessions);
+    tb_list_entry_ref_t     tail = tb_list_entry_tail(&pool->sessions);
+    for (; item != tail; item = tb_list_entry_next(item))
+    {
+        tb_http_pool_session_t* cached = (tb_http_pool_session_t*)tb_list_entry(&pool->sessions, item);
+        if (!tb_stricmp(cached->key, key))
+        {
+            // refer it
+            cached->refn++;
+            session = cached;
+            break;
+        }
+    }
+
+    // leave
+    tb_spinlock_leave(&pool->lock);
+
+    // ok?
+    return (tb_http_pool_session_ref_t)session;
+}
+tb_ssl_session_ref_t tb_http_pool_session_ssl(tb_http_pool_session_ref_t self)
+{
+    // check
+    tb_http_pool_session_t* session = (tb_http_pool_session_t*)self;
+    tb_assert_and_check_return_val(session, tb_null);
+
+    // the ssl session
+    return session->session;
+}
+tb_void_t tb_http_pool_session_put(tb_http_pool_session_ref_t self)
+{
+    // check
+    tb_http_pool_session_t* session = (tb_http_pool_session_t*)self;
+    tb_assert_and_check_return(session);
+
+    // the pool
+    tb_http_pool_t* pool = tb_http_pool();
+    tb_assert_and_check_return(pool);
+
+    // enter
+    tb_spinlock_enter(&pool->lock);
+
+    // unrefer it, it will be exited if it has been removed from the cache
+    tb_assert(session->refn);
+    tb_bool_t removed = (!--session->refn && !session->cached);
+
+    // leave
+    tb_spinlock_leave(&pool->lock);
+
+    // exit it
+    if (removed) tb_http_pool_session_exit(session);
+}
+tb_void_t tb_http_pool_session_save(tb_url_ref_t url, tb_ssl_session_ref_t ssl_session)
+{
+    // check
+    tb_check_return(url && ssl_session);
+
+    // done
+    tb_http_pool_session_t* session = tb_null;
+    tb_list_entry_head_t    removed;
+    tb_list_entry_init(&removed, tb_http_pool_session_t, entry, tb_null);
+    do
+    {
+        // the pool
+        tb_http_pool_t* pool = tb_http_pool();
+        tb_check_break(pool && pool->host_maxn);
+
+        // make key
+        tb_char_t key[TB_HTTP_POOL_KEY_MAXN];
+        tb_size_t size = tb_http_pool_key(url, key, sizeof(key));
+        tb_check_break(size);
+
+        // make session
+        session = (tb_http_pool_session_t*)tb_malloc0(sizeof(tb_http_pool_session_t) + size);
+        tb_assert_and_check_break(session);
+
+        // init session
+        session->session    = ssl_session;
+        session->cached     = tb_true;
+        tb_memcpy(session->key, key, size + 1);
+
+        // enter
+        tb_spinlock_enter(&pool->lock);
+
+        // remove the old session of this host
+        tb_list_entry_ref_t item = tb_list_entry_head(&pool->sessions);
+        tb_list_entry_ref_t tail = tb_list_entry_tail(&pool->sessions);
+        for (; item != tail; item = tb_list_entry_next(item))
+        {
+            tb_http_pool_session_t* cached = (tb_http_pool_session_t*)tb_list_entry(&pool->sessions, item);
+            if (!tb_stricmp(cached->key, key))
+            {
+                tb_list_entry_remove(&pool->sessions, item);
+                tb_list_entry_insert_tail(&removed, item);
+                break;
+            }
+        }
+
+        // insert the new session to the head
+        tb_list_entry_insert_head(&pool->sessions, &session->entry);
+
+        // remove the least recently used session if be full
+        if (tb_list_entry_size(&pool->sessions) > TB_HTTP_POOL_SESSION_MAXN)
+        {
+            tb_list_entry_ref_t last = tb_list_entry_last(&pool->sessions);
+            tb_list_entry_remove_last(&pool->sessions);
+            tb_list_entry_insert_tail(&removed, last);
+        }
+
+        // detach the removed sessions, the referenced sessions will be exited after the last reference is put
+        item = tb_list_entry_head(&removed);
+        tail = tb_list_entry_tail(&removed);
+        while (item != tail)
+        {
+            // the next item
+            tb_list_entry_ref_t next = tb_list_entry_next(item);
+
+            // detach it
+            tb_http_pool_session_t* old = (tb_http_pool_session_t*)tb_list_entry(&removed, item);
+            old->cached = tb_false;
+            if (old->refn) tb_list_entry_remove(&removed, item);
+
+            // the next item
+            item = next;
+        }
+
+        // leave
+        tb_spinlock_leave(&pool->lock);
+
+        // trace
+        tb_trace_d("session: save: %s", key);
+
+        // ok
+        ssl_session = tb_null;
+
+    } while (0);
+
+    // failed? exit the ssl session
+    if (ssl_session)
+    {
+        if (session) tb_free(session);
+#ifdef TB_SSL_ENABLE
+        tb_ssl_session_exit(ssl_session);
+#endif
+    }
+
+    // exit the removed sessions outside the lock
+    while (tb_list_entry_size(&removed))
+    {
+        tb_list_entry_ref_t last = tb_list_entry_last(&removed);
+        tb_list_entry_remove_last(&removed);
+        tb_http_pool_session_exit((tb_http_pool_session_t*)tb_list_entry(&removed, last));
+    }
+    tb_list_entry_exit(&removed);
+}
+tb_void_t tb_http_pool_limit(tb_size_t maxn, tb_long_t timeout)
+{
+    // the pool
+    tb_http_pool_t* pool = tb_http_pool();
+    tb_assert_and_check_return(pool);
+
+    // set limits
+    tb_spinlock_enter(&pool->lock);
+    pool->host_maxn = maxn;
+    if (timeout > 0) pool->timeout = timeout;
+    tb_spinlock_leave(&pool->lock);
+
+    // disabled? clear it
+    if (!maxn) tb_http_pool_clear();
+}
+tb_void_t tb_http_pool_clear()
+{
+    // the pool
+    tb_http_pool_t* pool = tb_http_pool();
+    tb_check_return(pool);
+
+    // enter
+    tb_list_entry_head_t conns;
+    tb_list_entry_head_t sessions;
+    tb_list_entry_init(&conns, tb_http_pool_conn_t, entry, tb_null);
+    tb_list_entry_init(&sessions, tb_http_pool_session_t, entry, tb_null);
+    tb_spinlock_enter(&pool->lock);
+
+    // take out all connections
+    tb_list_entry_splice_tail(&conns, &pool->conns);
+
+    // take out all unreferenced sessions and detach the referenced sessions
+    while (tb_list_entry_size(&pool->sessions))
+    {
+        tb_list_entry_ref_t last = tb_list_entry_last(&pool->sessions);
+        tb_list_entry_remove_last(&pool->sessions);
+
+        tb_http_pool_session_t* session = (tb_http_pool_session_t*)tb_list_entry(&pool->sessions, last);
+        session->cached = tb_false;
+        if (!session->refn) tb_list_entry_insert_tail(&sessions, last);
+    }
+
+    // leave
+    tb_spinlock_leave(&pool->lock);
+
+    // exit them outside the lock
+    tb_http_pool_conns_exit(&conns);
+    while (tb_list_entry_size(&sessions))
+    {
+        tb_list_entry_ref_t last = tb_list_entry_last(&sessions);
+        tb_list_entry_remove_last(&sessions);
+        tb_http_pool_session_exit((tb_http_pool_session_t*)tb_list_entry(&sessions, last));
+    }
+    tb_list_entry_exit(&conns);
+    tb_list_entry_exit(&sessions);
+}
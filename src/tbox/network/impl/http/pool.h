@@ -0,0 +1,102 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pool.h
+ */
+#ifndef TB_NETWORK_IMPL_HTTP_POOL_H
+#define TB_NETWORK_IMPL_HTTP_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../../ssl.h"
+#include "../../../stream/stream.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the cached ssl session ref type of the http pool
+typedef __tb_typeref__(http_pool_session);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* take an idle connection of the given url out from the pool
+ *
+ * the connection is keyed by (host, port, ssl), the expired and dead connections will be discarded.
+ *
+ * @param url           the url
+ *
+ * @return              the closed sock stream with the kept-alive connection, tb_null if not found
+ */
+tb_stream_ref_t         tb_http_pool_conn_get(tb_url_ref_t url);
+
+/* put the idle connection back to the pool
+ *
+ * @param url           the url
+ * @param stream        the closed sock stream with the kept-alive connection, the pool will own it if ok
+ *
+ * @return              tb_true or tb_false if the pool is disabled
+ */
+tb_bool_t               tb_http_pool_conn_put(tb_url_ref_t url, tb_stream_ref_t stream);
+
+/* get the cached ssl session of the given url
+ *
+ * the session is referenced until tb_http_pool_session_put() is called.
+ *
+ * @param url           the url
+ *
+ * @return              the cached session, tb_null if not found
+ */
+tb_http_pool_session_ref_t tb_http_pool_session_get(tb_url_ref_t url);
+
+/* the ssl session of the cached session
+ *
+ * @param session       the cached session
+ *
+ * @return              the ssl session
+ */
+tb_ssl_session_ref_t    tb_http_pool_session_ssl(tb_http_pool_session_ref_t session);
+
+/* put the cached ssl session
+ *
+ * @param session       the cached session
+ */
+tb_void_t               tb_http_pool_session_put(tb_http_pool_session_ref_t session);
+
+/* save the ssl session of the given url for resuming the next connection
+ *
+ * @param url           the url
+ * @param session       the ssl session, the pool will own it
+ */
+tb_void_t               tb_http_pool_session_save(tb_url_ref_t url, tb_ssl_session_ref_t session);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
@@ -705,3 +705,72 @@ tb_size_t tb_ssl_state(tb_ssl_ref_t self)
     // the state
     return ssl->state;
 }
+tb_ssl_session_ref_t tb_ssl_get_session(tb_ssl_ref_t self)
+{
+    // check
+    tb_ssl_t* ssl = (tb_ssl_t*)self;
+    tb_assert_and_check_return_val(ssl, tb_null);
+
+    // opened?
+    tb_check_return_val(ssl->bopened, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    mbedtls_ssl_session*    session = tb_null;
+    do
+    {
+        // make session
+        session = tb_malloc0_type(mbedtls_ssl_session);
+        tb_assert_and_check_break(session);
+
+        // init session
+        mbedtls_ssl_session_init(session);
+
+        // copy the current session
+        if (mbedtls_ssl_get_session(&ssl->ssl, session)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        if (session) tb_ssl_session_exit((tb_ssl_session_ref_t)session);
+        session = tb_null;
+    }
+
+    // ok?
+    return (tb_ssl_session_ref_t)session;
+}
+tb_bool_t tb_ssl_set_session(tb_ssl_ref_t self, tb_ssl_session_ref_t session)
+{
+    // check
+    tb_ssl_t* ssl = (tb_ssl_t*)self;
+    tb_assert_and_check_return_val(ssl && session, tb_false);
+
+    // must be closed
+    tb_assert_and_check_return_val(!ssl->bopened, tb_false);
+
+    // set session, it will be copied
+    return !mbedtls_ssl_set_session(&ssl->ssl, (mbedtls_ssl_session const*)session);
+}
+tb_bool_t tb_ssl_is_resumed(tb_ssl_ref_t self)
+{
+    // check
+    tb_assert_and_check_return_val(self, tb_false);
+
+    // the handshake info has been freed after opening, so we cannot know it
+    return tb_false;
+}
+tb_void_t tb_ssl_session_exit(tb_ssl_session_ref_t self)
+{
+    // check
+    mbedtls_ssl_session* session = (mbedtls_ssl_session*)self;
+    tb_check_return(session);
+
+    // exit it
+    mbedtls_ssl_session_free(session);
+    tb_free(session);
+}
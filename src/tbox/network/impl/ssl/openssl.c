@@ -842,3 +842,58 @@ tb_size_t tb_ssl_state(tb_ssl_ref_t self)
     return ssl->state;
 }
 
+tb_ssl_session_ref_t tb_ssl_get_session(tb_ssl_ref_t self)
+{
+    // the ssl
+    tb_ssl_t* ssl = (tb_ssl_t*)self;
+    tb_assert_and_check_return_val(ssl && ssl->ssl, tb_null);
+
+    // opened?
+    tb_check_return_val(ssl->bopened, tb_null);
+
+    // get a new reference of the session
+    SSL_SESSION* session = SSL_get1_session(ssl->ssl);
+    tb_check_return_val(session, tb_null);
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+    /* not resumable? 
+     *
+     * the tls1.3 session is resumable only after the new session ticket has been received,
+     * so we need get it after reading some data.
+     */
+    if (!SSL_SESSION_is_resumable(session))
+    {
+        SSL_SESSION_free(session);
+        return tb_null;
+    }
+#endif
+
+    // ok
+    return (tb_ssl_session_ref_t)session;
+}
+tb_bool_t tb_ssl_set_session(tb_ssl_ref_t self, tb_ssl_session_ref_t session)
+{
+    // the ssl
+    tb_ssl_t* ssl = (tb_ssl_t*)self;
+    tb_assert_and_check_return_val(ssl && ssl->ssl && session, tb_false);
+
+    // must be closed
+    tb_assert_and_check_return_val(!ssl->bopened, tb_false);
+
+    // set session, it will increase the reference count of the session
+    return SSL_set_session(ssl->ssl, (SSL_SESSION*)session) == 1;
+}
+tb_bool_t tb_ssl_is_resumed(tb_ssl_ref_t self)
+{
+    // the ssl
+    tb_ssl_t* ssl = (tb_ssl_t*)self;
+    tb_assert_and_check_return_val(ssl && ssl->ssl, tb_false);
+
+    // resumed?
+    return ssl->bopened && SSL_session_reused(ssl->ssl);
+}
+tb_void_t tb_ssl_session_exit(tb_ssl_session_ref_t session)
+{
+    // exit it
+    if (session) SSL_SESSION_free((SSL_SESSION*)session);
+}
@@ -81,6 +81,13 @@ typedef tb_long_t   (*tb_ssl_func_wait_t)(tb_cpointer_t priv, tb_size_t code, tb
 /// the ssl ref type
 typedef __tb_typeref__(ssl);
 
+/*! the ssl session ref type
+ *
+ * it's used to resume the ssl session for the new connection to the same server 
+ * and skip the full handshake.
+ */
+typedef __tb_typeref__(ssl_session);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -221,6 +228,41 @@ tb_long_t           tb_ssl_wait(tb_ssl_ref_t ssl, tb_size_t events, tb_long_t ti
  */
 tb_size_t           tb_ssl_state(tb_ssl_ref_t ssl);
 
+/*! get the session of the opened ssl
+ *
+ * @note the session is a new copy, please exit it using tb_ssl_session_exit()
+ *
+ * @param ssl       the ssl
+ *
+ * @return          the session, tb_null if no session or it is not resumable
+ */
+tb_ssl_session_ref_t tb_ssl_get_session(tb_ssl_ref_t ssl);
+
+/*! set the session to be resumed for the next handshake
+ *
+ * @note it must be called before opening ssl and the ssl will refer or copy it
+ *
+ * @param ssl       the ssl
+ * @param session   the session
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_ssl_set_session(tb_ssl_ref_t ssl, tb_ssl_session_ref_t session);
+
+/*! the ssl session has been resumed for the last handshake?
+ *
+ * @param ssl       the ssl
+ *
+ * @return          tb_true or tb_false, always tb_false if the backend cannot report it
+ */
+tb_bool_t           tb_ssl_is_resumed(tb_ssl_ref_t ssl);
+
+/*! exit the ssl session
+ *
+ * @param session   the session
+ */
+tb_void_t           tb_ssl_session_exit(tb_ssl_session_ref_t session);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../algorithm/algorithm.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -94,7 +95,7 @@ static tb_void_t tb_oc_array_exit(tb_object_ref_t object)
     array->vector = tb_null;
 
     // exit it
-    tb_free(array);
+    tb_oc_arena_object_free((tb_object_ref_t)array);
 }
 static tb_void_t tb_oc_array_clear(tb_object_ref_t object)
 {
@@ -112,12 +113,9 @@ static tb_oc_array_t* tb_oc_array_init_base()
     do
     {
         // make array
-        array = tb_malloc0_type(tb_oc_array_t);
+        array = (tb_oc_array_t*)tb_oc_arena_object_make(sizeof(tb_oc_array_t), TB_OBJECT_TYPE_ARRAY);
         tb_assert_and_check_break(array);
 
-        // init array
-        if (!tb_object_init((tb_object_ref_t)array, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_ARRAY)) break;
-
         // init base
         array->base.copy    = tb_oc_array_copy;
         array->base.exit    = tb_oc_array_exit;
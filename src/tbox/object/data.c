@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../utils/utils.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -68,7 +69,7 @@ static tb_void_t tb_oc_data_exit(tb_object_ref_t object)
     if (data) 
     {
         tb_buffer_exit(&data->buffer);
-        tb_free(data);
+        tb_oc_arena_object_free((tb_object_ref_t)data);
     }
 }
 static tb_void_t tb_oc_data_clear(tb_object_ref_t object)
@@ -84,12 +85,9 @@ static tb_oc_data_t* tb_oc_data_init_base()
     do
     {
         // make data
-        data = tb_malloc0_type(tb_oc_data_t);
+        data = (tb_oc_data_t*)tb_oc_arena_object_make(sizeof(tb_oc_data_t), TB_OBJECT_TYPE_DATA);
         tb_assert_and_check_break(data);
 
-        // init data
-        if (!tb_object_init((tb_object_ref_t)data, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DATA)) break;
-
         // init base
         data->base.copy     = tb_oc_data_copy;
         data->base.exit     = tb_oc_data_exit;
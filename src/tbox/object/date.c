@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../utils/utils.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -64,7 +65,7 @@ static tb_object_ref_t tb_oc_date_copy(tb_object_ref_t object)
 }
 static tb_void_t tb_oc_date_exit(tb_object_ref_t object)
 {
-    if (object) tb_free(object);
+    if (object) tb_oc_arena_object_free(object);
 }
 static tb_void_t tb_oc_date_clear(tb_object_ref_t object)
 {
@@ -79,12 +80,9 @@ static tb_oc_date_t* tb_oc_date_init_base()
     do
     {
         // make date
-        date = tb_malloc0_type(tb_oc_date_t);
+        date = (tb_oc_date_t*)tb_oc_arena_object_make(sizeof(tb_oc_date_t), TB_OBJECT_TYPE_DATE);
         tb_assert_and_check_break(date);
 
-        // init date
-        if (!tb_object_init((tb_object_ref_t)date, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DATE)) break;
-
         // init base
         date->base.copy     = tb_oc_date_copy;
         date->base.exit     = tb_oc_date_exit;
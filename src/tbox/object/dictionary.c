@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../string/string.h"
 #include "../algorithm/algorithm.h"
 
@@ -111,7 +112,7 @@ static tb_void_t tb_oc_dictionary_exit(tb_object_ref_t object)
     dictionary->hash = tb_null;
 
     // exit it
-    tb_free(dictionary);
+    tb_oc_arena_object_free((tb_object_ref_t)dictionary);
 }
 static tb_void_t tb_oc_dictionary_clear(tb_object_ref_t object)
 {
@@ -129,12 +130,9 @@ static tb_oc_dictionary_t* tb_oc_dictionary_init_base()
     do
     {
         // make dictionary
-        dictionary = tb_malloc0_type(tb_oc_dictionary_t);
+        dictionary = (tb_oc_dictionary_t*)tb_oc_arena_object_make(sizeof(tb_oc_dictionary_t), TB_OBJECT_TYPE_DICTIONARY);
         tb_assert_and_check_break(dictionary);
 
-        // init dictionary
-        if (!tb_object_init((tb_object_ref_t)dictionary, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DICTIONARY)) break;
-
         // init base
         dictionary->base.copy   = tb_oc_dictionary_copy;
         dictionary->base.exit   = tb_oc_dictionary_exit;
@@ -178,8 +176,9 @@ tb_object_ref_t tb_oc_dictionary_init(tb_size_t size, tb_bool_t incr)
         dictionary->size = size;
         dictionary->incr = incr;
 
-        // init hash
-        dictionary->hash = tb_hash_map_init(size, tb_element_str(tb_true), tb_element_obj());
+        // init hash, the keys will be interned if the dictionary is in the arena
+        tb_oc_arena_ref_t arena = (dictionary->base.flag & TB_OBJECT_FLAG_ARENA)? tb_oc_arena_self() : tb_null;
+        dictionary->hash = tb_hash_map_init(size, arena? tb_oc_arena_element_str(arena) : tb_element_str(tb_true), tb_element_obj());
         tb_assert_and_check_break(dictionary->hash);
 
         // ok
@@ -0,0 +1,411 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena.c
+ * @ingroup     object
+ *
+ */
+ 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "oc_arena"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "arena.h"
+#include "../../hash/fnv32.h"
+#include "../../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum and maximum chunk size, the chunk size will be grown from the minimum size
+#ifdef __tb_small__
+#   define TB_OC_ARENA_CHUNK_MINN           (4 << 10)
+#   define TB_OC_ARENA_CHUNK_MAXN           (64 << 10)
+#else
+#   define TB_OC_ARENA_CHUNK_MINN           (4 << 10)
+#   define TB_OC_ARENA_CHUNK_MAXN           (256 << 10)
+#endif
+
+// the chunk head size
+#define TB_OC_ARENA_CHUNK_HEAD              tb_align8(sizeof(tb_oc_arena_chunk_t))
+
+// the object head size, we save the arena before the object
+#define TB_OC_ARENA_OBJECT_HEAD             tb_align8(sizeof(tb_oc_arena_t*))
+
+// the minimum size of the objects and strings list
+#define TB_OC_ARENA_LIST_MINN               (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the arena chunk type
+typedef struct __tb_oc_arena_chunk_t
+{
+    // the next chunk
+    struct __tb_oc_arena_chunk_t*   next;
+
+}tb_oc_arena_chunk_t;
+
+// the arena type
+typedef struct __tb_oc_arena_t
+{
+    // the root object
+    tb_object_ref_t                 root;
+
+    // the chunks
+    tb_oc_arena_chunk_t*            chunks;
+
+    // the free data head of the current chunk
+    tb_byte_t*                      head;
+
+    // the free data tail of the current chunk
+    tb_byte_t*                      tail;
+
+    // the next chunk size
+    tb_size_t                       chunk_size;
+
+    // the objects which have the containers or buffers, we need release them when exiting arena
+    tb_object_ref_t*                objects;
+
+    // the objects size
+    tb_size_t                       objects_size;
+
+    // the objects maxn
+    tb_size_t                       objects_maxn;
+
+    // the interned strings, the open-addressing hash table 
+    tb_char_t const**               strings;
+
+    // the strings size
+    tb_size_t                       strings_size;
+
+    // the strings maxn, must be power of 2
+    tb_size_t                       strings_maxn;
+
+}tb_oc_arena_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the current arena of this thread
+#ifdef __tb_thread_local__
+static __tb_thread_local__ tb_oc_arena_t*   g_arena_self = tb_null;
+#else
+static tb_thread_local_t                    g_arena_self = TB_THREAD_LOCAL_INIT;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_pointer_t tb_oc_arena_malloc0(tb_oc_arena_t* arena, tb_size_t size)
+{
+    // check
+    tb_assert(arena && size);
+
+    // the current chunk is not enough?
+    size = tb_align8(size);
+    if ((tb_size_t)(arena->tail - arena->head) < size)
+    {
+        // is large data? make a single chunk for it and keep the current chunk
+        tb_bool_t   large = size > (arena->chunk_size >> 2);
+        tb_size_t   chunk_size = large? size : arena->chunk_size;
+
+        // make chunk
+        tb_oc_arena_chunk_t* chunk = (tb_oc_arena_chunk_t*)tb_malloc0_bytes(TB_OC_ARENA_CHUNK_HEAD + chunk_size);
+        tb_assert_and_check_return_val(chunk, tb_null);
+
+        // insert chunk
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+
+        // the large data
+        tb_byte_t* data = (tb_byte_t*)chunk + TB_OC_ARENA_CHUNK_HEAD;
+        if (large) return data;
+
+        // switch to the new chunk
+        arena->head = data;
+        arena->tail = data + chunk_size;
+
+        // grow the next chunk size
+        if (arena->chunk_size < TB_OC_ARENA_CHUNK_MAXN) arena->chunk_size <<= 1;
+    }
+
+    // bump it, the chunk data has been cleared
+    tb_byte_t* data = arena->head;
+    arena->head += size;
+    return data;
+}
+static tb_bool_t tb_oc_arena_strings_grow(tb_oc_arena_t* arena)
+{
+    // make the new strings
+    tb_size_t           maxn = arena->strings_maxn? (arena->strings_maxn << 1) : TB_OC_ARENA_LIST_MINN;
+    tb_char_t const**   strings = tb_nalloc0_type(maxn, tb_char_t const*);
+    tb_assert_and_check_return_val(strings, tb_false);
+
+    // move the interned strings
+    tb_size_t i = 0;
+    for (i = 0; i < arena->strings_maxn; i++)
+    {
+        tb_char_t const* cstr = arena->strings[i];
+        if (cstr)
+        {
+            tb_size_t j = tb_fnv32_1a_make_from_cstr(cstr, 0) & (maxn - 1);
+            while (strings[j]) j = (j + 1) & (maxn - 1);
+            strings[j] = cstr;
+        }
+    }
+
+    // update strings
+    if (arena->strings) tb_free(arena->strings);
+    arena->strings      = strings;
+    arena->strings_maxn = maxn;
+    return tb_true;
+}
+static tb_char_t const* tb_oc_arena_intern(tb_oc_arena_t* arena, tb_char_t const* cstr)
+{
+    // check
+    tb_assert(arena && cstr);
+
+    // grow the strings, the maximum load factor: 1/2
+    if (((arena->strings_size + 1) << 1) > arena->strings_maxn && !tb_oc_arena_strings_grow(arena)) return tb_null;
+
+    // find the interned string
+    tb_size_t mask = arena->strings_maxn - 1;
+    tb_size_t i = tb_fnv32_1a_make_from_cstr(cstr, 0) & mask;
+    for (; arena->strings[i]; i = (i + 1) & mask)
+    {
+        if (!tb_strcmp(arena->strings[i], cstr)) return arena->strings[i];
+    }
+
+    // intern it
+    tb_size_t   size = tb_strlen(cstr);
+    tb_char_t*  data = (tb_char_t*)tb_oc_arena_malloc0(arena, size + 1);
+    tb_assert_and_check_return_val(data, tb_null);
+    if (size) tb_memcpy(data, cstr, size);
+
+    // save it
+    arena->strings[i] = data;
+    arena->strings_size++;
+    return data;
+}
+static tb_void_t tb_oc_arena_element_str_dupl(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data)
+{
+    // check
+    tb_assert_and_check_return(element && element->priv && buff);
+
+    // intern it, we need not free the previous string for replacing it
+    *((tb_char_t const**)buff) = data? tb_oc_arena_intern((tb_oc_arena_t*)element->priv, (tb_char_t const*)data) : tb_null;
+}
+static tb_void_t tb_oc_arena_element_str_ndupl(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(element && buff);
+
+    // intern them
+    tb_size_t i = 0;
+    for (i = 0; i < size; i++) tb_oc_arena_element_str_dupl(element, (tb_byte_t*)buff + i * element->size, data);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_oc_arena_ref_t tb_oc_arena_init()
+{
+    // make arena
+    tb_oc_arena_t* arena = tb_malloc0_type(tb_oc_arena_t);
+    tb_assert_and_check_return_val(arena, tb_null);
+
+    // init arena
+    arena->chunk_size = TB_OC_ARENA_CHUNK_MINN;
+
+    // ok
+    return (tb_oc_arena_ref_t)arena;
+}
+tb_void_t tb_oc_arena_exit(tb_oc_arena_ref_t self)
+{
+    // check
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)self;
+    tb_assert_and_check_return(arena);
+
+    // trace
+    tb_trace_d("exit: objects: %lu, strings: %lu", arena->objects_size, arena->strings_size);
+
+    // clear root first, the root object may be exited by the containers again
+    arena->root = tb_null;
+
+    /* release the containers and buffers of all objects
+     *
+     * the objects in the arena will be not released again by the containers, 
+     * but the other objects inserted by user will be released.
+     */
+    tb_size_t i = 0;
+    for (i = 0; i < arena->objects_size; i++)
+    {
+        tb_object_ref_t object = arena->objects[i];
+        if (object->exit) object->exit(object);
+    }
+
+    // exit objects
+    if (arena->objects) tb_free(arena->objects);
+    arena->objects = tb_null;
+
+    // exit strings
+    if (arena->strings) tb_free(arena->strings);
+    arena->strings = tb_null;
+
+    // exit chunks
+    while (arena->chunks)
+    {
+        tb_oc_arena_chunk_t* next = arena->chunks->next;
+        tb_free(arena->chunks);
+        arena->chunks = next;
+    }
+
+    // exit it
+    tb_free(arena);
+}
+tb_oc_arena_ref_t tb_oc_arena_self()
+{
+#ifdef __tb_thread_local__
+    return (tb_oc_arena_ref_t)g_arena_self;
+#else
+    return (tb_oc_arena_ref_t)tb_thread_local_get(&g_arena_self);
+#endif
+}
+tb_oc_arena_ref_t tb_oc_arena_enter(tb_oc_arena_ref_t arena)
+{
+    // save the previous arena
+    tb_oc_arena_ref_t previous = tb_oc_arena_self();
+
+    // enter it
+#ifdef __tb_thread_local__
+    g_arena_self = (tb_oc_arena_t*)arena;
+#else
+    if (tb_thread_local_init(&g_arena_self, tb_null))
+        tb_thread_local_set(&g_arena_self, arena);
+#endif
+
+    // ok
+    return previous;
+}
+tb_void_t tb_oc_arena_root_set(tb_oc_arena_ref_t self, tb_object_ref_t root)
+{
+    // check
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)self;
+    tb_assert_and_check_return(arena && root && (root->flag & TB_OBJECT_FLAG_ARENA));
+    tb_assert(*((tb_oc_arena_t**)((tb_byte_t*)root - TB_OC_ARENA_OBJECT_HEAD)) == arena);
+
+    // set root
+    arena->root = root;
+}
+tb_element_t tb_oc_arena_element_str(tb_oc_arena_ref_t arena)
+{
+    // init element
+    tb_element_t element = tb_element_str(tb_true);
+    element.priv    = (tb_cpointer_t)arena;
+    element.free    = tb_null;
+    element.dupl    = tb_oc_arena_element_str_dupl;
+    element.repl    = tb_oc_arena_element_str_dupl;
+    element.nfree   = tb_null;
+    element.ndupl   = tb_oc_arena_element_str_ndupl;
+    element.nrepl   = tb_oc_arena_element_str_ndupl;
+
+    // ok
+    return element;
+}
+tb_object_ref_t tb_oc_arena_object_make(tb_size_t size, tb_size_t type)
+{
+    // check
+    tb_assert_and_check_return_val(size >= sizeof(tb_object_t), tb_null);
+
+    // no arena? make it from the default allocator
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)tb_oc_arena_self();
+    if (!arena)
+    {
+        // make object
+        tb_object_ref_t object = (tb_object_ref_t)tb_malloc0(size);
+        tb_assert_and_check_return_val(object, tb_null);
+
+        // init object
+        tb_object_init(object, TB_OBJECT_FLAG_NONE, type);
+        return object;
+    }
+
+    // the object has the containers or buffers? we need release them when exiting arena
+    tb_bool_t owned =   type == TB_OBJECT_TYPE_STRING
+                    ||  type == TB_OBJECT_TYPE_DATA
+                    ||  type == TB_OBJECT_TYPE_ARRAY
+                    ||  type == TB_OBJECT_TYPE_DICTIONARY;
+
+    // grow objects
+    if (owned && arena->objects_size >= arena->objects_maxn)
+    {
+        tb_size_t           maxn = arena->objects_maxn? (arena->objects_maxn << 1) : TB_OC_ARENA_LIST_MINN;
+        tb_object_ref_t*    objects = arena->objects? (tb_object_ref_t*)tb_ralloc(arena->objects, maxn * sizeof(tb_object_ref_t)) : tb_nalloc_type(maxn, tb_object_ref_t);
+        tb_assert_and_check_return_val(objects, tb_null);
+
+        // update objects
+        arena->objects      = objects;
+        arena->objects_maxn = maxn;
+    }
+
+    // make object and save the arena before it
+    tb_byte_t* data = (tb_byte_t*)tb_oc_arena_malloc0(arena, TB_OC_ARENA_OBJECT_HEAD + size);
+    tb_assert_and_check_return_val(data, tb_null);
+    *((tb_oc_arena_t**)data) = arena;
+
+    // init object
+    tb_object_ref_t object = (tb_object_ref_t)(data + TB_OC_ARENA_OBJECT_HEAD);
+    tb_object_init(object, TB_OBJECT_FLAG_ARENA, type);
+
+    // save it
+    if (owned) arena->objects[arena->objects_size++] = object;
+
+    // ok
+    return object;
+}
+tb_void_t tb_oc_arena_object_free(tb_object_ref_t object)
+{
+    // check
+    tb_assert_and_check_return(object);
+
+    // free it if it is not in the arena
+    if (!(object->flag & TB_OBJECT_FLAG_ARENA)) tb_free(object);
+}
+tb_void_t tb_oc_arena_object_exit(tb_object_ref_t object)
+{
+    // check
+    tb_assert_and_check_return(object && (object->flag & TB_OBJECT_FLAG_ARENA));
+
+    // only the root object can exit the arena, the other objects are owned by the arena
+    tb_oc_arena_t* arena = *((tb_oc_arena_t**)((tb_byte_t*)object - TB_OC_ARENA_OBJECT_HEAD));
+    tb_check_return(arena && object == arena->root);
+
+    // check refn
+    tb_assert_and_check_return(object->refn);
+
+    // refn--, exit the arena with all objects
+    if (!--object->refn) tb_oc_arena_exit((tb_oc_arena_ref_t)arena);
+}
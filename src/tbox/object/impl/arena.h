@@ -0,0 +1,120 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_IMPL_ARENA_H
+#define TB_OBJECT_IMPL_ARENA_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the object arena ref type
+ *
+ * all objects of one object tree are allocated from the arena chunks (bump allocator),
+ * and the dictionary keys are interned in the arena.
+ *
+ * the objects in the arena will not be freed one by one, 
+ * we only release the containers and buffers and free all chunks at once when exiting the root object.
+ */
+typedef __tb_typeref__(oc_arena);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the object arena
+ *
+ * @return                  the arena
+ */
+tb_oc_arena_ref_t           tb_oc_arena_init(tb_noarg_t);
+
+/* exit the object arena and all objects in it
+ *
+ * @param arena             the arena
+ */
+tb_void_t                   tb_oc_arena_exit(tb_oc_arena_ref_t arena);
+
+/* the current arena of this thread, all new objects will be allocated from it
+ *
+ * @return                  the arena, tb_null if no arena
+ */
+tb_oc_arena_ref_t           tb_oc_arena_self(tb_noarg_t);
+
+/* enter the given arena on the current thread
+ *
+ * @param arena             the arena, leave the current arena if be null
+ *
+ * @return                  the previous arena
+ */
+tb_oc_arena_ref_t           tb_oc_arena_enter(tb_oc_arena_ref_t arena);
+
+/* set the root object of the arena, the arena will be exited when the root object is exited
+ *
+ * @param arena             the arena
+ * @param root              the root object, it must be allocated from this arena
+ */
+tb_void_t                   tb_oc_arena_root_set(tb_oc_arena_ref_t arena, tb_object_ref_t root);
+
+/* the interned string element for the dictionary keys in the arena
+ *
+ * @param arena             the arena
+ *
+ * @return                  the element
+ */
+tb_element_t                tb_oc_arena_element_str(tb_oc_arena_ref_t arena);
+
+/* make a new object from the current arena or the default allocator and init it
+ *
+ * @param size              the object size
+ * @param type              the object type
+ *
+ * @return                  the object
+ */
+tb_object_ref_t             tb_oc_arena_object_make(tb_size_t size, tb_size_t type);
+
+/* free the object data if it is not allocated from the arena
+ *
+ * @param object            the object
+ */
+tb_void_t                   tb_oc_arena_object_free(tb_object_ref_t object);
+
+/* release the object in the arena, only exit the whole arena for the root object
+ *
+ * @param object            the object
+ */
+tb_void_t                   tb_oc_arena_object_exit(tb_object_ref_t object);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
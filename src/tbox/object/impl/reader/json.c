@@ -31,6 +31,13 @@
  */
 #include "json.h"
 #include "reader.h"
+#include "../../../utils/bits.h"
+#include "../../../libm/libm.h"
+#if defined(TB_ARCH_SSE2)
+#   include <emmintrin.h>
+#elif defined(TB_ARCH_ARM_NEON) || defined(TB_ARCH_ARM64)
+#   include <arm_neon.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -43,9 +50,96 @@
 #   define TB_OC_JSON_READER_ARRAY_GROW             (256)
 #endif
 
+// the maximum nesting depth of the fast parser
+#ifdef __tb_small__
+#   define TB_OC_JSON_PARSER_DEPTH_MAXN             (128)
+#else
+#   define TB_OC_JSON_PARSER_DEPTH_MAXN             (512)
+#endif
+
+/* the maximum size of the left data which will be buffered to the stream cache for the fast parser
+ *
+ * the data stream and the mapped file stream will be parsed directly, we need not buffer them.
+ */
+#ifdef __tb_small__
+#   define TB_OC_JSON_PARSER_NEED_MAXN              (64 << 10)
+#else
+#   define TB_OC_JSON_PARSER_NEED_MAXN              (1 << 20)
+#endif
+
+// the fast parser scans 16 bytes at a time using sse2/neon, or 8 bytes using swar
+#if defined(TB_ARCH_SSE2)
+#   define TB_OC_JSON_PARSER_BLOCK                  (16)
+#   define tb_oc_json_parser_bitmask_index(mask)    tb_bits_cl0_u32_le(mask)
+#elif defined(TB_ARCH_ARM_NEON) || defined(TB_ARCH_ARM64)
+#   define TB_OC_JSON_PARSER_BLOCK                  (16)
+#   define tb_oc_json_parser_bitmask_index(mask)    (tb_bits_cl0_u64_le(mask) >> 2)
+#else
+#   define TB_OC_JSON_PARSER_BLOCK                  (8)
+#   define tb_oc_json_parser_bitmask_index(mask)    (tb_bits_cl0_u64_le(mask) >> 3)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the block bitmask type of the fast parser
+#if defined(TB_ARCH_SSE2)
+typedef tb_uint32_t                 tb_oc_json_parser_bitmask_t;
+#else
+typedef tb_uint64_t                 tb_oc_json_parser_bitmask_t;
+#endif
+
+/* the json fast parser type
+ *
+ * it parses the whole buffered data directly instead of reading it byte by byte from the stream,
+ * the strings without escaped characters are made from the data in place.
+ */
+typedef struct __tb_oc_json_parser_t
+{
+    // the current position
+    tb_char_t const*        p;
+
+    // the end position
+    tb_char_t const*        e;
+
+    // the nesting depth
+    tb_size_t               depth;
+
+    // is too deep? we need parse it using the stream reader
+    tb_bool_t               deep;
+
+    // the string data for the dictionary key and the escaped string
+    tb_string_t             data;
+
+}tb_oc_json_parser_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// have the user hooked reader funcs? we cannot use the fast parser for them
+static tb_bool_t            g_hooked = tb_false;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+static __tb_inline__ tb_char_t tb_oc_json_reader_escape(tb_char_t ch)
+{
+    // the escaped control character?
+    switch (ch)
+    {
+    case 'b': return '\b';
+    case 'f': return '\f';
+    case 'n': return '\n';
+    case 'r': return '\r';
+    case 't': return '\t';
+    default: break;
+    }
+
+    // the escaped character self, e.g. '\\', '\"', '/'
+    return ch;
+}
 static tb_object_ref_t tb_oc_json_reader_func_null(tb_oc_json_reader_t* reader, tb_char_t type)
 {
     // check
@@ -209,7 +303,7 @@ static tb_object_ref_t tb_oc_json_reader_func_string(tb_oc_json_reader_t* reader
 #endif
             }
             // append escaped character
-            else tb_string_chrcat(&data, ch);
+            else tb_string_chrcat(&data, tb_oc_json_reader_escape(ch));
         }
         // append character
         else tb_string_chrcat(&data, ch);
@@ -469,11 +563,628 @@ static tb_object_ref_t tb_oc_json_reader_func_dictionary(tb_oc_json_reader_t* re
     // ok?
     return dictionary;
 }
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * fast parser block implementation
+ */
+#if defined(TB_ARCH_SSE2)
+static __tb_inline__ tb_oc_json_parser_bitmask_t tb_oc_json_parser_block_string(tb_char_t const* p, tb_char_t quote)
+{
+    // find the quote and backslash characters
+    __m128i block = _mm_loadu_si128((__m128i const*)p);
+    __m128i match = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(quote)), _mm_cmpeq_epi8(block, _mm_set1_epi8('\\')));
+    return (tb_oc_json_parser_bitmask_t)_mm_movemask_epi8(match);
+}
+static __tb_inline__ tb_oc_json_parser_bitmask_t tb_oc_json_parser_block_graph(tb_char_t const* p)
+{
+    // find the non-space characters, space: 0x20 or [0x09, 0x0d]
+    __m128i block = _mm_loadu_si128((__m128i const*)p);
+    __m128i ctrl  = _mm_sub_epi8(block, _mm_set1_epi8(0x09));
+    __m128i space = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(0x20)), _mm_cmpeq_epi8(_mm_min_epu8(ctrl, _mm_set1_epi8(0x04)), ctrl));
+    return (tb_oc_json_parser_bitmask_t)(~_mm_movemask_epi8(space) & 0xffff);
+}
+#elif defined(TB_ARCH_ARM_NEON) || defined(TB_ARCH_ARM64)
+static __tb_inline__ tb_oc_json_parser_bitmask_t tb_oc_json_parser_block_bits(uint8x16_t mask)
+{
+    // narrow the byte mask to the nibble mask, one bit per byte
+    uint8x8_t bits = vshrn_n_u16(vreinterpretq_u16_u8(mask), 4);
+    return (tb_oc_json_parser_bitmask_t)vget_lane_u64(vreinterpret_u64_u8(bits), 0) & 0x8888888888888888ULL;
+}
+static __tb_inline__ tb_oc_json_parser_bitmask_t tb_oc_json_parser_block_string(tb_char_t const* p, tb_char_t quote)
+{
+    // find the quote and backslash characters
+    uint8x16_t block = vld1q_u8((tb_byte_t const*)p);
+    return tb_oc_json_parser_block_bits(vorrq_u8(vceqq_u8(block, vdupq_n_u8((tb_byte_t)quote)), vceqq_u8(block, vdupq_n_u8('\\'))));
+}
+static __tb_inline__ tb_oc_json_parser_bitmask_t tb_oc_json_parser_block_graph(tb_char_t const* p)
+{
+    // find the non-space characters, space: 0x20 or [0x09, 0x0d]
+    uint8x16_t block = vld1q_u8((tb_byte_t const*)p);
+    uint8x16_t space = vorrq_u8(vceqq_u8(block, vdupq_n_u8(0x20)), vcleq_u8(vsubq_u8(block, vdupq_n_u8(0x09)), vdupq_n_u8(0x04)));
+    return tb_oc_json_parser_block_bits(vmvnq_u8(space));
+}
+#else
+static __tb_inline__ tb_oc_json_parser_bitmask_t tb_oc_json_parser_block_string(tb_char_t const* p, tb_char_t quote)
+{
+    /* find the zero bytes of (block ^ quote) and (block ^ '\\') using swar
+     *
+     * it may report false positive for the bytes after the real matched byte, 
+     * but the lowest bit is always exact and we only use it.
+     */
+    tb_uint64_t block = tb_bits_get_u64_le(p);
+    tb_uint64_t q = block ^ (0x0101010101010101ULL * (tb_byte_t)quote);
+    tb_uint64_t b = block ^ (0x0101010101010101ULL * '\\');
+    return ((q - 0x0101010101010101ULL) & ~q & 0x8080808080808080ULL) | ((b - 0x0101010101010101ULL) & ~b & 0x8080808080808080ULL);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * fast parser implementation
+ */
+static __tb_inline__ tb_void_t tb_oc_json_parser_skip_spaces(tb_oc_json_parser_t* parser)
+{
+    // skip the short spaces
+    tb_char_t const* p = parser->p;
+    tb_char_t const* e = parser->e;
+    while (p < e && tb_isspace(*p))
+    {
+#if defined(TB_ARCH_SSE2) || defined(TB_ARCH_ARM_NEON) || defined(TB_ARCH_ARM64)
+        // skip the long spaces (e.g. indents) block by block
+        if (p + TB_OC_JSON_PARSER_BLOCK <= e)
+        {
+            tb_oc_json_parser_bitmask_t mask = tb_oc_json_parser_block_graph(p);
+            if (mask) 
+            {
+                p += tb_oc_json_parser_bitmask_index(mask);
+                break;
+            }
+            p += TB_OC_JSON_PARSER_BLOCK;
+        }
+        else p++;
+#else
+        p++;
+#endif
+    }
+    parser->p = p;
+}
+static __tb_inline__ tb_char_t const* tb_oc_json_parser_find_string(tb_char_t const* p, tb_char_t const* e, tb_char_t quote)
+{
+    // find the quote or backslash character block by block
+    while (p + TB_OC_JSON_PARSER_BLOCK <= e)
+    {
+        tb_oc_json_parser_bitmask_t mask = tb_oc_json_parser_block_string(p, quote);
+        if (mask) return p + tb_oc_json_parser_bitmask_index(mask);
+        p += TB_OC_JSON_PARSER_BLOCK;
+    }
+
+    // find it from the left data
+    while (p < e && *p != quote && *p != '\\') p++;
+    return p;
+}
+static tb_bool_t tb_oc_json_parser_unicode(tb_oc_json_parser_t* parser, tb_uint32_t* pvalue)
+{
+    // the unicode value: XXXX
+    tb_char_t const* p = parser->p;
+    tb_check_return_val(p + 4 <= parser->e, tb_false);
+
+    // parse it
+    tb_size_t   i = 0;
+    tb_uint32_t value = 0;
+    for (i = 0; i < 4; i++)
+    {
+        tb_char_t ch = p[i];
+        if (tb_isdigit10(ch)) value = (value << 4) + (ch - '0');
+        else if (ch >= 'a' && ch <= 'f') value = (value << 4) + (ch - 'a' + 10);
+        else if (ch >= 'A' && ch <= 'F') value = (value << 4) + (ch - 'A' + 10);
+        else return tb_false;
+    }
+
+    // ok
+    parser->p = p + 4;
+    *pvalue = value;
+    return tb_true;
+}
+static tb_bool_t tb_oc_json_parser_escape(tb_oc_json_parser_t* parser)
+{
+    // the escaped character
+    tb_check_return_val(parser->p < parser->e, tb_false);
+    tb_char_t ch = *parser->p++;
+
+    // unicode?
+    if (ch == 'u')
+    {
+        // the unicode value
+        tb_uint32_t value = 0;
+        if (!tb_oc_json_parser_unicode(parser, &value)) return tb_false;
+
+        // the surrogate pair?
+        if (value >= 0xd800 && value < 0xdc00 && parser->p + 6 <= parser->e && parser->p[0] == '\\' && parser->p[1] == 'u')
+        {
+            tb_char_t const*    p = parser->p;
+            tb_uint32_t         low = 0;
+            parser->p += 2;
+            if (tb_oc_json_parser_unicode(parser, &low) && low >= 0xdc00 && low < 0xe000)
+                value = 0x10000 + ((value - 0xd800) << 10) + (low - 0xdc00);
+            else parser->p = p;
+        }
+
+        // unicode to utf8
+        tb_char_t utf8[4];
+        tb_size_t size = 0;
+        if (value < 0x80) utf8[size++] = (tb_char_t)value;
+        else if (value < 0x800)
+        {
+            utf8[size++] = (tb_char_t)(0xc0 | (value >> 6));
+            utf8[size++] = (tb_char_t)(0x80 | (value & 0x3f));
+        }
+        else if (value < 0x10000)
+        {
+            utf8[size++] = (tb_char_t)(0xe0 | (value >> 12));
+            utf8[size++] = (tb_char_t)(0x80 | ((value >> 6) & 0x3f));
+            utf8[size++] = (tb_char_t)(0x80 | (value & 0x3f));
+        }
+        else
+        {
+            utf8[size++] = (tb_char_t)(0xf0 | (value >> 18));
+            utf8[size++] = (tb_char_t)(0x80 | ((value >> 12) & 0x3f));
+            utf8[size++] = (tb_char_t)(0x80 | ((value >> 6) & 0x3f));
+            utf8[size++] = (tb_char_t)(0x80 | (value & 0x3f));
+        }
+
+        // append it
+        tb_size_t i = 0;
+        for (i = 0; i < size; i++) tb_string_chrcat(&parser->data, utf8[i]);
+    }
+    // append the escaped character
+    else tb_string_chrcat(&parser->data, tb_oc_json_reader_escape(ch));
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_oc_json_parser_string_data(tb_oc_json_parser_t* parser, tb_char_t quote, tb_char_t const** pdata, tb_size_t* psize)
+{
+    // find the string end or the first escaped character
+    tb_char_t const*    head = parser->p;
+    tb_char_t const*    e = parser->e;
+    tb_char_t const*    p = tb_oc_json_parser_find_string(head, e, quote);
+    tb_check_return_val(p < e, tb_false);
+
+    // no escaped characters? use the data in place
+    if (*p == quote)
+    {
+        *pdata = head;
+        *psize = p - head;
+        parser->p = p + 1;
+        return tb_true;
+    }
+
+    // copy the head data, @note p[0] is '\\' and it's safe to copy one more byte
+    tb_string_clear(&parser->data);
+    if (p > head) tb_string_cstrncpy(&parser->data, head, p - head);
+
+    // decode the escaped string
+    while (p < e && *p == '\\')
+    {
+        // append the escaped character
+        parser->p = p + 1;
+        if (!tb_oc_json_parser_escape(parser)) return tb_false;
+
+        // find the next escaped character or the string end
+        head = parser->p;
+        p = tb_oc_json_parser_find_string(head, e, quote);
+        tb_check_return_val(p < e, tb_false);
+
+        // append the plain data
+        if (p > head) tb_string_cstrncat(&parser->data, head, p - head);
+    }
+
+    // end
+    parser->p = p + 1;
+    *pdata = tb_string_cstr(&parser->data);
+    *psize = tb_string_size(&parser->data);
+    return tb_true;
+}
+static tb_object_ref_t tb_oc_json_parser_value(tb_oc_json_parser_t* parser);
+static tb_object_ref_t tb_oc_json_parser_string(tb_oc_json_parser_t* parser, tb_char_t type)
+{
+    // parse the string data
+    tb_char_t const*    data = tb_null;
+    tb_size_t           size = 0;
+    if (!tb_oc_json_parser_string_data(parser, type, &data, &size)) return tb_null;
+
+    // trace
+    tb_trace_d("string: %.*s", (tb_int_t)size, data);
+
+    // init string
+    return tb_oc_string_init_from_cstrn(data, size);
+}
+static tb_object_ref_t tb_oc_json_parser_number(tb_oc_json_parser_t* parser, tb_char_t type)
+{
+    /* parse the number: -?digits(.digits)?([eE][+-]?digits)?
+     *
+     * the integer digits are parsed directly and the other invalid numbers will be rejected,
+     * e.g. 1-2, 1+1, --5, 1.5.5, +1, .5, 1e
+     */
+    tb_char_t const*    head = parser->p - 1;
+    tb_char_t const*    p = parser->p;
+    tb_char_t const*    e = parser->e;
+    tb_bool_t           bs = (type == '-')? tb_true : tb_false;
+    tb_uint64_t         value = 0;
+
+    // the first character must be '-' or a digit
+    tb_check_return_val(bs || tb_isdigit10(type), tb_null);
+    if (bs) 
+    {
+        tb_check_return_val(p < e && tb_isdigit10(*p), tb_null);
+        type = *p++;
+    }
+
+    // parse the integer digits
+    value = type - '0';
+    for (; p < e && tb_isdigit10(*p); p++) value = value * 10 + (*p - '0');
+
+    // parse the fraction digits
+    tb_bool_t           bf = tb_false;
+    tb_char_t const*    f = tb_null;
+    if (p < e && *p == '.')
+    {
+        f = ++p;
+        while (p < e && tb_isdigit10(*p)) p++;
+        tb_check_return_val(p > f, tb_null);
+        bf = tb_true;
+    }
+
+    // parse the exponent digits
+    tb_char_t const*    m = p;
+    tb_long_t           exp = 0;
+    if (p < e && (*p == 'e' || *p == 'E'))
+    {
+        // the exponent sign
+        tb_bool_t es = tb_false;
+        if (++p < e && (*p == '-' || *p == '+')) es = (*p++ == '-');
+
+        // the exponent digits
+        tb_char_t const* d = p;
+        for (; p < e && tb_isdigit10(*p); p++) 
+        {
+            if (exp < 100000) exp = exp * 10 + (*p - '0');
+        }
+        tb_check_return_val(p > d, tb_null);
+        if (es) exp = -exp;
+        bf = tb_true;
+    }
+
+    // the number cannot be followed by the other number characters, e.g. 1-2, 1.5.5
+    tb_check_return_val(p >= e || !(tb_isdigit10(*p) || *p == '.' || *p == '-' || *p == '+' || *p == 'e' || *p == 'E'), tb_null);
+    parser->p = p;
+
+    // trace
+    tb_trace_d("number: %.*s", (tb_int_t)(p - head), head);
+
+    // init float number
+    tb_object_ref_t number = tb_null;
+    if (bf) 
+    {
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+        // make the c-string of the float number without the exponent
+        tb_char_t data[256];
+        tb_size_t size = m - head;
+        tb_check_return_val(size < sizeof(data), tb_null);
+        tb_memcpy(data, head, size);
+        data[size] = '\0';
+
+        // scale it by the exponent, stop it if the value has been overflow or underflow
+        tb_double_t val = tb_s10tod(data);
+        for (; exp > 0 && val != 0. && !tb_isinf(val); exp--) val *= 10.;
+        for (; exp < 0 && val != 0.; exp++) val /= 10.;
+
+        // init it
+        number = tb_oc_number_init_from_float((tb_float_t)val);
+#else
+        tb_trace_noimpl();
+#endif
+    }
+    else if (bs)
+    {
+        tb_sint64_t val = -(tb_sint64_t)value;
+        switch (tb_object_need_bytes(-val))
+        {
+        case 1: number = tb_oc_number_init_from_sint8((tb_sint8_t)val); break;
+        case 2: number = tb_oc_number_init_from_sint16((tb_sint16_t)val); break;
+        case 4: number = tb_oc_number_init_from_sint32((tb_sint32_t)val); break;
+        case 8: number = tb_oc_number_init_from_sint64((tb_sint64_t)val); break;
+        default: break;
+        }
+    }
+    else 
+    {
+        switch (tb_object_need_bytes(value))
+        {
+        case 1: number = tb_oc_number_init_from_uint8((tb_uint8_t)value); break;
+        case 2: number = tb_oc_number_init_from_uint16((tb_uint16_t)value); break;
+        case 4: number = tb_oc_number_init_from_uint32((tb_uint32_t)value); break;
+        case 8: number = tb_oc_number_init_from_uint64((tb_uint64_t)value); break;
+        default: break;
+        }
+    }
+
+    // ok?
+    return number;
+}
+static tb_object_ref_t tb_oc_json_parser_literal(tb_oc_json_parser_t* parser, tb_char_t type)
+{
+    // find the literal end
+    tb_char_t const*    head = parser->p - 1;
+    tb_char_t const*    p = parser->p;
+    tb_char_t const*    e = parser->e;
+    while (p < e && tb_isalpha(*p)) p++;
+    parser->p = p;
+
+    // trace
+    tb_trace_d("literal: %.*s", (tb_int_t)(p - head), head);
+
+    // null? true? false?
+    tb_size_t size = p - head;
+    if (size == 4 && !tb_strnicmp(head, "null", 4)) return tb_oc_null_init();
+    else if (size == 4 && !tb_strnicmp(head, "true", 4)) return tb_oc_boolean_init(tb_true);
+    else if (size == 5 && !tb_strnicmp(head, "false", 5)) return tb_oc_boolean_init(tb_false);
+    return tb_null;
+}
+static tb_object_ref_t tb_oc_json_parser_array(tb_oc_json_parser_t* parser, tb_char_t type)
+{
+    // init array
+    tb_object_ref_t array = tb_oc_array_init(TB_OC_JSON_READER_ARRAY_GROW, tb_false);
+    tb_assert_and_check_return_val(array, tb_null);
+
+    // done
+    tb_bool_t ok = tb_true;
+    while (ok)
+    {
+        // skip spaces
+        tb_oc_json_parser_skip_spaces(parser);
+        tb_check_break_state(parser->p < parser->e, ok, tb_false);
+
+        // end?
+        tb_char_t ch = *parser->p;
+        if (ch == ']') 
+        {
+            parser->p++;
+            break;
+        }
+        // skip ','
+        else if (ch == ',') parser->p++;
+        else
+        {
+            // read item
+            tb_object_ref_t item = tb_oc_json_parser_value(parser);
+            tb_check_break_state(item, ok, tb_false);
+
+            // append item
+            tb_oc_array_append(array, item);
+        }
+    }
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (array) tb_object_exit(array);
+        array = tb_null;
+    }
+
+    // ok?
+    return array;
+}
+static tb_object_ref_t tb_oc_json_parser_dictionary(tb_oc_json_parser_t* parser, tb_char_t type)
+{
+    // init dictionary
+    tb_object_ref_t dictionary = tb_oc_dictionary_init(0, tb_false);
+    tb_assert_and_check_return_val(dictionary, tb_null);
+
+    // done
+    tb_bool_t ok = tb_true;
+    while (ok)
+    {
+        // skip spaces
+        tb_oc_json_parser_skip_spaces(parser);
+        tb_check_break_state(parser->p < parser->e, ok, tb_false);
+
+        // end?
+        tb_char_t ch = *parser->p++;
+        if (ch == '}') break;
+        // skip ','
+        else if (ch == ',') continue;
+
+        // check
+        tb_check_break_state(ch == '\"' || ch == '\'', ok, tb_false);
+
+        // read key
+        tb_char_t const*    kdata = tb_null;
+        tb_size_t           ksize = 0;
+        ok = tb_oc_json_parser_string_data(parser, ch, &kdata, &ksize);
+        tb_check_break(ok);
+
+        /* save the escaped key
+         *
+         * the key data in place will not be changed, 
+         * but the escaped key data will be overwritten by the nested values.
+         */
+        tb_char_t* kcopy = tb_null;
+        if (kdata == tb_string_cstr(&parser->data))
+        {
+            kcopy = tb_strndup(kdata, ksize);
+            tb_assert_and_check_break_state(kcopy, ok, tb_false);
+            kdata = kcopy;
+        }
+
+        // skip ':'
+        tb_oc_json_parser_skip_spaces(parser);
+        if (parser->p < parser->e && *parser->p == ':')
+        {
+            // skip spaces
+            parser->p++;
+            tb_oc_json_parser_skip_spaces(parser);
+
+            // read val
+            tb_object_ref_t val = tb_oc_json_parser_value(parser);
+            if (val)
+            {
+                // make the c-string of the key, @note kdata[ksize] is the quote and it's safe to copy one more byte
+                if (!kcopy)
+                {
+                    tb_string_clear(&parser->data);
+                    if (ksize) tb_string_cstrncpy(&parser->data, kdata, ksize);
+                }
+                tb_char_t const* key = kcopy? kcopy : (ksize? tb_string_cstr(&parser->data) : "");
+
+                // trace
+                tb_trace_d("key: %s", key);
+
+                // set key => val
+                tb_oc_dictionary_insert(dictionary, key, val);
+            }
+            else ok = tb_false;
+        }
+        else ok = tb_false;
+
+        // exit the escaped key
+        if (kcopy) tb_free(kcopy);
+    }
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (dictionary) tb_object_exit(dictionary);
+        dictionary = tb_null;
+    }
+
+    // ok?
+    return dictionary;
+}
+static tb_object_ref_t tb_oc_json_parser_value(tb_oc_json_parser_t* parser)
+{
+    // end?
+    tb_check_return_val(parser->p < parser->e, tb_null);
+
+    // the type
+    tb_char_t type = *parser->p++;
+
+    // parse it
+    tb_object_ref_t object = tb_null;
+    switch (type)
+    {
+    case '{':
+    case '[':
+        {
+            // too deep?
+            if (parser->depth >= TB_OC_JSON_PARSER_DEPTH_MAXN)
+            {
+                parser->deep = tb_true;
+                break;
+            }
+
+            // parse the container
+            parser->depth++;
+            object = (type == '{')? tb_oc_json_parser_dictionary(parser, type) : tb_oc_json_parser_array(parser, type);
+            parser->depth--;
+        }
+        break;
+    case '\"':
+    case '\'':
+        object = tb_oc_json_parser_string(parser, type);
+        break;
+    case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+    case '.': case '-': case '+': case 'e': case 'E':
+        object = tb_oc_json_parser_number(parser, type);
+        break;
+    case 'n': case 'N':
+    case 't': case 'T':
+    case 'f': case 'F':
+        object = tb_oc_json_parser_literal(parser, type);
+        break;
+    default:
+        break;
+    }
+
+    // ok?
+    return object;
+}
+static tb_object_ref_t tb_oc_json_parser_done(tb_stream_ref_t stream, tb_char_t const* data, tb_size_t size, tb_bool_t* pdeep)
+{
+    // init parser
+    tb_oc_json_parser_t parser;
+    parser.p        = data;
+    parser.e        = data + size;
+    parser.depth    = 0;
+    parser.deep     = tb_false;
+    if (!tb_string_init(&parser.data)) return tb_null;
+
+    // skip spaces
+    tb_oc_json_parser_skip_spaces(&parser);
+
+    // parse it
+    tb_object_ref_t object = parser.p < parser.e? tb_oc_json_parser_value(&parser) : tb_null;
+
+    // skip the parsed data
+    if (object && !tb_stream_skip(stream, parser.p - data))
+    {
+        tb_object_exit(object);
+        object = tb_null;
+    }
+
+    // exit parser
+    tb_string_exit(&parser.data);
+
+    // save the too deep state
+    *pdeep = parser.deep;
+
+    // ok?
+    return object;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * reader implementation
+ */
 static tb_object_ref_t tb_oc_json_reader_done(tb_stream_ref_t stream)
 {
     // check
     tb_assert_and_check_return_val(stream, tb_null);
 
+    // the whole left data has been mapped or buffered? parse it directly using the fast parser
+    if (!g_hooked)
+    {
+        // peek the mapped data
+        tb_size_t           size = 0;
+        tb_byte_t const*    data = tb_stream_peek(stream, &size);
+        if (!data)
+        {
+            // buffer the small left data
+            tb_hong_t left = tb_stream_size(stream) > 0? (tb_hong_t)tb_stream_left(stream) : -1;
+            if (left > 0 && left <= TB_OC_JSON_PARSER_NEED_MAXN)
+            {
+                tb_byte_t* need = tb_null;
+                if (tb_stream_need(stream, &need, (tb_size_t)left)) 
+                {
+                    data = need;
+                    size = (tb_size_t)left;
+                }
+            }
+        }
+
+        /* parse it
+         *
+         * the stream has not been skipped if it's too deep for the fast parser, 
+         * so we can continue to parse it using the stream reader without the depth limit.
+         */
+        tb_bool_t deep = tb_false;
+        if (data && size)
+        {
+            tb_object_ref_t object = tb_oc_json_parser_done(stream, (tb_char_t const*)data, size, &deep);
+            if (!deep) return object;
+        }
+    }
+
     // init reader
     tb_oc_json_reader_t reader = {0};
     reader.stream = stream;
@@ -585,6 +1296,9 @@ tb_bool_t tb_oc_json_reader_hook(tb_char_t type, tb_oc_json_reader_func_t func)
     // hook it
     tb_hash_map_insert(reader->hooker, (tb_pointer_t)(tb_size_t)type, func);
 
+    // the fast parser does not know the user reader funcs, we need read it using them
+    g_hooked = tb_true;
+
     // ok
     return tb_true;
 }
@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
  
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -133,7 +134,7 @@ static tb_object_ref_t tb_oc_number_copy(tb_object_ref_t object)
 }
 static tb_void_t tb_oc_number_exit(tb_object_ref_t object)
 {
-    if (object) tb_free(object);
+    if (object) tb_oc_arena_object_free(object);
 }
 static tb_void_t tb_oc_number_clear(tb_object_ref_t object)
 {
@@ -188,12 +189,9 @@ static tb_oc_number_t* tb_oc_number_init_base()
     do
     {
         // make number
-        number = tb_malloc0_type(tb_oc_number_t);
+        number = (tb_oc_number_t*)tb_oc_arena_object_make(sizeof(tb_oc_number_t), TB_OBJECT_TYPE_NUMBER);
         tb_assert_and_check_break(number);
 
-        // init number
-        if (!tb_object_init((tb_object_ref_t)number, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_NUMBER)) break;
-
         // init base
         number->base.copy   = tb_oc_number_copy;
         number->base.exit   = tb_oc_number_exit;
@@ -31,6 +31,7 @@
  */
 #include "object.h"
 #include "impl/impl.h"
+#include "impl/arena.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -57,6 +58,13 @@ tb_void_t tb_object_exit(tb_object_ref_t object)
     // readonly?
     tb_check_return(!(object->flag & TB_OBJECT_FLAG_READONLY));
 
+    // is in the arena? only the root object can exit the whole arena
+    if (object->flag & TB_OBJECT_FLAG_ARENA) 
+    {
+        tb_oc_arena_object_exit(object);
+        return ;
+    }
+
     // check refn
     tb_assert_and_check_return(object->refn);
 
@@ -341,6 +349,70 @@ tb_object_ref_t tb_object_read_from_data(tb_byte_t const* data, tb_size_t size)
     // ok?
     return object;
 }
+tb_object_ref_t tb_object_read_arena(tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // init arena
+    tb_oc_arena_ref_t arena = tb_oc_arena_init();
+    tb_assert_and_check_return_val(arena, tb_null);
+
+    // read object in the arena
+    tb_oc_arena_ref_t   previous = tb_oc_arena_enter(arena);
+    tb_object_ref_t     object = tb_oc_reader_done(stream);
+    tb_oc_arena_enter(previous);
+
+    // the arena will be exited with the root object
+    if (object && (object->flag & TB_OBJECT_FLAG_ARENA)) tb_oc_arena_root_set(arena, object);
+    // failed or the singleton object? exit arena now
+    else tb_oc_arena_exit(arena);
+
+    // ok?
+    return object;
+}
+tb_object_ref_t tb_object_read_arena_from_url(tb_char_t const* url)
+{
+    // check
+    tb_assert_and_check_return_val(url, tb_null);
+
+    // init
+    tb_object_ref_t object = tb_null;
+
+    // make stream
+    tb_stream_ref_t stream = tb_stream_init_from_url(url);
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // read object
+    if (tb_stream_open(stream)) object = tb_object_read_arena(stream);
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    return object;
+}
+tb_object_ref_t tb_object_read_arena_from_data(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_null);
+
+    // init
+    tb_object_ref_t object = tb_null;
+
+    // make stream
+    tb_stream_ref_t stream = tb_stream_init_from_data(data, size);
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // read object
+    if (tb_stream_open(stream)) object = tb_object_read_arena(stream);
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    return object;
+}
 tb_long_t tb_object_writ(tb_object_ref_t object, tb_stream_ref_t stream, tb_size_t format)
 {
     // check
@@ -109,6 +109,49 @@ tb_object_ref_t     tb_object_read_from_url(tb_char_t const* url);
  */
 tb_object_ref_t     tb_object_read_from_data(tb_byte_t const* data, tb_size_t size);
 
+/*! read object in the arena mode
+ *
+ * all objects of the object tree are allocated from one arena and the dictionary keys are interned,
+ * they will be released at once when the root object is exited. 
+ *
+ * @note no object of the arena may outlive it, the child objects only live until the root object is exited,
+ * retaining them or copying the arrays and dictionaries (tb_object_copy only retains their items) will not keep them alive,
+ * and the arena is bound to the current thread while reading.
+ *
+ * @code
+    tb_object_ref_t root = tb_object_read_arena(stream);
+    if (root)
+    {
+        // ...
+
+        // exit the whole object tree
+        tb_object_exit(root);
+    }
+ * @endcode
+ *
+ * @param stream    the stream
+ *
+ * @return          the root object
+ */
+tb_object_ref_t     tb_object_read_arena(tb_stream_ref_t stream);
+
+/*! read object from url in the arena mode
+ *
+ * @param url       the url
+ *
+ * @return          the root object
+ */
+tb_object_ref_t     tb_object_read_arena_from_url(tb_char_t const* url);
+
+/*! read object from data in the arena mode
+ *
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          the root object
+ */
+tb_object_ref_t     tb_object_read_arena_from_data(tb_byte_t const* data, tb_size_t size);
+
 /*! writ object
  *
  * @param object    the object
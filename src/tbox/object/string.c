@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../string/string.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -78,7 +79,7 @@ static tb_void_t tb_oc_string_exit(tb_object_ref_t object)
         tb_string_exit(&string->str);
 
         // exit the object
-        tb_free(object);
+        tb_oc_arena_object_free(object);
     }
 }
 static tb_void_t tb_oc_string_clear(tb_object_ref_t object)
@@ -98,12 +99,9 @@ static tb_oc_string_t* tb_oc_string_init_base()
     do
     {
         // make string
-        string = tb_malloc0_type(tb_oc_string_t);
+        string = (tb_oc_string_t*)tb_oc_arena_object_make(sizeof(tb_oc_string_t), TB_OBJECT_TYPE_STRING);
         tb_assert_and_check_break(string);
 
-        // init string
-        if (!tb_object_init((tb_object_ref_t)string, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_STRING)) break;
-
         // init base
         string->base.copy   = tb_oc_string_copy;
         string->base.exit   = tb_oc_string_exit;
@@ -162,6 +160,49 @@ tb_object_ref_t tb_oc_string_init_from_cstr(tb_char_t const* cstr)
     // ok?
     return (tb_object_ref_t)string;
 }
+tb_object_ref_t tb_oc_string_init_from_cstrn(tb_char_t const* cstr, tb_size_t size)
+{
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_oc_string_t* string = tb_null;
+    do
+    {
+        // make string
+        string = tb_oc_string_init_base();
+        tb_assert_and_check_break(string);
+
+        // init str
+        if (!tb_string_init(&string->str)) break;
+
+        /* copy string
+         *
+         * @note the data may be not terminated by null, 
+         * so we cannot use tb_string_cstrncpy() which will copy one more byte
+         */
+        if (cstr && size)
+        {
+            tb_char_t* data = (tb_char_t*)tb_buffer_resize(&string->str, size + 1);
+            tb_assert_and_check_break(data);
+            tb_memcpy(data, cstr, size);
+            data[size] = '\0';
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        tb_oc_string_exit((tb_object_ref_t)string);
+        string = tb_null;
+    }
+
+    // ok?
+    return (tb_object_ref_t)string;
+}
 tb_object_ref_t tb_oc_string_init_from_str(tb_string_ref_t str)
 {
     // done
@@ -44,6 +44,15 @@ __tb_extern_c_enter__
  */
 tb_object_ref_t     tb_oc_string_init_from_cstr(tb_char_t const* cstr);
 
+/*! init string from the c-string data with the given size
+ *
+ * @param cstr      the c-string data, need not be terminated by null
+ * @param size      the c-string size
+ *
+ * @return          the string object
+ */
+tb_object_ref_t     tb_oc_string_init_from_cstrn(tb_char_t const* cstr, tb_size_t size);
+
 /*! init string from string
  *
  * @param str       the string
@@ -27,6 +27,7 @@
 #include "impl.h"
 #include "../exception.h"
 #include "../cache_time.h"
+#include "../processor.h"
 #include "../../network/network.h"
 #ifdef TB_CONFIG_OS_ANDROID
 #   include "../android/android.h"
@@ -38,6 +39,9 @@
 
 tb_bool_t tb_platform_init_env(tb_handle_t priv)
 {
+    // detect the processor features
+    tb_processor_features();
+
     // init android envirnoment
 #ifdef TB_CONFIG_OS_ANDROID
     if (!tb_android_init_env(priv)) return tb_false;
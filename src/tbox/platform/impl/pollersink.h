@@ -0,0 +1,141 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pollersink.h
+ * @ingroup     platform
+ *
+ */
+#ifndef TB_PLATFORM_IMPL_POLLERSINK_H
+#define TB_PLATFORM_IMPL_POLLERSINK_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../poller.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the poller sink type
+ *
+ * all pollers report the ready events to the sink,
+ * it will call the event function for tb_poller_wait() or save them to the events list for tb_poller_wait_events().
+ */
+typedef struct __tb_poller_sink_t
+{
+    // the event function
+    tb_poller_event_func_t  func;
+
+    // the events list
+    tb_poller_event_ref_t   list;
+
+    // the events list maxn
+    tb_size_t               maxn;
+
+    // the reported events count
+    tb_size_t               size;
+
+}tb_poller_sink_t, *tb_poller_sink_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inline implementation
+ */
+
+/* init the poller sink
+ *
+ * @param sink      the sink
+ * @param func      the event function, we will save events to the list if it's null
+ * @param list      the events list
+ * @param maxn      the events list maxn
+ */
+static __tb_inline__ tb_void_t tb_poller_sink_init(tb_poller_sink_ref_t sink, tb_poller_event_func_t func, tb_poller_event_ref_t list, tb_size_t maxn)
+{
+    // check
+    tb_assert(sink && (func || (list && maxn)));
+
+    // init it
+    sink->func  = func;
+    sink->list  = list;
+    sink->maxn  = func? (tb_size_t)-1 : maxn;
+    sink->size  = 0;
+}
+
+/* the left space of the poller sink
+ *
+ * @param sink      the sink
+ *
+ * @return          the left events count
+ */
+static __tb_inline__ tb_size_t tb_poller_sink_left(tb_poller_sink_ref_t sink)
+{
+    return sink->maxn - sink->size;
+}
+
+/* is the poller sink full?
+ *
+ * the pollers should stop to report the ready events and keep them for the next waiting
+ *
+ * @param sink      the sink
+ *
+ * @return          tb_true or tb_false
+ */
+static __tb_inline__ tb_bool_t tb_poller_sink_full(tb_poller_sink_ref_t sink)
+{
+    return sink->size >= sink->maxn;
+}
+
+/* report the ready events to the poller sink
+ *
+ * @param sink      the sink
+ * @param poller    the poller
+ * @param sock      the socket
+ * @param events    the poller events
+ * @param priv      the user private data for this socket
+ */
+static __tb_inline__ tb_void_t tb_poller_sink_done(tb_poller_sink_ref_t sink, tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(sink->size < sink->maxn);
+
+    // call event function
+    if (sink->func) sink->func(poller, sock, events, priv);
+    // save the events
+    else
+    {
+        tb_poller_event_ref_t event = sink->list + sink->size;
+        event->sock     = sock;
+        event->events   = events;
+        event->priv     = priv;
+    }
+
+    // update the events count
+    sink->size++;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
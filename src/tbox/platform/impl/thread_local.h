@@ -45,6 +45,14 @@ tb_bool_t           tb_thread_local_init_env(tb_noarg_t);
 // exit the thread local envirnoment
 tb_void_t           tb_thread_local_exit_env(tb_noarg_t);
 
+/* the thread local envirnoment has been initialized?
+ *
+ * @note the thread local cannot be registered before initializing it, e.g. in the allocator
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_thread_local_env_ready(tb_noarg_t);
+
 /* walk all thread locals
  *
  * @param func      the walk function
@@ -0,0 +1,207 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        iouring_object.h
+ * @ingroup     platform
+ *
+ */
+#ifndef TB_PLATFORM_LINUX_IOURING_OBJECT_H
+#define TB_PLATFORM_LINUX_IOURING_OBJECT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../../container/list_entry.h"
+#include <sys/socket.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the io_uring object code enum
+typedef enum __tb_iouring_object_code_e
+{
+    TB_IOURING_OBJECT_CODE_NONE     = 0
+,   TB_IOURING_OBJECT_CODE_ACPT     = 1     //!< accept it
+,   TB_IOURING_OBJECT_CODE_CONN     = 2     //!< connect to the host address
+,   TB_IOURING_OBJECT_CODE_RECV     = 3     //!< recv data for tcp
+,   TB_IOURING_OBJECT_CODE_SEND     = 4     //!< send data for tcp
+
+}tb_iouring_object_code_e;
+
+// the io_uring object operation index enum
+typedef enum __tb_iouring_object_op_e
+{
+    TB_IOURING_OBJECT_OP_RECV       = 0     //!< the recv operation: accept, recv
+,   TB_IOURING_OBJECT_OP_SEND       = 1     //!< the send operation: connect, send
+,   TB_IOURING_OBJECT_OP_MAXN       = 2
+
+}tb_iouring_object_op_e;
+
+// the io_uring object operation type
+typedef struct __tb_iouring_object_op_t
+{
+    // the operation code
+    tb_uint8_t                      code;
+
+    // the operation state, TB_STATE_OK, TB_STATE_WAITING or TB_STATE_FINISHED
+    tb_uint8_t                      state;
+
+    // the finished event has been notified?
+    tb_uint8_t                      notified;
+
+    // the result, the real size, the accepted socket fd or -errno
+    tb_long_t                       result;
+
+    /* the private buffer for recv/send
+     *
+     * the kernel may still write it after the socket has been closed or the waiting has been timeout,
+     * so we cannot pass the user buffer to the kernel directly.
+     */
+    tb_byte_t*                      buffer;
+
+    // the private buffer maxn
+    tb_size_t                       maxn;
+
+    // the consumed offset of the finished recv data in buffer
+    tb_size_t                       offset;
+
+    // the address for accept/connect
+    struct sockaddr_storage         addr;
+
+    // the address size
+    socklen_t                       addrlen;
+
+}tb_iouring_object_op_t;
+
+// the io_uring object type
+typedef struct __tb_iouring_object_t
+{
+    // the list entry for the poller
+    tb_list_entry_t                 entry;
+
+    // the next dirty object
+    struct __tb_iouring_object_t*   dirty_next;
+
+    // the socket
+    tb_socket_ref_t                 sock;
+
+    // the bound poller
+    tb_pointer_t                    poller;
+
+    // the user private data for the poller
+    tb_cpointer_t                   priv;
+
+    // the pending requests count in kernel
+    tb_size_t                       refs;
+
+    // the registered events of the poller
+    tb_uint16_t                     events;
+
+    // the events of the armed poll request
+    tb_uint16_t                     events_poll;
+
+    // is polling? the poll request has been armed in kernel
+    tb_uint16_t                     polling     : 1;
+
+    // is canceling the poll request?
+    tb_uint16_t                     canceling   : 1;
+
+    // is dirty? it will be updated before and after waiting
+    tb_uint16_t                     dirty       : 1;
+
+    // the oneshot poll request has been triggered?
+    tb_uint16_t                     triggered   : 1;
+
+    // is killing? the socket has been closed and we are waiting the canceled requests
+    tb_uint16_t                     killing     : 1;
+
+    // the operations
+    tb_iouring_object_op_t          ops[TB_IOURING_OBJECT_OP_MAXN];
+
+}tb_iouring_object_t, *tb_iouring_object_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* get or new io_uring object from the given socket in the current coroutine
+ *
+ * @note only be enabled if the io_uring poller is used in the current coroutine scheduler
+ *
+ * @param sock              the socket
+ *
+ * @return                  the io_uring object
+ */
+tb_iouring_object_ref_t     tb_iouring_object_get_or_new(tb_socket_ref_t sock);
+
+/* remove io_uring object for the given socket in the current coroutine, and cancel all pending requests
+ *
+ * @param sock              the socket
+ */
+tb_void_t                   tb_iouring_object_remove(tb_socket_ref_t sock);
+
+/*! accept socket
+ *
+ * @param object            the io_uring object
+ * @param addr              the client address
+ *
+ * @return                  the client socket
+ */
+tb_socket_ref_t             tb_iouring_object_accept(tb_iouring_object_ref_t object, tb_ipaddr_ref_t addr);
+
+/* connect the given client address
+ *
+ * @param object            the io_uring object
+ * @param addr              the client address
+ *
+ * @return                  ok: 1, continue: 0; failed: -1
+ */
+tb_long_t                   tb_iouring_object_connect(tb_iouring_object_ref_t object, tb_ipaddr_ref_t addr);
+
+/* recv the socket data for tcp
+ *
+ * @param object            the io_uring object
+ * @param data              the data
+ * @param size              the size
+ *
+ * @return                  the real size, continue: 0 or -1
+ */
+tb_long_t                   tb_iouring_object_recv(tb_iouring_object_ref_t object, tb_byte_t* data, tb_size_t size);
+
+/* send the socket data for tcp
+ *
+ * @param object            the io_uring object
+ * @param data              the data
+ * @param size              the size
+ *
+ * @return                  the real size, continue: 0 or -1
+ */
+tb_long_t                   tb_iouring_object_send(tb_iouring_object_ref_t object, tb_byte_t const* data, tb_size_t size);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,1142 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        poller_iouring.c
+ *
+ */
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "iouring_object.h"
+#include "../posix/sockaddr.h"
+#include "../../container/container.h"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) && !defined(TB_CONFIG_MICRO_ENABLE)
+#   include "../../coroutine/coroutine.h"
+#   include "../../coroutine/impl/impl.h"
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the epoll poller for fallback
+ */
+static tb_poller_ref_t  tb_poller_epoll_init(tb_cpointer_t priv);
+static tb_void_t        tb_poller_epoll_exit(tb_poller_ref_t poller);
+static tb_size_t        tb_poller_epoll_type(tb_poller_ref_t poller);
+static tb_cpointer_t    tb_poller_epoll_priv(tb_poller_ref_t poller);
+static tb_void_t        tb_poller_epoll_kill(tb_poller_ref_t poller);
+static tb_void_t        tb_poller_epoll_spak(tb_poller_ref_t poller);
+static tb_bool_t        tb_poller_epoll_support(tb_poller_ref_t poller, tb_size_t events);
+static tb_bool_t        tb_poller_epoll_insert(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv);
+static tb_bool_t        tb_poller_epoll_remove(tb_poller_ref_t poller, tb_socket_ref_t sock);
+static tb_bool_t        tb_poller_epoll_modify(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv);
+static tb_long_t        tb_poller_epoll_wait_sink(tb_poller_ref_t poller, tb_poller_sink_ref_t sink, tb_long_t timeout);
+
+#define tb_poller_init      tb_poller_epoll_init
+#define tb_poller_exit      tb_poller_epoll_exit
+#define tb_poller_type      tb_poller_epoll_type
+#define tb_poller_priv      tb_poller_epoll_priv
+#define tb_poller_kill      tb_poller_epoll_kill
+#define tb_poller_spak      tb_poller_epoll_spak
+#define tb_poller_support   tb_poller_epoll_support
+#define tb_poller_insert    tb_poller_epoll_insert
+#define tb_poller_remove    tb_poller_epoll_remove
+#define tb_poller_modify    tb_poller_epoll_modify
+#define tb_poller_wait_sink tb_poller_epoll_wait_sink
+#include "poller_epoll.c"
+#undef tb_poller_init
+#undef tb_poller_exit
+#undef tb_poller_type
+#undef tb_poller_priv
+#undef tb_poller_kill
+#undef tb_poller_spak
+#undef tb_poller_support
+#undef tb_poller_insert
+#undef tb_poller_remove
+#undef tb_poller_modify
+#undef tb_poller_wait_sink
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the submission queue entries count
+#ifdef __tb_small__
+#   define TB_POLLER_IOURING_ENTRIES            (64)
+#else
+#   define TB_POLLER_IOURING_ENTRIES            (1024)
+#endif
+
+// the maximum size of the private recv/send buffer for the io_uring object
+#ifdef __tb_small__
+#   define TB_IOURING_OBJECT_BUFFER_MAXN        (4096)
+#else
+#   define TB_IOURING_OBJECT_BUFFER_MAXN        (16384)
+#endif
+
+// the user data tags of the requests, the object address is aligned by 4 bytes at least
+#define TB_POLLER_IOURING_TAG_POLL              (0)
+#define TB_POLLER_IOURING_TAG_RECV              (1)
+#define TB_POLLER_IOURING_TAG_SEND              (2)
+#define TB_POLLER_IOURING_TAG_MASK              (3)
+
+// the required features: single mmap, no dropped completions, timeout for io_uring_enter and multishot poll
+#define TB_POLLER_IOURING_FEATURES              (IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG | IORING_FEAT_RSRC_TAGS)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the io_uring poller type
+typedef struct __tb_poller_iouring_t
+{
+    // the user private data
+    tb_cpointer_t               priv;
+
+    // the pair sockets for spak, kill ..
+    tb_socket_ref_t             pair[2];
+
+    // the io_uring fd
+    tb_int_t                    fd;
+
+    // the ring data, the submission and completion queues are mapped to the same memory
+    tb_byte_t*                  ring;
+
+    // the ring size
+    tb_size_t                   ring_size;
+
+    // the submission queue entries
+    struct io_uring_sqe*        sqes;
+
+    // the submission queue entries size
+    tb_size_t                   sqes_size;
+
+    // the submission queue head, tail and array
+    tb_uint32_t*                sq_head;
+    tb_uint32_t*                sq_tail;
+    tb_uint32_t*                sq_array;
+
+    // the submission queue mask and entries count
+    tb_uint32_t                 sq_mask;
+    tb_uint32_t                 sq_entries;
+
+    // the local submission queue tail, the pending entries will be submitted in batch
+    tb_uint32_t                 sq_tail_local;
+
+    // the completion queue head and tail
+    tb_uint32_t*                cq_head;
+    tb_uint32_t*                cq_tail;
+
+    // the completion queue mask
+    tb_uint32_t                 cq_mask;
+
+    // the completion queue entries
+    struct io_uring_cqe*        cqes;
+
+    // the socket data (sock => object)
+    tb_sockdata_t               sockdata;
+
+    // all objects, contains the killing objects
+    tb_list_entry_head_t        objects;
+
+    // the dirty objects
+    tb_iouring_object_ref_t     dirty;
+
+}tb_poller_iouring_t, *tb_poller_iouring_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the io_uring state, 0: unknown, 1: enabled, -1: disabled and fallback to epoll
+static tb_atomic_t              g_poller_iouring_state = 0;
+
+// the events of the object operations
+static tb_size_t const          g_iouring_object_events[TB_IOURING_OBJECT_OP_MAXN] =
+{
+    TB_POLLER_EVENT_RECV
+,   TB_POLLER_EVENT_SEND
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_bool_t tb_poller_iouring_enabled()
+{
+    return tb_atomic_get(&g_poller_iouring_state) > 0;
+}
+static tb_bool_t tb_poller_iouring_submit(tb_poller_iouring_ref_t poller)
+{
+    // check
+    tb_assert(poller && poller->fd >= 0);
+
+    // publish the pending entries
+    tb_barrier();
+    *poller->sq_tail = poller->sq_tail_local;
+    tb_barrier();
+
+    // submit them
+    tb_uint32_t pending = poller->sq_tail_local - *((__tb_volatile__ tb_uint32_t*)poller->sq_head);
+    tb_check_return_val(pending, tb_true);
+    if (syscall(__NR_io_uring_enter, poller->fd, pending, 0, 0, tb_null, 0) < 0)
+    {
+        // trace
+        tb_trace_e("submit %u entries failed, errno: %d", pending, errno);
+        return tb_false;
+    }
+    return tb_true;
+}
+static struct io_uring_sqe* tb_poller_iouring_sqe(tb_poller_iouring_ref_t poller)
+{
+    // check
+    tb_assert(poller && poller->sqes);
+
+    // the submission queue is full? submit them first
+    if (poller->sq_tail_local - *((__tb_volatile__ tb_uint32_t*)poller->sq_head) >= poller->sq_entries)
+    {
+        if (!tb_poller_iouring_submit(poller)) return tb_null;
+        tb_check_return_val(poller->sq_tail_local - *((__tb_volatile__ tb_uint32_t*)poller->sq_head) < poller->sq_entries, tb_null);
+    }
+
+    // get a free entry
+    tb_uint32_t             index = poller->sq_tail_local & poller->sq_mask;
+    struct io_uring_sqe*    sqe = poller->sqes + index;
+    tb_memset_(sqe, 0, sizeof(struct io_uring_sqe));
+    poller->sq_array[index] = index;
+    poller->sq_tail_local++;
+    return sqe;
+}
+static tb_iouring_object_ref_t tb_poller_iouring_object(tb_poller_iouring_ref_t poller, tb_socket_ref_t sock, tb_bool_t need)
+{
+    // check
+    tb_assert(poller && sock);
+
+    // get the object of this socket
+    tb_iouring_object_ref_t object = (tb_iouring_object_ref_t)tb_sockdata_get(&poller->sockdata, sock);
+    if (!object && need)
+    {
+        // make object
+        object = tb_malloc0_type(tb_iouring_object_t);
+        tb_assert_and_check_return_val(object, tb_null);
+
+        // init object
+        object->sock   = sock;
+        object->poller = poller;
+
+        // save object
+        tb_sockdata_insert(&poller->sockdata, sock, object);
+        tb_list_entry_insert_tail(&poller->objects, &object->entry);
+    }
+    return object;
+}
+static tb_void_t tb_poller_iouring_object_free(tb_poller_iouring_ref_t poller, tb_iouring_object_ref_t object)
+{
+    // check
+    tb_assert(poller && object);
+
+    // close the accepted socket if it has been not fetched
+    tb_iouring_object_op_t* op = &object->ops[TB_IOURING_OBJECT_OP_RECV];
+    if (op->code == TB_IOURING_OBJECT_CODE_ACPT && op->state == TB_STATE_FINISHED && op->result >= 0)
+        close((tb_int_t)op->result);
+
+    // free the private buffers
+    tb_size_t i = 0;
+    for (i = 0; i < TB_IOURING_OBJECT_OP_MAXN; i++)
+    {
+        if (object->ops[i].buffer) tb_free(object->ops[i].buffer);
+        object->ops[i].buffer = tb_null;
+    }
+
+    // remove and free it
+    tb_list_entry_remove(&poller->objects, &object->entry);
+    tb_free(object);
+}
+static __tb_inline__ tb_void_t tb_poller_iouring_object_dirty(tb_poller_iouring_ref_t poller, tb_iouring_object_ref_t object)
+{
+    // insert it to the dirty objects
+    if (!object->dirty)
+    {
+        object->dirty       = 1;
+        object->dirty_next  = poller->dirty;
+        poller->dirty       = object;
+    }
+}
+static tb_size_t tb_poller_iouring_object_events(tb_iouring_object_ref_t object)
+{
+    // killed or no registered events?
+    tb_size_t events = object->events & TB_POLLER_EVENT_EALL;
+    tb_check_return_val(!object->killing && events, TB_POLLER_EVENT_NONE);
+
+    // the oneshot request has been triggered? wait to modify it
+    if ((object->events & TB_POLLER_EVENT_ONESHOT) && object->triggered) return TB_POLLER_EVENT_NONE;
+
+    // we need not poll these events if they will be notified by the pending operations
+    tb_size_t i = 0;
+    for (i = 0; i < TB_IOURING_OBJECT_OP_MAXN; i++)
+    {
+        if (object->ops[i].state != TB_STATE_OK) events &= ~g_iouring_object_events[i];
+    }
+    return events;
+}
+static tb_bool_t tb_poller_iouring_object_update(tb_poller_iouring_ref_t poller, tb_iouring_object_ref_t object)
+{
+    // get the events which need be polled
+    tb_size_t events = tb_poller_iouring_object_events(object);
+
+    // the poll request has been armed?
+    if (object->polling)
+    {
+        // cancel it if the events have been changed, we will re-arm it after it has been canceled
+        if (events != object->events_poll && !object->canceling)
+        {
+            struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+            tb_assert_and_check_return_val(sqe, tb_false);
+
+            sqe->opcode     = IORING_OP_POLL_REMOVE;
+            sqe->fd         = -1;
+            sqe->addr       = (tb_uint64_t)(tb_size_t)object | TB_POLLER_IOURING_TAG_POLL;
+            sqe->user_data  = 0;
+            object->canceling = 1;
+        }
+    }
+    else if (events)
+    {
+        struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+        tb_assert_and_check_return_val(sqe, tb_false);
+
+        // init poll mask
+        tb_uint32_t mask = 0;
+        if (events & TB_POLLER_EVENT_RECV) mask |= EPOLLIN;
+        if (events & TB_POLLER_EVENT_SEND) mask |= EPOLLOUT;
+        if (object->events & TB_POLLER_EVENT_CLEAR) mask |= EPOLLRDHUP;
+#ifdef TB_WORDS_BIGENDIAN
+        mask = (mask << 16) | (mask >> 16);
+#endif
+
+        /* init poll request
+         *
+         * we use multishot poll request for the edge trigger, it will only be notified for the new wakeup,
+         * and we use oneshot request and re-arm it after notifying it for the level trigger.
+         */
+        sqe->opcode         = IORING_OP_POLL_ADD;
+        sqe->fd             = (tb_int_t)tb_sock2fd(object->sock);
+        sqe->poll32_events  = mask;
+        sqe->user_data      = (tb_uint64_t)(tb_size_t)object | TB_POLLER_IOURING_TAG_POLL;
+        if ((object->events & TB_POLLER_EVENT_CLEAR) && !(object->events & TB_POLLER_EVENT_ONESHOT))
+            sqe->len = IORING_POLL_ADD_MULTI;
+
+        // mark as polling
+        object->polling     = 1;
+        object->events_poll = (tb_uint16_t)events;
+        object->refs++;
+    }
+    return tb_true;
+}
+static tb_void_t tb_poller_iouring_object_kill(tb_poller_iouring_ref_t poller, tb_iouring_object_ref_t object)
+{
+    // check
+    tb_assert(poller && object && !object->killing);
+
+    // remove it from the socket data
+    tb_sockdata_remove(&poller->sockdata, object->sock);
+
+    // clear the registered events
+    object->events = 0;
+    object->priv   = tb_null;
+
+    // no pending requests? free it directly
+    if (!object->refs && !object->dirty)
+    {
+        tb_poller_iouring_object_free(poller, object);
+        return ;
+    }
+
+    // mark as killing, it will be freed after all pending requests have been finished
+    object->killing = 1;
+
+    // cancel the poll request
+    tb_poller_iouring_object_update(poller, object);
+
+    // cancel the pending operations
+    tb_size_t i = 0;
+    for (i = 0; i < TB_IOURING_OBJECT_OP_MAXN; i++)
+    {
+        if (object->ops[i].state == TB_STATE_WAITING)
+        {
+            struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+            tb_assert_and_check_break(sqe);
+
+            sqe->opcode     = IORING_OP_ASYNC_CANCEL;
+            sqe->fd         = -1;
+            sqe->addr       = (tb_uint64_t)(tb_size_t)object | (TB_POLLER_IOURING_TAG_RECV + i);
+            sqe->user_data  = 0;
+        }
+    }
+}
+static tb_void_t tb_poller_iouring_spak_dirty(tb_poller_iouring_ref_t poller, tb_poller_sink_ref_t sink)
+{
+    // check
+    tb_assert(poller && sink);
+
+    // walk all dirty objects, the left objects will be notified in the next waiting if the sink is full
+    while (poller->dirty && !tb_poller_sink_full(sink))
+    {
+        // pop it
+        tb_iouring_object_ref_t object = poller->dirty;
+        poller->dirty       = object->dirty_next;
+        object->dirty_next  = tb_null;
+        object->dirty       = 0;
+
+        // killed? free it if all pending requests have been finished
+        if (object->killing)
+        {
+            if (!object->refs) tb_poller_iouring_object_free(poller, object);
+            continue ;
+        }
+
+        // notify the finished operations
+        tb_size_t i = 0;
+        tb_size_t events = TB_POLLER_EVENT_NONE;
+        for (i = 0; i < TB_IOURING_OBJECT_OP_MAXN; i++)
+        {
+            tb_iouring_object_op_t* op = &object->ops[i];
+            if (op->state == TB_STATE_FINISHED && !op->notified && (object->events & g_iouring_object_events[i]))
+            {
+                op->notified = 1;
+                events |= g_iouring_object_events[i];
+            }
+        }
+        if (events) tb_poller_sink_done(sink, (tb_poller_ref_t)poller, object->sock, events, object->priv);
+
+        // update the poll request
+        tb_poller_iouring_object_update(poller, object);
+    }
+}
+static tb_bool_t tb_poller_iouring_spak_pair(tb_poller_iouring_ref_t poller)
+{
+    // read all spak data
+    tb_long_t   i = 0;
+    tb_long_t   real = 0;
+    tb_char_t   data[64];
+    tb_bool_t   killed = tb_false;
+    while ((real = recv((tb_int_t)tb_sock2fd(poller->pair[1]), data, sizeof(data), 0)) > 0)
+    {
+        // killed?
+        for (i = 0; i < real && !killed; i++)
+            if (data[i] == 'k') killed = tb_true;
+    }
+    return !killed;
+}
+static tb_void_t tb_poller_iouring_exit(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // exit pair sockets
+    if (poller->pair[0]) close((tb_int_t)tb_sock2fd(poller->pair[0]));
+    if (poller->pair[1]) close((tb_int_t)tb_sock2fd(poller->pair[1]));
+    poller->pair[0] = tb_null;
+    poller->pair[1] = tb_null;
+
+    // exit the submission queue entries
+    if (poller->sqes) munmap(poller->sqes, poller->sqes_size);
+    poller->sqes = tb_null;
+
+    // exit ring
+    if (poller->ring) munmap(poller->ring, poller->ring_size);
+    poller->ring = tb_null;
+
+    // close io_uring fd, all pending requests will be canceled
+    if (poller->fd >= 0) close(poller->fd);
+    poller->fd = -1;
+
+    // exit all objects
+    while (tb_list_entry_size(&poller->objects))
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(&poller->objects);
+        tb_assert_and_check_break(entry);
+        tb_poller_iouring_object_free(poller, (tb_iouring_object_ref_t)tb_list_entry(&poller->objects, entry));
+    }
+    tb_list_entry_exit(&poller->objects);
+    poller->dirty = tb_null;
+
+    // exit socket data
+    tb_sockdata_exit(&poller->sockdata);
+
+    // free it
+    tb_free(poller);
+}
+static tb_bool_t tb_poller_iouring_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->fd >= 0 && sock, tb_false);
+
+    // get or make the object of this socket
+    tb_iouring_object_ref_t object = tb_poller_iouring_object(poller, sock, tb_true);
+    tb_assert_and_check_return_val(object, tb_false);
+
+    // save the registered events and the user private data
+    object->events      = (tb_uint16_t)events;
+    object->priv        = priv;
+    object->triggered   = 0;
+
+    // the finished operations need be notified again for the new events
+    tb_size_t i = 0;
+    for (i = 0; i < TB_IOURING_OBJECT_OP_MAXN; i++)
+        object->ops[i].notified = 0;
+
+    // we will update the poll request before waiting
+    tb_poller_iouring_object_dirty(poller, object);
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->fd >= 0 && sock, tb_false);
+
+    // update the registered events
+    if (!tb_poller_iouring_insert(self, sock, events, priv)) return tb_false;
+
+    /* re-arm the multishot poll request for the edge trigger
+     *
+     * it only reports the new wakeup, so we need re-arm it to report the current ready events again, like EPOLL_CTL_MOD.
+     */
+    tb_iouring_object_ref_t object = tb_poller_iouring_object(poller, sock, tb_false);
+    if (object && object->polling && (events & TB_POLLER_EVENT_CLEAR))
+        object->events_poll = TB_POLLER_EVENT_NONE;
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_remove(tb_poller_ref_t self, tb_socket_ref_t sock)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->fd >= 0 && sock, tb_false);
+
+    // get the object of this socket
+    tb_iouring_object_ref_t object = tb_poller_iouring_object(poller, sock, tb_false);
+    if (!object || !object->events)
+    {
+        // trace
+        tb_trace_e("remove socket(%p) failed, not found!", sock);
+        return tb_false;
+    }
+
+    // exists the pending or finished operations? only clear the registered events and keep their results
+    if (object->ops[TB_IOURING_OBJECT_OP_RECV].state != TB_STATE_OK || object->ops[TB_IOURING_OBJECT_OP_SEND].state != TB_STATE_OK)
+    {
+        object->events = 0;
+        object->priv   = tb_null;
+        tb_poller_iouring_object_dirty(poller, object);
+    }
+    // kill this object
+    else tb_poller_iouring_object_kill(poller, object);
+    return tb_true;
+}
+static tb_long_t tb_poller_iouring_wait(tb_poller_ref_t self, tb_poller_sink_ref_t sink, tb_long_t timeout)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->fd >= 0 && sink, -1);
+
+    // notify the finished operations and update the poll requests of all dirty objects
+    tb_poller_iouring_spak_dirty(poller, sink);
+
+    // publish the pending entries
+    tb_barrier();
+    *poller->sq_tail = poller->sq_tail_local;
+    tb_barrier();
+
+    // init the timeout
+    struct __kernel_timespec        ts;
+    struct io_uring_getevents_arg   arg;
+    tb_memset(&arg, 0, sizeof(arg));
+    if (sink->size) timeout = 0;
+    if (timeout >= 0)
+    {
+        ts.tv_sec   = timeout / 1000;
+        ts.tv_nsec  = (timeout % 1000) * 1000000;
+        arg.ts      = (tb_uint64_t)(tb_size_t)&ts;
+    }
+
+    // submit all pending entries and wait completions
+    tb_uint32_t pending = poller->sq_tail_local - *((__tb_volatile__ tb_uint32_t*)poller->sq_head);
+    tb_uint32_t flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    if (syscall(__NR_io_uring_enter, poller->fd, pending, timeout? 1 : 0, flags, &arg, sizeof(arg)) < 0)
+    {
+        // interrupted(for gdb?), timeout or the completion queue is overflow? continue it
+        if (errno != EINTR && errno != ETIME && errno != EBUSY && errno != EAGAIN)
+        {
+            // trace
+            tb_trace_e("wait failed, errno: %d", errno);
+            return -1;
+        }
+    }
+
+    // walk all completions, the left completions will be kept in the queue for the next waiting if the sink is full
+    tb_bool_t   ok = tb_true;
+    tb_uint32_t head = *poller->cq_head;
+    tb_uint32_t tail = *((__tb_volatile__ tb_uint32_t*)poller->cq_tail);
+    tb_barrier();
+    for (; head != tail && !tb_poller_sink_full(sink); head++)
+    {
+        // get the completion
+        struct io_uring_cqe*    cqe = poller->cqes + (head & poller->cq_mask);
+        tb_size_t               tag = (tb_size_t)(cqe->user_data & TB_POLLER_IOURING_TAG_MASK);
+        tb_iouring_object_ref_t object = (tb_iouring_object_ref_t)(tb_size_t)(cqe->user_data & ~(tb_uint64_t)TB_POLLER_IOURING_TAG_MASK);
+        tb_int_t                res = cqe->res;
+
+        // the completion of the cancel request? ignore it
+        tb_check_continue(object);
+
+        // the completion of the poll request
+        if (tag == TB_POLLER_IOURING_TAG_POLL)
+        {
+            // the poll request has been finished? we need re-arm it
+            if (!(cqe->flags & IORING_CQE_F_MORE))
+            {
+                object->polling     = 0;
+                object->canceling   = 0;
+                object->refs--;
+                tb_poller_iouring_object_dirty(poller, object);
+            }
+
+            // killed, canceled or no registered events? ignore it
+            if (object->killing || !object->events || res == -ECANCELED) continue ;
+
+            // spak?
+            if (object->sock == poller->pair[1])
+            {
+                if (!tb_poller_iouring_spak_pair(poller)) ok = tb_false;
+                continue ;
+            }
+
+            // init events
+            tb_size_t events = TB_POLLER_EVENT_NONE;
+            if (res >= 0)
+            {
+                if (res & EPOLLIN) events |= TB_POLLER_EVENT_RECV;
+                if (res & EPOLLOUT) events |= TB_POLLER_EVENT_SEND;
+                if ((res & (EPOLLHUP | EPOLLERR)) && !(events & (TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND)))
+                    events |= TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND;
+                events &= object->events;
+
+                // connection closed for the edge trigger?
+                if ((res & EPOLLRDHUP) && (object->events & TB_POLLER_EVENT_CLEAR)) events |= TB_POLLER_EVENT_EOF;
+
+                /* the events of the pending operations will be notified by their completions
+                 *
+                 * the poll request may be triggered before it has been canceled,
+                 * and the coroutine will get nothing from the pending operation if we notify it now.
+                 */
+                tb_size_t i = 0;
+                for (i = 0; i < TB_IOURING_OBJECT_OP_MAXN; i++)
+                {
+                    if (object->ops[i].state == TB_STATE_WAITING) events &= ~g_iouring_object_events[i];
+                }
+
+                /* the eof will be notified by the completion of the recv operation too,
+                 *
+                 * we cannot report it now, because it will be cached as the next recv event
+                 * and the next recv will only post a new request and get nothing.
+                 */
+                if (object->ops[TB_IOURING_OBJECT_OP_RECV].state != TB_STATE_OK) events &= ~TB_POLLER_EVENT_EOF;
+            }
+            else events |= TB_POLLER_EVENT_ERROR;
+            tb_check_continue(events);
+
+            // the oneshot request has been triggered
+            if (object->events & TB_POLLER_EVENT_ONESHOT) object->triggered = 1;
+
+            // report events
+            tb_poller_sink_done(sink, self, object->sock, events, object->priv);
+        }
+        // the completion of the operation
+        else if (tag == TB_POLLER_IOURING_TAG_RECV || tag == TB_POLLER_IOURING_TAG_SEND)
+        {
+            // save the result, it will be notified after walking all completions
+            tb_iouring_object_op_t* op = &object->ops[tag - TB_POLLER_IOURING_TAG_RECV];
+            tb_assert(op->state == TB_STATE_WAITING);
+            op->state       = TB_STATE_FINISHED;
+            op->result      = res;
+            op->offset      = 0;
+            op->notified    = 0;
+            object->refs--;
+            tb_poller_iouring_object_dirty(poller, object);
+        }
+    }
+
+    // consume all completions
+    tb_barrier();
+    *poller->cq_head = head;
+
+    // killed?
+    tb_check_return_val(ok, -1);
+
+    // notify the finished operations
+    tb_poller_iouring_spak_dirty(poller, sink);
+
+    // ok
+    return sink->size;
+}
+static tb_poller_ref_t tb_poller_iouring_init(tb_cpointer_t priv)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_poller_iouring_ref_t poller = tb_null;
+    do
+    {
+        // make poller
+        poller = tb_malloc0_type(tb_poller_iouring_t);
+        tb_assert_and_check_break(poller);
+
+        // init socket data and objects
+        poller->fd = -1;
+        tb_sockdata_init(&poller->sockdata);
+        tb_list_entry_init(&poller->objects, tb_iouring_object_t, entry, tb_null);
+
+        // init io_uring
+        struct io_uring_params params;
+        tb_memset(&params, 0, sizeof(params));
+        params.flags        = IORING_SETUP_CQSIZE;
+        params.cq_entries   = TB_POLLER_IOURING_ENTRIES << 2;
+        poller->fd = (tb_int_t)syscall(__NR_io_uring_setup, TB_POLLER_IOURING_ENTRIES, &params);
+        if (poller->fd < 0)
+        {
+            // trace
+            tb_trace_d("io_uring_setup failed, errno: %d", errno);
+            break;
+        }
+
+        // check features
+        if ((params.features & TB_POLLER_IOURING_FEATURES) != TB_POLLER_IOURING_FEATURES)
+        {
+            // trace
+            tb_trace_d("io_uring features(%x) are not supported!", params.features);
+            break;
+        }
+
+        // map the submission and completion queues
+        poller->ring_size = tb_max(params.sq_off.array + params.sq_entries * sizeof(tb_uint32_t), params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+        poller->ring = (tb_byte_t*)mmap(tb_null, poller->ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->fd, IORING_OFF_SQ_RING);
+        if (poller->ring == MAP_FAILED)
+        {
+            poller->ring = tb_null;
+            break;
+        }
+
+        // map the submission queue entries
+        poller->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        poller->sqes = (struct io_uring_sqe*)mmap(tb_null, poller->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->fd, IORING_OFF_SQES);
+        if (poller->sqes == MAP_FAILED)
+        {
+            poller->sqes = tb_null;
+            break;
+        }
+
+        // init the submission queue
+        poller->sq_head         = (tb_uint32_t*)(poller->ring + params.sq_off.head);
+        poller->sq_tail         = (tb_uint32_t*)(poller->ring + params.sq_off.tail);
+        poller->sq_array        = (tb_uint32_t*)(poller->ring + params.sq_off.array);
+        poller->sq_mask         = *(tb_uint32_t*)(poller->ring + params.sq_off.ring_mask);
+        poller->sq_entries      = *(tb_uint32_t*)(poller->ring + params.sq_off.ring_entries);
+        poller->sq_tail_local   = *poller->sq_tail;
+
+        // init the completion queue
+        poller->cq_head         = (tb_uint32_t*)(poller->ring + params.cq_off.head);
+        poller->cq_tail         = (tb_uint32_t*)(poller->ring + params.cq_off.tail);
+        poller->cq_mask         = *(tb_uint32_t*)(poller->ring + params.cq_off.ring_mask);
+        poller->cqes            = (struct io_uring_cqe*)(poller->ring + params.cq_off.cqes);
+
+        // init user private data
+        poller->priv = priv;
+
+        // init pair sockets
+        if (!tb_socket_pair(TB_SOCKET_TYPE_TCP, poller->pair)) break;
+
+        // insert pair socket first
+        if (!tb_poller_iouring_insert((tb_poller_ref_t)poller, poller->pair[1], TB_POLLER_EVENT_RECV, tb_null)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (poller) tb_poller_iouring_exit((tb_poller_ref_t)poller);
+        poller = tb_null;
+    }
+
+    // ok?
+    return (tb_poller_ref_t)poller;
+}
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) && !defined(TB_CONFIG_MICRO_ENABLE)
+static tb_poller_iouring_ref_t tb_poller_iouring_self(tb_bool_t need)
+{
+    // get the poller of the current coroutine scheduler
+    tb_poller_ref_t poller = tb_null;
+    if (tb_co_scheduler_self())
+    {
+        tb_co_scheduler_io_ref_t scheduler_io = need? tb_co_scheduler_io_need(tb_null) : tb_co_scheduler_io_self();
+        if (scheduler_io) poller = scheduler_io->poller;
+    }
+    else if (tb_lo_scheduler_self_())
+    {
+        tb_lo_scheduler_io_ref_t scheduler_io = need? tb_lo_scheduler_io_need(tb_null) : tb_lo_scheduler_io_self();
+        if (scheduler_io) poller = scheduler_io->poller;
+    }
+
+    // only for the io_uring poller
+    return (poller && tb_poller_iouring_enabled())? (tb_poller_iouring_ref_t)poller : tb_null;
+}
+static tb_bool_t tb_poller_iouring_object_post(tb_iouring_object_ref_t object, tb_size_t index, tb_size_t code, tb_uint8_t opcode, tb_size_t size)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)object->poller;
+    tb_assert(poller && index < TB_IOURING_OBJECT_OP_MAXN);
+
+    // make request
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_assert_and_check_return_val(sqe, tb_false);
+
+    // init request
+    tb_iouring_object_op_t* op = &object->ops[index];
+    sqe->opcode     = opcode;
+    sqe->fd         = (tb_int_t)tb_sock2fd(object->sock);
+    sqe->user_data  = (tb_uint64_t)(tb_size_t)object | (TB_POLLER_IOURING_TAG_RECV + index);
+    switch (code)
+    {
+    case TB_IOURING_OBJECT_CODE_ACPT:
+        op->addrlen         = sizeof(op->addr);
+        sqe->addr           = (tb_uint64_t)(tb_size_t)&op->addr;
+        sqe->addr2          = (tb_uint64_t)(tb_size_t)&op->addrlen;
+        sqe->accept_flags   = SOCK_NONBLOCK;
+        break;
+    case TB_IOURING_OBJECT_CODE_CONN:
+        sqe->addr           = (tb_uint64_t)(tb_size_t)&op->addr;
+        sqe->off            = op->addrlen;
+        break;
+    default:
+        sqe->addr           = (tb_uint64_t)(tb_size_t)op->buffer;
+        sqe->len            = (tb_uint32_t)size;
+        break;
+    }
+
+    // mark as waiting
+    op->code    = (tb_uint8_t)code;
+    op->state   = TB_STATE_WAITING;
+    op->result  = 0;
+    op->offset  = 0;
+    object->refs++;
+
+    // the poll request for this operation may be canceled
+    tb_poller_iouring_object_dirty(poller, object);
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_object_buffer(tb_iouring_object_op_t* op, tb_size_t size)
+{
+    // grow the private buffer
+    if (op->maxn < size)
+    {
+        op->buffer = (tb_byte_t*)tb_ralloc(op->buffer, size);
+        tb_assert_and_check_return_val(op->buffer, tb_false);
+        op->maxn = size;
+    }
+    return tb_true;
+}
+static __tb_inline__ tb_void_t tb_poller_iouring_object_clear(tb_iouring_object_ref_t object, tb_iouring_object_op_t* op)
+{
+    // clear operation code and state
+    op->code        = TB_IOURING_OBJECT_CODE_NONE;
+    op->state       = TB_STATE_OK;
+    op->notified    = 0;
+
+    // we may need poll the events of this operation again
+    tb_poller_iouring_object_dirty((tb_poller_iouring_ref_t)object->poller, object);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
+{
+    // attempt to init the io_uring poller first
+    if (tb_atomic_get(&g_poller_iouring_state) >= 0)
+    {
+        tb_poller_ref_t poller = tb_poller_iouring_init(priv);
+        if (poller)
+        {
+            tb_atomic_set(&g_poller_iouring_state, 1);
+            return poller;
+        }
+
+        // the io_uring has been enabled? it may be not enough resources
+        tb_check_return_val(!tb_poller_iouring_enabled(), tb_null);
+
+        // trace
+        tb_trace_d("io_uring is not supported, fallback to epoll");
+
+        // disable io_uring and fallback to epoll
+        tb_atomic_set(&g_poller_iouring_state, -1);
+    }
+    return tb_poller_epoll_init(priv);
+}
+tb_void_t tb_poller_exit(tb_poller_ref_t self)
+{
+    if (tb_poller_iouring_enabled()) tb_poller_iouring_exit(self);
+    else tb_poller_epoll_exit(self);
+}
+tb_size_t tb_poller_type(tb_poller_ref_t poller)
+{
+    return tb_poller_iouring_enabled()? TB_POLLER_TYPE_IOURING : tb_poller_epoll_type(poller);
+}
+tb_cpointer_t tb_poller_priv(tb_poller_ref_t self)
+{
+    // uses epoll?
+    if (!tb_poller_iouring_enabled()) return tb_poller_epoll_priv(self);
+
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller, tb_null);
+
+    // get the user private data
+    return poller->priv;
+}
+tb_void_t tb_poller_kill(tb_poller_ref_t self)
+{
+    // uses epoll?
+    if (!tb_poller_iouring_enabled())
+    {
+        tb_poller_epoll_kill(self);
+        return ;
+    }
+
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // kill it, @note we cannot use tb_socket_send() because it may be posted to io_uring in coroutine
+    if (poller->pair[0]) send((tb_int_t)tb_sock2fd(poller->pair[0]), "k", 1, 0);
+}
+tb_void_t tb_poller_spak(tb_poller_ref_t self)
+{
+    // uses epoll?
+    if (!tb_poller_iouring_enabled())
+    {
+        tb_poller_epoll_spak(self);
+        return ;
+    }
+
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // post it
+    if (poller->pair[0]) send((tb_int_t)tb_sock2fd(poller->pair[0]), "p", 1, 0);
+}
+tb_bool_t tb_poller_support(tb_poller_ref_t self, tb_size_t events)
+{
+    // uses epoll?
+    if (!tb_poller_iouring_enabled()) return tb_poller_epoll_support(self, events);
+
+    // all supported events
+    static const tb_size_t events_supported = TB_POLLER_EVENT_EALL | TB_POLLER_EVENT_CLEAR | TB_POLLER_EVENT_ONESHOT;
+
+    // is supported?
+    return (events_supported & events) == events;
+}
+tb_bool_t tb_poller_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    return tb_poller_iouring_enabled()? tb_poller_iouring_insert(self, sock, events, priv) : tb_poller_epoll_insert(self, sock, events, priv);
+}
+tb_bool_t tb_poller_remove(tb_poller_ref_t self, tb_socket_ref_t sock)
+{
+    return tb_poller_iouring_enabled()? tb_poller_iouring_remove(self, sock) : tb_poller_epoll_remove(self, sock);
+}
+tb_bool_t tb_poller_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    return tb_poller_iouring_enabled()? tb_poller_iouring_modify(self, sock, events, priv) : tb_poller_epoll_modify(self, sock, events, priv);
+}
+static tb_long_t tb_poller_wait_sink(tb_poller_ref_t self, tb_poller_sink_ref_t sink, tb_long_t timeout)
+{
+    return tb_poller_iouring_enabled()? tb_poller_iouring_wait(self, sink, timeout) : tb_poller_epoll_wait_sink(self, sink, timeout);
+}
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) && !defined(TB_CONFIG_MICRO_ENABLE)
+tb_iouring_object_ref_t tb_iouring_object_get_or_new(tb_socket_ref_t sock)
+{
+    // get the io_uring poller of the current coroutine scheduler
+    tb_poller_iouring_ref_t poller = tb_poller_iouring_self(tb_true);
+    return (poller && sock != poller->pair[0] && sock != poller->pair[1])? tb_poller_iouring_object(poller, sock, tb_true) : tb_null;
+}
+tb_void_t tb_iouring_object_remove(tb_socket_ref_t sock)
+{
+    // get the io_uring poller of the current coroutine scheduler
+    tb_poller_iouring_ref_t poller = tb_poller_iouring_self(tb_false);
+    tb_check_return(poller && poller->fd >= 0);
+
+    // kill the object of this socket and cancel all pending requests
+    tb_iouring_object_ref_t object = tb_poller_iouring_object(poller, sock, tb_false);
+    if (object) tb_poller_iouring_object_kill(poller, object);
+}
+tb_socket_ref_t tb_iouring_object_accept(tb_iouring_object_ref_t object, tb_ipaddr_ref_t addr)
+{
+    // check
+    tb_assert_and_check_return_val(object && !object->killing, tb_null);
+
+    // continue to the previous operation
+    tb_iouring_object_op_t* op = &object->ops[TB_IOURING_OBJECT_OP_RECV];
+    if (op->code == TB_IOURING_OBJECT_CODE_ACPT)
+    {
+        // waiting now?
+        tb_check_return_val(op->state == TB_STATE_FINISHED, tb_null);
+
+        // get the result
+        tb_long_t fd = op->result;
+        tb_poller_iouring_object_clear(object, op);
+
+        // failed?
+        tb_check_return_val(fd >= 0, tb_null);
+
+        // disable the nagle's algorithm to fix 40ms ack delay, @see tb_socket_accept() in posix/socket.c
+        tb_int_t enable = 1;
+        setsockopt((tb_int_t)fd, IPPROTO_TCP, TCP_NODELAY, (tb_char_t*)&enable, sizeof(enable));
+
+        // save address
+        if (addr) tb_sockaddr_save(addr, &op->addr);
+        return tb_fd2sock(fd);
+    }
+
+    // check state
+    tb_assert_and_check_return_val(op->state == TB_STATE_OK, tb_null);
+
+    // post accept request
+    tb_poller_iouring_object_post(object, TB_IOURING_OBJECT_OP_RECV, TB_IOURING_OBJECT_CODE_ACPT, IORING_OP_ACCEPT, 0);
+    return tb_null;
+}
+tb_long_t tb_iouring_object_connect(tb_iouring_object_ref_t object, tb_ipaddr_ref_t addr)
+{
+    // check
+    tb_assert_and_check_return_val(object && !object->killing && addr, -1);
+
+    // continue to the previous operation
+    tb_iouring_object_op_t* op = &object->ops[TB_IOURING_OBJECT_OP_SEND];
+    if (op->code == TB_IOURING_OBJECT_CODE_CONN)
+    {
+        // waiting now?
+        tb_check_return_val(op->state == TB_STATE_FINISHED, 0);
+
+        // get the result
+        tb_long_t result = op->result;
+        tb_poller_iouring_object_clear(object, op);
+
+        // ok?
+        return (!result || result == -EISCONN)? 1 : -1;
+    }
+
+    // check state
+    tb_assert_and_check_return_val(op->state == TB_STATE_OK, -1);
+
+    // load address
+    op->addrlen = (socklen_t)tb_sockaddr_load(&op->addr, addr);
+    tb_check_return_val(op->addrlen, -1);
+
+    // post connect request
+    return tb_poller_iouring_object_post(object, TB_IOURING_OBJECT_OP_SEND, TB_IOURING_OBJECT_CODE_CONN, IORING_OP_CONNECT, 0)? 0 : -1;
+}
+tb_long_t tb_iouring_object_recv(tb_iouring_object_ref_t object, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(object && !object->killing && data && size, -1);
+
+    // continue to the previous operation
+    tb_iouring_object_op_t* op = &object->ops[TB_IOURING_OBJECT_OP_RECV];
+    if (op->code == TB_IOURING_OBJECT_CODE_RECV)
+    {
+        // waiting now?
+        tb_check_return_val(op->state == TB_STATE_FINISHED, 0);
+
+        // closed or failed?
+        tb_long_t result = op->result;
+        if (result <= 0)
+        {
+            tb_poller_iouring_object_clear(object, op);
+            return -1;
+        }
+
+        // copy the received data
+        tb_size_t real = tb_min((tb_size_t)result - op->offset, size);
+        tb_memcpy(data, op->buffer + op->offset, real);
+        op->offset += real;
+
+        // all received data have been read? clear it
+        if (op->offset >= (tb_size_t)result) tb_poller_iouring_object_clear(object, op);
+        return (tb_long_t)real;
+    }
+
+    // check state
+    tb_assert_and_check_return_val(op->state == TB_STATE_OK, -1);
+
+    // make the private buffer
+    size = tb_min(size, TB_IOURING_OBJECT_BUFFER_MAXN);
+    if (!tb_poller_iouring_object_buffer(op, size)) return -1;
+
+    // post recv request
+    return tb_poller_iouring_object_post(object, TB_IOURING_OBJECT_OP_RECV, TB_IOURING_OBJECT_CODE_RECV, IORING_OP_RECV, size)? 0 : -1;
+}
+tb_long_t tb_iouring_object_send(tb_iouring_object_ref_t object, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(object && !object->killing && data && size, -1);
+
+    // continue to the previous operation
+    tb_iouring_object_op_t* op = &object->ops[TB_IOURING_OBJECT_OP_SEND];
+    if (op->code == TB_IOURING_OBJECT_CODE_SEND)
+    {
+        // waiting now?
+        tb_check_return_val(op->state == TB_STATE_FINISHED, 0);
+
+        // get the result
+        tb_long_t result = op->result;
+        tb_poller_iouring_object_clear(object, op);
+
+        // ok?
+        return result > 0? result : -1;
+    }
+
+    // check state
+    tb_assert_and_check_return_val(op->state == TB_STATE_OK, -1);
+
+    // copy data to the private buffer
+    size = tb_min(size, TB_IOURING_OBJECT_BUFFER_MAXN);
+    if (!tb_poller_iouring_object_buffer(op, size)) return -1;
+    tb_memcpy(op->buffer, data, size);
+
+    // post send request
+    return tb_poller_iouring_object_post(object, TB_IOURING_OBJECT_OP_SEND, TB_IOURING_OBJECT_CODE_SEND, IORING_OP_SEND, size)? 0 : -1;
+}
+#endif
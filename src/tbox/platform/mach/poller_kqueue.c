@@ -351,11 +351,11 @@ tb_bool_t tb_poller_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t
     // ok?
     return ok;
 }
-tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_long_t timeout)
+static tb_long_t tb_poller_wait_sink(tb_poller_ref_t self, tb_poller_sink_ref_t sink, tb_long_t timeout)
 {
     // check
     tb_poller_kqueue_ref_t poller = (tb_poller_kqueue_ref_t)self;
-    tb_assert_and_check_return_val(poller && poller->kqfd > 0 && poller->maxn && func, -1);
+    tb_assert_and_check_return_val(poller && poller->kqfd > 0 && poller->maxn && sink, -1);
 
     // init time
     struct timespec t = {0};
@@ -374,9 +374,14 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
         tb_assert_and_check_return_val(poller->events, -1);
     }
 
-    // wait events
-    tb_long_t events_count = kevent(poller->kqfd, tb_null, 0, poller->events, poller->events_count, timeout >= 0? &t : tb_null);
-    tb_assert_and_check_return_val(events_count >= 0 && events_count <= poller->events_count, -1);
+    /* wait events
+     *
+     * we only get the events which can be saved to the sink, 
+     * the left events will be kept in kernel for the next waiting, even if they are edge-triggered.
+     */
+    tb_long_t events_maxn = tb_min(poller->events_count, tb_poller_sink_left(sink));
+    tb_long_t events_count = kevent(poller->kqfd, tb_null, 0, poller->events, events_maxn, timeout >= 0? &t : tb_null);
+    tb_assert_and_check_return_val(events_count >= 0 && events_count <= events_maxn, -1);
     
     // timeout?
     tb_check_return_val(events_count, 0);
@@ -399,7 +404,6 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
 
     // handle events 
     tb_size_t       i = 0;
-    tb_size_t       wait = 0;
     struct kevent*  e = tb_null;
     tb_socket_ref_t pair = poller->pair[1];
     for (i = 0; i < events_count; i++)
@@ -439,14 +443,11 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
         if (e->flags & EV_EOF) 
             events |= TB_POLLER_EVENT_EOF;
 
-        // call event function
-        func(self, sock, events, e->udata);
-
-        // update the events count
-        wait++;
+        // report events
+        tb_poller_sink_done(sink, self, sock, events, e->udata);
     }
 
     // ok
-    return wait;
+    return sink->size;
 }
 
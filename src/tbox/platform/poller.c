@@ -30,6 +30,7 @@
  */
 #include "poller.h"
 #include "impl/sockdata.h"
+#include "impl/pollersink.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -40,6 +41,11 @@
 #   else
 #       include "posix/poller_select.c"
 #   endif
+#elif defined(TB_CONFIG_POSIX_HAVE_IO_URING_SETUP) \
+    && defined(TB_CONFIG_POSIX_HAVE_EPOLL_CREATE) \
+    && defined(TB_CONFIG_POSIX_HAVE_EPOLL_WAIT) \
+    && !defined(TB_CONFIG_MICRO_ENABLE)
+#   include "linux/poller_iouring.c"
 #elif defined(TB_CONFIG_POSIX_HAVE_EPOLL_CREATE) \
     && defined(TB_CONFIG_POSIX_HAVE_EPOLL_WAIT)
 #   include "linux/poller_epoll.c"
@@ -92,10 +98,30 @@ tb_bool_t tb_poller_modify(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size
     tb_trace_noimpl();
     return tb_false;
 }
-tb_long_t tb_poller_wait(tb_poller_ref_t poller, tb_poller_event_func_t func, tb_long_t timeout)
+static tb_long_t tb_poller_wait_sink(tb_poller_ref_t poller, tb_poller_sink_ref_t sink, tb_long_t timeout)
 {
     tb_trace_noimpl();
     return 0;
 }
 #endif
+tb_long_t tb_poller_wait(tb_poller_ref_t poller, tb_poller_event_func_t func, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(poller && func, -1);
+
+    // wait events and call the event function
+    tb_poller_sink_t sink;
+    tb_poller_sink_init(&sink, func, tb_null, 0);
+    return tb_poller_wait_sink(poller, &sink, timeout);
+}
+tb_long_t tb_poller_wait_events(tb_poller_ref_t poller, tb_poller_event_ref_t events, tb_size_t maxn, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(poller && events && maxn, -1);
+
+    // wait events and save them to the events list
+    tb_poller_sink_t sink;
+    tb_poller_sink_init(&sink, tb_null, events, maxn);
+    return tb_poller_wait_sink(poller, &sink, timeout);
+}
 
@@ -45,6 +45,7 @@ typedef enum __tb_poller_type_e
 ,   TB_POLLER_TYPE_EPOLL        = 3
 ,   TB_POLLER_TYPE_KQUEUE       = 4
 ,   TB_POLLER_TYPE_SELECT       = 5
+,   TB_POLLER_TYPE_IOURING      = 6
 
 }tb_poller_type_e;
 
@@ -77,6 +78,20 @@ typedef enum __tb_poller_event_e
 /// the poller ref type
 typedef __tb_typeref__(poller);
 
+/// the poller event type
+typedef struct __tb_poller_event_t
+{
+    /// the socket
+    tb_socket_ref_t     sock;
+
+    /// the poller events
+    tb_size_t           events;
+
+    /// the user private data for this socket
+    tb_cpointer_t       priv;
+
+}tb_poller_event_t, *tb_poller_event_ref_t;
+
 /*! the poller event func type
  *
  * @param poller    the poller
@@ -182,6 +197,35 @@ tb_bool_t           tb_poller_modify(tb_poller_ref_t poller, tb_socket_ref_t soc
  */
 tb_long_t           tb_poller_wait(tb_poller_ref_t poller, tb_poller_event_func_t func, tb_long_t timeout);
 
+/*! wait all sockets and get the ready events in batch
+ *
+ * it's similar to tb_poller_wait(), but we need not call the event function for each socket.
+ * the left ready events will be returned by the next waiting if the events list is full,
+ * and the events of the edge trigger (TB_POLLER_EVENT_CLEAR) will be not lost.
+ *
+ * @code
+    tb_long_t           i = 0;
+    tb_long_t           count = 0;
+    tb_poller_event_t   events[64];
+    while ((count = tb_poller_wait_events(poller, events, tb_arrayn(events), -1)) >= 0)
+    {
+        for (i = 0; i < count; i++)
+        {
+            // handle events[i].sock, events[i].events and events[i].priv
+            // ...
+        }
+    }
+ * @endcode
+ *
+ * @param poller    the poller
+ * @param events    the events list
+ * @param maxn      the events list maxn
+ * @param timeout   the timeout, infinity: -1
+ *
+ * @return          > 0: the events number, 0: timeout, -1: failed
+ */
+tb_long_t           tb_poller_wait_events(tb_poller_ref_t poller, tb_poller_event_ref_t events, tb_size_t maxn, tb_long_t timeout);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -276,17 +276,16 @@ tb_bool_t tb_poller_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t
     // ok
     return tb_true;
 }
-tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_long_t timeout)
+static tb_long_t tb_poller_wait_sink(tb_poller_ref_t self, tb_poller_sink_ref_t sink, tb_long_t timeout)
 {
     // check
     tb_poller_poll_ref_t poller = (tb_poller_poll_ref_t)self;
-    tb_assert_and_check_return_val(poller && poller->pfds && poller->cfds && func, -1);
+    tb_assert_and_check_return_val(poller && poller->pfds && poller->cfds && sink, -1);
 
     // loop
-    tb_long_t wait = 0;
     tb_bool_t stop = tb_false;
     tb_hong_t time = tb_mclock();
-    while (!wait && !stop && (timeout < 0 || tb_mclock() < time + timeout))
+    while (!sink->size && !stop && (timeout < 0 || tb_mclock() < time + timeout))
     {
         // pfds
         struct pollfd*  pfds = (struct pollfd*)tb_vector_data(poller->pfds);
@@ -307,9 +306,9 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
         pfds = (struct pollfd*)tb_vector_data(poller->cfds);
         pfdm = tb_vector_size(poller->cfds);
 
-        // sync
+        // sync, the left events will be reported in the next waiting if the sink is full
         tb_size_t i = 0;
-        for (i = 0; i < pfdm; i++)
+        for (i = 0; i < pfdm && !tb_poller_sink_full(sink); i++)
         {
             // the sock
             tb_socket_ref_t sock = tb_fd2sock(pfds[i].fd);
@@ -346,15 +345,12 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
             if ((poll_events & POLLHUP) && !(events & (TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND))) 
                 events |= TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND;
 
-            // call event function
-            func(self, sock, events, tb_sockdata_get(&poller->sockdata, sock));
-
-            // update the events count
-            wait++;
+            // report events
+            tb_poller_sink_done(sink, self, sock, events, tb_sockdata_get(&poller->sockdata, sock));
         }
     }
 
     // ok
-    return wait;
+    return sink->size;
 }
 
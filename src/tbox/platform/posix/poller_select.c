@@ -321,11 +321,11 @@ tb_bool_t tb_poller_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t
     // ok
     return tb_true;
 }
-tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_long_t timeout)
+static tb_long_t tb_poller_wait_sink(tb_poller_ref_t self, tb_poller_sink_ref_t sink, tb_long_t timeout)
 {
     // check
     tb_poller_select_ref_t poller = (tb_poller_select_ref_t)self;
-    tb_assert_and_check_return_val(poller && func, -1);
+    tb_assert_and_check_return_val(poller && sink, -1);
 
     // init time
     struct timeval t = {0};
@@ -340,10 +340,10 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
     }
 
     // loop
-    tb_long_t wait = 0;
     tb_bool_t stop = tb_false;
+    tb_bool_t killed = tb_false;
     tb_hong_t time = tb_mclock();
-    while (!wait && !stop && (timeout < 0 || tb_mclock() < time + timeout))
+    while (!sink->size && !stop && !killed && (timeout < 0 || tb_mclock() < time + timeout))
     {
         // copy fds
         tb_memcpy(&poller->rfdc, &poller->rfds, sizeof(fd_set));
@@ -360,14 +360,11 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
         // timeout?
         tb_check_return_val(sfdn, 0);
         
-        // dispatch events
+        // dispatch events, the left events will be reported in the next waiting if the sink is full
         tb_size_t i = 0;
         tb_size_t n = poller->list_size;
-        for (i = 0; i < n; i++)
+        for (i = 0; i < n && !tb_poller_sink_full(sink); i++)
         {
-            // end?
-            tb_check_break(wait >= 0);
-
             // check
             tb_assert_and_check_return_val(poller->list, -1);
 
@@ -380,11 +377,11 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
             {
                 // read spak
                 tb_char_t spak = '\0';
-                if (1 != tb_socket_recv(poller->pair[1], (tb_byte_t*)&spak, 1)) wait = -1;
+                if (1 != tb_socket_recv(poller->pair[1], (tb_byte_t*)&spak, 1)) killed = tb_true;
 
                 // killed?
-                if (spak == 'k') wait = -1;
-                tb_check_break(wait >= 0);
+                if (spak == 'k') killed = tb_true;
+                tb_check_break(!killed);
 
                 // stop to wait
                 stop = tb_true;
@@ -415,19 +412,12 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
                 events |= TB_POLLER_EVENT_ERROR;
 #endif
 
-            // exists events?
-            if (events)
-            {
-                // call event function
-                func(self, sock, events, poller->list[i].priv);
-
-                // update the events count
-                wait++;
-            }
+            // report events
+            if (events) tb_poller_sink_done(sink, self, sock, events, poller->list[i].priv);
         }
     }
 
     // ok
-    return wait;
+    return killed? -1 : sink->size;
 }
 
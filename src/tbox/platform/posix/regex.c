@@ -56,6 +56,75 @@ typedef struct __tb_regex_t
 
 }tb_regex_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_long_t tb_regex_exec(tb_regex_t* regex, tb_char_t const* cstr, tb_size_t size, tb_size_t start)
+{
+    // check
+    tb_assert_and_check_return_val(regex && cstr, -1);
+
+    // the substring count
+    tb_size_t count = 1 + regex->code.re_nsub;
+
+    // init match data
+    if (!regex->match_data)
+    {
+        regex->match_maxn = tb_max(16, count);
+        regex->match_data = (regmatch_t*)tb_malloc_bytes(sizeof(regmatch_t) * regex->match_maxn);
+    }
+    tb_assert_and_check_return_val(regex->match_data, -1);
+
+    // check
+    tb_assert(size <= tb_strlen(cstr));
+
+    /* match it
+     *
+     * @note the start position is not the beginning of the line if start > 0,
+     * so '^' cannot be matched at it when we continue to match the next one in tb_regex_match_all()
+     */
+    tb_long_t error = -1;
+    tb_int_t  eflags = start? REG_NOTBOL : 0;
+    while (REG_ESPACE == (error = regexec(&regex->code, cstr + start, regex->match_maxn, regex->match_data, eflags)))
+    {
+        // grow match data
+        regex->match_maxn <<= 1;
+        regex->match_data = (regmatch_t*)tb_ralloc_bytes(regex->match_data, sizeof(regmatch_t) * regex->match_maxn);
+        tb_assert_and_check_return_val(regex->match_data, -1);
+    }
+    if (error)
+    {
+        // no match?
+        tb_check_return_val(error != REG_NOMATCH, 0);
+
+#ifdef __tb_debug__
+        // get error info
+        tb_char_t info[256] = {0};
+        regerror(error, &regex->code, info, sizeof(info));
+
+        // trace
+        tb_trace_d("match failed at offset %lu: error: %s\n", start, info);
+#endif
+
+        // failed
+        return -1;
+    }
+
+    // ok
+    return count;
+}
+static tb_bool_t tb_regex_exec_substr(tb_regex_t* regex, tb_size_t start, tb_size_t index, tb_size_t* poffset, tb_size_t* plength)
+{
+    // this substring is not matched?
+    regmatch_t const* match = regex->match_data;
+    tb_check_return_val(index < regex->match_maxn && match[index].rm_so >= 0, tb_false);
+
+    // get the substring offset and length, the offsets of posix are relative to the start position
+    *poffset = start + (tb_size_t)match[index].rm_so;
+    *plength = (tb_size_t)(match[index].rm_eo - match[index].rm_so);
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -148,117 +217,18 @@ tb_long_t tb_regex_match(tb_regex_ref_t self, tb_char_t const* cstr, tb_size_t s
     tb_regex_t* regex = (tb_regex_t*)self;
     tb_assert_and_check_return_val(regex && cstr, -1);
 
-    // done
-    tb_long_t ok = -1;
-    do
-    {
-        // clear length first
-        if (plength) *plength = 0;
-
-        // end?
-        tb_check_break(start < size);
-
-        // init match data
-        if (!regex->match_data)
-        {
-            regex->match_maxn = 16;
-            regex->match_data = (regmatch_t*)tb_malloc_bytes(sizeof(regmatch_t) * regex->match_maxn);
-        }
-        tb_assert_and_check_break(regex->match_data);
-
-        // check
-        tb_assert(size <= tb_strlen(cstr));
-
-        // match it
-        tb_long_t error = -1;
-        while (REG_ESPACE == (error = regexec(&regex->code, cstr + start, regex->match_maxn, regex->match_data, 0)))
-        {
-            // grow match data
-            regex->match_maxn <<= 1;
-            regex->match_data = (regmatch_t*)tb_ralloc_bytes(regex->match_data, sizeof(regmatch_t) * regex->match_maxn);
-            tb_assert_and_check_break(regex->match_data);
-        }
-        if (error)
-        {
-            // no match?
-            tb_check_break(error != REG_NOMATCH);
+    // clear length first
+    if (plength) *plength = 0;
 
-#ifdef __tb_debug__
-            // get error info
-            tb_char_t info[256] = {0};
-            regerror(error, &regex->code, info, sizeof(info));
+    // end?
+    tb_check_return_val(start < size, -1);
 
-            // trace
-            tb_trace_d("match failed at offset %lu: error: %s\n", start, info);
-#endif
-
-            // end
-            break;
-        }
-
-        // get the match offset and length
-        regmatch_t const*   match = regex->match_data;
-        tb_size_t           count = 1 + regex->code.re_nsub;
-        tb_size_t           offset = start + (tb_size_t)match[0].rm_so;
-        tb_size_t           length = (tb_size_t)match[0].rm_eo - match[0].rm_so;
-        tb_check_break(offset + length <= size);
-
-        // trace
-        tb_trace_d("matched count: %lu, offset: %lu, length: %lu", count, offset, length);
+    // match it
+    tb_long_t count = tb_regex_exec(regex, cstr, size, start);
+    tb_check_return_val(count > 0, -1);
 
-        // save results
-        if (presults)
-        {
-            // init results if not exists
-            tb_vector_ref_t results = *presults;
-            if (!results)
-            {
-                // init it
-                if (!regex->results) regex->results = tb_vector_init(16, tb_element_mem(sizeof(tb_regex_match_t), tb_regex_match_exit, tb_null));
-
-                // save it
-                *presults = results = regex->results;
-            }
-            tb_assert_and_check_break(results);
-
-            // clear it first
-            tb_vector_clear(results);
-
-            // done
-            tb_long_t           i = 0;
-            tb_regex_match_t    entry;
-            for (i = 0; i < count; i++)
-            {
-                // get substring offset and length
-                tb_size_t substr_offset = start + match[i].rm_so;
-                tb_size_t substr_length = match[i].rm_eo - match[i].rm_so;
-                tb_assert_and_check_break(substr_offset + substr_length <= size);
-
-                // make match entry
-                entry.cstr  = tb_strndup(cstr + substr_offset, substr_length);
-                entry.size  = substr_length;
-                entry.start = substr_offset;
-                tb_assert_and_check_break(entry.cstr);
-                
-                // trace
-                tb_trace_d("    matched: [%lu, %lu]: %s", entry.start, entry.size, entry.cstr);
-
-                // append it
-                tb_vector_insert_tail(results, &entry);
-            }
-            tb_assert_and_check_break(i == count);
-        }
-
-        // save length 
-        if (plength) *plength = length;
-
-        // ok
-        ok = offset;
-
-    } while (0);
-
-    // ok?
-    return ok;
+    // save results
+    return tb_regex_match_save(regex, &regex->results, cstr, size, start, (tb_size_t)count, plength, presults);
 }
 tb_char_t const* tb_regex_replace(tb_regex_ref_t self, tb_char_t const* cstr, tb_size_t size, tb_size_t start, tb_char_t const* replace_cstr, tb_size_t replace_size, tb_size_t* plength)
 {
@@ -293,8 +263,7 @@ tb_char_t const* tb_regex_replace(tb_regex_ref_t self, tb_char_t const* cstr, tb
         tb_long_t       suboffset = start;
         tb_size_t       sublength = 0;
         tb_size_t       length = 0;
-        tb_vector_ref_t results = tb_null;
-        while ((suboffset = tb_regex_match(self, regex->buffer_data, size, suboffset + sublength, &sublength, &results)) >= 0 && results)
+        while ((suboffset = tb_regex_match(self, regex->buffer_data, size, suboffset + sublength, &sublength, tb_null)) >= 0)
         {
             // trace
             tb_trace_d("replace: match: [%lu, %lu]", suboffset, sublength);
@@ -45,6 +45,14 @@
 #   include "../../coroutine/coroutine.h"
 #   include "../../coroutine/impl/impl.h"
 #endif
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+    && defined(TB_CONFIG_POSIX_HAVE_IO_URING_SETUP) \
+    && defined(TB_CONFIG_POSIX_HAVE_EPOLL_CREATE) \
+    && defined(TB_CONFIG_POSIX_HAVE_EPOLL_WAIT) \
+    && !defined(TB_CONFIG_MICRO_ENABLE)
+#   include "../linux/iouring_object.h"
+#   define TB_SOCKET_HAVE_IOURING_OBJECT
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
@@ -311,6 +319,12 @@ tb_long_t tb_socket_connect(tb_socket_ref_t sock, tb_ipaddr_ref_t addr)
     tb_assert_and_check_return_val(sock && addr, -1);
     tb_assert_and_check_return_val(!tb_ipaddr_is_empty(addr), -1);
 
+#ifdef TB_SOCKET_HAVE_IOURING_OBJECT
+    // attempt to use io_uring object to connect it if exists
+    tb_iouring_object_ref_t object = tb_iouring_object_get_or_new(sock);
+    if (object) return tb_iouring_object_connect(object, addr);
+#endif
+
     // load addr
     tb_size_t               n = 0;
     struct sockaddr_storage d = {0};
@@ -390,6 +404,12 @@ tb_socket_ref_t tb_socket_accept(tb_socket_ref_t sock, tb_ipaddr_ref_t addr)
     // check
     tb_assert_and_check_return_val(sock, tb_null);
 
+#ifdef TB_SOCKET_HAVE_IOURING_OBJECT
+    // attempt to use io_uring object to accept it if exists
+    tb_iouring_object_ref_t object = tb_iouring_object_get_or_new(sock);
+    if (object) return tb_iouring_object_accept(object, addr);
+#endif
+
     // done  
     struct sockaddr_storage d = {0};
     socklen_t               n = sizeof(struct sockaddr_in);
@@ -497,6 +517,11 @@ tb_bool_t tb_socket_exit(tb_socket_ref_t sock)
     if ((scheduler_io = tb_lo_scheduler_io_self()) && tb_lo_scheduler_io_cancel((tb_lo_scheduler_io_ref_t)scheduler_io, sock)) {}
 #endif
 
+#ifdef TB_SOCKET_HAVE_IOURING_OBJECT
+    // remove io_uring object for this socket if exists
+    tb_iouring_object_remove(sock);
+#endif
+
     // close it
     tb_bool_t ok = !close(tb_sock2fd(sock));
     
@@ -516,6 +541,12 @@ tb_long_t tb_socket_recv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size)
     tb_assert_and_check_return_val(sock && data, -1);
     tb_check_return_val(size, 0);
 
+#ifdef TB_SOCKET_HAVE_IOURING_OBJECT
+    // attempt to use io_uring object to recv data if exists
+    tb_iouring_object_ref_t object = tb_iouring_object_get_or_new(sock);
+    if (object) return tb_iouring_object_recv(object, data, size);
+#endif
+
     // recv
     tb_long_t real = recv(tb_sock2fd(sock), data, (tb_int_t)size, 0);
 
@@ -534,6 +565,12 @@ tb_long_t tb_socket_send(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t
     tb_assert_and_check_return_val(sock && data, -1);
     tb_check_return_val(size, 0);
 
+#ifdef TB_SOCKET_HAVE_IOURING_OBJECT
+    // attempt to use io_uring object to send data if exists
+    tb_iouring_object_ref_t object = tb_iouring_object_get_or_new(sock);
+    if (object) return tb_iouring_object_send(object, data, size);
+#endif
+
     // send
     tb_long_t real = send(tb_sock2fd(sock), data, (tb_int_t)size, 0);
 
@@ -23,6 +23,103 @@
  * includes
  */
 #include "processor.h"
+#if (defined(TB_ARCH_x86) || defined(TB_ARCH_x64)) && defined(TB_COMPILER_IS_GCC)
+#   include <cpuid.h>
+#   define TB_PROCESSOR_HAVE_CPUID
+#elif (defined(TB_ARCH_x86) || defined(TB_ARCH_x64)) && defined(TB_COMPILER_IS_MSVC)
+#   include <intrin.h>
+#   define TB_PROCESSOR_HAVE_CPUID
+#elif defined(TB_ARCH_ARM64) && (defined(TB_CONFIG_OS_LINUX) || defined(TB_CONFIG_OS_ANDROID))
+#   include <sys/auxv.h>
+#   define TB_PROCESSOR_HAVE_HWCAP
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the processor features, -1: not detected
+static tb_size_t g_processor_features = (tb_size_t)-1;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#if defined(TB_PROCESSOR_HAVE_CPUID)
+static tb_void_t tb_processor_cpuid(tb_uint32_t leaf, tb_uint32_t subleaf, tb_uint32_t regs[4])
+{
+#   ifdef TB_COMPILER_IS_MSVC
+    __cpuidex((int*)regs, (int)leaf, (int)subleaf);
+#   else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#   endif
+}
+static tb_uint64_t tb_processor_xgetbv(tb_noarg_t)
+{
+#   ifdef TB_COMPILER_IS_MSVC
+    return (tb_uint64_t)_xgetbv(0);
+#   else
+    tb_uint32_t eax = 0;
+    tb_uint32_t edx = 0;
+    __tb_asm__ __tb_volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (0));
+    return ((tb_uint64_t)edx << 32) | eax;
+#   endif
+}
+static tb_size_t tb_processor_features_detect(tb_noarg_t)
+{
+    // get the max leaf
+    tb_uint32_t regs[4] = {0};
+    tb_processor_cpuid(0, 0, regs);
+    tb_uint32_t maxleaf = regs[0];
+    tb_check_return_val(maxleaf >= 1, TB_PROCESSOR_FEATURE_NONE);
+
+    // get the basic features
+    tb_size_t features = TB_PROCESSOR_FEATURE_NONE;
+    tb_processor_cpuid(1, 0, regs);
+    if (regs[3] & (1 << 26)) features |= TB_PROCESSOR_FEATURE_SSE2;
+    if (regs[2] & (1 << 20)) features |= TB_PROCESSOR_FEATURE_SSE42;
+    if (regs[2] & (1 << 1)) features |= TB_PROCESSOR_FEATURE_PCLMUL;
+
+    // the os must save the ymm/zmm registers for avx (osxsave && avx)
+    tb_uint64_t xcr0 = 0;
+    if ((regs[2] & (1 << 27)) && (regs[2] & (1 << 28))) xcr0 = tb_processor_xgetbv();
+
+    // get the extended features
+    if (maxleaf >= 7 && (xcr0 & 0x6) == 0x6)
+    {
+        tb_processor_cpuid(7, 0, regs);
+        if (regs[1] & (1 << 5)) features |= TB_PROCESSOR_FEATURE_AVX2;
+        if ((regs[1] & (1 << 16)) && (regs[1] & (1 << 30)) && (xcr0 & 0xe6) == 0xe6) features |= TB_PROCESSOR_FEATURE_AVX512;
+    }
+    return features;
+}
+#elif defined(TB_ARCH_ARM64)
+static tb_size_t tb_processor_features_detect(tb_noarg_t)
+{
+    // neon is always available for arm64
+    tb_size_t features = TB_PROCESSOR_FEATURE_NEON;
+
+#   ifdef TB_PROCESSOR_HAVE_HWCAP
+    // get the other features from hwcap
+    tb_size_t hwcap = (tb_size_t)getauxval(AT_HWCAP);
+    if (hwcap & (1 << 4)) features |= TB_PROCESSOR_FEATURE_PMULL;
+    if (hwcap & (1 << 7)) features |= TB_PROCESSOR_FEATURE_CRC32;
+    if (hwcap & (1 << 22)) features |= TB_PROCESSOR_FEATURE_SVE;
+#   elif defined(TB_CONFIG_OS_MACOSX) || defined(TB_CONFIG_OS_IOS)
+    // all apple arm64 processors support them
+    features |= TB_PROCESSOR_FEATURE_PMULL | TB_PROCESSOR_FEATURE_CRC32;
+#   endif
+    return features;
+}
+#else
+static tb_size_t tb_processor_features_detect(tb_noarg_t)
+{
+#   if defined(TB_ARCH_ARM_NEON)
+    return TB_PROCESSOR_FEATURE_NEON;
+#   else
+    return TB_PROCESSOR_FEATURE_NONE;
+#   endif
+}
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -37,4 +134,10 @@ tb_size_t tb_processor_count()
     return 1;
 }
 #endif
-
+tb_size_t tb_processor_features()
+{
+    // detect them only once, it is also safe if multiple threads detect them at the same time
+    if (g_processor_features == (tb_size_t)-1) 
+        g_processor_features = tb_processor_features_detect();
+    return g_processor_features;
+}
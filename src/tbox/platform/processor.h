@@ -32,6 +32,30 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the processor feature enum
+typedef enum __tb_processor_feature_e
+{
+    TB_PROCESSOR_FEATURE_NONE       = 0
+
+    // x86/x64
+,   TB_PROCESSOR_FEATURE_SSE2       = 1 << 0
+,   TB_PROCESSOR_FEATURE_SSE42      = 1 << 1
+,   TB_PROCESSOR_FEATURE_PCLMUL     = 1 << 2
+,   TB_PROCESSOR_FEATURE_AVX2       = 1 << 3   //!< the cpu and os both support avx2
+,   TB_PROCESSOR_FEATURE_AVX512     = 1 << 4   //!< avx512f and avx512bw
+
+    // arm/arm64
+,   TB_PROCESSOR_FEATURE_NEON       = 1 << 8
+,   TB_PROCESSOR_FEATURE_CRC32      = 1 << 9
+,   TB_PROCESSOR_FEATURE_PMULL      = 1 << 10
+,   TB_PROCESSOR_FEATURE_SVE        = 1 << 11
+
+}tb_processor_feature_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -42,6 +66,15 @@ __tb_extern_c_enter__
  */
 tb_size_t               tb_processor_count(tb_noarg_t);
 
+/*! the processor features
+ *
+ * they are detected once from cpuid or hwcap when initializing tbox,
+ * and the optimized routines (e.g. libc/string) will be chosen by them.
+ *
+ * @return              the processor features, e.g. TB_PROCESSOR_FEATURE_SSE2 | TB_PROCESSOR_FEATURE_AVX2
+ */
+tb_size_t               tb_processor_features(tb_noarg_t);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
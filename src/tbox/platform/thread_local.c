@@ -44,6 +44,9 @@ static tb_single_list_entry_head_t  g_thread_local_list;
 // the thread local list lock
 static tb_spinlock_t                g_thread_local_lock = TB_SPINLOCK_INIT;
 
+// the thread local envirnoment has been initialized?
+static tb_bool_t                    g_thread_local_ready = tb_false;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -56,6 +59,7 @@ tb_bool_t tb_thread_local_init_env()
     tb_single_list_entry_init(&g_thread_local_list, tb_thread_local_t, entry, tb_null);
 
     // ok
+    g_thread_local_ready = tb_true;
     return tb_true;
 }
 tb_void_t tb_thread_local_exit_env()
@@ -63,6 +67,9 @@ tb_void_t tb_thread_local_exit_env()
     // enter lock
     tb_spinlock_enter(&g_thread_local_lock);
 
+    // mark it as not ready before exiting all thread locals
+    g_thread_local_ready = tb_false;
+
     // exit all thread locals
     tb_for_all_if (tb_thread_local_ref_t, local, tb_single_list_entry_itor(&g_thread_local_list), local)
     {
@@ -79,6 +86,10 @@ tb_void_t tb_thread_local_exit_env()
     // exit lock
     tb_spinlock_exit(&g_thread_local_lock);
 }
+tb_bool_t tb_thread_local_env_ready()
+{
+    return g_thread_local_ready;
+}
 tb_void_t tb_thread_local_walk(tb_walk_func_t func, tb_cpointer_t priv)
 {
     // enter lock
@@ -34,6 +34,11 @@
 #include "../memory/memory.h"
 #include "../container/container.h"
 #include "../algorithm/algorithm.h"
+#ifdef TB_CONFIG_POSIX_HAVE_FUTEX
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -74,6 +79,33 @@
 #   define TB_THREAD_POOL_JOBS_PULL_TIME_MAXN   (20000)
 #endif
 
+// the stealing deque maxn of each worker, must be power of 2
+#ifdef __tb_small__
+#   define TB_THREAD_POOL_DEQUE_MAXN            (256)
+#else
+#   define TB_THREAD_POOL_DEQUE_MAXN            (1024)
+#endif
+
+// the injection queue maxn of the stealing mode, must be power of 2
+#ifdef __tb_small__
+#   define TB_THREAD_POOL_QUEUE_MAXN            (1 << 12)
+#else
+#   define TB_THREAD_POOL_QUEUE_MAXN            (1 << 16)
+#endif
+
+// the jobs grab maxn from the injection queue at once
+#define TB_THREAD_POOL_JOBS_GRAB_MAXN           (32)
+
+// the free jobs cache maxn of each worker
+#ifdef __tb_small__
+#   define TB_THREAD_POOL_JOBS_FREE_MAXN        (64)
+#else
+#   define TB_THREAD_POOL_JOBS_FREE_MAXN        (256)
+#endif
+
+// the spinning count of the idle worker before parking it
+#define TB_THREAD_POOL_WORKER_SPIN_MAXN         (16)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -100,6 +132,12 @@ typedef struct __tb_thread_pool_job_t
     // the entry
     tb_list_entry_t                     entry;
 
+    // the killing generation of the pool when posting it, only for the stealing mode
+    tb_long_t                           killing;
+
+    // the next free job in the worker cache, only for the stealing mode
+    struct __tb_thread_pool_job_t*      free_next;
+
 }tb_thread_pool_job_t;
 
 // the thread pool job stats type
@@ -113,6 +151,61 @@ typedef struct __tb_thread_pool_job_stats_t
 
 }tb_thread_pool_job_stats_t;
 
+/* the thread pool deque type for the stealing mode
+ *
+ * the Chase-Lev work-stealing deque with the fixed size buffer, 
+ * the owner worker pushes and pops jobs at the bottom, the other workers steal jobs from the top.
+ */
+typedef struct __tb_thread_pool_deque_t
+{
+    // the top index, it will be modified by the stealing workers
+    tb_atomic_t                         top;
+
+    // the padding for avoiding false sharing
+    tb_byte_t                           top_pad[TB_L1_CACHE_BYTES];
+
+    // the bottom index, it will be modified by the owner worker only
+    tb_atomic_t                         bottom;
+
+    // the jobs buffer
+    tb_thread_pool_job_t* volatile*     jobs;
+
+}tb_thread_pool_deque_t;
+
+// the thread pool queue cell type
+typedef struct __tb_thread_pool_queue_cell_t
+{
+    // the sequence
+    tb_atomic_t                         seq;
+
+    // the job
+    tb_thread_pool_job_t* volatile      job;
+
+}tb_thread_pool_queue_cell_t;
+
+/* the thread pool queue type for the stealing mode
+ *
+ * the bounded lock-free MPMC queue (Vyukov), it will be used to inject the posted jobs to the workers
+ */
+typedef struct __tb_thread_pool_queue_t
+{
+    // the head index
+    tb_atomic_t                         head;
+
+    // the padding for avoiding false sharing
+    tb_byte_t                           head_pad[TB_L1_CACHE_BYTES];
+
+    // the tail index
+    tb_atomic_t                         tail;
+
+    // the padding for avoiding false sharing
+    tb_byte_t                           tail_pad[TB_L1_CACHE_BYTES];
+
+    // the cells
+    tb_thread_pool_queue_cell_t*        cells;
+
+}tb_thread_pool_queue_t;
+
 // the thread pool worker priv type
 typedef struct __tb_thread_pool_worker_priv_t
 {
@@ -148,6 +241,18 @@ typedef struct __tb_thread_pool_worker_t
     // is stoped?
     tb_atomic_t                         bstoped;
 
+    // the stealing deque, only for the stealing mode
+    tb_thread_pool_deque_t              deque;
+
+    // the free jobs cache, only for the stealing mode
+    tb_thread_pool_job_t*               jobs_free;
+
+    // the free jobs count
+    tb_size_t                           jobs_free_size;
+
+    // the random seed for choosing the stealing victim
+    tb_size_t                           steal_seed;
+
     // the private data 
     tb_thread_pool_worker_priv_t        priv[TB_THREAD_POOL_WORKER_PRIV_MAXN];
 
@@ -186,11 +291,47 @@ typedef struct __tb_thread_pool_impl_t
     // the worker size
     tb_size_t                           worker_size;
 
+    // is stealing mode?
+    tb_bool_t                           stealing;
+
+    // the urgent jobs queue for the stealing mode
+    tb_thread_pool_queue_t              queue_urgent;
+
+    // the waiting jobs queue for the stealing mode
+    tb_thread_pool_queue_t              queue_waiting;
+
+    // the jobs count for the stealing mode
+    tb_atomic_t                         jobs_size;
+
+    // the killing generation of all jobs for the stealing mode, it will be increased after killing all jobs
+    tb_atomic_t                         jobs_killing;
+
+    // the overflow jobs count in jobs_waiting if the waiting queue is full for the stealing mode
+    tb_atomic_t                         jobs_overflow;
+
+    // the idle workers count for the stealing mode
+    tb_atomic_t                         worker_idle;
+
+    // the starting workers count for the stealing mode
+    tb_atomic_t                         worker_starting;
+
+#ifdef TB_CONFIG_POSIX_HAVE_FUTEX
+    // the parking futex of the idle workers for the stealing mode
+    tb_int32_t volatile                 parking;
+#endif
+
     // the worker list
     tb_thread_pool_worker_t             worker_list[TB_THREAD_POOL_WORKER_MAXN];
 
 }tb_thread_pool_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the current worker of the stealing mode
+static tb_thread_local_t g_thread_pool_worker_self = TB_THREAD_LOCAL_INIT;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * instance implementation
  */
@@ -215,6 +356,478 @@ static tb_void_t tb_thread_pool_instance_kill(tb_handle_t pool, tb_cpointer_t pr
     tb_thread_pool_kill((tb_thread_pool_ref_t)pool);
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * stealing implementation
+ */
+static __tb_inline__ tb_long_t tb_thread_pool_atomic_load(tb_atomic_t* a)
+{
+    // load it without the write operation, tb_atomic_get() will lock the bus
+    tb_long_t value = *a;
+    tb_barrier();
+    return value;
+}
+static __tb_inline__ tb_void_t tb_thread_pool_atomic_store(tb_atomic_t* a, tb_long_t value)
+{
+    // the previous writes will be visible before storing it
+    tb_barrier();
+    *a = value;
+}
+static tb_bool_t tb_thread_pool_deque_push(tb_thread_pool_deque_t* deque, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(deque && deque->jobs && job);
+
+    // full?
+    tb_long_t bottom = deque->bottom;
+    tb_long_t top = tb_thread_pool_atomic_load(&deque->top);
+    tb_check_return_val(bottom - top < TB_THREAD_POOL_DEQUE_MAXN, tb_false);
+
+    // push it to the bottom
+    deque->jobs[bottom & (TB_THREAD_POOL_DEQUE_MAXN - 1)] = job;
+    tb_thread_pool_atomic_store(&deque->bottom, bottom + 1);
+    return tb_true;
+}
+static tb_thread_pool_job_t* tb_thread_pool_deque_pop(tb_thread_pool_deque_t* deque)
+{
+    // check
+    tb_assert(deque && deque->jobs);
+
+    // reserve the bottom job, we need the full barrier before loading the top
+    tb_long_t bottom = deque->bottom - 1;
+    tb_atomic_set(&deque->bottom, bottom);
+
+    // empty? restore it
+    tb_long_t top = tb_thread_pool_atomic_load(&deque->top);
+    if (top > bottom)
+    {
+        tb_thread_pool_atomic_store(&deque->bottom, bottom + 1);
+        return tb_null;
+    }
+
+    // the job
+    tb_thread_pool_job_t* job = deque->jobs[bottom & (TB_THREAD_POOL_DEQUE_MAXN - 1)];
+
+    // the last job? we need race with the stealing workers
+    if (top == bottom)
+    {
+        // has been stolen?
+        if (tb_atomic_fetch_and_pset(&deque->top, top, top + 1) != top) job = tb_null;
+        tb_thread_pool_atomic_store(&deque->bottom, bottom + 1);
+    }
+    return job;
+}
+static tb_thread_pool_job_t* tb_thread_pool_deque_steal(tb_thread_pool_deque_t* deque)
+{
+    // check
+    tb_assert(deque);
+
+    // no jobs buffer? this worker is starting now
+    tb_check_return_val(deque->jobs, tb_null);
+
+    // empty?
+    tb_long_t top = tb_thread_pool_atomic_load(&deque->top);
+    tb_long_t bottom = tb_thread_pool_atomic_load(&deque->bottom);
+    tb_check_return_val(top < bottom, tb_null);
+
+    // steal the top job, the job slot will not be reused before the top is updated
+    tb_thread_pool_job_t* job = deque->jobs[top & (TB_THREAD_POOL_DEQUE_MAXN - 1)];
+    return tb_atomic_fetch_and_pset(&deque->top, top, top + 1) == top? job : tb_null;
+}
+static __tb_inline__ tb_bool_t tb_thread_pool_deque_empty(tb_thread_pool_deque_t* deque)
+{
+    return tb_thread_pool_atomic_load(&deque->top) >= tb_thread_pool_atomic_load(&deque->bottom);
+}
+static tb_bool_t tb_thread_pool_queue_init(tb_thread_pool_queue_t* queue)
+{
+    // check
+    tb_assert_and_check_return_val(queue, tb_false);
+
+    // init cells
+    queue->cells = tb_nalloc0_type(TB_THREAD_POOL_QUEUE_MAXN, tb_thread_pool_queue_cell_t);
+    tb_assert_and_check_return_val(queue->cells, tb_false);
+
+    // init the sequence of all cells
+    tb_size_t i = 0;
+    for (i = 0; i < TB_THREAD_POOL_QUEUE_MAXN; i++) queue->cells[i].seq = (tb_long_t)i;
+
+    // init the head and tail
+    queue->head = 0;
+    queue->tail = 0;
+    return tb_true;
+}
+static tb_void_t tb_thread_pool_queue_exit(tb_thread_pool_queue_t* queue)
+{
+    // check
+    tb_assert_and_check_return(queue);
+
+    // exit cells
+    if (queue->cells) tb_free(queue->cells);
+    queue->cells = tb_null;
+}
+static __tb_inline__ tb_size_t tb_thread_pool_queue_size(tb_thread_pool_queue_t* queue)
+{
+    // the reserved but unpublished jobs are also counted
+    tb_long_t size = tb_thread_pool_atomic_load(&queue->tail) - tb_thread_pool_atomic_load(&queue->head);
+    return size > 0? (tb_size_t)size : 0;
+}
+static tb_size_t tb_thread_pool_queue_push_list(tb_thread_pool_queue_t* queue, tb_thread_pool_job_t** jobs, tb_size_t size)
+{
+    // check
+    tb_assert(queue && queue->cells && jobs);
+
+    // reserve the free cells from the tail
+    tb_size_t                       n = 0;
+    tb_long_t                       pos = tb_thread_pool_atomic_load(&queue->tail);
+    tb_thread_pool_queue_cell_t*    cells = queue->cells;
+    while (size)
+    {
+        // count the continuous free cells
+        tb_long_t seq = 0;
+        for (n = 0; n < size; n++)
+        {
+            seq = tb_thread_pool_atomic_load(&cells[(pos + n) & (TB_THREAD_POOL_QUEUE_MAXN - 1)].seq);
+            tb_check_break(seq == pos + (tb_long_t)n);
+        }
+
+        // no free cells?
+        if (!n) 
+        {
+            // full?
+            tb_check_return_val(seq - pos >= 0, 0);
+
+            // the tail has been moved, reload it
+            pos = tb_thread_pool_atomic_load(&queue->tail);
+            continue;
+        }
+
+        // reserve them
+        tb_long_t tail = tb_atomic_fetch_and_pset(&queue->tail, pos, pos + n);
+        if (tail == pos) break;
+        pos = tail;
+    }
+
+    // publish jobs
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_thread_pool_queue_cell_t* cell = &cells[(pos + i) & (TB_THREAD_POOL_QUEUE_MAXN - 1)];
+        cell->job = jobs[i];
+        tb_atomic_set(&cell->seq, pos + i + 1);
+    }
+    return n;
+}
+static tb_size_t tb_thread_pool_queue_pop_list(tb_thread_pool_queue_t* queue, tb_thread_pool_job_t** jobs, tb_size_t maxn)
+{
+    // check
+    tb_assert(queue && queue->cells && jobs);
+
+    // reserve the published cells from the head
+    tb_size_t                       n = 0;
+    tb_long_t                       pos = tb_thread_pool_atomic_load(&queue->head);
+    tb_thread_pool_queue_cell_t*    cells = queue->cells;
+    while (maxn)
+    {
+        // count the continuous published cells
+        tb_long_t seq = 0;
+        for (n = 0; n < maxn; n++)
+        {
+            seq = tb_thread_pool_atomic_load(&cells[(pos + n) & (TB_THREAD_POOL_QUEUE_MAXN - 1)].seq);
+            tb_check_break(seq == pos + (tb_long_t)n + 1);
+        }
+
+        // no published cells?
+        if (!n) 
+        {
+            // empty?
+            tb_check_return_val(seq - (pos + 1) >= 0, 0);
+
+            // the head has been moved, reload it
+            pos = tb_thread_pool_atomic_load(&queue->head);
+            continue;
+        }
+
+        // reserve them
+        tb_long_t head = tb_atomic_fetch_and_pset(&queue->head, pos, pos + n);
+        if (head == pos) break;
+        pos = head;
+    }
+
+    // fetch jobs and release cells for the next round
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_thread_pool_queue_cell_t* cell = &cells[(pos + i) & (TB_THREAD_POOL_QUEUE_MAXN - 1)];
+        jobs[i] = cell->job;
+        tb_atomic_set(&cell->seq, pos + i + TB_THREAD_POOL_QUEUE_MAXN);
+    }
+    return n;
+}
+static tb_thread_pool_worker_t* tb_thread_pool_stealing_self(tb_thread_pool_impl_t* impl)
+{
+    // get the current worker of this pool
+    tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)tb_thread_local_get(&g_thread_pool_worker_self);
+    return (worker && worker->pool == (tb_thread_pool_ref_t)impl)? worker : tb_null;
+}
+static tb_void_t tb_thread_pool_stealing_wake(tb_thread_pool_impl_t* impl, tb_size_t count)
+{
+    // check
+    tb_assert(impl && count);
+
+#ifdef TB_CONFIG_POSIX_HAVE_FUTEX
+    // update the parking sequence and wake up the parked workers
+    __sync_fetch_and_add(&impl->parking, 1);
+    syscall(__NR_futex, &impl->parking, FUTEX_WAKE_PRIVATE, (tb_int_t)tb_min(count, TB_MAXS32), tb_null, tb_null, 0);
+#else
+    // post the semaphore
+    if (impl->semaphore) tb_semaphore_post(impl->semaphore, count);
+#endif
+}
+static tb_bool_t tb_thread_pool_stealing_has_jobs(tb_thread_pool_impl_t* impl)
+{
+    // has queued jobs?
+    if (    tb_thread_pool_queue_size(&impl->queue_urgent) 
+        ||  tb_thread_pool_queue_size(&impl->queue_waiting) 
+        ||  tb_thread_pool_atomic_load(&impl->jobs_overflow))
+        return tb_true;
+
+    // has the stealable jobs?
+    tb_size_t i = 0;
+    tb_size_t n = impl->worker_size;
+    for (i = 0; i < n; i++)
+    {
+        if (!tb_thread_pool_deque_empty(&impl->worker_list[i].deque))
+            return tb_true;
+    }
+    return tb_false;
+}
+static tb_void_t tb_thread_pool_stealing_park(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_assert(impl && worker);
+
+#ifdef TB_CONFIG_POSIX_HAVE_FUTEX
+    // get the parking sequence before checking jobs, the waking worker will change it
+    tb_int32_t parking = impl->parking;
+    tb_barrier();
+#endif
+
+    /* mark this worker as idle, it will be visible before checking jobs (full barrier),
+     * so the posting thread will see it or we will see the posted jobs
+     */
+    tb_atomic_fetch_and_add(&impl->worker_idle, 1);
+
+    // no jobs? park it
+    if (!tb_atomic_get(&worker->bstoped) && !tb_thread_pool_stealing_has_jobs(impl))
+    {
+        // trace
+        tb_trace_d("worker[%lu]: park: ..", worker->id);
+
+#ifdef TB_CONFIG_POSIX_HAVE_FUTEX
+        // wait it, it will return directly if the parking sequence has been changed
+        syscall(__NR_futex, &impl->parking, FUTEX_WAIT_PRIVATE, parking, tb_null, tb_null, 0);
+#else
+        // wait it
+        tb_semaphore_wait(impl->semaphore, -1);
+#endif
+
+        // trace
+        tb_trace_d("worker[%lu]: park: ok", worker->id);
+    }
+
+    // mark this worker as busy
+    tb_atomic_fetch_and_sub(&impl->worker_idle, 1);
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_job_init(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_task_t const* task, tb_long_t refn)
+{
+    // reuse the free job in the worker cache
+    tb_thread_pool_job_t* job = tb_null;
+    if (worker && worker->jobs_free)
+    {
+        job = worker->jobs_free;
+        worker->jobs_free = job->free_next;
+        worker->jobs_free_size--;
+        tb_memset(job, 0, sizeof(tb_thread_pool_job_t));
+    }
+    // make a new job
+    else job = tb_malloc0_type(tb_thread_pool_job_t);
+    tb_assert_and_check_return_val(job, tb_null);
+
+    // init job
+    job->refn       = refn;
+    job->state      = TB_STATE_WAITING;
+    job->task       = *task;
+    job->killing    = tb_thread_pool_atomic_load(&impl->jobs_killing);
+    return job;
+}
+static tb_void_t tb_thread_pool_stealing_job_exit(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(impl && job);
+
+    // refn--
+    tb_check_return(!tb_atomic_sub_and_fetch(&job->refn, 1));
+
+    // cache it to the worker or free it
+    if (worker && worker->jobs_free_size < TB_THREAD_POOL_JOBS_FREE_MAXN)
+    {
+        job->free_next = worker->jobs_free;
+        worker->jobs_free = job;
+        worker->jobs_free_size++;
+    }
+    else tb_free(job);
+
+    // jobs--
+    tb_atomic_fetch_and_sub(&impl->jobs_size, 1);
+}
+static tb_size_t tb_thread_pool_stealing_push_waiting(tb_thread_pool_impl_t* impl, tb_thread_pool_job_t** jobs, tb_size_t size)
+{
+    // check
+    tb_assert(impl && jobs);
+
+    // push them to the waiting queue if there are no overflow jobs, we need keep the posting order
+    tb_size_t real = 0;
+    if (!tb_thread_pool_atomic_load(&impl->jobs_overflow))
+        real = tb_thread_pool_queue_push_list(&impl->queue_waiting, jobs, size);
+
+    // the waiting queue is full? push the left jobs to the overflow jobs
+    if (real < size)
+    {
+        // enter
+        tb_spinlock_enter(&impl->lock);
+
+        // push them
+        for (; real < size && tb_list_entry_size(&impl->jobs_waiting) + TB_THREAD_POOL_QUEUE_MAXN < TB_THREAD_POOL_JOBS_WAITING_MAXN; real++)
+            tb_list_entry_insert_tail(&impl->jobs_waiting, &jobs[real]->entry);
+        tb_atomic_set(&impl->jobs_overflow, tb_list_entry_size(&impl->jobs_waiting));
+
+        // leave
+        tb_spinlock_leave(&impl->lock);
+    }
+    return real;
+}
+static tb_size_t tb_thread_pool_stealing_pop_waiting(tb_thread_pool_impl_t* impl, tb_thread_pool_job_t** jobs, tb_size_t maxn)
+{
+    // check
+    tb_assert(impl && jobs);
+
+    // pop them from the waiting queue
+    tb_size_t size = tb_thread_pool_queue_pop_list(&impl->queue_waiting, jobs, maxn);
+
+    // the waiting queue is empty? pop them from the overflow jobs
+    if (!size && tb_thread_pool_atomic_load(&impl->jobs_overflow))
+    {
+        // enter
+        tb_spinlock_enter(&impl->lock);
+
+        // pop them
+        while (size < maxn && tb_list_entry_size(&impl->jobs_waiting))
+        {
+            jobs[size++] = (tb_thread_pool_job_t*)tb_list_entry(&impl->jobs_waiting, tb_list_entry_head(&impl->jobs_waiting));
+            tb_list_entry_remove_head(&impl->jobs_waiting);
+        }
+        tb_atomic_set(&impl->jobs_overflow, tb_list_entry_size(&impl->jobs_waiting));
+
+        // leave
+        tb_spinlock_leave(&impl->lock);
+    }
+    return size;
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_pull(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_assert(impl && worker);
+
+    // pull the urgent job first
+    tb_thread_pool_job_t* job = tb_null;
+    if (tb_thread_pool_queue_size(&impl->queue_urgent) && tb_thread_pool_queue_pop_list(&impl->queue_urgent, &job, 1))
+        return job;
+
+    // pop the local job
+    if ((job = tb_thread_pool_deque_pop(&worker->deque))) 
+        return job;
+
+    // grab some waiting jobs to the local deque, we only grab our share of them
+    tb_size_t size = tb_thread_pool_queue_size(&impl->queue_waiting) + tb_thread_pool_atomic_load(&impl->jobs_overflow);
+    if (size)
+    {
+        tb_thread_pool_job_t*   jobs[TB_THREAD_POOL_JOBS_GRAB_MAXN];
+        tb_size_t               grab = tb_min(size / (impl->worker_size + 1) + 1, TB_THREAD_POOL_JOBS_GRAB_MAXN);
+        if ((grab = tb_thread_pool_stealing_pop_waiting(impl, jobs, grab)))
+        {
+            // push the other jobs to the local deque, the local deque is empty now
+            tb_size_t i = 1;
+            for (i = 1; i < grab; i++) tb_thread_pool_deque_push(&worker->deque, jobs[i]);
+
+            // trace
+            tb_trace_d("worker[%lu]: grab: %lu jobs from waiting", worker->id, grab);
+            return jobs[0];
+        }
+    }
+
+    // steal job from the other workers, we start at a random victim
+    tb_size_t n = impl->worker_size;
+    if (n > 1)
+    {
+        // update the random seed (xorshift)
+        tb_size_t seed = worker->steal_seed;
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        worker->steal_seed = seed;
+
+        // steal it
+        tb_size_t i = 0;
+        tb_size_t k = seed % n;
+        for (i = 0; i < n; i++, k = (k + 1) % n)
+        {
+            if (k != worker->id && (job = tb_thread_pool_deque_steal(&impl->worker_list[k].deque)))
+            {
+                // trace
+                tb_trace_d("worker[%lu]: steal: task[%p:%s] from worker[%lu]", worker->id, job->task.done, job->task.name, k);
+                return job;
+            }
+        }
+    }
+    return tb_null;
+}
+static tb_void_t tb_thread_pool_stealing_done(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(impl && job && job->task.done);
+
+    // the pool has been stoped or all jobs have been killed? kill it
+    if (!worker || tb_atomic_get(&worker->bstoped) || job->killing != tb_thread_pool_atomic_load(&impl->jobs_killing))
+        tb_atomic_pset(&job->state, TB_STATE_WAITING, TB_STATE_KILLING);
+
+    // the job state
+    tb_size_t state = tb_atomic_fetch_and_pset(&job->state, TB_STATE_WAITING, TB_STATE_WORKING);
+
+    // the job is waiting? work it
+    if (state == TB_STATE_WAITING)
+    {
+        // trace
+        tb_trace_d("worker[%lu]: done: task[%p:%s]: ..", worker? worker->id : -1, job->task.done, job->task.name);
+
+        // done the job
+        job->task.done((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+        // update the job state
+        tb_atomic_set(&job->state, TB_STATE_FINISHED);
+    }
+    // the job is killing? kill it
+    else if (state == TB_STATE_KILLING)
+    {
+        // update the job state
+        tb_atomic_set(&job->state, TB_STATE_KILLED);
+    }
+
+    // exit the job
+    if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+    // release it
+    tb_thread_pool_stealing_job_exit(impl, worker, job);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * worker implementation
  */
@@ -381,11 +994,92 @@ static tb_void_t tb_thread_pool_worker_post(tb_thread_pool_impl_t* impl, tb_size
     if (value >= 0 && (tb_size_t)value < post) 
         tb_semaphore_post(impl->semaphore, post - value);
 }
+static tb_void_t tb_thread_pool_worker_exit_priv(tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_assert_and_check_return(worker);
+
+    // exit all private data
+    tb_size_t i = 0;
+    tb_size_t n = tb_arrayn(worker->priv);
+    for (i = 0; i < n; i++)
+    {
+        // the private data
+        tb_thread_pool_worker_priv_t* priv = &worker->priv[n - i - 1];
+
+        // exit it
+        if (priv->exit) priv->exit((tb_thread_pool_worker_ref_t)worker, priv->priv);
+
+        // clear it
+        priv->exit = tb_null;
+        priv->priv = tb_null;
+    }
+}
+static tb_int_t tb_thread_pool_worker_loop_stealing(tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_assert_and_check_return_val(worker, -1);
+
+    // the pool
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+    tb_assert_and_check_return_val(impl, -1);
+
+    // trace
+    tb_trace_d("worker[%lu]: init", worker->id);
+
+    // bind this worker to the current thread
+    tb_thread_local_set(&g_thread_pool_worker_self, worker);
+
+    // this worker has been started
+    tb_atomic_fetch_and_sub(&impl->worker_starting, 1);
+
+    // loop
+    tb_size_t spin = 0;
+    while (1)
+    {
+        // pull and done one job
+        tb_thread_pool_job_t* job = tb_thread_pool_stealing_pull(impl, worker);
+        if (job)
+        {
+            tb_thread_pool_stealing_done(impl, worker, job);
+            spin = 0;
+            continue;
+        }
+
+        // no jobs and stoped? exit it
+        tb_check_break(!tb_atomic_get(&worker->bstoped));
+
+        // spin some times before parking it, the jobs may be coming soon
+        if (spin++ < TB_THREAD_POOL_WORKER_SPIN_MAXN)
+        {
+            tb_sched_yield();
+            continue;
+        }
+
+        // park it
+        tb_thread_pool_stealing_park(impl, worker);
+        spin = 0;
+    }
+
+    // trace
+    tb_trace_d("worker[%lu]: exit", worker->id);
+
+    // exit all private data
+    tb_thread_pool_worker_exit_priv(worker);
+
+    // unbind this worker
+    tb_thread_local_set(&g_thread_pool_worker_self, tb_null);
+    return 0;
+}
 static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
 {
     // the worker
     tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)priv;
 
+    // the stealing mode?
+    if (worker && worker->pool && ((tb_thread_pool_impl_t*)worker->pool)->stealing) 
+        return tb_thread_pool_worker_loop_stealing(worker);
+
     // trace
     tb_trace_d("worker[%lu]: init", worker? worker->id : -1);
 
@@ -589,20 +1283,7 @@ static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
         tb_atomic_set(&worker->bstoped, 1);
 
         // exit all private data
-        tb_size_t i = 0;
-        tb_size_t n = tb_arrayn(worker->priv);
-        for (i = 0; i < n; i++)
-        {
-            // the private data
-            tb_thread_pool_worker_priv_t* priv = &worker->priv[n - i - 1];
-
-            // exit it
-            if (priv->exit) priv->exit((tb_thread_pool_worker_ref_t)worker, priv->priv);
-
-            // clear it
-            priv->exit = tb_null;
-            priv->priv = tb_null;
-        }
+        tb_thread_pool_worker_exit_priv(worker);
 
         // exit stats
         if (worker->stats) tb_hash_map_exit(worker->stats);
@@ -744,14 +1425,184 @@ static tb_thread_pool_job_t* tb_thread_pool_jobs_post_task(tb_thread_pool_impl_t
     return job;
 }
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
- */
-tb_thread_pool_ref_t tb_thread_pool()
+static tb_void_t tb_thread_pool_jobs_spawn_worker(tb_thread_pool_impl_t* impl)
 {
-    return (tb_thread_pool_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_THREAD_POOL, tb_thread_pool_instance_init, tb_thread_pool_instance_exit, tb_thread_pool_instance_kill, tb_null);
+    // check
+    tb_assert_and_check_return(impl);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // spawn a new worker if all workers are busy and no worker is starting
+    tb_size_t i = impl->worker_size;
+    if (!impl->bstoped && i < impl->worker_maxn && !tb_atomic_get(&impl->worker_starting))
+    {
+        // the worker 
+        tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+
+        // clear worker
+        tb_memset(worker, 0, sizeof(tb_thread_pool_worker_t));
+
+        // init worker
+        worker->id          = i;
+        worker->pool        = (tb_thread_pool_ref_t)impl;
+        worker->steal_seed  = (tb_size_t)(i + 1) * 0x9e3779b9;
+        worker->deque.jobs  = tb_nalloc0_type(TB_THREAD_POOL_DEQUE_MAXN, tb_thread_pool_job_t*);
+        if (worker->deque.jobs)
+        {
+            // start it
+            tb_atomic_fetch_and_add(&impl->worker_starting, 1);
+            worker->loop = tb_thread_init(__tb_lstring__("thread_pool"), tb_thread_pool_worker_loop, worker, impl->stack);
+            if (worker->loop) 
+            {
+                // publish this worker to the other workers after initializing it
+                tb_barrier();
+                impl->worker_size = i + 1;
+
+                // trace
+                tb_trace_d("worker[%lu]: spawn", i);
+            }
+            else
+            {
+                // failed
+                tb_atomic_fetch_and_sub(&impl->worker_starting, 1);
+                tb_free(worker->deque.jobs);
+                worker->deque.jobs = tb_null;
+            }
+        }
+    }
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
 }
-tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
+static tb_size_t tb_thread_pool_jobs_post_stealing(tb_thread_pool_impl_t* impl, tb_thread_pool_task_t const* list, tb_size_t size, tb_thread_pool_job_t** pjob)
+{
+    // check
+    tb_assert_and_check_return_val(impl && list && (!pjob || size == 1), 0);
+
+    // stoped?
+    tb_check_return_val(!impl->bstoped, 0);
+
+    // the current worker of this pool, we can post jobs to the local deque directly
+    tb_thread_pool_worker_t* worker = tb_thread_pool_stealing_self(impl);
+
+    // the jobs count will be increased before posting them, the workers may finish them soon
+    tb_atomic_fetch_and_add(&impl->jobs_size, size);
+
+    // post jobs
+    tb_size_t               post = 0;
+    tb_size_t               real = 0;
+    tb_size_t               batch_size = 0;
+    tb_thread_pool_job_t*   batch[TB_THREAD_POOL_JOBS_GRAB_MAXN];
+    tb_bool_t               failed = tb_false;
+    while (post + batch_size < size && !failed)
+    {
+        // the task
+        tb_thread_pool_task_t const* task = &list[post + batch_size];
+        tb_assert_and_check_break(task->done);
+
+        // flush the batch jobs to the waiting queue if be full or the urgent job is coming, we keep the posting order
+        if (batch_size && (batch_size == tb_arrayn(batch) || task->urgent))
+        {
+            real = tb_thread_pool_stealing_push_waiting(impl, batch, batch_size);
+            post += real;
+            if (real < batch_size) failed = tb_true;
+            for (; real < batch_size; real++) tb_free(batch[real]);
+            batch_size = 0;
+            continue;
+        }
+
+        // make job
+        tb_thread_pool_job_t* job = tb_thread_pool_stealing_job_init(impl, worker, task, pjob? 2 : 1);
+        tb_assert_and_check_break(job);
+
+        // trace
+        tb_trace_d("task[%p:%s]: post: %s", task->done, task->name, task->urgent? "urgent" : "waiting");
+
+        // save the job
+        if (pjob) *pjob = job;
+
+        // post the urgent job, we post it to the waiting jobs if the urgent queue is full
+        if (task->urgent)
+        {
+            if (    tb_thread_pool_queue_push_list(&impl->queue_urgent, &job, 1)
+                ||  tb_thread_pool_stealing_push_waiting(impl, &job, 1)) post++;
+            else 
+            {
+                tb_free(job);
+                failed = tb_true;
+            }
+        }
+        // post it to the local deque
+        else if (worker && tb_thread_pool_deque_push(&worker->deque, job)) post++;
+        // post it to the batch jobs
+        else batch[batch_size++] = job;
+    }
+
+    // flush the left batch jobs
+    if (batch_size) 
+    {
+        real = tb_thread_pool_stealing_push_waiting(impl, batch, batch_size);
+        post += real;
+        for (; real < batch_size; real++) tb_free(batch[real]);
+    }
+
+    // failed? 
+    if (post < size)
+    {
+        // trace
+        tb_trace_d("post: %lu jobs failed, the queue is full?", size - post);
+
+        // update the jobs count
+        tb_atomic_fetch_and_sub(&impl->jobs_size, size - post);
+
+        // clear the saved job
+        if (pjob) *pjob = tb_null;
+    }
+    tb_check_return_val(post, 0);
+
+    // wake up the idle workers, tb_atomic_get() is a full barrier and it will see the idle worker after posting jobs
+    tb_long_t idle = tb_atomic_get(&impl->worker_idle);
+    if (idle > 0) tb_thread_pool_stealing_wake(impl, tb_min((tb_size_t)idle, post));
+    // all workers are busy? spawn a new worker
+    else if (impl->worker_size < impl->worker_maxn) tb_thread_pool_jobs_spawn_worker(impl);
+
+    // ok
+    return post;
+}
+static tb_void_t tb_thread_pool_jobs_clear_stealing(tb_thread_pool_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // kill and exit the left jobs in the queues, they were posted after all workers have been exited
+    tb_thread_pool_job_t* job = tb_null;
+    while (tb_thread_pool_queue_pop_list(&impl->queue_urgent, &job, 1)) tb_thread_pool_stealing_done(impl, tb_null, job);
+    while (tb_thread_pool_stealing_pop_waiting(impl, &job, 1)) tb_thread_pool_stealing_done(impl, tb_null, job);
+
+    // exit the local deques and free jobs of all workers
+    tb_size_t i = 0;
+    tb_size_t n = impl->worker_size;
+    for (i = 0; i < n; i++)
+    {
+        // the worker
+        tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+        if (worker->deque.jobs)
+        {
+            while ((job = tb_thread_pool_deque_steal(&worker->deque))) tb_thread_pool_stealing_done(impl, tb_null, job);
+            tb_free(worker->deque.jobs);
+            worker->deque.jobs = tb_null;
+        }
+        while ((job = worker->jobs_free))
+        {
+            worker->jobs_free = job->free_next;
+            tb_free(job);
+        }
+        worker->jobs_free_size = 0;
+    }
+}
+
+static tb_thread_pool_ref_t tb_thread_pool_init_impl(tb_size_t worker_maxn, tb_size_t stack, tb_bool_t stealing)
 {
     // done
     tb_bool_t               ok = tb_false;
@@ -774,11 +1625,22 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
 
         // init workers
         impl->worker_size   = 0;
-        impl->worker_maxn   = worker_maxn;
+        impl->worker_maxn   = tb_min(worker_maxn, TB_THREAD_POOL_WORKER_MAXN);
+        impl->stealing      = stealing;
 
         // init jobs pool
-        impl->jobs_pool     = tb_fixed_pool_init(tb_null, TB_THREAD_POOL_JOBS_POOL_GROW, sizeof(tb_thread_pool_job_t), tb_null, tb_null, tb_null);
-        tb_assert_and_check_break(impl->jobs_pool);
+        if (!stealing)
+        {
+            impl->jobs_pool = tb_fixed_pool_init(tb_null, TB_THREAD_POOL_JOBS_POOL_GROW, sizeof(tb_thread_pool_job_t), tb_null, tb_null, tb_null);
+            tb_assert_and_check_break(impl->jobs_pool);
+        }
+        // init the jobs queues and the current worker for the stealing mode
+        else
+        {
+            if (!tb_thread_pool_queue_init(&impl->queue_urgent)) break;
+            if (!tb_thread_pool_queue_init(&impl->queue_waiting)) break;
+            if (!tb_thread_local_init(&g_thread_pool_worker_self, tb_null)) break;
+        }
 
         // init jobs urgent
         tb_list_entry_init(&impl->jobs_urgent, tb_thread_pool_job_t, entry, tb_null);
@@ -814,6 +1676,22 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
     // ok?
     return (tb_thread_pool_ref_t)impl;
 }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_thread_pool_ref_t tb_thread_pool()
+{
+    return (tb_thread_pool_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_THREAD_POOL, tb_thread_pool_instance_init, tb_thread_pool_instance_exit, tb_thread_pool_instance_kill, tb_null);
+}
+tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
+{
+    return tb_thread_pool_init_impl(worker_maxn, stack, tb_false);
+}
+tb_thread_pool_ref_t tb_thread_pool_init_stealing(tb_size_t worker_maxn, tb_size_t stack)
+{
+    return tb_thread_pool_init_impl(worker_maxn, stack, tb_true);
+}
 tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
 {
     // check
@@ -860,8 +1738,15 @@ tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
             worker->loop = tb_null;
         }
     }
+
+    // clear the left jobs, deques and free jobs for the stealing mode
+    if (impl->stealing) tb_thread_pool_jobs_clear_stealing(impl);
     impl->worker_size = 0;
 
+    // exit the jobs queues
+    tb_thread_pool_queue_exit(&impl->queue_urgent);
+    tb_thread_pool_queue_exit(&impl->queue_waiting);
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -923,6 +1808,7 @@ tb_void_t tb_thread_pool_kill(tb_thread_pool_ref_t pool)
 
         // kill all jobs
         if (impl->jobs_pool) tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
+        else if (impl->stealing) tb_atomic_fetch_and_add(&impl->jobs_killing, 1);
 
         // post it
         post = impl->worker_size;
@@ -932,7 +1818,11 @@ tb_void_t tb_thread_pool_kill(tb_thread_pool_ref_t pool)
     tb_spinlock_leave(&impl->lock);
 
     // post the workers
-    if (post) tb_thread_pool_worker_post(impl, post);
+    if (post) 
+    {
+        if (impl->stealing) tb_thread_pool_stealing_wake(impl, post);
+        else tb_thread_pool_worker_post(impl, post);
+    }
 }
 tb_size_t tb_thread_pool_worker_size(tb_thread_pool_ref_t pool)
 {
@@ -977,6 +1867,9 @@ tb_size_t tb_thread_pool_task_size(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl, 0);
 
+    // the stealing mode? get the jobs count directly
+    if (impl->stealing) return (tb_size_t)tb_atomic_get(&impl->jobs_size);
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -995,6 +1888,21 @@ tb_bool_t tb_thread_pool_task_post(tb_thread_pool_ref_t pool, tb_char_t const* n
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_false);
 
+    // the stealing mode? post it without lock
+    if (impl->stealing)
+    {
+        // init task
+        tb_thread_pool_task_t task = {0};
+        task.name       = name;
+        task.done       = done;
+        task.exit       = exit;
+        task.priv       = priv;
+        task.urgent     = urgent;
+
+        // post task
+        return tb_thread_pool_jobs_post_stealing(impl, &task, 1, tb_null) == 1;
+    }
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1040,6 +1948,9 @@ tb_size_t tb_thread_pool_task_post_list(tb_thread_pool_ref_t pool, tb_thread_poo
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && list, 0);
 
+    // the stealing mode? post them without lock
+    if (impl->stealing) return tb_thread_pool_jobs_post_stealing(impl, list, size, tb_null);
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1073,6 +1984,23 @@ tb_thread_pool_task_ref_t tb_thread_pool_task_init(tb_thread_pool_ref_t pool, tb
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_null);
 
+    // the stealing mode? post it without lock
+    if (impl->stealing)
+    {
+        // init task
+        tb_thread_pool_task_t task = {0};
+        task.name       = name;
+        task.done       = done;
+        task.exit       = exit;
+        task.priv       = priv;
+        task.urgent     = urgent;
+
+        // post task and hold it
+        tb_thread_pool_job_t* job = tb_null;
+        tb_thread_pool_jobs_post_stealing(impl, &task, 1, &job);
+        return (tb_thread_pool_task_ref_t)job;
+    }
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1136,6 +2064,15 @@ tb_void_t tb_thread_pool_task_kill_all(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return(impl);
 
+    /* the stealing mode? update the killing generation, 
+     * all posted jobs will be killed when the workers pull them
+     */
+    if (impl->stealing)
+    {
+        tb_atomic_fetch_and_add(&impl->jobs_killing, 1);
+        return ;
+    }
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -1180,6 +2117,18 @@ tb_long_t tb_thread_pool_task_wait_all(tb_thread_pool_ref_t pool, tb_long_t time
     tb_hong_t time = tb_cache_time_spak();
     while ((timeout < 0 || tb_cache_time_spak() < time + timeout))
     {
+        // the stealing mode? get the jobs count directly
+        if (impl->stealing)
+        {
+            // ok?
+            size = (tb_size_t)tb_atomic_get(&impl->jobs_size);
+            tb_check_break(size);
+
+            // wait some time
+            tb_msleep(200);
+            continue;
+        }
+
         // enter
         tb_spinlock_enter(&impl->lock);
 
@@ -1223,6 +2172,13 @@ tb_void_t tb_thread_pool_task_exit(tb_thread_pool_ref_t pool, tb_thread_pool_tas
     // kill it first
     tb_thread_pool_task_kill(pool, task);
 
+    // the stealing mode? release it without lock
+    if (impl->stealing)
+    {
+        tb_thread_pool_stealing_job_exit(impl, tb_thread_pool_stealing_self(impl), job);
+        return ;
+    }
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -1266,6 +2222,15 @@ tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
         // trace
         tb_trace_i("");
 
+        // dump the jobs count for the stealing mode
+        if (impl->stealing)
+        {
+            // trace
+            tb_trace_i("jobs: size: %ld, urgent: %lu, waiting: %lu, idle workers: %ld", (tb_long_t)tb_atomic_get(&impl->jobs_size)
+                    , tb_thread_pool_queue_size(&impl->queue_urgent), tb_thread_pool_queue_size(&impl->queue_waiting)
+                    , (tb_long_t)tb_atomic_get(&impl->worker_idle));
+        }
+
         // dump all jobs
         if (impl->jobs_pool) 
         {
@@ -104,6 +104,22 @@ tb_thread_pool_ref_t        tb_thread_pool(tb_noarg_t);
  */
 tb_thread_pool_ref_t        tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack);
 
+/*! init thread pool with the work-stealing mode
+ *
+ * each worker owns a lock-free local deque and steals jobs from the other workers if be idle,
+ * the posted jobs will be injected to the workers by the lock-free global queue,
+ * and the idle workers will be parked by futex (or semaphore if futex is not supported).
+ *
+ * it's more efficient than the default mode for many short tasks and workers,
+ * but the jobs will be run in the posting order approximately and the urgent jobs will be run first.
+ *
+ * @param worker_maxn       the thread worker max count, using the default count
+ * @param stack             the thread stack, using the default stack size if be zero 
+ *
+ * @return                  the thread pool 
+ */
+tb_thread_pool_ref_t        tb_thread_pool_init_stealing(tb_size_t worker_maxn, tb_size_t stack);
+
 /*! exit thread pool
  *
  * @param pool              the thread pool 
@@ -32,9 +32,47 @@
 #include "platform.h"
 #include "../memory/memory.h"
 #include "../container/container.h"
-#include "../algorithm/algorithm.h"
 #include "../utils/utils.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the hierarchical timer wheel
+ *
+ * root:    256 slots, 1ms per slot
+ * level1:  64 slots, 256ms per slot
+ * level2:  64 slots, 16s per slot
+ * level3:  64 slots, 17.5m per slot
+ * level4:  64 slots, 18.6h per slot
+ *
+ * the tasks in the upper level will be cascaded to the lower levels when the wheel enters their slot,
+ * and the tasks after 2^32ms (~49 days) will be clamped to the last slot and be cascaded again.
+ */
+#define TB_TIMER_WHEEL_ROOT_BITS            (8)
+#define TB_TIMER_WHEEL_ROOT_SIZE            (1 << TB_TIMER_WHEEL_ROOT_BITS)
+#define TB_TIMER_WHEEL_LEVEL_BITS           (6)
+#define TB_TIMER_WHEEL_LEVEL_SIZE           (1 << TB_TIMER_WHEEL_LEVEL_BITS)
+#define TB_TIMER_WHEEL_LEVEL_MAXN           (4)
+
+// the slots count
+#define TB_TIMER_WHEEL_SLOT_MAXN            (TB_TIMER_WHEEL_ROOT_SIZE + TB_TIMER_WHEEL_LEVEL_SIZE * TB_TIMER_WHEEL_LEVEL_MAXN)
+
+// the task is not in the wheel
+#define TB_TIMER_WHEEL_SLOT_NONE            (0xffff)
+
+// the task is in the expired list
+#define TB_TIMER_WHEEL_SLOT_EXPIRED         (TB_TIMER_WHEEL_SLOT_MAXN)
+
+// the time span of the whole wheel
+#define TB_TIMER_WHEEL_SPAN                 ((tb_hong_t)1 << (TB_TIMER_WHEEL_ROOT_BITS + TB_TIMER_WHEEL_LEVEL_BITS * TB_TIMER_WHEEL_LEVEL_MAXN))
+
+// the time shift of the given level
+#define tb_timer_wheel_shift(level)         (TB_TIMER_WHEEL_ROOT_BITS + TB_TIMER_WHEEL_LEVEL_BITS * ((level) - 1))
+
+// the first slot of the given level
+#define tb_timer_wheel_base(level)          (TB_TIMER_WHEEL_ROOT_SIZE + TB_TIMER_WHEEL_LEVEL_SIZE * ((level) - 1))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -42,6 +80,9 @@
 // the timer task type
 typedef struct __tb_timer_task_t
 {
+    // the list entry of the wheel slot or the expired list
+    tb_list_entry_t             entry;
+
     // the func
     tb_timer_task_func_t        func;
 
@@ -63,6 +104,9 @@ typedef struct __tb_timer_task_t
     // the refn, <= 2
     tb_uint32_t                 refn    : 2;
 
+    // the wheel slot
+    tb_uint16_t                 slot;
+
 }tb_timer_task_t;
 
 /// the timer type
@@ -86,12 +130,21 @@ typedef struct __tb_timer_t
     // the pool
     tb_fixed_pool_ref_t         pool;
 
-    // the heap
-    tb_heap_ref_t               heap;
-
     // the event
     tb_event_ref_t              event;
 
+    // the current wheel time, all slots before it have been expired
+    tb_hong_t                   jiffies;
+
+    // the expired tasks
+    tb_list_entry_t             expired;
+
+    // the non-empty slots bitmap, root: [0, 3], level1-4: [4, 7]
+    tb_uint64_t                 bitmap[TB_TIMER_WHEEL_SLOT_MAXN >> 6];
+
+    // the wheel slots
+    tb_list_entry_t             slots[TB_TIMER_WHEEL_SLOT_MAXN];
+
 }tb_timer_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -110,20 +163,293 @@ static __tb_inline__ tb_hong_t tb_timer_now(tb_timer_t* timer)
     // using cached time
     return tb_cache_time_mclock();
 }
-static tb_long_t tb_timer_comp_by_when(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+static __tb_inline__ tb_void_t tb_timer_list_init(tb_list_entry_ref_t list)
+{
+    list->next = list;
+    list->prev = list;
+}
+static __tb_inline__ tb_bool_t tb_timer_list_empty(tb_list_entry_ref_t list)
+{
+    return list->next == list;
+}
+static __tb_inline__ tb_void_t tb_timer_list_insert_tail(tb_list_entry_ref_t list, tb_list_entry_ref_t entry)
+{
+    entry->prev         = list->prev;
+    entry->next         = list;
+    list->prev->next    = entry;
+    list->prev          = entry;
+}
+static __tb_inline__ tb_void_t tb_timer_list_remove(tb_list_entry_ref_t entry)
+{
+    entry->prev->next   = entry->next;
+    entry->next->prev   = entry->prev;
+    entry->next         = tb_null;
+    entry->prev         = tb_null;
+}
+static __tb_inline__ tb_void_t tb_timer_list_move(tb_list_entry_ref_t list, tb_list_entry_ref_t moved_list)
+{
+    // empty?
+    if (tb_timer_list_empty(moved_list)) 
+    {
+        tb_timer_list_init(list);
+        return ;
+    }
+
+    // move all entries to the new list head
+    list->next          = moved_list->next;
+    list->prev          = moved_list->prev;
+    list->next->prev    = list;
+    list->prev->next    = list;
+
+    // clear the moved list
+    tb_timer_list_init(moved_list);
+}
+static tb_void_t tb_timer_wheel_insert(tb_timer_t* timer, tb_timer_task_t* timer_task)
 {
     // check
-    tb_timer_task_t const* ltask = (tb_timer_task_t const*)ldata;
-    tb_timer_task_t const* rtask = (tb_timer_task_t const*)rdata;
-    tb_assert_and_check_return_val(ltask && rtask, -1);
+    tb_assert(timer_task->slot == TB_TIMER_WHEEL_SLOT_NONE);
 
-    // comp
-    return (ltask->when > rtask->when? 1 : (ltask->when < rtask->when? -1 : 0));
+    // expired? insert it to the expired list directly
+    tb_hong_t when  = timer_task->when;
+    tb_hong_t delta = when - timer->jiffies;
+    if (delta < 0)
+    {
+        timer_task->slot = TB_TIMER_WHEEL_SLOT_EXPIRED;
+        tb_timer_list_insert_tail(&timer->expired, &timer_task->entry);
+        return ;
+    }
+
+    // get the slot
+    tb_size_t slot;
+    if (delta < TB_TIMER_WHEEL_ROOT_SIZE) slot = (tb_size_t)(when & (TB_TIMER_WHEEL_ROOT_SIZE - 1));
+    else
+    {
+        // clamp the too far task to the last slot, it will be cascaded again
+        if (delta >= TB_TIMER_WHEEL_SPAN)
+        {
+            delta   = TB_TIMER_WHEEL_SPAN - 1;
+            when    = timer->jiffies + delta;
+        }
+
+        // get the level
+        tb_size_t level = 1;
+        while (level < TB_TIMER_WHEEL_LEVEL_MAXN && delta >= ((tb_hong_t)1 << tb_timer_wheel_shift(level + 1))) level++;
+
+        // get the slot of this level
+        slot = tb_timer_wheel_base(level) + (tb_size_t)((when >> tb_timer_wheel_shift(level)) & (TB_TIMER_WHEEL_LEVEL_SIZE - 1));
+    }
+
+    // insert it to the slot
+    timer_task->slot = (tb_uint16_t)slot;
+    tb_timer_list_insert_tail(&timer->slots[slot], &timer_task->entry);
+    timer->bitmap[slot >> 6] |= ((tb_uint64_t)1 << (slot & 63));
 }
-static tb_bool_t tb_timer_pred_by_task(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+static tb_void_t tb_timer_wheel_remove(tb_timer_t* timer, tb_timer_task_t* timer_task)
 {
-    // is equal?
-    return item == value;
+    // check
+    tb_size_t slot = timer_task->slot;
+    tb_assert(slot != TB_TIMER_WHEEL_SLOT_NONE);
+
+    // remove it
+    tb_timer_list_remove(&timer_task->entry);
+    timer_task->slot = TB_TIMER_WHEEL_SLOT_NONE;
+
+    // clear the slot bit if this slot is empty now
+    if (slot < TB_TIMER_WHEEL_SLOT_MAXN && tb_timer_list_empty(&timer->slots[slot]))
+        timer->bitmap[slot >> 6] &= ~((tb_uint64_t)1 << (slot & 63));
+}
+/* get the next time to spak the wheel
+ *
+ * it's the exact expired time for the root slots, 
+ * and the cascading time for the upper levels, which is not later than the real expired time of their tasks.
+ *
+ * @return      the next time, -1: empty
+ */
+static tb_hong_t tb_timer_wheel_next(tb_timer_t* timer)
+{
+    // find the first non-empty root slot from the current slot
+    tb_hong_t   next = -1;
+    tb_hong_t   jiffies = timer->jiffies;
+    tb_size_t   index = (tb_size_t)(jiffies & (TB_TIMER_WHEEL_ROOT_SIZE - 1));
+    tb_size_t   w = index >> 6;
+    tb_size_t   b = index & 63;
+    tb_size_t   n = 0;
+    tb_size_t   wn = TB_TIMER_WHEEL_ROOT_SIZE >> 6;
+    for (n = 0; n <= wn; n++)
+    {
+        // get the bits of this word, only the bits after the current slot for the first word and the bits before it for the last word
+        tb_size_t   i = (w + n) & (wn - 1);
+        tb_uint64_t bits = timer->bitmap[i];
+        if (!n) bits &= ~(tb_uint64_t)0 << b;
+        else if (n == wn) bits &= ((tb_uint64_t)1 << b) - 1;
+        if (bits)
+        {
+            tb_size_t slot = (i << 6) + tb_bits_fb1_u64_le(bits);
+            next = jiffies + ((slot - index) & (TB_TIMER_WHEEL_ROOT_SIZE - 1));
+            break;
+        }
+    }
+
+    // find the first non-empty slot of the upper levels
+    tb_size_t level;
+    for (level = 1; level <= TB_TIMER_WHEEL_LEVEL_MAXN; level++)
+    {
+        // empty?
+        tb_uint64_t bits = timer->bitmap[tb_timer_wheel_base(level) >> 6];
+        tb_check_continue(bits);
+
+        // rotate the bits to the current slot of this level
+        tb_size_t   shift = tb_timer_wheel_shift(level);
+        tb_hong_t   round = jiffies >> shift;
+        tb_size_t   current = (tb_size_t)(round & (TB_TIMER_WHEEL_LEVEL_SIZE - 1));
+        if (current) bits = (bits >> current) | (bits << (64 - current));
+
+        /* the current slot has been cascaded if the wheel is not at the beginning of it,
+         * so the tasks in it will be cascaded at the next round
+         */
+        tb_size_t k;
+        if (jiffies & (((tb_hong_t)1 << shift) - 1))
+        {
+            bits &= ~(tb_uint64_t)1;
+            k = bits? tb_bits_fb1_u64_le(bits) : TB_TIMER_WHEEL_LEVEL_SIZE;
+        }
+        else k = tb_bits_fb1_u64_le(bits);
+
+        // update the next time
+        tb_hong_t when = (round + k) << shift;
+        if (next < 0 || when < next) next = when;
+    }
+
+    // ok?
+    return next;
+}
+static tb_void_t tb_timer_wheel_cascade(tb_timer_t* timer, tb_size_t level)
+{
+    // the slot
+    tb_size_t slot = tb_timer_wheel_base(level) + (tb_size_t)((timer->jiffies >> tb_timer_wheel_shift(level)) & (TB_TIMER_WHEEL_LEVEL_SIZE - 1));
+    tb_check_return(!tb_timer_list_empty(&timer->slots[slot]));
+
+    // move all tasks of this slot
+    tb_list_entry_t list;
+    tb_timer_list_move(&list, &timer->slots[slot]);
+    timer->bitmap[slot >> 6] &= ~((tb_uint64_t)1 << (slot & 63));
+
+    // re-insert them to the lower levels
+    while (!tb_timer_list_empty(&list))
+    {
+        tb_timer_task_t* timer_task = (tb_timer_task_t*)list.next;
+        tb_timer_list_remove(&timer_task->entry);
+        timer_task->slot = TB_TIMER_WHEEL_SLOT_NONE;
+        tb_timer_wheel_insert(timer, timer_task);
+    }
+}
+static tb_void_t tb_timer_wheel_spak(tb_timer_t* timer, tb_hong_t now)
+{
+    // advance the wheel to now
+    while (timer->jiffies <= now)
+    {
+        // no more tasks before now? skip the empty slots
+        tb_hong_t next = tb_timer_wheel_next(timer);
+        if (next < 0 || next > now)
+        {
+            timer->jiffies = now + 1;
+            break;
+        }
+
+        // goto the next time
+        tb_assert(next >= timer->jiffies);
+        timer->jiffies = next;
+
+        // cascade the upper levels if the wheel enters their new slots
+        tb_size_t level;
+        for (level = TB_TIMER_WHEEL_LEVEL_MAXN; level; level--)
+        {
+            if (!(next & (((tb_hong_t)1 << tb_timer_wheel_shift(level)) - 1)))
+                tb_timer_wheel_cascade(timer, level);
+        }
+
+        // move the tasks of the current root slot to the expired list
+        tb_size_t slot = (tb_size_t)(next & (TB_TIMER_WHEEL_ROOT_SIZE - 1));
+        tb_list_entry_ref_t list = &timer->slots[slot];
+        while (!tb_timer_list_empty(list))
+        {
+            tb_timer_task_t* timer_task = (tb_timer_task_t*)list->next;
+            tb_assert(timer_task->when <= next);
+            tb_timer_list_remove(&timer_task->entry);
+            timer_task->slot = TB_TIMER_WHEEL_SLOT_EXPIRED;
+            tb_timer_list_insert_tail(&timer->expired, &timer_task->entry);
+        }
+        timer->bitmap[slot >> 6] &= ~((tb_uint64_t)1 << (slot & 63));
+
+        // next slot
+        timer->jiffies++;
+    }
+}
+static tb_void_t tb_timer_wheel_clear(tb_timer_t* timer)
+{
+    // clear slots
+    tb_size_t i;
+    for (i = 0; i < TB_TIMER_WHEEL_SLOT_MAXN; i++)
+        tb_timer_list_init(&timer->slots[i]);
+
+    // clear bitmap
+    tb_memset(timer->bitmap, 0, sizeof(timer->bitmap));
+
+    // clear the expired list
+    tb_timer_list_init(&timer->expired);
+
+    // reset the wheel time
+    timer->jiffies = tb_timer_now(timer);
+}
+static tb_hong_t tb_timer_wheel_top(tb_timer_t* timer)
+{
+    // exists expired tasks?
+    if (!tb_timer_list_empty(&timer->expired))
+        return ((tb_timer_task_t*)timer->expired.next)->when;
+
+    // get the next time of the wheel
+    return tb_timer_wheel_next(timer);
+}
+static tb_timer_task_t* tb_timer_task_init_(tb_timer_t* timer, tb_hize_t when, tb_size_t period, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv, tb_size_t refn)
+{
+    // stoped?
+    tb_assert_and_check_return_val(!tb_atomic_get(&timer->stop), tb_null);
+
+    // enter
+    tb_spinlock_enter(&timer->lock);
+
+    // make task
+    tb_event_ref_t      event = tb_null;
+    tb_hong_t           when_top = -1;
+    tb_timer_task_t*    timer_task = (tb_timer_task_t*)tb_fixed_pool_malloc0(timer->pool);
+    if (timer_task)
+    {
+        // the top when for the timer loop
+        event = timer->event;
+        if (event) when_top = tb_timer_wheel_top(timer);
+
+        // init task
+        timer_task->refn      = refn;
+        timer_task->func      = func;
+        timer_task->priv      = priv;
+        timer_task->when      = (tb_hong_t)when;
+        timer_task->period    = period;
+        timer_task->repeat    = repeat? 1 : 0;
+        timer_task->slot      = TB_TIMER_WHEEL_SLOT_NONE;
+
+        // add task
+        tb_timer_wheel_insert(timer, timer_task);
+    }
+
+    // leave
+    tb_spinlock_leave(&timer->lock);
+
+    // post event if the top task is changed
+    if (event && timer_task && (when_top < 0 || (tb_hong_t)when < when_top))
+        tb_event_post(event);
+
+    // ok?
+    return timer_task;
 }
 static tb_int_t tb_timer_instance_loop(tb_cpointer_t priv)
 {
@@ -219,9 +545,6 @@ tb_timer_ref_t tb_timer_init(tb_size_t grow, tb_bool_t ctime)
         timer = tb_malloc0_type(tb_timer_t);
         tb_assert_and_check_break(timer);
 
-        // init element
-        tb_element_t element = tb_element_ptr(tb_null, tb_null); element.comp = tb_timer_comp_by_when;
-
         // init timer
         timer->grow         = tb_max(grow, 16);
         timer->ctime        = ctime;
@@ -233,9 +556,8 @@ tb_timer_ref_t tb_timer_init(tb_size_t grow, tb_bool_t ctime)
         timer->pool         = tb_fixed_pool_init(tb_null, timer->grow, sizeof(tb_timer_task_t), tb_null, tb_null, tb_null);
         tb_assert_and_check_break(timer->pool);
         
-        // init heap
-        timer->heap         = tb_heap_init(timer->grow, element);
-        tb_assert_and_check_break(timer->heap);
+        // init wheel
+        tb_timer_wheel_clear(timer);
 
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
@@ -279,10 +601,6 @@ tb_void_t tb_timer_exit(tb_timer_ref_t self)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // exit heap
-    if (timer->heap) tb_heap_exit(timer->heap);
-    timer->heap = tb_null;
-
     // exit pool
     if (timer->pool) tb_fixed_pool_exit(timer->pool);
     timer->pool = tb_null;
@@ -326,8 +644,8 @@ tb_void_t tb_timer_clear(tb_timer_ref_t self)
         // enter
         tb_spinlock_enter(&timer->lock);
 
-        // clear heap
-        if (timer->heap) tb_heap_clear(timer->heap);
+        // clear wheel
+        tb_timer_wheel_clear(timer);
 
         // clear pool
         if (timer->pool) tb_fixed_pool_clear(timer->pool);
@@ -340,7 +658,7 @@ tb_hize_t tb_timer_top(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->heap, -1);
+    tb_assert_and_check_return_val(timer, -1);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_get(&timer->stop), -1);
@@ -348,26 +666,20 @@ tb_hize_t tb_timer_top(tb_timer_ref_t self)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // done
-    tb_hize_t when = -1; 
-    if (tb_heap_size(timer->heap))
-    {
-        // the task
-        tb_timer_task_t const* timer_task = (tb_timer_task_t const*)tb_heap_top(timer->heap);
-        if (timer_task) when = timer_task->when;
-    }
+    // get the top when
+    tb_hong_t when = tb_timer_wheel_top(timer);
 
     // leave
     tb_spinlock_leave(&timer->lock);
 
     // ok?
-    return when;
+    return when >= 0? (tb_hize_t)when : (tb_hize_t)-1;
 }
 tb_size_t tb_timer_delay(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->heap, -1);
+    tb_assert_and_check_return_val(timer, -1);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_get(&timer->stop), -1);
@@ -377,18 +689,14 @@ tb_size_t tb_timer_delay(tb_timer_ref_t self)
 
     // done
     tb_size_t delay = -1; 
-    if (tb_heap_size(timer->heap))
+    tb_hong_t when = tb_timer_wheel_top(timer);
+    if (when >= 0)
     {
-        // the task
-        tb_timer_task_t const* timer_task = (tb_timer_task_t const*)tb_heap_top(timer->heap);
-        if (timer_task)
-        {
-            // the now
-            tb_hong_t now = tb_timer_now(timer);
+        // the now
+        tb_hong_t now = tb_timer_now(timer);
 
-            // the delay
-            delay = timer_task->when > now? (tb_size_t)(timer_task->when - now) : 0;
-        }
+        // the delay
+        delay = when > now? (tb_size_t)(when - now) : 0;
     }
 
     // leave
@@ -401,7 +709,7 @@ tb_bool_t tb_timer_spak(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->heap, tb_false);
+    tb_assert_and_check_return_val(timer && timer->pool, tb_false);
 
     // stoped?
     tb_check_return_val(!tb_atomic_get(&timer->stop), tb_false);
@@ -409,74 +717,66 @@ tb_bool_t tb_timer_spak(tb_timer_ref_t self)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // done
-    tb_bool_t               ok = tb_false;
-    tb_timer_task_func_t    func = tb_null;
-    tb_cpointer_t           priv = tb_null;
-    tb_bool_t               killed = tb_false;
-    do
-    {
-        // empty? 
-        if (!tb_heap_size(timer->heap))
-        {
-            ok = tb_true;
-            break;
-        }
+    // the now
+    tb_hong_t now = tb_timer_now(timer);
+
+    // advance the wheel and move all expired tasks to the expired list
+    if (timer->jiffies <= now) tb_timer_wheel_spak(timer, now);
 
-        // the top task
-        tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_heap_top(timer->heap);
-        tb_assert_and_check_break(timer_task);
+    /* take all expired tasks at this time
+     *
+     * the repeated tasks with zero period will be expired again, 
+     * so we cannot done the expired list directly to avoid the infinite loop.
+     */
+    tb_list_entry_t expired;
+    tb_timer_list_move(&expired, &timer->expired);
+
+    // done all expired tasks
+    while (!tb_timer_list_empty(&expired))
+    {
+        // pop the task
+        tb_timer_task_t* timer_task = (tb_timer_task_t*)expired.next;
+        tb_timer_wheel_remove(timer, timer_task);
 
         // check refn
         tb_assert(timer_task->refn);
 
-        // the now
-        tb_hong_t now = tb_timer_now(timer);
+        // save func and data for calling it later
+        tb_timer_task_func_t    func = timer_task->func;
+        tb_cpointer_t           priv = timer_task->priv;
+        tb_bool_t               killed = timer_task->killed? tb_true : tb_false;
 
-        // timeout?
-        if (timer_task->when <= now)
+        // repeat?
+        if (timer_task->repeat)
         {
-            // pop it
-            tb_heap_pop(timer->heap);
-
-            // save func and data for calling it later
-            func = timer_task->func;
-            priv = timer_task->priv;
-
-            // killed?
-            killed = timer_task->killed? tb_true : tb_false;
-
-            // repeat?
-            if (timer_task->repeat)
-            {
-                // update when
-                timer_task->when = now + timer_task->period;
-
-                // continue timer_task
-                tb_heap_put(timer->heap, timer_task);
-            }
-            else 
-            {
-                // refn--
-                if (timer_task->refn > 1) timer_task->refn--;
-                // remove it from pool directly
-                else tb_fixed_pool_free(timer->pool, timer_task);
-            }
-        }
+            // update when
+            timer_task->when = now + timer_task->period;
 
-        // ok
-        ok = tb_true;
+            // continue timer_task
+            tb_timer_wheel_insert(timer, timer_task);
+        }
+        else 
+        {
+            // refn--
+            if (timer_task->refn > 1) timer_task->refn--;
+            // remove it from pool directly
+            else tb_fixed_pool_free(timer->pool, timer_task);
+        }
 
-    } while (0);
+        // done func without lock, the other tasks may be removed or killed in it
+        if (func)
+        {
+            tb_spinlock_leave(&timer->lock);
+            func(killed, priv);
+            tb_spinlock_enter(&timer->lock);
+        }
+    }
 
     // leave
     tb_spinlock_leave(&timer->lock);
 
-    // done func
-    if (func) func(killed, priv);
-
-    // ok?
-    return ok;
+    // ok
+    return tb_true;
 }
 tb_void_t tb_timer_loop(tb_timer_ref_t self)
 {
@@ -532,51 +832,10 @@ tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, t
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->heap && func, tb_null);
+    tb_assert_and_check_return_val(timer && timer->pool && func, tb_null);
 
-    // stoped?
-    tb_assert_and_check_return_val(!tb_atomic_get(&timer->stop), tb_null);
-
-    // enter
-    tb_spinlock_enter(&timer->lock);
-
-    // make task
-    tb_event_ref_t      event = tb_null;
-    tb_hize_t           when_top = -1;
-    tb_timer_task_t*    timer_task = (tb_timer_task_t*)tb_fixed_pool_malloc0(timer->pool);
-    if (timer_task)
-    {
-        // the top when 
-        if (tb_heap_size(timer->heap))
-        {
-            tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_heap_top(timer->heap);
-            if (timer_task) when_top = timer_task->when;
-        }
-
-        // init task
-        timer_task->refn      = 2;
-        timer_task->func      = func;
-        timer_task->priv      = priv;
-        timer_task->when      = when;
-        timer_task->period    = period;
-        timer_task->repeat    = repeat? 1 : 0;
-
-        // add task
-        tb_heap_put(timer->heap, timer_task);
-
-        // the event
-        event = timer->event;
-    }
-
-    // leave
-    tb_spinlock_leave(&timer->lock);
-
-    // post event if the top task is changed
-    if (event && timer_task && when < when_top)
-        tb_event_post(event);
-
-    // ok?
-    return (tb_timer_task_ref_t)timer_task;
+    // add task, it will be referenced by the wheel and the caller
+    return (tb_timer_task_ref_t)tb_timer_task_init_(timer, when, period, repeat, func, priv, 2);
 }
 tb_timer_task_ref_t tb_timer_task_init_after(tb_timer_ref_t self, tb_hize_t after, tb_size_t period, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv)
 {
@@ -600,48 +859,10 @@ tb_void_t tb_timer_task_post_at(tb_timer_ref_t self, tb_hize_t when, tb_size_t p
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return(timer && timer->pool && timer->heap && func);
-
-    // stoped?
-    tb_assert_and_check_return(!tb_atomic_get(&timer->stop));
-
-    // enter
-    tb_spinlock_enter(&timer->lock);
-
-    // make task
-    tb_event_ref_t      event = tb_null;
-    tb_hize_t           when_top = -1;
-    tb_timer_task_t*    timer_task = (tb_timer_task_t*)tb_fixed_pool_malloc0(timer->pool);
-    if (timer_task)
-    {
-        // the top when 
-        if (tb_heap_size(timer->heap))
-        {
-            tb_timer_task_t* timer_task = (tb_timer_task_t*)tb_heap_top(timer->heap);
-            if (timer_task) when_top = timer_task->when;
-        }
-
-        // init task
-        timer_task->refn      = 1;
-        timer_task->func      = func;
-        timer_task->priv      = priv;
-        timer_task->when      = when;
-        timer_task->period    = period;
-        timer_task->repeat    = repeat? 1 : 0;
+    tb_assert_and_check_return(timer && timer->pool && func);
 
-        // add task
-        tb_heap_put(timer->heap, timer_task);
-
-        // the event
-        event = timer->event;
-    }
-
-    // leave
-    tb_spinlock_leave(&timer->lock);
-
-    // post event if the top task is changed
-    if (event && timer_task && when < when_top)
-        tb_event_post(event);
+    // add task, it will be only referenced by the wheel
+    tb_timer_task_init_(timer, when, period, repeat, func, priv, 1);
 }
 tb_void_t tb_timer_task_post_after(tb_timer_ref_t self, tb_hize_t after, tb_size_t period, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv)
 {
@@ -665,19 +886,18 @@ tb_void_t tb_timer_task_exit(tb_timer_ref_t self, tb_timer_task_ref_t task)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // remove it?
-    if (timer_task->refn > 1)
+    // remove it from the wheel directly if it has been not expired
+    if (timer_task->slot != TB_TIMER_WHEEL_SLOT_NONE)
     {
-        // refn--
-        timer_task->refn--;
+        // check refn
+        tb_assert(timer_task->refn == 2);
 
-        // cancel task 
-        timer_task->func      = tb_null;
-        timer_task->priv      = tb_null;
-        timer_task->repeat    = 0;
+        // remove it
+        tb_timer_wheel_remove(timer, timer_task);
     }
-    // remove it from pool directly if the timer_task have been expired 
-    else tb_fixed_pool_free(timer->pool, timer_task);
+
+    // remove it from pool
+    tb_fixed_pool_free(timer->pool, timer_task);
 
     // leave
     tb_spinlock_leave(&timer->lock);
@@ -695,18 +915,12 @@ tb_void_t tb_timer_task_kill(tb_timer_ref_t self, tb_timer_task_ref_t task)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // done
-    do
+    // expired or removed?
+    tb_event_ref_t event = tb_null;
+    if (timer_task->slot != TB_TIMER_WHEEL_SLOT_NONE)
     {
-        // expired or removed?
-        tb_check_break(timer_task->refn == 2);
-
-        // find it
-        tb_size_t itor = tb_find_all_if(timer->heap, tb_timer_pred_by_task, timer_task);
-        tb_assert_and_check_break(itor != tb_iterator_tail(timer->heap));
-
         // remove this task
-        tb_heap_remove(timer->heap, itor);
+        tb_timer_wheel_remove(timer, timer_task);
 
         // killed
         timer_task->killed = 1;
@@ -717,11 +931,17 @@ tb_void_t tb_timer_task_kill(tb_timer_ref_t self, tb_timer_task_ref_t task)
         // modify when => now
         timer_task->when = tb_timer_now(timer);
 
-        // re-add timer_task
-        tb_heap_put(timer->heap, timer_task);
+        // move it to the expired list
+        timer_task->slot = TB_TIMER_WHEEL_SLOT_EXPIRED;
+        tb_timer_list_insert_tail(&timer->expired, &timer_task->entry);
 
-    } while (0);
+        // the event
+        event = timer->event;
+    }
 
     // leave
     tb_spinlock_leave(&timer->lock);
+
+    // post event to call it immediately
+    if (event) tb_event_post(event);
 }
@@ -98,6 +98,9 @@ tb_size_t           tb_timer_delay(tb_timer_ref_t timer);
  *
  * @param timer     the timer 
  *
+ * @note            the tasks are stored in the hierarchical timing wheel, 
+ *                  so it may be earlier than the real when of the far tasks, but never be later
+ *
  * @return          the top when, -1: no task
  */
 tb_hize_t           tb_timer_top(tb_timer_ref_t timer);
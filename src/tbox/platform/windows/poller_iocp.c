@@ -318,7 +318,7 @@ static tb_long_t tb_poller_iocp_event_spak_iorw(tb_poller_iocp_ref_t poller, tb_
     // ok
     return 1;
 }
-static tb_long_t tb_poller_iocp_event_spak(tb_poller_iocp_ref_t poller, tb_poller_event_func_t func, tb_iocp_object_ref_t object, tb_size_t real, tb_size_t error)
+static tb_long_t tb_poller_iocp_event_spak(tb_poller_iocp_ref_t poller, tb_poller_sink_ref_t sink, tb_iocp_object_ref_t object, tb_size_t real, tb_size_t error)
 {
     // trace
     tb_trace_d("spak[%p]: code %u, state: %s ..", object->sock, object->code, tb_state_cstr(object->state));
@@ -350,13 +350,13 @@ static tb_long_t tb_poller_iocp_event_spak(tb_poller_iocp_ref_t poller, tb_polle
     // finish to wait events    
     object->state = TB_STATE_FINISHED;
 
-    // do event handler 
-    func((tb_poller_ref_t)poller, object->sock, tb_poller_iocp_event_from_code(object->code), object->priv);
+    // report events
+    tb_poller_sink_done(sink, (tb_poller_ref_t)poller, object->sock, tb_poller_iocp_event_from_code(object->code), object->priv);
 
     // ok?
     return ok;
 }
-static tb_long_t tb_poller_iocp_event_wait_ex(tb_poller_iocp_ref_t poller, tb_poller_event_func_t func, tb_long_t timeout)
+static tb_long_t tb_poller_iocp_event_wait_ex(tb_poller_iocp_ref_t poller, tb_poller_sink_ref_t sink, tb_long_t timeout)
 {
     // clear error first
     SetLastError(ERROR_SUCCESS);
@@ -370,9 +370,10 @@ static tb_long_t tb_poller_iocp_event_wait_ex(tb_poller_iocp_ref_t poller, tb_po
         tb_assert_and_check_return_val(poller->events, -1);
     }
 
-    // wait events
+    // wait events, we only get the events which can be saved to the sink
+    DWORD events_maxn = (DWORD)tb_min(poller->events_count, tb_poller_sink_left(sink));
     DWORD events_count = 0;
-    BOOL  wait_ok = poller->func.GetQueuedCompletionStatusEx(poller->port, poller->events, (DWORD)poller->events_count, &events_count, (DWORD)(timeout < 0? INFINITE : timeout), FALSE);
+    BOOL  wait_ok = poller->func.GetQueuedCompletionStatusEx(poller->port, poller->events, events_maxn, &events_count, (DWORD)(timeout < 0? INFINITE : timeout), FALSE);
 
     // the last error
     tb_size_t error = (tb_size_t)GetLastError();
@@ -401,7 +402,6 @@ static tb_long_t tb_poller_iocp_event_wait_ex(tb_poller_iocp_ref_t poller, tb_po
 
     // handle events
     tb_size_t               i = 0;
-    tb_size_t               wait = 0; 
     tb_OVERLAPPED_ENTRY_t*  e = tb_null;
     for (i = 0; i < events_count; i++)
     {
@@ -438,21 +438,19 @@ static tb_long_t tb_poller_iocp_event_wait_ex(tb_poller_iocp_ref_t poller, tb_po
         // trace
         tb_trace_d("wait_ex[%p]: real: %u bytes, lasterror: %lu", object->sock, real, error);
 
-        // spark and update the events
-        if (tb_poller_iocp_event_spak(poller, func, object, real, error) > 0)
-            wait++;
+        // spark and report the events
+        tb_poller_iocp_event_spak(poller, sink, object, real, error);
     }
 
     // ok
-    return wait;
+    return sink->size;
 }
-static tb_long_t tb_poller_iocp_event_wait(tb_poller_iocp_ref_t poller, tb_poller_event_func_t func, tb_long_t timeout)
+static tb_long_t tb_poller_iocp_event_wait(tb_poller_iocp_ref_t poller, tb_poller_sink_ref_t sink, tb_long_t timeout)
 {
-    tb_size_t wait = 0;
-    while (1)
+    while (!tb_poller_sink_full(sink))
     {
         // compute the timeout
-        if (wait) timeout = 0;
+        if (sink->size) timeout = 0;
 
         // clear error first
         SetLastError(ERROR_SUCCESS);
@@ -487,13 +485,12 @@ static tb_long_t tb_poller_iocp_event_wait(tb_poller_iocp_ref_t poller, tb_polle
         // trace
         tb_trace_d("wait[%p]: %s, real: %u bytes, lasterror: %lu", object->sock, wait_ok? "ok" : "failed", real, error);
 
-        // spark and update the events
-        if (tb_poller_iocp_event_spak(poller, func, object, real, error) > 0)
-            wait++;
+        // spark and report the events
+        tb_poller_iocp_event_spak(poller, sink, object, real, error);
     }
 
     // ok
-    return wait;
+    return sink->size;
 }
 tb_bool_t tb_poller_iocp_bind_object(tb_poller_iocp_ref_t poller, tb_iocp_object_ref_t object)
 {
@@ -665,11 +662,11 @@ tb_bool_t tb_poller_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t
 {
     return tb_poller_insert(self, sock, events, priv);
 }
-tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_long_t timeout)
+static tb_long_t tb_poller_wait_sink(tb_poller_ref_t self, tb_poller_sink_ref_t sink, tb_long_t timeout)
 {
     // check
     tb_poller_iocp_ref_t poller = (tb_poller_iocp_ref_t)self;
-    tb_assert_and_check_return_val(poller && func, -1);
+    tb_assert_and_check_return_val(poller && sink, -1);
 
     // trace
     tb_trace_d("waiting with timeout(%ld) ..", timeout);
@@ -679,8 +676,8 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
      */
     tb_long_t wait = -1;
     if (poller->lastwait_count > 1 && poller->func.GetQueuedCompletionStatusEx)
-        wait = tb_poller_iocp_event_wait_ex(poller, func, timeout);
-    else wait = tb_poller_iocp_event_wait(poller, func, timeout);
+        wait = tb_poller_iocp_event_wait_ex(poller, sink, timeout);
+    else wait = tb_poller_iocp_event_wait(poller, sink, timeout);
 
     // save the last wait count
     poller->lastwait_count = wait;
@@ -26,6 +26,31 @@
  */
 #include "prefix.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the regex type, it's defined by the backend implementation
+struct __tb_regex_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+
+/* get the offset and length of the matched substring after executing regex
+ *
+ * it's implemented by the backend.
+ *
+ * @param regex         the regex
+ * @param start         the start position of the executed regex
+ * @param index         the substring index, the whole matched string is 0
+ * @param poffset       the substring offset pointer
+ * @param plength       the substring length pointer
+ *
+ * @return              tb_true or tb_false (this substring is not matched)
+ */
+static tb_bool_t tb_regex_exec_substr(struct __tb_regex_t* regex, tb_size_t start, tb_size_t index, tb_size_t* poffset, tb_size_t* plength);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -41,4 +66,81 @@ static tb_void_t tb_regex_match_exit(tb_element_ref_t element, tb_pointer_t buff
     match->size = 0;
 }
 
+/* save the match results after executing regex
+ *
+ * @param regex         the regex
+ * @param pcache        the cached results of the regex, it will be used if the given results is null
+ * @param cstr          the c-string data
+ * @param size          the c-string size
+ * @param start         the start position
+ * @param count         the matched substring count
+ * @param plength       the matched length pointer, do not get it if be null
+ * @param presults      the results pointer, only match it if be null
+ *
+ * @return              the matched position, failed: -1
+ */
+static tb_long_t tb_regex_match_save(struct __tb_regex_t* regex, tb_vector_ref_t* pcache, tb_char_t const* cstr, tb_size_t size, tb_size_t start, tb_size_t count, tb_size_t* plength, tb_vector_ref_t* presults)
+{
+    // get the match offset and length
+    tb_size_t offset = 0;
+    tb_size_t length = 0;
+    tb_check_return_val(tb_regex_exec_substr(regex, start, 0, &offset, &length) && offset + length <= size, -1);
+
+    // trace
+    tb_trace_d("matched count: %lu, offset: %lu, length: %lu", count, offset, length);
+
+    // save results
+    if (presults)
+    {
+        // init results if not exists
+        tb_vector_ref_t results = *presults;
+        if (!results)
+        {
+            // init it
+            if (!*pcache) *pcache = tb_vector_init(16, tb_element_mem(sizeof(tb_regex_match_t), tb_regex_match_exit, tb_null));
+
+            // save it
+            *presults = results = *pcache;
+        }
+        tb_assert_and_check_return_val(results, -1);
+
+        // clear it first
+        tb_vector_clear(results);
+
+        // done
+        tb_size_t           i = 0;
+        tb_size_t           substr_offset = 0;
+        tb_size_t           substr_length = 0;
+        tb_regex_match_t    entry;
+        for (i = 0; i < count; i++)
+        {
+            // get substring offset and length, the unmatched substring will be saved as an empty string
+            if (!tb_regex_exec_substr(regex, start, i, &substr_offset, &substr_length))
+            {
+                substr_offset = offset;
+                substr_length = 0;
+            }
+            tb_assert_and_check_return_val(substr_offset + substr_length <= size, -1);
+
+            // make match entry
+            entry.cstr  = tb_strndup(cstr + substr_offset, substr_length);
+            entry.size  = substr_length;
+            entry.start = substr_offset;
+            tb_assert_and_check_return_val(entry.cstr, -1);
+
+            // trace
+            tb_trace_d("    matched: [%lu, %lu]: %s", entry.start, entry.size, entry.cstr);
+
+            // append it
+            tb_vector_insert_tail(results, &entry);
+        }
+    }
+
+    // save length
+    if (plength) *plength = length;
+
+    // ok
+    return (tb_long_t)offset;
+}
+
 #endif
@@ -38,6 +38,9 @@ typedef struct __tb_regex_t
     // the code
     pcre*               code;
 
+    // the study data, it contains the jit code if be supported
+    pcre_extra*         extra;
+
     // the results 
     tb_vector_ref_t     results;
 
@@ -58,6 +61,65 @@ typedef struct __tb_regex_t
 
 }tb_regex_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_long_t tb_regex_exec(tb_regex_t* regex, tb_char_t const* cstr, tb_size_t size, tb_size_t start)
+{
+    // check
+    tb_assert_and_check_return_val(regex && regex->code && cstr, -1);
+
+    // init options
+#ifdef __tb_debug__
+    tb_uint32_t options = 0;
+#else
+    tb_uint32_t options = 0;//PCRE_NO_UTF_CHECK;
+#endif
+
+    // init ovector
+    if (!regex->ovector_data)
+    {
+        regex->ovector_maxn = 3 * 16;
+        regex->ovector_data = (tb_int_t*)tb_malloc_bytes(sizeof(tb_int_t) * regex->ovector_maxn);
+    }
+    tb_assert_and_check_return_val(regex->ovector_data, -1);
+
+    // match it
+    tb_long_t count = -1;
+    while (!(count = pcre_exec(regex->code, regex->extra, cstr, (tb_int_t)size, (tb_int_t)start, (tb_int_t)options, regex->ovector_data, (tb_int_t)regex->ovector_maxn)))
+    {
+        // grow ovector
+        regex->ovector_maxn <<= 1;
+        regex->ovector_data = (tb_int_t*)tb_ralloc_bytes(regex->ovector_data, sizeof(tb_int_t) * regex->ovector_maxn);
+        tb_assert_and_check_return_val(regex->ovector_data, -1);
+    }
+    if (count < 0)
+    {
+        // no match?
+        tb_check_return_val(count != PCRE_ERROR_NOMATCH, 0);
+
+        // trace
+        tb_trace_d("match failed at offset %lu: error: %ld\n", start, count);
+
+        // failed
+        return -1;
+    }
+
+    // ok
+    return count;
+}
+static tb_bool_t tb_regex_exec_substr(tb_regex_t* regex, tb_size_t start, tb_size_t index, tb_size_t* poffset, tb_size_t* plength)
+{
+    // this substring is not matched?
+    tb_int_t const* ovector = regex->ovector_data;
+    tb_check_return_val(ovector[index << 1] >= 0, tb_false);
+
+    // get the substring offset and length
+    *poffset = (tb_size_t)ovector[index << 1];
+    *plength = (tb_size_t)(ovector[(index << 1) + 1] - ovector[index << 1]);
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -96,6 +158,14 @@ tb_regex_ref_t tb_regex_init(tb_char_t const* pattern, tb_size_t mode)
             break;
         }
 
+        // study it and enable jit if be supported, it's optional
+#ifdef PCRE_STUDY_JIT_COMPILE
+        regex->extra = pcre_study(regex->code, PCRE_STUDY_JIT_COMPILE, &errorstring);
+#else
+        regex->extra = pcre_study(regex->code, 0, &errorstring);
+#endif
+        if (errorstring) tb_trace_d("study failed: %s", errorstring);
+
         // save mode
         regex->mode = mode;
 
@@ -135,6 +205,14 @@ tb_void_t tb_regex_exit(tb_regex_ref_t self)
     if (regex->results) tb_vector_exit(regex->results);
     regex->results = tb_null;
 
+    // exit study data
+#ifdef PCRE_STUDY_JIT_COMPILE
+    if (regex->extra) pcre_free_study(regex->extra);
+#else
+    if (regex->extra) pcre_free(regex->extra);
+#endif
+    regex->extra = tb_null;
+
     // exit code
     if (regex->code) pcre_free(regex->code);
     regex->code = tb_null;
@@ -148,117 +226,18 @@ tb_long_t tb_regex_match(tb_regex_ref_t self, tb_char_t const* cstr, tb_size_t s
     tb_regex_t* regex = (tb_regex_t*)self;
     tb_assert_and_check_return_val(regex && regex->code && cstr, -1);
 
-    // done
-    tb_long_t ok = -1;
-    do
-    {
-        // clear length first
-        if (plength) *plength = 0;
+    // clear length first
+    if (plength) *plength = 0;
 
-        // end?
-        tb_check_break(start < size);
+    // end?
+    tb_check_return_val(start < size, -1);
 
-        // init options
-#ifdef __tb_debug__
-        tb_uint32_t options = 0;
-#else
-        tb_uint32_t options = 0;//PCRE_NO_UTF_CHECK;
-#endif
-
-        // init ovector
-        if (!regex->ovector_data)
-        {
-            regex->ovector_maxn = 3 * 16;
-            regex->ovector_data = (tb_int_t*)tb_malloc_bytes(sizeof(tb_int_t) * regex->ovector_maxn);
-        }
-        tb_assert_and_check_break(regex->ovector_data);
-
-        // match it
-        tb_long_t count = -1;
-        while (!(count = pcre_exec(regex->code, tb_null, cstr, (tb_int_t)size, (tb_int_t)start, (tb_int_t)options, regex->ovector_data, (tb_int_t)regex->ovector_maxn)))
-        {
-            // grow ovector
-            regex->ovector_maxn <<= 1;
-            regex->ovector_data = (tb_int_t*)tb_ralloc_bytes(regex->ovector_data, sizeof(tb_int_t) * regex->ovector_maxn);
-            tb_assert_and_check_break(regex->ovector_data);
-        }
-        if (count < 0)
-        {
-            // no match?
-            tb_check_break(count != PCRE_ERROR_NOMATCH);
+    // match it
+    tb_long_t count = tb_regex_exec(regex, cstr, size, start);
+    tb_check_return_val(count > 0, -1);
 
-            // trace
-            tb_trace_d("match failed at offset %lu: error: %ld\n", start, count);
-
-            // end
-            break;
-        }
-
-        // check
-        tb_assertf_and_check_break(count, "ovector has not enough space!");
-
-        // get the match offset and length
-        tb_int_t const* ovector = regex->ovector_data;
-        tb_size_t       offset = (tb_size_t)ovector[0];
-        tb_size_t       length = (tb_size_t)ovector[1] - ovector[0];
-        tb_assert_and_check_break(offset + length <= size);
-
-        // trace
-        tb_trace_d("matched count: %lu, offset: %lu, length: %lu", count, offset, length);
-
-        // save results
-        if (presults)
-        {
-            // init results if not exists
-            tb_vector_ref_t results = *presults;
-            if (!results)
-            {
-                // init it
-                if (!regex->results) regex->results = tb_vector_init(16, tb_element_mem(sizeof(tb_regex_match_t), tb_regex_match_exit, tb_null));
-
-                // save it
-                *presults = results = regex->results;
-            }
-            tb_assert_and_check_break(results);
-
-            // clear it first
-            tb_vector_clear(results);
-
-            // done
-            tb_long_t           i = 0;
-            tb_regex_match_t    entry;
-            for (i = 0; i < count; i++)
-            {
-                // get substring offset and length
-                tb_size_t substr_offset = ovector[i << 1];
-                tb_size_t substr_length = ovector[(i << 1) + 1] - ovector[i << 1];
-                tb_assert_and_check_break(substr_offset + substr_length <= size);
-
-                // make match entry
-                entry.cstr  = tb_strndup(cstr + substr_offset, substr_length);
-                entry.size  = substr_length;
-                entry.start = substr_offset;
-                tb_assert_and_check_break(entry.cstr);
-                
-                // trace
-                tb_trace_d("    matched: [%lu, %lu]: %s", entry.start, entry.size, entry.cstr);
-
-                // append it
-                tb_vector_insert_tail(results, &entry);
-            }
-            tb_assert_and_check_break(i == count);
-        }
-
-        // save length 
-        if (plength) *plength = length;
-
-        // ok
-        ok = offset;
-
-    } while (0);
-
-    // ok?
-    return ok;
+    // save results
+    return tb_regex_match_save(regex, &regex->results, cstr, size, start, (tb_size_t)count, plength, presults);
 }
 tb_char_t const* tb_regex_replace(tb_regex_ref_t self, tb_char_t const* cstr, tb_size_t size, tb_size_t start, tb_char_t const* replace_cstr, tb_size_t replace_size, tb_size_t* plength)
 {
@@ -293,8 +272,7 @@ tb_char_t const* tb_regex_replace(tb_regex_ref_t self, tb_char_t const* cstr, tb
         tb_long_t       suboffset = start;
         tb_size_t       sublength = 0;
         tb_size_t       length = 0;
-        tb_vector_ref_t results = tb_null;
-        while ((suboffset = tb_regex_match(self, regex->buffer_data, size, suboffset + sublength, &sublength, &results)) >= 0 && results)
+        while ((suboffset = tb_regex_match(self, regex->buffer_data, size, suboffset + sublength, &sublength, tb_null)) >= 0)
         {
             // trace
             tb_trace_d("replace: match: [%lu, %lu]", suboffset, sublength);
@@ -55,6 +55,62 @@ typedef struct __tb_regex_t
 
 }tb_regex_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_long_t tb_regex_exec(tb_regex_t* regex, tb_char_t const* cstr, tb_size_t size, tb_size_t start)
+{
+    // check
+    tb_assert_and_check_return_val(regex && regex->code && regex->match_data && cstr, -1);
+
+    // init options
+#ifdef __tb_debug__
+    tb_uint32_t options = 0;
+#else
+    tb_uint32_t options = PCRE2_NO_UTF_CHECK;
+#endif
+
+    // match it, it will use the jit code if exists
+    tb_long_t count = pcre2_match(regex->code, (PCRE2_SPTR)cstr, (PCRE2_SIZE)size, (PCRE2_SIZE)start, options, regex->match_data, tb_null);
+    if (count < 0)
+    {
+        // no match?
+        tb_check_return_val(count != PCRE2_ERROR_NOMATCH, 0);
+
+#if defined(__tb_debug__) && !defined(TB_CONFIG_OS_WINDOWS)
+        // get error info
+        PCRE2_UCHAR info[256];
+        pcre2_get_error_message(count, info, sizeof(info));
+
+        // trace
+        tb_trace_d("match failed at offset %lu: error: %ld, %s\n", start, count, info);
+#endif
+
+        // failed
+        return -1;
+    }
+
+    // check
+    tb_assertf_and_check_return_val(count, -1, "ovector has not enough space!");
+
+    // ok
+    return count;
+}
+static tb_bool_t tb_regex_exec_substr(tb_regex_t* regex, tb_size_t start, tb_size_t index, tb_size_t* poffset, tb_size_t* plength)
+{
+    // get output vector
+    PCRE2_SIZE* ovector = pcre2_get_ovector_pointer(regex->match_data);
+    tb_assert_and_check_return_val(ovector, tb_false);
+
+    // this substring is not matched?
+    tb_check_return_val(ovector[index << 1] != PCRE2_UNSET, tb_false);
+
+    // get the substring offset and length
+    *poffset = (tb_size_t)ovector[index << 1];
+    *plength = (tb_size_t)(ovector[(index << 1) + 1] - ovector[index << 1]);
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -99,6 +155,15 @@ tb_regex_ref_t tb_regex_init(tb_char_t const* pattern, tb_size_t mode)
             break;
         }
 
+#ifdef PCRE2_CONFIG_JIT
+        // enable jit if be supported, the interpreter will be used if jit compilation failed
+        tb_uint32_t jit = 0;
+        if (pcre2_config(PCRE2_CONFIG_JIT, &jit) >= 0 && jit)
+        {
+            if (pcre2_jit_compile(regex->code, PCRE2_JIT_COMPLETE)) tb_trace_d("jit compile failed, uses the interpreter");
+        }
+#endif
+
         // init match data
         regex->match_data = pcre2_match_data_create_from_pattern(regex->code, tb_null);
         tb_assert_and_check_break(regex->match_data);
@@ -154,111 +219,18 @@ tb_long_t tb_regex_match(tb_regex_ref_t self, tb_char_t const* cstr, tb_size_t s
     tb_regex_t* regex = (tb_regex_t*)self;
     tb_assert_and_check_return_val(regex && regex->code && regex->match_data && cstr, -1);
 
-    // done
-    tb_long_t ok = -1;
-    do
-    {
-        // clear length first
-        if (plength) *plength = 0;
-
-        // end?
-        tb_check_break(start < size);
-
-        // init options
-#ifdef __tb_debug__
-        tb_uint32_t options = 0;
-#else
-        tb_uint32_t options = PCRE2_NO_UTF_CHECK;
-#endif
-
-        // match it
-        tb_long_t count = pcre2_match(regex->code, (PCRE2_SPTR)cstr, (PCRE2_SIZE)size, (PCRE2_SIZE)start, options, regex->match_data, tb_null);
-        if (count < 0)
-        {
-            // no match?
-            tb_check_break(count != PCRE2_ERROR_NOMATCH);
+    // clear length first
+    if (plength) *plength = 0;
 
-#if defined(__tb_debug__) && !defined(TB_CONFIG_OS_WINDOWS)
-            // get error info
-            PCRE2_UCHAR info[256];
-            pcre2_get_error_message(count, info, sizeof(info));
+    // end?
+    tb_check_return_val(start < size, -1);
 
-            // trace
-            tb_trace_d("match failed at offset %lu: error: %ld, %s\n", start, count, info);
-#endif
-
-            // end
-            break;
-        }
+    // match it
+    tb_long_t count = tb_regex_exec(regex, cstr, size, start);
+    tb_check_return_val(count > 0, -1);
 
-        // check
-        tb_assertf_and_check_break(count, "ovector has not enough space!");
-
-        // get output vector
-        PCRE2_SIZE* ovector = pcre2_get_ovector_pointer(regex->match_data);
-        tb_assert_and_check_break(ovector);
-
-        // get the match offset and length
-        tb_size_t offset = (tb_size_t)ovector[0];
-        tb_size_t length = (tb_size_t)ovector[1] - ovector[0];
-        tb_assert_and_check_break(offset + length <= size);
-
-        // trace
-        tb_trace_d("matched count: %lu, offset: %lu, length: %lu", count, offset, length);
-
-        // save results
-        if (presults)
-        {
-            // init results if not exists
-            tb_vector_ref_t results = *presults;
-            if (!results)
-            {
-                // init it
-                if (!regex->results) regex->results = tb_vector_init(16, tb_element_mem(sizeof(tb_regex_match_t), tb_regex_match_exit, tb_null));
-
-                // save it
-                *presults = results = regex->results;
-            }
-            tb_assert_and_check_break(results);
-
-            // clear it first
-            tb_vector_clear(results);
-
-            // done
-            tb_long_t           i = 0;
-            tb_regex_match_t    entry;
-            for (i = 0; i < count; i++)
-            {
-                // get substring offset and length
-                tb_size_t substr_offset = ovector[i << 1];
-                tb_size_t substr_length = ovector[(i << 1) + 1] - ovector[i << 1];
-                tb_assert_and_check_break(substr_offset + substr_length <= size);
-
-                // make match entry
-                entry.cstr  = tb_strndup(cstr + substr_offset, substr_length);
-                entry.size  = substr_length;
-                entry.start = substr_offset;
-                tb_assert_and_check_break(entry.cstr);
-                
-                // trace
-                tb_trace_d("    matched: [%lu, %lu]: %s", entry.start, entry.size, entry.cstr);
-
-                // append it
-                tb_vector_insert_tail(results, &entry);
-            }
-            tb_assert_and_check_break(i == count);
-        }
-
-        // save length 
-        if (plength) *plength = length;
-
-        // ok
-        ok = offset;
-
-    } while (0);
-
-    // ok?
-    return ok;
+    // save results
+    return tb_regex_match_save(regex, &regex->results, cstr, size, start, (tb_size_t)count, plength, presults);
 }
 tb_char_t const* tb_regex_replace(tb_regex_ref_t self, tb_char_t const* cstr, tb_size_t size, tb_size_t start, tb_char_t const* replace_cstr, tb_size_t replace_size, tb_size_t* plength)
 {
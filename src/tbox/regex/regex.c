@@ -30,6 +30,62 @@
  */
 #include "regex.h"
 #include "impl/impl.h"
+#include "../platform/spinlock.h"
+#include "../utils/singleton.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the regex cache maxn
+#ifdef __tb_small__
+#   define TB_REGEX_CACHE_MAXN          (16)
+#else
+#   define TB_REGEX_CACHE_MAXN          (64)
+#endif
+
+// the stack matches count of tb_regex_match_all()
+#define TB_REGEX_MATCHES_STACK_MAXN     (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the regex cache entry type
+typedef struct __tb_regex_cache_entry_t
+{
+    // the list entry for lru
+    tb_list_entry_t         entry;
+
+    // the regex
+    tb_regex_ref_t          regex;
+
+    // the mode
+    tb_size_t               mode;
+
+    // the pattern size
+    tb_size_t               size;
+
+    // the pattern
+    tb_char_t const*        pattern;
+
+}tb_regex_cache_entry_t;
+
+/* the regex cache type
+ *
+ * the compiled regex has the mutable match data and buffers, so it will be taken out from the cache
+ * when it's being used, and be put back after using it. the concurrent users of the same pattern
+ * will compile their own copies, and each idle copy keeps its match data and buffers for reusing.
+ */
+typedef struct __tb_regex_cache_t
+{
+    // the lock
+    tb_spinlock_t           lock;
+
+    // the idle regexes, the recently used entry is at head
+    tb_list_entry_head_t    lru;
+
+}tb_regex_cache_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -42,6 +98,22 @@
         && defined(TB_CONFIG_POSIX_HAVE_REGEXEC)
 #   include "../platform/posix/regex.c"
 #else
+typedef struct __tb_regex_t
+{
+    // the mode
+    tb_size_t           mode;
+
+}tb_regex_t;
+static tb_long_t tb_regex_exec(tb_regex_t* regex, tb_char_t const* cstr, tb_size_t size, tb_size_t start)
+{
+    tb_assert_noimpl();
+    return -1;
+}
+static tb_bool_t tb_regex_exec_substr(tb_regex_t* regex, tb_size_t start, tb_size_t index, tb_size_t* poffset, tb_size_t* plength)
+{
+    tb_assert_noimpl();
+    return tb_false;
+}
 tb_regex_ref_t tb_regex_init(tb_char_t const* pattern, tb_size_t mode)
 {
     tb_assert_noimpl();
@@ -62,6 +134,173 @@ tb_char_t const* tb_regex_replace(tb_regex_ref_t regex, tb_char_t const* cstr, t
     return tb_null;
 }
 #endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * cache implementation
+ */
+static tb_void_t tb_regex_cache_entry_exit(tb_regex_cache_entry_t* entry)
+{
+    // check
+    tb_assert_and_check_return(entry);
+
+    // exit regex
+    if (entry->regex) tb_regex_exit(entry->regex);
+    entry->regex = tb_null;
+
+    // exit it
+    tb_free(entry);
+}
+static tb_handle_t tb_regex_cache_instance_init(tb_cpointer_t* ppriv)
+{
+    // make cache
+    tb_regex_cache_t* cache = tb_malloc0_type(tb_regex_cache_t);
+    tb_assert_and_check_return_val(cache, tb_null);
+
+    // init lock
+    if (!tb_spinlock_init(&cache->lock))
+    {
+        tb_free(cache);
+        return tb_null;
+    }
+
+    // init lru list
+    tb_list_entry_init(&cache->lru, tb_regex_cache_entry_t, entry, tb_null);
+
+    // ok
+    return (tb_handle_t)cache;
+}
+static tb_void_t tb_regex_cache_instance_exit(tb_handle_t handle, tb_cpointer_t priv)
+{
+    // check
+    tb_regex_cache_t* cache = (tb_regex_cache_t*)handle;
+    tb_assert_and_check_return(cache);
+
+    // exit all idle regexes
+    while (tb_list_entry_size(&cache->lru))
+    {
+        // the last entry
+        tb_list_entry_ref_t last = tb_list_entry_last(&cache->lru);
+        tb_list_entry_remove_last(&cache->lru);
+
+        // exit it
+        tb_regex_cache_entry_exit((tb_regex_cache_entry_t*)tb_list_entry(&cache->lru, last));
+    }
+    tb_list_entry_exit(&cache->lru);
+
+    // exit lock
+    tb_spinlock_exit(&cache->lock);
+
+    // exit it
+    tb_free(cache);
+}
+static tb_regex_cache_t* tb_regex_cache()
+{
+    return (tb_regex_cache_t*)tb_singleton_instance(TB_SINGLETON_TYPE_REGEX_CACHE, tb_regex_cache_instance_init, tb_regex_cache_instance_exit, tb_null, tb_null);
+}
+
+/* take the compiled regex of the given pattern and mode out from the cache
+ *
+ * it will compile a new regex if not found, and we need put it back by tb_regex_cache_put() after using it.
+ */
+static tb_regex_cache_entry_t* tb_regex_cache_get(tb_char_t const* pattern, tb_size_t mode)
+{
+    // check
+    tb_assert_and_check_return_val(pattern, tb_null);
+
+    // find the idle regex
+    tb_size_t               size = tb_strlen(pattern);
+    tb_regex_cache_t*       cache = tb_regex_cache();
+    tb_regex_cache_entry_t* entry = tb_null;
+    if (cache)
+    {
+        // enter
+        tb_spinlock_enter(&cache->lock);
+
+        // find it from the recently used entries
+        tb_list_entry_ref_t item = tb_list_entry_head(&cache->lru);
+        tb_list_entry_ref_t tail = tb_list_entry_tail(&cache->lru);
+        for (; item != tail; item = tb_list_entry_next(item))
+        {
+            tb_regex_cache_entry_t* cached = (tb_regex_cache_entry_t*)tb_list_entry(&cache->lru, item);
+            if (cached->mode == mode && cached->size == size && !tb_strcmp(cached->pattern, pattern))
+            {
+                // take it out
+                tb_list_entry_remove(&cache->lru, item);
+                entry = cached;
+                break;
+            }
+        }
+
+        // leave
+        tb_spinlock_leave(&cache->lock);
+    }
+
+    // not found? compile a new regex
+    if (!entry)
+    {
+        // make entry
+        entry = (tb_regex_cache_entry_t*)tb_malloc0(sizeof(tb_regex_cache_entry_t) + size + 1);
+        tb_assert_and_check_return_val(entry, tb_null);
+
+        // init pattern
+        entry->mode     = mode;
+        entry->size     = size;
+        entry->pattern  = (tb_char_t const*)(entry + 1);
+        tb_memcpy((tb_char_t*)entry->pattern, pattern, size + 1);
+
+        // init regex
+        entry->regex = tb_regex_init(pattern, mode);
+        if (!entry->regex)
+        {
+            tb_regex_cache_entry_exit(entry);
+            entry = tb_null;
+        }
+
+        // trace
+        tb_trace_d("cache: compile %s, mode: %lu, %s", pattern, mode, entry? "ok" : "failed");
+    }
+
+    // ok?
+    return entry;
+}
+
+// put the compiled regex back to the cache
+static tb_void_t tb_regex_cache_put(tb_regex_cache_entry_t* entry)
+{
+    // check
+    tb_assert_and_check_return(entry);
+
+    // put it back and remove the least recently used regex if full
+    tb_regex_cache_t*       cache = tb_regex_cache();
+    tb_regex_cache_entry_t* removed = entry;
+    if (cache)
+    {
+        // enter
+        tb_spinlock_enter(&cache->lock);
+
+        // insert it to the lru list head
+        tb_list_entry_insert_head(&cache->lru, &entry->entry);
+        removed = tb_null;
+
+        // full? remove the last entry
+        if (tb_list_entry_size(&cache->lru) > TB_REGEX_CACHE_MAXN)
+        {
+            tb_list_entry_ref_t last = tb_list_entry_last(&cache->lru);
+            tb_list_entry_remove_last(&cache->lru);
+            removed = (tb_regex_cache_entry_t*)tb_list_entry(&cache->lru, last);
+        }
+
+        // leave
+        tb_spinlock_leave(&cache->lock);
+    }
+
+    // exit the removed regex outside the lock
+    if (removed) tb_regex_cache_entry_exit(removed);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
 tb_long_t tb_regex_match_cstr(tb_regex_ref_t regex, tb_char_t const* cstr, tb_size_t start, tb_size_t* plength, tb_vector_ref_t* presults)
 {
     // check
@@ -79,6 +318,62 @@ tb_vector_ref_t tb_regex_match_simple(tb_regex_ref_t regex, tb_char_t const* cst
     tb_vector_ref_t results = tb_null;
     return tb_regex_match(regex, cstr, tb_strlen(cstr), 0, tb_null, &results) >= 0? results : tb_null;
 }
+tb_size_t tb_regex_match_all(tb_regex_ref_t self, tb_char_t const* cstr, tb_size_t size, tb_size_t start, tb_regex_match_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_regex_t* regex = (tb_regex_t*)self;
+    tb_assert_and_check_return_val(regex && cstr && func, 0);
+
+    // done
+    tb_size_t           matched = 0;
+    tb_regex_match_t    matches_stack[TB_REGEX_MATCHES_STACK_MAXN];
+    tb_regex_match_t*   matches = matches_stack;
+    tb_size_t           matches_maxn = tb_arrayn(matches_stack);
+    while (start < size)
+    {
+        // match it
+        tb_long_t count = tb_regex_exec(regex, cstr, size, start);
+        tb_check_break(count > 0);
+
+        // grow matches if the stack matches is not enough
+        if ((tb_size_t)count > matches_maxn)
+        {
+            matches_maxn = (tb_size_t)count;
+            matches = (tb_regex_match_t*)(matches == matches_stack? tb_malloc(matches_maxn * sizeof(tb_regex_match_t)) : tb_ralloc(matches, matches_maxn * sizeof(tb_regex_match_t)));
+            tb_assert_and_check_break(matches);
+        }
+
+        // get the matched substrings, the unmatched substring will be an empty string at the match start
+        tb_size_t i = 0;
+        tb_size_t offset = 0;
+        tb_size_t length = 0;
+        for (i = 0; i < (tb_size_t)count; i++)
+        {
+            if (!tb_regex_exec_substr(regex, start, i, &offset, &length))
+            {
+                offset = matches[0].start;
+                length = 0;
+            }
+            matches[i].cstr     = cstr + offset;
+            matches[i].size     = length;
+            matches[i].start    = offset;
+        }
+        tb_assert_and_check_break(i && matches[0].start + matches[0].size <= size);
+
+        // the next start position, skip one character for the empty match
+        start = matches[0].size? matches[0].start + matches[0].size : matches[0].start + 1;
+
+        // done func
+        matched++;
+        if (!func(matches, (tb_size_t)count, priv)) break;
+    }
+
+    // exit matches
+    if (matches && matches != matches_stack) tb_free(matches);
+
+    // ok
+    return matched;
+}
 tb_char_t const* tb_regex_replace_cstr(tb_regex_ref_t regex, tb_char_t const* cstr, tb_size_t start, tb_char_t const* replace_cstr, tb_size_t* plength)
 {
     // check
@@ -100,17 +395,17 @@ tb_long_t tb_regex_match_done(tb_char_t const* pattern, tb_size_t mode, tb_char_
     // clear results first
     if (presults) *presults = tb_null;
 
-    // init regex
-    tb_long_t ok = -1;
-    tb_regex_ref_t regex = tb_regex_init(pattern, mode);
-    if (regex)
+    // get the compiled regex from the cache
+    tb_long_t               ok = -1;
+    tb_regex_cache_entry_t* entry = tb_regex_cache_get(pattern, mode);
+    if (entry)
     {
         // init results
-        tb_vector_ref_t results = tb_vector_init(16, tb_element_mem(sizeof(tb_regex_match_t), tb_regex_match_exit, tb_null));
-        if (results)
+        tb_vector_ref_t results = presults? tb_vector_init(16, tb_element_mem(sizeof(tb_regex_match_t), tb_regex_match_exit, tb_null)) : tb_null;
+        if (results || !presults)
         {
             // match regex
-            ok = tb_regex_match(regex, cstr, size, start, plength, &results);
+            ok = tb_regex_match(entry->regex, cstr, size, start, plength, presults? &results : tb_null);
 
             // ok?
             if (ok >= 0)
@@ -128,8 +423,8 @@ tb_long_t tb_regex_match_done(tb_char_t const* pattern, tb_size_t mode, tb_char_
             results = tb_null;
         }
 
-        // exit regex
-        tb_regex_exit(regex);
+        // put it back to the cache
+        tb_regex_cache_put(entry);
     }
 
     // ok?
@@ -152,19 +447,36 @@ tb_vector_ref_t tb_regex_match_done_simple(tb_char_t const* pattern, tb_size_t m
     tb_vector_ref_t results = tb_null;
     return tb_regex_match_done(pattern, mode, cstr, tb_strlen(cstr), 0, tb_null, &results) >= 0? results : tb_null;
 }
+tb_size_t tb_regex_match_all_done(tb_char_t const* pattern, tb_size_t mode, tb_char_t const* cstr, tb_size_t size, tb_size_t start, tb_regex_match_func_t func, tb_cpointer_t priv)
+{
+    // get the compiled regex from the cache
+    tb_size_t               matched = 0;
+    tb_regex_cache_entry_t* entry = tb_regex_cache_get(pattern, mode);
+    if (entry)
+    {
+        // match all
+        matched = tb_regex_match_all(entry->regex, cstr, size, start, func, priv);
+
+        // put it back to the cache
+        tb_regex_cache_put(entry);
+    }
+
+    // ok?
+    return matched;
+}
 tb_char_t const* tb_regex_replace_done(tb_char_t const* pattern, tb_size_t mode, tb_char_t const* cstr, tb_size_t size, tb_size_t start, tb_char_t const* replace_cstr, tb_size_t replace_size, tb_size_t* plength)
 {
     // clear length first
     if (plength) *plength = 0;
 
-    // init regex
-    tb_char_t*      result = tb_null;
-    tb_regex_ref_t  regex = tb_regex_init(pattern, mode);
-    if (regex)
+    // get the compiled regex from the cache
+    tb_char_t*              result = tb_null;
+    tb_regex_cache_entry_t* entry = tb_regex_cache_get(pattern, mode);
+    if (entry)
     {
         // replace regex
         tb_size_t           result_size = 0;
-        tb_char_t const*    result_cstr = tb_regex_replace(regex, cstr, size, start, replace_cstr, replace_size, &result_size);
+        tb_char_t const*    result_cstr = tb_regex_replace(entry->regex, cstr, size, start, replace_cstr, replace_size, &result_size);
         if (result_cstr && result_size)
         {
             // save result
@@ -176,8 +488,8 @@ tb_char_t const* tb_regex_replace_done(tb_char_t const* pattern, tb_size_t mode,
             }
         }
 
-        // exit regex
-        tb_regex_exit(regex);
+        // put it back to the cache
+        tb_regex_cache_put(entry);
     }
 
     // ok?
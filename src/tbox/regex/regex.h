@@ -62,6 +62,17 @@ typedef enum __tb_regex_mode_e
 
 }tb_regex_mode_e;
 
+/*! the regex match func type
+ *
+ * @param matches       the matched substrings, the whole matched string is the first one,
+ *                      @note their c-strings point into the matched data directly and are not null-terminated
+ * @param count         the matched substring count
+ * @param priv          the user private data
+ *
+ * @return              tb_true: continue, tb_false: break
+ */
+typedef tb_bool_t       (*tb_regex_match_func_t)(tb_regex_match_ref_t matches, tb_size_t count, tb_cpointer_t priv);
+
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -188,6 +199,37 @@ tb_long_t               tb_regex_match_cstr(tb_regex_ref_t regex, tb_char_t cons
  */
 tb_vector_ref_t         tb_regex_match_simple(tb_regex_ref_t regex, tb_char_t const* cstr);
 
+/*! match all of the given c-string and size by regex
+ *
+ * it will call the given func for each match and not allocate any results,
+ * so it's faster than calling tb_regex_match() in a loop.
+ *
+ * @code
+
+    static tb_bool_t tb_demo_regex_match_func(tb_regex_match_ref_t matches, tb_size_t count, tb_cpointer_t priv)
+    {
+        // trace, results: "hello", "world"
+        tb_trace_i("start: %lu, size: %lu, data: %.*s", matches[0].start, matches[0].size, (tb_int_t)matches[0].size, matches[0].cstr);
+
+        // continue
+        return tb_true;
+    }
+
+    tb_regex_match_all(regex, "hello world", 11, 0, tb_demo_regex_match_func, tb_null);
+
+ * @endcode
+ *
+ * @param regex         the regex
+ * @param cstr          the c-string data
+ * @param size          the c-string size
+ * @param start         the start position
+ * @param func          the match func
+ * @param priv          the user private data
+ *
+ * @return              the matched count
+ */
+tb_size_t               tb_regex_match_all(tb_regex_ref_t regex, tb_char_t const* cstr, tb_size_t size, tb_size_t start, tb_regex_match_func_t func, tb_cpointer_t priv);
+
 /*! replace the given c-string and size by regex
  *
  * @param regex         the regex
@@ -247,6 +289,9 @@ tb_char_t const*        tb_regex_replace_cstr(tb_regex_ref_t regex, tb_char_t co
 tb_char_t const*        tb_regex_replace_simple(tb_regex_ref_t regex, tb_char_t const* cstr, tb_char_t const* replace_cstr);
 
 /*! match the given c-string and size by the given regex pattern
+ *
+ * the compiled regex of the pattern and mode will be cached (lru),
+ * so it's cheap to call it in a loop with the same patterns.
  *
  * @param pattern       the regex pattern
  * @param mode          the regex mode, uses the default mode if be zero
@@ -352,6 +397,20 @@ tb_long_t               tb_regex_match_done_cstr(tb_char_t const* pattern, tb_si
  */
 tb_vector_ref_t         tb_regex_match_done_simple(tb_char_t const* pattern, tb_size_t mode, tb_char_t const* cstr);
 
+/*! match all of the given c-string and size by the given regex pattern
+ *
+ * @param pattern       the regex pattern
+ * @param mode          the regex mode, uses the default mode if be zero
+ * @param cstr          the c-string data
+ * @param size          the c-string size
+ * @param start         the start position
+ * @param func          the match func
+ * @param priv          the user private data
+ *
+ * @return              the matched count
+ */
+tb_size_t               tb_regex_match_all_done(tb_char_t const* pattern, tb_size_t mode, tb_char_t const* cstr, tb_size_t size, tb_size_t start, tb_regex_match_func_t func, tb_cpointer_t priv);
+
 /*! replace the given c-string and size by the given regex pattern 
  *
  * @param pattern       the regex pattern
@@ -79,6 +79,9 @@ typedef __tb_typeref__(filter);
  */
 
 /*! init filter from zip
+ *
+ * the action TB_ZIP_ACTION_DEFLATE_PARALLEL will compress the independent blocks on the thread pool,
+ * and output a valid zlib or gzip stream, it's faster for the large data on the multi-core machine.
  *
  * @param algo          the zip algorithm
  * @param action        the zip action
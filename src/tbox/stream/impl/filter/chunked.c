@@ -48,6 +48,9 @@ typedef struct __tb_filter_chunked_t
     // the cache line
     tb_string_t                 line;
 
+    // the last chunk has been parsed?
+    tb_bool_t                   bend;
+
 }tb_filter_chunked_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -80,6 +83,13 @@ static tb_long_t tb_filter_chunked_spak(tb_filter_t* filter, tb_static_stream_re
     // trace
     tb_trace_d("[%p]: isize: %lu, beof: %d", cfilter, tb_static_stream_size(istream), filter->beof);
 
+    // the last chunk has been parsed? discard the left data, e.g. the trailer and the next response
+    if (cfilter->bend)
+    {
+        tb_static_stream_goto(istream, (tb_byte_t*)ie);
+        return 0;
+    }
+
     // find the eof: '\r\n 0\r\n\r\n'
     if (    !filter->beof
         &&  ip + 6 < ie
@@ -164,9 +174,11 @@ static tb_long_t tb_filter_chunked_spak(tb_filter_t* filter, tb_static_stream_re
 
                         // is eof
                         filter->beof = tb_true;
+                        cfilter->bend = tb_true;
 
-                        // continue to spak the end data 
-                        continue ;
+                        // discard the left data
+                        ip = ie;
+                        break;
                     }
 
                     // ok
@@ -214,6 +226,9 @@ static tb_void_t tb_filter_chunked_clos(tb_filter_t* filter)
     // clear read
     cfilter->read = 0;
 
+    // clear end
+    cfilter->bend = tb_false;
+
     // clear line
     tb_string_clear(&cfilter->line);
 }
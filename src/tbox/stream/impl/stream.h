@@ -109,6 +109,13 @@ typedef struct __tb_stream_t
     // kill
     tb_void_t           (*kill)(tb_stream_ref_t stream);
 
+    /* peek the mapped data at the current position, optional
+     *
+     * it returns the left mapped data and size if the stream data has been mapped to the memory,
+     * so we can need and read it directly without copying it to the cache.
+     */
+    tb_byte_t*          (*peek)(tb_stream_ref_t stream, tb_size_t* psize);
+
 }tb_stream_t;
 
 
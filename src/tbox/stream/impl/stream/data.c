@@ -23,6 +23,7 @@
  * includes
  */
 #include "prefix.h"
+#include "../stream.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -94,6 +95,18 @@ static tb_void_t tb_stream_data_exit(tb_stream_ref_t stream)
     stream_data->data = tb_null;
     stream_data->size = 0;
 }
+static tb_byte_t* tb_stream_data_peek(tb_stream_ref_t stream, tb_size_t* psize)
+{
+    // check
+    tb_stream_data_t* stream_data = tb_stream_data_cast(stream);
+    tb_assert_and_check_return_val(stream_data && stream_data->data && stream_data->head, tb_null);
+
+    // save the left size
+    if (psize) *psize = stream_data->data + stream_data->size - stream_data->head;
+
+    // ok
+    return stream_data->head;
+}
 static tb_long_t tb_stream_data_read(tb_stream_ref_t stream, tb_byte_t* data, tb_size_t size)
 {
     // check
@@ -257,19 +270,27 @@ static tb_bool_t tb_stream_data_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
  */
 tb_stream_ref_t tb_stream_init_data()
 {
-    return tb_stream_init(  TB_STREAM_TYPE_DATA
-                        ,   sizeof(tb_stream_data_t)
-                        ,   0
-                        ,   tb_stream_data_open
-                        ,   tb_stream_data_clos
-                        ,   tb_stream_data_exit
-                        ,   tb_stream_data_ctrl
-                        ,   tb_stream_data_wait
-                        ,   tb_stream_data_read
-                        ,   tb_stream_data_writ
-                        ,   tb_stream_data_seek
-                        ,   tb_null
-                        ,   tb_null);
+    // init stream
+    tb_stream_ref_t stream = tb_stream_init(    TB_STREAM_TYPE_DATA
+                                            ,   sizeof(tb_stream_data_t)
+                                            ,   0
+                                            ,   tb_stream_data_open
+                                            ,   tb_stream_data_clos
+                                            ,   tb_stream_data_exit
+                                            ,   tb_stream_data_ctrl
+                                            ,   tb_stream_data_wait
+                                            ,   tb_stream_data_read
+                                            ,   tb_stream_data_writ
+                                            ,   tb_stream_data_seek
+                                            ,   tb_null
+                                            ,   tb_null);
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // the data has been in memory, we can need and read it directly without copying it to the cache
+    tb_stream_cast(stream)->peek = tb_stream_data_peek;
+
+    // ok
+    return stream;
 }
 tb_stream_ref_t tb_stream_init_from_data(tb_byte_t const* data, tb_size_t size)
 {
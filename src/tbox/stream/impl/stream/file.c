@@ -19,10 +19,21 @@
  *
  */
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "stream_file"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
 #include "prefix.h"
+#include "../stream.h"
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+#   include <errno.h>
+#   include <sys/mman.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -31,6 +42,24 @@
 // the file cache maxn
 #define TB_STREAM_FILE_CACHE_MAXN             TB_FILE_DIRECT_CSIZE
 
+// the file mmap maxn, we cannot map the too large file for the 32-bits address space
+#if TB_CPU_BIT64
+#   define TB_STREAM_FILE_MMAP_MAXN         ((tb_hize_t)1 << 40)
+#else
+#   define TB_STREAM_FILE_MMAP_MAXN         ((tb_hize_t)1 << 28)
+#endif
+
+/* the reserved head size before the mapped data
+ *
+ * the memory checker of tb_memcpy(), tb_memcmp(), ... will read the data head before the given address in debug mode,
+ * so we reserve a readable page before the mapped data.
+ */
+#ifdef __tb_debug__
+#   define TB_STREAM_FILE_MMAP_HEAD         tb_page_size()
+#else
+#   define TB_STREAM_FILE_MMAP_HEAD         (0)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -50,6 +79,18 @@ typedef struct __tb_stream_file_t
     // is stream file?
     tb_bool_t           bstream;
 
+    // map the file data to the memory?
+    tb_bool_t           bmmap;
+
+    // the mapped data
+    tb_byte_t*          data;
+
+    // the mapped size
+    tb_size_t           size;
+
+    // the read offset of the mapped data
+    tb_size_t           head;
+
 }tb_stream_file_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -63,6 +104,85 @@ static __tb_inline__ tb_stream_file_t* tb_stream_file_cast(tb_stream_ref_t strea
     // ok?
     return (tb_stream_file_t*)stream;
 }
+static tb_void_t tb_stream_file_mmap(tb_stream_file_t* stream_file)
+{
+    // check
+    tb_assert_and_check_return(stream_file && stream_file->file && !stream_file->data);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    // only for the readonly and seekable file
+    tb_check_return(stream_file->bmmap && !stream_file->bstream);
+    tb_check_return(!(stream_file->mode & (TB_FILE_MODE_WO | TB_FILE_MODE_RW)));
+
+    // the file size, cannot map the empty or too large file
+    tb_hize_t size = tb_file_size(stream_file->file);
+    tb_check_return(size && size <= TB_STREAM_FILE_MMAP_MAXN);
+
+    /* map the file data
+     *
+     * we use the private writable mapping, 
+     * because the data returned by tb_stream_need() may be modified by the user.
+     * it's copy-on-write and the file will be not modified.
+     */
+    tb_size_t       head = TB_STREAM_FILE_MMAP_HEAD;
+    tb_byte_t*      base = tb_null;
+    tb_pointer_t    data = MAP_FAILED;
+    if (head)
+    {
+        // reserve the head page
+        base = (tb_byte_t*)mmap(tb_null, head + (size_t)size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base != (tb_byte_t*)MAP_FAILED)
+        {
+            // map the file data after the head page
+            data = mmap(base + head, (size_t)size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, tb_file2fd(stream_file->file), 0);
+            if (data == MAP_FAILED) munmap(base, head + (size_t)size);
+        }
+    }
+    else data = mmap(tb_null, (size_t)size, PROT_READ | PROT_WRITE, MAP_PRIVATE, tb_file2fd(stream_file->file), 0);
+
+    // ok?
+    if (data != MAP_FAILED)
+    {
+        stream_file->data = (tb_byte_t*)data;
+        stream_file->size = (tb_size_t)size;
+        stream_file->head = 0;
+    }
+    // failed? we will read it from the file directly
+    else tb_trace_d("mmap %llu bytes failed, errno: %d", size, errno);
+#endif
+}
+static tb_void_t tb_stream_file_munmap(tb_stream_file_t* stream_file)
+{
+    // check
+    tb_assert_and_check_return(stream_file);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    // unmap the file data
+    if (stream_file->data)
+    {
+        tb_size_t head = TB_STREAM_FILE_MMAP_HEAD;
+        munmap(stream_file->data - head, head + stream_file->size);
+    }
+#endif
+    stream_file->data = tb_null;
+    stream_file->size = 0;
+    stream_file->head = 0;
+}
+static tb_byte_t* tb_stream_file_peek(tb_stream_ref_t stream, tb_size_t* psize)
+{
+    // check
+    tb_stream_file_t* stream_file = tb_stream_file_cast(stream);
+    tb_assert_and_check_return_val(stream_file, tb_null);
+
+    // not mapped?
+    tb_check_return_val(stream_file->data, tb_null);
+
+    // save the left size
+    if (psize) *psize = stream_file->size - stream_file->head;
+
+    // ok
+    return stream_file->data + stream_file->head;
+}
 static tb_bool_t tb_stream_file_open(tb_stream_ref_t stream)
 {
     // check
@@ -87,6 +207,9 @@ static tb_bool_t tb_stream_file_open(tb_stream_ref_t stream)
         return tb_false;
     }
 
+    // try to map the file data
+    tb_stream_file_mmap(stream_file);
+
     // ok
     return tb_true;
 }
@@ -96,6 +219,9 @@ static tb_bool_t tb_stream_file_clos(tb_stream_ref_t stream)
     tb_stream_file_t* stream_file = tb_stream_file_cast(stream);
     tb_assert_and_check_return_val(stream_file, tb_false);
 
+    // unmap the file data
+    tb_stream_file_munmap(stream_file);
+
     // exit file
     if (stream_file->file && !tb_file_exit(stream_file->file)) return tb_false;
     stream_file->file = tb_null;
@@ -113,8 +239,22 @@ static tb_long_t tb_stream_file_read(tb_stream_ref_t stream, tb_byte_t* data, tb
     tb_check_return_val(data, -1);
     tb_check_return_val(size, 0);
 
-    // read 
-    stream_file->read = tb_file_read(stream_file->file, data, size);
+    // read the mapped data
+    if (stream_file->data)
+    {
+        // the left size
+        tb_size_t left = stream_file->size - stream_file->head;
+        if (size > left) size = left;
+
+        // copy data
+        if (size) tb_memcpy(data, stream_file->data + stream_file->head, size);
+
+        // save head
+        stream_file->head += size;
+        stream_file->read = (tb_long_t)size;
+    }
+    // read it from file
+    else stream_file->read = tb_file_read(stream_file->file, data, size);
 
     // ok?
     return stream_file->read;
@@ -155,6 +295,13 @@ static tb_bool_t tb_stream_file_seek(tb_stream_ref_t stream, tb_hize_t offset)
     // is stream file?
     tb_check_return_val(!stream_file->bstream, tb_false);
 
+    // seek the mapped data
+    if (stream_file->data)
+    {
+        stream_file->head = (tb_size_t)tb_min(offset, stream_file->size);
+        return stream_file->head == offset;
+    }
+
     // seek
     return (tb_file_seek(stream_file->file, offset, TB_FILE_SEEK_BEG) == offset)? tb_true : tb_false;
 }
@@ -225,6 +372,41 @@ static tb_bool_t tb_stream_file_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
             // is stream
             stream_file->bstream = (tb_bool_t)tb_va_arg(args, tb_bool_t);
 
+            // ok
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_FILE_SET_MMAP:
+        {
+            // check
+            tb_assert_and_check_return_val(tb_stream_is_closed(stream), tb_false);
+
+            // map file?
+            stream_file->bmmap = (tb_bool_t)tb_va_arg(args, tb_bool_t);
+
+            // ok
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_FILE_GET_MMAP:
+        {
+            // the pmmap
+            tb_bool_t* pmmap = (tb_bool_t*)tb_va_arg(args, tb_bool_t*);
+            tb_assert_and_check_return_val(pmmap, tb_false);
+
+            // has been mapped?
+            *pmmap = stream_file->data? tb_true : tb_false;
+
+            // ok
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_FILE_GET_FILE:
+        {
+            // the pfile
+            tb_file_ref_t* pfile = (tb_file_ref_t*)tb_va_arg(args, tb_file_ref_t*);
+            tb_assert_and_check_return_val(pfile, tb_false);
+
+            // get file
+            *pfile = stream_file->file;
+
             // ok
             return tb_true;
         }
@@ -263,6 +445,10 @@ tb_stream_ref_t tb_stream_init_file()
         stream_file->mode      = TB_FILE_MODE_RO;
         stream_file->bstream   = tb_false;
         stream_file->read      = 0;
+        stream_file->bmmap     = tb_false;
+
+        // init the peek function of the mapped data
+        tb_stream_cast(stream)->peek = tb_stream_file_peek;
     }
 
     // ok?
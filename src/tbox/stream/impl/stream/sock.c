@@ -54,6 +54,9 @@ typedef struct __tb_stream_sock_t
 #ifdef TB_SSL_ENABLE
     // the ssl 
     tb_ssl_ref_t            hssl;
+
+    // the ssl session to be resumed for the next handshake, not owner
+    tb_ssl_session_ref_t    session;
 #endif
 
     // the sock type
@@ -150,10 +153,21 @@ static tb_bool_t tb_stream_sock_open(tb_stream_ref_t stream)
     // exit sock first if not keep-alive
     if (!stream_sock->keep_alive && stream_sock->sock)
     {
+#ifdef TB_SSL_ENABLE
+        // close ssl first, it has been kept alive with the socket
+        if (stream_sock->hssl) tb_ssl_clos(stream_sock->hssl);
+#endif
+
+        // exit sock
         if (stream_sock->sock && !tb_socket_exit(stream_sock->sock)) return tb_false;
         stream_sock->sock = tb_null;
     }
 
+#ifdef TB_SSL_ENABLE
+    // reuse the kept-alive connection? the ssl has been opened too
+    tb_bool_t reused = stream_sock->sock? tb_true : tb_false;
+#endif
+
     // make sock
     if (!stream_sock->sock) stream_sock->sock = tb_socket_init(stream_sock->type, tb_ipaddr_family(addr));
     
@@ -219,7 +233,10 @@ static tb_bool_t tb_stream_sock_open(tb_stream_ref_t stream)
                         // init timeout
                         tb_ssl_set_timeout(stream_sock->hssl, tb_stream_timeout(stream));
 
-                        // open ssl
+                        // resume the given session for the new connection, it will be ignored if failed
+                        if (!reused && stream_sock->session) tb_ssl_set_session(stream_sock->hssl, stream_sock->session);
+
+                        // open ssl, it has been opened already if the connection is reused
                         if (!tb_ssl_open(stream_sock->hssl)) break;
 
                         // ok
@@ -228,7 +245,7 @@ static tb_bool_t tb_stream_sock_open(tb_stream_ref_t stream)
                     } while (0);
 
                     // trace
-                    tb_trace_d("sock(%p): ssl: %s", stream_sock->sock, ok? "ok" : "no");
+                    tb_trace_d("sock(%p): ssl: %s, reused: %d, resumed: %d", stream_sock->sock, ok? "ok" : "no", reused, ok && tb_ssl_is_resumed(stream_sock->hssl));
             
                     // ssl failed? save state 
                     if (!ok) tb_stream_state_set(stream, stream_sock->hssl? tb_ssl_state(stream_sock->hssl) : TB_STATE_SOCK_SSL_FAILED);
@@ -396,15 +413,15 @@ static tb_bool_t tb_stream_sock_clos(tb_stream_ref_t stream)
     tb_stream_sock_t* stream_sock = tb_stream_sock_cast(stream);
     tb_assert_and_check_return_val(stream_sock, tb_false);
 
+    // keep alive? not close it, the ssl is kept alive with the socket too
+    tb_check_return_val(!stream_sock->keep_alive, tb_true);
+
 #ifdef TB_SSL_ENABLE
     // close ssl
     if (tb_url_ssl(tb_stream_url(stream)) && stream_sock->hssl)
         tb_ssl_clos(stream_sock->hssl);
 #endif
 
-    // keep alive? not close it
-    tb_check_return_val(!stream_sock->keep_alive, tb_true);
-
     // exit socket
     if (stream_sock->owner) 
     {
@@ -704,6 +721,36 @@ static tb_bool_t tb_stream_sock_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
             stream_sock->keep_alive = keep_alive? 1 : 0;
             return tb_true;
         }
+    case TB_STREAM_CTRL_SOCK_GET_SOCK:
+        {
+            tb_socket_ref_t* psock = (tb_socket_ref_t*)tb_va_arg(args, tb_socket_ref_t*);
+            tb_assert_and_check_return_val(psock, tb_false);
+            *psock = stream_sock->sock;
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_SOCK_SET_SSL_SESSION:
+        {
+            // the session, it will be used only for the next opening
+            tb_ssl_session_ref_t session = (tb_ssl_session_ref_t)tb_va_arg(args, tb_ssl_session_ref_t);
+#ifdef TB_SSL_ENABLE
+            stream_sock->session = session;
+#else
+            tb_used(session);
+#endif
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_SOCK_GET_SSL_SESSION:
+        {
+            tb_ssl_session_ref_t* psession = (tb_ssl_session_ref_t*)tb_va_arg(args, tb_ssl_session_ref_t*);
+            tb_assert_and_check_return_val(psession, tb_false);
+#ifdef TB_SSL_ENABLE
+            // get a new copy of the current session if the ssl has been opened
+            *psession = (stream_sock->hssl && tb_url_ssl(tb_stream_url(stream)))? tb_ssl_get_session(stream_sock->hssl) : tb_null;
+#else
+            *psession = tb_null;
+#endif
+            return tb_true;
+        }
     default:
         break;
     }
@@ -737,6 +784,9 @@ tb_stream_ref_t tb_stream_init_sock()
     {
         // init sock type
         stream_sock->type = TB_SOCKET_TYPE_TCP;
+
+        // mark as owner of socket, it will be made when opening
+        stream_sock->owner = 1;
     }
 
     // ok?
@@ -657,6 +657,24 @@ tb_bool_t tb_stream_clos(tb_stream_ref_t self)
     // ok
     return tb_true;
 }
+tb_byte_t const* tb_stream_peek(tb_stream_ref_t self, tb_size_t* size)
+{
+    // check 
+    tb_stream_t* stream = tb_stream_cast(self);
+    tb_assert_and_check_return_val(stream && size && tb_stream_is_opened(self), tb_null);
+
+    // not mapped?
+    tb_check_return_val(stream->peek, tb_null);
+
+    // have writed cache? sync first
+    if (stream->bwrited && !tb_queue_buffer_null(&stream->cache) && !tb_stream_sync(self, tb_false)) return tb_null;
+
+    // the cache must be empty, otherwise the mapped data is not at the current position
+    tb_check_return_val(tb_queue_buffer_null(&stream->cache), tb_null);
+
+    // peek it
+    return stream->peek(self, size);
+}
 tb_bool_t tb_stream_need(tb_stream_ref_t self, tb_byte_t** data, tb_size_t size)
 {
     // check 
@@ -678,6 +696,24 @@ tb_bool_t tb_stream_need(tb_stream_ref_t self, tb_byte_t** data, tb_size_t size)
     // check the cache mode, must be read cache
     tb_assert_and_check_return_val(!stream->bwrited, tb_false);
 
+    // the stream data has been mapped? need it from the mapped data directly
+    if (stream->peek && tb_queue_buffer_null(&stream->cache))
+    {
+        tb_size_t   left = 0;
+        tb_byte_t*  head = stream->peek(self, &left);
+        if (head)
+        {
+            // not enough?
+            tb_check_return_val(size <= left, tb_false);
+
+            // save data
+            *data = head;
+
+            // ok
+            return tb_true;
+        }
+    }
+
     // not enough? grow the cache first
     if (tb_queue_buffer_maxn(&stream->cache) < size) tb_queue_buffer_resize(&stream->cache, size);
 
@@ -762,7 +798,17 @@ tb_long_t tb_stream_read(tb_stream_ref_t self, tb_byte_t* data, tb_size_t size)
     tb_long_t read = 0;
     do
     {
-        if (tb_queue_buffer_maxn(&stream->cache))
+        // the stream data has been mapped and the cache is empty? read it directly
+        if (stream->peek && tb_queue_buffer_null(&stream->cache) && stream->peek(self, tb_null))
+        {
+            // switch to the read mode
+            stream->bwrited = 0;
+
+            // read it directly
+            read = stream->read(self, data, size);
+            tb_check_return_val(read >= 0, -1);
+        }
+        else if (tb_queue_buffer_maxn(&stream->cache))
         {
             // switch to the read cache mode
             if (stream->bwrited && tb_queue_buffer_null(&stream->cache)) stream->bwrited = 0;
@@ -1129,34 +1175,120 @@ tb_long_t tb_stream_bread_line(tb_stream_ref_t self, tb_char_t* data, tb_size_t
 {
     // check
     tb_stream_t* stream = tb_stream_cast(self);
-    tb_assert_and_check_return_val(stream, -1);
+    tb_assert_and_check_return_val(stream && data && size, -1);
+
+    // have writed cache? sync first
+    if (stream->bwrited && !tb_queue_buffer_null(&stream->cache) && !tb_stream_sync(self, tb_false)) return -1;
 
     // done
     tb_char_t   ch = 0;
     tb_char_t*  p = data;
-    while ((TB_STATE_OPENED == tb_atomic_get(&stream->istate)))
+    tb_char_t*  e = data + size - 1;
+    if (tb_queue_buffer_maxn(&stream->cache) && !(stream->peek && stream->peek(self, tb_null)))
     {
-        // read char
-        if (!tb_stream_bread_s8(self, (tb_sint8_t*)&ch)) break;
-
-        // is line?
-        if (ch == '\n') 
+        // switch to the read cache mode
+        if (stream->bwrited && tb_queue_buffer_null(&stream->cache)) stream->bwrited = 0;
+
+        // check the cache mode, must be read cache
+        tb_assert_and_check_return_val(!stream->bwrited, -1);
+
+        /* scan the cached data for the line end instead of reading it char by char,
+         * and the data after the line end is still left in the cache
+         */
+        tb_size_t   pull = 0;
+        tb_byte_t*  head = tb_null;
+        while ((TB_STATE_OPENED == tb_atomic_get(&stream->istate)))
         {
-            // finish line
-            if (p > data && p[-1] == '\r')
-                p--;
-            *p = '\0';
-    
-            // ok
-            return p - data;
+            // have the cached data?
+            head = tb_queue_buffer_pull_init(&stream->cache, &pull);
+            if (head && pull)
+            {
+                // find '\n'
+                tb_byte_t const*    lf = (tb_byte_t const*)tb_memmem(head, pull, "\n", 1);
+                tb_size_t           n = lf? (tb_size_t)(lf - head) : pull;
+
+                // find '\0', it will end the line too
+                tb_byte_t const*    nul = n? (tb_byte_t const*)tb_memmem(head, n, "", 1) : tb_null;
+                tb_size_t           z = nul? (tb_size_t)(nul - head) : n;
+
+                // append the line data, the overflowed data will be discarded
+                tb_size_t           copy = tb_min(z, (tb_size_t)(e - p));
+                if (copy) 
+                {
+                    tb_memcpy(p, head, copy);
+                    p += copy;
+                }
+
+                // skip the scanned data and the line end
+                tb_size_t           skip = (z < n || lf)? z + 1 : n;
+                tb_queue_buffer_pull_exit(&stream->cache, skip);
+                stream->offset += skip;
+
+                // line end?
+                if (z < n) break;
+                else if (lf)
+                {
+                    // finish line
+                    if (p > data && p[-1] == '\r')
+                        p--;
+                    *p = '\0';
+
+                    // ok
+                    return p - data;
+                }
+                continue;
+            }
+
+            // push data to cache from self
+            tb_size_t   push = 0;
+            tb_byte_t*  tail = tb_queue_buffer_push_init(&stream->cache, &push);
+            tb_assert_and_check_break(tail && push);
+            tb_long_t   real = stream->read(self, tail, push);
+
+            // ok?
+            if (real > 0) tb_queue_buffer_push_exit(&stream->cache, real);
+            // no data?
+            else if (!real)
+            {
+                // wait
+                real = stream->wait(self, TB_STREAM_WAIT_READ, tb_stream_timeout(self));
+
+                // ok?
+                tb_check_break(real > 0);
+            }
+            else break;
         }
-        // append char to line
-        else 
+
+        // killed? save state
+        if (!stream->state && (TB_STATE_KILLING == tb_atomic_get(&stream->istate)))
+            stream->state = TB_STATE_KILLED;
+    }
+    else
+    {
+        while ((TB_STATE_OPENED == tb_atomic_get(&stream->istate)))
         {
-            if ((p - data) < size - 1) *p++ = ch;
+            // read char
+            if (!tb_stream_bread_s8(self, (tb_sint8_t*)&ch)) break;
+
+            // is line?
+            if (ch == '\n') 
+            {
+                // finish line
+                if (p > data && p[-1] == '\r')
+                    p--;
+                *p = '\0';
+        
+                // ok
+                return p - data;
+            }
+            // append char to line
+            else 
+            {
+                if (p < e) *p++ = ch;
 
-            // line end?
-            if (!ch) break;
+                // line end?
+                if (!ch) break;
+            }
         }
     }
 
@@ -1164,7 +1296,7 @@ tb_long_t tb_stream_bread_line(tb_stream_ref_t self, tb_char_t* data, tb_size_t
     if ((TB_STATE_KILLING == tb_atomic_get(&stream->istate))) return -1;
 
     // end
-    if (p < data + size) *p = '\0';
+    *p = '\0';
 
     // ok?
     return !tb_stream_beof(self)? p - data : -1;
@@ -370,6 +370,9 @@ tb_stream_ref_t         tb_stream_init_from_http(tb_char_t const* host, tb_uint1
 tb_stream_ref_t         tb_stream_init_filter_from_null(tb_stream_ref_t stream);
 
 /*! init filter stream from zip
+ *
+ * the action TB_ZIP_ACTION_DEFLATE_PARALLEL will compress the independent blocks on the thread pool,
+ * and output a valid zlib or gzip stream, it's faster for the large data on the multi-core machine.
  *
  * @param stream        the stream
  * @param algo          the zip algorithm
@@ -660,6 +663,8 @@ tb_bool_t               tb_stream_bwrit(tb_stream_ref_t stream, tb_byte_t const*
 tb_bool_t               tb_stream_sync(tb_stream_ref_t stream, tb_bool_t bclosing);
 
 /*! need stream
+ *
+ * @note the data will be not copied to the cache if the file stream has been mapped by TB_STREAM_CTRL_FILE_SET_MMAP
  *
  * @code
  
@@ -680,6 +685,18 @@ tb_bool_t               tb_stream_sync(tb_stream_ref_t stream, tb_bool_t bclosin
  */
 tb_bool_t               tb_stream_need(tb_stream_ref_t stream, tb_byte_t** data, tb_size_t size);
 
+/*! peek the left mapped data at the current position without reading it
+ *
+ * only for the data stream and the file stream mapped by TB_STREAM_CTRL_FILE_SET_MMAP,
+ * we can parse the whole left data directly and skip the parsed size after it.
+ *
+ * @param stream        the stream
+ * @param size          the left size
+ *
+ * @return              the left data, tb_null if the stream data has not been mapped
+ */
+tb_byte_t const*        tb_stream_peek(tb_stream_ref_t stream, tb_size_t* size);
+
 /*! seek stream
  *
  * @param stream        the stream
@@ -34,6 +34,57 @@
 #include "../network/network.h"
 #include "../platform/platform.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum size of sending file data at once
+#define TB_TRANSFER_SENDF_MAXN              (1 << 24)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t tb_transfer_sendf_init(tb_stream_ref_t istream, tb_stream_ref_t ostream, tb_file_ref_t* pfile, tb_socket_ref_t* psock)
+{
+    // check
+    tb_assert_and_check_return_val(istream && ostream && pfile && psock, tb_false);
+
+    // only for transferring the seekable file to the tcp socket
+    tb_check_return_val(tb_stream_type(istream) == TB_STREAM_TYPE_FILE && tb_stream_type(ostream) == TB_STREAM_TYPE_SOCK, tb_false);
+    tb_check_return_val(tb_stream_size(istream) >= 0 && tb_stream_left(istream), tb_false);
+
+    // we cannot send the file data to the ssl socket directly
+    tb_check_return_val(!tb_url_ssl(tb_stream_url(ostream)), tb_false);
+
+    // is tcp socket?
+    tb_size_t type = TB_SOCKET_TYPE_NONE;
+    if (!tb_stream_ctrl(ostream, TB_STREAM_CTRL_SOCK_GET_TYPE, &type) || type != TB_SOCKET_TYPE_TCP) return tb_false;
+
+    // get the file and socket
+    tb_file_ref_t   file = tb_null;
+    tb_socket_ref_t sock = tb_null;
+    if (!tb_stream_ctrl(istream, TB_STREAM_CTRL_FILE_GET_FILE, &file) || !file) return tb_false;
+    if (!tb_stream_ctrl(ostream, TB_STREAM_CTRL_SOCK_GET_SOCK, &sock) || !sock) return tb_false;
+
+    // sync the cached data of ostream first
+    if (!tb_stream_sync(ostream, tb_false)) return tb_false;
+
+    // ok
+    *pfile = file;
+    *psock = sock;
+    return tb_true;
+}
+static tb_long_t tb_transfer_sendf(tb_stream_ref_t istream, tb_file_ref_t file, tb_socket_ref_t sock, tb_size_t size)
+{
+    // send the file data at the current offset, the cached data of istream will be skipped after seeking
+    tb_hize_t offset = tb_stream_offset(istream);
+    tb_hong_t real = tb_socket_sendf(sock, file, offset, size);
+    tb_check_return_val(real > 0, (tb_long_t)real);
+
+    // update the offset of istream
+    return tb_stream_seek(istream, offset + real)? (tb_long_t)real : -1;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -51,6 +102,14 @@ tb_hong_t tb_transfer(tb_stream_ref_t istream, tb_stream_ref_t ostream, tb_size_
     // done func
     if (func) func(TB_STATE_OK, tb_stream_offset(istream), tb_stream_size(istream), 0, 0, priv);
 
+    /* send the file data to the socket directly? 
+     *
+     * we need not copy data to the user buffer and it will use sendfile() or TransmitFile()
+     */
+    tb_file_ref_t   file = tb_null;
+    tb_socket_ref_t sock = tb_null;
+    tb_bool_t       sendf = tb_transfer_sendf_init(istream, ostream, &file, &sock);
+
     // writ data
     tb_byte_t data[TB_STREAM_BLOCK_MAXN];
     tb_hize_t writ = 0;
@@ -64,14 +123,15 @@ tb_hong_t tb_transfer(tb_stream_ref_t istream, tb_stream_ref_t ostream, tb_size_
     do
     {
         // the need
-        tb_size_t need = lrate? tb_min(lrate, TB_STREAM_BLOCK_MAXN) : TB_STREAM_BLOCK_MAXN;
+        tb_size_t need = lrate? tb_min(lrate, TB_STREAM_BLOCK_MAXN) : (sendf? TB_TRANSFER_SENDF_MAXN : TB_STREAM_BLOCK_MAXN);
+        if (sendf && need > left - writ) need = (tb_size_t)(left - writ);
 
-        // read data
-        tb_long_t real = tb_stream_read(istream, data, need);
+        // send the file data directly or read data
+        tb_long_t real = sendf? tb_transfer_sendf(istream, file, sock, need) : tb_stream_read(istream, data, need);
         if (real > 0)
         {
             // writ data
-            if (!tb_stream_bwrit(ostream, data, real)) break;
+            if (!sendf && !tb_stream_bwrit(ostream, data, real)) break;
 
             // save writ
             writ += real;
@@ -116,6 +176,15 @@ tb_hong_t tb_transfer(tb_stream_ref_t istream, tb_stream_ref_t ostream, tb_size_
                 if (delay) tb_msleep(delay);
             }
         }
+        else if (!real && sendf)
+        {
+            // wait
+            tb_long_t wait = tb_stream_wait(ostream, TB_STREAM_WAIT_WRIT, tb_stream_timeout(ostream));
+            tb_check_break(wait > 0);
+
+            // has writ?
+            tb_assert_and_check_break(wait & TB_STREAM_WAIT_WRIT);
+        }
         else if (!real) 
         {
             // wait
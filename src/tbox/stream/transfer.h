@@ -54,6 +54,9 @@ typedef tb_bool_t   (*tb_transfer_func_t)(tb_size_t state, tb_hize_t offset, tb_
  */
 
 /*! transfer stream to stream
+ *
+ * @note it will send the file data to the socket directly by sendfile() 
+ * if the istream is a file stream and the ostream is a tcp stream without ssl
  *
  * @param istream   the istream
  * @param ostream   the ostream
@@ -85,8 +85,14 @@ typedef enum __tb_singleton_type_e
     /// the cookies type
 ,   TB_SINGLETON_TYPE_COOKIES               = 12
 
+    /// the regex cache type
+,   TB_SINGLETON_TYPE_REGEX_CACHE           = 13
+
+    /// the http connection pool type
+,   TB_SINGLETON_TYPE_HTTP_POOL             = 14
+
     /// the user defined type
-,   TB_SINGLETON_TYPE_USER                  = 13
+,   TB_SINGLETON_TYPE_USER                  = 15
 
 #endif
 
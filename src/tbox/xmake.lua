@@ -106,12 +106,13 @@ target("tbox")
 
     -- add the source files for the zip module
     if has_config("zip") then 
-        add_files("zip/**.c|gzip.c|zlib.c|zlibraw.c|lzsw.c")
+        add_files("zip/**.c|gzip.c|zlib.c|zlibraw.c|parallel.c|lzsw.c")
         add_files("stream/impl/filter/zip.c")
         if has_config("zlib") then 
             add_files("zip/gzip.c") 
             add_files("zip/zlib.c") 
             add_files("zip/zlibraw.c") 
+            add_files("zip/parallel.c") 
         end
     end
 
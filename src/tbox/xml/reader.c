@@ -42,6 +42,16 @@
 #   define TB_XML_READER_ATTRIBUTES_MAXN        (128)
 #endif
 
+/* the initial window size of the buffered data for the scanner
+ *
+ * the window will be grown if the current element or text is larger than it.
+ */
+#ifdef __tb_small__
+#   define TB_XML_READER_WINDOW_SIZE            (8 << 10)
+#else
+#   define TB_XML_READER_WINDOW_SIZE            (64 << 10)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -88,6 +98,21 @@ typedef struct __tb_xml_reader_impl_t
     // the attribute data
     tb_string_t             attribute_data;
 
+    // the current element data: <data>, it points to the element string or the buffered stream data
+    tb_char_t const*        element_data;
+
+    // the current element size
+    tb_size_t               element_size;
+
+    // the current text data, it points to the text string or the buffered stream data
+    tb_char_t const*        text_data;
+
+    // the current text size
+    tb_size_t               text_size;
+
+    // the window size of the buffered data for the scanner
+    tb_size_t               window;
+
     // the attributes
     tb_xml_attribute_t      attributes[TB_XML_READER_ATTRIBUTES_MAXN];
 
@@ -138,6 +163,305 @@ static tb_char_t const* tb_xml_reader_text_parse(tb_xml_reader_impl_t* reader)
     }
     return tb_null;
 }
+static tb_bool_t tb_xml_reader_element_parse_end(tb_xml_reader_impl_t* reader, tb_char_t end)
+{
+    // patch '>'
+    tb_string_chrcat(&reader->element, '>');
+
+    // seek to the end of the comment or cdata: -->, ]]>
+    tb_char_t ch = '\0';
+    tb_int_t n = 0;
+    while (tb_stream_bread_s8(reader->rstream, (tb_sint8_t*)&ch))
+    {
+        if (n == 2 && ch == '>') break;
+        else
+        {
+            // append it
+            tb_string_chrcat(&reader->element, ch);
+
+            if (ch == end) n++;
+            else n = 0;
+        }
+    }
+
+    // ok?
+    return ch != '\0';
+}
+static tb_char_t const* tb_xml_reader_string_copy(tb_string_ref_t string, tb_char_t const* data, tb_size_t size)
+{
+    // copy it
+    if (data && size) return tb_string_cstrncpy(string, data, size);
+
+    // clear it
+    tb_string_clear(string);
+    return tb_null;
+}
+static tb_void_t tb_xml_reader_document_done(tb_xml_reader_impl_t* impl)
+{
+    // update version & charset
+    tb_xml_node_ref_t attr = (tb_xml_node_ref_t)tb_xml_reader_attributes((tb_xml_reader_ref_t)impl); 
+    for (; attr; attr = attr->next)
+    {
+        if (!tb_string_cstricmp(&attr->name, "version")) tb_string_strcpy(&impl->version, &attr->data);
+        if (!tb_string_cstricmp(&attr->name, "encoding")) tb_string_strcpy(&impl->charset, &attr->data);
+    }
+
+    // transform stream => utf-8
+    if (tb_string_cstricmp(&impl->charset, "utf-8") && tb_string_cstricmp(&impl->charset, "utf8"))
+    {
+        // charset
+        tb_size_t charset = TB_CHARSET_TYPE_UTF8;
+        if (!tb_string_cstricmp(&impl->charset, "gb2312") || !tb_string_cstricmp(&impl->charset, "gbk")) 
+            charset = TB_CHARSET_TYPE_GB2312;
+        else tb_trace_e("the charset: %s is not supported", tb_string_cstr(&impl->charset));
+
+        // init transform stream
+        if (charset != TB_CHARSET_TYPE_UTF8)
+        {
+#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
+            // init the filter stream
+            if (!impl->fstream) impl->fstream = tb_stream_init_filter_from_charset(impl->istream, charset, TB_CHARSET_TYPE_UTF8);
+            else
+            {
+                // ctrl stream
+                if (!tb_stream_ctrl(impl->fstream, TB_STREAM_CTRL_FLTR_SET_STREAM, impl->istream)) return ;
+
+                // the filter
+                tb_filter_ref_t filter = tb_null;
+                if (!tb_stream_ctrl(impl->fstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter)) return ;
+                tb_assert_and_check_return(filter);
+
+                // ctrl filter
+                if (!tb_filter_ctrl(filter, TB_FILTER_CTRL_CHARSET_SET_FTYPE, charset)) return ;
+            }
+
+            // open the filter stream
+            if (impl->fstream && tb_stream_open(impl->fstream))
+                impl->rstream = impl->fstream;
+            tb_string_cstrcpy(&impl->charset, "utf-8");
+#else
+            // trace
+            tb_trace_e("unicode type is not supported, please enable charset module config if you want to use it!");
+#endif
+        }
+    }
+}
+static tb_void_t tb_xml_reader_element_done(tb_xml_reader_impl_t* impl)
+{
+    // the element
+    tb_char_t const*    element = impl->element_data;
+    tb_size_t           size = impl->element_size;
+    tb_assert_and_check_return(element);
+
+    // is document begin: <?xml version="..." charset=".." ?>
+    if (size > 4 && !tb_strnicmp(element, "?xml", 4))
+    {
+        // update event
+        impl->event = TB_XML_READER_EVENT_DOCUMENT;
+
+        // update version & charset
+        tb_xml_reader_document_done(impl);
+    }
+    // is document type: <!DOCTYPE ... >
+    else if (size > 8 && !tb_strnicmp(element, "!DOCTYPE", 8))
+    {
+        // update event
+        impl->event = TB_XML_READER_EVENT_DOCUMENT_TYPE;
+    }
+    // is element end: </name>
+    else if (size > 1 && element[0] == '/')
+    {
+        // check
+        tb_check_return(impl->level);
+
+        // update event
+        impl->event = TB_XML_READER_EVENT_ELEMENT_END;
+
+        // leave
+        impl->level--;
+    }
+    // is comment: <!-- text -->
+    else if (size >= 3 && !tb_strncmp(element, "!--", 3))
+    {
+        // update event
+        impl->event = TB_XML_READER_EVENT_COMMENT;
+    }
+    // is cdata: <![CDATA[ text ]]>
+    else if (size >= 8 && !tb_strnicmp(element, "![CDATA[", 8))
+    {
+        // update event
+        impl->event = TB_XML_READER_EVENT_CDATA;
+    }
+    // is empty element: <name/>
+    else if (size > 1 && element[size - 1] == '/')
+    {
+        // update event
+        impl->event = TB_XML_READER_EVENT_ELEMENT_EMPTY;
+    }
+    // is element begin: <name>
+    else
+    {
+        // update event
+        impl->event = TB_XML_READER_EVENT_ELEMENT_BEG;
+
+        // enter
+        impl->level++;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * scanner implementation
+ */
+
+/* load the buffered data at the current stream position
+ *
+ * the mapped data will be used directly, otherwise we need the given size data in the stream cache,
+ * and the data is still valid after skipping it until the next reading.
+ *
+ * @return              1: ok, 0: end, -1: the stream size is unknown, we cannot scan it
+ */
+static tb_long_t tb_xml_reader_scan_load(tb_xml_reader_impl_t* reader, tb_size_t size, tb_char_t const** pdata, tb_size_t* psize)
+{
+    // the stream data has been mapped? 
+    tb_size_t           left = 0;
+    tb_byte_t const*    data = tb_stream_peek(reader->rstream, &left);
+    if (data)
+    {
+        *pdata = (tb_char_t const*)data;
+        *psize = left;
+        return left? 1 : 0;
+    }
+
+    // the stream size must be known, otherwise we do not know how much data can be needed
+    tb_check_return_val(tb_stream_size(reader->rstream) > 0, -1);
+
+    // end?
+    tb_hize_t rest = tb_stream_left(reader->rstream);
+    tb_check_return_val(rest, 0);
+
+    // need the data to the stream cache
+    tb_byte_t* need = tb_null;
+    if (size > rest) size = (tb_size_t)rest;
+    if (!tb_stream_need(reader->rstream, &need, size) || !need) return 0;
+
+    // ok
+    *pdata = (tb_char_t const*)need;
+    *psize = size;
+    return 1;
+}
+
+/* find the needle from the given offset of the buffered data using tb_memmem() with the simd filter, and grow the window if not found
+ *
+ * @return              the found offset, -1: not found until the end
+ */
+static tb_long_t tb_xml_reader_scan_find(tb_xml_reader_impl_t* reader, tb_size_t from, tb_char_t const* needle, tb_size_t needle_size, tb_char_t const** pdata, tb_size_t* psize)
+{
+    // done
+    tb_char_t const*    data = *pdata;
+    tb_size_t           size = *psize;
+    while (1)
+    {
+        // find it
+        if (from + needle_size <= size)
+        {
+            tb_char_t const* p = (tb_char_t const*)tb_memmem(data + from, size - from, needle, needle_size);
+            if (p) return p - data;
+
+            // the needle maybe cross the window end
+            from = size - needle_size + 1;
+        }
+
+        // grow the window, and load more data 
+        tb_size_t window = tb_max(size, reader->window) << 1;
+        if (tb_xml_reader_scan_load(reader, window, &data, &size) <= 0 || size <= *psize) break;
+
+        // save the window
+        reader->window  = window;
+        *pdata          = data;
+        *psize          = size;
+    }
+
+    // not found
+    return -1;
+}
+static tb_size_t tb_xml_reader_scan_next(tb_xml_reader_impl_t* impl)
+{
+    // next
+    while (!impl->event)
+    {
+        // load the buffered data
+        tb_char_t const*    data = tb_null;
+        tb_size_t           size = 0;
+        if (tb_xml_reader_scan_load(impl, impl->window, &data, &size) <= 0) break;
+
+        // is element?
+        if (*data == '<') 
+        {
+            // find the element end
+            tb_long_t end = -1;
+            if (size >= 4 && !tb_strncmp(data, "<!--", 4))
+            {
+                // find the comment end: -->
+                end = tb_xml_reader_scan_find(impl, 2, "-->", 3, &data, &size);
+                if (end >= 0) end += 2;
+            }
+            else if (size >= 9 && !tb_strnicmp(data, "<![CDATA[", 9))
+            {
+                // find the cdata end: ]]>
+                end = tb_xml_reader_scan_find(impl, 9, "]]>", 3, &data, &size);
+                if (end >= 0) end += 2;
+            }
+            // find the element end: >
+            else end = tb_xml_reader_scan_find(impl, 1, ">", 1, &data, &size);
+            if (end < 0)
+            {
+                tb_assertf(0, "invalid element from %s", tb_url_cstr(tb_stream_url(impl->istream)));
+                break;
+            }
+
+            // save the element: <...>, the comment: <!-- ... -->, the cdata: <![CDATA[ ... ]]>
+            impl->element_data = data + 1;
+            impl->element_size = (tb_size_t)end - 1;
+
+            // skip it first, the charset stream maybe be switched after parsing the document element
+            if (!tb_stream_skip(impl->rstream, end + 1)) break;
+
+            // done element
+            tb_xml_reader_element_done(impl);
+        }
+        // is text: <> text </>
+        else if (*data)
+        {
+            // find the text end
+            tb_long_t end = tb_xml_reader_scan_find(impl, 1, "<", 1, &data, &size);
+            if (end < 0) 
+            {
+                // skip the left text without the next element
+                tb_stream_skip(impl->rstream, size);
+                break;
+            }
+
+            // save the text
+            impl->text_data = data;
+            impl->text_size = (tb_size_t)end;
+
+            // skip it
+            if (!tb_stream_skip(impl->rstream, end)) break;
+
+            // ignore the empty lines
+            if (!(end == 1 && data[0] == '\n') && !(end == 2 && data[0] == '\r' && data[1] == '\n'))
+                impl->event = TB_XML_READER_EVENT_TEXT;
+        }
+        else 
+        {
+            // skip the invalid character
+            if (!tb_stream_skip(impl->rstream, 1)) break;
+        }
+    }
+
+    // ok?
+    return impl->event;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -159,6 +483,9 @@ tb_xml_reader_ref_t tb_xml_reader_init()
     tb_string_cstrcpy(&reader->version, "2.0");
     tb_string_cstrcpy(&reader->charset, "utf-8");
 
+    // init window
+    reader->window = TB_XML_READER_WINDOW_SIZE;
+
     // init attributes
     tb_size_t i = 0;
     for (i = 0; i < TB_XML_READER_ATTRIBUTES_MAXN; i++)
@@ -259,6 +586,12 @@ tb_bool_t tb_xml_reader_open(tb_xml_reader_ref_t reader, tb_stream_ref_t stream,
         // clear attribute data
         tb_string_clear(&impl->attribute_data);
 
+        // clear element and text data
+        impl->element_data = tb_null;
+        impl->element_size = 0;
+        impl->text_data = tb_null;
+        impl->text_size = 0;
+
         // clear attributes
         tb_long_t i = 0;
         for (i = 0; i < TB_XML_READER_ATTRIBUTES_MAXN; i++)
@@ -314,6 +647,12 @@ tb_void_t tb_xml_reader_clos(tb_xml_reader_ref_t reader)
     // clear attribute data
     tb_string_clear(&impl->attribute_data);
 
+    // clear element and text data
+    impl->element_data = tb_null;
+    impl->element_size = 0;
+    impl->text_data = tb_null;
+    impl->text_size = 0;
+
     // clear attributes
     tb_long_t i = 0;
     for (i = 0; i < TB_XML_READER_ATTRIBUTES_MAXN; i++)
@@ -348,6 +687,15 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
     // reset event
     impl->event = TB_XML_READER_EVENT_NONE;
 
+    /* scan the buffered data directly if the stream data has been mapped or the stream size is known
+     *
+     * the element, text and attributes will point to the buffered data without copying them.
+     */
+    tb_char_t const*    data = tb_null;
+    tb_size_t           size = 0;
+    tb_long_t           ok = tb_xml_reader_scan_load(impl, impl->window, &data, &size);
+    if (ok >= 0) return ok? tb_xml_reader_scan_next(impl) : TB_XML_READER_EVENT_NONE;
+
     // next
     while (!impl->event)
     {
@@ -362,158 +710,26 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
             tb_char_t const* element = tb_xml_reader_element_parse(impl);
             tb_assert_and_check_break(element);
 
-            // is document begin: <?xml version="..." charset=".." ?>
+            // is comment or cdata without the end? seek to the comment end: --> or the cdata end: ]]>
             tb_size_t size = tb_string_size(&impl->element);
-            if (size > 4 && !tb_strnicmp(element, "?xml", 4))
+            if (size >= 3 && !tb_strncmp(element, "!--", 3))
             {
-                // update event
-                impl->event = TB_XML_READER_EVENT_DOCUMENT;
-
-                // update version & charset
-                tb_xml_node_ref_t attr = (tb_xml_node_ref_t)tb_xml_reader_attributes(reader); 
-                for (; attr; attr = attr->next)
-                {
-                    if (!tb_string_cstricmp(&attr->name, "version")) tb_string_strcpy(&impl->version, &attr->data);
-                    if (!tb_string_cstricmp(&attr->name, "encoding")) tb_string_strcpy(&impl->charset, &attr->data);
-                }
-
-                // transform stream => utf-8
-                if (tb_string_cstricmp(&impl->charset, "utf-8") && tb_string_cstricmp(&impl->charset, "utf8"))
-                {
-                    // charset
-                    tb_size_t charset = TB_CHARSET_TYPE_UTF8;
-                    if (!tb_string_cstricmp(&impl->charset, "gb2312") || !tb_string_cstricmp(&impl->charset, "gbk")) 
-                        charset = TB_CHARSET_TYPE_GB2312;
-                    else tb_trace_e("the charset: %s is not supported", tb_string_cstr(&impl->charset));
-
-                    // init transform stream
-                    if (charset != TB_CHARSET_TYPE_UTF8)
-                    {
-#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
-                        // init the filter stream
-                        if (!impl->fstream) impl->fstream = tb_stream_init_filter_from_charset(impl->istream, charset, TB_CHARSET_TYPE_UTF8);
-                        else
-                        {
-                            // ctrl stream
-                            if (!tb_stream_ctrl(impl->fstream, TB_STREAM_CTRL_FLTR_SET_STREAM, impl->istream)) break;
-
-                            // the filter
-                            tb_filter_ref_t filter = tb_null;
-                            if (!tb_stream_ctrl(impl->fstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter)) break;
-                            tb_assert_and_check_break(filter);
-
-                            // ctrl filter
-                            if (!tb_filter_ctrl(filter, TB_FILTER_CTRL_CHARSET_SET_FTYPE, charset)) break;
-                        }
-
-                        // open the filter stream
-                        if (impl->fstream && tb_stream_open(impl->fstream))
-                            impl->rstream = impl->fstream;
-                        tb_string_cstrcpy(&impl->charset, "utf-8");
-#else
-                        // trace
-                        tb_trace_e("unicode type is not supported, please enable charset module config if you want to use it!");
-#endif
-                    }
-                }
+                if ((element[size - 2] != '-' || element[size - 1] != '-') && !tb_xml_reader_element_parse_end(impl, '-')) continue;
             }
-            // is document type: <!DOCTYPE ... >
-            else if (size > 8 && !tb_strnicmp(element, "!DOCTYPE", 8))
-            {
-                // update event
-                impl->event = TB_XML_READER_EVENT_DOCUMENT_TYPE;
-            }
-            // is element end: </name>
-            else if (size > 1 && element[0] == '/')
-            {
-                // check
-                tb_check_break(impl->level);
-
-                // update event
-                impl->event = TB_XML_READER_EVENT_ELEMENT_END;
-
-                // leave
-                impl->level--;
-            }
-            // is comment: <!-- text -->
-            else if (size >= 3 && !tb_strncmp(element, "!--", 3))
-            {
-                // no comment end?
-                if (element[size - 2] != '-' || element[size - 1] != '-')
-                {
-                    // patch '>'
-                    tb_string_chrcat(&impl->element, '>');
-
-                    // seek to comment end
-                    tb_char_t ch = '\0';
-                    tb_int_t n = 0;
-                    while (tb_stream_bread_s8(impl->rstream, (tb_sint8_t*)&ch))
-                    {
-                        // -->
-                        if (n == 2 && ch == '>') break;
-                        else
-                        {
-                            // append it
-                            tb_string_chrcat(&impl->element, ch);
-
-                            if (ch == '-') n++;
-                            else n = 0;
-                        }
-                    }
-
-                    // update event
-                    if (ch != '\0') impl->event = TB_XML_READER_EVENT_COMMENT;
-                }
-                else impl->event = TB_XML_READER_EVENT_COMMENT;
-            }
-            // is cdata: <![CDATA[ text ]]>
             else if (size >= 8 && !tb_strnicmp(element, "![CDATA[", 8))
             {
-                if (element[size - 2] != ']' || element[size - 1] != ']')
-                {
-                    // patch '>'
-                    tb_string_chrcat(&impl->element, '>');
-
-                    // seek to cdata end
-                    tb_char_t ch = '\0';
-                    tb_int_t n = 0;
-                    while (tb_stream_bread_s8(impl->rstream, (tb_sint8_t*)&ch))
-                    {
-                        // ]]>
-                        if (n == 2 && ch == '>') break;
-                        else
-                        {
-                            // append it
-                            tb_string_chrcat(&impl->element, ch);
-
-                            if (ch == ']') n++;
-                            else n = 0;
-                        }
-                    }
-
-                    // update event
-                    if (ch != '\0') impl->event = TB_XML_READER_EVENT_CDATA;
-                }
-                else impl->event = TB_XML_READER_EVENT_CDATA;
-            }
-            // is empty element: <name/>
-            else if (size > 1 && element[size - 1] == '/')
-            {
-                // update event
-                impl->event = TB_XML_READER_EVENT_ELEMENT_EMPTY;
+                if ((element[size - 2] != ']' || element[size - 1] != ']') && !tb_xml_reader_element_parse_end(impl, ']')) continue;
             }
-            // is element begin: <name>
-            else
-            {
-                // update event
-                impl->event = TB_XML_READER_EVENT_ELEMENT_BEG;
 
-                // enter
-                impl->level++;
-            }
+            // save the element
+            impl->element_data = tb_string_cstr(&impl->element);
+            impl->element_size = tb_string_size(&impl->element);
+
+            // done element
+            tb_xml_reader_element_done(impl);
 
             // trace
-            tb_trace_d("<%s>", element);
+            tb_trace_d("<%s>", impl->element_data);
         }
         // is text: <> text </>
         else if (*pc)
@@ -521,7 +737,12 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
             // parse text: <> ... <>
             tb_char_t const* text = tb_xml_reader_text_parse(impl);
             if (text && tb_string_cstrcmp(&impl->text, "\r\n") && tb_string_cstrcmp(&impl->text, "\n"))
+            {
+                // save the text
+                impl->text_data = text;
+                impl->text_size = tb_string_size(&impl->text);
                 impl->event = TB_XML_READER_EVENT_TEXT;
+            }
 
             // trace
             tb_trace_d("%s", text);
@@ -793,132 +1014,202 @@ tb_char_t const* tb_xml_reader_charset(tb_xml_reader_ref_t reader)
     return tb_string_cstr(&impl->charset);
 }
 tb_char_t const* tb_xml_reader_comment(tb_xml_reader_ref_t reader)
+{
+    // the comment
+    tb_xml_reader_slice_t comment;
+    if (!tb_xml_reader_comment_slice(reader, &comment)) return tb_null;
+
+    // copy it
+    return tb_xml_reader_string_copy(&((tb_xml_reader_impl_t*)reader)->text, comment.data, comment.size);
+}
+tb_char_t const* tb_xml_reader_cdata(tb_xml_reader_ref_t reader)
+{
+    // the cdata
+    tb_xml_reader_slice_t cdata;
+    if (!tb_xml_reader_cdata_slice(reader, &cdata)) return tb_null;
+
+    // copy it
+    return tb_xml_reader_string_copy(&((tb_xml_reader_impl_t*)reader)->text, cdata.data, cdata.size);
+}
+tb_char_t const* tb_xml_reader_text(tb_xml_reader_ref_t reader)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_COMMENT, tb_null);
+    tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_TEXT, tb_null);
 
-    // init
-    tb_char_t const*    p = tb_string_cstr(&impl->element);
-    tb_size_t           n = tb_string_size(&impl->element);
-    tb_assert_and_check_return_val(p && n >= 6, tb_null);
+    // the text has been copied?
+    tb_char_t const* text = tb_string_cstr(&impl->text);
+    if (text && text == impl->text_data) return text;
 
-    // comment
-    tb_string_cstrncpy(&impl->text, p + 3, n - 5);
-    return tb_string_cstr(&impl->text);
+    // copy it
+    return tb_xml_reader_string_copy(&impl->text, impl->text_data, impl->text_size);
 }
-tb_char_t const* tb_xml_reader_cdata(tb_xml_reader_ref_t reader)
+tb_char_t const* tb_xml_reader_element(tb_xml_reader_ref_t reader)
+{
+    // the element name
+    tb_xml_reader_slice_t name;
+    if (!tb_xml_reader_element_slice(reader, &name)) return tb_null;
+
+    // copy it
+    return tb_xml_reader_string_copy(&((tb_xml_reader_impl_t*)reader)->element_name, name.data, name.size);
+}
+tb_char_t const* tb_xml_reader_doctype(tb_xml_reader_ref_t reader)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_CDATA, tb_null);
-
-    // init
-    tb_char_t const*    p = tb_string_cstr(&impl->element);
-    tb_size_t           n = tb_string_size(&impl->element);
-    tb_assert_and_check_return_val(p && n >= 11, tb_null);
+    tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_DOCUMENT_TYPE, tb_null);
+    tb_assert_and_check_return_val(impl->element_data && impl->element_size > 8, tb_null);
 
-    // comment
-    tb_string_cstrncpy(&impl->text, p + 8, n - 10);
-    return tb_string_cstr(&impl->text);
+    // skip !DOCTYPE
+    tb_size_t skip = tb_min(impl->element_size, 9);
+    return tb_xml_reader_string_copy(&impl->text, impl->element_data + skip, impl->element_size - skip);
 }
-tb_char_t const* tb_xml_reader_text(tb_xml_reader_ref_t reader)
+tb_xml_node_ref_t tb_xml_reader_attributes(tb_xml_reader_ref_t reader)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_TEXT, tb_null);
+    tb_assert_and_check_return_val(impl, tb_null);
 
-    // text
-    return tb_string_cstr(&impl->text);
+    // build the attribute nodes
+    tb_size_t               n = 0;
+    tb_size_t               itor = 0;
+    tb_xml_reader_slice_t   name;
+    tb_xml_reader_slice_t   data;
+    while (n < TB_XML_READER_ATTRIBUTES_MAXN && tb_xml_reader_attribute_next(reader, &itor, &name, &data))
+    {
+        // ignore the empty attribute
+        tb_check_continue(name.size && data.size);
+
+        // node
+        tb_xml_node_ref_t prev = n > 0? (tb_xml_node_ref_t)&impl->attributes[n - 1] : tb_null;
+        tb_xml_node_ref_t node = (tb_xml_node_ref_t)&impl->attributes[n];
+
+        // init node
+        tb_string_cstrncpy(&node->name, name.data, name.size);
+        tb_string_cstrncpy(&node->data, data.data, data.size);
+
+        // append node
+        if (prev) prev->next = node;
+        node->next = tb_null;
+
+        // next
+        n++;
+    }
+
+    // ok?
+    return n? (tb_xml_node_ref_t)&impl->attributes[0] : tb_null;
 }
-tb_char_t const* tb_xml_reader_element(tb_xml_reader_ref_t reader)
+tb_bool_t tb_xml_reader_element_slice(tb_xml_reader_ref_t reader, tb_xml_reader_slice_t* name)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && ( impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_null);
+    tb_assert_and_check_return_val(impl && name && ( impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
+                                                    ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
+                                                    ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_false);
 
     // init
     tb_char_t const* p = tb_null;
-    tb_char_t const* b = tb_string_cstr(&impl->element);
-    tb_char_t const* e = b + tb_string_size(&impl->element);
-    tb_assert_and_check_return_val(b, tb_null);
+    tb_char_t const* b = impl->element_data;
+    tb_char_t const* e = b + impl->element_size;
+    tb_assert_and_check_return_val(b, tb_false);
 
     // </name> or <name ... />
     if (b < e && *b == '/') b++;
     for (p = b; p < e && *p && !tb_isspace(*p) && *p != '/'; p++) ;
+    tb_check_return_val(p > b, tb_false);
 
-    // ok?
-    return p > b? tb_string_cstrncpy(&impl->element_name, b, p - b) : tb_null;
+    // ok
+    name->data = b;
+    name->size = p - b;
+    return tb_true;
 }
-tb_char_t const* tb_xml_reader_doctype(tb_xml_reader_ref_t reader)
+tb_bool_t tb_xml_reader_text_slice(tb_xml_reader_ref_t reader, tb_xml_reader_slice_t* text)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_DOCUMENT_TYPE, tb_null);
-
-    // doctype
-    tb_char_t const* p = tb_string_cstr(&impl->element);
-    tb_assert_and_check_return_val(p, tb_null);
+    tb_assert_and_check_return_val(impl && text && impl->event == TB_XML_READER_EVENT_TEXT && impl->text_data, tb_false);
 
-    // skip !DOCTYPE
-    return (p + 9);
+    // ok
+    text->data = impl->text_data;
+    text->size = impl->text_size;
+    return tb_true;
 }
-tb_xml_node_ref_t tb_xml_reader_attributes(tb_xml_reader_ref_t reader)
+tb_bool_t tb_xml_reader_cdata_slice(tb_xml_reader_ref_t reader, tb_xml_reader_slice_t* cdata)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && ( impl->event == TB_XML_READER_EVENT_DOCUMENT
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_null);
-
-    // init
-    tb_char_t const* p = tb_string_cstr(&impl->element);
-    tb_char_t const* e = p + tb_string_size(&impl->element);
+    tb_assert_and_check_return_val(impl && cdata && impl->event == TB_XML_READER_EVENT_CDATA, tb_false);
 
-    // skip name
-    while (p < e && *p && !tb_isspace(*p)) p++;
-    while (p < e && *p && tb_isspace(*p)) p++;
+    // ![CDATA[ ... ]]
+    tb_assert_and_check_return_val(impl->element_data && impl->element_size >= 10, tb_false);
 
-    // parse attributes
-    tb_size_t n = 0;
-    while (p < e)
-    {
-        // parse name
-        tb_string_clear(&impl->attribute_name);
-        for (; p < e && *p != '='; p++) if (!tb_isspace(*p)) tb_string_chrcat(&impl->attribute_name, *p);
-        if (*p != '=') break;
-
-        // parse data
-        tb_string_clear(&impl->attribute_data);
-        for (p++; p < e && (*p != '\'' && *p != '\"'); p++) ;
-        if (*p != '\'' && *p != '\"') break;
-        for (p++; p < e && (*p != '\'' && *p != '\"'); p++) tb_string_chrcat(&impl->attribute_data, *p);
-        if (*p != '\'' && *p != '\"') break;
-        p++;
+    // ok
+    cdata->data = impl->element_data + 8;
+    cdata->size = impl->element_size - 10;
+    return tb_true;
+}
+tb_bool_t tb_xml_reader_comment_slice(tb_xml_reader_ref_t reader, tb_xml_reader_slice_t* comment)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && comment && impl->event == TB_XML_READER_EVENT_COMMENT, tb_false);
 
-        // append node
-        if (tb_string_cstr(&impl->attribute_name) && tb_string_cstr(&impl->attribute_data))
-        {
-            // node
-            tb_xml_node_ref_t prev = n > 0? (tb_xml_node_ref_t)&impl->attributes[n - 1] : tb_null;
-            tb_xml_node_ref_t node = (tb_xml_node_ref_t)&impl->attributes[n];
+    // !-- ... --
+    tb_assert_and_check_return_val(impl->element_data && impl->element_size >= 5, tb_false);
 
-            // init node
-            tb_string_strcpy(&node->name, &impl->attribute_name);
-            tb_string_strcpy(&node->data, &impl->attribute_data);
+    // ok
+    comment->data = impl->element_data + 3;
+    comment->size = impl->element_size - 5;
+    return tb_true;
+}
+tb_bool_t tb_xml_reader_attribute_next(tb_xml_reader_ref_t reader, tb_size_t* itor, tb_xml_reader_slice_t* name, tb_xml_reader_slice_t* data)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && itor && name && data && ( impl->event == TB_XML_READER_EVENT_DOCUMENT
+                                                                    ||  impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
+                                                                    ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
+                                                                    ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_false);
 
-            // append node
-            if (prev) prev->next = node;
-            node->next = tb_null;
+    // init
+    tb_char_t const* b = impl->element_data;
+    tb_char_t const* e = b + impl->element_size;
+    tb_char_t const* p = b + *itor;
+    tb_check_return_val(b && p < e, tb_false);
+
+    // the first attribute? skip name
+    if (!*itor) while (p < e && *p && !tb_isspace(*p)) p++;
+
+    // parse name
+    while (p < e && tb_isspace(*p)) p++;
+    name->data = p;
+    for (; p < e && *p != '='; p++) ;
+    if (p >= e) 
+    {
+        *itor = impl->element_size;
+        return tb_false;
+    }
+    name->size = p - name->data;
+    while (name->size && tb_isspace(name->data[name->size - 1])) name->size--;
 
-            // next
-            n++;
-        }
+    // parse data: "..." or '...'
+    for (p++; p < e && (*p != '\'' && *p != '\"'); p++) ;
+    if (p >= e) 
+    {
+        *itor = impl->element_size;
+        return tb_false;
     }
+    tb_char_t quote = *p++;
+    data->data = p;
+    for (; p < e && *p != quote; p++) ;
+    if (p >= e) 
+    {
+        *itor = impl->element_size;
+        return tb_false;
+    }
+    data->size = p - data->data;
 
-    // ok?
-    return n? (tb_xml_node_ref_t)&impl->attributes[0] : tb_null;
+    // save the next position
+    *itor = p + 1 - b;
+    return tb_true;
 }
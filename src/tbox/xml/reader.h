@@ -52,6 +52,21 @@ typedef enum __tb_xml_reader_event_t
 
 }tb_xml_reader_event_t;
 
+/*! the xml reader slice type
+ *
+ * it points to the buffered data of the reader and is not null-terminated,
+ * it's only valid until the next tb_xml_reader_next().
+ */
+typedef struct __tb_xml_reader_slice_t
+{
+    /// the data
+    tb_char_t const*            data;
+
+    /// the size
+    tb_size_t                   size;
+
+}tb_xml_reader_slice_t;
+
 /// the xml reader ref type
 typedef __tb_typeref__(xml_reader);
 
@@ -88,6 +103,10 @@ tb_bool_t               tb_xml_reader_open(tb_xml_reader_ref_t reader, tb_stream
 tb_void_t               tb_xml_reader_clos(tb_xml_reader_ref_t reader);
 
 /*! the next iterator for the xml reader
+ *
+ * if the stream data has been mapped (e.g. data stream) or the stream size is known (e.g. file stream),
+ * the reader will scan the buffered data directly instead of reading and copying it byte by byte,
+ * and we can get the element, text and attributes as the slices without copying them.
  *
  * @param reader        the xml reader
  * @return              the iterator event 
@@ -286,6 +305,63 @@ tb_char_t const*        tb_xml_reader_doctype(tb_xml_reader_ref_t reader);
  */
 tb_xml_node_ref_t       tb_xml_reader_attributes(tb_xml_reader_ref_t reader);
 
+/*! the current xml element name slice without copying it
+ *
+ * @param reader        the xml reader
+ * @param name          the element name slice
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_element_slice(tb_xml_reader_ref_t reader, tb_xml_reader_slice_t* name);
+
+/*! the current xml node text slice without copying it
+ *
+ * @param reader        the xml reader
+ * @param text          the text slice
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_text_slice(tb_xml_reader_ref_t reader, tb_xml_reader_slice_t* text);
+
+/*! the current xml node cdata slice without copying it
+ *
+ * @param reader        the xml reader
+ * @param cdata         the cdata slice
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_cdata_slice(tb_xml_reader_ref_t reader, tb_xml_reader_slice_t* cdata);
+
+/*! the current xml node comment slice without copying it
+ *
+ * @param reader        the xml reader
+ * @param comment       the comment slice
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_comment_slice(tb_xml_reader_ref_t reader, tb_xml_reader_slice_t* comment);
+
+/*! the next attribute slices of the current xml node, it will parse the attributes lazily and not build the attribute nodes
+ *
+ * @param reader        the xml reader
+ * @param itor          the attribute iterator, it must be initialized to zero for the first attribute
+ * @param name          the attribute name slice
+ * @param data          the attribute data slice
+ *
+ * @return              tb_true or tb_false if no more attributes
+ *
+ * @code
+    tb_size_t               itor = 0;
+    tb_xml_reader_slice_t   name;
+    tb_xml_reader_slice_t   data;
+    while (tb_xml_reader_attribute_next(reader, &itor, &name, &data))
+    {
+        tb_trace_i("%.*s = %.*s", (tb_int_t)name.size, name.data, (tb_int_t)data.size, data.data);
+    }
+ * @endcode
+ */
+tb_bool_t               tb_xml_reader_attribute_next(tb_xml_reader_ref_t reader, tb_size_t* itor, tb_xml_reader_slice_t* name, tb_xml_reader_slice_t* data);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
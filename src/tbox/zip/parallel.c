@@ -0,0 +1,640 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        parallel.c
+ * @ingroup     zip
+ *
+ */
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "zip_parallel"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "parallel.h"
+#include "../platform/platform.h"
+#include "../utils/bits.h"
+#include <zlib.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the block size
+#ifdef __tb_small__
+#   define TB_ZIP_PARALLEL_BLOCK_SIZE       (64 * 1024)
+#else
+#   define TB_ZIP_PARALLEL_BLOCK_SIZE       (128 * 1024)
+#endif
+
+// the dictionary size, the deflate window size
+#define TB_ZIP_PARALLEL_DICT_SIZE           (1 << MAX_WBITS)
+
+// the maximum count of the blocks in flight
+#define TB_ZIP_PARALLEL_JOBS_MAXN           (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the parallel zip block job type
+typedef struct __tb_zip_parallel_job_t
+{
+    // the next job in the pending or free list
+    struct __tb_zip_parallel_job_t*     next;
+
+    // the parallel zip
+    struct __tb_zip_parallel_t*         zip;
+
+    // the raw deflate stream, it will be reused for the next blocks
+    z_stream                            zstream;
+
+    // the zstream has been inited?
+    tb_bool_t                           zinited;
+
+    // is the last block?
+    tb_bool_t                           last;
+
+    // has been finished? it's protected by the zip lock
+    tb_bool_t                           done;
+
+    // the input data: dictionary + block data
+    tb_byte_t*                          idata;
+
+    // the dictionary size
+    tb_size_t                           dict_size;
+
+    // the block data size
+    tb_size_t                           size;
+
+    // the checksum of the block data, crc32 for gzip and adler32 for zlib
+    tb_uint32_t                         check;
+
+    // the output data
+    tb_byte_t*                          odata;
+
+    // the output data maxn
+    tb_size_t                           omaxn;
+
+    // the output data size, -1: failed
+    tb_long_t                           osize;
+
+    // the output data position which has been written to the output stream
+    tb_size_t                           opos;
+
+}tb_zip_parallel_job_t;
+
+// the parallel zip type
+typedef struct __tb_zip_parallel_t
+{
+    // the zip base
+    tb_zip_t                            base;
+
+    // the thread pool
+    tb_thread_pool_ref_t                pool;
+
+    // the lock for the job state
+    tb_spinlock_t                       lock;
+
+    // the semaphore for notifying the finished jobs
+    tb_semaphore_ref_t                  semaphore;
+
+    // all jobs
+    tb_zip_parallel_job_t*              jobs[TB_ZIP_PARALLEL_JOBS_MAXN];
+
+    // the jobs count
+    tb_size_t                           jobs_count;
+
+    // the jobs maxn
+    tb_size_t                           jobs_maxn;
+
+    // the free jobs
+    tb_zip_parallel_job_t*              jobs_free;
+
+    // the pending jobs in order, they are being compressed or waiting for writing
+    tb_zip_parallel_job_t*              jobs_head;
+    tb_zip_parallel_job_t*              jobs_tail;
+
+    // the current job which is being filled
+    tb_zip_parallel_job_t*              current;
+
+    // the checksum of all written blocks
+    tb_uint32_t                         check;
+
+    // the input size
+    tb_hize_t                           isize;
+
+    // the header and trailer data
+    tb_byte_t                           head[10];
+    tb_byte_t                           tail[8];
+
+    // the header size and the written position
+    tb_size_t                           head_size;
+    tb_size_t                           head_pos;
+
+    // the trailer size and the written position
+    tb_size_t                           tail_size;
+    tb_size_t                           tail_pos;
+
+    // the last block has been posted?
+    tb_bool_t                           finished;
+
+    // has been failed?
+    tb_bool_t                           failed;
+
+    // the dictionary window, the last 32K input of the posted blocks
+    tb_size_t                           window_size;
+    tb_byte_t                           window[TB_ZIP_PARALLEL_DICT_SIZE];
+
+}tb_zip_parallel_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static __tb_inline__ tb_zip_parallel_t* tb_zip_parallel_cast(tb_zip_ref_t zip)
+{
+    // check
+    tb_assert_and_check_return_val(zip && zip->action == TB_ZIP_ACTION_DEFLATE_PARALLEL, tb_null);
+
+    // cast it
+    return (tb_zip_parallel_t*)zip;
+}
+static tb_void_t tb_zip_parallel_job_deflate(tb_zip_parallel_job_t* job)
+{
+    // done
+    tb_long_t osize = -1;
+    do
+    {
+        // init or reset the raw deflate stream
+        if (!job->zinited)
+        {
+            if (deflateInit2(&job->zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) break;
+            job->zinited = tb_true;
+        }
+        else if (deflateReset(&job->zstream) != Z_OK) break;
+
+        // set the dictionary, the block can refer to the data of the previous blocks
+        if (job->dict_size && deflateSetDictionary(&job->zstream, (Bytef const*)job->idata, (uInt)job->dict_size) != Z_OK) break;
+
+        // grow the output data, the sync flush need some extra bytes
+        tb_size_t need = (tb_size_t)deflateBound(&job->zstream, (uLong)job->size) + 64;
+        if (need > job->omaxn)
+        {
+            job->odata = (tb_byte_t*)tb_ralloc(job->odata, need);
+            tb_assert_and_check_break(job->odata);
+            job->omaxn = need;
+        }
+
+        /* deflate it
+         *
+         * the non-last block is ended with the sync flush, so it's byte-aligned and can be concatenated with the next block,
+         * and the last block is finished with the final bit.
+         */
+        tb_byte_t const* data = job->idata + job->dict_size;
+        job->zstream.next_in    = (Bytef*)data;
+        job->zstream.avail_in   = (uInt)job->size;
+        job->zstream.next_out   = (Bytef*)job->odata;
+        job->zstream.avail_out  = (uInt)job->omaxn;
+        tb_int_t r = deflate(&job->zstream, job->last? Z_FINISH : Z_SYNC_FLUSH);
+        if (job->last? r != Z_STREAM_END : (r != Z_OK || job->zstream.avail_in || !job->zstream.avail_out))
+        {
+            tb_trace_e("deflate block failed: %d, size: %lu", r, job->size);
+            break;
+        }
+
+        // compute the checksum of the block data
+        if (job->zip->base.algo == TB_ZIP_ALGO_GZIP)
+            job->check = (tb_uint32_t)crc32(crc32(0L, Z_NULL, 0), (Bytef const*)data, (uInt)job->size);
+        else job->check = (tb_uint32_t)adler32(adler32(0L, Z_NULL, 0), (Bytef const*)data, (uInt)job->size);
+
+        // ok
+        osize = (tb_long_t)(job->omaxn - job->zstream.avail_out);
+
+    } while (0);
+
+    // save the output size
+    job->osize = osize;
+}
+static tb_void_t tb_zip_parallel_job_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    tb_zip_parallel_job_t* job = (tb_zip_parallel_job_t*)priv;
+    tb_assert_and_check_return(job && job->zip);
+
+    // deflate this block
+    tb_zip_parallel_job_deflate(job);
+
+    // trace
+    tb_trace_d("job[%p]: %lu => %ld, last: %d", job, job->size, job->osize, job->last);
+
+    /* finish it and notify the zip
+     *
+     * @note we post the semaphore in the lock, so the zip cannot be freed before leaving it
+     */
+    tb_zip_parallel_t* zip = job->zip;
+    tb_spinlock_enter(&zip->lock);
+    job->done = tb_true;
+    tb_semaphore_post(zip->semaphore, 1);
+    tb_spinlock_leave(&zip->lock);
+}
+static tb_bool_t tb_zip_parallel_job_finished(tb_zip_parallel_t* zip, tb_zip_parallel_job_t* job)
+{
+    // get the job state
+    tb_spinlock_enter(&zip->lock);
+    tb_bool_t done = job->done;
+    tb_spinlock_leave(&zip->lock);
+    return done;
+}
+static tb_bool_t tb_zip_parallel_job_wait(tb_zip_parallel_t* zip, tb_zip_parallel_job_t* job)
+{
+    // wait the next finished job until this job has been finished
+    while (!tb_zip_parallel_job_finished(zip, job))
+    {
+        if (tb_semaphore_wait(zip->semaphore, -1) < 0) return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_zip_parallel_job_t* tb_zip_parallel_job_get(tb_zip_parallel_t* zip)
+{
+    // get a free job
+    tb_zip_parallel_job_t* job = zip->jobs_free;
+    if (job) zip->jobs_free = job->next;
+    // make a new job if the jobs in flight are not enough
+    else if (zip->jobs_count < zip->jobs_maxn)
+    {
+        // make job
+        job = tb_malloc0_type(tb_zip_parallel_job_t);
+        tb_assert_and_check_return_val(job, tb_null);
+
+        // make the input data
+        job->idata = tb_malloc_bytes(TB_ZIP_PARALLEL_DICT_SIZE + TB_ZIP_PARALLEL_BLOCK_SIZE);
+        if (!job->idata)
+        {
+            tb_free(job);
+            return tb_null;
+        }
+
+        // save it
+        job->zip = zip;
+        zip->jobs[zip->jobs_count++] = job;
+    }
+    tb_check_return_val(job, tb_null);
+
+    // init the dictionary from the window
+    if (zip->window_size) tb_memcpy(job->idata, zip->window, zip->window_size);
+    job->dict_size  = zip->window_size;
+    job->size       = 0;
+    job->next       = tb_null;
+    return job;
+}
+static tb_void_t tb_zip_parallel_job_post(tb_zip_parallel_t* zip, tb_zip_parallel_job_t* job, tb_bool_t last)
+{
+    // update the dictionary window with the tail of this block
+    tb_size_t total = job->dict_size + job->size;
+    tb_size_t keep = tb_min(total, TB_ZIP_PARALLEL_DICT_SIZE);
+    tb_memcpy(zip->window, job->idata + total - keep, keep);
+    zip->window_size = keep;
+
+    // update the input size
+    zip->isize += job->size;
+
+    // init job state
+    job->last   = last;
+    job->done   = tb_false;
+    job->osize  = 0;
+    job->opos   = 0;
+    job->next   = tb_null;
+
+    // append it to the pending jobs
+    if (zip->jobs_tail) zip->jobs_tail->next = job;
+    else zip->jobs_head = job;
+    zip->jobs_tail = job;
+
+    // post it to the thread pool, or compress it directly if failed
+    if (!zip->pool || !tb_thread_pool_task_post(zip->pool, "zip_parallel", tb_zip_parallel_job_done, tb_null, job, tb_false))
+        tb_zip_parallel_job_done(tb_null, job);
+}
+static tb_void_t tb_zip_parallel_write(tb_static_stream_ref_t ost, tb_byte_t const* data, tb_size_t size, tb_size_t* ppos)
+{
+    // write the left data as much as possible
+    tb_size_t left = (tb_size_t)(ost->e - ost->p);
+    tb_size_t need = tb_min(size - *ppos, left);
+    if (need)
+    {
+        tb_memcpy(ost->p, data + *ppos, need);
+        ost->p += need;
+        *ppos += need;
+    }
+}
+/* write the finished blocks to the output stream in order
+ *
+ * @param wait      the maximum count of the blocks which can be waited for
+ */
+static tb_bool_t tb_zip_parallel_drain(tb_zip_parallel_t* zip, tb_static_stream_ref_t ost, tb_size_t wait)
+{
+    // write the header first
+    tb_zip_parallel_write(ost, zip->head, zip->head_size, &zip->head_pos);
+
+    // write the finished blocks
+    tb_zip_parallel_job_t* job = tb_null;
+    while ((job = zip->jobs_head) && ost->p < ost->e)
+    {
+        // not finished? wait it
+        if (!tb_zip_parallel_job_finished(zip, job))
+        {
+            tb_check_break(wait);
+            if (!tb_zip_parallel_job_wait(zip, job)) return tb_false;
+            wait--;
+        }
+
+        // failed?
+        tb_check_return_val(job->osize >= 0, tb_false);
+
+        // write the compressed data
+        tb_zip_parallel_write(ost, job->odata, (tb_size_t)job->osize, &job->opos);
+        tb_check_break(job->opos == (tb_size_t)job->osize);
+
+        // combine the checksum of this block
+        if (zip->base.algo == TB_ZIP_ALGO_GZIP)
+            zip->check = (tb_uint32_t)crc32_combine(zip->check, job->check, (z_off_t)job->size);
+        else zip->check = (tb_uint32_t)adler32_combine(zip->check, job->check, (z_off_t)job->size);
+
+        // remove it from the pending jobs and recycle it
+        zip->jobs_head = job->next;
+        if (!zip->jobs_head) zip->jobs_tail = tb_null;
+        job->next = zip->jobs_free;
+        zip->jobs_free = job;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_long_t tb_zip_parallel_spak_deflate(tb_zip_ref_t zip, tb_static_stream_ref_t ist, tb_static_stream_ref_t ost, tb_long_t sync)
+{
+    // check
+    tb_zip_parallel_t* parallel = tb_zip_parallel_cast(zip);
+    tb_assert_and_check_return_val(parallel && ist && ost, -1);
+
+    // the output stream
+    tb_byte_t* op = ost->p;
+    tb_byte_t* oe = ost->e;
+    tb_assert_and_check_return_val(op && oe, -1);
+
+    // failed?
+    tb_check_return_val(!parallel->failed, -1);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // write the finished blocks first
+        if (!tb_zip_parallel_drain(parallel, ost, 0)) break;
+
+        // split the input data to the blocks, @note the input stream maybe null for flushing the end data
+        tb_bool_t failed = tb_false;
+        while (ist->p && ist->p < ist->e)
+        {
+            // get a job for the current block
+            if (!parallel->current)
+            {
+                // too many blocks in flight? wait and write the oldest block if the output stream is not full
+                parallel->current = tb_zip_parallel_job_get(parallel);
+                if (!parallel->current)
+                {
+                    tb_check_break(ost->p < ost->e && parallel->jobs_head);
+                    if (!tb_zip_parallel_drain(parallel, ost, 1))
+                    {
+                        failed = tb_true;
+                        break;
+                    }
+                    continue;
+                }
+            }
+
+            // fill the current block
+            tb_zip_parallel_job_t*  job = parallel->current;
+            tb_size_t               size = tb_min((tb_size_t)(ist->e - ist->p), TB_ZIP_PARALLEL_BLOCK_SIZE - job->size);
+            tb_memcpy(job->idata + job->dict_size + job->size, ist->p, size);
+            job->size += size;
+            ist->p += size;
+
+            // the block is full? post it
+            if (job->size == TB_ZIP_PARALLEL_BLOCK_SIZE)
+            {
+                tb_zip_parallel_job_post(parallel, job, tb_false);
+                parallel->current = tb_null;
+            }
+        }
+        tb_check_break(!failed);
+
+        // sync or end? flush all blocks after all input data has been consumed
+        if (sync && !(ist->p && ist->p < ist->e))
+        {
+            // end? post the last block, it maybe empty
+            if (sync < 0)
+            {
+                while (!parallel->finished)
+                {
+                    // get a job for the last block
+                    if (!parallel->current) parallel->current = tb_zip_parallel_job_get(parallel);
+                    if (parallel->current)
+                    {
+                        tb_zip_parallel_job_post(parallel, parallel->current, tb_true);
+                        parallel->current = tb_null;
+                        parallel->finished = tb_true;
+                    }
+                    else
+                    {
+                        // too many blocks in flight? wait and write the oldest block
+                        tb_check_break(ost->p < ost->e && parallel->jobs_head);
+                        if (!tb_zip_parallel_drain(parallel, ost, 1))
+                        {
+                            failed = tb_true;
+                            break;
+                        }
+                    }
+                }
+                tb_check_break(!failed);
+            }
+            // sync? post the current block
+            else if (parallel->current && parallel->current->size)
+            {
+                tb_zip_parallel_job_post(parallel, parallel->current, tb_false);
+                parallel->current = tb_null;
+            }
+
+            // wait and write all blocks
+            if (!tb_zip_parallel_drain(parallel, ost, (tb_size_t)-1)) break;
+
+            // all blocks have been written? write the trailer
+            if (parallel->finished && !parallel->jobs_head)
+            {
+                // init the trailer
+                if (!parallel->tail_size)
+                {
+                    if (zip->algo == TB_ZIP_ALGO_GZIP)
+                    {
+                        tb_bits_set_u32_le(parallel->tail, parallel->check);
+                        tb_bits_set_u32_le(parallel->tail + 4, (tb_uint32_t)parallel->isize);
+                        parallel->tail_size = 8;
+                    }
+                    else
+                    {
+                        tb_bits_set_u32_be(parallel->tail, parallel->check);
+                        parallel->tail_size = 4;
+                    }
+                }
+
+                // write the trailer
+                tb_zip_parallel_write(ost, parallel->tail, parallel->tail_size, &parallel->tail_pos);
+            }
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        parallel->failed = tb_true;
+        return -1;
+    }
+
+    // trace
+    tb_trace_d("deflate: %lu, sync: %ld, pending: %p", (tb_size_t)(ost->p - op), sync, parallel->jobs_head);
+
+    // end?
+    tb_check_return_val(ost->p > op || !parallel->tail_size || parallel->tail_pos < parallel->tail_size, -1);
+
+    // ok?
+    return (ost->p - op);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_zip_ref_t tb_zip_parallel_init(tb_size_t algo)
+{
+    // check
+    tb_assert_and_check_return_val(algo == TB_ZIP_ALGO_ZLIBRAW || algo == TB_ZIP_ALGO_ZLIB || algo == TB_ZIP_ALGO_GZIP, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_zip_parallel_t*  zip = tb_null;
+    do
+    {
+        // make zip
+        zip = tb_malloc0_type(tb_zip_parallel_t);
+        tb_assert_and_check_break(zip);
+
+        // init zip
+        zip->base.algo      = (tb_uint16_t)algo;
+        zip->base.action    = TB_ZIP_ACTION_DEFLATE_PARALLEL;
+        zip->base.spak      = tb_zip_parallel_spak_deflate;
+
+        // init lock
+        if (!tb_spinlock_init(&zip->lock)) break;
+
+        // init semaphore
+        zip->semaphore = tb_semaphore_init(0);
+        tb_assert_and_check_break(zip->semaphore);
+
+        // init the thread pool, we will compress blocks directly if no thread pool
+        zip->pool = tb_thread_pool();
+
+        // keep two blocks in flight for each processor at most
+        zip->jobs_maxn = tb_min(tb_max(tb_processor_count() << 1, 2), TB_ZIP_PARALLEL_JOBS_MAXN);
+
+        /* init the header, the zlib and zlibraw deflate all output the zlib stream
+         *
+         * zlib: cmf: deflate with 32K window, flg: the default compression level and the check bits
+         * gzip: magic, deflate, no flags, no mtime, no extra flags and the unknown os
+         */
+        if (algo == TB_ZIP_ALGO_GZIP)
+        {
+            static tb_byte_t const s_head[] = {0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff};
+            tb_memcpy(zip->head, s_head, sizeof(s_head));
+            zip->head_size = sizeof(s_head);
+            zip->check = (tb_uint32_t)crc32(0L, Z_NULL, 0);
+        }
+        else
+        {
+            zip->head[0] = 0x78;
+            zip->head[1] = 0x9c;
+            zip->head_size = 2;
+            zip->check = (tb_uint32_t)adler32(0L, Z_NULL, 0);
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (zip) tb_zip_parallel_exit((tb_zip_ref_t)zip);
+        zip = tb_null;
+    }
+
+    // ok?
+    return (tb_zip_ref_t)zip;
+}
+tb_void_t tb_zip_parallel_exit(tb_zip_ref_t zip)
+{
+    // check
+    tb_zip_parallel_t* parallel = tb_zip_parallel_cast(zip);
+    tb_assert_and_check_return(parallel);
+
+    // wait all pending jobs, they are still using the job data
+    tb_zip_parallel_job_t* job = parallel->jobs_head;
+    for (; job; job = job->next) tb_zip_parallel_job_wait(parallel, job);
+
+    // ensure that all workers have left the lock
+    tb_spinlock_enter(&parallel->lock);
+    tb_spinlock_leave(&parallel->lock);
+
+    // exit all jobs
+    tb_size_t i = 0;
+    for (i = 0; i < parallel->jobs_count; i++)
+    {
+        job = parallel->jobs[i];
+        if (job->zinited) deflateEnd(&job->zstream);
+        if (job->idata) tb_free(job->idata);
+        if (job->odata) tb_free(job->odata);
+        tb_free(job);
+    }
+    parallel->jobs_count = 0;
+
+    // exit semaphore
+    if (parallel->semaphore) tb_semaphore_exit(parallel->semaphore);
+    parallel->semaphore = tb_null;
+
+    // exit lock
+    tb_spinlock_exit(&parallel->lock);
+
+    // free it
+    tb_free(parallel);
+}
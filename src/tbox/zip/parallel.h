@@ -0,0 +1,62 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2019, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        parallel.h
+ * @ingroup     zip
+ *
+ */
+#ifndef TB_ZIP_PARALLEL_H
+#define TB_ZIP_PARALLEL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the parallel deflate zip
+ *
+ * the input will be split to the independent blocks and compressed on the thread pool,
+ * each block uses the last 32K input of the previous blocks as the dictionary,
+ * and the compressed blocks will be stitched into a valid zlib or gzip stream in order.
+ *
+ * @param algo      the zip algorithm, only supports zlibraw, zlib and gzip
+ *
+ * @return          the zip
+ */
+tb_zip_ref_t        tb_zip_parallel_init(tb_size_t algo);
+
+/* exit the parallel deflate zip
+ *
+ * @param zip       the zip
+ */
+tb_void_t           tb_zip_parallel_exit(tb_zip_ref_t zip);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
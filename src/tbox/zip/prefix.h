@@ -35,9 +35,10 @@
 // the zip action type
 typedef enum __tb_zip_action_t
 {
-    TB_ZIP_ACTION_NONE      = 0
-,   TB_ZIP_ACTION_INFLATE   = 1
-,   TB_ZIP_ACTION_DEFLATE   = 2
+    TB_ZIP_ACTION_NONE              = 0
+,   TB_ZIP_ACTION_INFLATE           = 1
+,   TB_ZIP_ACTION_DEFLATE           = 2
+,   TB_ZIP_ACTION_DEFLATE_PARALLEL  = 3     //!< deflate the independent blocks on the thread pool, only for zlibraw, zlib and gzip
 
 }tb_zip_action_t;
 
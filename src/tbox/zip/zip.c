@@ -26,6 +26,7 @@
 #include "gzip.h"
 #include "zlib.h"
 #include "zlibraw.h"
+#include "parallel.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -49,6 +50,11 @@ tb_zip_ref_t tb_zip_init(tb_size_t algo, tb_size_t action)
     };
     tb_assert_and_check_return_val(algo < tb_arrayn(s_init) && s_init[algo], tb_null);
 
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+    // deflate it in parallel?
+    if (action == TB_ZIP_ACTION_DEFLATE_PARALLEL) return tb_zip_parallel_init(algo);
+#endif
+
     // init
     return s_init[algo](action);
 }
@@ -73,6 +79,15 @@ tb_void_t tb_zip_exit(tb_zip_ref_t zip)
     };
     tb_assert_and_check_return(zip->algo < tb_arrayn(s_exit) && s_exit[zip->algo]);
 
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+    // deflate it in parallel?
+    if (zip->action == TB_ZIP_ACTION_DEFLATE_PARALLEL)
+    {
+        tb_zip_parallel_exit(zip);
+        return ;
+    }
+#endif
+
     // exit
     s_exit[zip->algo](zip);
 }
@@ -246,6 +246,7 @@ function check_interfaces()
     check_module_cfuncs("posix", "ifaddrs.h",                        "getifaddrs")
     check_module_cfuncs("posix", "semaphore.h",                      "sem_init")
     check_module_cfuncs("posix", "unistd.h",                         "getpagesize", "sysconf")
+    check_module_cfuncs("posix", "sys/mman.h",                       "mmap", "mprotect", "madvise")
     check_module_cfuncs("posix", "sched.h",                          "sched_yield")
     check_module_cfuncs("posix", "regex.h",                          "regcomp", "regexec")
     check_module_cfuncs("posix", "sys/uio.h",                        "readv", "writev", "preadv", "pwritev")
@@ -254,6 +255,8 @@ function check_interfaces()
     check_module_cfuncs("posix", "copyfile.h",                       "copyfile")
     check_module_cfuncs("posix", "sys/sendfile.h",                   "sendfile")
     check_module_cfuncs("posix", "sys/epoll.h",                      "epoll_create", "epoll_wait")
+    check_module_cfuncs("posix", {"linux/io_uring.h", "sys/syscall.h", "unistd.h"}, "io_uring_setup{struct io_uring_params p = {0}; syscall(__NR_io_uring_setup, 1, &p); (void)IORING_POLL_ADD_MULTI;}")
+    check_module_cfuncs("posix", {"linux/futex.h", "sys/syscall.h", "unistd.h"}, "futex{syscall(__NR_futex, (int*)0, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);}")
     check_module_cfuncs("posix", "spawn.h",                          "posix_spawnp")
     check_module_cfuncs("posix", "unistd.h",                         "execvp", "execvpe", "fork", "vfork")
     check_module_cfuncs("posix", "sys/wait.h",                       "waitpid")